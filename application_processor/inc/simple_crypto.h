@@ -16,6 +16,9 @@
 
 #include "wolfssl/wolfcrypt/aes.h"
 #include "wolfssl/wolfcrypt/hash.h"
+#include "wolfssl/wolfcrypt/hmac.h"
+#include "wolfssl/wolfcrypt/pwdbased.h"
+#include "wolfssl/wolfcrypt/memory.h"
 #include "wolfssl/wolfcrypt/rsa.h"
 #include "wolfssl/wolfcrypt/random.h"
 #include "wolfssl/wolfcrypt/settings.h" // To define our random generator...
@@ -25,6 +28,14 @@
 #define BLOCK_SIZE AES_BLOCK_SIZE
 #define KEY_SIZE 16
 #define HASH_SIZE SHA256_DIGEST_SIZE
+#define MAC_SIZE WC_SHA256_DIGEST_SIZE
+#define KDF_SIZE WC_SHA256_DIGEST_SIZE
+// Bytes handed to wc_LoadStaticMemory, split into WOLFMEM_BUCKETS (user_settings.h)
+#define CRYPTO_HEAP_SIZE 1024
+
+/******************************** GLOBAL DEFINITIONS ********************************/
+// Heap hint for the static wolfCrypt pool, pass to every wolfCrypt init that takes a heap
+extern WOLFSSL_HEAP_HINT* crypto_heap;
 
 /******************************** FUNCTION PROTOTYPES ********************************/
 /** @brief Encrypts plaintext using a symmetric cipher
@@ -57,6 +68,14 @@ int encrypt_sym(uint8_t *plaintext, size_t len, uint8_t *key, uint8_t *ciphertex
  */
 int decrypt_sym(uint8_t *ciphertext, size_t len, uint8_t *key, uint8_t *plaintext);
 
+/** @brief Carves the static memory pool into wolfCrypt buckets
+ *
+ * Must be called before any key or RNG is initialized with crypto_heap
+ *
+ * @return 0 on success, non-zero for other error
+ */
+int crypto_heap_init(void);
+
 /** @brief Hashes arbitrary-length data
  *
  * @param data A pointer to a buffer of length len containing the data
@@ -69,6 +88,31 @@ int decrypt_sym(uint8_t *ciphertext, size_t len, uint8_t *key, uint8_t *plaintex
  */
 int hash(void *data, size_t len, uint8_t *hash_out);
 
+/** @brief Derives a key from a low-entropy secret with PBKDF2-HMAC-SHA256
+ *
+ * @param secret A pointer to a buffer of length len containing the secret
+ * @param len The length of the secret
+ * @param salt A pointer to a buffer of length salt_len containing the salt
+ * @param salt_len The length of the salt
+ * @param iterations The work factor, the number of HMACs per output block
+ * @param kdf_out A pointer to a buffer of length KDF_SIZE (32 bytes) where the
+ *           derived key will be written to
+ *
+ * @return 0 on success, non-zero for other error
+ */
+int kdf(const void *secret, size_t len, const uint8_t *salt, size_t salt_len,
+        int iterations, uint8_t *kdf_out);
+
+/** @brief Compares two buffers in time independent of their contents
+ *
+ * @param a A pointer to a buffer of length len
+ * @param b A pointer to a buffer of length len
+ * @param len The number of bytes to compare
+ *
+ * @return 0 if the buffers are equal, non-zero otherwise
+ */
+int ct_compare(const void *a, const void *b, size_t len);
+
 // This initializes wolfssl's random generator to allow us to generate secure randomness
 // wolfssl.com/forums/topic879-solved-using-rsa-undefined-reference-to-wcgenerateseed-error.html
 // int rand_gen_seed(uint8_t* output, int sz); already defined in user_settings.h
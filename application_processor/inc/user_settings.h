@@ -4,4 +4,22 @@
 // wolfssl.com/forums/topic879-solved-using-rsa-undefined-reference-to-wcgenerateseed-error.html
 int rand_gen_seed(uint8_t* output, int sz);
 #define CUSTOM_RAND_GENERATE_SEED rand_gen_seed
+
+// Size sp_int to the deployment RSA modulus (RSA_KEY_LENGTH in generate_secrets.py).
+// The 3072 bit default makes every decoded RsaKey ~6.2KB of SRAM, at 512 bits it is ~1.2KB.
+// Checked against RSA_KEY_LENGTH at compile time where the keys are decoded
+#define SP_INT_BITS 512
+// Nothing uses DH, and the minimum DH group no longer fits in an sp_int
+#define NO_DH
+
+// wolfCrypt allocates from a fixed pool of buckets (crypto_heap_init() in simple_crypto.c)
+// instead of newlib malloc, so allocation time is constant and the heap cannot fragment.
+// With WOLFSSL_NO_MALLOC anything called without the pool's heap hint fails instead of
+// falling back to malloc, sp_int temporaries live on the stack and RSA decrypts in place
+#define WOLFSSL_STATIC_MEMORY
+#define WOLFSSL_NO_MALLOC
+// Sizes from an allocation trace of list/boot/attest: once decrypt is in place the only
+// allocation left is the 128 byte DRBG state of each WC_RNG, 64 byte buckets are headroom
+#define WOLFMEM_BUCKETS 64,128
+#define WOLFMEM_DIST 1,1
 #endif
@@ -22,6 +22,22 @@ IPATH+=../deployment
 IPATH+=inc/
 VPATH+=src/
 
+# ****************** Memory instrumentation *******************
+# Build with MEM_STATS=1 to paint the stack at reset and count wolfCrypt heap
+# use. The AP then accepts a "mem" command reporting its own and each
+# provisioned component's stack and heap high-water marks
+ifeq ($(MEM_STATS), 1)
+PROJ_CFLAGS += -DMEM_STATS
+PROJ_AFLAGS += -DMEM_STATS
+endif
+
+# ****************** PIN/token KDF benchmark *******************
+# Build with KDF_BENCH=1 to add a "kdf" command that times the PIN and token
+# KDF at several work factors, to pick KDF_ITERATIONS for generate_secrets.py
+ifeq ($(KDF_BENCH), 1)
+PROJ_CFLAGS += -DKDF_BENCH
+endif
+
 # ****************** eCTF Bootloader *******************
 # DO NOT REMOVE
 LINKERFILE=firmware.ld
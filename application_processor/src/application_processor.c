@@ -20,6 +20,7 @@
 #include "nvic_table.h"
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <string.h>
@@ -28,6 +29,7 @@
 #include "simple_flash.h"
 #include "host_messaging.h"
 #include "simple_crypto.h"
+#include "mem_stats.h"
 
 #ifdef POST_BOOT
 #include "mxc_delay.h"
@@ -40,6 +42,11 @@
 #include "ectf_params.h"
 #include "global_secrets.h"
 
+// Key material in global_secrets.h is decoded into sp_ints of SP_INT_BITS
+#if (RSA_KEY_LENGTH * 8) > SP_INT_BITS
+#error "SP_INT_BITS in user_settings.h is smaller than the deployment RSA key"
+#endif
+
 /********************************* CONSTANTS **********************************/
 
 // Passed in through ectf-params.h
@@ -60,8 +67,8 @@
 #define SUCCESS_RETURN 0
 #define ERROR_RETURN -1
 
-int init_ap_priv_key(RsaKey* key, uint8_t* DER_Key, int len);
-int init_comp_pub_key(RsaKey* key, uint8_t* DER_Key, int len);
+int init_ap_priv_key(RsaKey* key, const uint8_t* DER_Key, word32 len);
+int init_comp_pub_key(RsaKey* key, const uint8_t* DER_Key, word32 len);
 /******************************** TYPE DEFINITIONS ********************************/
 // Data structure for sending commands to component
 // Params allows for up to MAX_I2C_MESSAGE_LEN - 2 bytes to be send
@@ -87,6 +94,15 @@ typedef struct {
     uint32_t component_id;
 } scan_message;
 
+// Data type for receiving an attestation reply: the AT data encrypted with our
+// AT key, followed by a MAC over it and the nonce we sent with the request
+typedef struct {
+    uint8_t AT_ECUST[RSA_KEY_LENGTH];
+    uint8_t AT_ELOCA[RSA_KEY_LENGTH];
+    uint8_t AT_EDATE[RSA_KEY_LENGTH];
+    uint8_t tag[MAC_SIZE];
+} attest_message;
+
 // Datatype for information stored in flash
 typedef struct {
     uint32_t flash_magic;
@@ -100,7 +116,8 @@ typedef enum {
     COMPONENT_CMD_SCAN,
     COMPONENT_CMD_VALIDATE,
     COMPONENT_CMD_BOOT,
-    COMPONENT_CMD_ATTEST
+    COMPONENT_CMD_ATTEST,
+    COMPONENT_CMD_MEM_STATS
 } component_cmd_t;
 
 /********************************* GLOBAL VARIABLES **********************************/
@@ -253,6 +270,20 @@ int init(void) {
     // Enable global interrupts    
     __enable_irq();
 
+    // All wolfCrypt memory comes from a static pool, set up before any key or RNG
+    if (crypto_heap_init() != 0) {
+        print_error("Could not set up the wolfCrypt memory pool\n");
+        return -4;
+    }
+
+#ifdef MEM_STATS
+    // Count wolfCrypt pool use, must happen before the first key or RNG init
+    if (mem_stats_init() != 0) {
+        print_error("Could not enable wolfCrypt pool statistics\n");
+        return -5;
+    }
+#endif
+
     // Initializes true randomness to enable the random generator for RSA encryption
     MXC_TRNG_Init();
 
@@ -261,21 +292,21 @@ int init(void) {
 
     // Generate private key here using wolfssl
     
-    // For AT Data
-    if( init_ap_priv_key(&AP_AT_PRIV, (uint8_t*)AP_PRIV_AT, sizeof(AP_PRIV_AT)) < 0) { 
+    // For AT Data, decoded straight from the .key_store flash section
+    if( init_ap_priv_key(&AP_AT_PRIV, AP_PRIV_AT, sizeof(AP_PRIV_AT)) < 0) { 
         print_error("FAILED to initialize key for private component, CRITICAL!\n");
         return -1; 
     }
 
     // Initialize the Randomizer for private communication :P
-    int ret = wc_InitRng(&AP_rng); 
+    int ret = wc_InitRng_ex(&AP_rng, crypto_heap, INVALID_DEVID); 
     if(ret != 0) { 
          print_error("Randomizer failed to initialize - suffer \n");
          return -2; 
     }
 
     // For Comp Data 
-    if( init_comp_pub_key(&COMP_PUB, (uint8_t*)COMP1_PUB, sizeof(COMP_PUB)) < 0) { 
+    if( init_comp_pub_key(&COMP_PUB, COMP1_PUB, sizeof(COMP1_PUB)) < 0) { 
         print_error("FAILED to initialize key for public component, CRITICAL!\n");
         return -3; 
     }
@@ -306,13 +337,13 @@ int init(void) {
     return 0;
 }
 
-int init_ap_priv_key(RsaKey* key, uint8_t* DER_Key, int len)
+int init_ap_priv_key(RsaKey* key, const uint8_t* DER_Key, word32 len)
 {
     int ret = 0;
-    unsigned int idx = 0;
+    word32 idx = 0;
 
     // Initialize key structure
-    ret = wc_InitRsaKey(key, NULL);
+    ret = wc_InitRsaKey(key, crypto_heap);
     if(ret < 0) { 
         print_error(" Error initializing RsaKey \n");
         return ERROR_RETURN;
@@ -330,13 +361,13 @@ int init_ap_priv_key(RsaKey* key, uint8_t* DER_Key, int len)
     return 0;
 }
 
-int init_comp_pub_key(RsaKey* key, uint8_t* DER_Key, int len)
+int init_comp_pub_key(RsaKey* key, const uint8_t* DER_Key, word32 len)
 {
     int ret = 0;
-    unsigned int idx = 0;
+    word32 idx = 0;
 
     // Initialize key structure
-    ret = wc_InitRsaKey(key, NULL);
+    ret = wc_InitRsaKey(key, crypto_heap);
     if(ret < 0) { 
         print_error(" Error initializing RsaKey \n");
         return ERROR_RETURN;    
@@ -533,52 +564,73 @@ int attest_component(uint32_t component_id) {
     uint8_t receive_buffer[MAX_I2C_MESSAGE_LEN];
     uint8_t transmit_buffer[MAX_I2C_MESSAGE_LEN];
 
-    // customer, location, date
-    uint8_t plaintext_attest[3][MAX_I2C_MESSAGE_LEN];
-    uint8_t HASH_DIGEST[HASH_SIZE];
+    // customer, location, date, each NUL terminated even if the sender forgot to
+    uint8_t plaintext_attest[3][RSA_KEY_LENGTH + 1];
+    uint8_t tag[MAC_SIZE];
+    Hmac hmac;
+    int ret;
+    nonce_t nonce = generate_nonce();
+
     // Set the I2C address of the component
     i2c_addr_t addr = component_id_to_i2c_addr(component_id);
 
-    // Create command message
+    // Create command message, the reply MAC has to cover this nonce
     command_message* command = (command_message*) transmit_buffer;
     command->opcode = COMPONENT_CMD_ATTEST;
+    memcpy(command->params, &nonce, sizeof(nonce_t));
 
-    // Send out command first, we'll be expecting exactly 4 messages
-    secure_send(addr, transmit_buffer, sizeof(command));
-    for(; i < 4; i++)
-    {
-         bzero(receive_buffer, sizeof(receive_buffer)); // Clean our buffer to not mess with the hash check
-         int len = secure_receive(addr, receive_buffer);
-         if (len == ERROR_RETURN) {
-            print_error("Could not attest component\n");
-            return ERROR_RETURN;
-         }
-         // Hash comes last 
-         if(i == 3)
-         {
-            memcpy(HASH_DIGEST, receive_buffer, sizeof(HASH_DIGEST));
-            break;
-         }
-         wc_RsaPrivateDecrypt(receive_buffer, sizeof(receive_buffer),
-                            plaintext_attest[i], MAX_I2C_MESSAGE_LEN, &AP_AT_PRIV );
-                                               //sizeof(plaintext_attest[0]) 
-    }
-
-    uint8_t hash_test[HASH_SIZE];
-    
-    hash(plaintext_attest, sizeof(plaintext_attest), hash_test);
+    if (secure_send(addr, transmit_buffer, sizeof(nonce_t) + 1) == ERROR_RETURN) {
+        print_error("Could not attest component\n");
+        return ERROR_RETURN;
+    }
 
-    if (memcmp(hash_test, HASH_DIGEST, HASH_SIZE) != 0)
-    {
+    // The reply is already encrypted for us and carries its own MAC, so it
+    // arrives as one plain packet rather than through secure_receive
+    int len = poll_and_receive_packet(addr, receive_buffer);
+    if (len != sizeof(attest_message)) {
+        print_error("Could not attest component\n");
+        return ERROR_RETURN;
+    }
+    attest_message* reply = (attest_message*) receive_buffer;
+
+    ret = wc_HmacInit(&hmac, crypto_heap, INVALID_DEVID);
+    if (ret == 0) {
+        ret = wc_HmacSetKey(&hmac, WC_SHA256, ATTEST_KEY, sizeof(ATTEST_KEY));
+        if (ret == 0) {
+            ret = wc_HmacUpdate(&hmac, receive_buffer, offsetof(attest_message, tag));
+        }
+        if (ret == 0) {
+            ret = wc_HmacUpdate(&hmac, (uint8_t*)&nonce, sizeof(nonce));
+        }
+        if (ret == 0) {
+            ret = wc_HmacFinal(&hmac, tag);
+        }
+        wc_HmacFree(&hmac);
+    }
+    if (ret != 0) {
+        print_error("Error: mac\n");
+        return ERROR_RETURN;
+    }
+
+    if (ct_compare(tag, reply->tag, MAC_SIZE) != 0) {
         print_error("Failure to verify the integrity of attestation data\n");
         return ERROR_RETURN;
     }
 
+    uint8_t* encrypted_attest[3] = {reply->AT_ECUST, reply->AT_ELOCA, reply->AT_EDATE};
+    for (; i < 3; i++) {
+        bzero(plaintext_attest[i], sizeof(plaintext_attest[i]));
+        if (wc_RsaPrivateDecrypt(encrypted_attest[i], RSA_KEY_LENGTH,
+                    plaintext_attest[i], RSA_KEY_LENGTH, &AP_AT_PRIV) < 0) {
+            print_error("Could not decrypt attestation data\n");
+            return ERROR_RETURN;
+        }
+    }
+
     bzero(receive_buffer, sizeof(receive_buffer));
     sprintf((char*)receive_buffer,"CUST>%s\nLOC>%s\nDATE>%s\n", plaintext_attest[0], plaintext_attest[1], plaintext_attest[2]);
     // Print out attestation data 
     print_info("C>0x%08x\n", component_id);
-    //"LOC>%s\nDATE>%s\nCUST>%s\n"
     print_info("%s", receive_buffer);
     return SUCCESS_RETURN;
 }
@@ -613,27 +665,29 @@ void boot(void) {
     #endif
 }
 
+// Derive the entered secret with its deployment salt and compare it to the stored digest.
+// One KDF call and a constant-time compare, no allocation and no hex formatting
+int check_secret(const char* input, const uint8_t* salt, size_t salt_len, const uint8_t* digest) {
+    uint8_t derived[KDF_SIZE];
+    int ret = ERROR_RETURN;
+
+    if (kdf(input, strlen(input), salt, salt_len, KDF_ITERATIONS, derived) != 0) {
+        print_error("Error: kdf\n");
+    } else if (ct_compare(derived, digest, KDF_SIZE) == 0) {
+        ret = SUCCESS_RETURN;
+    }
+
+    bzero(derived, sizeof(derived));
+    return ret;
+}
+
 // Compare the entered PIN to the correct PIN
 int validate_pin(void) {
     char buf[PIN_BUFSIZE]; // Should be generated by deployment
-    uint8_t hash_out[HASH_SIZE];
-    char hash_to_string[HASH_SIZE*2];
-    int i;
 
     recv_input("Enter pin: ", buf, sizeof(buf));
 
-    if (hash(buf, sizeof(buf), hash_out) != 0) {
-	print_error("Error: hash\n");
-        return ERROR_RETURN;
-    }
-    
-    for(i = 0; i < 32; i++)
-    {
-        sprintf(&hash_to_string[i*2], "%02x", hash_out[i]);
-    }
-    
-    // Compares the hashes!
-    if (!strcmp((char*)hash_to_string, PIN)) {
+    if (check_secret(buf, PIN_SALT, sizeof(PIN_SALT), PIN_DIGEST) == SUCCESS_RETURN) {
         print_debug("Pin Accepted!\n");
         return SUCCESS_RETURN;
     }
@@ -645,24 +699,10 @@ int validate_pin(void) {
 // Function to validate the replacement token
 int validate_token(void) {
     char buf[TOKEN_BUFSIZE];
-    uint8_t hash_out[HASH_SIZE];
-    char hash_to_string[HASH_SIZE*2];
-    int i;
     
     recv_input("Enter token: ", buf, sizeof(buf));
 
-    if (hash(buf, sizeof(buf), hash_out) != 0) {
-	print_error("Error: hash\n");
-        return ERROR_RETURN;
-    }
-
-    for(i = 0; i < 32; i++)
-    {
-        sprintf(&hash_to_string[i*2], "%02x", hash_out[i]);
-    }
-
-
-    if (!strcmp((char*)hash_to_string, TOKEN)) {
+    if (check_secret(buf, TOKEN_SALT, sizeof(TOKEN_SALT), TOKEN_DIGEST) == SUCCESS_RETURN) {
         print_debug("Token Accepted!\n");
         return SUCCESS_RETURN;
     }
@@ -745,6 +785,66 @@ void attempt_attest(void) {
     }
 }
 
+#ifdef MEM_STATS
+void print_mem_stats(const char* name, uint32_t id, const mem_stats_t* stats) {
+    print_info("%s>0x%08x stack %u/%u heap %u (peak %u, %u allocs)\n", name, id,
+            stats->stack_peak, stats->stack_size, stats->heap_current,
+            stats->heap_peak, stats->heap_allocs);
+}
+
+// Report stack and heap high-water marks for the AP and every provisioned component
+void attempt_mem_stats(void) {
+    uint8_t receive_buffer[MAX_I2C_MESSAGE_LEN];
+    uint8_t transmit_buffer[MAX_I2C_MESSAGE_LEN];
+    mem_stats_t stats;
+
+    mem_stats_get(&stats);
+    print_mem_stats("AP", 0, &stats);
+
+    for (unsigned i = 0; i < flash_status.component_cnt; i++) {
+        i2c_addr_t addr = component_id_to_i2c_addr(flash_status.component_ids[i]);
+
+        bzero(transmit_buffer, sizeof(transmit_buffer));
+        command_message* command = (command_message*) transmit_buffer;
+        command->opcode = COMPONENT_CMD_MEM_STATS;
+
+        int len = issue_cmd(addr, transmit_buffer, receive_buffer);
+        if (len != sizeof(mem_stats_t)) {
+            print_error("Could not get memory stats from 0x%08x\n", flash_status.component_ids[i]);
+            continue;
+        }
+        memcpy(&stats, receive_buffer, sizeof(stats));
+        print_mem_stats("C", flash_status.component_ids[i], &stats);
+    }
+    print_success("Mem\n");
+}
+#endif
+
+#ifdef KDF_BENCH
+// Report what a PIN or token check costs at a range of work factors, to pick
+// KDF_ITERATIONS for a deployment. Timed with the Cortex-M4 cycle counter
+void attempt_kdf_bench(void) {
+    const int work_factors[] = {1, 10, 100, 1000, 10000, KDF_ITERATIONS};
+    uint8_t derived[KDF_SIZE];
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    for (unsigned i = 0; i < sizeof(work_factors) / sizeof(work_factors[0]); i++) {
+        uint32_t start = DWT->CYCCNT;
+        if (kdf("0123456789abcdef", 16, PIN_SALT, sizeof(PIN_SALT), work_factors[i], derived) != 0) {
+            print_error("Error: kdf\n");
+            return;
+        }
+        uint32_t cycles = DWT->CYCCNT - start;
+        print_info("KDF>%d iterations: %u cycles, %u us%s\n", work_factors[i], cycles,
+                cycles / (SystemCoreClock / 1000000),
+                work_factors[i] == KDF_ITERATIONS ? " (deployed)" : "");
+    }
+    print_success("Kdf\n");
+}
+#endif
+
 /*********************************** MAIN *************************************/
 #define CMD_BUFSIZE 100
 
@@ -772,6 +872,14 @@ int main(void) {
             attempt_replace();
         } else if (!strcmp(buf, "attest")) {
             attempt_attest();
+#ifdef MEM_STATS
+        } else if (!strcmp(buf, "mem")) {
+            attempt_mem_stats();
+#endif
+#ifdef KDF_BENCH
+        } else if (!strcmp(buf, "kdf")) {
+            attempt_kdf_bench();
+#endif
         } else {
             print_error("Unrecognized command '%s'\n", buf);
         }
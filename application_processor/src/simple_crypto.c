@@ -15,6 +15,11 @@
 #include <stdint.h>
 #include <string.h>
 
+/******************************** GLOBAL DEFINITIONS ********************************/
+// Backing store for every wolfCrypt allocation, aligned as wolfSSL_load_static_memory expects
+static unsigned char crypto_heap_buf[CRYPTO_HEAP_SIZE] __attribute__((aligned(WOLFSSL_STATIC_ALIGN)));
+WOLFSSL_HEAP_HINT* crypto_heap = NULL;
+
 /******************************** FUNCTION PROTOTYPES ********************************/
 /** @brief Encrypts plaintext using a symmetric cipher
  *
@@ -87,6 +92,17 @@ int decrypt_sym(uint8_t *ciphertext, size_t len, uint8_t *key, uint8_t *plaintex
     return 0;
 }
 
+/** @brief Carves the static memory pool into wolfCrypt buckets
+ *
+ * Must be called before any key or RNG is initialized with crypto_heap
+ *
+ * @return 0 on success, non-zero for other error
+ */
+int crypto_heap_init(void) {
+    return wc_LoadStaticMemory(&crypto_heap, crypto_heap_buf, sizeof(crypto_heap_buf),
+                               WOLFMEM_GENERAL, 1);
+}
+
 /** @brief Hashes arbitrary-length data
  *
  * @param data A pointer to a buffer of length len containing the data
@@ -102,6 +118,45 @@ int hash(void *data, size_t len, uint8_t *hash_out) {
     return wc_Sha256Hash((uint8_t *)data, len, hash_out);
 }
 
+/** @brief Derives a key from a low-entropy secret with PBKDF2-HMAC-SHA256
+ *
+ * @param secret A pointer to a buffer of length len containing the secret
+ * @param len The length of the secret
+ * @param salt A pointer to a buffer of length salt_len containing the salt
+ * @param salt_len The length of the salt
+ * @param iterations The work factor, the number of HMACs per output block
+ * @param kdf_out A pointer to a buffer of length KDF_SIZE (32 bytes) where the
+ *          derived key will be written to
+ *
+ * @return 0 on success, non-zero for other error
+ */
+int kdf(const void *secret, size_t len, const uint8_t *salt, size_t salt_len,
+        int iterations, uint8_t *kdf_out) {
+    // The HMAC state lives on the stack, nothing is taken from the pool
+    return wc_PBKDF2_ex(kdf_out, (const byte *)secret, (int)len, salt, (int)salt_len,
+                        iterations, KDF_SIZE, WC_SHA256, crypto_heap, INVALID_DEVID);
+}
+
+/** @brief Compares two buffers in time independent of their contents
+ *
+ * @param a A pointer to a buffer of length len
+ * @param b A pointer to a buffer of length len
+ * @param len The number of bytes to compare
+ *
+ * @return 0 if the buffers are equal, non-zero otherwise
+ */
+int ct_compare(const void *a, const void *b, size_t len) {
+    const volatile uint8_t *x = a;
+    const volatile uint8_t *y = b;
+    uint8_t diff = 0;
+
+    // Always walk the whole buffer, never exit on the first mismatch
+    for (size_t i = 0; i < len; i++) {
+        diff |= x[i] ^ y[i];
+    }
+    return diff;
+}
+
 
 /** @brief This initializes wolfssl's random generator to allow us to generate secure randomness
  * wolfssl.com/forums/topic879-solved-using-rsa-undefined-reference-to-wcgenerateseed-error.html
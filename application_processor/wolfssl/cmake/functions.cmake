@@ -94,6 +94,9 @@ function(generate_build_flags)
     if(WOLFSSL_BLAKE2S OR WOLFSSL_USER_SETTINGS)
         set(BUILD_BLAKE2S "yes" PARENT_SCOPE)
     endif()
+    if(WOLFSSL_BLAKE3 OR WOLFSSL_USER_SETTINGS)
+        set(BUILD_BLAKE3 "yes" PARENT_SCOPE)
+    endif()
     if(WOLFSSL_SHA512 OR WOLFSSL_SHA384 OR WOLFSSL_USER_SETTINGS)
         set(BUILD_SHA512 "yes" PARENT_SCOPE)
     endif()
@@ -499,6 +502,9 @@ function(generate_lib_src_list LIB_SOURCES)
               else()
                    if(NOT BUILD_FIPS_V2)
                         list(APPEND LIB_SOURCES wolfcrypt/src/rsa.c)
+                        if(BUILD_INTELASM)
+                             list(APPEND LIB_SOURCES wolfcrypt/src/rsa_batch_asm.S)
+                        endif()
                    endif()
               endif()
          endif()
@@ -560,6 +566,10 @@ function(generate_lib_src_list LIB_SOURCES)
 
          if(NOT BUILD_FIPS_V2 AND BUILD_SHA)
               list(APPEND LIB_SOURCES wolfcrypt/src/sha.c)
+
+              if(BUILD_INTELASM)
+                   list(APPEND LIB_SOURCES wolfcrypt/src/sha_asm.S)
+              endif()
          endif()
 
          if(NOT BUILD_FIPS_V2 AND BUILD_SHA512)
@@ -673,10 +683,26 @@ function(generate_lib_src_list LIB_SOURCES)
 
          if(BUILD_BLAKE2)
               list(APPEND LIB_SOURCES wolfcrypt/src/blake2b.c)
+
+              if(BUILD_INTELASM)
+                   list(APPEND LIB_SOURCES wolfcrypt/src/blake2b_asm.S)
+              endif()
          endif()
 
          if(BUILD_BLAKE2S)
               list(APPEND LIB_SOURCES wolfcrypt/src/blake2s.c)
+
+              if(BUILD_INTELASM)
+                   list(APPEND LIB_SOURCES wolfcrypt/src/blake2s_asm.S)
+              endif()
+         endif()
+
+         if(BUILD_BLAKE3)
+              list(APPEND LIB_SOURCES wolfcrypt/src/blake3.c)
+
+              if(BUILD_INTELASM)
+                   list(APPEND LIB_SOURCES wolfcrypt/src/blake3_asm.S)
+              endif()
          endif()
 
          if(BUILD_CHACHA)
@@ -692,6 +718,10 @@ function(generate_lib_src_list LIB_SOURCES)
 
               if(BUILD_POLY1305)
                    list(APPEND LIB_SOURCES wolfcrypt/src/chacha20_poly1305.c)
+
+                   if(BUILD_INTELASM)
+                        list(APPEND LIB_SOURCES wolfcrypt/src/chacha20_poly1305_asm.S)
+                   endif()
               endif()
          endif()
 
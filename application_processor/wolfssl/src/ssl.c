@@ -75,6 +75,11 @@
     #include <wolfssl/wolfcrypt/rsa.h>
 #endif
 
+#ifdef HAVE_PQC
+    /* Kyber levels compiled in are needed for the group names. */
+    #include <wolfssl/wolfcrypt/kyber.h>
+#endif
+
 #ifdef OPENSSL_EXTRA
     /* openssl headers begin */
     #include <wolfssl/openssl/ssl.h>
@@ -452,7 +457,7 @@ const WOLF_EC_NIST_NAME kNistCurves[] = {
     {XSTR_SIZEOF("KYBER_LEVEL1"), "KYBER_LEVEL1", WOLFSSL_KYBER_LEVEL1},
     {XSTR_SIZEOF("KYBER_LEVEL3"), "KYBER_LEVEL3", WOLFSSL_KYBER_LEVEL3},
     {XSTR_SIZEOF("KYBER_LEVEL5"), "KYBER_LEVEL5", WOLFSSL_KYBER_LEVEL5},
-#ifdef HAVE_LIBOQS
+#if defined(HAVE_LIBOQS) || (defined(WOLFSSL_WC_KYBER) && defined(HAVE_ECC))
     {XSTR_SIZEOF("P256_KYBER_LEVEL1"), "P256_KYBER_LEVEL1", WOLFSSL_P256_KYBER_LEVEL1},
     {XSTR_SIZEOF("P384_KYBER_LEVEL3"), "P384_KYBER_LEVEL3", WOLFSSL_P384_KYBER_LEVEL3},
     {XSTR_SIZEOF("P521_KYBER_LEVEL5"), "P521_KYBER_LEVEL5", WOLFSSL_P521_KYBER_LEVEL5},
@@ -3730,7 +3735,8 @@ static int isValidCurveGroup(word16 name)
         case WOLFSSL_KYBER_LEVEL1:
         case WOLFSSL_KYBER_LEVEL3:
         case WOLFSSL_KYBER_LEVEL5:
-    #ifdef HAVE_LIBOQS
+    #if defined(HAVE_LIBOQS) || \
+        (defined(WOLFSSL_WC_KYBER) && defined(HAVE_ECC))
         case WOLFSSL_P256_KYBER_LEVEL1:
         case WOLFSSL_P384_KYBER_LEVEL3:
         case WOLFSSL_P521_KYBER_LEVEL5:
@@ -20219,6 +20225,20 @@ const char* wolfSSL_get_curve_name(WOLFSSL* ssl)
         case WOLFSSL_KYBER_LEVEL5:
             return "KYBER_LEVEL5";
     #endif
+    #ifdef HAVE_ECC
+        #ifdef WOLFSSL_KYBER512
+        case WOLFSSL_P256_KYBER_LEVEL1:
+            return "P256_KYBER_LEVEL1";
+        #endif
+        #ifdef WOLFSSL_KYBER768
+        case WOLFSSL_P384_KYBER_LEVEL3:
+            return "P384_KYBER_LEVEL3";
+        #endif
+        #ifdef WOLFSSL_KYBER1024
+        case WOLFSSL_P521_KYBER_LEVEL5:
+            return "P521_KYBER_LEVEL5";
+        #endif
+    #endif
 #endif
         }
     }
@@ -75,6 +75,7 @@
 #include <wolfssl/wolfcrypt/random.h>
 #include <wolfssl/wolfcrypt/error-crypt.h>
 #include <wolfssl/wolfcrypt/asn.h>
+#include <wolfssl/wolfcrypt/cpuid.h>
 #include <wolfssl/version.h>
 
 #ifdef HAVE_CHACHA
@@ -173,6 +174,9 @@
     #ifdef HAVE_LIBLMS
         #include <wolfssl/wolfcrypt/ext_lms.h>
     #endif
+    #ifdef WOLFSSL_WC_LMS
+        #include <wolfssl/wolfcrypt/wc_lms.h>
+    #endif
 #endif
 #if defined(WOLFSSL_HAVE_XMSS) && !defined(WOLFSSL_XMSS_VERIFY_ONLY)
     #include <wolfssl/wolfcrypt/xmss.h>
@@ -596,6 +600,7 @@
 #define BENCH_BLAKE2B            0x00008000
 #define BENCH_BLAKE2S            0x00010000
 #define BENCH_SM3                0x00020000
+#define BENCH_BLAKE3             0x00040000
 
 /* MAC algorithms. */
 #define BENCH_CMAC               0x00000001
@@ -618,6 +623,8 @@
 #define BENCH_RSA_KEYGEN         0x00000001
 #define BENCH_RSA                0x00000002
 #define BENCH_RSA_SZ             0x00000004
+#define BENCH_RSA_MP             0x00000008
+#define BENCH_RSA_BATCH          0x00000100
 #define BENCH_DH                 0x00000010
 #define BENCH_KYBER              0x00000020
 #define BENCH_ECC_MAKEKEY        0x00001000
@@ -846,6 +853,9 @@ static const bench_alg bench_digest_opt[] = {
 #endif
 #ifdef HAVE_BLAKE2S
     { "-blake2s",            BENCH_BLAKE2S           },
+#endif
+#ifdef HAVE_BLAKE3
+    { "-blake3",             BENCH_BLAKE3            },
 #endif
     { NULL, 0 }
 };
@@ -904,6 +914,12 @@ static const bench_alg bench_asym_opt[] = {
     #endif
     { "-rsa",                BENCH_RSA               },
     { "-rsa-sz",             BENCH_RSA_SZ            },
+#ifdef WOLFSSL_RSA_MULTI_PRIME
+    { "-rsa-mp",             BENCH_RSA_MP            },
+#endif
+#ifdef WC_RSA_BATCH
+    { "-rsa-batch",          BENCH_RSA_BATCH         },
+#endif
 #endif
 #ifndef NO_DH
     { "-dh",                 BENCH_DH                },
@@ -1153,11 +1169,11 @@ static const char* bench_result_words1[][4] = {
     defined(HAVE_CURVE448_SHARED_SECRET) || defined(HAVE_ED448) || \
     defined(WOLFSSL_HAVE_KYBER)
 
-static const char* bench_desc_words[][15] = {
-    /* 0           1          2         3        4        5         6            7            8          9        10        11       12          13       14 */
-    {"public", "private", "key gen", "agree" , "sign", "verify", "encrypt", "decrypt", "rsk gen", "encap", "derive", "valid", "pair gen", "decap", NULL}, /* 0 English */
+static const char* bench_desc_words[][16] = {
+    /* 0           1          2         3        4        5         6            7            8          9        10        11       12          13       14           15 */
+    {"public", "private", "key gen", "agree" , "sign", "verify", "encrypt", "decrypt", "rsk gen", "encap", "derive", "valid", "pair gen", "decap", "multi mul", NULL}, /* 0 English */
 #ifndef NO_MULTIBYTE_PRINT
-    {"公開鍵", "秘密鍵" ,"鍵生成" , "鍵共有" , "署名", "検証"  , "暗号化"    , "復号化"    , "rsk gen", "encap", "derive", "valid", "pair gen", "decap", NULL}, /* 1 Japanese */
+    {"公開鍵", "秘密鍵" ,"鍵生成" , "鍵共有" , "署名", "検証"  , "暗号化"    , "復号化"    , "rsk gen", "encap", "derive", "valid", "pair gen", "decap", "multi mul", NULL}, /* 1 Japanese */
 #endif
 };
 
@@ -1547,6 +1563,9 @@ static const char* bench_result_words3[][5] = {
 #if defined(HAVE_BLAKE2) || defined(HAVE_BLAKE2S)
     #include <wolfssl/wolfcrypt/blake2.h>
 #endif
+#ifdef HAVE_BLAKE3
+    #include <wolfssl/wolfcrypt/blake3.h>
+#endif
 
 #ifdef _MSC_VER
     /* 4996 warning to use MS extensions e.g., strcpy_s instead of strncpy */
@@ -2824,6 +2843,55 @@ static WC_INLINE void bench_stats_free(void)
 /*****************************************************************************/
 
 
+#if defined(HAVE_CPUID_INTEL) && defined(USE_INTEL_SPEEDUP) && \
+    (!defined(NO_SHA) || !defined(NO_SHA256))
+static int bench_sha_no_ni = 0;
+#define BENCH_SHA_DESC(desc, descNoNi)  (bench_sha_no_ni ? (descNoNi) : (desc))
+
+/* Run a SHA benchmark again with the SHA extensions disabled so the SHA-NI
+ * transform can be compared with the AVX and C transforms. */
+static void bench_sha_without_ni(void (*bench)(int))
+{
+    word32 flags = cpuid_get_flags();
+
+    if (!IS_INTEL_SHA(flags))
+        return;
+
+    cpuid_clear_flag(CPUID_SHA);
+    bench_sha_no_ni = 1;
+    bench(0);
+    bench_sha_no_ni = 0;
+    cpuid_select_flags(flags);
+}
+#else
+#define BENCH_SHA_DESC(desc, descNoNi)  (desc)
+#endif
+
+#if defined(HAVE_CPUID_INTEL) && defined(USE_INTEL_SPEEDUP) && \
+    (defined(HAVE_BLAKE2) || defined(HAVE_BLAKE2S))
+static int bench_blake2_no_simd = 0;
+#define BENCH_BLAKE2_DESC(desc, descNoSimd) \
+    (bench_blake2_no_simd ? (descNoSimd) : (desc))
+
+/* Run a BLAKE2 benchmark again with the vector extension used by its
+ * compression function disabled so it can be compared with the C code. */
+static void bench_blake2_without_simd(void (*bench)(void), word32 flag)
+{
+    word32 flags = cpuid_get_flags();
+
+    if ((flags & flag) == 0)
+        return;
+
+    cpuid_clear_flag(flag);
+    bench_blake2_no_simd = 1;
+    bench();
+    bench_blake2_no_simd = 0;
+    cpuid_select_flags(flags);
+}
+#else
+#define BENCH_BLAKE2_DESC(desc, descNoSimd)  (desc)
+#endif
+
 static void* benchmarks_do(void* args)
 {
     long bench_buf_size;
@@ -3141,8 +3209,10 @@ static void* benchmarks_do(void* args)
         bench_chacha();
 #endif
 #if defined(HAVE_CHACHA) && defined(HAVE_POLY1305)
-    if (bench_all || (bench_cipher_algs & BENCH_CHACHA20_POLY1305))
+    if (bench_all || (bench_cipher_algs & BENCH_CHACHA20_POLY1305)) {
         bench_chacha20_poly1305_aead();
+        bench_chacha20_poly1305_records();
+    }
 #endif
 #ifndef NO_DES3
     if (bench_all || (bench_cipher_algs & BENCH_DES)) {
@@ -3172,6 +3242,9 @@ static void* benchmarks_do(void* args)
     if (bench_all || (bench_digest_algs & BENCH_SHA)) {
     #ifndef NO_SW_BENCH
         bench_sha(0);
+        #if defined(HAVE_CPUID_INTEL) && defined(USE_INTEL_SPEEDUP)
+        bench_sha_without_ni(bench_sha);
+        #endif
     #endif
     #ifdef BENCH_DEVID
         bench_sha(1);
@@ -3182,6 +3255,9 @@ static void* benchmarks_do(void* args)
     if (bench_all || (bench_digest_algs & BENCH_SHA224)) {
     #ifndef NO_SW_BENCH
         bench_sha224(0);
+        #if defined(HAVE_CPUID_INTEL) && defined(USE_INTEL_SPEEDUP)
+        bench_sha_without_ni(bench_sha224);
+        #endif
     #endif
     #ifdef BENCH_DEVID
         bench_sha224(1);
@@ -3192,6 +3268,15 @@ static void* benchmarks_do(void* args)
     if (bench_all || (bench_digest_algs & BENCH_SHA256)) {
     #ifndef NO_SW_BENCH
         bench_sha256(0);
+        #if defined(HAVE_CPUID_INTEL) && defined(USE_INTEL_SPEEDUP)
+        bench_sha_without_ni(bench_sha256);
+        #endif
+        #ifdef WOLFSSL_SHA256_MULTI
+        bench_sha256_multi(0);
+            #if defined(HAVE_CPUID_INTEL) && defined(USE_INTEL_SPEEDUP)
+        bench_sha_without_ni(bench_sha256_multi);
+            #endif
+        #endif
     #endif
     #ifdef BENCH_DEVID
         bench_sha256(1);
@@ -3288,6 +3373,7 @@ static void* benchmarks_do(void* args)
     if (bench_all || (bench_digest_algs & BENCH_SHAKE128)) {
     #ifndef NO_SW_BENCH
         bench_shake128(0);
+        bench_shake128x4();
     #endif
     #ifdef BENCH_DEVID
         bench_shake128(1);
@@ -3298,6 +3384,7 @@ static void* benchmarks_do(void* args)
     if (bench_all || (bench_digest_algs & BENCH_SHAKE256)) {
     #ifndef NO_SW_BENCH
         bench_shake256(0);
+        bench_shake256x4();
     #endif
     #ifdef BENCH_DEVID
         bench_shake256(1);
@@ -3320,12 +3407,26 @@ static void* benchmarks_do(void* args)
         bench_ripemd();
 #endif
 #ifdef HAVE_BLAKE2
-    if (bench_all || (bench_digest_algs & BENCH_BLAKE2B))
+    if (bench_all || (bench_digest_algs & BENCH_BLAKE2B)) {
         bench_blake2b();
+    #if defined(HAVE_CPUID_INTEL) && defined(USE_INTEL_SPEEDUP)
+        bench_blake2_without_simd(bench_blake2b, CPUID_AVX2);
+    #endif
+        bench_blake2bp();
+    }
 #endif
 #ifdef HAVE_BLAKE2S
-    if (bench_all || (bench_digest_algs & BENCH_BLAKE2S))
+    if (bench_all || (bench_digest_algs & BENCH_BLAKE2S)) {
         bench_blake2s();
+    #if defined(HAVE_CPUID_INTEL) && defined(USE_INTEL_SPEEDUP)
+        bench_blake2_without_simd(bench_blake2s, CPUID_AVX1);
+    #endif
+        bench_blake2sp();
+    }
+#endif
+#ifdef HAVE_BLAKE3
+    if (bench_all || (bench_digest_algs & BENCH_BLAKE3))
+        bench_blake3();
 #endif
 #ifdef WOLFSSL_CMAC
     if (bench_all || (bench_mac_algs & BENCH_CMAC)) {
@@ -3462,6 +3563,28 @@ static void* benchmarks_do(void* args)
     #endif
     }
     #endif
+
+    #if defined(WOLFSSL_RSA_MULTI_PRIME) && defined(WOLFSSL_KEY_GEN)
+    if (bench_asym_algs & BENCH_RSA_MP) {
+    #ifndef NO_SW_BENCH
+        bench_rsa_multiprime(0);
+    #endif
+    #ifdef BENCH_DEVID
+        bench_rsa_multiprime(1);
+    #endif
+    }
+    #endif
+
+    #ifdef WC_RSA_BATCH
+    if (bench_asym_algs & BENCH_RSA_BATCH) {
+    #ifndef NO_SW_BENCH
+        bench_rsa_batch(0);
+    #endif
+    #ifdef BENCH_DEVID
+        bench_rsa_batch(1);
+    #endif
+    }
+    #endif
 #endif
 #endif
 
@@ -4007,6 +4130,20 @@ exit_rng:
 
 #ifndef NO_AES
 
+/* Software AES core compiled in. Used to label rows of small messages so
+ * builds with the T-table and bit-sliced cores can be compared where the
+ * number of blocks per call matters. Not defined when AES instructions
+ * replace the software core. */
+#if defined(WOLFSSL_AESNI) || defined(WOLFSSL_ARMASM) || \
+    defined(WOLFSSL_RISCV_ASM)
+#elif defined(WC_AES_BITSLICED_NARROW)
+    #define BENCH_AES_CORE  "bs-narrow"
+#elif defined(WC_AES_BITSLICED)
+    #define BENCH_AES_CORE  "bs-wide"
+#else
+    #define BENCH_AES_CORE  "table"
+#endif
+
 #ifdef HAVE_AES_CBC
 static void bench_aescbc_internal(int useDeviceID,
                                   const byte* key, word32 keySz,
@@ -4521,6 +4658,27 @@ void bench_aesgcm(int useDeviceID)
                           AES_GCM_STRING(256, enc), AES_GCM_STRING(256, dec));
 #endif
 #endif
+#if defined(BENCH_AES_CORE) && defined(WOLFSSL_AES_128) && \
+    !defined(HAVE_RENESAS_SYNC)
+    {
+        word32 benchSize = bench_size;
+
+    #undef AES_GCM_STRING
+    #define AES_GCM_STRING(sz, dir) \
+        AES_AAD_STRING("AES-128-GCM-" #dir "-" BENCH_AES_CORE "-" #sz "B")
+        bench_size = 16;
+        bench_aesgcm_internal(useDeviceID, bench_key, 16, bench_iv, 12,
+                              AES_GCM_STRING(16, enc), AES_GCM_STRING(16, dec));
+        bench_size = 64;
+        bench_aesgcm_internal(useDeviceID, bench_key, 16, bench_iv, 12,
+                              AES_GCM_STRING(64, enc), AES_GCM_STRING(64, dec));
+        bench_size = 256;
+        bench_aesgcm_internal(useDeviceID, bench_key, 16, bench_iv, 12,
+                              AES_GCM_STRING(256, enc),
+                              AES_GCM_STRING(256, dec));
+        bench_size = benchSize;
+    }
+#endif
 #ifdef WOLFSSL_AESGCM_STREAM
 #undef AES_GCM_STRING
 #define AES_GCM_STRING(n, dir)  AES_AAD_STRING("AES-" #n "-GCM-STREAM-" #dir)
@@ -4559,6 +4717,8 @@ void bench_gmac(int useDeviceID)
     const char* gmacStr = "GMAC Table";
 #elif defined(GCM_TABLE_4BIT)
     const char* gmacStr = "GMAC Table 4-bit";
+#elif defined(GCM_CTMUL64)
+    const char* gmacStr = "GMAC CT-Mul64";
 #elif defined(GCM_WORD32)
     const char* gmacStr = "GMAC Word32";
 #else
@@ -4875,7 +5035,10 @@ void bench_aesofb(void)
 
 
 #ifdef WOLFSSL_AES_XTS
-void bench_aesxts(void)
+/* threads is 0 to encrypt each block as one data unit, otherwise the block is
+ * encrypted as consecutive 4 KiB sectors split across that many threads. */
+static void bench_aesxts_internal(word32 threads, const char* encLabel,
+    const char* decLabel)
 {
     XtsAes aes;
     double start;
@@ -4900,12 +5063,23 @@ void bench_aesxts(void)
         printf("wc_AesXtsSetKey failed, ret = %d\n", ret);
         return;
     }
+#if defined(WOLFSSL_AESXTS_THREADS) && !defined(SINGLE_THREADED)
+    if (threads > 1)
+        (void)wc_AesXtsSetThreads(&aes, threads);
+#endif
 
     bench_stats_start(&count, &start);
     do {
         for (i = 0; i < numBlocks; i++) {
-            if ((ret = wc_AesXtsEncrypt(&aes, bench_cipher, bench_plain,
-                            bench_size, i1, sizeof(i1))) != 0) {
+            if (threads == 0) {
+                ret = wc_AesXtsEncrypt(&aes, bench_cipher, bench_plain,
+                                       bench_size, i1, sizeof(i1));
+            }
+            else {
+                ret = wc_AesXtsEncryptConsecutiveSectors(&aes, bench_cipher,
+                          bench_plain, bench_size, (word64)i, 4096);
+            }
+            if (ret != 0) {
                 printf("wc_AesXtsEncrypt failed, ret = %d\n", ret);
                 return;
             }
@@ -4918,7 +5092,7 @@ void bench_aesxts(void)
 #endif
            );
 
-    bench_stats_sym_finish("AES-XTS-enc", 0, count, bench_size, start, ret);
+    bench_stats_sym_finish(encLabel, 0, count, bench_size, start, ret);
 #ifdef MULTI_VALUE_STATISTICS
     bench_multi_value_stats(max, min, sum, squareSum, runs);
 #endif
@@ -4931,14 +5105,25 @@ void bench_aesxts(void)
         printf("wc_AesXtsSetKey failed, ret = %d\n", ret);
         return;
     }
+#if defined(WOLFSSL_AESXTS_THREADS) && !defined(SINGLE_THREADED)
+    if (threads > 1)
+        (void)wc_AesXtsSetThreads(&aes, threads);
+#endif
 
     RESET_MULTI_VALUE_STATS_VARS();
 
     bench_stats_start(&count, &start);
     do {
         for (i = 0; i < numBlocks; i++) {
-            if ((ret = wc_AesXtsDecrypt(&aes, bench_plain, bench_cipher,
-                            bench_size, i1, sizeof(i1))) != 0) {
+            if (threads == 0) {
+                ret = wc_AesXtsDecrypt(&aes, bench_plain, bench_cipher,
+                                       bench_size, i1, sizeof(i1));
+            }
+            else {
+                ret = wc_AesXtsDecryptConsecutiveSectors(&aes, bench_plain,
+                          bench_cipher, bench_size, (word64)i, 4096);
+            }
+            if (ret != 0) {
                 printf("wc_AesXtsDecrypt failed, ret = %d\n", ret);
                 return;
             }
@@ -4951,12 +5136,25 @@ void bench_aesxts(void)
 #endif
            );
 
-    bench_stats_sym_finish("AES-XTS-dec", 0, count, bench_size, start, ret);
+    bench_stats_sym_finish(decLabel, 0, count, bench_size, start, ret);
 #ifdef MULTI_VALUE_STATISTICS
     bench_multi_value_stats(max, min, sum, squareSum, runs);
 #endif
     wc_AesXtsFree(&aes);
 }
+
+/* Threads only split runs of at least 64 KiB each, so pass a block size of
+ * several MiB to see them scale. */
+void bench_aesxts(void)
+{
+    bench_aesxts_internal(0, "AES-XTS-enc", "AES-XTS-dec");
+#if defined(WOLFSSL_AESXTS_THREADS) && !defined(SINGLE_THREADED)
+    bench_aesxts_internal(1, "AES-XTS-4K-enc", "AES-XTS-4K-dec");
+    bench_aesxts_internal(2, "AES-XTS-4K-2thr-enc", "AES-XTS-4K-2thr-dec");
+    bench_aesxts_internal(4, "AES-XTS-4K-4thr-enc", "AES-XTS-4K-4thr-dec");
+    bench_aesxts_internal(8, "AES-XTS-4K-8thr-enc", "AES-XTS-4K-8thr-dec");
+#endif
+}
 #endif /* WOLFSSL_AES_XTS */
 
 
@@ -5016,6 +5214,23 @@ void bench_aesctr(int useDeviceID)
 #ifdef WOLFSSL_AES_256
     bench_aesctr_internal(bench_key, 32, bench_iv, "AES-256-CTR", useDeviceID);
 #endif
+#if defined(BENCH_AES_CORE) && defined(WOLFSSL_AES_128)
+    {
+        word32 benchSize = bench_size;
+
+        bench_size = 16;
+        bench_aesctr_internal(bench_key, 16, bench_iv,
+                              "AES-128-CTR-" BENCH_AES_CORE "-16B", useDeviceID);
+        bench_size = 64;
+        bench_aesctr_internal(bench_key, 16, bench_iv,
+                              "AES-128-CTR-" BENCH_AES_CORE "-64B", useDeviceID);
+        bench_size = 256;
+        bench_aesctr_internal(bench_key, 16, bench_iv,
+                              "AES-128-CTR-" BENCH_AES_CORE "-256B",
+                              useDeviceID);
+        bench_size = benchSize;
+    }
+#endif
 }
 #endif /* WOLFSSL_AES_COUNTER */
 
@@ -5719,6 +5934,80 @@ void bench_chacha20_poly1305_aead(void)
     bench_multi_value_stats(max, min, sum, squareSum, runs);
 #endif
 }
+
+/* Encrypt the benchmark data as records of recSz bytes, each with a 13 byte
+ * TLS header as AAD, the way a TLS connection uses the AEAD. */
+static void bench_chacha20_poly1305_record_run(word32 recSz, const char* desc)
+{
+    double start;
+    int    ret = 0, i, count;
+    word32 off;
+    word32 sz = (bench_size / recSz) * recSz;
+    DECLARE_MULTI_VALUE_STATS_VARS()
+
+    byte authTag[CHACHA20_POLY1305_AEAD_AUTHTAG_SIZE];
+    byte aad[13];
+    XMEMSET(authTag, 0, sizeof(authTag));
+    XMEMSET(aad, 0x17, sizeof(aad));
+
+    if (sz == 0)
+        return;
+
+    bench_stats_start(&count, &start);
+    do {
+        for (i = 0; i < numBlocks; i++) {
+            for (off = 0; (ret == 0) && (off < sz); off += recSz) {
+                ret = wc_ChaCha20Poly1305_Encrypt(bench_key, bench_iv, aad,
+                    sizeof(aad), bench_plain + off, recSz, bench_cipher + off,
+                    authTag);
+            }
+            if (ret < 0) {
+                printf("wc_ChaCha20Poly1305_Encrypt error: %d\n", ret);
+                break;
+            }
+            RECORD_MULTI_VALUE_STATS();
+        }
+        count += i;
+    } while (bench_stats_check(start)
+#ifdef MULTI_VALUE_STATISTICS
+        || runs < minimum_runs
+#endif
+        );
+
+    bench_stats_sym_finish(desc, 0, count, sz, start, ret);
+#ifdef MULTI_VALUE_STATISTICS
+    bench_multi_value_stats(max, min, sum, squareSum, runs);
+#endif
+}
+
+/* Run the record benchmark and, when AVX2 is in use, again with the
+ * stitched kernel disabled. ChaCha20 and Poly1305 keep the SIMD code they
+ * picked on first use so the second run is their two pass AVX2 code. */
+static void bench_chacha20_poly1305_record(word32 recSz, const char* desc,
+    const char* descTwoPass)
+{
+    bench_chacha20_poly1305_record_run(recSz, desc);
+#if defined(HAVE_CPUID_INTEL) && defined(USE_INTEL_SPEEDUP)
+    {
+        word32 flags = cpuid_get_flags();
+
+        if (IS_INTEL_AVX2(flags)) {
+            cpuid_clear_flag(CPUID_AVX2);
+            bench_chacha20_poly1305_record_run(recSz, descTwoPass);
+            cpuid_select_flags(flags);
+        }
+    }
+#else
+    (void)descTwoPass;
+#endif
+}
+
+void bench_chacha20_poly1305_records(void)
+{
+    bench_chacha20_poly1305_record(1024, "CHA-POLY-1K", "CHA-POLY-1K-2pass");
+    bench_chacha20_poly1305_record(16384, "CHA-POLY-16K",
+        "CHA-POLY-16K-2pass");
+}
 #endif /* HAVE_CHACHA && HAVE_POLY1305 */
 
 
@@ -5930,7 +6219,8 @@ void bench_sha(int useDeviceID)
         );
     }
 exit_sha:
-    bench_stats_sym_finish("SHA", useDeviceID, count, bench_size, start, ret);
+    bench_stats_sym_finish(BENCH_SHA_DESC("SHA", "SHA-noNI"), useDeviceID,
+                           count, bench_size, start, ret);
 #ifdef MULTI_VALUE_STATISTICS
     bench_multi_value_stats(max, min, sum, squareSum, runs);
 #endif
@@ -6036,8 +6326,8 @@ void bench_sha224(int useDeviceID)
         );
     }
 exit_sha224:
-    bench_stats_sym_finish("SHA-224", useDeviceID, count,
-                           bench_size, start, ret);
+    bench_stats_sym_finish(BENCH_SHA_DESC("SHA-224", "SHA-224-noNI"),
+                           useDeviceID, count, bench_size, start, ret);
 #ifdef MULTI_VALUE_STATISTICS
     bench_multi_value_stats(max, min, sum, squareSum, runs);
 #endif
@@ -6147,8 +6437,8 @@ void bench_sha256(int useDeviceID)
            );
     }
 exit_sha256:
-    bench_stats_sym_finish("SHA-256", useDeviceID, count, bench_size,
-                           start, ret);
+    bench_stats_sym_finish(BENCH_SHA_DESC("SHA-256", "SHA-256-noNI"),
+                           useDeviceID, count, bench_size, start, ret);
 #ifdef MULTI_VALUE_STATISTICS
     bench_multi_value_stats(max, min, sum, squareSum, runs);
 #endif
@@ -6159,6 +6449,56 @@ exit:
 
     WC_FREE_ARRAY(digest, BENCH_MAX_PENDING, HEAP_HINT);
 }
+
+#ifdef WOLFSSL_SHA256_MULTI
+#define BENCH_SHA256_MULTI_CNT  8
+/* Hash several buffers per call and report the aggregate throughput. */
+void bench_sha256_multi(int useDeviceID)
+{
+    const byte* data[BENCH_SHA256_MULTI_CNT];
+    word32 len[BENCH_SHA256_MULTI_CNT];
+    byte* hash[BENCH_SHA256_MULTI_CNT];
+    double start;
+    int    ret = 0, i, count = 0, times;
+    DECLARE_MULTI_VALUE_STATS_VARS()
+    WC_DECLARE_ARRAY(digest, byte, BENCH_SHA256_MULTI_CNT,
+                     WC_SHA256_DIGEST_SIZE, HEAP_HINT);
+    WC_INIT_ARRAY(digest, byte, BENCH_SHA256_MULTI_CNT,
+                  WC_SHA256_DIGEST_SIZE, HEAP_HINT);
+
+    for (i = 0; i < BENCH_SHA256_MULTI_CNT; i++) {
+        data[i] = bench_plain;
+        len[i] = bench_size;
+        hash[i] = digest[i];
+    }
+
+    bench_stats_start(&count, &start);
+    do {
+        for (times = 0; times < numBlocks; times++) {
+            ret = wc_Sha256HashMulti_ex(data, len, hash,
+                BENCH_SHA256_MULTI_CNT, HEAP_HINT,
+                useDeviceID ? devId : INVALID_DEVID);
+            if (ret != 0)
+                goto exit_sha256_multi;
+            RECORD_MULTI_VALUE_STATS();
+        } /* for times */
+        count += times * BENCH_SHA256_MULTI_CNT;
+    } while (bench_stats_check(start)
+    #ifdef MULTI_VALUE_STATISTICS
+       || runs < minimum_runs
+    #endif
+       );
+exit_sha256_multi:
+    bench_stats_sym_finish(
+        BENCH_SHA_DESC("SHA-256-multi", "SHA-256-multi-noNI"), useDeviceID,
+        count, bench_size, start, ret);
+#ifdef MULTI_VALUE_STATISTICS
+    bench_multi_value_stats(max, min, sum, squareSum, runs);
+#endif
+
+    WC_FREE_ARRAY(digest, BENCH_SHA256_MULTI_CNT, HEAP_HINT);
+}
+#endif /* WOLFSSL_SHA256_MULTI */
 #endif
 
 #ifdef WOLFSSL_SHA384
@@ -7239,6 +7579,98 @@ exit:
     WC_FREE_ARRAY(digest, BENCH_MAX_PENDING, HEAP_HINT);
 }
 #endif /* WOLFSSL_SHAKE256 */
+
+#if defined(WOLFSSL_SHAKE128) || defined(WOLFSSL_SHAKE256)
+/* Absorb the buffer into four SHAKE states at once and squeeze a block from
+ * each, reporting the throughput over the four states. */
+static void bench_shakex4_run(int shake256, const char* desc)
+{
+    wc_Shakex4 x4;
+    const byte* data[4];
+    byte* out[4];
+    double start;
+    int    ret = 0, i, count = 0, times;
+    DECLARE_MULTI_VALUE_STATS_VARS()
+    WC_DECLARE_ARRAY(digest, byte, 4, WC_SHA3_128_BLOCK_SIZE, HEAP_HINT);
+    WC_INIT_ARRAY(digest, byte, 4, WC_SHA3_128_BLOCK_SIZE, HEAP_HINT);
+
+    for (i = 0; i < 4; i++) {
+        data[i] = bench_plain;
+        out[i] = digest[i];
+    }
+
+    bench_stats_start(&count, &start);
+    do {
+        for (times = 0; times < numBlocks; times++) {
+        #ifdef WOLFSSL_SHAKE256
+            if (shake256) {
+                ret = wc_Shake256x4_Absorb(&x4, data, bench_size);
+                if (ret == 0)
+                    ret = wc_Shake256x4_SqueezeBlocks(&x4, out, 1);
+            }
+        #endif
+        #ifdef WOLFSSL_SHAKE128
+            if (!shake256) {
+                ret = wc_Shake128x4_Absorb(&x4, data, bench_size);
+                if (ret == 0)
+                    ret = wc_Shake128x4_SqueezeBlocks(&x4, out, 1);
+            }
+        #endif
+            if (ret != 0)
+                goto exit_shakex4;
+            RECORD_MULTI_VALUE_STATS();
+        } /* for times */
+        count += times * 4;
+    } while (bench_stats_check(start)
+    #ifdef MULTI_VALUE_STATISTICS
+       || runs < minimum_runs
+    #endif
+       );
+exit_shakex4:
+    bench_stats_sym_finish(desc, 0, count, bench_size, start, ret);
+#ifdef MULTI_VALUE_STATISTICS
+    bench_multi_value_stats(max, min, sum, squareSum, runs);
+#endif
+
+    wc_Shakex4_Free(&x4);
+    WC_FREE_ARRAY(digest, 4, HEAP_HINT);
+}
+
+/* Run the four state benchmark and, when AVX2 is in use, again with the
+ * states permuted one at a time. */
+static void bench_shakex4(int shake256, const char* desc,
+    const char* descNoAvx2)
+{
+    bench_shakex4_run(shake256, desc);
+#if defined(HAVE_CPUID_INTEL) && defined(USE_INTEL_SPEEDUP)
+    {
+        word32 flags = cpuid_get_flags();
+
+        if (IS_INTEL_AVX2(flags)) {
+            cpuid_clear_flag(CPUID_AVX2);
+            bench_shakex4_run(shake256, descNoAvx2);
+            cpuid_select_flags(flags);
+        }
+    }
+#else
+    (void)descNoAvx2;
+#endif
+}
+#endif
+
+#ifdef WOLFSSL_SHAKE128
+void bench_shake128x4(void)
+{
+    bench_shakex4(0, "SHAKE128-x4", "SHAKE128-x4-noAVX2");
+}
+#endif
+
+#ifdef WOLFSSL_SHAKE256
+void bench_shake256x4(void)
+{
+    bench_shakex4(1, "SHAKE256-x4", "SHAKE256-x4-noAVX2");
+}
+#endif
 #endif
 
 #ifdef WOLFSSL_SM3
@@ -7489,7 +7921,79 @@ void bench_blake2b(void)
     #endif
            );
     }
-    bench_stats_sym_finish("BLAKE2b", 0, count, bench_size, start, ret);
+    bench_stats_sym_finish(BENCH_BLAKE2_DESC("BLAKE2b", "BLAKE2b-noAVX2"), 0,
+        count, bench_size, start, ret);
+#ifdef MULTI_VALUE_STATISTICS
+    bench_multi_value_stats(max, min, sum, squareSum, runs);
+#endif
+}
+
+void bench_blake2bp(void)
+{
+    Blake2bp b2bp;
+    byte    digest[64];
+    double  start;
+    int     ret = 0, i, count;
+    DECLARE_MULTI_VALUE_STATS_VARS()
+
+    if (digest_stream) {
+        ret = wc_InitBlake2bp(&b2bp, 64);
+        if (ret != 0) {
+            printf("InitBlake2bp failed, ret = %d\n", ret);
+            return;
+        }
+
+        bench_stats_start(&count, &start);
+        do {
+            for (i = 0; i < numBlocks; i++) {
+                ret = wc_Blake2bpUpdate(&b2bp, bench_plain, bench_size);
+                if (ret != 0) {
+                    printf("Blake2bpUpdate failed, ret = %d\n", ret);
+                    return;
+                }
+                RECORD_MULTI_VALUE_STATS();
+            }
+            ret = wc_Blake2bpFinal(&b2bp, digest, 64);
+            if (ret != 0) {
+                printf("Blake2bpFinal failed, ret = %d\n", ret);
+                return;
+            }
+            count += i;
+        } while (bench_stats_check(start)
+    #ifdef MULTI_VALUE_STATISTICS
+           || runs < minimum_runs
+    #endif
+           );
+    }
+    else {
+        bench_stats_start(&count, &start);
+        do {
+            for (i = 0; i < numBlocks; i++) {
+                ret = wc_InitBlake2bp(&b2bp, 64);
+                if (ret != 0) {
+                    printf("InitBlake2bp failed, ret = %d\n", ret);
+                    return;
+                }
+                ret = wc_Blake2bpUpdate(&b2bp, bench_plain, bench_size);
+                if (ret != 0) {
+                    printf("Blake2bpUpdate failed, ret = %d\n", ret);
+                    return;
+                }
+                ret = wc_Blake2bpFinal(&b2bp, digest, 64);
+                if (ret != 0) {
+                    printf("Blake2bpFinal failed, ret = %d\n", ret);
+                    return;
+                }
+                RECORD_MULTI_VALUE_STATS();
+            }
+            count += i;
+        } while (bench_stats_check(start)
+    #ifdef MULTI_VALUE_STATISTICS
+           || runs < minimum_runs
+    #endif
+           );
+    }
+    bench_stats_sym_finish("BLAKE2bp", 0, count, bench_size, start, ret);
 #ifdef MULTI_VALUE_STATISTICS
     bench_multi_value_stats(max, min, sum, squareSum, runs);
 #endif
@@ -7562,17 +8066,183 @@ void bench_blake2s(void)
     #endif
            );
     }
-    bench_stats_sym_finish("BLAKE2s", 0, count, bench_size, start, ret);
+    bench_stats_sym_finish(BENCH_BLAKE2_DESC("BLAKE2s", "BLAKE2s-noAVX"), 0,
+        count, bench_size, start, ret);
 #ifdef MULTI_VALUE_STATISTICS
     bench_multi_value_stats(max, min, sum, squareSum, runs);
 #endif
 }
-#endif
 
-
-#ifdef WOLFSSL_CMAC
-
-static void bench_cmac_helper(word32 keySz, const char* outMsg, int useDeviceID)
+void bench_blake2sp(void)
+{
+    Blake2sp b2sp;
+    byte    digest[32];
+    double  start;
+    int     ret = 0, i, count;
+    DECLARE_MULTI_VALUE_STATS_VARS()
+
+    if (digest_stream) {
+        ret = wc_InitBlake2sp(&b2sp, 32);
+        if (ret != 0) {
+            printf("InitBlake2sp failed, ret = %d\n", ret);
+            return;
+        }
+
+        bench_stats_start(&count, &start);
+        do {
+            for (i = 0; i < numBlocks; i++) {
+                ret = wc_Blake2spUpdate(&b2sp, bench_plain, bench_size);
+                if (ret != 0) {
+                    printf("Blake2spUpdate failed, ret = %d\n", ret);
+                    return;
+                }
+                RECORD_MULTI_VALUE_STATS();
+            }
+            ret = wc_Blake2spFinal(&b2sp, digest, 32);
+            if (ret != 0) {
+                printf("Blake2spFinal failed, ret = %d\n", ret);
+                return;
+            }
+            count += i;
+        } while (bench_stats_check(start)
+    #ifdef MULTI_VALUE_STATISTICS
+           || runs < minimum_runs
+    #endif
+           );
+    }
+    else {
+        bench_stats_start(&count, &start);
+        do {
+            for (i = 0; i < numBlocks; i++) {
+                ret = wc_InitBlake2sp(&b2sp, 32);
+                if (ret != 0) {
+                    printf("InitBlake2sp failed, ret = %d\n", ret);
+                    return;
+                }
+                ret = wc_Blake2spUpdate(&b2sp, bench_plain, bench_size);
+                if (ret != 0) {
+                    printf("Blake2spUpdate failed, ret = %d\n", ret);
+                    return;
+                }
+                ret = wc_Blake2spFinal(&b2sp, digest, 32);
+                if (ret != 0) {
+                    printf("Blake2spFinal failed, ret = %d\n", ret);
+                    return;
+                }
+                RECORD_MULTI_VALUE_STATS();
+            }
+            count += i;
+        } while (bench_stats_check(start)
+    #ifdef MULTI_VALUE_STATISTICS
+           || runs < minimum_runs
+    #endif
+           );
+    }
+    bench_stats_sym_finish("BLAKE2sp", 0, count, bench_size, start, ret);
+#ifdef MULTI_VALUE_STATISTICS
+    bench_multi_value_stats(max, min, sum, squareSum, runs);
+#endif
+}
+#endif
+
+#ifdef HAVE_BLAKE3
+static void bench_blake3_threads(word32 threads, const char* desc)
+{
+    Blake3  b3;
+    byte    digest[BLAKE3_OUTBYTES];
+    double  start;
+    int     ret = 0, i, count;
+    DECLARE_MULTI_VALUE_STATS_VARS()
+
+    if (digest_stream) {
+        ret = wc_InitBlake3(&b3, BLAKE3_OUTBYTES);
+    #if defined(WOLFSSL_BLAKE3_THREADS) && !defined(SINGLE_THREADED)
+        if (ret == 0)
+            ret = wc_Blake3SetThreads(&b3, threads);
+    #endif
+        if (ret != 0) {
+            printf("InitBlake3 failed, ret = %d\n", ret);
+            return;
+        }
+
+        bench_stats_start(&count, &start);
+        do {
+            for (i = 0; i < numBlocks; i++) {
+                ret = wc_Blake3Update(&b3, bench_plain, bench_size);
+                if (ret != 0) {
+                    printf("Blake3Update failed, ret = %d\n", ret);
+                    return;
+                }
+                RECORD_MULTI_VALUE_STATS();
+            }
+            ret = wc_Blake3Final(&b3, digest, BLAKE3_OUTBYTES);
+            if (ret != 0) {
+                printf("Blake3Final failed, ret = %d\n", ret);
+                return;
+            }
+            count += i;
+        } while (bench_stats_check(start)
+    #ifdef MULTI_VALUE_STATISTICS
+           || runs < minimum_runs
+    #endif
+           );
+    }
+    else {
+        bench_stats_start(&count, &start);
+        do {
+            for (i = 0; i < numBlocks; i++) {
+                ret = wc_InitBlake3(&b3, BLAKE3_OUTBYTES);
+            #if defined(WOLFSSL_BLAKE3_THREADS) && !defined(SINGLE_THREADED)
+                if (ret == 0)
+                    ret = wc_Blake3SetThreads(&b3, threads);
+            #endif
+                if (ret != 0) {
+                    printf("InitBlake3 failed, ret = %d\n", ret);
+                    return;
+                }
+                ret = wc_Blake3Update(&b3, bench_plain, bench_size);
+                if (ret != 0) {
+                    printf("Blake3Update failed, ret = %d\n", ret);
+                    return;
+                }
+                ret = wc_Blake3Final(&b3, digest, BLAKE3_OUTBYTES);
+                if (ret != 0) {
+                    printf("Blake3Final failed, ret = %d\n", ret);
+                    return;
+                }
+                RECORD_MULTI_VALUE_STATS();
+            }
+            count += i;
+        } while (bench_stats_check(start)
+    #ifdef MULTI_VALUE_STATISTICS
+           || runs < minimum_runs
+    #endif
+           );
+    }
+    bench_stats_sym_finish(desc, 0, count, bench_size, start, ret);
+#ifdef MULTI_VALUE_STATISTICS
+    bench_multi_value_stats(max, min, sum, squareSum, runs);
+#endif
+    (void)threads;
+}
+
+/* Threads only split subtrees of large inputs, so pass a block size of
+ * several MiB to see them scale. */
+void bench_blake3(void)
+{
+    bench_blake3_threads(1, "BLAKE3");
+#if defined(WOLFSSL_BLAKE3_THREADS) && !defined(SINGLE_THREADED)
+    bench_blake3_threads(2, "BLAKE3-2thr");
+    bench_blake3_threads(4, "BLAKE3-4thr");
+    bench_blake3_threads(8, "BLAKE3-8thr");
+#endif
+}
+#endif
+
+
+#ifdef WOLFSSL_CMAC
+
+static void bench_cmac_helper(word32 keySz, const char* outMsg, int useDeviceID)
 {
     Cmac    cmac;
     byte    digest[AES_BLOCK_SIZE];
@@ -8086,8 +8756,23 @@ void bench_srtpkdf(void)
 
 #ifndef NO_RSA
 
+#if defined(WOLFSSL_RSA_MULTI_PRIME) && defined(WOLFSSL_KEY_GEN)
+/* Algorithm name to report for a key with the given number of primes. */
+static const char* bench_rsa_name(int primes)
+{
+    switch (primes) {
+        case 3:
+            return "RSA-3P";
+        case 4:
+            return "RSA-4P";
+        default:
+            return "RSA";
+    }
+}
+#endif
+
 #if defined(WOLFSSL_KEY_GEN)
-static void bench_rsaKeyGen_helper(int useDeviceID, word32 keySz)
+static void bench_rsaKeyGen_helper(int useDeviceID, word32 keySz, int primes)
 {
 #ifdef WOLFSSL_SMALL_STACK
     RsaKey *genKey;
@@ -8128,8 +8813,14 @@ static void bench_rsaKeyGen_helper(int useDeviceID, word32 keySz)
                         goto exit;
                     }
 
+                #ifdef WOLFSSL_RSA_MULTI_PRIME
+                    ret = wc_MakeRsaKeyMultiPrime(&genKey[i], (int)keySz,
+                                                  rsa_e_val, primes, &gRng);
+                #else
+                    (void)primes;
                     ret = wc_MakeRsaKey(&genKey[i], (int)keySz, rsa_e_val,
                                         &gRng);
+                #endif
                     if (!bench_async_handle(&ret,
                         BENCH_ASYNC_GET_DEV(&genKey[i]), 0,
                                             &times, &pending)) {
@@ -8147,8 +8838,13 @@ static void bench_rsaKeyGen_helper(int useDeviceID, word32 keySz)
        );
 
 exit:
+#ifdef WOLFSSL_RSA_MULTI_PRIME
+    bench_stats_asym_finish(bench_rsa_name(primes), (int)keySz, desc[2],
+                            useDeviceID, count, start, ret);
+#else
     bench_stats_asym_finish("RSA", (int)keySz, desc[2], useDeviceID, count,
                             start, ret);
+#endif
 #ifdef MULTI_VALUE_STATISTICS
     bench_multi_value_stats(max, min, sum, squareSum, runs);
 #endif
@@ -8173,14 +8869,14 @@ void bench_rsaKeyGen(int useDeviceID)
 #endif
 
     for (k = 0; k < (int)(sizeof(keySizes)/sizeof(int)); k++) {
-        bench_rsaKeyGen_helper(useDeviceID, keySizes[k]);
+        bench_rsaKeyGen_helper(useDeviceID, keySizes[k], 2);
     }
 }
 
 
 void bench_rsaKeyGen_size(int useDeviceID, word32 keySz)
 {
-    bench_rsaKeyGen_helper(useDeviceID, keySz);
+    bench_rsaKeyGen_helper(useDeviceID, keySz, 2);
 }
 #endif /* WOLFSSL_KEY_GEN */
 
@@ -8292,7 +8988,7 @@ static const unsigned char rsa_3072_sig[] = {
 #endif /* WOLFSSL_RSA_VERIFY_INLINE || WOLFSSL_RSA_PUBLIC_ONLY */
 
 static void bench_rsa_helper(int useDeviceID, RsaKey rsaKey[BENCH_MAX_PENDING],
-                             word32 rsaKeySz)
+                             word32 rsaKeySz, const char* algo)
 {
     int         ret = 0, i, times, count = 0, pending = 0;
     word32      idx = 0;
@@ -8378,7 +9074,7 @@ static void bench_rsa_helper(int useDeviceID, RsaKey rsaKey[BENCH_MAX_PENDING],
            );
 
 exit_rsa_verify:
-        bench_stats_asym_finish("RSA", (int)rsaKeySz, desc[0],
+        bench_stats_asym_finish(algo, (int)rsaKeySz, desc[0],
                                 useDeviceID, count, start, ret);
     #ifdef MULTI_VALUE_STATISTICS
         bench_multi_value_stats(max, min, sum, squareSum, runs);
@@ -8425,7 +9121,7 @@ exit_rsa_verify:
            );
 
 exit_rsa_pub:
-        bench_stats_asym_finish("RSA", (int)rsaKeySz, desc[1],
+        bench_stats_asym_finish(algo, (int)rsaKeySz, desc[1],
                                 useDeviceID, count, start, ret);
     #ifdef MULTI_VALUE_STATISTICS
         bench_multi_value_stats(max, min, sum, squareSum, runs);
@@ -8464,7 +9160,7 @@ exit_rsa_pub:
            );
 
 exit_rsa_sign:
-        bench_stats_asym_finish("RSA", (int)rsaKeySz, desc[4], useDeviceID,
+        bench_stats_asym_finish(algo, (int)rsaKeySz, desc[4], useDeviceID,
                                 count, start, ret);
     #ifdef MULTI_VALUE_STATISTICS
         bench_multi_value_stats(max, min, sum, squareSum, runs);
@@ -8531,7 +9227,7 @@ exit_rsa_sign:
            );
 
 exit_rsa_verifyinline:
-        bench_stats_asym_finish("RSA", (int)rsaKeySz, desc[5],
+        bench_stats_asym_finish(algo, (int)rsaKeySz, desc[5],
                                  useDeviceID, count,  start, ret);
     #ifdef MULTI_VALUE_STATISTICS
         bench_multi_value_stats(max, min, sum, squareSum, runs);
@@ -8646,7 +9342,7 @@ void bench_rsa(int useDeviceID)
     }
 
     if (rsaKeySz > 0) {
-        bench_rsa_helper(useDeviceID, rsaKey, rsaKeySz);
+        bench_rsa_helper(useDeviceID, rsaKey, rsaKeySz, "RSA");
     }
 
     (void)bytes;
@@ -8722,7 +9418,7 @@ void bench_rsa_key(int useDeviceID, word32 rsaKeySz)
         } /* for i */
     } while (pending > 0);
 
-    bench_rsa_helper(useDeviceID, rsaKey, rsaKeySz);
+    bench_rsa_helper(useDeviceID, rsaKey, rsaKeySz, "RSA");
 exit_bench_rsa_key:
 
     /* cleanup */
@@ -8734,7 +9430,200 @@ exit_bench_rsa_key:
     XFREE(rsaKey, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
 #endif
 }
+
+#ifdef WOLFSSL_RSA_MULTI_PRIME
+/* bench multi-prime keys against two prime keys of the same size */
+void bench_rsa_multiprime(int useDeviceID)
+{
+    int     ret = 0, i, k, p;
+#ifdef WOLFSSL_SMALL_STACK
+    RsaKey *rsaKey;
+#else
+    RsaKey  rsaKey[BENCH_MAX_PENDING];
+#endif
+    static const word32 keySizes[2] = { 3072, 4096 };
+    static const int    maxPrimes[2] = { 3, 4 };
+
+#ifdef WOLFSSL_SMALL_STACK
+    rsaKey = (RsaKey *)XMALLOC(sizeof(*rsaKey) * BENCH_MAX_PENDING,
+                               HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+    if (rsaKey == NULL) {
+        printf("bench_rsa_multiprime malloc failed\n");
+        return;
+    }
+#endif
+
+    XMEMSET(rsaKey, 0, sizeof(*rsaKey) * BENCH_MAX_PENDING);
+
+    for (k = 0; k < 2; k++) {
+        for (p = 2; p <= maxPrimes[k]; p++) {
+            bench_rsaKeyGen_helper(useDeviceID, keySizes[k], p);
+
+            for (i = 0; i < BENCH_MAX_PENDING; i++) {
+                ret = wc_InitRsaKey_ex(&rsaKey[i], HEAP_HINT,
+                        useDeviceID ? devId : INVALID_DEVID);
+                if (ret != 0)
+                    goto exit_bench_rsa_mp;
+            #ifdef WC_RSA_BLINDING
+                ret = wc_RsaSetRNG(&rsaKey[i], &gRng);
+                if (ret != 0)
+                    goto exit_bench_rsa_mp;
+            #endif
+                ret = wc_MakeRsaKeyMultiPrime(&rsaKey[i], (int)keySizes[k],
+                                              WC_RSA_EXPONENT, p, &gRng);
+                if (ret != 0) {
+                    printf("wc_MakeRsaKeyMultiPrime failed! %d\n", ret);
+                    goto exit_bench_rsa_mp;
+                }
+            }
+
+            bench_rsa_helper(useDeviceID, rsaKey, keySizes[k],
+                             bench_rsa_name(p));
+
+            for (i = 0; i < BENCH_MAX_PENDING; i++) {
+                wc_FreeRsaKey(&rsaKey[i]);
+            }
+            XMEMSET(rsaKey, 0, sizeof(*rsaKey) * BENCH_MAX_PENDING);
+        }
+    }
+
+exit_bench_rsa_mp:
+    if (ret != 0) {
+        for (i = 0; i < BENCH_MAX_PENDING; i++) {
+            wc_FreeRsaKey(&rsaKey[i]);
+        }
+    }
+
+#ifdef WOLFSSL_SMALL_STACK
+    XFREE(rsaKey, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+#endif
+}
+#endif /* WOLFSSL_RSA_MULTI_PRIME */
 #endif /* WOLFSSL_KEY_GEN */
+
+#ifdef WC_RSA_BATCH
+#define BENCH_RSA_BATCH_MAX     16
+/* bench PKCS #1 v1.5 signing in batches of 1, 4, 8 and 16 */
+void bench_rsa_batch(int useDeviceID)
+{
+    int         ret = 0, i, b, times, count = 0;
+    double      start = 0.0F;
+    word32      idx = 0;
+    word32      rsaKeySz;
+    const byte* tmp;
+    size_t      bytes;
+    const char**desc = bench_desc_words[lng_index];
+    static const int   batchSz[4] = { 1, 4, 8, 16 };
+    static const char* batchDesc[4] = { "x1", "x4", "x8", "x16" };
+    const byte* msg[BENCH_RSA_BATCH_MAX];
+    word32      msgLen[BENCH_RSA_BATCH_MAX];
+    byte*       sig[BENCH_RSA_BATCH_MAX];
+    RsaKey*     keys[BENCH_RSA_BATCH_MAX];
+#ifdef WOLFSSL_SMALL_STACK
+    RsaKey      *rsaKey;
+#else
+    RsaKey      rsaKey[1];
+#endif
+    DECLARE_MULTI_VALUE_STATS_VARS()
+    WC_DECLARE_VAR(out, byte, BENCH_RSA_BATCH_MAX * (RSA_MAX_SIZE / 8),
+                   HEAP_HINT);
+
+#ifdef USE_CERT_BUFFERS_1024
+    tmp = rsa_key_der_1024;
+    bytes = (size_t)sizeof_rsa_key_der_1024;
+    rsaKeySz = 1024;
+#elif defined(USE_CERT_BUFFERS_2048)
+    tmp = rsa_key_der_2048;
+    bytes = (size_t)sizeof_rsa_key_der_2048;
+    rsaKeySz = 2048;
+#elif defined(USE_CERT_BUFFERS_3072)
+    tmp = rsa_key_der_3072;
+    bytes = (size_t)sizeof_rsa_key_der_3072;
+    rsaKeySz = 3072;
+#elif defined(USE_CERT_BUFFERS_4096)
+    tmp = client_key_der_4096;
+    bytes = (size_t)sizeof_client_key_der_4096;
+    rsaKeySz = 4096;
+#else
+    #error "need a cert buffer size"
+#endif /* USE_CERT_BUFFERS */
+
+#ifdef WOLFSSL_SMALL_STACK
+    rsaKey = (RsaKey *)XMALLOC(sizeof(*rsaKey), HEAP_HINT,
+                               DYNAMIC_TYPE_TMP_BUFFER);
+    if (rsaKey == NULL) {
+        printf("bench_rsa_batch malloc failed\n");
+        WC_FREE_VAR(out, HEAP_HINT);
+        return;
+    }
+#endif
+    XMEMSET(rsaKey, 0, sizeof(*rsaKey));
+#ifdef WC_DECLARE_VAR_IS_HEAP_ALLOC
+    if (out == NULL) {
+        ret = MEMORY_E;
+        goto exit_bench_rsa_batch;
+    }
+#endif
+
+    ret = wc_InitRsaKey_ex(rsaKey, HEAP_HINT,
+        useDeviceID ? devId : INVALID_DEVID);
+    if (ret != 0)
+        goto exit_bench_rsa_batch;
+#ifdef WC_RSA_BLINDING
+    ret = wc_RsaSetRNG(rsaKey, &gRng);
+    if (ret != 0)
+        goto exit_bench_rsa_batch;
+#endif
+    ret = wc_RsaPrivateKeyDecode(tmp, &idx, rsaKey, (word32)bytes);
+    if (ret != 0) {
+        printf("wc_RsaPrivateKeyDecode failed! %d\n", ret);
+        goto exit_bench_rsa_batch;
+    }
+
+    for (i = 0; i < BENCH_RSA_BATCH_MAX; i++) {
+        msg[i] = (const byte*)TEST_STRING;
+        msgLen[i] = (word32)TEST_STRING_SZ;
+        sig[i] = out + i * (RSA_MAX_SIZE / 8);
+        keys[i] = rsaKey;
+    }
+
+    for (b = 0; b < 4; b++) {
+        RESET_MULTI_VALUE_STATS_VARS();
+        bench_stats_start(&count, &start);
+        do {
+            for (times = 0; times < ntimes; times += batchSz[b]) {
+                ret = wc_RsaSSL_SignBatch(msg, msgLen, sig, RSA_MAX_SIZE / 8,
+                                          keys, batchSz[b], GLOBAL_RNG);
+                if (ret < 0)
+                    goto exit_rsa_batch_sign;
+                RECORD_MULTI_VALUE_STATS();
+            }
+            count += times;
+        } while (bench_stats_check(start)
+    #ifdef MULTI_VALUE_STATISTICS
+           || runs < minimum_runs
+    #endif
+           );
+
+exit_rsa_batch_sign:
+        bench_stats_asym_finish_ex("RSA", (int)rsaKeySz, desc[4],
+                                   batchDesc[b], useDeviceID, count, start,
+                                   ret);
+    #ifdef MULTI_VALUE_STATISTICS
+        bench_multi_value_stats(max, min, sum, squareSum, runs);
+    #endif
+        if (ret < 0)
+            break;
+    }
+
+exit_bench_rsa_batch:
+    wc_FreeRsaKey(rsaKey);
+#ifdef WOLFSSL_SMALL_STACK
+    XFREE(rsaKey, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+#endif
+    WC_FREE_VAR(out, HEAP_HINT);
+}
+#endif /* WC_RSA_BATCH */
 #endif /* !NO_RSA */
 
 
@@ -8760,7 +9649,65 @@ exit_bench_rsa_key:
 #else
 #define BENCH_DH_KEY_SIZE  384 /* for 3072 bit */
 #endif
-#define BENCH_DH_PRIV_SIZE (BENCH_DH_KEY_SIZE/8)
+#define BENCH_DH_PRIV_SIZE (BENCH_DH_KEY_SIZE/8)
+
+#if defined(WOLFSSL_DH_COMB) && (defined(HAVE_FFDHE_2048) || \
+    defined(HAVE_FFDHE_3072) || defined(HAVE_FFDHE_4096))
+/* Key generation with a named group. The first key built the group's comb
+ * table and the rest use it. */
+static void bench_dh_ffdhe_keygen(int name, int bits)
+{
+    int    ret;
+    int    count = 0;
+    int    times;
+    double start = 0.0F;
+    DhKey  key;
+    byte   priv[BENCH_DH_PRIV_SIZE];
+    byte   pub[BENCH_DH_KEY_SIZE];
+    word32 privSz;
+    word32 pubSz;
+    char   name_str[16];
+    DECLARE_MULTI_VALUE_STATS_VARS()
+
+    ret = wc_InitDhKey_ex(&key, HEAP_HINT, INVALID_DEVID);
+    if (ret == 0)
+        ret = wc_DhSetNamedKey(&key, name);
+    if (ret != 0) {
+        printf("wc_DhSetNamedKey failed %d, can't benchmark\n", ret);
+        wc_FreeDhKey(&key);
+        return;
+    }
+    XSNPRINTF(name_str, sizeof(name_str), "DH-ffdhe%d", bits);
+
+    bench_stats_start(&count, &start);
+    PRIVATE_KEY_UNLOCK();
+    do {
+        for (times = 0; times < genTimes; times++) {
+            privSz = sizeof(priv);
+            pubSz = sizeof(pub);
+            ret = wc_DhGenerateKeyPair(&key, &gRng, priv, &privSz, pub,
+                                       &pubSz);
+            if (ret != 0)
+                goto exit_dh_ffdhe;
+            RECORD_MULTI_VALUE_STATS();
+        }
+        count += times;
+    } while (bench_stats_check(start)
+#ifdef MULTI_VALUE_STATISTICS
+       || runs < minimum_runs
+#endif
+       );
+
+exit_dh_ffdhe:
+    PRIVATE_KEY_LOCK();
+    bench_stats_asym_finish(name_str, bits, bench_desc_words[lng_index][2], 0,
+                            count, start, ret);
+#ifdef MULTI_VALUE_STATISTICS
+    bench_multi_value_stats(max, min, sum, squareSum, runs);
+#endif
+    wc_FreeDhKey(&key);
+}
+#endif
 
 void bench_dh(int useDeviceID)
 {
@@ -9040,10 +9987,47 @@ exit:
     WC_FREE_ARRAY(priv, BENCH_MAX_PENDING, HEAP_HINT);
     WC_FREE_VAR(priv2, HEAP_HINT);
     WC_FREE_ARRAY(agree, BENCH_MAX_PENDING, HEAP_HINT);
+
+#ifdef WOLFSSL_DH_COMB
+    /* Named groups use the cached comb tables. */
+    if (!use_ffdhe && !useDeviceID) {
+    #ifdef HAVE_FFDHE_2048
+        bench_dh_ffdhe_keygen(WC_FFDHE_2048, 2048);
+    #endif
+    #ifdef HAVE_FFDHE_3072
+        bench_dh_ffdhe_keygen(WC_FFDHE_3072, 3072);
+    #endif
+    #ifdef HAVE_FFDHE_4096
+        bench_dh_ffdhe_keygen(WC_FFDHE_4096, 4096);
+    #endif
+    }
+#endif
 }
 #endif /* !NO_DH */
 
 #ifdef WOLFSSL_HAVE_KYBER
+#if defined(HAVE_GET_CYCLES) && !defined(WOLFSSL_ESPIDF)
+/* Show the average number of cycles of each Kyber operation.
+ *
+ * The cycle counter was started by bench_stats_start().
+ */
+static void bench_kyber_cycles(const char* name, int keySize,
+    const char* desc, int count)
+{
+#ifndef GENERATE_MACHINE_PARSEABLE_REPORT
+    END_INTEL_CYCLES
+#endif
+    if ((csv_format != 1) && (count > 0)) {
+        printf("%-6s %5d %8s %lu cycles/op\n", name, keySize, desc,
+               (unsigned long)(total_cycles / (word64)count));
+    }
+}
+#define BENCH_KYBER_CYCLES(name, keySize, desc, count) \
+    bench_kyber_cycles(name, keySize, desc, count)
+#else
+#define BENCH_KYBER_CYCLES(name, keySize, desc, count) WC_DO_NOTHING
+#endif
+
 static void bench_kyber_keygen(int type, const char* name, int keySize,
     KyberKey* key)
 {
@@ -9081,6 +10065,7 @@ static void bench_kyber_keygen(int type, const char* name, int keySize,
 
 exit:
     bench_stats_asym_finish(name, keySize, desc[2], 0, count, start, ret);
+    BENCH_KYBER_CYCLES(name, keySize, desc[2], count);
 #ifdef MULTI_VALUE_STATISTICS
     bench_multi_value_stats(max, min, sum, squareSum, runs);
 #endif
@@ -9126,6 +10111,7 @@ static void bench_kyber_encap(const char* name, int keySize, KyberKey* key)
 
 exit_encap:
     bench_stats_asym_finish(name, keySize, desc[9], 0, count, start, ret);
+    BENCH_KYBER_CYCLES(name, keySize, desc[9], count);
 #ifdef MULTI_VALUE_STATISTICS
     bench_multi_value_stats(max, min, sum, squareSum, runs);
 #endif
@@ -9151,6 +10137,7 @@ exit_encap:
 
 exit_decap:
     bench_stats_asym_finish(name, keySize, desc[13], 0, count, start, ret);
+    BENCH_KYBER_CYCLES(name, keySize, desc[13], count);
 #ifdef MULTI_VALUE_STATISTICS
     bench_multi_value_stats(max, min, sum, squareSum, runs);
 #endif
@@ -9563,6 +10550,117 @@ exit_lms_sign_verify:
     return;
 }
 
+#ifdef WOLFSSL_WC_LMS
+/* Key generation builds the whole tree: 2^height one-time keys. Signing
+ * recomputes a subtree of leaves every 2^(height - WOLFSSL_LMS_CACHE_HEIGHT)
+ * signatures when the tree is taller than the cache. */
+static void bench_lms_keygen_sign(int height, word32 threads, const char* str)
+{
+    int          ret = 0;
+    LmsKey       key;
+    WC_RNG       rng;
+    const char * msg = TEST_STRING;
+    word32       msgSz = TEST_STRING_SZ;
+    byte *       sig = NULL;
+    word32       sigSz = 0;
+    int          times = 0;
+    int          count = 0;
+    double       start = 0.0F;
+    byte         priv[HSS_MAX_PRIVATE_KEY_LEN];
+    DECLARE_MULTI_VALUE_STATS_VARS()
+
+    XMEMSET(&key, 0, sizeof(key));
+
+#ifndef HAVE_FIPS
+    ret = wc_InitRng_ex(&rng, HEAP_HINT, INVALID_DEVID);
+#else
+    ret = wc_InitRng(&rng);
+#endif
+    if (ret != 0) {
+        printf("wc_InitRng failed: %d\n", ret);
+        return;
+    }
+
+    bench_stats_start(&count, &start);
+    do {
+        wc_LmsKey_Free(&key);
+        ret = wc_LmsKey_Init(&key, NULL, INVALID_DEVID);
+    #if defined(WOLFSSL_LMS_THREADS) && !defined(SINGLE_THREADED)
+        if (ret == 0)
+            ret = wc_LmsKey_SetThreads(&key, threads);
+    #endif
+        if (ret == 0)
+            ret = wc_LmsKey_SetParameters(&key, 1, height, 2);
+        if (ret == 0)
+            ret = wc_LmsKey_SetWriteCb(&key, lms_write_key_mem);
+        if (ret == 0)
+            ret = wc_LmsKey_SetReadCb(&key, lms_read_key_mem);
+        if (ret == 0)
+            ret = wc_LmsKey_SetContext(&key, (void *) priv);
+        if (ret == 0)
+            ret = wc_LmsKey_MakeKey(&key, &rng);
+        if (ret != 0) {
+            printf("wc_LmsKey_MakeKey failed: %d\n", ret);
+            goto exit_lms_keygen_sign;
+        }
+        RECORD_MULTI_VALUE_STATS();
+        count++;
+    } while (bench_stats_check(start)
+#ifdef MULTI_VALUE_STATISTICS
+       || runs < minimum_runs
+#endif
+       );
+
+    bench_stats_asym_finish(str, height, "keygen", 0, count, start, ret);
+#ifdef MULTI_VALUE_STATISTICS
+    bench_multi_value_stats(max, min, sum, squareSum, runs);
+#endif
+
+    ret = wc_LmsKey_GetSigLen(&key, &sigSz);
+    if (ret == 0) {
+        sig = (byte*)XMALLOC(sigSz, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+        if (sig == NULL) {
+            ret = MEMORY_E;
+        }
+    }
+    if (ret != 0) {
+        printf("bench_lms_keygen_sign failed: %d\n", ret);
+        goto exit_lms_keygen_sign;
+    }
+
+    RESET_MULTI_VALUE_STATS_VARS();
+    count = 0;
+    bench_stats_start(&count, &start);
+    do {
+        /* Stop early when the signatures of a short tree are used up. */
+        for (times = 0; times < ntimes && wc_LmsKey_SigsLeft(&key); ++times) {
+            ret = wc_LmsKey_Sign(&key, sig, &sigSz, (byte *) msg, msgSz);
+            if (ret) {
+                printf("wc_LmsKey_Sign failed: %d\n", ret);
+                goto exit_lms_keygen_sign;
+            }
+            RECORD_MULTI_VALUE_STATS();
+        }
+        count += times;
+    } while (wc_LmsKey_SigsLeft(&key) && (bench_stats_check(start)
+#ifdef MULTI_VALUE_STATISTICS
+       || runs < minimum_runs
+#endif
+       ));
+
+    bench_stats_asym_finish(str, (int)sigSz, "sign", 0, count, start, ret);
+#ifdef MULTI_VALUE_STATISTICS
+    bench_multi_value_stats(max, min, sum, squareSum, runs);
+#endif
+
+exit_lms_keygen_sign:
+    XFREE(sig, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+    wc_LmsKey_Free(&key);
+    wc_FreeRng(&rng);
+    (void)threads;
+}
+#endif /* WOLFSSL_WC_LMS */
+
 void bench_lms(void)
 {
     bench_lms_sign_verify(WC_LMS_PARM_L2_H10_W2);
@@ -9571,6 +10669,16 @@ void bench_lms(void)
     bench_lms_sign_verify(WC_LMS_PARM_L3_H5_W8);
     bench_lms_sign_verify(WC_LMS_PARM_L3_H10_W4);
     bench_lms_sign_verify(WC_LMS_PARM_L4_H5_W8);
+#ifdef WOLFSSL_WC_LMS
+    bench_lms_keygen_sign(5, 1, "LMS/HSS L1_H5_W2");
+    bench_lms_keygen_sign(10, 1, "LMS/HSS L1_H10_W2");
+    bench_lms_keygen_sign(15, 1, "LMS/HSS L1_H15_W2");
+#if defined(WOLFSSL_LMS_THREADS) && !defined(SINGLE_THREADED)
+    bench_lms_keygen_sign(15, 2, "LMS/HSS L1_H15_W2-2thr");
+    bench_lms_keygen_sign(15, 4, "LMS/HSS L1_H15_W2-4thr");
+    bench_lms_keygen_sign(15, 8, "LMS/HSS L1_H15_W2-8thr");
+#endif
+#endif
     return;
 }
 
@@ -9821,6 +10929,183 @@ void bench_xmss(void)
  * "ECC   [%15s]" and "ECDHE [%15s]" and "ECDSA [%15s]" */
 #define BENCH_ECC_NAME_SZ (ECC_MAXNAME + 8)
 
+#ifdef WOLFSSL_ECC_KEYGEN_BATCH
+#define BENCH_ECC_KEYGEN_BATCH_MAX  64
+/* Make keys in batches of different sizes. */
+static void bench_eccMakeKeyBatch(int curveId)
+{
+    int ret = 0, i, b, times, count = 0;
+    int keySize;
+    double start = 0.0F;
+    char name[BENCH_ECC_NAME_SZ];
+    const char**desc = bench_desc_words[lng_index];
+    static const int   batchSz[7] = { 1, 2, 4, 8, 16, 32, 64 };
+    static const char* batchDesc[7] = { "x1", "x2", "x4", "x8", "x16", "x32",
+                                        "x64" };
+    ecc_key* keys[BENCH_ECC_KEYGEN_BATCH_MAX];
+    ecc_key* genKey;
+    DECLARE_MULTI_VALUE_STATS_VARS()
+
+    genKey = (ecc_key*)XMALLOC(sizeof(*genKey) * BENCH_ECC_KEYGEN_BATCH_MAX,
+                               HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+    if (genKey == NULL) {
+        printf("bench_eccMakeKeyBatch malloc failed\n");
+        return;
+    }
+    XMEMSET(genKey, 0, sizeof(*genKey) * BENCH_ECC_KEYGEN_BATCH_MAX);
+
+    keySize = wc_ecc_get_curve_size_from_id(curveId);
+    (void)XSNPRINTF(name, BENCH_ECC_NAME_SZ, "ECC   [%15s]",
+            wc_ecc_get_name(curveId));
+
+    for (i = 0; i < BENCH_ECC_KEYGEN_BATCH_MAX; i++) {
+        ret = wc_ecc_init_ex(&genKey[i], HEAP_HINT, INVALID_DEVID);
+        if (ret != 0)
+            goto exit_ecc_batch;
+        keys[i] = &genKey[i];
+    }
+
+    for (b = 0; b < 7; b++) {
+        RESET_MULTI_VALUE_STATS_VARS();
+        bench_stats_start(&count, &start);
+        do {
+            for (times = 0; times < agreeTimes; times += batchSz[b]) {
+                ret = wc_ecc_make_key_batch(&gRng, keySize, keys,
+                                            (word32)batchSz[b], curveId);
+                if (ret != 0)
+                    goto exit_ecc_batch_kg;
+                RECORD_MULTI_VALUE_STATS();
+            }
+            count += times;
+        } while (bench_stats_check(start)
+    #ifdef MULTI_VALUE_STATISTICS
+           || runs < minimum_runs
+    #endif
+           );
+
+exit_ecc_batch_kg:
+        bench_stats_asym_finish_ex(name, keySize * 8, desc[2], batchDesc[b],
+                                   0, count, start, ret);
+    #ifdef MULTI_VALUE_STATISTICS
+        bench_multi_value_stats(max, min, sum, squareSum, runs);
+    #endif
+        if (ret != 0)
+            break;
+    }
+
+exit_ecc_batch:
+    for (i = 0; i < BENCH_ECC_KEYGEN_BATCH_MAX; i++) {
+        wc_ecc_free(&genKey[i]);
+    }
+    XFREE(genKey, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+}
+#endif /* WOLFSSL_ECC_KEYGEN_BATCH */
+
+#ifdef WOLFSSL_ECC_MULTI_SCALAR
+#define BENCH_ECC_MULTI_KEYS        16
+#define BENCH_ECC_MULTI_MAX         4096
+/* Multiply and add different numbers of points. Rate is points per second. */
+static void bench_eccMulMulti(int curveId)
+{
+    int ret = 0, i, b, times, count = 0;
+    int keySize;
+    double start = 0.0F;
+    char name[BENCH_ECC_NAME_SZ];
+    const char**desc = bench_desc_words[lng_index];
+    static const int   multiSz[3] = { 16, 256, BENCH_ECC_MULTI_MAX };
+    static const char* multiDesc[3] = { "x16", "x256", "x4096" };
+    ecc_key* keys = NULL;
+    mp_int** k = NULL;
+    ecc_point** g = NULL;
+    ecc_point* r = NULL;
+    DECLARE_MULTI_VALUE_STATS_VARS()
+
+    keys = (ecc_key*)XMALLOC(sizeof(*keys) * BENCH_ECC_MULTI_KEYS, HEAP_HINT,
+                             DYNAMIC_TYPE_TMP_BUFFER);
+    k = (mp_int**)XMALLOC(sizeof(*k) * BENCH_ECC_MULTI_MAX, HEAP_HINT,
+                          DYNAMIC_TYPE_TMP_BUFFER);
+    g = (ecc_point**)XMALLOC(sizeof(*g) * BENCH_ECC_MULTI_MAX, HEAP_HINT,
+                             DYNAMIC_TYPE_TMP_BUFFER);
+    r = wc_ecc_new_point_h(HEAP_HINT);
+    if ((keys == NULL) || (k == NULL) || (g == NULL) || (r == NULL)) {
+        printf("bench_eccMulMulti malloc failed\n");
+        goto exit_ecc_multi;
+    }
+    XMEMSET(keys, 0, sizeof(*keys) * BENCH_ECC_MULTI_KEYS);
+    XMEMSET(g, 0, sizeof(*g) * BENCH_ECC_MULTI_MAX);
+
+    keySize = wc_ecc_get_curve_size_from_id(curveId);
+    (void)XSNPRINTF(name, BENCH_ECC_NAME_SZ, "ECC   [%15s]",
+            wc_ecc_get_name(curveId));
+
+    for (i = 0; i < BENCH_ECC_MULTI_KEYS; i++) {
+        ret = wc_ecc_init_ex(&keys[i], HEAP_HINT, INVALID_DEVID);
+        if (ret == 0)
+            ret = wc_ecc_make_key_ex(&gRng, keySize, &keys[i], curveId);
+        if (ret != 0)
+            goto exit_ecc_multi;
+    }
+    /* Distinct points with scalars reused from a few keys. */
+    for (i = 0; i < BENCH_ECC_MULTI_MAX; i++) {
+        k[i] = wc_ecc_key_get_priv(&keys[i % BENCH_ECC_MULTI_KEYS]);
+        g[i] = wc_ecc_new_point_h(HEAP_HINT);
+        if (g[i] == NULL) {
+            ret = MEMORY_E;
+            goto exit_ecc_multi;
+        }
+        ret = wc_ecc_make_key_ex(&gRng, keySize, &keys[0], curveId);
+        if (ret == 0)
+            ret = wc_ecc_copy_point(&keys[0].pubkey, g[i]);
+        if (ret != 0)
+            goto exit_ecc_multi;
+    }
+
+    for (b = 0; b < 3; b++) {
+        RESET_MULTI_VALUE_STATS_VARS();
+        bench_stats_start(&count, &start);
+        do {
+            for (times = 0; times < agreeTimes; times += multiSz[b]) {
+                ret = wc_ecc_mulmod_multi(k, g, r, (word32)multiSz[b],
+                                          curveId, HEAP_HINT);
+                if (ret != 0)
+                    goto exit_ecc_multi_mul;
+                RECORD_MULTI_VALUE_STATS();
+            }
+            count += times;
+        } while (bench_stats_check(start)
+    #ifdef MULTI_VALUE_STATISTICS
+           || runs < minimum_runs
+    #endif
+           );
+
+exit_ecc_multi_mul:
+        bench_stats_asym_finish_ex(name, keySize * 8, desc[14], multiDesc[b],
+                                   0, count, start, ret);
+    #ifdef MULTI_VALUE_STATISTICS
+        bench_multi_value_stats(max, min, sum, squareSum, runs);
+    #endif
+        if (ret != 0)
+            break;
+    }
+
+exit_ecc_multi:
+    if (ret != 0)
+        printf("bench_eccMulMulti failed: %d\n", ret);
+    if (g != NULL) {
+        for (i = 0; i < BENCH_ECC_MULTI_MAX; i++)
+            wc_ecc_del_point_h(g[i], HEAP_HINT);
+    }
+    if (keys != NULL) {
+        for (i = 0; i < BENCH_ECC_MULTI_KEYS; i++)
+            wc_ecc_free(&keys[i]);
+    }
+    wc_ecc_del_point_h(r, HEAP_HINT);
+    XFREE(g, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+    XFREE(k, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+    XFREE(keys, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+}
+#endif /* WOLFSSL_ECC_MULTI_SCALAR */
+
 /* run all benchmarks on a curve */
 void bench_ecc_curve(int curveId)
 {
@@ -9828,6 +11113,9 @@ void bench_ecc_curve(int curveId)
     #ifndef NO_SW_BENCH
         bench_eccMakeKey(0, curveId);
     #endif
+    #ifdef WOLFSSL_ECC_KEYGEN_BATCH
+        bench_eccMakeKeyBatch(curveId);
+    #endif
     #if defined(BENCH_DEVID)
         bench_eccMakeKey(1, curveId);
     #endif
@@ -9836,6 +11124,9 @@ void bench_ecc_curve(int curveId)
     #ifndef NO_SW_BENCH
         bench_ecc(0, curveId);
     #endif
+    #ifdef WOLFSSL_ECC_MULTI_SCALAR
+        bench_eccMulMulti(curveId);
+    #endif
     #if defined(BENCH_DEVID)
         bench_ecc(1, curveId);
     #endif
@@ -10860,6 +12151,163 @@ void bench_ed25519KeyGen(void)
 }
 
 
+#if defined(WOLFSSL_ED25519_BATCH_VERIFY) && defined(HAVE_ED25519_SIGN) && \
+    defined(HAVE_ED25519_VERIFY)
+#define BENCH_ED25519_BATCH_MAX     64
+/* Verify distinct signatures of one key in batches of different sizes. */
+static void bench_ed25519_batch(ed25519_key* key, const byte* msg)
+{
+    int         ret = 0, i, b, times, count = 0;
+    double      start = 0.0F;
+    const char**desc = bench_desc_words[lng_index];
+    static const int   batchSz[3] = { 8, 32, BENCH_ED25519_BATCH_MAX };
+    static const char* batchDesc[3] = { "x8", "x32", "x64" };
+    const byte*  sig[BENCH_ED25519_BATCH_MAX];
+    word32       sigLen[BENCH_ED25519_BATCH_MAX];
+    const byte*  msgs[BENCH_ED25519_BATCH_MAX];
+    word32       msgLen[BENCH_ED25519_BATCH_MAX];
+    ed25519_key* keys[BENCH_ED25519_BATCH_MAX];
+    int          res[BENCH_ED25519_BATCH_MAX];
+    byte*        sigs;
+    DECLARE_MULTI_VALUE_STATS_VARS()
+
+    sigs = (byte*)XMALLOC(BENCH_ED25519_BATCH_MAX * ED25519_SIG_SIZE,
+        HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+    if (sigs == NULL) {
+        printf("bench_ed25519_batch malloc failed\n");
+        return;
+    }
+
+    for (i = 0; i < BENCH_ED25519_BATCH_MAX; i++) {
+        msgs[i] = msg + i;
+        msgLen[i] = 256;
+        sig[i] = sigs + i * ED25519_SIG_SIZE;
+        sigLen[i] = ED25519_SIG_SIZE;
+        keys[i] = key;
+        ret = wc_ed25519_sign_msg(msgs[i], msgLen[i],
+            sigs + i * ED25519_SIG_SIZE, &sigLen[i], key);
+        if (ret != 0) {
+            printf("ed25519_sign_msg failed\n");
+            goto exit_ed_batch;
+        }
+    }
+
+    for (b = 0; b < 3; b++) {
+        RESET_MULTI_VALUE_STATS_VARS();
+        bench_stats_start(&count, &start);
+        do {
+            for (times = 0; times < agreeTimes; times += batchSz[b]) {
+                ret = wc_ed25519_verify_msg_batch(sig, sigLen, msgs, msgLen,
+                    keys, (word32)batchSz[b], res, &gRng);
+                if (ret != 0) {
+                    printf("ed25519_verify_msg_batch failed\n");
+                    goto exit_ed_batch_verify;
+                }
+                RECORD_MULTI_VALUE_STATS();
+            }
+            count += times;
+        } while (bench_stats_check(start)
+    #ifdef MULTI_VALUE_STATISTICS
+           || runs < minimum_runs
+    #endif
+           );
+
+exit_ed_batch_verify:
+        bench_stats_asym_finish_ex("ED", 25519, desc[5], batchDesc[b], 0,
+                                   count, start, ret);
+    #ifdef MULTI_VALUE_STATISTICS
+        bench_multi_value_stats(max, min, sum, squareSum, runs);
+    #endif
+        if (ret != 0)
+            break;
+    }
+
+exit_ed_batch:
+    XFREE(sigs, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+}
+#endif /* WOLFSSL_ED25519_BATCH_VERIFY && HAVE_ED25519_SIGN &&
+        * HAVE_ED25519_VERIFY */
+
+#if defined(WOLFSSL_ED25519_MULTI_SCALAR) && \
+    defined(HAVE_ED25519_KEY_EXPORT) && defined(HAVE_ED25519_MAKE_KEY)
+#define BENCH_ED25519_MULTI_MAX     4096
+/* Multiply and add different numbers of points. Rate is points per second. */
+static void bench_ed25519_multi(ed25519_key* key)
+{
+    int         ret = 0, i, b, times, count = 0;
+    double      start = 0.0F;
+    const char**desc = bench_desc_words[lng_index];
+    static const int   multiSz[3] = { 16, 256, BENCH_ED25519_MULTI_MAX };
+    static const char* multiDesc[3] = { "x16", "x256", "x4096" };
+    byte        r[ED25519_PUB_KEY_SIZE];
+    byte*       s;
+    byte*       p;
+    word32      sz;
+    DECLARE_MULTI_VALUE_STATS_VARS()
+
+    s = (byte*)XMALLOC(BENCH_ED25519_MULTI_MAX * ED25519_KEY_SIZE, HEAP_HINT,
+        DYNAMIC_TYPE_TMP_BUFFER);
+    p = (byte*)XMALLOC(BENCH_ED25519_MULTI_MAX * ED25519_PUB_KEY_SIZE,
+        HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+    if ((s == NULL) || (p == NULL)) {
+        printf("bench_ed25519_multi malloc failed\n");
+        goto exit_ed_multi;
+    }
+
+    for (i = 0; (ret == 0) && (i < BENCH_ED25519_MULTI_MAX); i++) {
+        ret = wc_RNG_GenerateBlock(&gRng, s + i * ED25519_KEY_SIZE,
+            ED25519_KEY_SIZE);
+        /* Scalars less than 2^253. */
+        s[i * ED25519_KEY_SIZE + ED25519_KEY_SIZE - 1] &= 0x1f;
+        if (ret == 0)
+            ret = wc_ed25519_make_key(&gRng, ED25519_KEY_SIZE, key);
+        if (ret == 0) {
+            sz = ED25519_PUB_KEY_SIZE;
+            ret = wc_ed25519_export_public(key, p + i * ED25519_PUB_KEY_SIZE,
+                &sz);
+        }
+    }
+    if (ret != 0) {
+        printf("ed25519 multi setup failed\n");
+        goto exit_ed_multi;
+    }
+
+    for (b = 0; b < 3; b++) {
+        RESET_MULTI_VALUE_STATS_VARS();
+        bench_stats_start(&count, &start);
+        do {
+            for (times = 0; times < agreeTimes; times += multiSz[b]) {
+                ret = wc_ed25519_mul_multi(r, s, p, (word32)multiSz[b]);
+                if (ret != 0) {
+                    printf("ed25519_mul_multi failed\n");
+                    goto exit_ed_multi_mul;
+                }
+                RECORD_MULTI_VALUE_STATS();
+            }
+            count += times;
+        } while (bench_stats_check(start)
+    #ifdef MULTI_VALUE_STATISTICS
+           || runs < minimum_runs
+    #endif
+           );
+
+exit_ed_multi_mul:
+        bench_stats_asym_finish_ex("ED", 25519, desc[14], multiDesc[b], 0,
+                                   count, start, ret);
+    #ifdef MULTI_VALUE_STATISTICS
+        bench_multi_value_stats(max, min, sum, squareSum, runs);
+    #endif
+        if (ret != 0)
+            break;
+    }
+
+exit_ed_multi:
+    XFREE(p, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+    XFREE(s, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+}
+#endif /* WOLFSSL_ED25519_MULTI_SCALAR && HAVE_ED25519_KEY_EXPORT &&
+        * HAVE_ED25519_MAKE_KEY */
+
 void bench_ed25519KeySign(void)
 {
 #ifdef HAVE_ED25519_MAKE_KEY
@@ -10942,9 +12390,19 @@ exit_ed_verify:
 #ifdef MULTI_VALUE_STATISTICS
     bench_multi_value_stats(max, min, sum, squareSum, runs);
 #endif
+
+#ifdef WOLFSSL_ED25519_BATCH_VERIFY
+    if (ret == 0)
+        bench_ed25519_batch(&genKey, msg);
+#endif
 #endif /* HAVE_ED25519_VERIFY */
 #endif /* HAVE_ED25519_SIGN */
 
+#if defined(WOLFSSL_ED25519_MULTI_SCALAR) && \
+    defined(HAVE_ED25519_KEY_EXPORT) && defined(HAVE_ED25519_MAKE_KEY)
+    bench_ed25519_multi(&genKey);
+#endif
+
     wc_ed25519_free(&genKey);
 }
 #endif /* HAVE_ED25519 */
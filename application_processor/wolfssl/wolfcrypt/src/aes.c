@@ -2362,6 +2362,8 @@ static void bs_sub_bytes(bs_word u[8])
     u[7] = S0;
 }
 
+#ifndef WC_AES_BITSLICED_NARROW
+
 #define BS_MASK_BIT_SET(w, j, bmask) \
     (((bs_word)0 - (((w) >> (j)) & (bs_word)1)) & (bmask))
 
@@ -2751,6 +2753,439 @@ static void AesEncryptBlocks_C(Aes* aes, const byte* in, byte* out, word32 sz)
 }
 #endif
 
+#else /* WC_AES_BITSLICED_NARROW */
+
+/* Narrow bit-sliced implementation.
+ *
+ * Eight words hold the state of BS_BLOCK_SIZE / AES_BLOCK_SIZE blocks: word i
+ * has bit i of every byte. 32-bit words hold two blocks and 64-bit words hold
+ * four. Each row of the state is a contiguous run of bits so ShiftRows and
+ * MixColumns are masks, shifts and rotates of whole words.
+ * See: https://eprint.iacr.org/2009/129.pdf
+ *      BearSSL aes_ct and aes_ct64 by Thomas Pornin.
+ *
+ * Unlike the wide implementation, one or two blocks are not padded out to 32
+ * or 64 and the sliced round keys are small enough to keep in the Aes object.
+ */
+
+/* Number of blocks processed in parallel. */
+#define BS_PAR_BLOCKS   (BS_BLOCK_SIZE / AES_BLOCK_SIZE)
+
+#if BS_WORD_SIZE == 64
+    #define BS_M1_LO    W64LIT(0x5555555555555555)
+    #define BS_M1_HI    W64LIT(0xAAAAAAAAAAAAAAAA)
+    #define BS_M2_LO    W64LIT(0x3333333333333333)
+    #define BS_M2_HI    W64LIT(0xCCCCCCCCCCCCCCCC)
+    #define BS_M4_LO    W64LIT(0x0F0F0F0F0F0F0F0F)
+    #define BS_M4_HI    W64LIT(0xF0F0F0F0F0F0F0F0)
+    /* Rotate by one row and by two rows of the state. */
+    #define BS_ROT_ROW(x)   (((x) >> 16) | ((x) << 48))
+    #define BS_ROT_ROW2(x)  (((x) >> 32) | ((x) << 32))
+#else
+    #define BS_M1_LO    0x55555555U
+    #define BS_M1_HI    0xAAAAAAAAU
+    #define BS_M2_LO    0x33333333U
+    #define BS_M2_HI    0xCCCCCCCCU
+    #define BS_M4_LO    0x0F0F0F0FU
+    #define BS_M4_HI    0xF0F0F0F0U
+    /* Rotate by one row and by two rows of the state. */
+    #define BS_ROT_ROW(x)   (((x) >> 8) | ((x) << 24))
+    #define BS_ROT_ROW2(x)  (((x) >> 16) | ((x) << 16))
+#endif
+
+#define BS_SWAP(cl, ch, s, x, y)                \
+    do {                                        \
+        bs_word a_ = (x);                       \
+        bs_word b_ = (y);                       \
+        (x) = (a_ & (cl)) | ((b_ & (cl)) << (s)); \
+        (y) = ((a_ & (ch)) >> (s)) | (b_ & (ch)); \
+    } while (0)
+
+/* Convert between words of bytes and words of bits. Self-inverse.
+ *
+ * @param [in, out]  q  Eight words of state.
+ */
+static void bs_ortho(bs_word* q)
+{
+    BS_SWAP(BS_M1_LO, BS_M1_HI, 1, q[0], q[1]);
+    BS_SWAP(BS_M1_LO, BS_M1_HI, 1, q[2], q[3]);
+    BS_SWAP(BS_M1_LO, BS_M1_HI, 1, q[4], q[5]);
+    BS_SWAP(BS_M1_LO, BS_M1_HI, 1, q[6], q[7]);
+
+    BS_SWAP(BS_M2_LO, BS_M2_HI, 2, q[0], q[2]);
+    BS_SWAP(BS_M2_LO, BS_M2_HI, 2, q[1], q[3]);
+    BS_SWAP(BS_M2_LO, BS_M2_HI, 2, q[4], q[6]);
+    BS_SWAP(BS_M2_LO, BS_M2_HI, 2, q[5], q[7]);
+
+    BS_SWAP(BS_M4_LO, BS_M4_HI, 4, q[0], q[4]);
+    BS_SWAP(BS_M4_LO, BS_M4_HI, 4, q[1], q[5]);
+    BS_SWAP(BS_M4_LO, BS_M4_HI, 4, q[2], q[6]);
+    BS_SWAP(BS_M4_LO, BS_M4_HI, 4, q[3], q[7]);
+}
+
+static WC_INLINE word32 bs_load32_le(const byte* p)
+{
+    return  (word32)p[0]        | ((word32)p[1] <<  8) |
+           ((word32)p[2] << 16) | ((word32)p[3] << 24);
+}
+
+static WC_INLINE void bs_store32_le(byte* p, word32 w)
+{
+    p[0] = (byte)(w      );
+    p[1] = (byte)(w >>  8);
+    p[2] = (byte)(w >> 16);
+    p[3] = (byte)(w >> 24);
+}
+
+#if BS_WORD_SIZE == 64
+/* Spread the bytes of four little-endian words of a block over two words. */
+static void bs_interleave_in(bs_word* q0, bs_word* q1, const word32* w)
+{
+    bs_word x0 = w[0];
+    bs_word x1 = w[1];
+    bs_word x2 = w[2];
+    bs_word x3 = w[3];
+
+    x0 |= (x0 << 16);
+    x1 |= (x1 << 16);
+    x2 |= (x2 << 16);
+    x3 |= (x3 << 16);
+    x0 &= W64LIT(0x0000FFFF0000FFFF);
+    x1 &= W64LIT(0x0000FFFF0000FFFF);
+    x2 &= W64LIT(0x0000FFFF0000FFFF);
+    x3 &= W64LIT(0x0000FFFF0000FFFF);
+    x0 |= (x0 << 8);
+    x1 |= (x1 << 8);
+    x2 |= (x2 << 8);
+    x3 |= (x3 << 8);
+    x0 &= W64LIT(0x00FF00FF00FF00FF);
+    x1 &= W64LIT(0x00FF00FF00FF00FF);
+    x2 &= W64LIT(0x00FF00FF00FF00FF);
+    x3 &= W64LIT(0x00FF00FF00FF00FF);
+    *q0 = x0 | (x2 << 8);
+    *q1 = x1 | (x3 << 8);
+}
+
+/* Gather the bytes of a block in two words into four little-endian words. */
+static void bs_interleave_out(word32* w, bs_word q0, bs_word q1)
+{
+    bs_word x0 = q0 & W64LIT(0x00FF00FF00FF00FF);
+    bs_word x1 = q1 & W64LIT(0x00FF00FF00FF00FF);
+    bs_word x2 = (q0 >> 8) & W64LIT(0x00FF00FF00FF00FF);
+    bs_word x3 = (q1 >> 8) & W64LIT(0x00FF00FF00FF00FF);
+
+    x0 |= (x0 >> 8);
+    x1 |= (x1 >> 8);
+    x2 |= (x2 >> 8);
+    x3 |= (x3 >> 8);
+    x0 &= W64LIT(0x0000FFFF0000FFFF);
+    x1 &= W64LIT(0x0000FFFF0000FFFF);
+    x2 &= W64LIT(0x0000FFFF0000FFFF);
+    x3 &= W64LIT(0x0000FFFF0000FFFF);
+    w[0] = (word32)x0 | (word32)(x0 >> 16);
+    w[1] = (word32)x1 | (word32)(x1 >> 16);
+    w[2] = (word32)x2 | (word32)(x2 >> 16);
+    w[3] = (word32)x3 | (word32)(x3 >> 16);
+}
+
+/* Bit-slice the words of a round key into every block of the state. */
+static void bs_slice_key(bs_word* q, const word32* w)
+{
+    bs_interleave_in(&q[0], &q[4], w);
+    q[1] = q[0];
+    q[2] = q[0];
+    q[3] = q[0];
+    q[5] = q[4];
+    q[6] = q[4];
+    q[7] = q[4];
+    bs_ortho(q);
+}
+
+/* Load and bit-slice BS_BLOCK_SIZE bytes of blocks. */
+static void bs_load(bs_word* q, const byte* in)
+{
+    int i;
+    word32 w[4];
+
+    for (i = 0; i < 4; i++) {
+        w[0] = bs_load32_le(in +  0);
+        w[1] = bs_load32_le(in +  4);
+        w[2] = bs_load32_le(in +  8);
+        w[3] = bs_load32_le(in + 12);
+        bs_interleave_in(&q[i], &q[i + 4], w);
+        in += AES_BLOCK_SIZE;
+    }
+    bs_ortho(q);
+}
+
+/* Un-bit-slice and store BS_BLOCK_SIZE bytes of blocks. */
+static void bs_store(byte* out, bs_word* q)
+{
+    int i;
+    word32 w[4];
+
+    bs_ortho(q);
+    for (i = 0; i < 4; i++) {
+        bs_interleave_out(w, q[i], q[i + 4]);
+        bs_store32_le(out +  0, w[0]);
+        bs_store32_le(out +  4, w[1]);
+        bs_store32_le(out +  8, w[2]);
+        bs_store32_le(out + 12, w[3]);
+        out += AES_BLOCK_SIZE;
+    }
+}
+
+static void bs_shift_rows(bs_word* q)
+{
+    int i;
+
+    for (i = 0; i < 8; i++) {
+        bs_word x = q[i];
+
+        q[i] = (x & W64LIT(0x000000000000FFFF))
+            | ((x & W64LIT(0x00000000FFF00000)) >>  4)
+            | ((x & W64LIT(0x00000000000F0000)) << 12)
+            | ((x & W64LIT(0x0000FF0000000000)) >>  8)
+            | ((x & W64LIT(0x000000FF00000000)) <<  8)
+            | ((x & W64LIT(0xF000000000000000)) >> 12)
+            | ((x & W64LIT(0x0FFF000000000000)) <<  4);
+    }
+}
+#else
+/* Bit-slice the words of a round key into both blocks of the state. */
+static void bs_slice_key(bs_word* q, const word32* w)
+{
+    q[0] = q[1] = w[0];
+    q[2] = q[3] = w[1];
+    q[4] = q[5] = w[2];
+    q[6] = q[7] = w[3];
+    bs_ortho(q);
+}
+
+/* Load and bit-slice BS_BLOCK_SIZE bytes of blocks. */
+static void bs_load(bs_word* q, const byte* in)
+{
+    q[0] = bs_load32_le(in +  0);
+    q[2] = bs_load32_le(in +  4);
+    q[4] = bs_load32_le(in +  8);
+    q[6] = bs_load32_le(in + 12);
+    q[1] = bs_load32_le(in + 16);
+    q[3] = bs_load32_le(in + 20);
+    q[5] = bs_load32_le(in + 24);
+    q[7] = bs_load32_le(in + 28);
+    bs_ortho(q);
+}
+
+/* Un-bit-slice and store BS_BLOCK_SIZE bytes of blocks. */
+static void bs_store(byte* out, bs_word* q)
+{
+    bs_ortho(q);
+    bs_store32_le(out +  0, q[0]);
+    bs_store32_le(out +  4, q[2]);
+    bs_store32_le(out +  8, q[4]);
+    bs_store32_le(out + 12, q[6]);
+    bs_store32_le(out + 16, q[1]);
+    bs_store32_le(out + 20, q[3]);
+    bs_store32_le(out + 24, q[5]);
+    bs_store32_le(out + 28, q[7]);
+}
+
+static void bs_shift_rows(bs_word* q)
+{
+    int i;
+
+    for (i = 0; i < 8; i++) {
+        bs_word x = q[i];
+
+        q[i] = (x & 0x000000FFU)
+            | ((x & 0x0000FC00U) >> 2) | ((x & 0x00000300U) << 6)
+            | ((x & 0x00F00000U) >> 4) | ((x & 0x000F0000U) << 4)
+            | ((x & 0xC0000000U) >> 6) | ((x & 0x3F000000U) << 2);
+    }
+}
+#endif
+
+/* Mix columns: 2.a[r] ^ 3.a[r+1] ^ a[r+2] ^ a[r+3]. */
+static void bs_mix_columns(bs_word* q)
+{
+    bs_word q0 = q[0], q1 = q[1], q2 = q[2], q3 = q[3];
+    bs_word q4 = q[4], q5 = q[5], q6 = q[6], q7 = q[7];
+    bs_word r0 = BS_ROT_ROW(q0);
+    bs_word r1 = BS_ROT_ROW(q1);
+    bs_word r2 = BS_ROT_ROW(q2);
+    bs_word r3 = BS_ROT_ROW(q3);
+    bs_word r4 = BS_ROT_ROW(q4);
+    bs_word r5 = BS_ROT_ROW(q5);
+    bs_word r6 = BS_ROT_ROW(q6);
+    bs_word r7 = BS_ROT_ROW(q7);
+
+    q[0] = q7 ^ r7 ^ r0 ^ BS_ROT_ROW2(q0 ^ r0);
+    q[1] = q0 ^ r0 ^ q7 ^ r7 ^ r1 ^ BS_ROT_ROW2(q1 ^ r1);
+    q[2] = q1 ^ r1 ^ r2 ^ BS_ROT_ROW2(q2 ^ r2);
+    q[3] = q2 ^ r2 ^ q7 ^ r7 ^ r3 ^ BS_ROT_ROW2(q3 ^ r3);
+    q[4] = q3 ^ r3 ^ q7 ^ r7 ^ r4 ^ BS_ROT_ROW2(q4 ^ r4);
+    q[5] = q4 ^ r4 ^ r5 ^ BS_ROT_ROW2(q5 ^ r5);
+    q[6] = q5 ^ r5 ^ r6 ^ BS_ROT_ROW2(q6 ^ r6);
+    q[7] = q6 ^ r6 ^ r7 ^ BS_ROT_ROW2(q7 ^ r7);
+}
+
+static WC_INLINE void bs_add_round_key(bs_word* q, const bs_word* rk)
+{
+    q[0] ^= rk[0];
+    q[1] ^= rk[1];
+    q[2] ^= rk[2];
+    q[3] ^= rk[3];
+    q[4] ^= rk[4];
+    q[5] ^= rk[5];
+    q[6] ^= rk[6];
+    q[7] ^= rk[7];
+}
+
+static const FLASH_QUALIFIER byte bs_rcon[] = {
+    0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1B, 0x36,
+    /* for 128-bit blocks, Rijndael never uses more than 10 rcon values */
+};
+
+/* S-box each byte of a little-endian word without table look-ups. */
+static word32 bs_sub_word(word32 x)
+{
+    bs_word q[8];
+
+    XMEMSET(q, 0, sizeof(q));
+    q[0] = x;
+    bs_ortho(q);
+    bs_sub_bytes(q);
+    bs_ortho(q);
+
+    return (word32)q[0];
+}
+
+/* Expand the key and store the bit-sliced round keys.
+ *
+ * @param [out] rk      Bit-sliced round keys.
+ * @param [in]  key     Key data.
+ * @param [in]  keyLen  Length of key in bytes.
+ * @param [in]  rounds  Number of rounds for key length.
+ */
+static void bs_set_key(bs_word* rk, const byte* key, word32 keyLen,
+    word32 rounds)
+{
+    word32 w[15 * 4];
+    word32 nk = keyLen / 4;
+    word32 nkf = (rounds + 1) * 4;
+    word32 i;
+    word32 j;
+    word32 k;
+    word32 t;
+
+    for (i = 0; i < nk; i++) {
+        w[i] = bs_load32_le(key + i * 4);
+    }
+    t = w[nk - 1];
+    for (i = nk, j = 0, k = 0; i < nkf; i++) {
+        if (j == 0) {
+            /* Words are little-endian so RotWord is a right rotate. */
+            t = rotrFixed(t, 8);
+            t = bs_sub_word(t) ^ bs_rcon[k];
+        }
+        else if ((nk > 6) && (j == 4)) {
+            t = bs_sub_word(t);
+        }
+        t ^= w[i - nk];
+        w[i] = t;
+        if (++j == nk) {
+            j = 0;
+            k++;
+        }
+    }
+
+    for (i = 0; i < nkf; i += 4) {
+        bs_slice_key(rk, w + i);
+        rk += 8;
+    }
+
+    ForceZero(w, sizeof(w));
+}
+
+static void bs_encrypt(bs_word* q, const bs_word* rk, word32 r)
+{
+    word32 i;
+
+    bs_add_round_key(q, rk);
+    for (i = 1; i < r; i++) {
+        bs_sub_bytes(q);
+        bs_shift_rows(q);
+        bs_mix_columns(q);
+        rk += 8;
+        bs_add_round_key(q, rk);
+    }
+    bs_sub_bytes(q);
+    bs_shift_rows(q);
+    rk += 8;
+    bs_add_round_key(q, rk);
+}
+
+/* Encrypt a block using AES.
+ *
+ * @param [in]  aes       AES object.
+ * @param [in]  inBlock   Block to encrypt.
+ * @param [out] outBlock  Encrypted block.
+ * @param [in]  r         Rounds divided by 2.
+ */
+static void AesEncrypt_C(Aes* aes, const byte* inBlock, byte* outBlock,
+        word32 r)
+{
+    bs_word q[8];
+    byte block[BS_BLOCK_SIZE];
+
+    (void)r;
+
+    XMEMCPY(block, inBlock, AES_BLOCK_SIZE);
+    XMEMSET(block + AES_BLOCK_SIZE, 0, sizeof(block) - AES_BLOCK_SIZE);
+
+    bs_load(q, block);
+    bs_encrypt(q, aes->bs_key, aes->rounds);
+    bs_store(block, q);
+
+    XMEMCPY(outBlock, block, AES_BLOCK_SIZE);
+}
+
+#if defined(HAVE_AES_ECB) && !(defined(WOLFSSL_IMX6_CAAM) && \
+    !defined(NO_IMX6_CAAM_AES) && !defined(WOLFSSL_QNX_CAAM))
+/* Encrypt a number of blocks using AES.
+ *
+ * @param [in]  aes  AES object.
+ * @param [in]  in   Block to encrypt.
+ * @param [out] out  Encrypted block.
+ * @param [in]  sz   Number of blocks to encrypt.
+ */
+static void AesEncryptBlocks_C(Aes* aes, const byte* in, byte* out, word32 sz)
+{
+    bs_word q[8];
+
+    while (sz >= BS_BLOCK_SIZE) {
+        bs_load(q, in);
+        bs_encrypt(q, aes->bs_key, aes->rounds);
+        bs_store(out, q);
+        sz  -= BS_BLOCK_SIZE;
+        in  += BS_BLOCK_SIZE;
+        out += BS_BLOCK_SIZE;
+    }
+    if (sz > 0) {
+        byte block[BS_BLOCK_SIZE];
+
+        XMEMCPY(block, in, sz);
+        XMEMSET(block + sz, 0, sizeof(block) - sz);
+        bs_load(q, block);
+        bs_encrypt(q, aes->bs_key, aes->rounds);
+        bs_store(block, q);
+        XMEMCPY(out, block, sz);
+    }
+}
+#endif
+
+#endif /* !WC_AES_BITSLICED_NARROW */
+
 #endif /* !WC_AES_BITSLICED */
 
 /* this section disabled with NO_AES_192 */
@@ -3336,6 +3771,8 @@ static void bs_inv_sub_bytes(bs_word u[8])
     u[7] = S0;
 }
 
+#ifndef WC_AES_BITSLICED_NARROW
+
 static void bs_inv_shift_rows(bs_word* b)
 {
     bs_word t[AES_BLOCK_BITS];
@@ -3501,6 +3938,154 @@ static void AesDecryptBlocks_C(Aes* aes, const byte* in, byte* out, word32 sz)
 }
 #endif
 
+#else /* WC_AES_BITSLICED_NARROW */
+
+#if BS_WORD_SIZE == 64
+static void bs_inv_shift_rows(bs_word* q)
+{
+    int i;
+
+    for (i = 0; i < 8; i++) {
+        bs_word x = q[i];
+
+        q[i] = (x & W64LIT(0x000000000000FFFF))
+            | ((x & W64LIT(0x000000000FFF0000)) <<  4)
+            | ((x & W64LIT(0x00000000F0000000)) >> 12)
+            | ((x & W64LIT(0x000000FF00000000)) <<  8)
+            | ((x & W64LIT(0x0000FF0000000000)) >>  8)
+            | ((x & W64LIT(0x000F000000000000)) << 12)
+            | ((x & W64LIT(0xFFF0000000000000)) >>  4);
+    }
+}
+#else
+static void bs_inv_shift_rows(bs_word* q)
+{
+    int i;
+
+    for (i = 0; i < 8; i++) {
+        bs_word x = q[i];
+
+        q[i] = (x & 0x000000FFU)
+            | ((x & 0x00003F00U) << 2) | ((x & 0x0000C000U) >> 6)
+            | ((x & 0x000F0000U) << 4) | ((x & 0x00F00000U) >> 4)
+            | ((x & 0x03000000U) << 6) | ((x & 0xFC000000U) >> 2);
+    }
+}
+#endif
+
+/* Inverse mix columns: e.a[r] ^ b.a[r+1] ^ d.a[r+2] ^ 9.a[r+3]. */
+static void bs_inv_mix_columns(bs_word* q)
+{
+    bs_word q0 = q[0], q1 = q[1], q2 = q[2], q3 = q[3];
+    bs_word q4 = q[4], q5 = q[5], q6 = q[6], q7 = q[7];
+    bs_word r0 = BS_ROT_ROW(q0);
+    bs_word r1 = BS_ROT_ROW(q1);
+    bs_word r2 = BS_ROT_ROW(q2);
+    bs_word r3 = BS_ROT_ROW(q3);
+    bs_word r4 = BS_ROT_ROW(q4);
+    bs_word r5 = BS_ROT_ROW(q5);
+    bs_word r6 = BS_ROT_ROW(q6);
+    bs_word r7 = BS_ROT_ROW(q7);
+
+    q[0] = q5 ^ q6 ^ q7 ^ r0 ^ r5 ^ r7 ^ BS_ROT_ROW2(q0 ^ q5 ^ q6 ^ r0 ^ r5);
+    q[1] = q0 ^ q5 ^ r0 ^ r1 ^ r5 ^ r6 ^ r7 ^
+           BS_ROT_ROW2(q1 ^ q5 ^ q7 ^ r1 ^ r5 ^ r6);
+    q[2] = q0 ^ q1 ^ q6 ^ r1 ^ r2 ^ r6 ^ r7 ^
+           BS_ROT_ROW2(q0 ^ q2 ^ q6 ^ r2 ^ r6 ^ r7);
+    q[3] = q0 ^ q1 ^ q2 ^ q5 ^ q6 ^ r0 ^ r2 ^ r3 ^ r5 ^
+           BS_ROT_ROW2(q0 ^ q1 ^ q3 ^ q5 ^ q6 ^ q7 ^ r0 ^ r3 ^ r5 ^ r7);
+    q[4] = q1 ^ q2 ^ q3 ^ q5 ^ r1 ^ r3 ^ r4 ^ r5 ^ r6 ^ r7 ^
+           BS_ROT_ROW2(q1 ^ q2 ^ q4 ^ q5 ^ q7 ^ r1 ^ r4 ^ r5 ^ r6);
+    q[5] = q2 ^ q3 ^ q4 ^ q6 ^ r2 ^ r4 ^ r5 ^ r6 ^ r7 ^
+           BS_ROT_ROW2(q2 ^ q3 ^ q5 ^ q6 ^ r2 ^ r5 ^ r6 ^ r7);
+    q[6] = q3 ^ q4 ^ q5 ^ q7 ^ r3 ^ r5 ^ r6 ^ r7 ^
+           BS_ROT_ROW2(q3 ^ q4 ^ q6 ^ q7 ^ r3 ^ r6 ^ r7);
+    q[7] = q4 ^ q5 ^ q6 ^ r4 ^ r6 ^ r7 ^
+           BS_ROT_ROW2(q4 ^ q5 ^ q7 ^ r4 ^ r7);
+}
+
+static void bs_decrypt(bs_word* q, const bs_word* rk, word32 r)
+{
+    word32 i;
+
+    rk += r * 8;
+    bs_add_round_key(q, rk);
+    for (i = r - 1; i > 0; i--) {
+        bs_inv_shift_rows(q);
+        bs_inv_sub_bytes(q);
+        rk -= 8;
+        bs_add_round_key(q, rk);
+        bs_inv_mix_columns(q);
+    }
+    bs_inv_shift_rows(q);
+    bs_inv_sub_bytes(q);
+    rk -= 8;
+    bs_add_round_key(q, rk);
+}
+
+#ifdef WOLFSSL_AES_DIRECT
+/* Decrypt a block using AES.
+ *
+ * @param [in]  aes       AES object.
+ * @param [in]  inBlock   Block to encrypt.
+ * @param [out] outBlock  Encrypted block.
+ * @param [in]  r         Rounds divided by 2.
+ */
+static void AesDecrypt_C(Aes* aes, const byte* inBlock, byte* outBlock,
+    word32 r)
+{
+    bs_word q[8];
+    byte block[BS_BLOCK_SIZE];
+
+    (void)r;
+
+    XMEMCPY(block, inBlock, AES_BLOCK_SIZE);
+    XMEMSET(block + AES_BLOCK_SIZE, 0, sizeof(block) - AES_BLOCK_SIZE);
+
+    bs_load(q, block);
+    bs_decrypt(q, aes->bs_key, aes->rounds);
+    bs_store(block, q);
+
+    XMEMCPY(outBlock, block, AES_BLOCK_SIZE);
+}
+#endif
+
+#if defined(HAVE_AES_ECB) && !(defined(WOLFSSL_IMX6_CAAM) && \
+    !defined(NO_IMX6_CAAM_AES) && !defined(WOLFSSL_QNX_CAAM))
+/* Decrypt a number of blocks using AES.
+ *
+ * @param [in]  aes  AES object.
+ * @param [in]  in   Block to encrypt.
+ * @param [out] out  Encrypted block.
+ * @param [in]  sz   Number of blocks to encrypt.
+ */
+static void AesDecryptBlocks_C(Aes* aes, const byte* in, byte* out, word32 sz)
+{
+    bs_word q[8];
+
+    while (sz >= BS_BLOCK_SIZE) {
+        bs_load(q, in);
+        bs_decrypt(q, aes->bs_key, aes->rounds);
+        bs_store(out, q);
+        sz  -= BS_BLOCK_SIZE;
+        in  += BS_BLOCK_SIZE;
+        out += BS_BLOCK_SIZE;
+    }
+    if (sz > 0) {
+        byte block[BS_BLOCK_SIZE];
+
+        XMEMCPY(block, in, sz);
+        XMEMSET(block + sz, 0, sizeof(block) - sz);
+        bs_load(q, block);
+        bs_decrypt(q, aes->bs_key, aes->rounds);
+        bs_store(block, q);
+        XMEMCPY(out, block, sz);
+    }
+}
+#endif
+
+#endif /* !WC_AES_BITSLICED_NARROW */
+
 #endif
 
 #if !defined(WC_AES_BITSLICED) || defined(WOLFSSL_AES_DIRECT)
@@ -6220,7 +6805,8 @@ static WC_INLINE void IncrementGcmCounter(byte* inOutCtr)
 }
 #endif /* !FREESCALE_LTC_AES_GCM */
 
-#if defined(GCM_SMALL) || defined(GCM_TABLE) || defined(GCM_TABLE_4BIT)
+#if defined(GCM_SMALL) || defined(GCM_TABLE) || defined(GCM_TABLE_4BIT) || \
+    defined(GCM_CTMUL64)
 
 static WC_INLINE void FlattenSzInBits(byte* buf, word32 sz)
 {
@@ -6239,6 +6825,9 @@ static WC_INLINE void FlattenSzInBits(byte* buf, word32 sz)
     buf[7] = (byte)sz;
 }
 
+#endif
+
+#if defined(GCM_SMALL) || defined(GCM_TABLE) || defined(GCM_TABLE_4BIT)
 
 static WC_INLINE void RIGHTSHIFTX(byte* x)
 {
@@ -6414,7 +7003,7 @@ int wc_AesGcmSetKey(Aes* aes, const byte* key, word32 len)
         VECTOR_REGISTERS_POP;
     }
     if (ret == 0) {
-    #if defined(GCM_TABLE) || defined(GCM_TABLE_4BIT)
+    #if defined(GCM_TABLE) || defined(GCM_TABLE_4BIT) || defined(GCM_CTMUL64)
         GenerateM0(&aes->gcm);
     #endif /* GCM_TABLE */
     }
@@ -7135,6 +7724,284 @@ void GHASH(Gcm* gcm, const byte* a, word32 aSz, const byte* c,
     }                                                   \
     while (0)
 #endif /* WOLFSSL_AESGCM_STREAM */
+#elif defined(GCM_CTMUL64)
+
+/* Constant-time GHASH using 64-bit integer multiplication.
+ *
+ * A 64x64 carry-less multiply is emulated with integer multiplies of operands
+ * that have only every fourth bit set - the carries land in the holes, which
+ * are masked off. Multiplying bit-reversed operands gives the top half of the
+ * product. A 128-bit product is three of these (Karatsuba) for each half.
+ * Four blocks are multiplied by H^4..H^1 and the products summed before one
+ * reduction.
+ * See: BearSSL ghash_ctmul64 by Thomas Pornin.
+ *
+ * M0 holds, for each power of H: low and high words, their XOR and the
+ * bit-reversed forms of these.
+ */
+
+/* Low 64 bits of carry-less product of x and y. */
+static WC_INLINE word64 GcmBMul64(word64 x, word64 y)
+{
+    word64 x0 = x & W64LIT(0x1111111111111111);
+    word64 x1 = x & W64LIT(0x2222222222222222);
+    word64 x2 = x & W64LIT(0x4444444444444444);
+    word64 x3 = x & W64LIT(0x8888888888888888);
+    word64 y0 = y & W64LIT(0x1111111111111111);
+    word64 y1 = y & W64LIT(0x2222222222222222);
+    word64 y2 = y & W64LIT(0x4444444444444444);
+    word64 y3 = y & W64LIT(0x8888888888888888);
+    word64 z0 = (x0 * y0) ^ (x1 * y3) ^ (x2 * y2) ^ (x3 * y1);
+    word64 z1 = (x0 * y1) ^ (x1 * y0) ^ (x2 * y3) ^ (x3 * y2);
+    word64 z2 = (x0 * y2) ^ (x1 * y1) ^ (x2 * y0) ^ (x3 * y3);
+    word64 z3 = (x0 * y3) ^ (x1 * y2) ^ (x2 * y1) ^ (x3 * y0);
+
+    return (z0 & W64LIT(0x1111111111111111)) |
+           (z1 & W64LIT(0x2222222222222222)) |
+           (z2 & W64LIT(0x4444444444444444)) |
+           (z3 & W64LIT(0x8888888888888888));
+}
+
+/* Reverse the bits of a 64-bit word. */
+static WC_INLINE word64 GcmRev64(word64 x)
+{
+    x = ((x & W64LIT(0x5555555555555555)) <<  1) |
+        ((x >>  1) & W64LIT(0x5555555555555555));
+    x = ((x & W64LIT(0x3333333333333333)) <<  2) |
+        ((x >>  2) & W64LIT(0x3333333333333333));
+    x = ((x & W64LIT(0x0F0F0F0F0F0F0F0F)) <<  4) |
+        ((x >>  4) & W64LIT(0x0F0F0F0F0F0F0F0F));
+    x = ((x & W64LIT(0x00FF00FF00FF00FF)) <<  8) |
+        ((x >>  8) & W64LIT(0x00FF00FF00FF00FF));
+    x = ((x & W64LIT(0x0000FFFF0000FFFF)) << 16) |
+        ((x >> 16) & W64LIT(0x0000FFFF0000FFFF));
+    return (x << 32) | (x >> 32);
+}
+
+static WC_INLINE word64 GcmLoad64BE(const byte* p)
+{
+    word64 v;
+
+    XMEMCPY(&v, p, sizeof(v));
+#ifdef LITTLE_ENDIAN_ORDER
+    v = ByteReverseWord64(v);
+#endif
+    return v;
+}
+
+static WC_INLINE void GcmStore64BE(byte* p, word64 v)
+{
+#ifdef LITTLE_ENDIAN_ORDER
+    v = ByteReverseWord64(v);
+#endif
+    XMEMCPY(p, &v, sizeof(v));
+}
+
+/* Add the unreduced product of (y1:y0) and a power of H into z.
+ *
+ * @param [in, out] z   Six words of accumulated product halves.
+ * @param [in]      y1  High word of value.
+ * @param [in]      y0  Low word of value.
+ * @param [in]      hp  Power of H with derived values.
+ */
+static WC_INLINE void GcmMulAcc(word64* z, word64 y1, word64 y0,
+    const word64* hp)
+{
+    word64 y0r = GcmRev64(y0);
+    word64 y1r = GcmRev64(y1);
+
+    z[0] ^= GcmBMul64(y0, hp[0]);
+    z[1] ^= GcmBMul64(y1, hp[1]);
+    z[2] ^= GcmBMul64(y0 ^ y1, hp[2]);
+    z[3] ^= GcmBMul64(y0r, hp[3]);
+    z[4] ^= GcmBMul64(y1r, hp[4]);
+    z[5] ^= GcmBMul64(y0r ^ y1r, hp[5]);
+}
+
+/* Combine and reduce accumulated product halves into x.
+ *
+ * @param [out] x  Result: x[0] is low and x[1] is high word.
+ * @param [in]  z  Six words of accumulated product halves.
+ */
+static WC_INLINE void GcmReduce(word64* x, const word64* z)
+{
+    word64 z2  = z[2] ^ z[0] ^ z[1];
+    word64 z2h = z[5] ^ z[3] ^ z[4];
+    word64 z0h = GcmRev64(z[3]) >> 1;
+    word64 z1h = GcmRev64(z[4]) >> 1;
+    word64 v0, v1, v2, v3;
+
+    z2h = GcmRev64(z2h) >> 1;
+
+    v0 = z[0];
+    v1 = z0h ^ z2;
+    v2 = z[1] ^ z2h;
+    v3 = z1h;
+
+    /* Bits are reflected - shift product into place. */
+    v3 = (v3 << 1) | (v2 >> 63);
+    v2 = (v2 << 1) | (v1 >> 63);
+    v1 = (v1 << 1) | (v0 >> 63);
+    v0 = (v0 << 1);
+
+    /* Reduce by x^128 + x^7 + x^2 + x + 1. */
+    v2 ^= v0 ^ (v0 >> 1) ^ (v0 >> 2) ^ (v0 >> 7);
+    v1 ^= (v0 << 63) ^ (v0 << 62) ^ (v0 << 57);
+    v3 ^= v1 ^ (v1 >> 1) ^ (v1 >> 2) ^ (v1 >> 7);
+    v2 ^= (v1 << 63) ^ (v1 << 62) ^ (v1 << 57);
+
+    x[0] = v2;
+    x[1] = v3;
+}
+
+/* GHASH whole blocks of data into x.
+ *
+ * @param [in]      m       Powers of H with derived values.
+ * @param [in, out] x       GHASH state: x[0] is low and x[1] is high word.
+ * @param [in]      data    Blocks of data.
+ * @param [in]      blocks  Number of blocks.
+ */
+static void GcmCtMul64Blocks(const word64 (*m)[6], word64* x,
+    const byte* data, word32 blocks)
+{
+    word64 z[6];
+
+    while (blocks >= 4) {
+        XMEMSET(z, 0, sizeof(z));
+        GcmMulAcc(z, x[1] ^ GcmLoad64BE(data),
+                     x[0] ^ GcmLoad64BE(data + 8), m[3]);
+        GcmMulAcc(z, GcmLoad64BE(data + 16), GcmLoad64BE(data + 24), m[2]);
+        GcmMulAcc(z, GcmLoad64BE(data + 32), GcmLoad64BE(data + 40), m[1]);
+        GcmMulAcc(z, GcmLoad64BE(data + 48), GcmLoad64BE(data + 56), m[0]);
+        GcmReduce(x, z);
+        data += 4 * AES_BLOCK_SIZE;
+        blocks -= 4;
+    }
+    while (blocks > 0) {
+        XMEMSET(z, 0, sizeof(z));
+        GcmMulAcc(z, x[1] ^ GcmLoad64BE(data),
+                     x[0] ^ GcmLoad64BE(data + 8), m[0]);
+        GcmReduce(x, z);
+        data += AES_BLOCK_SIZE;
+        blocks--;
+    }
+}
+
+/* Calculate H^1..H^4 and their derived values.
+ *
+ * @param [in, out] gcm  GCM object with H set.
+ */
+void GenerateM0(Gcm* gcm)
+{
+    word64 p[2];
+    word64 z[6];
+    int i;
+
+    p[1] = GcmLoad64BE(gcm->H);
+    p[0] = GcmLoad64BE(gcm->H + 8);
+
+    for (i = 0; i < 4; i++) {
+        if (i > 0) {
+            /* Next power: previous power times H. */
+            XMEMSET(z, 0, sizeof(z));
+            GcmMulAcc(z, p[1], p[0], gcm->M0[0]);
+            GcmReduce(p, z);
+        }
+        gcm->M0[i][0] = p[0];
+        gcm->M0[i][1] = p[1];
+        gcm->M0[i][2] = p[0] ^ p[1];
+        gcm->M0[i][3] = GcmRev64(p[0]);
+        gcm->M0[i][4] = GcmRev64(p[1]);
+        gcm->M0[i][5] = gcm->M0[i][3] ^ gcm->M0[i][4];
+    }
+
+    ForceZero(p, sizeof(p));
+    ForceZero(z, sizeof(z));
+}
+
+void GHASH(Gcm* gcm, const byte* a, word32 aSz, const byte* c,
+    word32 cSz, byte* s, word32 sSz)
+{
+    word64 x[2] = {0, 0};
+    byte scratch[AES_BLOCK_SIZE];
+    word32 blocks, partial;
+
+    if (gcm == NULL) {
+        return;
+    }
+
+    /* Hash in A, the Additional Authentication Data */
+    if (aSz != 0 && a != NULL) {
+        blocks = aSz / AES_BLOCK_SIZE;
+        partial = aSz % AES_BLOCK_SIZE;
+        GcmCtMul64Blocks((const word64 (*)[6])gcm->M0, x, a, blocks);
+        if (partial != 0) {
+            XMEMSET(scratch, 0, AES_BLOCK_SIZE);
+            XMEMCPY(scratch, a + blocks * AES_BLOCK_SIZE, partial);
+            GcmCtMul64Blocks((const word64 (*)[6])gcm->M0, x, scratch, 1);
+        }
+    }
+
+    /* Hash in C, the Ciphertext */
+    if (cSz != 0 && c != NULL) {
+        blocks = cSz / AES_BLOCK_SIZE;
+        partial = cSz % AES_BLOCK_SIZE;
+        GcmCtMul64Blocks((const word64 (*)[6])gcm->M0, x, c, blocks);
+        if (partial != 0) {
+            XMEMSET(scratch, 0, AES_BLOCK_SIZE);
+            XMEMCPY(scratch, c + blocks * AES_BLOCK_SIZE, partial);
+            GcmCtMul64Blocks((const word64 (*)[6])gcm->M0, x, scratch, 1);
+        }
+    }
+
+    /* Hash in the lengths of A and C in bits */
+    FlattenSzInBits(&scratch[0], aSz);
+    FlattenSzInBits(&scratch[8], cSz);
+    GcmCtMul64Blocks((const word64 (*)[6])gcm->M0, x, scratch, 1);
+
+    /* Copy the result into s. */
+    GcmStore64BE(scratch, x[1]);
+    GcmStore64BE(scratch + 8, x[0]);
+    XMEMCPY(s, scratch, sSz);
+}
+
+#ifdef WOLFSSL_AESGCM_STREAM
+/* No extra initialization for 64-bit multiply implementation.
+ *
+ * @param [in] aes  AES GCM object.
+ */
+#define GHASH_INIT_EXTRA(aes) WC_DO_NOTHING
+
+/* GHASH blocks of data.
+ *
+ * Tag is kept as a big-endian byte array between calls.
+ *
+ * @param [in, out] aes     AES GCM object.
+ * @param [in]      data    Blocks of AAD or cipher text.
+ * @param [in]      blocks  Number of blocks.
+ */
+#define GHASH_BLOCKS(aes, data, blocks)                                 \
+    do {                                                                \
+        word64 x_[2];                                                   \
+        x_[1] = GcmLoad64BE(AES_TAG(aes));                              \
+        x_[0] = GcmLoad64BE(AES_TAG(aes) + 8);                          \
+        GcmCtMul64Blocks((const word64 (*)[6])(aes)->gcm.M0, x_, data,  \
+            blocks);                                                    \
+        GcmStore64BE(AES_TAG(aes), x_[1]);                              \
+        GcmStore64BE(AES_TAG(aes) + 8, x_[0]);                          \
+    }                                                                   \
+    while (0)
+
+/* GHASH one block of data.
+ *
+ * XOR block into tag and multiply by H.
+ *
+ * @param [in, out] aes    AES GCM object.
+ * @param [in]      block  Block of AAD or cipher text.
+ */
+#define GHASH_ONE_BLOCK(aes, block) GHASH_BLOCKS(aes, block, 1)
+#endif /* WOLFSSL_AESGCM_STREAM */
+/* end GCM_CTMUL64 */
 #elif defined(WORD64_AVAILABLE) && !defined(GCM_WORD32)
 
 #if !defined(FREESCALE_LTC_AES_GCM)
@@ -7776,10 +8643,15 @@ static void GHASH_UPDATE(Aes* aes, const byte* a, word32 aSz, const byte* c,
         blocks = aSz / AES_BLOCK_SIZE;
         partial = aSz % AES_BLOCK_SIZE;
         /* GHASH full blocks now. */
+    #ifdef GHASH_BLOCKS
+        GHASH_BLOCKS(aes, a, blocks);
+        a += blocks * AES_BLOCK_SIZE;
+    #else
         while (blocks--) {
             GHASH_ONE_BLOCK(aes, a);
             a += AES_BLOCK_SIZE;
         }
+    #endif
         if (partial != 0) {
             /* Cache the partial block. */
             XMEMCPY(AES_LASTGBLOCK(aes), a, partial);
@@ -7825,10 +8697,15 @@ static void GHASH_UPDATE(Aes* aes, const byte* a, word32 aSz, const byte* c,
         blocks = cSz / AES_BLOCK_SIZE;
         partial = cSz % AES_BLOCK_SIZE;
         /* GHASH full blocks now. */
+    #ifdef GHASH_BLOCKS
+        GHASH_BLOCKS(aes, c, blocks);
+        c += blocks * AES_BLOCK_SIZE;
+    #else
         while (blocks--) {
             GHASH_ONE_BLOCK(aes, c);
             c += AES_BLOCK_SIZE;
         }
+    #endif
         if (partial != 0) {
             /* Cache the partial block. */
             XMEMCPY(AES_LASTGBLOCK(aes), c, partial);
@@ -12252,6 +13129,18 @@ int wc_AesKeyUnWrap(const byte* key, word32 keySz, const byte* in, word32 inSz,
 /* Galios Field to use */
 #define GF_XTS 0x87
 
+#if defined(WOLFSSL_AESXTS_THREADS) && !defined(SINGLE_THREADED)
+    #define AESXTS_THREADS
+    /* Least number of bytes given to each thread. */
+    #ifndef WOLFSSL_AESXTS_THREAD_MIN
+        #define WOLFSSL_AESXTS_THREAD_MIN   (64 * 1024)
+    #endif
+    /* Most threads a run of consecutive sectors is split across. */
+    #ifndef WOLFSSL_AESXTS_MAX_THREADS
+        #define WOLFSSL_AESXTS_MAX_THREADS  16
+    #endif
+#endif
+
 int wc_AesXtsInit(XtsAes* aes, void* heap, int devId)
 {
     int    ret = 0;
@@ -12266,6 +13155,9 @@ int wc_AesXtsInit(XtsAes* aes, void* heap, int devId)
     if ((ret = wc_AesInit(&aes->aes, heap, devId)) != 0) {
         return ret;
     }
+#ifdef AESXTS_THREADS
+    aes->threads = 1;
+#endif
 
     return 0;
 }
@@ -12881,41 +13773,38 @@ int wc_AesXtsDecrypt(XtsAes* xaes, byte* out, const byte* in, word32 sz,
 }
 #endif /* !WOLFSSL_ARMASM || WOLFSSL_ARMASM_NO_HW_CRYPTO */
 
-/* Same as wc_AesXtsEncryptSector but the sector gets incremented by one every
- * sectorSz bytes
+/* Encrypt or decrypt sectors one after the other on the calling thread.
  *
- * xaes     AES keys to use for block encrypt
- * out      output buffer to hold cipher text
- * in       input plain text buffer to encrypt
+ * aes      AES keys to use for block encrypt/decrypt
+ * out      output buffer
+ * in       input buffer
  * sz       size of both out and in buffers
- * sector   value to use for tweak
+ * sector   value to use for tweak of first sector
  * sectorSz size of the sector
+ * dir      AES_ENCRYPTION or AES_DECRYPTION
  *
  * returns 0 on success
  */
-int wc_AesXtsEncryptConsecutiveSectors(XtsAes* aes, byte* out, const byte* in,
-        word32 sz, word64 sector, word32 sectorSz)
+static int AesXtsSectors(XtsAes* aes, byte* out, const byte* in, word32 sz,
+        word64 sector, word32 sectorSz, int dir)
 {
     int ret  = 0;
     word32 iter = 0;
     word32 sectorCount;
     word32 remainder;
 
-    if (aes == NULL || out == NULL || in == NULL || sectorSz == 0) {
-        return BAD_FUNC_ARG;
-    }
-
-    if (sz < AES_BLOCK_SIZE) {
-        WOLFSSL_MSG("Cipher text input too small for encryption");
-        return BAD_FUNC_ARG;
-    }
-
     sectorCount  = sz / sectorSz;
     remainder = sz % sectorSz;
 
     while (sectorCount) {
-        ret = wc_AesXtsEncryptSector(aes, out + (iter * sectorSz),
-                in + (iter * sectorSz), sectorSz, sector);
+        if (dir == AES_ENCRYPTION) {
+            ret = wc_AesXtsEncryptSector(aes, out + (iter * sectorSz),
+                    in + (iter * sectorSz), sectorSz, sector);
+        }
+        else {
+            ret = wc_AesXtsDecryptSector(aes, out + (iter * sectorSz),
+                    in + (iter * sectorSz), sectorSz, sector);
+        }
         if (ret != 0)
             break;
 
@@ -12924,12 +13813,157 @@ int wc_AesXtsEncryptConsecutiveSectors(XtsAes* aes, byte* out, const byte* in,
         sector++;
     }
 
-    if (remainder && ret == 0)
-        ret = wc_AesXtsEncryptSector(aes, out + (iter * sectorSz),
-                in + (iter * sectorSz), remainder, sector);
+    if (remainder && ret == 0) {
+        if (dir == AES_ENCRYPTION) {
+            ret = wc_AesXtsEncryptSector(aes, out + (iter * sectorSz),
+                    in + (iter * sectorSz), remainder, sector);
+        }
+        else {
+            ret = wc_AesXtsDecryptSector(aes, out + (iter * sectorSz),
+                    in + (iter * sectorSz), remainder, sector);
+        }
+    }
+
+    return ret;
+}
+
+#ifdef AESXTS_THREADS
+/* Range of sectors handled by one thread. */
+typedef struct AesXtsSectorJob {
+    XtsAes*     aes;
+    byte*       out;
+    const byte* in;
+    word32      sz;
+    word32      sectorSz;
+    word64      sector;
+    int         dir;
+    int         ret;
+} AesXtsSectorJob;
+
+static THREAD_RETURN WOLFSSL_THREAD AesXtsSectorThread(void* arg)
+{
+    AesXtsSectorJob* job = (AesXtsSectorJob*)arg;
+
+    job->ret = AesXtsSectors(job->aes, job->out, job->in, job->sz,
+        job->sector, job->sectorSz, job->dir);
+    WOLFSSL_RETURN_FROM_THREAD(0);
+}
+
+/* Split consecutive sectors into contiguous ranges, one per thread.
+ *
+ * Each range starts on a sector boundary and derives its own tweaks from the
+ * number of its first sector. The last range takes any partial sector. The
+ * key schedules are only read so all threads share the one XtsAes. The first
+ * range is processed on the calling thread and a range whose thread can't be
+ * started is processed there too.
+ *
+ * aes      AES keys to use for block encrypt/decrypt
+ * out      output buffer
+ * in       input buffer
+ * sz       size of both out and in buffers
+ * sector   value to use for tweak of first sector
+ * sectorSz size of the sector
+ * dir      AES_ENCRYPTION or AES_DECRYPTION
+ *
+ * returns 0 on success
+ */
+static int AesXtsSectorsThreaded(XtsAes* aes, byte* out, const byte* in,
+        word32 sz, word64 sector, word32 sectorSz, int dir)
+{
+    AesXtsSectorJob job[WOLFSSL_AESXTS_MAX_THREADS];
+    THREAD_TYPE tid[WOLFSSL_AESXTS_MAX_THREADS];
+    int started[WOLFSSL_AESXTS_MAX_THREADS];
+    word32 sectorCount = sz / sectorSz;
+    word32 threads = aes->threads;
+    word32 per;
+    word32 extra;
+    word32 first = 0;
+    word32 t;
+    int ret = 0;
+
+    if (threads > WOLFSSL_AESXTS_MAX_THREADS)
+        threads = WOLFSSL_AESXTS_MAX_THREADS;
+    if (threads > sz / WOLFSSL_AESXTS_THREAD_MIN)
+        threads = sz / WOLFSSL_AESXTS_THREAD_MIN;
+    if (threads > sectorCount)
+        threads = sectorCount;
+#ifdef WOLF_CRYPTO_CB
+    /* Devices may keep state in the Aes objects. */
+    if (aes->aes.devId != INVALID_DEVID)
+        threads = 1;
+#endif
+    if (threads <= 1) {
+        return AesXtsSectors(aes, out, in, sz, sector, sectorSz, dir);
+    }
+
+    per = sectorCount / threads;
+    extra = sectorCount % threads;
+    for (t = 0; t < threads; t++) {
+        word32 cnt = per + ((t < extra) ? 1 : 0);
+
+        job[t].aes = aes;
+        job[t].out = out + first * sectorSz;
+        job[t].in = in + first * sectorSz;
+        job[t].sz = cnt * sectorSz;
+        job[t].sectorSz = sectorSz;
+        job[t].sector = sector + first;
+        job[t].dir = dir;
+        job[t].ret = 0;
+        first += cnt;
+    }
+    job[threads - 1].sz += sz % sectorSz;
+
+    for (t = 1; t < threads; t++) {
+        started[t] = (wolfSSL_NewThread(&tid[t], AesXtsSectorThread,
+                                        &job[t]) == 0);
+    }
+    (void)AesXtsSectorThread(&job[0]);
+    for (t = 1; t < threads; t++) {
+        if (started[t])
+            (void)wolfSSL_JoinThread(tid[t]);
+        else
+            (void)AesXtsSectorThread(&job[t]);
+    }
 
+    for (t = 0; (ret == 0) && (t < threads); t++) {
+        ret = job[t].ret;
+    }
     return ret;
 }
+#endif /* AESXTS_THREADS */
+
+/* Same as wc_AesXtsEncryptSector but the sector gets incremented by one every
+ * sectorSz bytes
+ *
+ * xaes     AES keys to use for block encrypt
+ * out      output buffer to hold cipher text
+ * in       input plain text buffer to encrypt
+ * sz       size of both out and in buffers
+ * sector   value to use for tweak
+ * sectorSz size of the sector
+ *
+ * returns 0 on success
+ */
+int wc_AesXtsEncryptConsecutiveSectors(XtsAes* aes, byte* out, const byte* in,
+        word32 sz, word64 sector, word32 sectorSz)
+{
+    if (aes == NULL || out == NULL || in == NULL || sectorSz == 0) {
+        return BAD_FUNC_ARG;
+    }
+
+    if (sz < AES_BLOCK_SIZE) {
+        WOLFSSL_MSG("Cipher text input too small for encryption");
+        return BAD_FUNC_ARG;
+    }
+
+#ifdef AESXTS_THREADS
+    if (aes->threads > 1) {
+        return AesXtsSectorsThreaded(aes, out, in, sz, sector, sectorSz,
+            AES_ENCRYPTION);
+    }
+#endif
+    return AesXtsSectors(aes, out, in, sz, sector, sectorSz, AES_ENCRYPTION);
+}
 
 /* Same as wc_AesXtsEncryptConsecutiveSectors but Aes key is AES_DECRYPTION type
  *
@@ -12945,11 +13979,6 @@ int wc_AesXtsEncryptConsecutiveSectors(XtsAes* aes, byte* out, const byte* in,
 int wc_AesXtsDecryptConsecutiveSectors(XtsAes* aes, byte* out, const byte* in,
         word32 sz, word64 sector, word32 sectorSz)
 {
-    int ret  = 0;
-    word32 iter = 0;
-    word32 sectorCount;
-    word32 remainder;
-
     if (aes == NULL || out == NULL || in == NULL || sectorSz == 0) {
         return BAD_FUNC_ARG;
     }
@@ -12959,26 +13988,200 @@ int wc_AesXtsDecryptConsecutiveSectors(XtsAes* aes, byte* out, const byte* in,
         return BAD_FUNC_ARG;
     }
 
-    sectorCount  = sz / sectorSz;
-    remainder = sz % sectorSz;
+#ifdef AESXTS_THREADS
+    if (aes->threads > 1) {
+        return AesXtsSectorsThreaded(aes, out, in, sz, sector, sectorSz,
+            AES_DECRYPTION);
+    }
+#endif
+    return AesXtsSectors(aes, out, in, sz, sector, sectorSz, AES_DECRYPTION);
+}
 
-    while (sectorCount) {
-        ret = wc_AesXtsDecryptSector(aes, out + (iter * sectorSz),
-                in + (iter * sectorSz), sectorSz, sector);
-        if (ret != 0)
+#ifdef AESXTS_THREADS
+/* Split consecutive sector runs across up to threads threads
+ *
+ * aes      AES keys to use for block encrypt/decrypt
+ * threads  number of threads, 1 to use only the calling thread
+ *
+ * returns 0 on success
+ */
+int wc_AesXtsSetThreads(XtsAes* aes, word32 threads)
+{
+    if (aes == NULL || threads == 0) {
+        return BAD_FUNC_ARG;
+    }
+
+    aes->threads = threads;
+
+    return 0;
+}
+
+/* Read of the next chunk done on its own thread. */
+typedef struct AesXtsReadJob {
+    wc_AesXtsReadCb readCb;
+    void*           ctx;
+    byte*           buf;
+    word32          sz;
+    int             ret;
+} AesXtsReadJob;
+
+/* Call the read callback until the chunk is full or it reports the end.
+ *
+ * A callback may return fewer bytes than asked for, as read() does, so only a
+ * return of 0 ends the data.
+ *
+ * returns the number of bytes read, or the negative error code from the
+ * callback
+ */
+static int AesXtsReadChunk(wc_AesXtsReadCb readCb, void* ctx, byte* buf,
+        word32 sz)
+{
+    word32 got = 0;
+
+    while (got < sz) {
+        int n = readCb(ctx, buf + got, sz - got);
+        if (n < 0) {
+            return n;
+        }
+        if (n == 0) {
             break;
+        }
+        if ((word32)n > sz - got) {
+            return BUFFER_E;
+        }
+        got += (word32)n;
+    }
 
-        sectorCount--;
-        iter++;
-        sector++;
+    return (int)got;
+}
+
+static THREAD_RETURN WOLFSSL_THREAD AesXtsReadThread(void* arg)
+{
+    AesXtsReadJob* job = (AesXtsReadJob*)arg;
+
+    job->ret = AesXtsReadChunk(job->readCb, job->ctx, job->buf, job->sz);
+    WOLFSSL_RETURN_FROM_THREAD(0);
+}
+
+/* Read, encrypt or decrypt in place, and write consecutive sectors in chunks.
+ *
+ * buf is split in two. While one half is encrypted or decrypted and written,
+ * the next chunk is read into the other half on another thread. A chunk that
+ * can't be filled because the read callback returned 0 is the last one.
+ *
+ * returns 0 on success
+ */
+static int AesXtsPipelined(XtsAes* aes, byte* buf, word32 bufSz,
+        word64 sector, word32 sectorSz, wc_AesXtsReadCb readCb,
+        wc_AesXtsWriteCb writeCb, void* ctx, int dir)
+{
+    AesXtsReadJob rd;
+    byte* cur;
+    word32 chunk;
+    int n;
+    int ret = 0;
+
+    if (aes == NULL || buf == NULL || sectorSz == 0 || readCb == NULL ||
+            writeCb == NULL) {
+        return BAD_FUNC_ARG;
     }
+    chunk = ((bufSz / 2) / sectorSz) * sectorSz;
+    if (chunk == 0) {
+        return BAD_FUNC_ARG;
+    }
+
+    cur = buf;
+    rd.readCb = readCb;
+    rd.ctx = ctx;
+    rd.sz = chunk;
+    n = AesXtsReadChunk(readCb, ctx, cur, chunk);
+    while (n > 0) {
+        int more = ((word32)n == chunk);
+        int started = 0;
+        THREAD_TYPE tid;
 
-    if (remainder && ret == 0)
-        ret = wc_AesXtsDecryptSector(aes, out + (iter * sectorSz),
-                in + (iter * sectorSz), remainder, sector);
+        if (more) {
+            rd.buf = (cur == buf) ? buf + chunk : buf;
+            rd.ret = 0;
+            started = (wolfSSL_NewThread(&tid, AesXtsReadThread, &rd) == 0);
+        }
+
+        if (dir == AES_ENCRYPTION) {
+            ret = wc_AesXtsEncryptConsecutiveSectors(aes, cur, cur, (word32)n,
+                sector, sectorSz);
+        }
+        else {
+            ret = wc_AesXtsDecryptConsecutiveSectors(aes, cur, cur, (word32)n,
+                sector, sectorSz);
+        }
+        if (ret == 0) {
+            ret = writeCb(ctx, cur, (word32)n);
+        }
+
+        if (started) {
+            (void)wolfSSL_JoinThread(tid);
+        }
+        else if (more && (ret == 0)) {
+            (void)AesXtsReadThread(&rd);
+        }
+        if ((ret != 0) || !more) {
+            break;
+        }
+
+        n = rd.ret;
+        cur = rd.buf;
+        sector += chunk / sectorSz;
+    }
+    if ((ret == 0) && (n < 0)) {
+        ret = n;
+    }
 
     return ret;
 }
+
+/* Encrypt a stream of consecutive sectors, reading the next chunk while the
+ * current one is encrypted and written.
+ *
+ * aes      AES keys to use for block encrypt
+ * buf      working buffer, split into two chunks
+ * bufSz    size of buf - each chunk is a whole number of sectors
+ * sector   value to use for tweak of first sector
+ * sectorSz size of the sector
+ * readCb   called to read the next plain text, may run on a helper thread
+ * writeCb  called to write each cipher text chunk
+ * ctx      passed to the callbacks
+ *
+ * returns 0 on success, or the negative error code from a callback
+ */
+int wc_AesXtsEncryptPipelined(XtsAes* aes, byte* buf, word32 bufSz,
+        word64 sector, word32 sectorSz, wc_AesXtsReadCb readCb,
+        wc_AesXtsWriteCb writeCb, void* ctx)
+{
+    return AesXtsPipelined(aes, buf, bufSz, sector, sectorSz, readCb, writeCb,
+        ctx, AES_ENCRYPTION);
+}
+
+/* Same as wc_AesXtsEncryptPipelined but Aes key is AES_DECRYPTION type
+ *
+ * aes      AES keys to use for block decrypt
+ * buf      working buffer, split into two chunks
+ * bufSz    size of buf - each chunk is a whole number of sectors
+ * sector   value to use for tweak of first sector
+ * sectorSz size of the sector
+ * readCb   called to read the next cipher text, may run on a helper thread
+ * writeCb  called to write each plain text chunk
+ * ctx      passed to the callbacks
+ *
+ * returns 0 on success, or the negative error code from a callback
+ */
+int wc_AesXtsDecryptPipelined(XtsAes* aes, byte* buf, word32 bufSz,
+        word64 sector, word32 sectorSz, wc_AesXtsReadCb readCb,
+        wc_AesXtsWriteCb writeCb, void* ctx)
+{
+    return AesXtsPipelined(aes, buf, bufSz, sector, sectorSz, readCb, writeCb,
+        ctx, AES_DECRYPTION);
+}
+#endif /* AESXTS_THREADS */
 #endif /* WOLFSSL_AES_XTS */
 
 #ifdef WOLFSSL_AES_SIV
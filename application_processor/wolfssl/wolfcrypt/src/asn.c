@@ -6393,6 +6393,18 @@ static const ASNItem rsaKeyASN[] = {
 /*  U   */        { 1, ASN_INTEGER, 0, 0, 0 },
                 /* otherPrimeInfos  OtherPrimeInfos OPTIONAL
                  * v2 - multiprime */
+#ifdef WOLFSSL_RSA_MULTI_PRIME
+/*  OPS */        { 1, ASN_SEQUENCE, 1, 1, 1 },
+                      /* OtherPrimeInfo: prime, exponent, coefficient */
+/*  OP0 */            { 2, ASN_SEQUENCE, 1, 1, 0 },
+/*  R0  */                { 3, ASN_INTEGER, 0, 0, 0 },
+/*  D0  */                { 3, ASN_INTEGER, 0, 0, 0 },
+/*  T0  */                { 3, ASN_INTEGER, 0, 0, 0 },
+/*  OP1 */            { 2, ASN_SEQUENCE, 1, 1, 1 },
+/*  R1  */                { 3, ASN_INTEGER, 0, 0, 0 },
+/*  D1  */                { 3, ASN_INTEGER, 0, 0, 0 },
+/*  T1  */                { 3, ASN_INTEGER, 0, 0, 0 },
+#endif
 #endif
 };
 enum {
@@ -6409,10 +6421,29 @@ enum {
     RSAKEYASN_IDX_DP,
     RSAKEYASN_IDX_DQ,
     RSAKEYASN_IDX_U,
+#ifdef WOLFSSL_RSA_MULTI_PRIME
+    RSAKEYASN_IDX_OPS,
+    RSAKEYASN_IDX_OP0,
+    RSAKEYASN_IDX_R0,
+    RSAKEYASN_IDX_D0,
+    RSAKEYASN_IDX_T0,
+    RSAKEYASN_IDX_OP1,
+    RSAKEYASN_IDX_R1,
+    RSAKEYASN_IDX_D1,
+    RSAKEYASN_IDX_T1,
+#endif
 #endif
     WOLF_ENUM_DUMMY_LAST_ELEMENT(RSAKEYASN_IDX)
 };
 
+#ifdef WOLFSSL_RSA_MULTI_PRIME
+    #if RSA_MAX_OTHER_PRIMES != 2
+        #error "rsaKeyASN has OtherPrimeInfo items for two other primes"
+    #endif
+    /* Number of template items for each OtherPrimeInfo. */
+    #define RSAKEYASN_OP_ITEMS  (RSAKEYASN_IDX_OP1 - RSAKEYASN_IDX_OP0)
+#endif
+
 /* Number of items in ASN.1 template for an RSA private key. */
 #define rsaKeyASN_Length (sizeof(rsaKeyASN) / sizeof(ASNItem))
 #endif
@@ -6447,6 +6478,9 @@ static int _RsaPrivateKeyDecode(const byte* input, word32* inOutIdx,
 #ifndef WOLFSSL_ASN_TEMPLATE
     int version, length;
     word32 algId = 0;
+#ifdef WOLFSSL_RSA_MULTI_PRIME
+    word32 seqEnd;
+#endif
 
     if (inOutIdx == NULL || input == NULL || (key == NULL && keySz == NULL)) {
         return BAD_FUNC_ARG;
@@ -6459,6 +6493,9 @@ static int _RsaPrivateKeyDecode(const byte* input, word32* inOutIdx,
 
     if (GetSequence(input, inOutIdx, &length, inSz) < 0)
         return ASN_PARSE_E;
+#ifdef WOLFSSL_RSA_MULTI_PRIME
+    seqEnd = *inOutIdx + (word32)length;
+#endif
 
     if (GetMyVersion(input, inOutIdx, &version, inSz) < 0)
         return ASN_PARSE_E;
@@ -6476,6 +6513,12 @@ static int _RsaPrivateKeyDecode(const byte* input, word32* inOutIdx,
                 return ASN_RSA_KEY_E;
             }
         }
+    #ifdef WOLFSSL_RSA_MULTI_PRIME
+        /* Skip OtherPrimeInfos. */
+        if (version == PKCS1v1) {
+            *inOutIdx = seqEnd;
+        }
+    #endif
     }
     else {
         key->type = RSA_PRIVATE;
@@ -6517,6 +6560,31 @@ static int _RsaPrivateKeyDecode(const byte* input, word32* inOutIdx,
             SkipInt(input, inOutIdx, inSz) < 0 )  return ASN_RSA_KEY_E;
     #endif
 
+    #ifdef WOLFSSL_RSA_MULTI_PRIME
+        /* OtherPrimeInfos only with multi-prime version. */
+        key->otherPrimes = 0;
+        if ((version == PKCS1v1) && (*inOutIdx < seqEnd)) {
+            word32 opEnd;
+
+            if (GetSequence(input, inOutIdx, &length, inSz) < 0)
+                return ASN_PARSE_E;
+            opEnd = *inOutIdx + (word32)length;
+            while (*inOutIdx < opEnd) {
+                int i = key->otherPrimes;
+
+                if (i == RSA_MAX_OTHER_PRIMES)
+                    return ASN_RSA_KEY_E;
+                if (GetSequence(input, inOutIdx, &length, inSz) < 0 ||
+                    GetInt(&key->r[i],  input, inOutIdx, inSz) < 0 ||
+                    GetInt(&key->dR[i], input, inOutIdx, inSz) < 0 ||
+                    GetInt(&key->tR[i], input, inOutIdx, inSz) < 0) {
+                    return ASN_RSA_KEY_E;
+                }
+                key->otherPrimes++;
+            }
+        }
+    #endif
+
     #if defined(WOLFSSL_XILINX_CRYPT) || defined(WOLFSSL_CRYPTOCELL)
         if (wc_InitRsaHw(key) != 0) {
             return BAD_STATE_E;
@@ -6576,6 +6644,15 @@ static int _RsaPrivateKeyDecode(const byte* input, word32* inOutIdx,
                 GetASN_MP(&dataASN[(byte)RSAKEYASN_IDX_N + i],
                     GetRsaInt(key, i));
             }
+        #ifdef WOLFSSL_RSA_MULTI_PRIME
+            /* Extract OtherPrimeInfos when present. */
+            for (i = 0; i < RSA_MAX_OTHER_PRIMES; i++) {
+                int idx = RSAKEYASN_IDX_OP0 + i * RSAKEYASN_OP_ITEMS;
+                GetASN_MP(&dataASN[idx + 1], &key->r[i]);
+                GetASN_MP(&dataASN[idx + 2], &key->dR[i]);
+                GetASN_MP(&dataASN[idx + 3], &key->tR[i]);
+            }
+        #endif
         }
         /* Parse BER encoding for RSA private key. */
         ret = GetASN_Items(rsaKeyASN, dataASN, rsaKeyASN_Length,
@@ -6588,6 +6665,23 @@ static int _RsaPrivateKeyDecode(const byte* input, word32* inOutIdx,
     if ((ret == 0) && (version > PKCS1v1)) {
         ret = ASN_PARSE_E;
     }
+#ifdef WOLFSSL_RSA_MULTI_PRIME
+    if ((ret == 0) && (key != NULL)) {
+        int i;
+
+        /* Count the other primes found. */
+        key->otherPrimes = 0;
+        for (i = 0; i < RSA_MAX_OTHER_PRIMES; i++) {
+            if (dataASN[RSAKEYASN_IDX_OP0 + i * RSAKEYASN_OP_ITEMS].tag != 0) {
+                key->otherPrimes++;
+            }
+        }
+        /* OtherPrimeInfos only allowed with multi-prime version. */
+        if ((key->otherPrimes > 0) && (version != PKCS1v1)) {
+            ret = ASN_PARSE_E;
+        }
+    }
+#endif
     if ((ret == 0) && (key != NULL)) {
     #if !defined(WOLFSSL_RSA_PUBLIC_ONLY)
         /* RSA key object has all private key values. */
@@ -25361,6 +25455,12 @@ int wc_RsaKeyToDer(RsaKey* key, byte* output, word32 inLen)
     byte  seq[MAX_SEQ_SZ];
     byte  ver[MAX_VERSION_SZ];
     byte* tmps[RSA_INTS];
+#ifdef WOLFSSL_RSA_MULTI_PRIME
+    word32 opSz[RSA_MAX_OTHER_PRIMES];
+    word32 opsSz = 0;
+    byte  opsSeq[MAX_SEQ_SZ];
+    word32 opsSeqSz = 0;
+#endif
 
     if (key == NULL)
         return BAD_FUNC_ARG;
@@ -25400,9 +25500,28 @@ int wc_RsaKeyToDer(RsaKey* key, byte* output, word32 inLen)
         intTotalLen += (word32)mpSz;
     }
 
+#ifdef WOLFSSL_RSA_MULTI_PRIME
+    /* size the OtherPrimeInfos */
+    for (i = 0; (ret == 0) && (i < key->otherPrimes); i++) {
+        opSz[i] = (word32)SetASNIntMP(&key->r[i], MAX_RSA_INT_SZ, NULL) +
+                  (word32)SetASNIntMP(&key->dR[i], MAX_RSA_INT_SZ, NULL) +
+                  (word32)SetASNIntMP(&key->tR[i], MAX_RSA_INT_SZ, NULL);
+        opsSz += SetSequence(opSz[i], NULL) + opSz[i];
+    }
+    if ((ret == 0) && (key->otherPrimes > 0)) {
+        opsSeqSz = SetSequence(opsSz, opsSeq);
+        intTotalLen += opsSeqSz + opsSz;
+    }
+#endif
+
     if (ret == 0) {
         /* make headers */
+    #ifdef WOLFSSL_RSA_MULTI_PRIME
+        ret = SetMyVersion((key->otherPrimes > 0) ? PKCS1v1 : PKCS1v0, ver,
+            FALSE);
+    #else
         ret = SetMyVersion(0, ver, FALSE);
+    #endif
     }
 
     if (ret >= 0) {
@@ -25426,6 +25545,18 @@ int wc_RsaKeyToDer(RsaKey* key, byte* output, word32 inLen)
             XMEMCPY(output + j, tmps[i], sizes[i]);
             j += sizes[i];
         }
+    #ifdef WOLFSSL_RSA_MULTI_PRIME
+        if (key->otherPrimes > 0) {
+            XMEMCPY(output + j, opsSeq, opsSeqSz);
+            j += opsSeqSz;
+        }
+        for (i = 0; i < key->otherPrimes; i++) {
+            j += SetSequence(opSz[i], output + j);
+            j += (word32)SetASNIntMP(&key->r[i], MAX_RSA_INT_SZ, output + j);
+            j += (word32)SetASNIntMP(&key->dR[i], MAX_RSA_INT_SZ, output + j);
+            j += (word32)SetASNIntMP(&key->tR[i], MAX_RSA_INT_SZ, output + j);
+        }
+    #endif
     }
 
     for (i = 0; i < RSA_INTS; i++) {
@@ -25450,11 +25581,32 @@ int wc_RsaKeyToDer(RsaKey* key, byte* output, word32 inLen)
 
     if (ret == 0) {
         /* Set the version. */
+    #ifdef WOLFSSL_RSA_MULTI_PRIME
+        SetASN_Int8Bit(&dataASN[RSAKEYASN_IDX_VER],
+            (key->otherPrimes > 0) ? PKCS1v1 : PKCS1v0);
+    #else
         SetASN_Int8Bit(&dataASN[RSAKEYASN_IDX_VER], 0);
+    #endif
         /* Set all the mp_ints in private key. */
         for (i = 0; i < RSA_INTS; i++) {
             SetASN_MP(&dataASN[(byte)RSAKEYASN_IDX_N + i], GetRsaInt(key, i));
         }
+    #ifdef WOLFSSL_RSA_MULTI_PRIME
+        /* Set the other primes and don't encode unused OtherPrimeInfo. */
+        for (i = 0; i < key->otherPrimes; i++) {
+            int idx = RSAKEYASN_IDX_OP0 + i * RSAKEYASN_OP_ITEMS;
+            SetASN_MP(&dataASN[idx + 1], &key->r[i]);
+            SetASN_MP(&dataASN[idx + 2], &key->dR[i]);
+            SetASN_MP(&dataASN[idx + 3], &key->tR[i]);
+        }
+        if (key->otherPrimes == 0) {
+            SetASNItem_NoOut(dataASN, RSAKEYASN_IDX_OPS, RSAKEYASN_IDX_T1);
+        }
+        else {
+            SetASNItem_NoOut(dataASN, RSAKEYASN_IDX_OP0 +
+                key->otherPrimes * RSAKEYASN_OP_ITEMS, RSAKEYASN_IDX_T1);
+        }
+    #endif
 
         /* Calculate size of RSA private key encoding. */
         ret = SizeASN_Items(rsaKeyASN, dataASN, rsaKeyASN_Length, &sz);
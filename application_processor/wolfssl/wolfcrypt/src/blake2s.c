@@ -45,6 +45,26 @@
 #include <wolfssl/wolfcrypt/blake2-impl.h>
 #include <wolfssl/wolfcrypt/error-crypt.h>
 
+#if defined(WOLFSSL_X86_64_BUILD) && defined(USE_INTEL_SPEEDUP) && \
+    !defined(WOLFSSL_NO_ASM)
+    #define USE_INTEL_BLAKE2S_SPEEDUP
+    #include <wolfssl/wolfcrypt/cpuid.h>
+
+/* CPU features, read when a state is initialized rather than per block. */
+static word32 intel_flags = 0;
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+/* Compress one block with the rows of the state held in xmm registers. */
+extern void blake2s_compress_avx1(blake2s_state* S, const byte* block);
+#ifdef __cplusplus
+    }  /* extern "C" */
+#endif
+#endif
+
+#define BLAKE2SP_PARALLELISM    8
+
 
 static const word32 blake2s_IV[8] =
 {
@@ -95,6 +115,10 @@ static WC_INLINE int blake2s_init0( blake2s_state *S )
   int i;
   XMEMSET( S, 0, sizeof( blake2s_state ) );
 
+#ifdef USE_INTEL_BLAKE2S_SPEEDUP
+  intel_flags = cpuid_get_flags();
+#endif
+
   for( i = 0; i < 8; ++i ) S->h[i] = blake2s_IV[i];
 
   return 0;
@@ -217,6 +241,18 @@ static WC_INLINE int blake2s_compress(
 {
   word32 i;
 
+#ifdef USE_INTEL_BLAKE2S_SPEEDUP
+  if( IS_INTEL_AVX1( intel_flags ) )
+  {
+    SAVE_VECTOR_REGISTERS(return _svr_ret;);
+    blake2s_compress_avx1( S, block );
+    RESTORE_VECTOR_REGISTERS();
+    (void)m;
+    (void)v;
+    return 0;
+  }
+#endif
+
   for( i = 0; i < 16; ++i )
     m[i] = load32( block + i * sizeof( m[i] ) );
 
@@ -416,6 +452,265 @@ int blake2s( byte *out, const void *in, const void *key, const byte outlen,
   return blake2s_final( S, out, outlen );
 }
 
+/* BLAKE2sp: BLAKE2SP_PARALLELISM leaves each hash every
+ * BLAKE2SP_PARALLELISM-th block of the message and a root node hashes the
+ * leaf digests. */
+static int blake2sp_init_node( blake2s_state *S, byte outlen, byte keylen,
+                               word64 offset, byte depth )
+{
+  volatile blake2s_param P[1];
+
+  XMEMSET( (blake2s_param *)P, 0, sizeof( *P ) );
+  P->digest_length = outlen;
+  P->key_length    = keylen;
+  P->fanout        = BLAKE2SP_PARALLELISM;
+  P->depth         = 2;
+  store48( (byte *)P->node_offset, offset );
+  P->node_depth    = depth;
+  P->inner_length  = BLAKE2S_OUTBYTES;
+  return blake2s_init_param( S, (blake2s_param *)P );
+}
+
+static int blake2sp_init_all( blake2sp_state *S, byte outlen, const void *key,
+                              byte keylen )
+{
+  int ret;
+  int i;
+
+  if ( ( !outlen ) || ( outlen > BLAKE2S_OUTBYTES ) ) return BAD_FUNC_ARG;
+
+  XMEMSET( S->buf, 0, sizeof( S->buf ) );
+  S->buflen = 0;
+
+  ret = blake2sp_init_node( S->R, outlen, keylen, 0, 1 );
+  for( i = 0; ( ret == 0 ) && ( i < BLAKE2SP_PARALLELISM ); ++i )
+    ret = blake2sp_init_node( S->S[i], outlen, keylen, (word64)i, 0 );
+  if ( ret < 0 ) return ret;
+
+  S->R->last_node = 1;
+  S->S[BLAKE2SP_PARALLELISM - 1]->last_node = 1;
+
+  if( keylen > 0 )
+  {
+#ifdef WOLFSSL_SMALL_STACK
+    byte* block;
+
+    block = (byte*)XMALLOC(BLAKE2S_BLOCKBYTES, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+
+    if ( block == NULL ) return MEMORY_E;
+#else
+    byte block[BLAKE2S_BLOCKBYTES];
+#endif
+
+    XMEMSET( block, 0, BLAKE2S_BLOCKBYTES );
+    XMEMCPY( block, key, keylen );
+    for( i = 0; ( ret == 0 ) && ( i < BLAKE2SP_PARALLELISM ); ++i )
+      ret = blake2s_update( S->S[i], block, BLAKE2S_BLOCKBYTES );
+    secure_zero_memory( block, BLAKE2S_BLOCKBYTES );
+
+#ifdef WOLFSSL_SMALL_STACK
+    XFREE(block, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+#endif
+  }
+  return ret;
+}
+
+int blake2sp_init( blake2sp_state *S, const byte outlen )
+{
+  return blake2sp_init_all( S, outlen, NULL, 0 );
+}
+
+int blake2sp_init_key( blake2sp_state *S, const byte outlen, const void *key,
+                       const byte keylen )
+{
+  if ( !key || !keylen || keylen > BLAKE2S_KEYBYTES ) return BAD_FUNC_ARG;
+
+  return blake2sp_init_all( S, outlen, key, keylen );
+}
+
+#if defined(WOLFSSL_BLAKE2_THREADS) && !defined(SINGLE_THREADED)
+#ifndef WOLFSSL_BLAKE2_THREAD_MIN
+    /* Bytes of input before the leaves are hashed on separate threads. */
+    #define WOLFSSL_BLAKE2_THREAD_MIN   (1024 * 1024)
+#endif
+
+typedef struct Blake2spLeaf {
+  blake2s_state *S;
+  const byte    *in;
+  word32         inlen;
+  int            ret;
+} Blake2spLeaf;
+
+/* Hash the leaf's share of all the whole strides of input. */
+static THREAD_RETURN WOLFSSL_THREAD blake2sp_leaf_thread( void *arg )
+{
+  Blake2spLeaf *leaf = (Blake2spLeaf *)arg;
+  const byte *in = leaf->in;
+  word32 inlen = leaf->inlen;
+
+  leaf->ret = 0;
+  while( ( leaf->ret == 0 ) &&
+         ( inlen >= BLAKE2SP_PARALLELISM * BLAKE2S_BLOCKBYTES ) )
+  {
+    leaf->ret = blake2s_update( leaf->S, in, BLAKE2S_BLOCKBYTES );
+    in += BLAKE2SP_PARALLELISM * BLAKE2S_BLOCKBYTES;
+    inlen -= BLAKE2SP_PARALLELISM * BLAKE2S_BLOCKBYTES;
+  }
+  WOLFSSL_RETURN_FROM_THREAD(0);
+}
+#endif
+
+/* Hash all the whole strides of input into the leaves. */
+static int blake2sp_update_leaves( blake2sp_state *S, const byte *in,
+                                   word32 inlen )
+{
+  int ret = 0;
+  int i;
+
+#if defined(WOLFSSL_BLAKE2_THREADS) && !defined(SINGLE_THREADED)
+  if( inlen >= WOLFSSL_BLAKE2_THREAD_MIN )
+  {
+    Blake2spLeaf leaf[BLAKE2SP_PARALLELISM];
+    THREAD_TYPE  tid[BLAKE2SP_PARALLELISM];
+    int          started[BLAKE2SP_PARALLELISM];
+
+    for( i = 0; i < BLAKE2SP_PARALLELISM; ++i )
+    {
+      leaf[i].S = S->S[i];
+      leaf[i].in = in + i * BLAKE2S_BLOCKBYTES;
+      leaf[i].inlen = inlen;
+      started[i] = ( i > 0 ) &&
+          ( wolfSSL_NewThread( &tid[i], blake2sp_leaf_thread, &leaf[i] ) == 0 );
+    }
+    /* Leaf 0, and any leaf without a thread, is hashed here. */
+    for( i = 0; i < BLAKE2SP_PARALLELISM; ++i )
+    {
+      if( !started[i] )
+        (void)blake2sp_leaf_thread( &leaf[i] );
+    }
+    for( i = 0; i < BLAKE2SP_PARALLELISM; ++i )
+    {
+      if( started[i] )
+        (void)wolfSSL_JoinThread( tid[i] );
+      if( ret == 0 )
+        ret = leaf[i].ret;
+    }
+    return ret;
+  }
+#endif
+
+  while( ( ret == 0 ) &&
+         ( inlen >= BLAKE2SP_PARALLELISM * BLAKE2S_BLOCKBYTES ) )
+  {
+    for( i = 0; ( ret == 0 ) && ( i < BLAKE2SP_PARALLELISM ); ++i )
+      ret = blake2s_update( S->S[i], in + i * BLAKE2S_BLOCKBYTES,
+                            BLAKE2S_BLOCKBYTES );
+    in += BLAKE2SP_PARALLELISM * BLAKE2S_BLOCKBYTES;
+    inlen -= BLAKE2SP_PARALLELISM * BLAKE2S_BLOCKBYTES;
+  }
+  return ret;
+}
+
+int blake2sp_update( blake2sp_state *S, const byte *in, word32 inlen )
+{
+  int ret = 0;
+  int i;
+  word32 left = S->buflen;
+  word32 fill = sizeof( S->buf ) - left;
+  word32 done;
+
+  if( left && inlen >= fill )
+  {
+    XMEMCPY( S->buf + left, in, (wolfssl_word)fill );
+    for( i = 0; ( ret == 0 ) && ( i < BLAKE2SP_PARALLELISM ); ++i )
+      ret = blake2s_update( S->S[i], S->buf + i * BLAKE2S_BLOCKBYTES,
+                            BLAKE2S_BLOCKBYTES );
+    in += fill;
+    inlen -= fill;
+    left = 0;
+  }
+  if( ret == 0 )
+    ret = blake2sp_update_leaves( S, in, inlen );
+  if( ret < 0 ) return ret;
+
+  done = inlen - inlen % ( BLAKE2SP_PARALLELISM * BLAKE2S_BLOCKBYTES );
+  in += done;
+  inlen -= done;
+  if( inlen > 0 )
+    XMEMCPY( S->buf + left, in, (wolfssl_word)inlen );
+  S->buflen = left + inlen;
+
+  return 0;
+}
+
+int blake2sp_final( blake2sp_state *S, byte *out, const byte outlen )
+{
+  int ret = 0;
+  int i;
+  byte hash[BLAKE2SP_PARALLELISM][BLAKE2S_OUTBYTES];
+
+  if ( ( !outlen ) || ( outlen > BLAKE2S_OUTBYTES ) ) return BAD_FUNC_ARG;
+
+  for( i = 0; ( ret == 0 ) && ( i < BLAKE2SP_PARALLELISM ); ++i )
+  {
+    if( S->buflen > (word32)i * BLAKE2S_BLOCKBYTES )
+    {
+      word32 left = S->buflen - (word32)i * BLAKE2S_BLOCKBYTES;
+
+      if( left > BLAKE2S_BLOCKBYTES ) left = BLAKE2S_BLOCKBYTES;
+      ret = blake2s_update( S->S[i], S->buf + i * BLAKE2S_BLOCKBYTES, left );
+    }
+    if( ret == 0 )
+      ret = blake2s_final( S->S[i], hash[i], BLAKE2S_OUTBYTES );
+  }
+  for( i = 0; ( ret == 0 ) && ( i < BLAKE2SP_PARALLELISM ); ++i )
+    ret = blake2s_update( S->R, hash[i], BLAKE2S_OUTBYTES );
+  if( ret == 0 )
+    ret = blake2s_final( S->R, out, outlen );
+
+  secure_zero_memory( hash, sizeof( hash ) );
+  return ret;
+}
+
+int blake2sp( byte *out, const void *in, const void *key, const byte outlen,
+              const word32 inlen, byte keylen )
+{
+  int ret;
+#ifdef WOLFSSL_SMALL_STACK
+  blake2sp_state* S;
+#else
+  blake2sp_state S[1];
+#endif
+
+  /* Verify parameters */
+  if ( NULL == in && inlen > 0 ) return BAD_FUNC_ARG;
+
+  if ( NULL == out ) return BAD_FUNC_ARG;
+
+  if( NULL == key ) keylen = 0;
+
+#ifdef WOLFSSL_SMALL_STACK
+  S = (blake2sp_state*)XMALLOC(sizeof(blake2sp_state), NULL,
+                               DYNAMIC_TYPE_TMP_BUFFER);
+  if ( S == NULL ) return MEMORY_E;
+#endif
+
+  if( keylen > 0 )
+    ret = blake2sp_init_key( S, outlen, key, keylen );
+  else
+    ret = blake2sp_init( S, outlen );
+  if( ret == 0 )
+    ret = blake2sp_update( S, ( const byte * )in, inlen );
+  if( ret == 0 )
+    ret = blake2sp_final( S, out, outlen );
+
+  secure_zero_memory( S, sizeof( *S ) );
+#ifdef WOLFSSL_SMALL_STACK
+  XFREE(S, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+#endif
+  return ret;
+}
+
 #if defined(BLAKE2S_SELFTEST)
 #include <string.h>
 #include "blake2-kat.h"
@@ -500,6 +795,63 @@ int wc_Blake2sFinal(Blake2s* b2s, byte* final, word32 requestSz)
 }
 
 
+/* Init Blake2sp digest, track size in case final doesn't want to "remember" */
+int wc_InitBlake2sp(Blake2sp* b2sp, word32 digestSz)
+{
+    if (b2sp == NULL || digestSz > BLAKE2S_OUTBYTES) {
+        return BAD_FUNC_ARG;
+    }
+    b2sp->digestSz = digestSz;
+
+    return blake2sp_init(b2sp->S, (byte)digestSz);
+}
+
+/* Init Blake2sp digest with key, track size in case final doesn't want to
+ * "remember" */
+int wc_InitBlake2sp_WithKey(Blake2sp* b2sp, word32 digestSz, const byte *key,
+                            word32 keylen)
+{
+    if (b2sp == NULL || digestSz > BLAKE2S_OUTBYTES) {
+        return BAD_FUNC_ARG;
+    }
+    b2sp->digestSz = digestSz;
+
+    if (keylen > BLAKE2S_KEYBYTES)
+        return BAD_FUNC_ARG;
+
+    if (key)
+        return blake2sp_init_key(b2sp->S, (byte)digestSz, key, (byte)keylen);
+    else
+        return blake2sp_init(b2sp->S, (byte)digestSz);
+}
+
+/* Blake2sp Update */
+int wc_Blake2spUpdate(Blake2sp* b2sp, const byte* data, word32 sz)
+{
+    if (b2sp == NULL || (data == NULL && sz > 0)) {
+        return BAD_FUNC_ARG;
+    }
+
+    return blake2sp_update(b2sp->S, data, sz);
+}
+
+/* Blake2sp Final, if pass in zero size we use init digestSz */
+int wc_Blake2spFinal(Blake2sp* b2sp, byte* final, word32 requestSz)
+{
+    word32 sz;
+
+    if (b2sp == NULL || final == NULL) {
+        return BAD_FUNC_ARG;
+    }
+    sz = requestSz ? requestSz : b2sp->digestSz;
+    if (sz > BLAKE2S_OUTBYTES) {
+        return BAD_FUNC_ARG;
+    }
+
+    return blake2sp_final(b2sp->S, final, (byte)sz);
+}
+
+
 /* end CTaoCrypt API */
 
 #endif  /* HAVE_BLAKE2S */
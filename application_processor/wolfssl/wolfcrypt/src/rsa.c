@@ -68,6 +68,14 @@ Possible RSA enable options:
  *                                                                 (not defined)
  * WC_RSA_BLINDING:       Uses Blinding w/ Private Ops              default: on
                           Note: slower by ~20%
+ * WC_RSA_BLINDING_CACHE: Keep blinding factors in the key and     default: off
+ *                        refresh them by squaring on each use.
+ * WC_RSA_BLINDING_CACHE_USES: Uses of a cached blinding factor    default: 32
+ *                        before a new one is made from the RNG.
+ * WOLFSSL_RSA_MULTI_PRIME: Keys with up to RSA_MAX_PRIMES primes   default: off
+ *                        (RFC 8017) and CRT over all of them.
+ * WC_RSA_BATCH:          Batch API for many private operations    default: off
+ *                        (4-lane AVX2 exponentiation on x86_64).
  * WOLFSSL_KEY_GEN:       Allows Private Key Generation             default: off
  * RSA_LOW_MEM:           NON CRT Private Operations, less memory   default: off
  * WC_NO_RSA_OAEP:        Disables RSA OAEP padding                 default: on
@@ -93,6 +101,12 @@ RSA Key Size Configuration:
 #ifdef WOLF_CRYPTO_CB
     #include <wolfssl/wolfcrypt/cryptocb.h>
 #endif
+#if defined(WC_RSA_BATCH) && defined(WOLFSSL_X86_64_BUILD) && \
+    defined(USE_INTEL_SPEEDUP) && !defined(WOLFSSL_NO_ASM) && \
+    !defined(NO_AVX2_SUPPORT)
+    #define RSA_BATCH_AVX2
+    #include <wolfssl/wolfcrypt/cpuid.h>
+#endif
 #ifdef NO_INLINE
     #include <wolfssl/wolfcrypt/misc.h>
 #else
@@ -140,6 +154,9 @@ static void wc_RsaCleanup(RsaKey* key)
 int wc_InitRsaKey_ex(RsaKey* key, void* heap, int devId)
 {
     int ret      = 0;
+#ifdef WOLFSSL_RSA_MULTI_PRIME
+    int i;
+#endif
 #if defined(HAVE_PKCS11)
     int isPkcs11 = 0;
 #endif
@@ -196,7 +213,12 @@ int wc_InitRsaKey_ex(RsaKey* key, void* heap, int devId)
 #endif /* WOLFSSL_ASYNC_CRYPT */
 
 #ifndef WOLFSSL_RSA_PUBLIC_ONLY
+#if defined(WC_RSA_BLINDING) && defined(WC_RSA_BLINDING_CACHE)
+    ret = mp_init_multi(&key->n, &key->e, &key->blind, &key->blindInv,
+        &key->blindN, &key->blindE);
+#else
     ret = mp_init_multi(&key->n, &key->e, NULL, NULL, NULL, NULL);
+#endif
     if (ret != MP_OKAY)
         return ret;
 
@@ -210,6 +232,15 @@ int wc_InitRsaKey_ex(RsaKey* key, void* heap, int devId)
         mp_clear(&key->e);
         return ret;
     }
+#ifdef WOLFSSL_RSA_MULTI_PRIME
+    for (i = 0; (ret == MP_OKAY) && (i < RSA_MAX_OTHER_PRIMES); i++) {
+        ret = mp_init_multi(&key->r[i], &key->dR[i], &key->tR[i], NULL, NULL,
+            NULL);
+    }
+    if (ret != MP_OKAY)
+        return ret;
+    key->otherPrimes = 0;
+#endif
 #else
     ret = mp_init(&key->n);
     if (ret != MP_OKAY)
@@ -243,6 +274,11 @@ int wc_InitRsaKey_ex(RsaKey* key, void* heap, int devId)
     key->ctx.wrapped_pub2048_key = NULL;
     key->ctx.keySz = 0;
 #endif
+
+#if defined(WC_RSA_BLINDING) && defined(WC_RSA_BLINDING_CACHE)
+    key->blindUses = 0;
+    ret = wc_InitMutex(&key->blindMutex);
+#endif
     return ret;
 }
 
@@ -533,6 +569,9 @@ int wc_RsaGetKeyId(RsaKey* key, word32* keyId)
 int wc_FreeRsaKey(RsaKey* key)
 {
     int ret = 0;
+#ifdef WOLFSSL_RSA_MULTI_PRIME
+    int i;
+#endif
 
     if (key == NULL) {
         return BAD_FUNC_ARG;
@@ -566,6 +605,21 @@ int wc_FreeRsaKey(RsaKey* key)
         mp_clear(&key->p);
         mp_clear(&key->d);
     }
+#ifdef WOLFSSL_RSA_MULTI_PRIME
+    for (i = 0; i < RSA_MAX_OTHER_PRIMES; i++) {
+        mp_forcezero(&key->tR[i]);
+        mp_forcezero(&key->dR[i]);
+        mp_forcezero(&key->r[i]);
+    }
+    key->otherPrimes = 0;
+#endif
+#if defined(WC_RSA_BLINDING) && defined(WC_RSA_BLINDING_CACHE)
+    mp_forcezero(&key->blindInv);
+    mp_forcezero(&key->blind);
+    mp_clear(&key->blindN);
+    mp_clear(&key->blindE);
+    key->blindUses = 0;
+#endif
 #endif /* WOLFSSL_RSA_PUBLIC_ONLY */
 
     /* public part */
@@ -593,6 +647,10 @@ int wc_FreeRsaKey(RsaKey* key)
     KcapiRsa_Free(key);
 #endif
 
+#if defined(WC_RSA_BLINDING) && defined(WC_RSA_BLINDING_CACHE)
+    wc_FreeMutex(&key->blindMutex);
+#endif
+
 #ifdef WOLFSSL_CHECK_MEM_ZERO
     wc_MemZero_Check(key, sizeof(RsaKey));
 #endif
@@ -739,6 +797,17 @@ int wc_CheckRsaKey(RsaKey* key)
             ret = MP_EXPTMOD_E;
         }
     }
+#ifdef WOLFSSL_RSA_MULTI_PRIME
+    /* Multi-prime: n is the product of all the primes. */
+    if (ret == 0) {
+        int i;
+        for (i = 0; (ret == 0) && (i < key->otherPrimes); i++) {
+            if (mp_mul(tmp, &key->r[i], tmp) != MP_OKAY) {
+                ret = MP_EXPTMOD_E;
+            }
+        }
+    }
+#endif
     if (ret == 0 ) {
         if (mp_cmp(&key->n, tmp) != MP_EQ) {
             ret = MP_EXPTMOD_E;
@@ -2390,6 +2459,14 @@ static int RsaFunction_SP(const byte* in, word32 inLen, byte* out,
 {
     (void)rng;
 
+#ifdef WOLFSSL_RSA_MULTI_PRIME
+    /* SP private operations only do CRT with two primes. */
+    if ((key->otherPrimes > 0) && ((type == RSA_PRIVATE_DECRYPT) ||
+                                   (type == RSA_PRIVATE_ENCRYPT))) {
+        return WC_KEY_SIZE_E;
+    }
+#endif
+
 #ifndef WOLFSSL_SP_NO_2048
     if (mp_count_bits(&key->n) == 2048) {
         switch(type) {
@@ -2491,11 +2568,278 @@ static int RsaFunction_SP(const byte* in, word32 inLen, byte* out,
 
 #if !defined(WOLFSSL_SP_MATH)
 #if !defined(WOLFSSL_RSA_PUBLIC_ONLY) && !defined(WOLFSSL_RSA_VERIFY_ONLY)
+#if defined(WC_RSA_BLINDING) && !defined(WC_NO_RNG)
+/* Make a new blinding value and its inverse.
+ *
+ * @param [in]  key   RSA key.
+ * @param [in]  rng   Random number generator.
+ * @param [out] rnd   Blinding value: r^e mod n.
+ * @param [out] rndi  Blinding inverse: 1/r mod n.
+ * @return  0 on success.
+ * @return  MP_INVMOD_E or MP_EXPTMOD_E when calculation fails.
+ */
+static int RsaBlindingNew(RsaKey* key, WC_RNG* rng, mp_int* rnd, mp_int* rndi)
+{
+    int ret;
+
+    /* blind */
+    ret = mp_rand(rnd, get_digit_count(&key->n), rng);
+    if (ret == 0) {
+        /* rndi = 1/rnd mod n */
+        if (mp_invmod(rnd, &key->n, rndi) != MP_OKAY) {
+            ret = MP_INVMOD_E;
+        }
+    }
+    if (ret == 0) {
+        /* rnd = rnd^e */
+    #ifndef WOLFSSL_SP_MATH_ALL
+        if (mp_exptmod(rnd, &key->e, &key->n, rnd) != MP_OKAY) {
+            ret = MP_EXPTMOD_E;
+        }
+    #else
+        if (mp_exptmod_nct(rnd, &key->e, &key->n, rnd) != MP_OKAY) {
+            ret = MP_EXPTMOD_E;
+        }
+    #endif
+    }
+
+    return ret;
+}
+
+#ifdef WC_RSA_BLINDING_CACHE
+#ifndef WC_RSA_BLINDING_CACHE_USES
+    #define WC_RSA_BLINDING_CACHE_USES  32
+#endif
+
+/* Get a blinding value and its inverse from the cache in the key.
+ *
+ * The cached pair is squared after each use: (r^e)^2 = (r^2)^e and
+ * (1/r)^2 = 1/r^2 so the pair stays consistent for far less than an
+ * inversion and exponentiation. After WC_RSA_BLINDING_CACHE_USES uses a new
+ * pair is made from the RNG.
+ *
+ * The pair is only valid for the n and e it was made with. New key material
+ * can be loaded into a key that has been used, so the cache is dropped when
+ * they no longer match.
+ *
+ * @param [in, out] key   RSA key holding the cache.
+ * @param [in]      rng   Random number generator.
+ * @param [out]     rnd   Blinding value: r^e mod n.
+ * @param [out]     rndi  Blinding inverse: 1/r mod n.
+ * @return  0 on success.
+ * @return  BAD_MUTEX_E when locking the cache fails.
+ * @return  MP_INVMOD_E, MP_EXPTMOD_E or MP_MULMOD_E when calculation fails.
+ */
+static int RsaBlindingCached(RsaKey* key, WC_RNG* rng, mp_int* rnd,
+    mp_int* rndi)
+{
+    int ret = 0;
+    int cached = 0;
+
+    if (wc_LockMutex(&key->blindMutex) != 0) {
+        return BAD_MUTEX_E;
+    }
+    if ((key->blindUses > 0) && ((mp_cmp(&key->blindN, &key->n) != MP_EQ) ||
+            (mp_cmp(&key->blindE, &key->e) != MP_EQ))) {
+        /* Key material changed since the pair was made. */
+        mp_forcezero(&key->blind);
+        mp_forcezero(&key->blindInv);
+        key->blindUses = 0;
+    }
+    if (key->blindUses > 0) {
+        if ((mp_copy(&key->blind, rnd) != MP_OKAY) ||
+                (mp_copy(&key->blindInv, rndi) != MP_OKAY)) {
+            ret = MP_MULMOD_E;
+        }
+        /* Update for next use. */
+        if ((ret == 0) && ((mp_sqrmod(&key->blind, &key->n, &key->blind) !=
+                MP_OKAY) || (mp_sqrmod(&key->blindInv, &key->n,
+                &key->blindInv) != MP_OKAY))) {
+            ret = MP_MULMOD_E;
+        }
+        if (ret == 0) {
+            key->blindUses--;
+            cached = 1;
+        }
+        else {
+            key->blindUses = 0;
+        }
+    }
+    wc_UnLockMutex(&key->blindMutex);
+
+    if ((ret == 0) && (!cached)) {
+        ret = RsaBlindingNew(key, rng, rnd, rndi);
+        if ((ret == 0) && (wc_LockMutex(&key->blindMutex) == 0)) {
+            /* Cache the squares - this pair is being used now. */
+            if ((mp_sqrmod(rnd, &key->n, &key->blind) == MP_OKAY) &&
+                    (mp_sqrmod(rndi, &key->n, &key->blindInv) == MP_OKAY) &&
+                    (mp_copy(&key->n, &key->blindN) == MP_OKAY) &&
+                    (mp_copy(&key->e, &key->blindE) == MP_OKAY)) {
+                key->blindUses = WC_RSA_BLINDING_CACHE_USES;
+            }
+            else {
+                key->blindUses = 0;
+            }
+            wc_UnLockMutex(&key->blindMutex);
+        }
+    }
+
+    return ret;
+}
+#endif /* WC_RSA_BLINDING_CACHE */
+#endif /* WC_RSA_BLINDING && !WC_NO_RNG */
+
+#ifdef WOLFSSL_RSA_MULTI_PRIME
+/* Combine the results for the other primes of a multi-prime key.
+ *
+ * RFC 8017, 5.1.2 step 2.b.v: for each other prime r_i
+ *   m_i = c^d_i mod r_i
+ *   h = (m_i - m) * t_i mod r_i
+ *   m = m + R * h
+ * where R is the product of the primes combined so far.
+ *
+ * @param [in, out] m    On in, c^d mod p*q. On out, c^d mod n.
+ * @param [in]      c    Input to private operation.
+ * @param [in]      key  RSA key with other primes.
+ * @return  0 on success.
+ * @return  MEMORY_E when dynamic memory allocation fails.
+ * @return  MP_INIT_E, MP_EXPTMOD_E, MP_SUB_E, MP_MULMOD_E, MP_MUL_E or
+ *          MP_ADD_E when calculation fails.
+ */
+static int RsaMultiPrimeCrt(mp_int* m, mp_int* c, RsaKey* key)
+{
+    int ret = 0;
+    int i;
+    DECL_MP_INT_SIZE_DYN(prod, mp_bitsused(&key->n), RSA_MAX_SIZE);
+    DECL_MP_INT_SIZE_DYN(h, mp_bitsused(&key->n), RSA_MAX_SIZE);
+    DECL_MP_INT_SIZE_DYN(t, mp_bitsused(&key->n), RSA_MAX_SIZE);
+
+    NEW_MP_INT_SIZE(prod, mp_bitsused(&key->n), key->heap, DYNAMIC_TYPE_RSA);
+    NEW_MP_INT_SIZE(h, mp_bitsused(&key->n), key->heap, DYNAMIC_TYPE_RSA);
+    NEW_MP_INT_SIZE(t, mp_bitsused(&key->n), key->heap, DYNAMIC_TYPE_RSA);
+#ifdef MP_INT_SIZE_CHECK_NULL
+    if ((prod == NULL) || (h == NULL) || (t == NULL)) {
+        FREE_MP_INT_SIZE(t, key->heap, DYNAMIC_TYPE_RSA);
+        FREE_MP_INT_SIZE(h, key->heap, DYNAMIC_TYPE_RSA);
+        FREE_MP_INT_SIZE(prod, key->heap, DYNAMIC_TYPE_RSA);
+        return MEMORY_E;
+    }
+#endif
+
+    if ((INIT_MP_INT_SIZE(prod, mp_bitsused(&key->n)) != MP_OKAY) ||
+            (INIT_MP_INT_SIZE(h, mp_bitsused(&key->n)) != MP_OKAY) ||
+            (INIT_MP_INT_SIZE(t, mp_bitsused(&key->n)) != MP_OKAY)) {
+        ret = MP_INIT_E;
+    }
+#ifdef WOLFSSL_CHECK_MEM_ZERO
+    if (ret == 0) {
+        mp_memzero_add("RSA Multi-prime h", h);
+        mp_memzero_add("RSA Multi-prime t", t);
+    }
+#endif
+
+    /* prod = p * q */
+    if ((ret == 0) && (mp_mul(&key->p, &key->q, prod) != MP_OKAY))
+        ret = MP_MUL_E;
+
+    for (i = 0; (ret == 0) && (i < key->otherPrimes); i++) {
+        /* h = c^d_i mod r_i */
+        if (mp_exptmod(c, &key->dR[i], &key->r[i], h) != MP_OKAY)
+            ret = MP_EXPTMOD_E;
+        /* t = m mod r_i */
+        if ((ret == 0) && (mp_mod(m, &key->r[i], t) != MP_OKAY))
+            ret = MP_MULMOD_E;
+
+        /* h = (h - t) * t_i mod r_i */
+    #if (defined(WOLFSSL_SP_MATH) || (defined(WOLFSSL_SP_MATH_ALL)) && \
+                                              !defined(WOLFSSL_SP_INT_NEGATIVE))
+        if ((ret == 0) && (mp_submod(h, t, &key->r[i], h) != MP_OKAY))
+            ret = MP_SUB_E;
+    #else
+        if ((ret == 0) && (mp_sub(h, t, h) != MP_OKAY))
+            ret = MP_SUB_E;
+    #endif
+        if ((ret == 0) && (mp_mulmod(h, &key->tR[i], &key->r[i], h) !=
+                MP_OKAY)) {
+            ret = MP_MULMOD_E;
+        }
+
+        /* m = m + prod * h */
+        if ((ret == 0) && (mp_mul(h, prod, h) != MP_OKAY))
+            ret = MP_MUL_E;
+        if ((ret == 0) && (mp_add(m, h, m) != MP_OKAY))
+            ret = MP_ADD_E;
+
+        /* prod = prod * r_i */
+        if ((ret == 0) && (i + 1 < key->otherPrimes) &&
+                (mp_mul(prod, &key->r[i], prod) != MP_OKAY)) {
+            ret = MP_MUL_E;
+        }
+    }
+
+    mp_forcezero(t);
+    mp_forcezero(h);
+    mp_clear(prod);
+    FREE_MP_INT_SIZE(t, key->heap, DYNAMIC_TYPE_RSA);
+    FREE_MP_INT_SIZE(h, key->heap, DYNAMIC_TYPE_RSA);
+    FREE_MP_INT_SIZE(prod, key->heap, DYNAMIC_TYPE_RSA);
+#if !defined(MP_INT_SIZE_CHECK_NULL) && defined(WOLFSSL_CHECK_MEM_ZERO)
+    mp_memzero_check(h);
+    mp_memzero_check(t);
+#endif
+    return ret;
+}
+#endif /* WOLFSSL_RSA_MULTI_PRIME */
+
+#if defined(WC_RSA_BLINDING) && !defined(WC_NO_RNG)
+/* Take the blinding off the result of a private operation.
+ *
+ * Multiply result (tmp) by blinding invertor (rndi).
+ * Use Montgomery form to make operation more constant time.
+ *
+ * @param [in, out] tmp   On in, blinded result. On out, result.
+ * @param [in]      key   RSA key.
+ * @param [in]      rnd   Scratch: overwritten.
+ * @param [in]      rndi  Blinding inverse: 1/r mod n. Overwritten.
+ * @return  0 on success.
+ * @return  MP_MULMOD_E when calculation fails.
+ */
+static int RsaUnblind(mp_int* tmp, RsaKey* key, mp_int* rnd, mp_int* rndi)
+{
+    int ret = 0;
+    mp_digit mp = 0;
+
+    if (mp_montgomery_setup(&key->n, &mp) != MP_OKAY) {
+        ret = MP_MULMOD_E;
+    }
+    if ((ret == 0) && (mp_montgomery_calc_normalization(rnd, &key->n) !=
+            MP_OKAY)) {
+        ret = MP_MULMOD_E;
+    }
+    /* Convert blinding invert to Montgomery form. */
+    if ((ret == 0) && (mp_mul(rndi, rnd, rndi) != MP_OKAY)) {
+        ret = MP_MULMOD_E;
+    }
+    if ((ret == 0) && (mp_mod(rndi, &key->n, rndi) != MP_OKAY)) {
+        ret = MP_MULMOD_E;
+    }
+    /* Multiply result by blinding invert. */
+    if ((ret == 0) && (mp_mul(tmp, rndi, tmp) != MP_OKAY)) {
+        ret = MP_MULMOD_E;
+    }
+    /* Reduce result. */
+    if ((ret == 0) && (mp_montgomery_reduce_ct(tmp, &key->n, mp) != MP_OKAY)) {
+        ret = MP_MULMOD_E;
+    }
+
+    return ret;
+}
+#endif /* WC_RSA_BLINDING && !WC_NO_RNG */
+
 static int RsaFunctionPrivate(mp_int* tmp, RsaKey* key, WC_RNG* rng)
 {
     int    ret = 0;
 #if defined(WC_RSA_BLINDING) && !defined(WC_NO_RNG)
-    mp_digit mp = 0;
     DECL_MP_INT_SIZE_DYN(rnd, mp_bitsused(&key->n), RSA_MAX_SIZE);
     DECL_MP_INT_SIZE_DYN(rndi, mp_bitsused(&key->n), RSA_MAX_SIZE);
 #endif /* WC_RSA_BLINDING && !WC_NO_RNG */
@@ -2518,31 +2862,15 @@ static int RsaFunctionPrivate(mp_int* tmp, RsaKey* key, WC_RNG* rng)
         ret = MP_INIT_E;
     }
 
-    if (ret == 0) {
-        /* blind */
-        ret = mp_rand(rnd, get_digit_count(&key->n), rng);
-    }
-    if (ret == 0) {
-        /* rndi = 1/rnd mod n */
-        if (mp_invmod(rnd, &key->n, rndi) != MP_OKAY) {
-            ret = MP_INVMOD_E;
-        }
-    }
     if (ret == 0) {
     #ifdef WOLFSSL_CHECK_MEM_ZERO
         mp_memzero_add("RSA Private rnd", rnd);
         mp_memzero_add("RSA Private rndi", rndi);
     #endif
-
-        /* rnd = rnd^e */
-    #ifndef WOLFSSL_SP_MATH_ALL
-        if (mp_exptmod(rnd, &key->e, &key->n, rnd) != MP_OKAY) {
-            ret = MP_EXPTMOD_E;
-        }
+    #ifdef WC_RSA_BLINDING_CACHE
+        ret = RsaBlindingCached(key, rng, rnd, rndi);
     #else
-        if (mp_exptmod_nct(rnd, &key->e, &key->n, rnd) != MP_OKAY) {
-            ret = MP_EXPTMOD_E;
-        }
+        ret = RsaBlindingNew(key, rng, rnd, rndi);
     #endif
     }
 
@@ -2568,6 +2896,11 @@ static int RsaFunctionPrivate(mp_int* tmp, RsaKey* key, WC_RNG* rng)
 #else
         DECL_MP_INT_SIZE_DYN(tmpb, mp_bitsused(&key->n), RSA_MAX_SIZE);
 #endif
+#ifdef WOLFSSL_RSA_MULTI_PRIME
+        /* Input kept for the exponentiations with the other primes. */
+        DECL_MP_INT_SIZE_DYN(c, mp_bitsused(&key->n), RSA_MAX_SIZE);
+        int haveC = 0;
+#endif
 
 #if !defined(WC_RSA_BLINDING) || defined(WC_NO_RNG)
         NEW_MP_INT_SIZE(tmpb, mp_bitsused(&key->n), key->heap,
@@ -2589,6 +2922,30 @@ static int RsaFunctionPrivate(mp_int* tmp, RsaKey* key, WC_RNG* rng)
         }
     #endif
 
+    #ifdef WOLFSSL_RSA_MULTI_PRIME
+        if ((ret == 0) && (key->otherPrimes > 0)) {
+            NEW_MP_INT_SIZE(c, mp_bitsused(&key->n), key->heap,
+                DYNAMIC_TYPE_RSA);
+        #ifdef MP_INT_SIZE_CHECK_NULL
+            if (c == NULL) {
+                ret = MEMORY_E;
+            }
+        #endif
+            if ((ret == 0) && (INIT_MP_INT_SIZE(c, mp_bitsused(&key->n)) !=
+                    MP_OKAY)) {
+                ret = MP_INIT_E;
+            }
+            if (ret == 0) {
+                haveC = 1;
+            #ifdef WOLFSSL_CHECK_MEM_ZERO
+                mp_memzero_add("RSA Multi-prime c", c);
+            #endif
+                if (mp_copy(tmp, c) != MP_OKAY)
+                    ret = MP_INIT_E;
+            }
+        }
+    #endif
+
         /* tmpb = tmp^dQ mod q */
         if (ret == 0 && mp_exptmod(tmp, &key->dQ, &key->q, tmpb) != MP_OKAY)
             ret = MP_EXPTMOD_E;
@@ -2617,6 +2974,17 @@ static int RsaFunctionPrivate(mp_int* tmp, RsaKey* key, WC_RNG* rng)
         if (ret == 0 && mp_add(tmp, tmpb, tmp) != MP_OKAY)
             ret = MP_ADD_E;
 
+    #ifdef WOLFSSL_RSA_MULTI_PRIME
+        /* tmp = c^d mod n using the other primes */
+        if ((ret == 0) && haveC)
+            ret = RsaMultiPrimeCrt(tmp, c, key);
+        if (haveC)
+            mp_forcezero(c);
+        if (key->otherPrimes > 0) {
+            FREE_MP_INT_SIZE(c, key->heap, DYNAMIC_TYPE_RSA);
+        }
+    #endif
+
 #if !defined(WC_RSA_BLINDING) || defined(WC_NO_RNG)
         mp_forcezero(tmpb);
         FREE_MP_INT_SIZE(tmpb, key->heap, DYNAMIC_TYPE_RSA);
@@ -2628,30 +2996,8 @@ static int RsaFunctionPrivate(mp_int* tmp, RsaKey* key, WC_RNG* rng)
 #endif   /* RSA_LOW_MEM */
 
 #if defined(WC_RSA_BLINDING) && !defined(WC_NO_RNG)
-    /* Multiply result (tmp) by blinding invertor (rndi).
-     * Use Montgomery form to make operation more constant time.
-     */
-    if ((ret == 0) && (mp_montgomery_setup(&key->n, &mp) != MP_OKAY)) {
-        ret = MP_MULMOD_E;
-    }
-    if ((ret == 0) && (mp_montgomery_calc_normalization(rnd, &key->n) !=
-            MP_OKAY)) {
-        ret = MP_MULMOD_E;
-    }
-    /* Convert blinding invert to Montgomery form. */
-    if ((ret == 0) && (mp_mul(rndi, rnd, rndi) != MP_OKAY)) {
-        ret = MP_MULMOD_E;
-    }
-    if ((ret == 0) && (mp_mod(rndi, &key->n, rndi) != MP_OKAY)) {
-        ret = MP_MULMOD_E;
-    }
-    /* Multiply result by blinding invert. */
-    if ((ret == 0) && (mp_mul(tmp, rndi, tmp) != MP_OKAY)) {
-        ret = MP_MULMOD_E;
-    }
-    /* Reduce result. */
-    if ((ret == 0) && (mp_montgomery_reduce_ct(tmp, &key->n, mp) != MP_OKAY)) {
-        ret = MP_MULMOD_E;
+    if (ret == 0) {
+        ret = RsaUnblind(tmp, key, rnd, rndi);
     }
 
     mp_forcezero(rndi);
@@ -4222,44 +4568,676 @@ int wc_RsaPSS_Sign_ex(const byte* in, word32 inLen, byte* out, word32 outLen,
     return ret;
 }
 #endif
-#endif
-
-int wc_RsaEncryptSize(const RsaKey* key)
+#ifdef WC_RSA_BATCH
+#ifdef RSA_BATCH_AVX2
+/* Number of exponentiations done at once: the CRT halves of two operations.
+ */
+#define RSA_BATCH_LANES         4
+/* Bits in a digit of a lane. */
+#define RSA_BATCH_DIGIT_BITS    28
+#define RSA_BATCH_DIGIT_MASK    ((word64)0x0fffffff)
+/* Bits of exponent in a window and entries in the table of powers. */
+#define RSA_BATCH_WINDOW        5
+#define RSA_BATCH_TABLE_SZ      (1 << RSA_BATCH_WINDOW)
+/* Digits needed for a prime of bits bits: 2^(28n) > 4 * prime. */
+#define RSA_BATCH_DIGITS(bits)  \
+    (((bits) + 2 + RSA_BATCH_DIGIT_BITS - 1) / RSA_BATCH_DIGIT_BITS)
+/* Column sums of 2n 56-bit products fit in 64 bits when n is at most 127. */
+#if RSA_BATCH_DIGITS(RSA_MAX_SIZE / 2) <= 127
+    #define RSA_BATCH_MAX_DIGITS    RSA_BATCH_DIGITS(RSA_MAX_SIZE / 2)
+#else
+    #define RSA_BATCH_MAX_DIGITS    127
+#endif
+/* Largest number of bytes holding the digits of a number. */
+#define RSA_BATCH_MAX_BYTES     \
+    ((RSA_BATCH_MAX_DIGITS * RSA_BATCH_DIGIT_BITS + 7) / 8)
+/* Words of workspace: table, modulus, R^2, one, base/result and two vectors
+ * for -1/m and the window indices. */
+#define RSA_BATCH_WS_WORDS      \
+    ((RSA_BATCH_TABLE_SZ + 4) * RSA_BATCH_MAX_DIGITS * RSA_BATCH_LANES + \
+     2 * RSA_BATCH_LANES)
+/* mp_ints for an operation: input, two halves, blinding value and inverse. */
+#define RSA_BATCH_OP_MPS        5
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+/* Montgomery multiply in each lane: r = a * b / 2^(28n) mod m. */
+extern void rsa_batch_mont_mul_avx2(word64* r, const word64* a,
+    const word64* b, const word64* m, const word64* mp, word32 n);
+/* Select table[idx[l]] for each lane l in constant time. */
+extern void rsa_batch_select_avx2(word64* r, const word64* table,
+    const word64* idx, word32 n, word32 cnt);
+#ifdef __cplusplus
+    }  /* extern "C" */
+#endif
+
+/* One exponentiation: base^exp mod mod. The result replaces the base. */
+typedef struct RsaBatchLane {
+    mp_int*       base;
+    const mp_int* exp;
+    const mp_int* mod;
+} RsaBatchLane;
+
+/* Convert a big-endian number into the digits of one lane.
+ *
+ * @param [out] d     First digit of the lane.
+ * @param [in]  in    Big-endian number.
+ * @param [in]  inSz  Size of number in bytes.
+ * @param [in]  n     Number of digits.
+ */
+static void RsaBatchFromBin(word64* d, const byte* in, word32 inSz, word32 n)
 {
-    int ret;
-
-    if (key == NULL) {
-        return BAD_FUNC_ARG;
+    word32 j;
+    word64 t = 0;
+    int bits = 0;
+    int i = (int)inSz - 1;
+
+    for (j = 0; j < n; j++) {
+        while ((bits < RSA_BATCH_DIGIT_BITS) && (i >= 0)) {
+            t |= (word64)in[i--] << bits;
+            bits += 8;
+        }
+        d[j * RSA_BATCH_LANES] = t & RSA_BATCH_DIGIT_MASK;
+        t >>= RSA_BATCH_DIGIT_BITS;
+        bits -= RSA_BATCH_DIGIT_BITS;
+        if (bits < 0) {
+            bits = 0;
+        }
     }
+}
 
-    ret = mp_unsigned_bin_size(&key->n);
-
-#ifdef WOLF_CRYPTO_CB
-    if (ret == 0 && key->devId != INVALID_DEVID) {
-        if (wc_CryptoCb_RsaGetSize(key, &ret) == CRYPTOCB_UNAVAILABLE) {
-            ret = 2048/8; /* hardware handles, use 2048-bit as default */
+/* Convert the normalized digits of one lane into a big-endian number.
+ *
+ * @param [out] out    Buffer to hold big-endian number.
+ * @param [in]  outSz  Size of buffer in bytes.
+ * @param [in]  d      First digit of the lane.
+ * @param [in]  n      Number of digits.
+ */
+static void RsaBatchToBin(byte* out, word32 outSz, const word64* d, word32 n)
+{
+    word32 j;
+    word64 t = 0;
+    int bits = 0;
+    int i = (int)outSz - 1;
+
+    for (j = 0; j < n; j++) {
+        t |= d[j * RSA_BATCH_LANES] << bits;
+        bits += RSA_BATCH_DIGIT_BITS;
+        while ((bits >= 8) && (i >= 0)) {
+            out[i--] = (byte)t;
+            t >>= 8;
+            bits -= 8;
         }
     }
-#endif
-
-    return ret;
+    while (i >= 0) {
+        out[i--] = (byte)t;
+        t >>= 8;
+    }
 }
 
-#ifndef WOLFSSL_RSA_VERIFY_ONLY
-/* flatten RsaKey structure into individual elements (e, n) */
-int wc_RsaFlattenPublicKey(RsaKey* key, byte* e, word32* eSz, byte* n,
-                                                                   word32* nSz)
+/* Calculate -1/m mod 2^28 from the bottom digit of an odd modulus.
+ *
+ * @param [in] m0  Bottom digit of modulus.
+ * @return  Montgomery multiplier.
+ */
+static word64 RsaBatchMontSetup(word64 m0)
 {
-    int sz, ret;
+    /* Newton's method: correct to 3 bits and doubling each step. */
+    word64 x = m0;
 
-    if (key == NULL || e == NULL || eSz == NULL || n == NULL || nSz == NULL) {
-        return BAD_FUNC_ARG;
-    }
+    x *= 2 - m0 * x;
+    x *= 2 - m0 * x;
+    x *= 2 - m0 * x;
+    x *= 2 - m0 * x;
 
-    sz = mp_unsigned_bin_size(&key->e);
-    if ((word32)sz > *eSz)
-        return RSA_BUFFER_E;
-    ret = mp_to_unsigned_bin(&key->e, e);
+    return (0 - x) & RSA_BATCH_DIGIT_MASK;
+}
+
+/* Get the window of exponent bits starting at bit.
+ *
+ * The position depends only on the size of the modulus.
+ *
+ * @param [in] e    Big-endian exponent.
+ * @param [in] eSz  Size of exponent in bytes.
+ * @param [in] bit  Lowest bit of window.
+ * @return  Value of window.
+ */
+static word64 RsaBatchWindow(const byte* e, word32 eSz, int bit)
+{
+    word64 v = 0;
+    int k;
+
+    for (k = RSA_BATCH_WINDOW - 1; k >= 0; k--) {
+        int b = bit + k;
+        int i = (int)eSz - 1 - b / 8;
+
+        v <<= 1;
+        if (i >= 0) {
+            v |= (word64)((e[i] >> (b & 7)) & 1);
+        }
+    }
+
+    return v;
+}
+
+/* Exponentiate in each of the four lanes together.
+ *
+ * Fixed window exponentiation with a constant time table lookup. All lanes
+ * use the number of digits and exponent bits of the largest modulus.
+ *
+ * @param [in, out] lane  Exponentiations. Base must be less than modulus.
+ * @param [in]      ws    Workspace of RSA_BATCH_WS_WORDS words.
+ * @param [in]      buf   Buffer of (RSA_BATCH_LANES + 1) *
+ *                        RSA_BATCH_MAX_BYTES bytes.
+ * @param [in]      t     Temporary mp_int.
+ * @return  0 on success.
+ * @return  MP_TO_E, MP_READ_E or MP_EXPTMOD_E when conversion or calculation
+ *          fails.
+ */
+static int RsaBatchExptMod(RsaBatchLane* lane, word64* ws, byte* buf,
+    mp_int* t)
+{
+    int ret = 0;
+    int l;
+    int i;
+    int bits = 0;
+    word32 n;
+    word32 sz;
+    word32 k;
+    word64* tbl;
+    word64* m;
+    word64* rr;
+    word64* one;
+    word64* x;
+    word64* mp;
+    word64* idx;
+    byte* e;
+
+    for (l = 0; l < RSA_BATCH_LANES; l++) {
+        if (mp_count_bits(lane[l].mod) > bits) {
+            bits = mp_count_bits(lane[l].mod);
+        }
+    }
+    n = (word32)RSA_BATCH_DIGITS(bits);
+    sz = (n * RSA_BATCH_DIGIT_BITS + 7) / 8;
+
+    tbl = ws;
+    m   = tbl + RSA_BATCH_TABLE_SZ * n * RSA_BATCH_LANES;
+    rr  = m   + n * RSA_BATCH_LANES;
+    one = rr  + n * RSA_BATCH_LANES;
+    x   = one + n * RSA_BATCH_LANES;
+    mp  = x   + n * RSA_BATCH_LANES;
+    idx = mp  + RSA_BATCH_LANES;
+    e   = buf + RSA_BATCH_MAX_BYTES;
+
+    XMEMSET(one, 0, n * RSA_BATCH_LANES * sizeof(word64));
+    for (l = 0; (ret == 0) && (l < RSA_BATCH_LANES); l++) {
+        one[l] = 1;
+
+        if (mp_to_unsigned_bin_len(lane[l].mod, buf, (int)sz) != MP_OKAY) {
+            ret = MP_TO_E;
+            break;
+        }
+        RsaBatchFromBin(m + l, buf, sz, n);
+        mp[l] = RsaBatchMontSetup(m[l]);
+
+        /* R^2 mod m where R = 2^(28n) */
+        mp_zero(t);
+        if ((mp_set_bit(t, (int)(n * RSA_BATCH_DIGIT_BITS)) != MP_OKAY) ||
+                (mp_mod(t, lane[l].mod, t) != MP_OKAY) ||
+                (mp_sqrmod(t, lane[l].mod, t) != MP_OKAY)) {
+            ret = MP_EXPTMOD_E;
+            break;
+        }
+        if (mp_to_unsigned_bin_len(t, buf, (int)sz) != MP_OKAY) {
+            ret = MP_TO_E;
+            break;
+        }
+        RsaBatchFromBin(rr + l, buf, sz, n);
+
+        if ((mp_to_unsigned_bin_len(lane[l].base, buf, (int)sz) != MP_OKAY) ||
+                (mp_to_unsigned_bin_len((mp_int*)lane[l].exp,
+                    e + (word32)l * sz, (int)sz) != MP_OKAY)) {
+            ret = MP_TO_E;
+            break;
+        }
+        RsaBatchFromBin(x + l, buf, sz, n);
+    }
+
+    if (ret == 0) {
+        word64* t1 = tbl + n * RSA_BATCH_LANES;
+
+        /* table[0] = R mod m, table[1] = base * R mod m */
+        rsa_batch_mont_mul_avx2(tbl, rr, one, m, mp, n);
+        rsa_batch_mont_mul_avx2(t1, x, rr, m, mp, n);
+        for (k = 2; k < RSA_BATCH_TABLE_SZ; k++) {
+            rsa_batch_mont_mul_avx2(tbl + k * n * RSA_BATCH_LANES,
+                tbl + (k - 1) * n * RSA_BATCH_LANES, t1, m, mp, n);
+        }
+
+        i = ((bits + RSA_BATCH_WINDOW - 1) / RSA_BATCH_WINDOW) *
+            RSA_BATCH_WINDOW - RSA_BATCH_WINDOW;
+        for (l = 0; l < RSA_BATCH_LANES; l++) {
+            idx[l] = RsaBatchWindow(e + (word32)l * sz, sz, i);
+        }
+        rsa_batch_select_avx2(x, tbl, idx, n, RSA_BATCH_TABLE_SZ);
+        for (i -= RSA_BATCH_WINDOW; i >= 0; i -= RSA_BATCH_WINDOW) {
+            for (k = 0; k < RSA_BATCH_WINDOW; k++) {
+                rsa_batch_mont_mul_avx2(x, x, x, m, mp, n);
+            }
+            for (l = 0; l < RSA_BATCH_LANES; l++) {
+                idx[l] = RsaBatchWindow(e + (word32)l * sz, sz, i);
+            }
+            rsa_batch_select_avx2(rr, tbl, idx, n, RSA_BATCH_TABLE_SZ);
+            rsa_batch_mont_mul_avx2(x, x, rr, m, mp, n);
+        }
+        /* Out of Montgomery form: result is at most m. */
+        rsa_batch_mont_mul_avx2(x, x, one, m, mp, n);
+    }
+
+    for (l = 0; (ret == 0) && (l < RSA_BATCH_LANES); l++) {
+        RsaBatchToBin(buf, sz, x + l, n);
+        if (mp_read_unsigned_bin(lane[l].base, buf, sz) != MP_OKAY) {
+            ret = MP_READ_E;
+        }
+        else if (mp_cmp(lane[l].base, (mp_int*)lane[l].mod) == MP_EQ) {
+            mp_zero(lane[l].base);
+        }
+    }
+
+    ForceZero(ws, RSA_BATCH_WS_WORDS * sizeof(word64));
+    ForceZero(buf, (RSA_BATCH_LANES + 1) * RSA_BATCH_MAX_BYTES);
+
+    return ret;
+}
+
+/* Check whether a private operation can be done in a batch.
+ *
+ * @param [in] key  RSA key.
+ * @param [in] sz   Size of input and output in bytes.
+ * @return  1 when the key can be used in a batch.
+ * @return  0 otherwise.
+ */
+static int RsaBatchKeyOk(RsaKey* key, word32 sz)
+{
+    int maxBits = RSA_BATCH_MAX_DIGITS * RSA_BATCH_DIGIT_BITS - 2;
+
+    if ((key->type != RSA_PRIVATE) || (wc_RsaEncryptSize(key) != (int)sz) ||
+            mp_iseven(&key->n) || mp_iszero(&key->dP) ||
+            mp_iszero(&key->dQ) || mp_iszero(&key->u) ||
+            (mp_count_bits(&key->p) > maxBits) ||
+            (mp_count_bits(&key->q) > maxBits) ||
+            mp_iseven(&key->p) || mp_iseven(&key->q)) {
+        return 0;
+    }
+#ifdef WOLFSSL_RSA_MULTI_PRIME
+    if (key->otherPrimes > 0) {
+        return 0;
+    }
+#endif
+#ifdef WOLF_CRYPTO_CB
+    if (key->devId != INVALID_DEVID) {
+        return 0;
+    }
+#endif
+#if defined(WOLFSSL_ASYNC_CRYPT) && defined(WC_ASYNC_ENABLE_RSA)
+    if (key->asyncDev.marker == WOLFSSL_ASYNC_MARKER_RSA) {
+        return 0;
+    }
+#endif
+#ifdef WC_RSA_NONBLOCK
+    if (key->nb != NULL) {
+        return 0;
+    }
+#endif
+
+    return 1;
+}
+
+/* Private operations of one or two requests as four lanes.
+ *
+ * The CRT halves of each operation are a lane each. A single operation is
+ * put in the lanes twice.
+ *
+ * @param [in]  in    Inputs of the two operations.
+ * @param [out] out   Outputs of the two operations.
+ * @param [in]  sz    Size of inputs and outputs in bytes.
+ * @param [in]  type  RSA_PRIVATE_ENCRYPT or RSA_PRIVATE_DECRYPT.
+ * @param [in]  key   Keys of the two operations.
+ * @param [in]  cnt   Number of operations: 1 or 2.
+ * @param [in]  rng   Random number generator for blinding.
+ * @param [in]  mps   2 * RSA_BATCH_OP_MPS + 1 initialized mp_ints.
+ * @param [in]  ws    Workspace of RSA_BATCH_WS_WORDS words.
+ * @param [in]  buf   Buffer of (RSA_BATCH_LANES + 1) *
+ *                    RSA_BATCH_MAX_BYTES bytes.
+ * @return  0 on success.
+ * @return  RSA_OUT_OF_RANGE_E when decrypt input is out of range.
+ * @return  MP error codes when calculation fails.
+ */
+static int RsaBatchPrivatePair(const byte* const* in, byte* const* out,
+    word32 sz, int type, RsaKey* const* key, int cnt, WC_RNG* rng,
+    mp_int* mps, word64* ws, byte* buf)
+{
+    int ret = 0;
+    int o;
+    RsaBatchLane lane[RSA_BATCH_LANES];
+
+    (void)type;
+    (void)rng;
+
+    for (o = 0; (ret == 0) && (o < cnt); o++) {
+        mp_int* tmp = &mps[o * RSA_BATCH_OP_MPS];
+        mp_int* tmpa = tmp + 1;
+        mp_int* tmpb = tmp + 2;
+    #if defined(WC_RSA_BLINDING) && !defined(WC_NO_RNG)
+        mp_int* rnd = tmp + 3;
+        mp_int* rndi = tmp + 4;
+    #endif
+
+    #if !defined(TEST_UNPAD_CONSTANT_TIME) && !defined(NO_RSA_BOUNDS_CHECK)
+        if (type == RSA_PRIVATE_DECRYPT) {
+            ret = RsaFunctionCheckIn(in[o], sz, key[o], 1);
+            if (ret != 0)
+                break;
+        }
+    #endif
+        if (mp_read_unsigned_bin(tmp, in[o], sz) != MP_OKAY) {
+            ret = MP_READ_E;
+            break;
+        }
+    #if defined(WC_RSA_BLINDING) && !defined(WC_NO_RNG)
+    #ifdef WC_RSA_BLINDING_CACHE
+        ret = RsaBlindingCached(key[o], rng, rnd, rndi);
+    #else
+        ret = RsaBlindingNew(key[o], rng, rnd, rndi);
+    #endif
+        /* tmp = tmp*rnd mod n */
+        if ((ret == 0) && (mp_mulmod(tmp, rnd, &key[o]->n, tmp) != MP_OKAY)) {
+            ret = MP_MULMOD_E;
+        }
+    #endif
+        /* Exponentiate halves modulo p and q. */
+        if ((ret == 0) && ((mp_mod(tmp, &key[o]->p, tmpa) != MP_OKAY) ||
+                (mp_mod(tmp, &key[o]->q, tmpb) != MP_OKAY))) {
+            ret = MP_MOD_E;
+        }
+        lane[2 * o + 0].base = tmpa;
+        lane[2 * o + 0].exp = &key[o]->dP;
+        lane[2 * o + 0].mod = &key[o]->p;
+        lane[2 * o + 1].base = tmpb;
+        lane[2 * o + 1].exp = &key[o]->dQ;
+        lane[2 * o + 1].mod = &key[o]->q;
+    }
+    if ((ret == 0) && (cnt == 1)) {
+        lane[2] = lane[0];
+        lane[3] = lane[1];
+    }
+
+    if (ret == 0) {
+        SAVE_VECTOR_REGISTERS(ret = _svr_ret;);
+        if (ret == 0) {
+            ret = RsaBatchExptMod(lane, ws, buf,
+                &mps[2 * RSA_BATCH_OP_MPS]);
+            RESTORE_VECTOR_REGISTERS();
+        }
+    }
+
+    for (o = 0; (ret == 0) && (o < cnt); o++) {
+        mp_int* tmp = &mps[o * RSA_BATCH_OP_MPS];
+        mp_int* tmpa = tmp + 1;
+        mp_int* tmpb = tmp + 2;
+
+        /* tmp = (tmpa - tmpb) * qInv (mod p) */
+    #if (defined(WOLFSSL_SP_MATH) || (defined(WOLFSSL_SP_MATH_ALL)) && \
+                                              !defined(WOLFSSL_SP_INT_NEGATIVE))
+        if (mp_submod(tmpa, tmpb, &key[o]->p, tmp) != MP_OKAY)
+            ret = MP_SUB_E;
+    #else
+        if (mp_sub(tmpa, tmpb, tmp) != MP_OKAY)
+            ret = MP_SUB_E;
+    #endif
+        if ((ret == 0) && (mp_mulmod(tmp, &key[o]->u, &key[o]->p, tmp) !=
+                MP_OKAY)) {
+            ret = MP_MULMOD_E;
+        }
+        /* tmp = tmpb + q * tmp */
+        if ((ret == 0) && (mp_mul(tmp, &key[o]->q, tmp) != MP_OKAY))
+            ret = MP_MUL_E;
+        if ((ret == 0) && (mp_add(tmp, tmpb, tmp) != MP_OKAY))
+            ret = MP_ADD_E;
+    #if defined(WC_RSA_BLINDING) && !defined(WC_NO_RNG)
+        if (ret == 0)
+            ret = RsaUnblind(tmp, key[o], tmp + 3, tmp + 4);
+    #endif
+        if ((ret == 0) && (mp_to_unsigned_bin_len_ct(tmp, out[o], (int)sz) !=
+                MP_OKAY)) {
+            ret = MP_TO_E;
+        }
+    }
+
+    for (o = 0; o < 2 * RSA_BATCH_OP_MPS + 1; o++) {
+        mp_forcezero(&mps[o]);
+    }
+
+    return ret;
+}
+#endif /* RSA_BATCH_AVX2 */
+
+/* Do the private operations of many independent requests.
+ *
+ * With AVX2, the CRT halves of two operations are exponentiated together in
+ * the four 64-bit lanes of a vector. The keys may differ but all must give
+ * outputs of sz bytes. Operations whose keys can't be batched (multi-prime,
+ * hardware or too large) and all operations on other CPUs are done one at a
+ * time with wc_RsaFunction().
+ *
+ * @param [in]  in    Inputs of the operations: cnt pointers to sz bytes.
+ * @param [out] out   Outputs of the operations: cnt pointers to sz bytes.
+ *                    out[i] may be in[i].
+ * @param [in]  sz    Size of inputs and outputs: size of keys in bytes.
+ * @param [in]  type  RSA_PRIVATE_ENCRYPT or RSA_PRIVATE_DECRYPT.
+ * @param [in]  key   Private keys of the operations.
+ * @param [in]  cnt   Number of operations.
+ * @param [in]  rng   Random number generator for blinding.
+ * @return  0 on success.
+ * @return  BAD_FUNC_ARG when a pointer is NULL, type is not private or cnt
+ *          is negative.
+ * @return  MEMORY_E when dynamic memory allocation fails.
+ * @return  Other negative values on failure of an operation.
+ */
+int wc_RsaFunctionBatch(const byte* const* in, byte* const* out, word32 sz,
+    int type, RsaKey* const* key, int cnt, WC_RNG* rng)
+{
+    int ret = 0;
+    int i;
+#ifdef RSA_BATCH_AVX2
+    int pair[2];
+    int pending = 0;
+    mp_int* mps = NULL;
+    word64* ws = NULL;
+    byte* buf = NULL;
+#endif
+
+    if ((in == NULL) || (out == NULL) || (key == NULL) || (cnt < 0) ||
+            (sz == 0) || ((type != RSA_PRIVATE_ENCRYPT) &&
+            (type != RSA_PRIVATE_DECRYPT))) {
+        return BAD_FUNC_ARG;
+    }
+    for (i = 0; i < cnt; i++) {
+        if ((in[i] == NULL) || (out[i] == NULL) || (key[i] == NULL)) {
+            return BAD_FUNC_ARG;
+        }
+    }
+
+#ifdef RSA_BATCH_AVX2
+    if ((cnt > 0) && IS_INTEL_AVX2(cpuid_get_flags())) {
+        mps = (mp_int*)XMALLOC(sizeof(mp_int) * (2 * RSA_BATCH_OP_MPS + 1),
+            key[0]->heap, DYNAMIC_TYPE_RSA);
+        ws = (word64*)XMALLOC(RSA_BATCH_WS_WORDS * sizeof(word64),
+            key[0]->heap, DYNAMIC_TYPE_RSA);
+        buf = (byte*)XMALLOC((RSA_BATCH_LANES + 1) * RSA_BATCH_MAX_BYTES,
+            key[0]->heap, DYNAMIC_TYPE_RSA);
+        if ((mps == NULL) || (ws == NULL) || (buf == NULL)) {
+            ret = MEMORY_E;
+        }
+        for (i = 0; (ret == 0) && (i < 2 * RSA_BATCH_OP_MPS + 1); i++) {
+            if (mp_init(&mps[i]) != MP_OKAY) {
+                ret = MP_INIT_E;
+            }
+        }
+    }
+#endif
+
+    for (i = 0; (ret == 0) && (i < cnt); i++) {
+    #ifdef RSA_BATCH_AVX2
+        if ((ws != NULL) && RsaBatchKeyOk(key[i], sz)) {
+            pair[pending++] = i;
+            if (pending == 2) {
+                const byte* pIn[2];
+                byte* pOut[2];
+                RsaKey* pKey[2];
+
+                pIn[0] = in[pair[0]];  pIn[1] = in[pair[1]];
+                pOut[0] = out[pair[0]]; pOut[1] = out[pair[1]];
+                pKey[0] = key[pair[0]]; pKey[1] = key[pair[1]];
+                ret = RsaBatchPrivatePair(pIn, pOut, sz, type, pKey, 2, rng,
+                    mps, ws, buf);
+                pending = 0;
+            }
+        }
+        else
+    #endif
+        {
+            word32 outLen = sz;
+
+            ret = wc_RsaFunction(in[i], sz, out[i], &outLen, type, key[i],
+                rng);
+            if (ret > 0) {
+                ret = 0;
+            }
+        }
+    }
+#ifdef RSA_BATCH_AVX2
+    if ((ret == 0) && (pending == 1)) {
+        ret = RsaBatchPrivatePair(&in[pair[0]], &out[pair[0]], sz, type,
+            &key[pair[0]], 1, rng, mps, ws, buf);
+    }
+
+    if (mps != NULL) {
+        for (i = 0; i < 2 * RSA_BATCH_OP_MPS + 1; i++) {
+            mp_free(&mps[i]);
+        }
+        XFREE(mps, key[0]->heap, DYNAMIC_TYPE_RSA);
+    }
+    XFREE(ws, key[0]->heap, DYNAMIC_TYPE_RSA);
+    XFREE(buf, key[0]->heap, DYNAMIC_TYPE_RSA);
+#endif
+
+    return ret;
+}
+
+/* Sign many hashes, each with PKCS #1 v1.5 padding.
+ *
+ * The private operations are done with wc_RsaFunctionBatch().
+ *
+ * @param [in]  in      Encoded digests to sign.
+ * @param [in]  inLen   Lengths of the encoded digests.
+ * @param [out] out     Buffers to hold signatures, each outLen bytes.
+ * @param [in]  outLen  Size of each output buffer.
+ * @param [in]  key     Private keys, all of the same size.
+ * @param [in]  cnt     Number of signatures.
+ * @param [in]  rng     Random number generator.
+ * @return  Size of each signature on success.
+ * @return  BAD_FUNC_ARG when a pointer is NULL, cnt is not positive or the
+ *          keys differ in size.
+ * @return  RSA_BUFFER_E when an input is too long or an output too short.
+ * @return  Other negative values on failure.
+ */
+int wc_RsaSSL_SignBatch(const byte* const* in, const word32* inLen,
+    byte* const* out, word32 outLen, RsaKey* const* key, int cnt, WC_RNG* rng)
+{
+    int ret = 0;
+    int sz;
+    int i;
+
+    if ((in == NULL) || (inLen == NULL) || (out == NULL) || (key == NULL) ||
+            (cnt <= 0) || (key[0] == NULL)) {
+        return BAD_FUNC_ARG;
+    }
+
+    sz = wc_RsaEncryptSize(key[0]);
+    if (sz < RSA_MIN_PAD_SZ || sz > (int)RSA_MAX_SIZE/8) {
+        return WC_KEY_SIZE_E;
+    }
+    if (sz > (int)outLen) {
+        return RSA_BUFFER_E;
+    }
+
+    for (i = 0; (ret == 0) && (i < cnt); i++) {
+        if ((in[i] == NULL) || (out[i] == NULL) || (key[i] == NULL) ||
+                (wc_RsaEncryptSize(key[i]) != sz)) {
+            ret = BAD_FUNC_ARG;
+        }
+        else if (inLen[i] > (word32)(sz - RSA_MIN_PAD_SZ)) {
+            ret = RSA_BUFFER_E;
+        }
+        else {
+            ret = wc_RsaPad_ex(in[i], inLen[i], out[i], (word32)sz,
+                RSA_BLOCK_TYPE_1, rng, WC_RSA_PKCSV15_PAD, WC_HASH_TYPE_NONE,
+                WC_MGF1NONE, NULL, 0, 0, mp_count_bits(&key[i]->n),
+                key[i]->heap);
+        }
+    }
+    if (ret == 0) {
+        ret = wc_RsaFunctionBatch((const byte* const*)out, out, (word32)sz,
+            RSA_PRIVATE_ENCRYPT, key, cnt, rng);
+    }
+    if (ret == 0) {
+        ret = sz;
+    }
+
+    return ret;
+}
+#endif /* WC_RSA_BATCH */
+#endif
+
+int wc_RsaEncryptSize(const RsaKey* key)
+{
+    int ret;
+
+    if (key == NULL) {
+        return BAD_FUNC_ARG;
+    }
+
+    ret = mp_unsigned_bin_size(&key->n);
+
+#ifdef WOLF_CRYPTO_CB
+    if (ret == 0 && key->devId != INVALID_DEVID) {
+        if (wc_CryptoCb_RsaGetSize(key, &ret) == CRYPTOCB_UNAVAILABLE) {
+            ret = 2048/8; /* hardware handles, use 2048-bit as default */
+        }
+    }
+#endif
+
+    return ret;
+}
+
+#ifndef WOLFSSL_RSA_VERIFY_ONLY
+/* flatten RsaKey structure into individual elements (e, n) */
+int wc_RsaFlattenPublicKey(RsaKey* key, byte* e, word32* eSz, byte* n,
+                                                                   word32* nSz)
+{
+    int sz, ret;
+
+    if (key == NULL || e == NULL || eSz == NULL || n == NULL || nSz == NULL) {
+        return BAD_FUNC_ARG;
+    }
+
+    sz = mp_unsigned_bin_size(&key->e);
+    if ((word32)sz > *eSz)
+        return RSA_BUFFER_E;
+    ret = mp_to_unsigned_bin(&key->e, e);
     if (ret != MP_OKAY)
         return ret;
     *eSz = (word32)sz;
@@ -5009,6 +5987,10 @@ int wc_MakeRsaKey(RsaKey* key, int size, long e, WC_RNG* rng)
 
     if (err == MP_OKAY)
         key->type = RSA_PRIVATE;
+#ifdef WOLFSSL_RSA_MULTI_PRIME
+    if (err == MP_OKAY)
+        key->otherPrimes = 0;
+#endif
 
 #ifdef WOLFSSL_CHECK_MEM_ZERO
     if (err == MP_OKAY) {
@@ -5081,6 +6063,301 @@ int wc_MakeRsaKey(RsaKey* key, int size, long e, WC_RNG* rng)
     return NOT_COMPILED_IN;
 #endif
 }
+
+#ifdef WOLFSSL_RSA_MULTI_PRIME
+/* Maximum number of primes for a modulus size.
+ *
+ * The primes must stay large enough that finding one with ECM is no easier
+ * than factoring the modulus.
+ *
+ * @param [in] size  Size of modulus in bits.
+ * @return  Maximum number of primes.
+ */
+static int RsaMultiPrimeMax(int size)
+{
+    if (size < 1024)
+        return 2;
+    if (size < 4096)
+        return 3;
+    return RSA_MAX_PRIMES;
+}
+
+/* Generate a prime of bits bits for a multi-prime key.
+ *
+ * The top three bits are set so that the product of the primes, whose sizes
+ * add up to the modulus size, has exactly that many bits: 1.75^k >= 2^(k-1)
+ * for up to five primes.
+ *
+ * @param [out] prime  Generated prime.
+ * @param [in]  bits   Size of prime in bits.
+ * @param [in]  e      Public exponent. gcd(prime - 1, e) will be 1.
+ * @param [in]  tmp1   Temporary mp_int.
+ * @param [in]  tmp2   Temporary mp_int.
+ * @param [in]  buf    Buffer of at least (bits + 7) / 8 bytes.
+ * @param [in]  rng    Random number generator.
+ * @return  0 on success.
+ * @return  RNG or MP error codes on failure.
+ */
+static int RsaMultiPrimeMakePrime(mp_int* prime, int bits, mp_int* e,
+    mp_int* tmp1, mp_int* tmp2, byte* buf, WC_RNG* rng)
+{
+    int err;
+    int isPrime = 0;
+    word32 sz = ((word32)bits + 7) / 8;
+
+    do {
+        err = wc_RNG_GenerateBlock(rng, buf, sz);
+        if (err == 0) {
+            /* drop bits above the size of the prime */
+            buf[0] &= (byte)(0xff >> ((8 - (bits & 7)) & 7));
+            err = mp_read_unsigned_bin(prime, buf, sz);
+        }
+        /* set top three bits and make candidate odd */
+        if (err == MP_OKAY)
+            err = mp_set_bit(prime, bits - 1);
+        if (err == MP_OKAY)
+            err = mp_set_bit(prime, bits - 2);
+        if (err == MP_OKAY)
+            err = mp_set_bit(prime, bits - 3);
+        if (err == MP_OKAY)
+            err = mp_set_bit(prime, 0);
+        /* Check that GCD(prime-1, e) == 1 */
+        if (err == MP_OKAY)
+            err = mp_sub_d(prime, 1, tmp1);
+        if (err == MP_OKAY)
+            err = mp_gcd(tmp1, e, tmp2);
+        if ((err == MP_OKAY) && (mp_cmp_d(tmp2, 1) == MP_EQ))
+            err = mp_prime_is_prime_ex(prime, 8, &isPrime, rng);
+    } while ((err == MP_OKAY) && !isPrime);
+
+    return err;
+}
+
+/* Make a multi-prime RSA key (RFC 8017) for size bits with e specified.
+ *
+ * The private operation does CRT over all the primes. Each exponentiation is
+ * on a smaller modulus so private operations are faster than with two primes.
+ *
+ * @param [in, out] key     RSA key object.
+ * @param [in]      size    Size of modulus in bits.
+ * @param [in]      e       Public exponent.
+ * @param [in]      primes  Number of primes. 2 makes a standard key.
+ *                          3 needs a modulus of at least 1024 bits and 4 at
+ *                          least 4096 bits.
+ * @param [in]      rng     Random number generator.
+ * @return  0 on success.
+ * @return  BAD_FUNC_ARG when key or rng is NULL, or size, e or primes is
+ *          invalid.
+ * @return  MEMORY_E when dynamic memory allocation fails.
+ * @return  RNG or MP error codes on failure.
+ */
+int wc_MakeRsaKeyMultiPrime(RsaKey* key, int size, long e, int primes,
+    WC_RNG* rng)
+{
+#ifdef WOLFSSL_SMALL_STACK
+    mp_int* r = NULL;
+#else
+    mp_int r[RSA_MAX_PRIMES + 3];
+#endif
+    mp_int* tmp1;
+    mp_int* tmp2;
+    mp_int* tmp3;
+    byte* buf = NULL;
+    word32 bufSz;
+    int err = 0;
+    int i;
+    int j;
+
+    if ((key == NULL) || (rng == NULL) || (primes < 2)) {
+        return BAD_FUNC_ARG;
+    }
+    if (primes == 2) {
+        return wc_MakeRsaKey(key, size, e, rng);
+    }
+    if ((!RsaSizeCheck(size)) || (primes > RsaMultiPrimeMax(size)) ||
+            (e < 3) || ((e & 1) == 0)) {
+        return BAD_FUNC_ARG;
+    }
+
+#ifdef WOLFSSL_SMALL_STACK
+    r = (mp_int*)XMALLOC(sizeof(mp_int) * (RSA_MAX_PRIMES + 3), key->heap,
+        DYNAMIC_TYPE_RSA);
+    if (r == NULL) {
+        return MEMORY_E;
+    }
+#endif
+    tmp1 = &r[RSA_MAX_PRIMES];
+    tmp2 = &r[RSA_MAX_PRIMES + 1];
+    tmp3 = &r[RSA_MAX_PRIMES + 2];
+    for (i = 0; i < RSA_MAX_PRIMES + 3; i++) {
+        if (err == 0)
+            err = mp_init(&r[i]);
+        else
+            XMEMSET(&r[i], 0, sizeof(mp_int));
+    }
+
+    /* largest prime is first */
+    bufSz = ((word32)(size / primes) + 8) / 8;
+    if (err == MP_OKAY) {
+        buf = (byte*)XMALLOC(bufSz, key->heap, DYNAMIC_TYPE_RSA);
+        if (buf == NULL)
+            err = MEMORY_E;
+    }
+    if (err == MP_OKAY)
+        err = mp_set_int(&key->e, (unsigned long)e);
+
+    SAVE_VECTOR_REGISTERS(err = _svr_ret;);
+
+    /* make primes - sizes add up to size with the first ones larger */
+    for (i = 0; (err == MP_OKAY) && (i < primes); i++) {
+        int bits = size / primes + ((i < size % primes) ? 1 : 0);
+
+        do {
+            err = RsaMultiPrimeMakePrime(&r[i], bits, &key->e, tmp1, tmp2, buf,
+                rng);
+            /* primes must be distinct */
+            for (j = 0; (err == MP_OKAY) && (j < i); j++) {
+                if (mp_cmp(&r[i], &r[j]) == MP_EQ)
+                    break;
+            }
+        } while ((err == MP_OKAY) && (j < i));
+    }
+
+    if (buf != NULL) {
+        ForceZero(buf, bufSz);
+        XFREE(buf, key->heap, DYNAMIC_TYPE_RSA);
+    }
+
+    /* p > q for CRT recombination */
+    if ((err == MP_OKAY) && (mp_cmp(&r[0], &r[1]) == MP_LT)) {
+        err = mp_copy(&r[0], tmp1);
+        if (err == MP_OKAY)
+            err = mp_copy(&r[1], &r[0]);
+        if (err == MP_OKAY)
+            err = mp_copy(tmp1, &r[1]);
+    }
+
+    /* tmp3 = order of n (product of primes - 1) */
+    if (err == MP_OKAY)
+        err = mp_sub_d(&r[0], 1, tmp3);
+    for (i = 1; (err == MP_OKAY) && (i < primes); i++) {
+        err = mp_sub_d(&r[i], 1, tmp1);
+    #ifdef WC_RSA_BLINDING
+        if (err == MP_OKAY)
+            err = mp_mul(tmp3, tmp1, tmp2);
+    #else
+        if (err == MP_OKAY)                /* lcm of all primes - 1 */
+            err = mp_lcm(tmp3, tmp1, tmp2);
+    #endif
+        if (err == MP_OKAY)
+            err = mp_copy(tmp2, tmp3);
+    }
+
+#ifdef WC_RSA_BLINDING
+    /* Blind the inverse operation with a value that is invertable */
+    if (err == MP_OKAY) {
+        do {
+            err = mp_rand(tmp1, get_digit_count(tmp3), rng);
+            if (err == MP_OKAY)
+                err = mp_set_bit(tmp1, 0);
+            if (err == MP_OKAY)
+                err = mp_set_bit(tmp1, size - 1);
+            if (err == MP_OKAY)
+                err = mp_gcd(tmp1, tmp3, tmp2);
+        }
+        while ((err == MP_OKAY) && !mp_isone(tmp2));
+    }
+    if (err == MP_OKAY)                /* tmp2 = e * blind */
+        err = mp_mul(tmp1, &key->e, tmp2);
+    if (err == MP_OKAY)                /* key->d = 1/(e * blind) */
+        err = mp_invmod(tmp2, tmp3, &key->d);
+    if (err == MP_OKAY)                /* take off blinding: key->d = 1/e */
+        err = mp_mulmod(&key->d, tmp1, tmp3, &key->d);
+#else
+    if (err == MP_OKAY)                /* key->d = 1/e mod lcm */
+        err = mp_invmod(&key->e, tmp3, &key->d);
+#endif
+
+    /* key->n = product of primes */
+    if (err == MP_OKAY)
+        err = mp_mul(&r[0], &r[1], &key->n);
+    for (i = 2; (err == MP_OKAY) && (i < primes); i++)
+        err = mp_mul(&key->n, &r[i], &key->n);
+
+    if (err == MP_OKAY)                /* key->dP = d mod(p-1) */
+        err = mp_sub_d(&r[0], 1, tmp1);
+    if (err == MP_OKAY)
+        err = mp_mod(&key->d, tmp1, &key->dP);
+    if (err == MP_OKAY)                /* key->dQ = d mod(q-1) */
+        err = mp_sub_d(&r[1], 1, tmp1);
+    if (err == MP_OKAY)
+        err = mp_mod(&key->d, tmp1, &key->dQ);
+#ifdef WOLFSSL_MP_INVMOD_CONSTANT_TIME
+    if (err == MP_OKAY)                /* key->u = 1/q mod p */
+        err = mp_invmod(&r[1], &r[0], &key->u);
+#else
+    if (err == MP_OKAY)
+        err = mp_sub_d(&r[0], 2, tmp1);
+    if (err == MP_OKAY)                /* key->u = 1/q mod p = q^p-2 mod p */
+        err = mp_exptmod(&r[1], tmp1, &r[0], &key->u);
+#endif
+
+    /* tmp3 = product of primes before r_i */
+    if (err == MP_OKAY)
+        err = mp_mul(&r[0], &r[1], tmp3);
+    for (i = 2; (err == MP_OKAY) && (i < primes); i++) {
+        mp_int* ri = &r[i];
+
+        err = mp_sub_d(ri, 1, tmp1);
+        if (err == MP_OKAY)            /* d_i = d mod (r_i - 1) */
+            err = mp_mod(&key->d, tmp1, &key->dR[i - 2]);
+        if (err == MP_OKAY)
+            err = mp_mod(tmp3, ri, tmp2);
+    #ifdef WOLFSSL_MP_INVMOD_CONSTANT_TIME
+        if (err == MP_OKAY)            /* t_i = 1/tmp3 mod r_i */
+            err = mp_invmod(tmp2, ri, &key->tR[i - 2]);
+    #else
+        if (err == MP_OKAY)
+            err = mp_sub_d(ri, 2, tmp1);
+        if (err == MP_OKAY)            /* t_i = tmp3^(r_i-2) mod r_i */
+            err = mp_exptmod(tmp2, tmp1, ri, &key->tR[i - 2]);
+    #endif
+        if (err == MP_OKAY)
+            err = mp_copy(ri, &key->r[i - 2]);
+        if (err == MP_OKAY)
+            err = mp_mul(tmp3, ri, tmp3);
+    }
+
+    if (err == MP_OKAY)
+        err = mp_copy(&r[0], &key->p);
+    if (err == MP_OKAY)
+        err = mp_copy(&r[1], &key->q);
+    if (err == MP_OKAY) {
+        key->otherPrimes = primes - 2;
+        key->type = RSA_PRIVATE;
+    }
+
+    RESTORE_VECTOR_REGISTERS();
+
+    for (i = 0; i < RSA_MAX_PRIMES + 3; i++) {
+        mp_forcezero(&r[i]);
+    }
+#ifdef WOLFSSL_SMALL_STACK
+    XFREE(r, key->heap, DYNAMIC_TYPE_RSA);
+#endif
+
+#ifdef WOLFSSL_RSA_KEY_CHECK
+    /* Perform the pair-wise consistency test on the new key. */
+    if (err == 0)
+        err = _ifc_pairwise_consistency_test(key, rng);
+#endif
+
+    if (err != 0) {
+        wc_FreeRsaKey(key);
+    }
+    return err;
+}
+#endif /* WOLFSSL_RSA_MULTI_PRIME */
 #endif /* !FIPS || FIPS_VER >= 2 */
 #endif /* WOLFSSL_KEY_GEN */
 
@@ -410,6 +410,41 @@
     }
 #endif /* End Hardware Acceleration */
 
+#if defined(USE_SHA_SOFTWARE_IMPL) && !defined(XTRANSFORM) && \
+    defined(WOLFSSL_X86_64_BUILD) && defined(USE_INTEL_SPEEDUP) && \
+    !defined(NO_SHA_NI_SUPPORT) && !defined(WOLFSSL_NO_ASM) && \
+    !defined(HAVE_FIPS)
+    /* Intel SHA extensions, selected at runtime from the CPU flags. The
+     * SHA-NI transform reads the message as big-endian bytes so no byte
+     * reversal of the buffer is done when it is in use. */
+    #define HAVE_INTEL_SHA
+
+    #include <wolfssl/wolfcrypt/cpuid.h>
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+        extern int Transform_Sha_SHA_NI_Len(word32* digest, const byte* data,
+                                            word32 len);
+#ifdef __cplusplus
+    }  /* extern "C" */
+#endif
+
+    static word32 intel_flags = 0;
+
+    static int Transform(wc_Sha* sha, const byte* data);
+
+    static WC_INLINE int Transform_Intel(wc_Sha* sha, const byte* data)
+    {
+        if (IS_INTEL_SHA(intel_flags)) {
+            return Transform_Sha_SHA_NI_Len(sha->digest, data,
+                                            WC_SHA_BLOCK_SIZE);
+        }
+        return Transform(sha, data);
+    }
+    #define XTRANSFORM(S,B)   Transform_Intel((S),(B))
+#endif
+
 /* Software implementation */
 #ifdef USE_SHA_SOFTWARE_IMPL
 
@@ -421,8 +456,10 @@ static WC_INLINE void AddLength(wc_Sha* sha, word32 len)
 }
 
 /* Check if custom wc_Sha transform is used */
-#ifndef XTRANSFORM
+#if !defined(XTRANSFORM) || defined(HAVE_INTEL_SHA)
+    #ifndef XTRANSFORM
     #define XTRANSFORM(S,B)   Transform((S),(B))
+    #endif
 
     #define blk0(i) (W[i] = *((word32*)&data[(i)*sizeof(word32)]))
     #define blk1(i) (W[(i)&15] = \
@@ -566,6 +603,11 @@ int wc_InitSha_ex(wc_Sha* sha, void* heap, int devId)
         return ret;
     }
 
+#ifdef HAVE_INTEL_SHA
+    /* choose best Transform function under this runtime environment */
+    intel_flags = cpuid_get_flags();
+#endif
+
 #if defined(WOLFSSL_ASYNC_CRYPT) && defined(WC_ASYNC_ENABLE_SHA)
     ret = wolfAsync_DevCtxInit(&sha->asyncDev, WOLFSSL_ASYNC_MARKER_SHA,
                                                             sha->heap, devId);
@@ -649,6 +691,9 @@ int wc_ShaUpdate(wc_Sha* sha, const byte* data, word32 len)
                 !defined(NO_WOLFSSL_ESP32_CRYPT_HASH)
                 if (esp_sha_need_byte_reversal(&sha->ctx))
             #endif
+            #ifdef HAVE_INTEL_SHA
+                if (!IS_INTEL_SHA(intel_flags))
+            #endif
             {
                 ByteReverseWords(sha->buffer, sha->buffer, WC_SHA_BLOCK_SIZE);
             }
@@ -686,6 +731,17 @@ int wc_ShaUpdate(wc_Sha* sha, const byte* data, word32 len)
     } /* (sha->buffLen > 0)  Process any remainder from previous operation. */
 
     /* process blocks */
+#ifdef HAVE_INTEL_SHA
+    if (IS_INTEL_SHA(intel_flags)) {
+        /* Byte reversal performed in function. */
+        blocksLen = len & ~((word32)WC_SHA_BLOCK_SIZE-1);
+        if (blocksLen > 0) {
+            ret = Transform_Sha_SHA_NI_Len(sha->digest, data, blocksLen);
+            data += blocksLen;
+            len  -= blocksLen;
+        }
+    }
+#endif
 #ifdef XTRANSFORM_LEN
     /* get number of blocks */
     /* 64-1 = 0x3F (~ Inverted = 0xFFFFFFC0) */
@@ -839,6 +895,9 @@ int wc_ShaFinal(wc_Sha* sha, byte* hash)
             !defined(NO_WOLFSSL_ESP32_CRYPT_HASH)
             if (esp_sha_need_byte_reversal(&sha->ctx))
         #endif
+        #ifdef HAVE_INTEL_SHA
+            if (!IS_INTEL_SHA(intel_flags))
+        #endif
         {
             ByteReverseWords(sha->buffer, sha->buffer, WC_SHA_BLOCK_SIZE);
         }
@@ -880,6 +939,9 @@ int wc_ShaFinal(wc_Sha* sha, byte* hash)
         !defined(NO_WOLFSSL_ESP32_CRYPT_HASH)
         if (esp_sha_need_byte_reversal(&sha->ctx))
     #endif
+    #ifdef HAVE_INTEL_SHA
+        if (!IS_INTEL_SHA(intel_flags))
+    #endif
     { /* reminder local also points to sha->buffer  */
         ByteReverseWords(sha->buffer, sha->buffer, WC_SHA_BLOCK_SIZE);
     }
@@ -894,8 +956,11 @@ int wc_ShaFinal(wc_Sha* sha, byte* hash)
     XMEMCPY(&local[WC_SHA_PAD_SIZE], &sha->hiLen, sizeof(word32));
     XMEMCPY(&local[WC_SHA_PAD_SIZE + sizeof(word32)], &sha->loLen, sizeof(word32));
 
-#if defined(FREESCALE_MMCAU_SHA)
-    /* Kinetis requires only these bytes reversed */
+#if defined(FREESCALE_MMCAU_SHA) || defined(HAVE_INTEL_SHA)
+    /* Kinetis and SHA-NI require only these bytes reversed */
+    #ifdef HAVE_INTEL_SHA
+    if (IS_INTEL_SHA(intel_flags))
+    #endif
     ByteReverseWords(&sha->buffer[WC_SHA_PAD_SIZE/sizeof(word32)],
                      &sha->buffer[WC_SHA_PAD_SIZE/sizeof(word32)],
                      2 * sizeof(word32));
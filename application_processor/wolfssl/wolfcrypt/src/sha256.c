@@ -166,6 +166,9 @@ on the specific device platform.
 #if defined(HAVE_INTEL_AVX2)
     #define HAVE_INTEL_RORX
 #endif
+#if defined(HAVE_INTEL_AVX1) && !defined(NO_SHA_NI_SUPPORT)
+    #define HAVE_INTEL_SHA
+#endif
 
 
 #if !defined(WOLFSSL_PIC32MZ_HASH) && !defined(STM32_HASH_SHA2) && \
@@ -246,6 +249,8 @@ static int InitSha256(wc_Sha256* sha256)
 
     #define HAVE_INTEL_RORX
 
+    #define HAVE_INTEL_SHA   (SHA-NI, preferred when the CPU has it)
+
 
     int InitSha256(wc_Sha256* sha256) {
          Save/Recover XMM, YMM
@@ -319,6 +324,11 @@ static int InitSha256(wc_Sha256* sha256)
                                                   const byte* data, word32 len);
         #endif /* HAVE_INTEL_RORX */
     #endif /* HAVE_INTEL_AVX2 */
+    #if defined(HAVE_INTEL_SHA)
+        extern int Transform_Sha256_SHA_NI(wc_Sha256 *sha256, const byte* data);
+        extern int Transform_Sha256_SHA_NI_Len(wc_Sha256* sha256,
+                                               const byte* data, word32 len);
+    #endif /* HAVE_INTEL_SHA */
 
 #ifdef __cplusplus
     }  /* extern "C" */
@@ -349,12 +359,23 @@ static int InitSha256(wc_Sha256* sha256)
 
     static void Sha256_SetTransform(void)
     {
+        word32 flags = cpuid_get_flags();
 
-        if (transform_check)
+        /* Re-select when the CPU flags have been changed with
+         * cpuid_select_flags() since the last selection. */
+        if (transform_check && flags == intel_flags)
             return;
 
-        intel_flags = cpuid_get_flags();
+        intel_flags = flags;
 
+    #ifdef HAVE_INTEL_SHA
+        if (IS_INTEL_SHA(intel_flags)) {
+            Transform_Sha256_p = Transform_Sha256_SHA_NI;
+            Transform_Sha256_Len_p = Transform_Sha256_SHA_NI_Len;
+            Transform_Sha256_is_vectorized = 1;
+        }
+        else
+    #endif
     #ifdef HAVE_INTEL_AVX2
         if (1 && IS_INTEL_AVX2(intel_flags)) {
         #ifdef HAVE_INTEL_RORX
@@ -1071,7 +1092,7 @@ static int InitSha256(wc_Sha256* sha256)
                 #if defined(WOLFSSL_X86_64_BUILD) && \
                           defined(USE_INTEL_SPEEDUP) && \
                           (defined(HAVE_INTEL_AVX1) || defined(HAVE_INTEL_AVX2))
-                if (!IS_INTEL_AVX1(intel_flags) && !IS_INTEL_AVX2(intel_flags))
+                if (!Transform_Sha256_is_vectorized)
                 #endif
                 #if (defined(CONFIG_IDF_TARGET_ESP32C3) || \
                      defined(CONFIG_IDF_TARGET_ESP32C6)) && \
@@ -1189,7 +1210,7 @@ static int InitSha256(wc_Sha256* sha256)
                 #if defined(WOLFSSL_X86_64_BUILD) && \
                           defined(USE_INTEL_SPEEDUP) && \
                           (defined(HAVE_INTEL_AVX1) || defined(HAVE_INTEL_AVX2))
-                if (!IS_INTEL_AVX1(intel_flags) && !IS_INTEL_AVX2(intel_flags))
+                if (!Transform_Sha256_is_vectorized)
                 #endif
                 {
                     ByteReverseWords(local32, local32, WC_SHA256_BLOCK_SIZE);
@@ -1306,7 +1327,7 @@ static int InitSha256(wc_Sha256* sha256)
             #endif
             #if defined(WOLFSSL_X86_64_BUILD) && defined(USE_INTEL_SPEEDUP) && \
                           (defined(HAVE_INTEL_AVX1) || defined(HAVE_INTEL_AVX2))
-            if (!IS_INTEL_AVX1(intel_flags) && !IS_INTEL_AVX2(intel_flags))
+            if (!Transform_Sha256_is_vectorized)
             #endif
             {
                 ByteReverseWords(sha256->buffer, sha256->buffer,
@@ -1359,7 +1380,7 @@ static int InitSha256(wc_Sha256* sha256)
         #endif
         #if defined(WOLFSSL_X86_64_BUILD) && defined(USE_INTEL_SPEEDUP) && \
                           (defined(HAVE_INTEL_AVX1) || defined(HAVE_INTEL_AVX2))
-        if (!IS_INTEL_AVX1(intel_flags) && !IS_INTEL_AVX2(intel_flags))
+        if (!Transform_Sha256_is_vectorized)
         #endif
         {
             ByteReverseWords(sha256->buffer, sha256->buffer,
@@ -1399,7 +1420,7 @@ static int InitSha256(wc_Sha256* sha256)
         /* Kinetis requires only these bytes reversed */
         #if defined(WOLFSSL_X86_64_BUILD) && defined(USE_INTEL_SPEEDUP) && \
                           (defined(HAVE_INTEL_AVX1) || defined(HAVE_INTEL_AVX2))
-        if (IS_INTEL_AVX1(intel_flags) || IS_INTEL_AVX2(intel_flags))
+        if (Transform_Sha256_is_vectorized)
         #endif
         {
             ByteReverseWords(
@@ -2265,4 +2286,299 @@ int wc_Sha256GetFlags(wc_Sha256* sha256, word32* flags)
 #endif
 #endif /* !WOLFSSL_TI_HASH */
 
+#ifdef WOLFSSL_SHA256_MULTI
+
+#if defined(WOLFSSL_X86_64_BUILD) && defined(USE_INTEL_SPEEDUP) && \
+    defined(HAVE_INTEL_AVX1) && !defined(WOLFSSL_NO_ASM)
+    #define SHA256_MULTI_SIMD
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+        /* One block of each of 4 or 8 messages. The state is stored word
+         * major: state[word * lanes + lane]. */
+        extern int Transform_Sha256_AVX1_x4(word32* state, const byte** data);
+    #ifdef HAVE_INTEL_AVX2
+        extern int Transform_Sha256_AVX2_x8(word32* state, const byte** data);
+    #endif
+#ifdef __cplusplus
+    }  /* extern "C" */
+#endif
+
+#define SHA256_MULTI_MAX_LANES  8
+
+/* Progress of one message through a SIMD lane. */
+typedef struct Sha256MultiLane {
+    const byte* data;       /* next full block of the message */
+    word32      blocks;     /* full message blocks left */
+    word32      len;        /* length of the message in bytes */
+    word32      padBlocks;  /* padding blocks left */
+    word32      padTotal;   /* padding blocks, 1 or 2 */
+    word32      idx;        /* index of the message */
+    byte        pad[2 * WC_SHA256_BLOCK_SIZE];
+} Sha256MultiLane;
+
+static const word32 sha256MultiIV[WC_SHA256_DIGEST_SIZE / sizeof(word32)] = {
+    0x6A09E667L, 0xBB67AE85L, 0x3C6EF372L, 0xA54FF53AL,
+    0x510E527FL, 0x9B05688CL, 0x1F83D9ABL, 0x5BE0CD19L
+};
+
+static void Sha256MultiLaneStart(Sha256MultiLane* lane, word32* state,
+    int lanes, int l, const byte* data, word32 len, word32 idx)
+{
+    word32 rem = len & (WC_SHA256_BLOCK_SIZE - 1);
+    word32 padLen;
+    int i;
+
+    lane->data = data;
+    lane->blocks = len / WC_SHA256_BLOCK_SIZE;
+    lane->len = len;
+    lane->idx = idx;
+    lane->padTotal = (rem < WC_SHA256_PAD_SIZE) ? 1 : 2;
+    lane->padBlocks = lane->padTotal;
+
+    /* Final bytes of the message, the 1 bit and the length in bits. */
+    padLen = lane->padTotal * WC_SHA256_BLOCK_SIZE;
+    if (rem > 0) {
+        XMEMCPY(lane->pad, data + len - rem, rem);
+    }
+    lane->pad[rem] = 0x80;
+    XMEMSET(lane->pad + rem + 1, 0, padLen - rem - 1 - 8);
+    lane->pad[padLen - 8] = 0;
+    lane->pad[padLen - 7] = 0;
+    lane->pad[padLen - 6] = 0;
+    lane->pad[padLen - 5] = (byte)(len >> 29);
+    lane->pad[padLen - 4] = (byte)(len >> 21);
+    lane->pad[padLen - 3] = (byte)(len >> 13);
+    lane->pad[padLen - 2] = (byte)(len >>  5);
+    lane->pad[padLen - 1] = (byte)(len <<  3);
+
+    for (i = 0; i < 8; i++) {
+        state[i * lanes + l] = sha256MultiIV[i];
+    }
+}
+
+static void Sha256MultiLaneDigest(const word32* state, int lanes, int l,
+    byte* hash)
+{
+    int i;
+
+    for (i = 0; i < 8; i++) {
+        word32 w = state[i * lanes + l];
+        hash[i * 4 + 0] = (byte)(w >> 24);
+        hash[i * 4 + 1] = (byte)(w >> 16);
+        hash[i * 4 + 2] = (byte)(w >>  8);
+        hash[i * 4 + 3] = (byte)(w      );
+    }
+}
+
+/* Finish a lane that has not started on its padding with the single-buffer
+ * code. Used once too few lanes are busy for SIMD to pay off. */
+static int Sha256MultiLaneFinish(Sha256MultiLane* lane, const word32* state,
+    int lanes, int l, byte* hash, void* heap)
+{
+    int ret;
+    int i;
+    wc_Sha256 sha256[1];
+
+    ret = wc_InitSha256_ex(sha256, heap, INVALID_DEVID);
+    if (ret == 0) {
+        for (i = 0; i < 8; i++) {
+            sha256->digest[i] = state[i * lanes + l];
+        }
+        sha256->loLen = (lane->len / WC_SHA256_BLOCK_SIZE - lane->blocks) *
+                        WC_SHA256_BLOCK_SIZE;
+        ret = wc_Sha256Update(sha256, lane->data,
+                                 lane->len - sha256->loLen);
+    }
+    if (ret == 0) {
+        ret = wc_Sha256Final(sha256, hash);
+    }
+    wc_Sha256Free(sha256);
+
+    return ret;
+}
+
+static int Sha256HashMultiSIMD(const byte* const* data, const word32* len,
+    byte* const* hash, word32 cnt, void* heap, int lanes,
+    int (*transform)(word32* state, const byte** data))
+{
+    int ret = 0;
+    int l;
+    int active = 0;
+    word32 next = 0;
+    const byte* blk[SHA256_MULTI_MAX_LANES];
+    word32 state[8 * SHA256_MULTI_MAX_LANES];
+#ifdef WOLFSSL_SMALL_STACK
+    Sha256MultiLane* lane;
+#else
+    Sha256MultiLane lane[SHA256_MULTI_MAX_LANES];
+#endif
+
+#ifdef WOLFSSL_SMALL_STACK
+    lane = (Sha256MultiLane*)XMALLOC(sizeof(Sha256MultiLane) *
+        SHA256_MULTI_MAX_LANES, heap, DYNAMIC_TYPE_TMP_BUFFER);
+    if (lane == NULL) {
+        return MEMORY_E;
+    }
+#endif
+
+    for (l = 0; l < lanes; l++) {
+        if (next < cnt) {
+            Sha256MultiLaneStart(&lane[l], state, lanes, l, data[next],
+                                 len[next], next);
+            next++;
+            active++;
+        }
+        else {
+            lane[l].idx = cnt;
+        }
+    }
+
+    while ((ret == 0) && (active > 0)) {
+        /* With no messages left to start, hand lanes that are still in the
+         * message body to the single-buffer code once most lanes are idle. */
+        if ((next == cnt) && (active * 4 <= lanes)) {
+            for (l = 0; (ret == 0) && (l < lanes); l++) {
+                if ((lane[l].idx < cnt) &&
+                        (lane[l].padBlocks == lane[l].padTotal)) {
+                    ret = Sha256MultiLaneFinish(&lane[l], state, lanes, l,
+                                                hash[lane[l].idx], heap);
+                    lane[l].idx = cnt;
+                    active--;
+                }
+            }
+            if ((ret != 0) || (active == 0)) {
+                break;
+            }
+        }
+
+        for (l = 0; l < lanes; l++) {
+            if (lane[l].idx >= cnt) {
+                /* Idle lane: any readable block, the state is discarded. */
+                blk[l] = lane[l].pad;
+            }
+            else if (lane[l].blocks > 0) {
+                blk[l] = lane[l].data;
+                lane[l].data += WC_SHA256_BLOCK_SIZE;
+                lane[l].blocks--;
+            }
+            else {
+                blk[l] = lane[l].pad + (lane[l].padTotal -
+                         lane[l].padBlocks) * WC_SHA256_BLOCK_SIZE;
+                lane[l].padBlocks--;
+            }
+        }
+
+        ret = (*transform)(state, blk);
+
+        for (l = 0; (ret == 0) && (l < lanes); l++) {
+            if ((lane[l].idx < cnt) && (lane[l].blocks == 0) &&
+                    (lane[l].padBlocks == 0)) {
+                Sha256MultiLaneDigest(state, lanes, l, hash[lane[l].idx]);
+                if (next < cnt) {
+                    Sha256MultiLaneStart(&lane[l], state, lanes, l,
+                                         data[next], len[next], next);
+                    next++;
+                }
+                else {
+                    lane[l].idx = cnt;
+                    active--;
+                }
+            }
+        }
+    }
+
+    ForceZero(state, sizeof(state));
+    ForceZero(lane, sizeof(Sha256MultiLane) * SHA256_MULTI_MAX_LANES);
+#ifdef WOLFSSL_SMALL_STACK
+    XFREE(lane, heap, DYNAMIC_TYPE_TMP_BUFFER);
+#endif
+
+    return ret;
+}
+#endif /* WOLFSSL_X86_64_BUILD && USE_INTEL_SPEEDUP && HAVE_INTEL_AVX1 */
+
+/* Hash cnt independent messages. Message i is len[i] bytes at data[i] and its
+ * digest is written to hash[i]. On x86_64 without the SHA extensions the
+ * messages are interleaved in 8 (AVX2) or 4 (AVX1) lanes; otherwise they are
+ * hashed one after another.
+ *
+ * Returns 0 on success, BAD_FUNC_ARG when an array or pointer is NULL. */
+int wc_Sha256HashMulti_ex(const byte* const* data, const word32* len,
+    byte* const* hash, word32 cnt, void* heap, int devId)
+{
+    int ret = 0;
+    word32 i;
+#ifdef SHA256_MULTI_SIMD
+    word32 flags;
+#endif
+
+    if ((cnt > 0) && ((data == NULL) || (len == NULL) || (hash == NULL))) {
+        return BAD_FUNC_ARG;
+    }
+    for (i = 0; i < cnt; i++) {
+        if (((data[i] == NULL) && (len[i] > 0)) || (hash[i] == NULL)) {
+            return BAD_FUNC_ARG;
+        }
+    }
+
+#ifdef SHA256_MULTI_SIMD
+    flags = cpuid_get_flags();
+    /* A single SHA-NI stream outruns the SIMD lanes. */
+    if ((cnt > 1) && (devId == INVALID_DEVID)
+    #ifdef HAVE_INTEL_SHA
+            && !IS_INTEL_SHA(flags)
+    #endif
+            ) {
+    #ifdef HAVE_INTEL_AVX2
+        if (IS_INTEL_AVX2(flags)) {
+            return Sha256HashMultiSIMD(data, len, hash, cnt, heap, 8,
+                                       Transform_Sha256_AVX2_x8);
+        }
+    #endif
+        if (IS_INTEL_AVX1(flags)) {
+            return Sha256HashMultiSIMD(data, len, hash, cnt, heap, 4,
+                                       Transform_Sha256_AVX1_x4);
+        }
+    }
+#endif
+
+    for (i = 0; (ret == 0) && (i < cnt); i++) {
+    #ifdef WOLFSSL_SMALL_STACK
+        wc_Sha256* sha256;
+    #else
+        wc_Sha256 sha256[1];
+    #endif
+
+    #ifdef WOLFSSL_SMALL_STACK
+        sha256 = (wc_Sha256*)XMALLOC(sizeof(wc_Sha256), heap,
+            DYNAMIC_TYPE_TMP_BUFFER);
+        if (sha256 == NULL) {
+            return MEMORY_E;
+        }
+    #endif
+        ret = wc_InitSha256_ex(sha256, heap, devId);
+        if (ret == 0) {
+            ret = wc_Sha256Update(sha256, data[i], len[i]);
+            if (ret == 0) {
+                ret = wc_Sha256Final(sha256, hash[i]);
+            }
+            wc_Sha256Free(sha256);
+        }
+    #ifdef WOLFSSL_SMALL_STACK
+        XFREE(sha256, heap, DYNAMIC_TYPE_TMP_BUFFER);
+    #endif
+    }
+
+    return ret;
+}
+
+int wc_Sha256HashMulti(const byte* const* data, const word32* len,
+    byte* const* hash, word32 cnt)
+{
+    return wc_Sha256HashMulti_ex(data, len, hash, cnt, NULL, INVALID_DEVID);
+}
+#endif /* WOLFSSL_SHA256_MULTI */
+
 #endif /* NO_SHA256 */
@@ -1490,4 +1490,206 @@ int wc_Shake256_Copy(wc_Shake* src, wc_Shake* dst)
 }
 #endif
 
+#if defined(WOLFSSL_SHAKE128) || defined(WOLFSSL_SHAKE256)
+/* Permute four interleaved Keccak states.
+ *
+ * With AVX2 the four states are permuted at once, otherwise one at a time.
+ *
+ * s  Four states, word i of state l at s[i * 4 + l].
+ */
+static void BlockSha3x4(word64* s)
+{
+    word64 t[25];
+    int i;
+    int l;
+
+#ifdef USE_INTEL_SPEEDUP
+    if (IS_INTEL_AVX2(cpuid_get_flags())) {
+        kyber_sha3_blocksx4_avx2(s);
+        return;
+    }
+#endif
+
+    for (l = 0; l < 4; l++) {
+        for (i = 0; i < 25; i++) {
+            t[i] = s[i * 4 + l];
+        }
+    #ifdef USE_INTEL_SPEEDUP
+        if (sha3_block != NULL) {
+            (*sha3_block)(t);
+        }
+        else
+    #endif
+        {
+            BlockSha3(t);
+        }
+        for (i = 0; i < 25; i++) {
+            s[i * 4 + l] = t[i];
+        }
+    }
+    ForceZero(t, sizeof(t));
+}
+
+/* Absorb four messages of the same length into four SHAKE states.
+ *
+ * The states are reset first and left ready for squeezing.
+ *
+ * shake  wc_Shakex4 object holding the states.
+ * data   Four messages to absorb.
+ * len    Length of each message in bytes.
+ * p      Number of 64-bit numbers in a block of data to process.
+ * returns 0 on success and BAD_FUNC_ARG when a parameter is NULL.
+ */
+static int Shakex4Absorb(wc_Shakex4* shake, const byte* const* data,
+    word32 len, byte p)
+{
+    word32 rate = p * 8;
+    word32 o = 0;
+    word32 i;
+    int l;
+    byte t[WC_SHA3_128_COUNT * 8];
+
+    if ((shake == NULL) || ((data == NULL) && (len > 0))) {
+        return BAD_FUNC_ARG;
+    }
+    for (l = 0; (len > 0) && (l < 4); l++) {
+        if (data[l] == NULL) {
+            return BAD_FUNC_ARG;
+        }
+    }
+
+    XMEMSET(shake->s, 0, sizeof(shake->s));
+    for (; len - o >= rate; o += rate) {
+        for (l = 0; l < 4; l++) {
+            for (i = 0; i < p; i++) {
+                shake->s[i * 4 + l] ^= Load64Unaligned(data[l] + o + 8 * i);
+            }
+        }
+        BlockSha3x4(shake->s);
+    }
+    for (l = 0; l < 4; l++) {
+        if (len > o) {
+            XMEMCPY(t, data[l] + o, len - o);
+        }
+        t[len - o] = 0x1f;
+        XMEMSET(t + len - o + 1, 0, rate - (len - o + 1));
+        t[rate - 1] |= 0x80;
+        for (i = 0; i < p; i++) {
+            shake->s[i * 4 + l] ^= Load64BitBigEndian(t + 8 * i);
+        }
+    }
+    ForceZero(t, sizeof(t));
+
+    return 0;
+}
+
+/* Squeeze four SHAKE states to produce pseudo-random output.
+ *
+ * shake     wc_Shakex4 object holding the states.
+ * out       Four output buffers.
+ * blockCnt  Number of blocks to write to each buffer.
+ * p         Number of 64-bit numbers in a block of data to output.
+ * returns 0 on success and BAD_FUNC_ARG when a parameter is NULL.
+ */
+static int Shakex4SqueezeBlocks(wc_Shakex4* shake, byte* const* out,
+    word32 blockCnt, byte p)
+{
+    word32 o = 0;
+    word32 i;
+    int l;
+
+    if ((shake == NULL) || ((out == NULL) && (blockCnt > 0))) {
+        return BAD_FUNC_ARG;
+    }
+    for (l = 0; (blockCnt > 0) && (l < 4); l++) {
+        if (out[l] == NULL) {
+            return BAD_FUNC_ARG;
+        }
+    }
+
+    for (; (blockCnt > 0); blockCnt--) {
+        BlockSha3x4(shake->s);
+        for (l = 0; l < 4; l++) {
+            for (i = 0; i < p; i++) {
+                word64 w = shake->s[i * 4 + l];
+            #if defined(BIG_ENDIAN_ORDER)
+                w = ByteReverseWord64(w);
+            #endif
+                XMEMCPY(out[l] + o + 8 * i, &w, sizeof(w));
+            }
+        }
+        o += p * 8;
+    }
+
+    return 0;
+}
+
+/* Dispose of the four SHAKE states.
+ *
+ * shake  wc_Shakex4 object holding the states.
+ */
+void wc_Shakex4_Free(wc_Shakex4* shake)
+{
+    if (shake != NULL) {
+        ForceZero(shake->s, sizeof(shake->s));
+    }
+}
+#endif
+
+#ifdef WOLFSSL_SHAKE128
+/* Absorb four messages into four SHAKE128 states for squeezing.
+ *
+ * shake  wc_Shakex4 object holding the states.
+ * data   Four messages to absorb.
+ * len    Length of each message in bytes.
+ * returns 0 on success.
+ */
+int wc_Shake128x4_Absorb(wc_Shakex4* shake, const byte* const* data,
+    word32 len)
+{
+    return Shakex4Absorb(shake, data, len, WC_SHA3_128_COUNT);
+}
+
+/* Squeeze four SHAKE128 states to produce pseudo-random output.
+ *
+ * shake     wc_Shakex4 object holding the states.
+ * out       Four output buffers.
+ * blockCnt  Number of blocks to write to each buffer.
+ * returns 0 on success.
+ */
+int wc_Shake128x4_SqueezeBlocks(wc_Shakex4* shake, byte* const* out,
+    word32 blockCnt)
+{
+    return Shakex4SqueezeBlocks(shake, out, blockCnt, WC_SHA3_128_COUNT);
+}
+#endif
+
+#ifdef WOLFSSL_SHAKE256
+/* Absorb four messages into four SHAKE256 states for squeezing.
+ *
+ * shake  wc_Shakex4 object holding the states.
+ * data   Four messages to absorb.
+ * len    Length of each message in bytes.
+ * returns 0 on success.
+ */
+int wc_Shake256x4_Absorb(wc_Shakex4* shake, const byte* const* data,
+    word32 len)
+{
+    return Shakex4Absorb(shake, data, len, WC_SHA3_256_COUNT);
+}
+
+/* Squeeze four SHAKE256 states to produce pseudo-random output.
+ *
+ * shake     wc_Shakex4 object holding the states.
+ * out       Four output buffers.
+ * blockCnt  Number of blocks to write to each buffer.
+ * returns 0 on success.
+ */
+int wc_Shake256x4_SqueezeBlocks(wc_Shakex4* shake, byte* const* out,
+    word32 blockCnt)
+{
+    return Shakex4SqueezeBlocks(shake, out, blockCnt, WC_SHA3_256_COUNT);
+}
+#endif
+
 #endif /* WOLFSSL_SHA3 */
@@ -19,8 +19,985 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
  */
 
+/* Implementation of Kyber, the CRYSTALS key encapsulation mechanism, as
+ * submitted to round 3 of the NIST PQC competition.
+ *
+ * H is SHA3-256, G is SHA3-512, the XOF is SHAKE128 and the PRF and KDF are
+ * SHAKE256. The polynomial operations are in wc_kyber_poly.c.
+ */
+
+#ifdef HAVE_CONFIG_H
+    #include <config.h>
+#endif
+
 #include <wolfssl/wolfcrypt/settings.h>
 
-#ifdef WOLFSSL_HAVE_KYBER
-    #error "Contact wolfSSL to get the implementation of this file"
+#ifdef WOLFSSL_WC_KYBER
+
+#include <wolfssl/wolfcrypt/wc_kyber.h>
+#include <wolfssl/wolfcrypt/error-crypt.h>
+#include <wolfssl/wolfcrypt/logging.h>
+
+#ifdef NO_INLINE
+    #include <wolfssl/wolfcrypt/misc.h>
+#else
+    #define WOLFSSL_MISC_INCLUDED
+    #include <wolfcrypt/src/misc.c>
+#endif
+
+/******************************************************************************/
+/* Parameters. */
+
+/**
+ * Get the number of polynomials in a vector for a key type.
+ *
+ * @param  [in]  type  Type of key: KYBER512, KYBER768, KYBER1024.
+ * @return  Dimension of the key type.
+ * @return  0 when the key type is not supported.
+ */
+static int kyber_type_k(int type)
+{
+    int k;
+
+    switch (type) {
+#ifdef WOLFSSL_KYBER512
+    case KYBER512:
+        k = KYBER512_K;
+        break;
+#endif
+#ifdef WOLFSSL_KYBER768
+    case KYBER768:
+        k = KYBER768_K;
+        break;
+#endif
+#ifdef WOLFSSL_KYBER1024
+    case KYBER1024:
+        k = KYBER1024_K;
+        break;
+#endif
+    default:
+        k = 0;
+        break;
+    }
+
+    return k;
+}
+
+/**
+ * Get the size of an encoded public key.
+ *
+ * @param  [in]  k  Number of polynomials in a vector.
+ * @return  Size of public key in bytes.
+ */
+static word32 kyber_pub_size(int k)
+{
+    return (word32)(KYBER_POLY_VEC_SZ(k) + KYBER_SYM_SZ);
+}
+
+/**
+ * Get the size of an encoded private key.
+ *
+ * @param  [in]  k  Number of polynomials in a vector.
+ * @return  Size of private key in bytes.
+ */
+static word32 kyber_priv_size(int k)
+{
+    return (word32)(KYBER_POLY_VEC_SZ(k)) + kyber_pub_size(k) +
+           2 * KYBER_SYM_SZ;
+}
+
+/**
+ * Get the size of the compressed vector of polynomials in a cipher text.
+ *
+ * @param  [in]  k  Number of polynomials in a vector.
+ * @return  Size of compressed vector in bytes.
+ */
+static word32 kyber_ct_vec_size(int k)
+{
+#ifdef WOLFSSL_KYBER1024
+    if (k == KYBER1024_K) {
+        return KYBER1024_POLY_VEC_COMPRESSED_SZ;
+    }
 #endif
+    return (word32)KYBER_POLY_VEC_COMPRESSED_SZ(k, 10);
+}
+
+/**
+ * Get the size of a cipher text.
+ *
+ * @param  [in]  k  Number of polynomials in a vector.
+ * @return  Size of cipher text in bytes.
+ */
+static word32 kyber_ct_size(int k)
+{
+#ifdef WOLFSSL_KYBER1024
+    if (k == KYBER1024_K) {
+        return KYBER1024_CIPHER_TEXT_SIZE;
+    }
+#endif
+    return kyber_ct_vec_size(k) + KYBER_POLY_COMPRESSED_SZ(4);
+}
+
+
+/******************************************************************************/
+/* Symmetric primitives. */
+
+/**
+ * Hash data with H: SHA3-256.
+ *
+ * @param  [in]   key   Kyber key object.
+ * @param  [in]   data  Data to hash.
+ * @param  [in]   len   Length of data in bytes.
+ * @param  [out]  hash  32 byte hash.
+ * @return  0 on success.
+ */
+static int kyber_hash_h(KyberKey* key, const byte* data, word32 len,
+    byte* hash)
+{
+    int ret;
+    wc_Sha3 sha3;
+
+    ret = wc_InitSha3_256(&sha3, key->heap, key->devId);
+    if (ret == 0) {
+        ret = wc_Sha3_256_Update(&sha3, data, len);
+        if (ret == 0) {
+            ret = wc_Sha3_256_Final(&sha3, hash);
+        }
+        wc_Sha3_256_Free(&sha3);
+    }
+
+    return ret;
+}
+
+/**
+ * Hash data with G: SHA3-512.
+ *
+ * @param  [in]   key   Kyber key object.
+ * @param  [in]   data  Data to hash.
+ * @param  [in]   len   Length of data in bytes.
+ * @param  [out]  hash  64 byte hash.
+ * @return  0 on success.
+ */
+static int kyber_hash_g(KyberKey* key, const byte* data, word32 len,
+    byte* hash)
+{
+    int ret;
+    wc_Sha3 sha3;
+
+    ret = wc_InitSha3_512(&sha3, key->heap, key->devId);
+    if (ret == 0) {
+        ret = wc_Sha3_512_Update(&sha3, data, len);
+        if (ret == 0) {
+            ret = wc_Sha3_512_Final(&sha3, hash);
+        }
+        wc_Sha3_512_Free(&sha3);
+    }
+
+    return ret;
+}
+
+/**
+ * Derive the shared secret with the KDF: SHAKE256.
+ *
+ * @param  [in]   key  Kyber key object.
+ * @param  [in]   kr   Pre-key and hash of cipher text: 64 bytes.
+ * @param  [out]  ss   Shared secret.
+ * @return  0 on success.
+ */
+static int kyber_kdf(KyberKey* key, const byte* kr, byte* ss)
+{
+    int ret;
+    wc_Shake shake;
+
+    ret = wc_InitShake256(&shake, key->heap, key->devId);
+    if (ret == 0) {
+        ret = wc_Shake256_Update(&shake, kr, 2 * KYBER_SYM_SZ);
+        if (ret == 0) {
+            ret = wc_Shake256_Final(&shake, ss, KYBER_SS_SZ);
+        }
+        wc_Shake256_Free(&shake);
+    }
+
+    return ret;
+}
+
+
+/******************************************************************************/
+/* Initializer and cleanup functions. */
+
+/**
+ * Initialize the Kyber key.
+ *
+ * @param  [in]   type   Type of key: KYBER512, KYBER768, KYBER1024.
+ * @param  [out]  key    Kyber key object to initialize.
+ * @param  [in]   heap   Dynamic memory hint.
+ * @param  [in]   devId  Device Id.
+ * @return  0 on success.
+ * @return  BAD_FUNC_ARG when key is NULL.
+ * @return  NOT_COMPILED_IN when key type is not supported.
+ */
+int wc_KyberKey_Init(int type, KyberKey* key, void* heap, int devId)
+{
+    int ret = 0;
+
+    /* Validate key. */
+    if (key == NULL) {
+        ret = BAD_FUNC_ARG;
+    }
+    /* Validate type. */
+    if ((ret == 0) && (kyber_type_k(type) == 0)) {
+        ret = NOT_COMPILED_IN;
+    }
+    if (ret == 0) {
+        key->type = type;
+        key->heap = heap;
+        key->devId = devId;
+        /* Nothing stored yet. */
+        key->flags = 0;
+
+        kyber_init();
+    }
+
+    return ret;
+}
+
+/**
+ * Free the Kyber key object.
+ *
+ * @param  [in, out]  key   Kyber key object to dispose of.
+ */
+void wc_KyberKey_Free(KyberKey* key)
+{
+    if (key != NULL) {
+        /* Ensure all private data is zeroed. */
+        ForceZero(key->priv, sizeof(key->priv));
+        ForceZero(key->z, sizeof(key->z));
+        key->flags = 0;
+    }
+}
+
+
+/******************************************************************************/
+/* Data size getters. */
+
+/**
+ * Get the size in bytes of encoded private key for the key.
+ *
+ * @param  [in]   key  Kyber key object.
+ * @param  [out]  len  Length of encoded private key in bytes.
+ * @return  0 on success.
+ * @return  BAD_FUNC_ARG when key or len is NULL.
+ * @return  NOT_COMPILED_IN when key type is not supported.
+ */
+int wc_KyberKey_PrivateKeySize(KyberKey* key, word32* len)
+{
+    int ret = 0;
+    int k = 0;
+
+    /* Validate parameters. */
+    if ((key == NULL) || (len == NULL)) {
+        ret = BAD_FUNC_ARG;
+    }
+    if ((ret == 0) && ((k = kyber_type_k(key->type)) == 0)) {
+        ret = NOT_COMPILED_IN;
+    }
+    if (ret == 0) {
+        *len = kyber_priv_size(k);
+    }
+
+    return ret;
+}
+
+/**
+ * Get the size in bytes of encoded public key for the key.
+ *
+ * @param  [in]   key  Kyber key object.
+ * @param  [out]  len  Length of encoded public key in bytes.
+ * @return  0 on success.
+ * @return  BAD_FUNC_ARG when key or len is NULL.
+ * @return  NOT_COMPILED_IN when key type is not supported.
+ */
+int wc_KyberKey_PublicKeySize(KyberKey* key, word32* len)
+{
+    int ret = 0;
+    int k = 0;
+
+    /* Validate parameters. */
+    if ((key == NULL) || (len == NULL)) {
+        ret = BAD_FUNC_ARG;
+    }
+    if ((ret == 0) && ((k = kyber_type_k(key->type)) == 0)) {
+        ret = NOT_COMPILED_IN;
+    }
+    if (ret == 0) {
+        *len = kyber_pub_size(k);
+    }
+
+    return ret;
+}
+
+/**
+ * Get the size in bytes of cipher text for key.
+ *
+ * @param  [in]   key  Kyber key object.
+ * @param  [out]  len  Length of cipher text in bytes.
+ * @return  0 on success.
+ * @return  BAD_FUNC_ARG when key or len is NULL.
+ * @return  NOT_COMPILED_IN when key type is not supported.
+ */
+int wc_KyberKey_CipherTextSize(KyberKey* key, word32* len)
+{
+    int ret = 0;
+    int k = 0;
+
+    /* Validate parameters. */
+    if ((key == NULL) || (len == NULL)) {
+        ret = BAD_FUNC_ARG;
+    }
+    if ((ret == 0) && ((k = kyber_type_k(key->type)) == 0)) {
+        ret = NOT_COMPILED_IN;
+    }
+    if (ret == 0) {
+        *len = kyber_ct_size(k);
+    }
+
+    return ret;
+}
+
+/**
+ * Size of a shared secret in bytes. Always KYBER_SS_SZ.
+ *
+ * @param  [in]   key  Kyber key object. Not used.
+ * @param  [out]  len  Size of the shared secret created with a Kyber key.
+ * @return  0 on success.
+ * @return  BAD_FUNC_ARG when len is NULL.
+ */
+int wc_KyberKey_SharedSecretSize(KyberKey* key, word32* len)
+{
+    (void)key;
+    /* Validate parameters. */
+    if (len == NULL) {
+        return BAD_FUNC_ARG;
+    }
+
+    *len = KYBER_SS_SZ;
+
+    return 0;
+}
+
+
+/******************************************************************************/
+/* Encoding helpers. */
+
+/**
+ * Encode the public key: polynomials then public seed.
+ *
+ * @param  [in]   key  Kyber key object.
+ * @param  [out]  out  Buffer to hold encoded public key.
+ * @param  [in]   k    Number of polynomials in a vector.
+ */
+static void kyber_encode_pub(KyberKey* key, byte* out, int k)
+{
+    kyber_to_bytes(out, key->pub, k);
+    XMEMCPY(out + KYBER_POLY_VEC_SZ(k), key->pubSeed, KYBER_SYM_SZ);
+}
+
+/**
+ * Calculate the hash of the encoded public key when not already known.
+ *
+ * @param  [in, out]  key  Kyber key object.
+ * @param  [in]       k    Number of polynomials in a vector.
+ * @return  0 on success.
+ */
+static int kyber_pub_hash(KyberKey* key, int k)
+{
+    int ret = 0;
+
+    if ((key->flags & KYBER_FLAG_H_SET) == 0) {
+        byte pub[KYBER_MAX_PUBLIC_KEY_SIZE];
+
+        kyber_encode_pub(key, pub, k);
+        ret = kyber_hash_h(key, pub, kyber_pub_size(k), key->h);
+        if (ret == 0) {
+            key->flags |= KYBER_FLAG_H_SET;
+        }
+    }
+
+    return ret;
+}
+
+
+/******************************************************************************/
+/* Cryptographic operations. */
+
+/**
+ * Make a Kyber key object using a random number generator.
+ *
+ * @param  [in, out]  key   Kyber key object.
+ * @param  [in]       rng   Random number generator.
+ * @return  0 on success.
+ * @return  BAD_FUNC_ARG when key or rng is NULL.
+ * @return  NOT_COMPILED_IN when key type is not supported.
+ * @return  MEMORY_E when dynamic memory allocation failed.
+ */
+int wc_KyberKey_MakeKey(KyberKey* key, WC_RNG* rng)
+{
+    int ret = 0;
+    unsigned char rand[KYBER_MAKEKEY_RAND_SZ];
+
+    /* Validate parameters. */
+    if ((key == NULL) || (rng == NULL)) {
+        ret = BAD_FUNC_ARG;
+    }
+
+    if (ret == 0) {
+        /* Generate random to use with PRFs: d and z. */
+        ret = wc_RNG_GenerateBlock(rng, rand, sizeof(rand));
+    }
+    if (ret == 0) {
+        ret = wc_KyberKey_MakeKeyWithRandom(key, rand, sizeof(rand));
+    }
+
+    /* Ensure seeds are zeroized. */
+    ForceZero(rand, sizeof(rand));
+
+    return ret;
+}
+
+/**
+ * Make a Kyber key object using random data.
+ *
+ * rand is d || z: d seeds the matrix and noise and z is used for implicit
+ * rejection.
+ *
+ * @param  [in, out]  key   Kyber key object.
+ * @param  [in]       rand  Random data.
+ * @param  [in]       len   Length of random data in bytes.
+ * @return  0 on success.
+ * @return  BAD_FUNC_ARG when key or rand is NULL.
+ * @return  BUFFER_E when length is not KYBER_MAKEKEY_RAND_SZ.
+ * @return  NOT_COMPILED_IN when key type is not supported.
+ * @return  MEMORY_E when dynamic memory allocation failed.
+ */
+int wc_KyberKey_MakeKeyWithRandom(KyberKey* key, const unsigned char* rand,
+    int len)
+{
+    int ret = 0;
+    int k = 0;
+    byte buf[2 * KYBER_SYM_SZ];
+    sword16* a = NULL;
+    sword16* e = NULL;
+    word32 sz = 0;
+
+    /* Validate parameters. */
+    if ((key == NULL) || (rand == NULL)) {
+        ret = BAD_FUNC_ARG;
+    }
+    if ((ret == 0) && (len != KYBER_MAKEKEY_RAND_SZ)) {
+        ret = BUFFER_E;
+    }
+    if ((ret == 0) && ((k = kyber_type_k(key->type)) == 0)) {
+        ret = NOT_COMPILED_IN;
+    }
+
+    if (ret == 0) {
+        /* Matrix A and error vector e. */
+        sz = (word32)((k * k + k) * KYBER_N * (int)sizeof(sword16));
+        a = (sword16*)XMALLOC(sz, key->heap, DYNAMIC_TYPE_TMP_BUFFER);
+        if (a == NULL) {
+            ret = MEMORY_E;
+        }
+    }
+    if (ret == 0) {
+        e = a + k * k * KYBER_N;
+
+        /* Public seed rho and noise seed sigma from G(d). */
+        ret = kyber_hash_g(key, rand, KYBER_SYM_SZ, buf);
+    }
+    if (ret == 0) {
+        XMEMCPY(key->pubSeed, buf, KYBER_SYM_SZ);
+        XMEMCPY(key->z, rand + KYBER_SYM_SZ, KYBER_SYM_SZ);
+
+        ret = kyber_gen_matrix(a, k, key->pubSeed, 0, key->heap,
+            key->devId);
+    }
+    if (ret == 0) {
+        ret = kyber_get_noise(k, key->priv, e, NULL, buf + KYBER_SYM_SZ,
+            key->heap, key->devId);
+    }
+    if (ret == 0) {
+        kyber_keygen(key->priv, key->pub, e, a, k);
+        key->flags = KYBER_FLAG_BOTH_SET;
+    }
+
+    if (a != NULL) {
+        ForceZero(a, sz);
+        XFREE(a, key->heap, DYNAMIC_TYPE_TMP_BUFFER);
+    }
+    ForceZero(buf, sizeof(buf));
+
+    return ret;
+}
+
+/**
+ * Encrypt a message with the public key.
+ *
+ * @param  [in]   key    Kyber key object.
+ * @param  [out]  ct     Cipher text.
+ * @param  [in]   m      Message: 32 bytes.
+ * @param  [in]   coins  Seed for noise: 32 bytes.
+ * @param  [in]   k      Number of polynomials in a vector.
+ * @return  0 on success.
+ * @return  MEMORY_E when dynamic memory allocation failed.
+ */
+static int kyber_encrypt(KyberKey* key, byte* ct, const byte* m,
+    const byte* coins, int k)
+{
+    int ret = 0;
+    sword16* at;
+    sword16* sp;
+    sword16* ep;
+    sword16* bp;
+    sword16* epp;
+    sword16* v;
+    sword16* mp;
+    word32 sz = (word32)((k * k + 3 * k + 3) * KYBER_N *
+                         (int)sizeof(sword16));
+
+    at = (sword16*)XMALLOC(sz, key->heap, DYNAMIC_TYPE_TMP_BUFFER);
+    if (at == NULL) {
+        ret = MEMORY_E;
+    }
+    if (ret == 0) {
+        sp  = at + k * k * KYBER_N;
+        ep  = sp + k * KYBER_N;
+        bp  = ep + k * KYBER_N;
+        epp = bp + k * KYBER_N;
+        v   = epp + KYBER_N;
+        mp  = v + KYBER_N;
+
+        ret = kyber_gen_matrix(at, k, key->pubSeed, 1, key->heap,
+            key->devId);
+        if (ret == 0) {
+            ret = kyber_get_noise(k, sp, ep, epp, coins, key->heap,
+                key->devId);
+        }
+        if (ret == 0) {
+            kyber_from_msg(mp, m);
+            kyber_encapsulate(key->pub, bp, v, at, sp, ep, epp, mp, k);
+
+        #ifdef WOLFSSL_KYBER1024
+            if (k == KYBER1024_K) {
+                kyber_vec_compress_11(ct, bp);
+                kyber_compress_5(ct + kyber_ct_vec_size(k), v);
+            }
+            else
+        #endif
+            {
+            #if defined(WOLFSSL_KYBER512) || defined(WOLFSSL_KYBER768)
+                kyber_vec_compress_10(ct, bp, (unsigned int)k);
+                kyber_compress_4(ct + kyber_ct_vec_size(k), v);
+            #endif
+            }
+        }
+
+        ForceZero(at, sz);
+        XFREE(at, key->heap, DYNAMIC_TYPE_TMP_BUFFER);
+    }
+
+    return ret;
+}
+
+/**
+ * Encapsulate with random number generator and derive secret.
+ *
+ * @param  [in]   key  Kyber key object.
+ * @param  [out]  ct   Cipher text.
+ * @param  [out]  ss   Shared secret generated.
+ * @param  [in]   rng  Random number generator.
+ * @return  0 on success.
+ * @return  BAD_FUNC_ARG when key, ct, ss or RNG is NULL.
+ * @return  BAD_STATE_E when the public key is not set.
+ * @return  NOT_COMPILED_IN when key type is not supported.
+ * @return  MEMORY_E when dynamic memory allocation failed.
+ */
+int wc_KyberKey_Encapsulate(KyberKey* key, unsigned char* ct, unsigned char* ss,
+    WC_RNG* rng)
+{
+    int ret = 0;
+    unsigned char rand[KYBER_ENC_RAND_SZ];
+
+    /* Validate parameters. */
+    if ((key == NULL) || (ct == NULL) || (ss == NULL) || (rng == NULL)) {
+        ret = BAD_FUNC_ARG;
+    }
+
+    if (ret == 0) {
+        /* Generate seed for use with PRFs. */
+        ret = wc_RNG_GenerateBlock(rng, rand, sizeof(rand));
+    }
+    if (ret == 0) {
+        ret = wc_KyberKey_EncapsulateWithRandom(key, ct, ss, rand,
+            sizeof(rand));
+    }
+
+    ForceZero(rand, sizeof(rand));
+
+    return ret;
+}
+
+/**
+ * Encapsulate with random data and derive secret.
+ *
+ * @param  [in]   key   Kyber key object.
+ * @param  [out]  ct    Cipher text.
+ * @param  [out]  ss    Shared secret generated.
+ * @param  [in]   rand  Random data.
+ * @param  [in]   len   Length of random data in bytes.
+ * @return  0 on success.
+ * @return  BAD_FUNC_ARG when key, ct, ss or rand is NULL.
+ * @return  BUFFER_E when len is not KYBER_ENC_RAND_SZ.
+ * @return  BAD_STATE_E when the public key is not set.
+ * @return  NOT_COMPILED_IN when key type is not supported.
+ * @return  MEMORY_E when dynamic memory allocation failed.
+ */
+int wc_KyberKey_EncapsulateWithRandom(KyberKey* key, unsigned char* ct,
+    unsigned char* ss, const unsigned char* rand, int len)
+{
+    int ret = 0;
+    int k = 0;
+    byte msg[2 * KYBER_SYM_SZ];
+    byte kr[2 * KYBER_SYM_SZ];
+
+    /* Validate parameters. */
+    if ((key == NULL) || (ct == NULL) || (ss == NULL) || (rand == NULL)) {
+        ret = BAD_FUNC_ARG;
+    }
+    if ((ret == 0) && (len != KYBER_ENC_RAND_SZ)) {
+        ret = BUFFER_E;
+    }
+    if ((ret == 0) && ((k = kyber_type_k(key->type)) == 0)) {
+        ret = NOT_COMPILED_IN;
+    }
+    if ((ret == 0) && ((key->flags & KYBER_FLAG_PUB_SET) == 0)) {
+        ret = BAD_STATE_E;
+    }
+
+    if (ret == 0) {
+        /* Don't send the output of the system RNG: m = H(rand). */
+        ret = kyber_hash_h(key, rand, KYBER_SYM_SZ, msg);
+    }
+    if (ret == 0) {
+        ret = kyber_pub_hash(key, k);
+    }
+    if (ret == 0) {
+        /* Pre-key and coins: G(m || H(pk)). */
+        XMEMCPY(msg + KYBER_SYM_SZ, key->h, KYBER_SYM_SZ);
+        ret = kyber_hash_g(key, msg, sizeof(msg), kr);
+    }
+    if (ret == 0) {
+        ret = kyber_encrypt(key, ct, msg, kr + KYBER_SYM_SZ, k);
+    }
+    if (ret == 0) {
+        /* Replace coins with hash of cipher text and derive secret. */
+        ret = kyber_hash_h(key, ct, kyber_ct_size(k), kr + KYBER_SYM_SZ);
+    }
+    if (ret == 0) {
+        ret = kyber_kdf(key, kr, ss);
+    }
+
+    ForceZero(msg, sizeof(msg));
+    ForceZero(kr, sizeof(kr));
+
+    return ret;
+}
+
+/**
+ * Decapsulate the cipher text to calculate the shared secret.
+ *
+ * Implicit rejection: when the cipher text does not re-encrypt to the same
+ * value, the secret is derived from z instead of the pre-key.
+ *
+ * @param  [in]   key  Kyber key object.
+ * @param  [out]  ss   Shared secret.
+ * @param  [in]   ct   Cipher text.
+ * @param  [in]   len  Length of cipher text.
+ * @return  0 on success.
+ * @return  BAD_FUNC_ARG when key, ss or ct are NULL.
+ * @return  NOT_COMPILED_IN when key type is not supported.
+ * @return  BUFFER_E when len is not the length of cipher text for the key type.
+ * @return  BAD_STATE_E when the private key is not set.
+ * @return  MEMORY_E when dynamic memory allocation failed.
+ */
+int wc_KyberKey_Decapsulate(KyberKey* key, unsigned char* ss,
+    const unsigned char* ct, word32 len)
+{
+    int ret = 0;
+    int k = 0;
+    int i;
+    byte mask;
+    byte msg[2 * KYBER_SYM_SZ];
+    byte kr[2 * KYBER_SYM_SZ];
+    byte cmp[KYBER_MAX_CIPHER_TEXT_SIZE];
+    sword16* bp = NULL;
+    sword16* v = NULL;
+    sword16* mp = NULL;
+    word32 sz = 0;
+
+    /* Validate parameters. */
+    if ((key == NULL) || (ss == NULL) || (ct == NULL)) {
+        ret = BAD_FUNC_ARG;
+    }
+    if ((ret == 0) && ((k = kyber_type_k(key->type)) == 0)) {
+        ret = NOT_COMPILED_IN;
+    }
+    if ((ret == 0) && (len != kyber_ct_size(k))) {
+        ret = BUFFER_E;
+    }
+    if ((ret == 0) && ((key->flags & KYBER_FLAG_BOTH_SET) !=
+                       KYBER_FLAG_BOTH_SET)) {
+        ret = BAD_STATE_E;
+    }
+
+    if (ret == 0) {
+        sz = (word32)((k + 2) * KYBER_N * (int)sizeof(sword16));
+        bp = (sword16*)XMALLOC(sz, key->heap, DYNAMIC_TYPE_TMP_BUFFER);
+        if (bp == NULL) {
+            ret = MEMORY_E;
+        }
+    }
+    if (ret == 0) {
+        v = bp + k * KYBER_N;
+        mp = v + KYBER_N;
+
+    #ifdef WOLFSSL_KYBER1024
+        if (k == KYBER1024_K) {
+            kyber_vec_decompress_11(bp, ct);
+            kyber_decompress_5(v, ct + kyber_ct_vec_size(k));
+        }
+        else
+    #endif
+        {
+        #if defined(WOLFSSL_KYBER512) || defined(WOLFSSL_KYBER768)
+            kyber_vec_decompress_10(bp, ct, (unsigned int)k);
+            kyber_decompress_4(v, ct + kyber_ct_vec_size(k));
+        #endif
+        }
+        kyber_decapsulate(key->priv, mp, bp, v, k);
+        kyber_to_msg(msg, mp);
+
+        ret = kyber_pub_hash(key, k);
+    }
+    if (ret == 0) {
+        /* Pre-key and coins: G(m' || H(pk)). */
+        XMEMCPY(msg + KYBER_SYM_SZ, key->h, KYBER_SYM_SZ);
+        ret = kyber_hash_g(key, msg, sizeof(msg), kr);
+    }
+    if (ret == 0) {
+        /* Re-encrypt to check the cipher text. */
+        ret = kyber_encrypt(key, cmp, msg, kr + KYBER_SYM_SZ, k);
+    }
+    if (ret == 0) {
+        mask = (byte)kyber_cmp(ct, cmp, (int)len);
+
+        ret = kyber_hash_h(key, ct, len, kr + KYBER_SYM_SZ);
+        if (ret == 0) {
+            /* Use z when the cipher text is invalid. */
+            for (i = 0; i < KYBER_SYM_SZ; i++) {
+                kr[i] ^= (byte)(mask & (kr[i] ^ key->z[i]));
+            }
+            ret = kyber_kdf(key, kr, ss);
+        }
+    }
+
+    if (bp != NULL) {
+        ForceZero(bp, sz);
+        XFREE(bp, key->heap, DYNAMIC_TYPE_TMP_BUFFER);
+    }
+    ForceZero(msg, sizeof(msg));
+    ForceZero(kr, sizeof(kr));
+
+    return ret;
+}
+
+
+/******************************************************************************/
+/* Encoding and decoding functions. */
+
+/**
+ * Decode the private key.
+ *
+ * Private key format: s || pk || H(pk) || z
+ *
+ * @param  [in, out]  key  Kyber key object.
+ * @param  [in]       in   Buffer holding encoded key.
+ * @param  [in]       len  Length of data in buffer.
+ * @return  0 on success.
+ * @return  BAD_FUNC_ARG when key or in is NULL.
+ * @return  NOT_COMPILED_IN when key type is not supported.
+ * @return  BUFFER_E when len is not the correct size.
+ */
+int wc_KyberKey_DecodePrivateKey(KyberKey* key, unsigned char* in, word32 len)
+{
+    int ret = 0;
+    int k = 0;
+
+    /* Validate parameters. */
+    if ((key == NULL) || (in == NULL)) {
+        ret = BAD_FUNC_ARG;
+    }
+    if ((ret == 0) && ((k = kyber_type_k(key->type)) == 0)) {
+        ret = NOT_COMPILED_IN;
+    }
+    if ((ret == 0) && (len != kyber_priv_size(k))) {
+        ret = BUFFER_E;
+    }
+
+    if (ret == 0) {
+        kyber_from_bytes(key->priv, in, k);
+        in += KYBER_POLY_VEC_SZ(k);
+        kyber_from_bytes(key->pub, in, k);
+        in += KYBER_POLY_VEC_SZ(k);
+        XMEMCPY(key->pubSeed, in, KYBER_SYM_SZ);
+        in += KYBER_SYM_SZ;
+        XMEMCPY(key->h, in, KYBER_SYM_SZ);
+        in += KYBER_SYM_SZ;
+        XMEMCPY(key->z, in, KYBER_SYM_SZ);
+
+        key->flags = KYBER_FLAG_BOTH_SET | KYBER_FLAG_H_SET;
+    }
+
+    return ret;
+}
+
+/**
+ * Decode public key.
+ *
+ * Public key format: t || rho
+ *
+ * @param  [in, out]  key  Kyber key object.
+ * @param  [in]       in   Buffer holding encoded key.
+ * @param  [in]       len  Length of data in buffer.
+ * @return  0 on success.
+ * @return  BAD_FUNC_ARG when key or in is NULL.
+ * @return  NOT_COMPILED_IN when key type is not supported.
+ * @return  BUFFER_E when len is not the correct size.
+ */
+int wc_KyberKey_DecodePublicKey(KyberKey* key, unsigned char* in, word32 len)
+{
+    int ret = 0;
+    int k = 0;
+
+    /* Validate parameters. */
+    if ((key == NULL) || (in == NULL)) {
+        ret = BAD_FUNC_ARG;
+    }
+    if ((ret == 0) && ((k = kyber_type_k(key->type)) == 0)) {
+        ret = NOT_COMPILED_IN;
+    }
+    if ((ret == 0) && (len != kyber_pub_size(k))) {
+        ret = BUFFER_E;
+    }
+
+    if (ret == 0) {
+        kyber_from_bytes(key->pub, in, k);
+        XMEMCPY(key->pubSeed, in + KYBER_POLY_VEC_SZ(k), KYBER_SYM_SZ);
+
+        /* Hash of public key calculated when needed. */
+        key->flags = (key->flags & KYBER_FLAG_PRIV_SET) | KYBER_FLAG_PUB_SET;
+    }
+
+    return ret;
+}
+
+/**
+ * Encode the private key.
+ *
+ * Private key format: s || pk || H(pk) || z
+ *
+ * @param  [in]   key  Kyber key object.
+ * @param  [out]  out  Buffer to hold data.
+ * @param  [in]   len  Size of buffer in bytes.
+ * @return  0 on success.
+ * @return  BAD_FUNC_ARG when key or out is NULL.
+ * @return  BAD_STATE_E when the private or public key is not set.
+ * @return  NOT_COMPILED_IN when key type is not supported.
+ * @return  BUFFER_E when len is not the correct size.
+ */
+int wc_KyberKey_EncodePrivateKey(KyberKey* key, unsigned char* out, word32 len)
+{
+    int ret = 0;
+    int k = 0;
+
+    /* Validate parameters. */
+    if ((key == NULL) || (out == NULL)) {
+        ret = BAD_FUNC_ARG;
+    }
+    if ((ret == 0) && ((k = kyber_type_k(key->type)) == 0)) {
+        ret = NOT_COMPILED_IN;
+    }
+    if ((ret == 0) && (len != kyber_priv_size(k))) {
+        ret = BUFFER_E;
+    }
+    if ((ret == 0) && ((key->flags & KYBER_FLAG_BOTH_SET) !=
+                       KYBER_FLAG_BOTH_SET)) {
+        ret = BAD_STATE_E;
+    }
+
+    if (ret == 0) {
+        ret = kyber_pub_hash(key, k);
+    }
+    if (ret == 0) {
+        kyber_to_bytes(out, key->priv, k);
+        out += KYBER_POLY_VEC_SZ(k);
+        kyber_encode_pub(key, out, k);
+        out += kyber_pub_size(k);
+        XMEMCPY(out, key->h, KYBER_SYM_SZ);
+        out += KYBER_SYM_SZ;
+        XMEMCPY(out, key->z, KYBER_SYM_SZ);
+    }
+
+    return ret;
+}
+
+/**
+ * Encode the public key.
+ *
+ * Public key format: t || rho
+ *
+ * @param  [in]   key  Kyber key object.
+ * @param  [out]  out  Buffer to hold data.
+ * @param  [in]   len  Size of buffer in bytes.
+ * @return  0 on success.
+ * @return  BAD_FUNC_ARG when key or out is NULL.
+ * @return  BAD_STATE_E when the public key is not set.
+ * @return  NOT_COMPILED_IN when key type is not supported.
+ * @return  BUFFER_E when len is not the correct size.
+ */
+int wc_KyberKey_EncodePublicKey(KyberKey* key, unsigned char* out, word32 len)
+{
+    int ret = 0;
+    int k = 0;
+
+    /* Validate parameters. */
+    if ((key == NULL) || (out == NULL)) {
+        ret = BAD_FUNC_ARG;
+    }
+    if ((ret == 0) && ((k = kyber_type_k(key->type)) == 0)) {
+        ret = NOT_COMPILED_IN;
+    }
+    if ((ret == 0) && (len != kyber_pub_size(k))) {
+        ret = BUFFER_E;
+    }
+    if ((ret == 0) && ((key->flags & KYBER_FLAG_PUB_SET) == 0)) {
+        ret = BAD_STATE_E;
+    }
+
+    if (ret == 0) {
+        kyber_encode_pub(key, out, k);
+    }
+
+    return ret;
+}
+
+#endif /* WOLFSSL_WC_KYBER */
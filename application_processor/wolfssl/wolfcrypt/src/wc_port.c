@@ -32,6 +32,9 @@
 #ifdef HAVE_ECC
     #include <wolfssl/wolfcrypt/ecc.h>
 #endif
+#if !defined(NO_DH) && defined(WOLFSSL_DH_COMB)
+    #include <wolfssl/wolfcrypt/dh.h>
+#endif
 #ifdef WOLFSSL_ASYNC_CRYPT
     #include <wolfssl/wolfcrypt/async.h>
 #endif
@@ -342,6 +345,9 @@ int wolfCrypt_Init(void)
         }
     #endif
 #endif
+#if !defined(NO_DH) && defined(WOLFSSL_DH_COMB)
+        wc_DhCombInit();
+#endif
 
 #ifdef WOLFSSL_SCE
         ret = (int)WOLFSSL_SCE_GSCE_HANDLE.p_api->open(
@@ -427,6 +433,9 @@ int wolfCrypt_Cleanup(void)
         wc_ecc_curve_cache_free();
     #endif
 #endif /* HAVE_ECC */
+#if !defined(NO_DH) && defined(WOLFSSL_DH_COMB)
+        wc_DhCombFree();
+#endif
 
     #if defined(OPENSSL_EXTRA) || defined(DEBUG_WOLFSSL_VERBOSE)
         ret = wc_LoggingCleanup();
@@ -1190,6 +1199,23 @@ int wolfSSL_Atomic_Int_FetchSub(wolfSSL_Atomic_Int* c, int i)
 {
     return __atomic_fetch_sub(c, i, __ATOMIC_RELAXED);
 }
+
+int wolfSSL_Atomic_Int_Load(wolfSSL_Atomic_Int* c)
+{
+    return __atomic_load_n(c, __ATOMIC_ACQUIRE);
+}
+
+void wolfSSL_Atomic_Int_Store(wolfSSL_Atomic_Int* c, int i)
+{
+    __atomic_store_n(c, i, __ATOMIC_RELEASE);
+}
+
+int wolfSSL_Atomic_Int_CompareExchange(wolfSSL_Atomic_Int* c, int* expected,
+    int i)
+{
+    return __atomic_compare_exchange_n(c, expected, i, 0, __ATOMIC_ACQ_REL,
+        __ATOMIC_ACQUIRE);
+}
 #else
 /* Default C Implementation */
 void wolfSSL_Atomic_Int_Init(wolfSSL_Atomic_Int* c, int i)
@@ -1206,6 +1232,23 @@ int wolfSSL_Atomic_Int_FetchSub(wolfSSL_Atomic_Int* c, int i)
 {
     return atomic_fetch_sub_explicit(c, i, memory_order_relaxed);
 }
+
+int wolfSSL_Atomic_Int_Load(wolfSSL_Atomic_Int* c)
+{
+    return atomic_load_explicit(c, memory_order_acquire);
+}
+
+void wolfSSL_Atomic_Int_Store(wolfSSL_Atomic_Int* c, int i)
+{
+    atomic_store_explicit(c, i, memory_order_release);
+}
+
+int wolfSSL_Atomic_Int_CompareExchange(wolfSSL_Atomic_Int* c, int* expected,
+    int i)
+{
+    return atomic_compare_exchange_strong_explicit(c, expected, i,
+        memory_order_acq_rel, memory_order_acquire);
+}
 #endif /* __cplusplus */
 
 #elif defined(_MSC_VER)
@@ -1226,6 +1269,27 @@ int wolfSSL_Atomic_Int_FetchSub(wolfSSL_Atomic_Int* c, int i)
     return (int)_InterlockedExchangeAdd(c, (long)-i);
 }
 
+int wolfSSL_Atomic_Int_Load(wolfSSL_Atomic_Int* c)
+{
+    return (int)_InterlockedCompareExchange(c, 0, 0);
+}
+
+void wolfSSL_Atomic_Int_Store(wolfSSL_Atomic_Int* c, int i)
+{
+    (void)_InterlockedExchange(c, (long)i);
+}
+
+int wolfSSL_Atomic_Int_CompareExchange(wolfSSL_Atomic_Int* c, int* expected,
+    int i)
+{
+    long prev = _InterlockedCompareExchange(c, (long)i, (long)*expected);
+    if (prev == (long)*expected) {
+        return 1;
+    }
+    *expected = (int)prev;
+    return 0;
+}
+
 #endif
 
 #endif /* WOLFSSL_ATOMIC_OPS */
@@ -37,6 +37,10 @@ block cipher mechanism that uses n-bit binary string parameter key with 128-bits
 #include <wolfssl/wolfcrypt/types.h>
 
 #if !defined(NO_AES) || defined(WOLFSSL_SM4)
+#if defined(GCM_CTMUL64) && !defined(WORD64_AVAILABLE)
+    #error "GCM_CTMUL64 requires a 64-bit word type"
+#endif
+
 typedef struct Gcm {
     ALIGN16 byte H[16];
 #ifdef OPENSSL_EXTRA
@@ -52,6 +56,9 @@ typedef struct Gcm {
     #else
         ALIGN16 byte M0[32][16];
     #endif
+#elif defined(GCM_CTMUL64)
+    /* H^1..H^4 as words with bit-reversed forms for constant-time multiply. */
+    ALIGN16 word64 M0[4][6];
 #endif /* GCM_TABLE */
 } Gcm;
 
@@ -216,10 +223,20 @@ enum {
 
     /* Number of bits to a block. */
     #define AES_BLOCK_BITS      (AES_BLOCK_SIZE * 8)
+#ifndef WC_AES_BITSLICED_NARROW
     /* Number of bytes of input that can be processed in one call. */
     #define BS_BLOCK_SIZE       (AES_BLOCK_SIZE * BS_WORD_SIZE)
     /* Number of words in a block.  */
     #define BS_BLOCK_WORDS      (AES_BLOCK_BITS / BS_WORD_SIZE)
+#else
+    /* Number of bytes of input that can be processed in one call.
+     * Eight words hold one bit of each byte: 2 blocks in 32-bit words and
+     * 4 blocks in 64-bit words. */
+    #define BS_BLOCK_SIZE       (AES_BLOCK_SIZE * BS_WORD_SIZE / 16)
+    #if BS_WORD_SIZE != 64 && BS_WORD_SIZE != 32
+        #error "Narrow bit-slicing only supports 32 and 64-bit words"
+    #endif
+#endif
 
     #if BS_WORD_SIZE == 64
         typedef word64          bs_word;
@@ -245,8 +262,13 @@ enum {
 struct Aes {
     ALIGN16 word32 key[60];
 #ifdef WC_AES_BITSLICED
+#ifndef WC_AES_BITSLICED_NARROW
     /* Extra key schedule space required for bit-slicing technique. */
     ALIGN16 bs_word bs_key[15 * AES_BLOCK_SIZE * BS_WORD_SIZE];
+#else
+    /* Bit-sliced round keys - eight words for each of up to 15 rounds. */
+    ALIGN16 bs_word bs_key[15 * 8];
+#endif
 #endif
     word32  rounds;
 #ifdef WC_AES_C_DYNAMIC_FALLBACK
@@ -396,7 +418,24 @@ struct Aes {
 typedef struct XtsAes {
     Aes aes;
     Aes tweak;
+#if defined(WOLFSSL_AESXTS_THREADS) && !defined(SINGLE_THREADED)
+    word32 threads;    /* threads to split consecutive sectors across */
+#endif
 } XtsAes;
+
+#if defined(WOLFSSL_AESXTS_THREADS) && !defined(SINGLE_THREADED)
+/* Callbacks for wc_AesXtsEncryptPipelined and wc_AesXtsDecryptPipelined.
+ *
+ * The read callback runs on a helper thread at the same time as the write
+ * callback runs on the calling thread, with the same ctx. Any state in ctx
+ * that both use must be safe to access from two threads at once. */
+/* Read up to sz bytes into buf. Returns the number of bytes read, 0 at the
+ * end of the data or a negative error code. Fewer than sz bytes may be
+ * returned; it is called again for the rest. */
+typedef int (*wc_AesXtsReadCb)(void* ctx, byte* buf, word32 sz);
+/* Write sz bytes from buf. Returns 0 on success or a negative error code. */
+typedef int (*wc_AesXtsWriteCb)(void* ctx, const byte* buf, word32 sz);
+#endif
 #endif
 
 #if (!defined(WC_AESFREE_IS_MANDATORY)) &&                              \
@@ -648,6 +687,18 @@ WOLFSSL_API int wc_AesXtsDecryptConsecutiveSectors(XtsAes* aes,
         byte* out, const byte* in, word32 sz, word64 sector,
         word32 sectorSz);
 
+#if defined(WOLFSSL_AESXTS_THREADS) && !defined(SINGLE_THREADED)
+WOLFSSL_API int wc_AesXtsSetThreads(XtsAes* aes, word32 threads);
+
+WOLFSSL_API int wc_AesXtsEncryptPipelined(XtsAes* aes, byte* buf,
+        word32 bufSz, word64 sector, word32 sectorSz,
+        wc_AesXtsReadCb readCb, wc_AesXtsWriteCb writeCb, void* ctx);
+
+WOLFSSL_API int wc_AesXtsDecryptPipelined(XtsAes* aes, byte* buf,
+        word32 bufSz, word64 sector, word32 sectorSz,
+        wc_AesXtsReadCb readCb, wc_AesXtsWriteCb writeCb, void* ctx);
+#endif
+
 WOLFSSL_API int wc_AesXtsFree(XtsAes* aes);
 #endif
 
@@ -0,0 +1,87 @@
+/* blake3.h
+ *
+ * Copyright (C) 2006-2023 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL.
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
+ */
+
+/*!
+    \file wolfssl/wolfcrypt/blake3.h
+*/
+
+#ifndef WOLF_CRYPT_BLAKE3_H
+#define WOLF_CRYPT_BLAKE3_H
+
+#include <wolfssl/wolfcrypt/settings.h>
+
+#ifdef HAVE_BLAKE3
+
+#include <wolfssl/wolfcrypt/types.h>
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+/* in bytes, the digest is an extendable output, 32 bytes by default */
+enum {
+    BLAKE3_KEYBYTES   = 32,
+    BLAKE3_OUTBYTES   = 32,
+    BLAKE3_BLOCKBYTES = 64,
+    BLAKE3_CHUNKBYTES = 1024,
+    BLAKE3_MAX_DEPTH  = 54   /* 2^64 bytes of input in 1 KiB chunks */
+};
+
+/* BLAKE3 digest */
+typedef struct Blake3 {
+    word32 key[BLAKE3_KEYBYTES / sizeof(word32)];  /* key or IV words */
+    word32 cv[BLAKE3_OUTBYTES / sizeof(word32)];   /* current chunk cv */
+    word64 chunkCounter;        /* index of the current chunk */
+    byte   buf[BLAKE3_BLOCKBYTES];
+    byte   bufLen;
+    byte   blocksCompressed;    /* blocks of the current chunk done */
+    byte   flags;               /* mode flags for every compression */
+    byte   cvStackLen;
+    byte   cvStack[(BLAKE3_MAX_DEPTH + 1) * BLAKE3_OUTBYTES];
+    word32 digestSz;            /* digest size used on init */
+#if defined(WOLFSSL_BLAKE3_THREADS) && !defined(SINGLE_THREADED)
+    word32 threads;             /* threads to hash large updates on */
+#endif
+} Blake3;
+
+
+WOLFSSL_API int wc_InitBlake3(Blake3* b3, word32 digestSz);
+WOLFSSL_API int wc_InitBlake3_WithKey(Blake3* b3, word32 digestSz,
+                                      const byte *key, word32 keylen);
+WOLFSSL_API int wc_InitBlake3_DeriveKey(Blake3* b3, word32 digestSz,
+                                        const byte* context,
+                                        word32 contextSz);
+WOLFSSL_API int wc_Blake3Update(Blake3* b3, const byte* data, word32 sz);
+WOLFSSL_API int wc_Blake3Final(Blake3* b3, byte* final, word32 requestSz);
+WOLFSSL_API int wc_Blake3FinalXof(Blake3* b3, word64 seek, byte* out,
+                                  word32 outSz);
+#if defined(WOLFSSL_BLAKE3_THREADS) && !defined(SINGLE_THREADED)
+WOLFSSL_API int wc_Blake3SetThreads(Blake3* b3, word32 threads);
+#endif
+
+
+#ifdef __cplusplus
+    }
+#endif
+
+#endif  /* HAVE_BLAKE3 */
+#endif  /* WOLF_CRYPT_BLAKE3_H */
+
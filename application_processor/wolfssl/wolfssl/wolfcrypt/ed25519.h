@@ -171,6 +171,13 @@ WOLFSSL_API
 int wc_ed25519_verify_msg_final(const byte* sig, word32 sigLen, int* res,
                                 ed25519_key* key);
 #endif /* WOLFSSL_ED25519_STREAMING_VERIFY */
+#ifdef WOLFSSL_ED25519_BATCH_VERIFY
+WOLFSSL_API
+int wc_ed25519_verify_msg_batch(const byte** sig, const word32* sigLen,
+                                const byte** msg, const word32* msgLen,
+                                ed25519_key** key, word32 cnt, int* res,
+                                WC_RNG* rng);
+#endif /* WOLFSSL_ED25519_BATCH_VERIFY */
 #endif /* HAVE_ED25519_VERIFY */
 
 
@@ -212,6 +219,10 @@ int wc_ed25519_export_key(ed25519_key* key,
 
 WOLFSSL_API
 int wc_ed25519_check_key(ed25519_key* key);
+#ifdef WOLFSSL_ED25519_MULTI_SCALAR
+WOLFSSL_API
+int wc_ed25519_mul_multi(byte* r, const byte* s, const byte* p, word32 cnt);
+#endif
 
 /* size helper */
 WOLFSSL_API
@@ -130,6 +130,24 @@ RSA keys can be used to encrypt, decrypt, sign and verify data.
     #endif
 #endif
 
+#ifdef WOLFSSL_RSA_MULTI_PRIME
+    #if defined(HAVE_FIPS) || defined(RSA_LOW_MEM) || \
+        defined(WOLFSSL_SP_MATH) || defined(WOLFSSL_RSA_PUBLIC_ONLY)
+        #error "Multi-prime RSA needs software CRT private operations"
+    #endif
+    /* Maximum number of primes in a multi-prime RSA key (RFC 8017). */
+    #define RSA_MAX_PRIMES          4
+    /* Primes after p and q - OtherPrimeInfos entries. */
+    #define RSA_MAX_OTHER_PRIMES    (RSA_MAX_PRIMES - 2)
+#endif
+
+#ifdef WC_RSA_BATCH
+    #if defined(RSA_LOW_MEM) || defined(WOLFSSL_SP_MATH) || \
+        defined(WOLFSSL_RSA_PUBLIC_ONLY) || defined(WOLFSSL_RSA_VERIFY_ONLY)
+        #error "RSA batch needs software CRT private operations"
+    #endif
+#endif
+
 /* avoid redefinition of structs */
 #if !defined(HAVE_FIPS) || \
     (defined(HAVE_FIPS_VERSION) && (HAVE_FIPS_VERSION >= 2))
@@ -195,6 +213,12 @@ struct RsaKey {
 #if defined(WOLFSSL_KEY_GEN) || defined(OPENSSL_EXTRA) || !defined(RSA_LOW_MEM)
     mp_int dP, dQ, u;
 #endif
+#ifdef WOLFSSL_RSA_MULTI_PRIME
+    mp_int r[RSA_MAX_OTHER_PRIMES];           /* other primes r_i */
+    mp_int dR[RSA_MAX_OTHER_PRIMES];          /* d mod (r_i - 1) */
+    mp_int tR[RSA_MAX_OTHER_PRIMES];          /* CRT coefficients t_i */
+    int    otherPrimes;                       /* number of primes after q */
+#endif
 #endif
     void* heap;                               /* for user memory overrides */
     byte* data;                               /* temp buffer for async RSA */
@@ -203,6 +227,14 @@ struct RsaKey {
     word32 dataLen;
 #ifdef WC_RSA_BLINDING
     WC_RNG* rng;                              /* for PrivateDecrypt blinding */
+#ifdef WC_RSA_BLINDING_CACHE
+    mp_int blind;                             /* cached r^e mod n */
+    mp_int blindInv;                          /* cached 1/r mod n */
+    mp_int blindN;                            /* n the pair was made for */
+    mp_int blindE;                            /* e the pair was made for */
+    word32 blindUses;                         /* uses left before refresh */
+    wolfSSL_Mutex blindMutex;
+#endif
 #endif
 #ifdef WOLFSSL_SE050
     word32 keyId;
@@ -308,6 +340,15 @@ WOLFSSL_API int  wc_RsaPSS_Sign_ex(const byte* in, word32 inLen, byte* out,
                                    word32 outLen, enum wc_HashType hash,
                                    int mgf, int saltLen, RsaKey* key,
                                    WC_RNG* rng);
+#ifdef WC_RSA_BATCH
+WOLFSSL_API int  wc_RsaFunctionBatch(const byte* const* in, byte* const* out,
+                                     word32 sz, int type, RsaKey* const* key,
+                                     int cnt, WC_RNG* rng);
+WOLFSSL_API int  wc_RsaSSL_SignBatch(const byte* const* in,
+                                     const word32* inLen, byte* const* out,
+                                     word32 outLen, RsaKey* const* key,
+                                     int cnt, WC_RNG* rng);
+#endif
 WOLFSSL_API int  wc_RsaSSL_VerifyInline(byte* in, word32 inLen, byte** out,
                                     RsaKey* key);
 WOLFSSL_API int  wc_RsaSSL_Verify(const byte* in, word32 inLen, byte* out,
@@ -429,6 +470,10 @@ WOLFSSL_API int wc_RsaExportKey(RsaKey* key,
 
 #ifdef WOLFSSL_KEY_GEN
     WOLFSSL_API int wc_MakeRsaKey(RsaKey* key, int size, long e, WC_RNG* rng);
+#ifdef WOLFSSL_RSA_MULTI_PRIME
+    WOLFSSL_API int wc_MakeRsaKeyMultiPrime(RsaKey* key, int size, long e,
+                                            int primes, WC_RNG* rng);
+#endif
     WOLFSSL_API int wc_CheckProbablePrime_ex(const byte* p, word32 pSz,
                                           const byte* q, word32 qSz,
                                           const byte* e, word32 eSz,
@@ -1028,6 +1028,12 @@ MP_API int sp_exptmod(const sp_int* b, const sp_int* e, const sp_int* m,
 MP_API int sp_exptmod_nct(const sp_int* b, const sp_int* e, const sp_int* m,
     sp_int* r);
 #endif
+#if defined(WOLFSSL_SP_MATH_ALL) && defined(WOLFSSL_DH_COMB)
+MP_API int sp_exptmod_comb_precomp(const sp_int* b, const sp_int* m, int bits,
+    int teeth, sp_int_digit* table);
+MP_API int sp_exptmod_comb(const sp_int_digit* table, int teeth, int bits,
+    const sp_int* e, const sp_int* m, sp_int* r);
+#endif
 
 #if defined(WOLFSSL_SP_MATH_ALL) || defined(OPENSSL_ALL)
 MP_API int sp_div_2d(const sp_int* a, int e, sp_int* r, sp_int* rem);
@@ -1155,6 +1161,8 @@ WOLFSSL_LOCAL void sp_memzero_check(sp_int* sp);
 #define mp_exptmod_ex                       sp_exptmod_ex
 #define mp_exptmod                          sp_exptmod
 #define mp_exptmod_nct                      sp_exptmod_nct
+#define mp_exptmod_comb_precomp             sp_exptmod_comb_precomp
+#define mp_exptmod_comb                     sp_exptmod_comb
 #define mp_div_2d                           sp_div_2d
 #define mp_mod_2d                           sp_mod_2d
 #define mp_mul_2d                           sp_mul_2d
@@ -0,0 +1,50 @@
+/**
+ * @file "mem_stats.h"
+ * @author CyberSecurity Club at SFSU
+ * @brief Stack and heap high-water-mark instrumentation
+ * @date 2024
+ *
+ * Only active when the firmware is built with MEM_STATS=1 (see project.mk).
+ * startup_firmware.S paints the stack at reset and mem_stats_init() turns on
+ * the usage counters of the static wolfCrypt pool, so the peaks below are the
+ * worst case seen since reset.
+ */
+
+#ifndef ECTF_MEM_STATS_H
+#define ECTF_MEM_STATS_H
+
+#include <stdint.h>
+
+/******************************** MACRO DEFINITIONS ********************************/
+// Word written over the whole stack by Reset_Handler, keep in sync with startup_firmware.S
+#define STACK_PAINT_WORD 0xDEADC0DE
+
+/******************************** TYPE DEFINITIONS ********************************/
+// Snapshot of the counters, the component sends this to the AP as is
+typedef struct {
+    uint32_t stack_size;   // Bytes reserved for the stack
+    uint32_t stack_peak;   // Deepest stack use since reset
+    uint32_t heap_current; // Pool bytes wolfCrypt currently holds, in whole buckets
+    uint32_t heap_peak;    // Most pool bytes wolfCrypt held at once
+    uint32_t heap_allocs;  // Number of wolfCrypt allocations since reset
+} mem_stats_t;
+
+/******************************** FUNCTION PROTOTYPES ********************************/
+/** @brief Turn on usage counters for the static wolfCrypt pool
+ *
+ * Must run after crypto_heap_init() and before the first key or RNG init
+ * so that no allocation is freed without having been counted
+ *
+ * @return 0 on success, non-zero on failure
+ */
+int mem_stats_init(void);
+
+/** @brief Take a snapshot of the stack and heap counters
+ *
+ * @param stats Filled with the current counters. The stack peak is found by
+ *          scanning up from the bottom of the stack for the first word that
+ *          no longer holds STACK_PAINT_WORD
+ */
+void mem_stats_get(mem_stats_t* stats);
+
+#endif
@@ -16,6 +16,8 @@
 
 #include "wolfssl/wolfcrypt/aes.h"
 #include "wolfssl/wolfcrypt/hash.h"
+#include "wolfssl/wolfcrypt/hmac.h"
+#include "wolfssl/wolfcrypt/memory.h"
 #include "wolfssl/wolfcrypt/rsa.h"
 #include "wolfssl/wolfcrypt/settings.h" // To define our random generator...
 #include "trng.h"
@@ -24,6 +26,13 @@
 #define BLOCK_SIZE AES_BLOCK_SIZE
 #define KEY_SIZE 16
 #define HASH_SIZE SHA256_DIGEST_SIZE
+#define MAC_SIZE WC_SHA256_DIGEST_SIZE
+// Bytes handed to wc_LoadStaticMemory, split into WOLFMEM_BUCKETS (user_settings.h)
+#define CRYPTO_HEAP_SIZE 1024
+
+/******************************** GLOBAL DEFINITIONS ********************************/
+// Heap hint for the static wolfCrypt pool, pass to every wolfCrypt init that takes a heap
+extern WOLFSSL_HEAP_HINT* crypto_heap;
 
 /******************************** FUNCTION PROTOTYPES ********************************/
 /** @brief Encrypts plaintext using a symmetric cipher
@@ -56,6 +65,14 @@ int encrypt_sym(uint8_t *plaintext, size_t len, uint8_t *key, uint8_t *ciphertex
  */
 int decrypt_sym(uint8_t *ciphertext, size_t len, uint8_t *key, uint8_t *plaintext);
 
+/** @brief Carves the static memory pool into wolfCrypt buckets
+ *
+ * Must be called before any key or RNG is initialized with crypto_heap
+ *
+ * @return 0 on success, non-zero for other error
+ */
+int crypto_heap_init(void);
+
 /** @brief Hashes arbitrary-length data
  *
  * @param data A pointer to a buffer of length len containing the data
@@ -21,6 +21,15 @@ IPATH+=../deployment
 IPATH+=inc/
 VPATH+=src/
 
+# ****************** Memory instrumentation *******************
+# Build with MEM_STATS=1 to paint the stack at reset and count wolfCrypt heap
+# use. The AP then accepts a "mem" command reporting its own and each
+# provisioned component's stack and heap high-water marks
+ifeq ($(MEM_STATS), 1)
+PROJ_CFLAGS += -DMEM_STATS
+PROJ_AFLAGS += -DMEM_STATS
+endif
+
 # ****************** eCTF Bootloader *******************
 # DO NOT REMOVE
 LINKERFILE=firmware.ld
@@ -18,6 +18,7 @@
 #include "mxc_errors.h"
 #include "nvic_table.h"
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
@@ -27,11 +28,17 @@
 #include "board_link.h"
 
 #include "simple_crypto.h"
+#include "mem_stats.h"
 
 // Includes from containerized build
 #include "ectf_params.h"
 #include "global_secrets.h"
 
+// Key material in global_secrets.h is decoded into sp_ints of SP_INT_BITS
+#if (RSA_KEY_LENGTH * 8) > SP_INT_BITS
+#error "SP_INT_BITS in user_settings.h is smaller than the deployment RSA key"
+#endif
+
 #ifdef POST_BOOT
 #include "led.h"
 #include <stdint.h>
@@ -58,7 +65,8 @@ typedef enum {
     COMPONENT_CMD_SCAN,
     COMPONENT_CMD_VALIDATE,
     COMPONENT_CMD_BOOT,
-    COMPONENT_CMD_ATTEST
+    COMPONENT_CMD_ATTEST,
+    COMPONENT_CMD_MEM_STATS
 } component_cmd_t;
 
 /******************************** TYPE DEFINITIONS ********************************/
@@ -96,7 +104,8 @@ void component_process_cmd(void);
 void process_boot(nonce_t expected_nonce2, command_message* command);
 void process_scan(void);
 void process_validate(nonce_t nonce2, command_message* command);
-void process_attest(void);
+void process_attest(command_message* command);
+void process_mem_stats(void);
 
 /********************************* GLOBAL VARIABLES **********************************/
 // Global varaibles
@@ -217,27 +226,30 @@ nonce_t generate_nonce()
     return *((nonce_t *)(hash_out));
 }
 
-// Structure to hold the encrypted data
+// Attestation reply: the AT data encrypted for the AP, followed by a MAC over it
+// and the nonce the AP sent with the request. Must match the AP's attest_message
 typedef struct {
     uint8_t AT_ECUST[RSA_KEY_LENGTH];
     uint8_t AT_ELOCA[RSA_KEY_LENGTH];
     uint8_t AT_EDATE[RSA_KEY_LENGTH];
-} attestation_data;
-
-uint8_t AT_DATA_DIGEST[HASH_SIZE];
-
+    uint8_t tag[MAC_SIZE];
+} attest_message;
 
+// The whole reply goes out as a single I2C packet
+#if (3 * RSA_KEY_LENGTH + MAC_SIZE) > (MAX_I2C_MESSAGE_LEN - 1)
+#error "Attestation reply does not fit in one I2C message"
+#endif
 
-// Encrypted AT Data
-attestation_data encrypted_AT;
+// Encrypted AT data, computed once at startup since it never changes
+attest_message attest_response;
 
-int init_at_pub_key(RsaKey* key, uint8_t* DER_Key, int len)
+int init_at_pub_key(RsaKey* key, const uint8_t* DER_Key, word32 len)
 {
     int ret = 0;
-    unsigned int idx = 0;
+    word32 idx = 0;
 
     // Initialize key structure
-    ret = wc_InitRsaKey(key, NULL);
+    ret = wc_InitRsaKey(key, crypto_heap);
     if(ret < 0) { return -1;}
 
     // Use existing public key to finalize the creation of our pub
@@ -249,13 +261,13 @@ int init_at_pub_key(RsaKey* key, uint8_t* DER_Key, int len)
     return 0;
 }
 
-int init_comp_priv_key(RsaKey* key, uint8_t* DER_Key, int len)
+int init_comp_priv_key(RsaKey* key, const uint8_t* DER_Key, word32 len)
 {
     int ret = 0;
-    unsigned int idx = 0;
+    word32 idx = 0;
 
     // Initialize key structure
-    ret = wc_InitRsaKey(key, NULL);
+    ret = wc_InitRsaKey(key, crypto_heap);
     if(ret < 0) { 
         return -1;
     }
@@ -275,21 +287,18 @@ int encrypt_AT()
 {
     int P_SIZE[] = {sizeof(ATTESTATION_LOC), sizeof(ATTESTATION_DATE), sizeof(ATTESTATION_CUSTOMER)};
     uint8_t* P_DATA[] = {(uint8_t*)ATTESTATION_LOC, (uint8_t*)ATTESTATION_DATE, (uint8_t*)ATTESTATION_CUSTOMER};
-    uint8_t* E_DATA[] = {encrypted_AT.AT_ELOCA, encrypted_AT.AT_EDATE, encrypted_AT.AT_ECUST};
-    int total_size = P_SIZE[0] + P_SIZE[1] + P_SIZE[2];
+    uint8_t* E_DATA[] = {attest_response.AT_ELOCA, attest_response.AT_EDATE, attest_response.AT_ECUST};
     int ret = 0;
     int i = 0;
 
-    // If any of the attestation data's sizes are greater than the key length than
+    // If any of the attestation data's sizes do not fit in one padded RSA block
     // we must fail the encryption and quit
-    if(P_SIZE[0]  > RSA_KEY_LENGTH ||
-       P_SIZE[1]  > RSA_KEY_LENGTH ||
-       P_SIZE[2]  > RSA_KEY_LENGTH) {
+    if(P_SIZE[0]  > RSA_KEY_LENGTH - RSA_MIN_PAD_SZ ||
+       P_SIZE[1]  > RSA_KEY_LENGTH - RSA_MIN_PAD_SZ ||
+       P_SIZE[2]  > RSA_KEY_LENGTH - RSA_MIN_PAD_SZ) {
         printf("Failed to encrypt attestation data due to rsa length, bye bye");
         return -1;
     }
-    // hash and store the hash value result in the digest global variable
-    hash(P_DATA, total_size, AT_DATA_DIGEST);
     
     for (;i < 3;i++) { 
          ret = wc_RsaPublicEncrypt(P_DATA[i], P_SIZE[i], E_DATA[i], RSA_KEY_LENGTH, &AP_PUB_FOR_AT, &COMP_rng);
@@ -352,8 +361,13 @@ void component_process_cmd() {
         process_validate(nonce2, command);
         break;
     case COMPONENT_CMD_ATTEST:
-        process_attest();
+        process_attest(command);
+        break;
+#ifdef MEM_STATS
+    case COMPONENT_CMD_MEM_STATS:
+        process_mem_stats();
         break;
+#endif
     default:
         printf("Error: Unrecognized command received %d\n", command->opcode);
         break;
@@ -409,29 +423,44 @@ void process_validate(nonce_t nonce2, command_message* command) {
     secure_send(transmit_buffer, sizeof(validate_message));
 }
 
-void process_attest() {
-    // The AP requested attestation. Respond with the attestation data
-    int i = 0;
-    int copied = 0;
-    // Since we're bottlenecked with i2c message size, send exactly 4 messages
-    // AT_CUST, AT_LOC, AT_DATE, HASH DIGEST
-    uint8_t* DATA[4] = {encrypted_AT.AT_ECUST, encrypted_AT.AT_ELOCA, encrypted_AT.AT_EDATE, AT_DATA_DIGEST};
+void process_attest(command_message* command) {
+    // The AP requested attestation. Respond with the precomputed attestation data,
+    // only the MAC binding it to the AP's nonce is computed per request
+    attest_message* packet = (attest_message*) transmit_buffer;
+    Hmac hmac;
+    int ret;
 
-    for(; i < 4; i++)
-    {
-        memset(transmit_buffer, 0 , sizeof(transmit_buffer));
-        if(i == 3)
-        {   
-            copied = HASH_SIZE;
-            memcpy(transmit_buffer, DATA[i], HASH_SIZE);
-        } else {
-            copied = MAX_I2C_MESSAGE_LEN;
-            memcpy(transmit_buffer, DATA[i], MAX_I2C_MESSAGE_LEN); // Fix the size here
-        }
-        
-        secure_send(transmit_buffer, copied);
+    memcpy(packet, &attest_response, offsetof(attest_message, tag));
+    ret = wc_HmacInit(&hmac, crypto_heap, INVALID_DEVID);
+    if (ret != 0) {
+        return;
+    }
+    ret = wc_HmacSetKey(&hmac, WC_SHA256, ATTEST_KEY, sizeof(ATTEST_KEY));
+    if (ret == 0) {
+        ret = wc_HmacUpdate(&hmac, (uint8_t*)&attest_response, offsetof(attest_message, tag));
+    }
+    if (ret == 0) {
+        ret = wc_HmacUpdate(&hmac, command->params, sizeof(nonce_t));
+    }
+    if (ret == 0) {
+        ret = wc_HmacFinal(&hmac, packet->tag);
     }
-    return;
+    wc_HmacFree(&hmac);
+    if (ret != 0) {
+        return;
+    }
+
+    // Already encrypted for the AP, so skip secure_send and its RSA wrap
+    send_packet_and_ack(sizeof(attest_message), transmit_buffer);
+}
+
+void process_mem_stats() {
+    // The AP requested our stack and heap high-water marks
+#ifdef MEM_STATS
+    mem_stats_t* stats = (mem_stats_t*) transmit_buffer;
+    mem_stats_get(stats);
+    secure_send(transmit_buffer, sizeof(mem_stats_t));
+#endif
 }
 
 /*********************************** MAIN *************************************/
@@ -442,23 +471,36 @@ int main(void) {
     // Enable Global Interrupts
     __enable_irq();
 
+    // All wolfCrypt memory comes from a static pool, set up before any key or RNG
+    if (crypto_heap_init() != 0) {
+        return -1;
+    }
+
+#ifdef MEM_STATS
+    // Count wolfCrypt pool use, must happen before the first key or RNG init
+    if (mem_stats_init() != 0) {
+        return -1;
+    }
+#endif
+
     // Enable library's randomness generator
     MXC_TRNG_Init();
    
    // Initialize the Randomizer :P
-    if(wc_InitRng(&COMP_rng) < 0) { 
+    if(wc_InitRng_ex(&COMP_rng, crypto_heap, INVALID_DEVID) < 0) { 
          return -1;
     }
    
-    // Encrypt component's AT data with AP's public key
-    if (init_at_pub_key(&AP_PUB_FOR_AT, (uint8_t*)AP_PUB_AT, sizeof(AP_PUB_AT)) < 0
+    // Encrypt component's AT data with AP's public key, keys are decoded
+    // straight from the .key_store flash section
+    if (init_at_pub_key(&AP_PUB_FOR_AT, AP_PUB_AT, sizeof(AP_PUB_AT)) < 0
     || encrypt_AT() < 0 )
     {
         return -1;
     }
     
     // Initialize COMP public key for communication
-    if (init_comp_priv_key(&COMP_PRIV ,(uint8_t*)COMP1_PRIV, sizeof(COMP1_PRIV)) < 0)
+    if (init_comp_priv_key(&COMP_PRIV, COMP1_PRIV, sizeof(COMP1_PRIV)) < 0)
     {
         return -1;
     }
@@ -0,0 +1,51 @@
+/**
+ * @file "mem_stats.c"
+ * @author CyberSecurity Club at SFSU
+ * @brief Stack and heap high-water-mark instrumentation
+ * @date 2024
+ */
+
+#ifdef MEM_STATS
+
+#include <string.h>
+
+#include "simple_crypto.h"
+#include "mem_stats.h"
+
+/******************************** GLOBAL DEFINITIONS ********************************/
+// Stack bounds from firmware.ld
+extern uint32_t __StackLimit[];
+extern uint32_t __StackTop[];
+
+// Filled in by wolfSSL_Malloc/wolfSSL_Free once WOLFMEM_TRACK_STATS is set on the pool
+static WOLFSSL_MEM_CONN_STATS pool_stats;
+
+/******************************** PUBLIC FUNCTIONS ********************************/
+int mem_stats_init(void) {
+    if (crypto_heap == NULL) {
+        return -1;
+    }
+
+    memset(&pool_stats, 0, sizeof(pool_stats));
+    crypto_heap->stats = &pool_stats;
+    crypto_heap->memory->flag |= WOLFMEM_TRACK_STATS;
+    return 0;
+}
+
+void mem_stats_get(mem_stats_t* stats) {
+    uint32_t* p = __StackLimit;
+
+    // The stack grows down, so the first overwritten word from the bottom
+    // marks the deepest point it ever reached
+    while (p < __StackTop && *p == STACK_PAINT_WORD) {
+        p++;
+    }
+
+    stats->stack_size = (uint32_t)((uint8_t*)__StackTop - (uint8_t*)__StackLimit);
+    stats->stack_peak = (uint32_t)((uint8_t*)__StackTop - (uint8_t*)p);
+    stats->heap_current = pool_stats.curMem;
+    stats->heap_peak = pool_stats.peakMem;
+    stats->heap_allocs = pool_stats.totalAlloc;
+}
+
+#endif
@@ -15,6 +15,11 @@
 #include <stdint.h>
 #include <string.h>
 
+/******************************** GLOBAL DEFINITIONS ********************************/
+// Backing store for every wolfCrypt allocation, aligned as wolfSSL_load_static_memory expects
+static unsigned char crypto_heap_buf[CRYPTO_HEAP_SIZE] __attribute__((aligned(WOLFSSL_STATIC_ALIGN)));
+WOLFSSL_HEAP_HINT* crypto_heap = NULL;
+
 /******************************** FUNCTION PROTOTYPES ********************************/
 /** @brief Encrypts plaintext using a symmetric cipher
  *
@@ -87,6 +92,17 @@ int decrypt_sym(uint8_t *ciphertext, size_t len, uint8_t *key, uint8_t *plaintex
     return 0;
 }
 
+/** @brief Carves the static memory pool into wolfCrypt buckets
+ *
+ * Must be called before any key or RNG is initialized with crypto_heap
+ *
+ * @return 0 on success, non-zero for other error
+ */
+int crypto_heap_init(void) {
+    return wc_LoadStaticMemory(&crypto_heap, crypto_heap_buf, sizeof(crypto_heap_buf),
+                               WOLFMEM_GENERAL, 1);
+}
+
 /** @brief Hashes arbitrary-length data
  *
  * @param data A pointer to a buffer of length len containing the data
@@ -102,7 +118,6 @@ int hash(void *data, size_t len, uint8_t *hash_out) {
     return wc_Md5Hash((uint8_t *)data, len, hash_out);
 }
 
-
 /** @brief This initializes wolfssl's random generator to allow us to generate secure randomness
  * wolfssl.com/forums/topic879-solved-using-rsa-undefined-reference-to-wcgenerateseed-error.html
  * github.com/analogdevicesinc/msdk/blob/main/Examples/MAX78000/TRNG/main.c
@@ -9256,6 +9256,28 @@ static int TLSX_KeyShare_IsSupported(int namedGroup)
             case WOLFSSL_KYBER_LEVEL5:
         #endif
                 break;
+        #ifdef HAVE_ECC
+        #ifdef WOLFSSL_KYBER512
+            case WOLFSSL_P256_KYBER_LEVEL1:
+        #endif
+        #ifdef WOLFSSL_KYBER768
+            case WOLFSSL_P384_KYBER_LEVEL3:
+        #endif
+        #ifdef WOLFSSL_KYBER1024
+            case WOLFSSL_P521_KYBER_LEVEL5:
+        #endif
+            {
+                int ecc_group = 0;
+                int pqc_group = 0;
+
+                /* Hybrid is only usable when the curve is compiled in. */
+                findEccPqc(&ecc_group, &pqc_group, namedGroup);
+                if (!TLSX_KeyShare_IsSupported(ecc_group)) {
+                    return 0;
+                }
+                break;
+            }
+        #endif /* HAVE_ECC */
     #elif defined(HAVE_LIBOQS)
         case WOLFSSL_KYBER_LEVEL1:
         case WOLFSSL_KYBER_LEVEL3:
@@ -9337,6 +9359,21 @@ static const word16 preferredGroup[] = {
     #ifdef WOLFSSL_KYBER1024
     WOLFSSL_KYBER_LEVEL5,
     #endif
+    #if defined(HAVE_ECC) && (!defined(NO_ECC256) || \
+        defined(HAVE_ALL_CURVES)) && !defined(NO_ECC_SECP) && \
+        ECC_MIN_KEY_SZ <= 256 && defined(WOLFSSL_KYBER512)
+    WOLFSSL_P256_KYBER_LEVEL1,
+    #endif
+    #if defined(HAVE_ECC) && (defined(HAVE_ECC384) || \
+        defined(HAVE_ALL_CURVES)) && !defined(NO_ECC_SECP) && \
+        ECC_MIN_KEY_SZ <= 384 && defined(WOLFSSL_KYBER768)
+    WOLFSSL_P384_KYBER_LEVEL3,
+    #endif
+    #if defined(HAVE_ECC) && (defined(HAVE_ECC521) || \
+        defined(HAVE_ALL_CURVES)) && !defined(NO_ECC_SECP) && \
+        ECC_MIN_KEY_SZ <= 521 && defined(WOLFSSL_KYBER1024)
+    WOLFSSL_P521_KYBER_LEVEL5,
+    #endif
 #elif defined(HAVE_LIBOQS)
     /* These require a runtime call to TLSX_KeyShare_IsSupported to use */
     WOLFSSL_KYBER_LEVEL1,
@@ -12809,11 +12846,29 @@ static int TLSX_PopulateSupportedGroups(WOLFSSL* ssl, TLSX** extensions)
         ret = TLSX_UseSupportedCurve(extensions, WOLFSSL_KYBER_LEVEL3,
                                      ssl->heap);
 #endif
-#ifdef WOLFSSL_KYBER768
+#ifdef WOLFSSL_KYBER1024
     if (ret == WOLFSSL_SUCCESS)
         ret = TLSX_UseSupportedCurve(extensions, WOLFSSL_KYBER_LEVEL5,
                                      ssl->heap);
 #endif
+#if defined(HAVE_ECC) && (!defined(NO_ECC256) || defined(HAVE_ALL_CURVES)) && \
+    !defined(NO_ECC_SECP) && ECC_MIN_KEY_SZ <= 256 && defined(WOLFSSL_KYBER512)
+    if (ret == WOLFSSL_SUCCESS)
+        ret = TLSX_UseSupportedCurve(extensions, WOLFSSL_P256_KYBER_LEVEL1,
+                                     ssl->heap);
+#endif
+#if defined(HAVE_ECC) && (defined(HAVE_ECC384) || defined(HAVE_ALL_CURVES)) && \
+    !defined(NO_ECC_SECP) && ECC_MIN_KEY_SZ <= 384 && defined(WOLFSSL_KYBER768)
+    if (ret == WOLFSSL_SUCCESS)
+        ret = TLSX_UseSupportedCurve(extensions, WOLFSSL_P384_KYBER_LEVEL3,
+                                     ssl->heap);
+#endif
+#if defined(HAVE_ECC) && (defined(HAVE_ECC521) || defined(HAVE_ALL_CURVES)) && \
+    !defined(NO_ECC_SECP) && ECC_MIN_KEY_SZ <= 521 && defined(WOLFSSL_KYBER1024)
+    if (ret == WOLFSSL_SUCCESS)
+        ret = TLSX_UseSupportedCurve(extensions, WOLFSSL_P521_KYBER_LEVEL5,
+                                     ssl->heap);
+#endif
 #elif defined(HAVE_LIBOQS)
     ret = TLSX_UseSupportedCurve(extensions, WOLFSSL_KYBER_LEVEL1, ssl->heap);
     if (ret == WOLFSSL_SUCCESS)
@@ -68,6 +68,9 @@
 #ifdef WOLFSSL_ASNC_CRYPT
     #include <wolfssl/wolfcrypt/async.h>
 #endif
+#ifdef WOLFSSL_HAVE_KYBER
+    #include <wolfssl/wolfcrypt/kyber.h> /* Kyber levels compiled in */
+#endif
 #ifdef HAVE_ECC
     #include <wolfssl/wolfcrypt/ecc.h>   /* wc_ecc_fp_free */
     #ifndef ECC_ASN963_MAX_BUF_SZ
@@ -68688,6 +68691,69 @@ static int test_tls13_pq_groups(void)
     return EXPECT_RESULT();
 }
 
+/* Handshake with each hybrid ECDHE and Kyber group as the only group. */
+static int test_tls13_pq_hybrid_groups(void)
+{
+    EXPECT_DECLS;
+#if defined(HAVE_MANUAL_MEMIO_TESTS_DEPENDENCIES) && defined(WOLFSSL_TLS13) && \
+    defined(HAVE_PQC) && defined(WOLFSSL_HAVE_KYBER) && defined(HAVE_ECC) && \
+    (defined(HAVE_LIBOQS) || defined(WOLFSSL_WC_KYBER)) && \
+    !defined(NO_ECC_SECP)
+    static const struct {
+        int         group;
+        const char* name;
+    } groups[] = {
+    #if defined(WOLFSSL_KYBER512) && (!defined(NO_ECC256) || \
+        defined(HAVE_ALL_CURVES)) && ECC_MIN_KEY_SZ <= 256
+        { WOLFSSL_P256_KYBER_LEVEL1, "P256_KYBER_LEVEL1" },
+    #endif
+    #if defined(WOLFSSL_KYBER768) && (defined(HAVE_ECC384) || \
+        defined(HAVE_ALL_CURVES)) && ECC_MIN_KEY_SZ <= 384
+        { WOLFSSL_P384_KYBER_LEVEL3, "P384_KYBER_LEVEL3" },
+    #endif
+    #if defined(WOLFSSL_KYBER1024) && (defined(HAVE_ECC521) || \
+        defined(HAVE_ALL_CURVES)) && ECC_MIN_KEY_SZ <= 521
+        { WOLFSSL_P521_KYBER_LEVEL5, "P521_KYBER_LEVEL5" },
+    #endif
+        { 0, NULL }
+    };
+    const char* test_str = "test";
+    int test_str_size = (int)XSTRLEN(test_str) + 1;
+    byte buf[16];
+    int i;
+
+    for (i = 0; groups[i].name != NULL; i++) {
+        WOLFSSL_CTX *ctx_c = NULL;
+        WOLFSSL_CTX *ctx_s = NULL;
+        WOLFSSL *ssl_c = NULL;
+        WOLFSSL *ssl_s = NULL;
+        struct test_memio_ctx test_ctx;
+        int group = groups[i].group;
+
+        XMEMSET(&test_ctx, 0, sizeof(test_ctx));
+        ExpectIntEQ(test_memio_setup(&test_ctx, &ctx_c, &ctx_s, &ssl_c, &ssl_s,
+            wolfTLSv1_3_client_method, wolfTLSv1_3_server_method), 0);
+        ExpectIntEQ(wolfSSL_set_groups(ssl_c, &group, 1), WOLFSSL_SUCCESS);
+        ExpectIntEQ(wolfSSL_set_groups(ssl_s, &group, 1), WOLFSSL_SUCCESS);
+        ExpectIntEQ(wolfSSL_UseKeyShare(ssl_c, (word16)group),
+            WOLFSSL_SUCCESS);
+        ExpectIntEQ(test_memio_do_handshake(ssl_c, ssl_s, 10, NULL), 0);
+        ExpectStrEQ(wolfSSL_get_curve_name(ssl_c), groups[i].name);
+        ExpectStrEQ(wolfSSL_get_curve_name(ssl_s), groups[i].name);
+        ExpectIntEQ(wolfSSL_write(ssl_c, test_str, test_str_size),
+            test_str_size);
+        ExpectIntEQ(wolfSSL_read(ssl_s, buf, sizeof(buf)), test_str_size);
+        ExpectIntEQ(XSTRCMP((char*)buf, test_str), 0);
+
+        wolfSSL_free(ssl_c);
+        wolfSSL_free(ssl_s);
+        wolfSSL_CTX_free(ctx_c);
+        wolfSSL_CTX_free(ctx_s);
+    }
+#endif
+    return EXPECT_RESULT();
+}
+
 static int test_dtls13_early_data(void)
 {
     EXPECT_DECLS;
@@ -70183,6 +70249,7 @@ TEST_CASE testCases[] = {
     TEST_DECL(test_dtls13_frag_ch_pq),
     TEST_DECL(test_dtls_empty_keyshare_with_cookie),
     TEST_DECL(test_tls13_pq_groups),
+    TEST_DECL(test_tls13_pq_hybrid_groups),
     TEST_DECL(test_dtls13_early_data),
     /* This test needs to stay at the end to clean up any caches allocated. */
     TEST_DECL(test_wolfSSL_Cleanup)
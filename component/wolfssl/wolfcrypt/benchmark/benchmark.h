@@ -49,6 +49,7 @@ void bench_des(int useDeviceID);
 void bench_arc4(int useDeviceID);
 void bench_chacha(void);
 void bench_chacha20_poly1305_aead(void);
+void bench_chacha20_poly1305_records(void);
 void bench_aescbc(int useDeviceID);
 void bench_aesgcm(int useDeviceID);
 void bench_gmac(int useDeviceID);
@@ -68,6 +69,7 @@ void bench_md5(int useDeviceID);
 void bench_sha(int useDeviceID);
 void bench_sha224(int useDeviceID);
 void bench_sha256(int useDeviceID);
+void bench_sha256_multi(int useDeviceID);
 void bench_sha384(int useDeviceID);
 void bench_sha512(int useDeviceID);
 #if !defined(WOLFSSL_NOSHA512_224) && \
@@ -84,6 +86,8 @@ void bench_sha3_384(int useDeviceID);
 void bench_sha3_512(int useDeviceID);
 void bench_shake128(int useDeviceID);
 void bench_shake256(int useDeviceID);
+void bench_shake128x4(void);
+void bench_shake256x4(void);
 void bench_sm3(int useDeviceID);
 void bench_ripemd(void);
 void bench_cmac(int useDeviceID);
@@ -100,6 +104,8 @@ void bench_rsaKeyGen(int useDeviceID);
 void bench_rsaKeyGen_size(int useDeviceID, word32 keySz);
 void bench_rsa(int useDeviceID);
 void bench_rsa_key(int useDeviceID, word32 keySz);
+void bench_rsa_multiprime(int useDeviceID);
+void bench_rsa_batch(int useDeviceID);
 void bench_dh(int useDeviceID);
 void bench_kyber(int type);
 void bench_lms(void);
@@ -127,7 +133,10 @@ void bench_sakkeValidate(void);
 void bench_sakke(void);
 void bench_rng(void);
 void bench_blake2b(void);
+void bench_blake2bp(void);
 void bench_blake2s(void);
+void bench_blake2sp(void);
+void bench_blake3(void);
 void bench_pbkdf2(void);
 void bench_falconKeySign(byte level);
 void bench_dilithiumKeySign(byte level);
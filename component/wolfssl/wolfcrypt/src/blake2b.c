@@ -45,6 +45,26 @@
 #include <wolfssl/wolfcrypt/blake2-impl.h>
 #include <wolfssl/wolfcrypt/error-crypt.h>
 
+#if defined(WOLFSSL_X86_64_BUILD) && defined(USE_INTEL_SPEEDUP) && \
+    !defined(WOLFSSL_NO_ASM) && !defined(NO_AVX2_SUPPORT)
+    #define USE_INTEL_BLAKE2B_SPEEDUP
+    #include <wolfssl/wolfcrypt/cpuid.h>
+
+/* CPU features, read when a state is initialized rather than per block. */
+static word32 intel_flags = 0;
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+/* Compress one block with the rows of the state held in ymm registers. */
+extern void blake2b_compress_avx2(blake2b_state* S, const byte* block);
+#ifdef __cplusplus
+    }  /* extern "C" */
+#endif
+#endif
+
+#define BLAKE2BP_PARALLELISM    4
+
 
 static const word64 blake2b_IV[8] =
 {
@@ -99,6 +119,10 @@ static WC_INLINE int blake2b_init0( blake2b_state *S )
   int i;
   XMEMSET( S, 0, sizeof( blake2b_state ) );
 
+#ifdef USE_INTEL_BLAKE2B_SPEEDUP
+  intel_flags = cpuid_get_flags();
+#endif
+
   for( i = 0; i < 8; ++i ) S->h[i] = blake2b_IV[i];
 
   return 0;
@@ -221,6 +245,18 @@ static WC_INLINE int blake2b_compress(
 {
   word64 i;
 
+#ifdef USE_INTEL_BLAKE2B_SPEEDUP
+  if( IS_INTEL_AVX2( intel_flags ) )
+  {
+    SAVE_VECTOR_REGISTERS(return _svr_ret;);
+    blake2b_compress_avx2( S, block );
+    RESTORE_VECTOR_REGISTERS();
+    (void)m;
+    (void)v;
+    return 0;
+  }
+#endif
+
   for( i = 0; i < 16; ++i )
     m[i] = load64( block + i * sizeof( m[i] ) );
 
@@ -422,6 +458,265 @@ int blake2b( byte *out, const void *in, const void *key, const byte outlen,
   return blake2b_final( S, out, outlen );
 }
 
+/* BLAKE2bp: BLAKE2BP_PARALLELISM leaves each hash every
+ * BLAKE2BP_PARALLELISM-th block of the message and a root node hashes the
+ * leaf digests. */
+static int blake2bp_init_node( blake2b_state *S, byte outlen, byte keylen,
+                               word64 offset, byte depth )
+{
+  volatile blake2b_param P[1];
+
+  XMEMSET( (blake2b_param *)P, 0, sizeof( *P ) );
+  P->digest_length = outlen;
+  P->key_length    = keylen;
+  P->fanout        = BLAKE2BP_PARALLELISM;
+  P->depth         = 2;
+  store64( (word64 *)&P->node_offset, offset );
+  P->node_depth    = depth;
+  P->inner_length  = BLAKE2B_OUTBYTES;
+  return blake2b_init_param( S, (blake2b_param *)P );
+}
+
+static int blake2bp_init_all( blake2bp_state *S, byte outlen, const void *key,
+                              byte keylen )
+{
+  int ret;
+  int i;
+
+  if ( ( !outlen ) || ( outlen > BLAKE2B_OUTBYTES ) ) return BAD_FUNC_ARG;
+
+  XMEMSET( S->buf, 0, sizeof( S->buf ) );
+  S->buflen = 0;
+
+  ret = blake2bp_init_node( S->R, outlen, keylen, 0, 1 );
+  for( i = 0; ( ret == 0 ) && ( i < BLAKE2BP_PARALLELISM ); ++i )
+    ret = blake2bp_init_node( S->S[i], outlen, keylen, (word64)i, 0 );
+  if ( ret < 0 ) return ret;
+
+  S->R->last_node = 1;
+  S->S[BLAKE2BP_PARALLELISM - 1]->last_node = 1;
+
+  if( keylen > 0 )
+  {
+#ifdef WOLFSSL_SMALL_STACK
+    byte* block;
+
+    block = (byte*)XMALLOC(BLAKE2B_BLOCKBYTES, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+
+    if ( block == NULL ) return MEMORY_E;
+#else
+    byte block[BLAKE2B_BLOCKBYTES];
+#endif
+
+    XMEMSET( block, 0, BLAKE2B_BLOCKBYTES );
+    XMEMCPY( block, key, keylen );
+    for( i = 0; ( ret == 0 ) && ( i < BLAKE2BP_PARALLELISM ); ++i )
+      ret = blake2b_update( S->S[i], block, BLAKE2B_BLOCKBYTES );
+    secure_zero_memory( block, BLAKE2B_BLOCKBYTES );
+
+#ifdef WOLFSSL_SMALL_STACK
+    XFREE(block, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+#endif
+  }
+  return ret;
+}
+
+int blake2bp_init( blake2bp_state *S, const byte outlen )
+{
+  return blake2bp_init_all( S, outlen, NULL, 0 );
+}
+
+int blake2bp_init_key( blake2bp_state *S, const byte outlen, const void *key,
+                       const byte keylen )
+{
+  if ( !key || !keylen || keylen > BLAKE2B_KEYBYTES ) return BAD_FUNC_ARG;
+
+  return blake2bp_init_all( S, outlen, key, keylen );
+}
+
+#if defined(WOLFSSL_BLAKE2_THREADS) && !defined(SINGLE_THREADED)
+#ifndef WOLFSSL_BLAKE2_THREAD_MIN
+    /* Bytes of input before the leaves are hashed on separate threads. */
+    #define WOLFSSL_BLAKE2_THREAD_MIN   (1024 * 1024)
+#endif
+
+typedef struct Blake2bpLeaf {
+  blake2b_state *S;
+  const byte    *in;
+  word64         inlen;
+  int            ret;
+} Blake2bpLeaf;
+
+/* Hash the leaf's share of all the whole strides of input. */
+static THREAD_RETURN WOLFSSL_THREAD blake2bp_leaf_thread( void *arg )
+{
+  Blake2bpLeaf *leaf = (Blake2bpLeaf *)arg;
+  const byte *in = leaf->in;
+  word64 inlen = leaf->inlen;
+
+  leaf->ret = 0;
+  while( ( leaf->ret == 0 ) &&
+         ( inlen >= BLAKE2BP_PARALLELISM * BLAKE2B_BLOCKBYTES ) )
+  {
+    leaf->ret = blake2b_update( leaf->S, in, BLAKE2B_BLOCKBYTES );
+    in += BLAKE2BP_PARALLELISM * BLAKE2B_BLOCKBYTES;
+    inlen -= BLAKE2BP_PARALLELISM * BLAKE2B_BLOCKBYTES;
+  }
+  WOLFSSL_RETURN_FROM_THREAD(0);
+}
+#endif
+
+/* Hash all the whole strides of input into the leaves. */
+static int blake2bp_update_leaves( blake2bp_state *S, const byte *in,
+                                   word64 inlen )
+{
+  int ret = 0;
+  int i;
+
+#if defined(WOLFSSL_BLAKE2_THREADS) && !defined(SINGLE_THREADED)
+  if( inlen >= WOLFSSL_BLAKE2_THREAD_MIN )
+  {
+    Blake2bpLeaf leaf[BLAKE2BP_PARALLELISM];
+    THREAD_TYPE  tid[BLAKE2BP_PARALLELISM];
+    int          started[BLAKE2BP_PARALLELISM];
+
+    for( i = 0; i < BLAKE2BP_PARALLELISM; ++i )
+    {
+      leaf[i].S = S->S[i];
+      leaf[i].in = in + i * BLAKE2B_BLOCKBYTES;
+      leaf[i].inlen = inlen;
+      started[i] = ( i > 0 ) &&
+          ( wolfSSL_NewThread( &tid[i], blake2bp_leaf_thread, &leaf[i] ) == 0 );
+    }
+    /* Leaf 0, and any leaf without a thread, is hashed here. */
+    for( i = 0; i < BLAKE2BP_PARALLELISM; ++i )
+    {
+      if( !started[i] )
+        (void)blake2bp_leaf_thread( &leaf[i] );
+    }
+    for( i = 0; i < BLAKE2BP_PARALLELISM; ++i )
+    {
+      if( started[i] )
+        (void)wolfSSL_JoinThread( tid[i] );
+      if( ret == 0 )
+        ret = leaf[i].ret;
+    }
+    return ret;
+  }
+#endif
+
+  while( ( ret == 0 ) &&
+         ( inlen >= BLAKE2BP_PARALLELISM * BLAKE2B_BLOCKBYTES ) )
+  {
+    for( i = 0; ( ret == 0 ) && ( i < BLAKE2BP_PARALLELISM ); ++i )
+      ret = blake2b_update( S->S[i], in + i * BLAKE2B_BLOCKBYTES,
+                            BLAKE2B_BLOCKBYTES );
+    in += BLAKE2BP_PARALLELISM * BLAKE2B_BLOCKBYTES;
+    inlen -= BLAKE2BP_PARALLELISM * BLAKE2B_BLOCKBYTES;
+  }
+  return ret;
+}
+
+int blake2bp_update( blake2bp_state *S, const byte *in, word64 inlen )
+{
+  int ret = 0;
+  int i;
+  word64 left = S->buflen;
+  word64 fill = sizeof( S->buf ) - left;
+  word64 done;
+
+  if( left && inlen >= fill )
+  {
+    XMEMCPY( S->buf + left, in, (wolfssl_word)fill );
+    for( i = 0; ( ret == 0 ) && ( i < BLAKE2BP_PARALLELISM ); ++i )
+      ret = blake2b_update( S->S[i], S->buf + i * BLAKE2B_BLOCKBYTES,
+                            BLAKE2B_BLOCKBYTES );
+    in += fill;
+    inlen -= fill;
+    left = 0;
+  }
+  if( ret == 0 )
+    ret = blake2bp_update_leaves( S, in, inlen );
+  if( ret < 0 ) return ret;
+
+  done = inlen - inlen % ( BLAKE2BP_PARALLELISM * BLAKE2B_BLOCKBYTES );
+  in += done;
+  inlen -= done;
+  if( inlen > 0 )
+    XMEMCPY( S->buf + left, in, (wolfssl_word)inlen );
+  S->buflen = left + inlen;
+
+  return 0;
+}
+
+int blake2bp_final( blake2bp_state *S, byte *out, const byte outlen )
+{
+  int ret = 0;
+  int i;
+  byte hash[BLAKE2BP_PARALLELISM][BLAKE2B_OUTBYTES];
+
+  if ( ( !outlen ) || ( outlen > BLAKE2B_OUTBYTES ) ) return BAD_FUNC_ARG;
+
+  for( i = 0; ( ret == 0 ) && ( i < BLAKE2BP_PARALLELISM ); ++i )
+  {
+    if( S->buflen > (word64)i * BLAKE2B_BLOCKBYTES )
+    {
+      word64 left = S->buflen - (word64)i * BLAKE2B_BLOCKBYTES;
+
+      if( left > BLAKE2B_BLOCKBYTES ) left = BLAKE2B_BLOCKBYTES;
+      ret = blake2b_update( S->S[i], S->buf + i * BLAKE2B_BLOCKBYTES, left );
+    }
+    if( ret == 0 )
+      ret = blake2b_final( S->S[i], hash[i], BLAKE2B_OUTBYTES );
+  }
+  for( i = 0; ( ret == 0 ) && ( i < BLAKE2BP_PARALLELISM ); ++i )
+    ret = blake2b_update( S->R, hash[i], BLAKE2B_OUTBYTES );
+  if( ret == 0 )
+    ret = blake2b_final( S->R, out, outlen );
+
+  secure_zero_memory( hash, sizeof( hash ) );
+  return ret;
+}
+
+int blake2bp( byte *out, const void *in, const void *key, const byte outlen,
+              const word64 inlen, byte keylen )
+{
+  int ret;
+#ifdef WOLFSSL_SMALL_STACK
+  blake2bp_state* S;
+#else
+  blake2bp_state S[1];
+#endif
+
+  /* Verify parameters */
+  if ( NULL == in && inlen > 0 ) return BAD_FUNC_ARG;
+
+  if ( NULL == out ) return BAD_FUNC_ARG;
+
+  if( NULL == key ) keylen = 0;
+
+#ifdef WOLFSSL_SMALL_STACK
+  S = (blake2bp_state*)XMALLOC(sizeof(blake2bp_state), NULL,
+                               DYNAMIC_TYPE_TMP_BUFFER);
+  if ( S == NULL ) return MEMORY_E;
+#endif
+
+  if( keylen > 0 )
+    ret = blake2bp_init_key( S, outlen, key, keylen );
+  else
+    ret = blake2bp_init( S, outlen );
+  if( ret == 0 )
+    ret = blake2bp_update( S, ( const byte * )in, inlen );
+  if( ret == 0 )
+    ret = blake2bp_final( S, out, outlen );
+
+  secure_zero_memory( S, sizeof( *S ) );
+#ifdef WOLFSSL_SMALL_STACK
+  XFREE(S, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+#endif
+  return ret;
+}
+
 #if defined(BLAKE2B_SELFTEST)
 #include <string.h>
 #include "blake2-kat.h"
@@ -504,6 +799,63 @@ int wc_Blake2bFinal(Blake2b* b2b, byte* final, word32 requestSz)
 }
 
 
+/* Init Blake2bp digest, track size in case final doesn't want to "remember" */
+int wc_InitBlake2bp(Blake2bp* b2bp, word32 digestSz)
+{
+    if (b2bp == NULL || digestSz > BLAKE2B_OUTBYTES) {
+        return BAD_FUNC_ARG;
+    }
+    b2bp->digestSz = digestSz;
+
+    return blake2bp_init(b2bp->S, (byte)digestSz);
+}
+
+/* Init Blake2bp digest with key, track size in case final doesn't want to
+ * "remember" */
+int wc_InitBlake2bp_WithKey(Blake2bp* b2bp, word32 digestSz, const byte *key,
+                            word32 keylen)
+{
+    if (b2bp == NULL || digestSz > BLAKE2B_OUTBYTES) {
+        return BAD_FUNC_ARG;
+    }
+    b2bp->digestSz = digestSz;
+
+    if (keylen > BLAKE2B_KEYBYTES)
+        return BAD_FUNC_ARG;
+
+    if (key)
+        return blake2bp_init_key(b2bp->S, (byte)digestSz, key, (byte)keylen);
+    else
+        return blake2bp_init(b2bp->S, (byte)digestSz);
+}
+
+/* Blake2bp Update */
+int wc_Blake2bpUpdate(Blake2bp* b2bp, const byte* data, word32 sz)
+{
+    if (b2bp == NULL || (data == NULL && sz > 0)) {
+        return BAD_FUNC_ARG;
+    }
+
+    return blake2bp_update(b2bp->S, data, sz);
+}
+
+/* Blake2bp Final, if pass in zero size we use init digestSz */
+int wc_Blake2bpFinal(Blake2bp* b2bp, byte* final, word32 requestSz)
+{
+    word32 sz;
+
+    if (b2bp == NULL || final == NULL) {
+        return BAD_FUNC_ARG;
+    }
+    sz = requestSz ? requestSz : b2bp->digestSz;
+    if (sz > BLAKE2B_OUTBYTES) {
+        return BAD_FUNC_ARG;
+    }
+
+    return blake2bp_final(b2bp->S, final, (byte)sz);
+}
+
+
 /* end CTaoCrypt API */
 
 #endif  /* HAVE_BLAKE2 */
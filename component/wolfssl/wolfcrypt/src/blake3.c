@@ -0,0 +1,868 @@
+/* blake3.c
+ *
+ * Copyright (C) 2006-2023 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL.
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
+ */
+
+/* BLAKE3 as specified by O'Connor, Aumasson, Neves and Wilcox-O'Hearn.
+ *
+ * The message is split into 1 KiB chunks that are the leaves of a binary
+ * tree. Whole subtrees are hashed many chunks at a time with the AVX2 (8
+ * chunks) or AVX (4 chunks) code in blake3_asm.S and, when
+ * WOLFSSL_BLAKE3_THREADS is defined, the halves of large subtrees are hashed
+ * on separate threads.
+ */
+
+#ifdef HAVE_CONFIG_H
+    #include <config.h>
+#endif
+
+#include <wolfssl/wolfcrypt/settings.h>
+
+#ifdef HAVE_BLAKE3
+
+#include <wolfssl/wolfcrypt/blake3.h>
+#include <wolfssl/wolfcrypt/error-crypt.h>
+
+#ifdef NO_INLINE
+    #include <wolfssl/wolfcrypt/misc.h>
+#else
+    #define WOLFSSL_MISC_INCLUDED
+    #include <wolfcrypt/src/misc.c>
+#endif
+
+#if defined(WOLFSSL_X86_64_BUILD) && defined(USE_INTEL_SPEEDUP) && \
+    !defined(WOLFSSL_NO_ASM)
+    #define USE_INTEL_BLAKE3_SPEEDUP
+    #include <wolfssl/wolfcrypt/cpuid.h>
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+/* Hash 4 (AVX) or 8 (AVX2) inputs of the same number of blocks.
+ * counters holds the low words of the lanes' counters then the high words.
+ * flags holds the flags of every block, those of the first block shifted
+ * left by 8 and those of the last block shifted left by 16. */
+extern void blake3_hash_many_avx1(const byte* const* inputs, word32 blocks,
+    const word32* key, const word32* counters, word32 flags, byte* out);
+#ifndef NO_AVX2_SUPPORT
+extern void blake3_hash_many_avx2(const byte* const* inputs, word32 blocks,
+    const word32* key, const word32* counters, word32 flags, byte* out);
+#endif
+#ifdef __cplusplus
+    }  /* extern "C" */
+#endif
+#endif
+
+#if defined(WOLFSSL_BLAKE3_THREADS) && !defined(SINGLE_THREADED)
+    #define BLAKE3_THREADS
+    #ifndef WOLFSSL_BLAKE3_THREAD_MIN
+        /* Bytes in each half of a subtree before it is split over threads. */
+        #define WOLFSSL_BLAKE3_THREAD_MIN   (128 * 1024)
+    #endif
+#endif
+
+/* Most chunks or parents hashed at once and most chaining values out of
+ * hashing a subtree. */
+#define BLAKE3_MAX_SIMD_DEGREE  8
+
+enum {
+    BLAKE3_CHUNK_START         = 1 << 0,
+    BLAKE3_CHUNK_END           = 1 << 1,
+    BLAKE3_PARENT              = 1 << 2,
+    BLAKE3_ROOT                = 1 << 3,
+    BLAKE3_KEYED_HASH          = 1 << 4,
+    BLAKE3_DERIVE_KEY_CONTEXT  = 1 << 5,
+    BLAKE3_DERIVE_KEY_MATERIAL = 1 << 6
+};
+
+static const word32 blake3_IV[8] = {
+    0x6A09E667UL, 0xBB67AE85UL, 0x3C6EF372UL, 0xA54FF53AUL,
+    0x510E527FUL, 0x9B05688CUL, 0x1F83D9ABUL, 0x5BE0CD19UL
+};
+
+/* Message word order of each round - the permutation applied repeatedly. */
+static const byte blake3_sigma[7][16] = {
+    {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15 },
+    {  2,  6,  3, 10,  7,  0,  4, 13,  1, 11, 12,  5,  9, 14, 15,  8 },
+    {  3,  4, 10, 12, 13,  2,  7, 14,  6,  5,  9,  0, 11, 15,  8,  1 },
+    { 10,  7, 12,  9, 14,  3, 13, 15,  4,  0, 11,  2,  5,  8,  1,  6 },
+    { 12, 13,  9, 11, 15, 10, 14,  8,  7,  2,  5,  3,  0,  1,  6,  4 },
+    {  9, 14, 11,  5,  8, 12, 15,  1, 13,  3,  0, 10,  2,  6,  4,  7 },
+    { 11, 15,  5,  0,  1,  9,  8,  6, 14, 10,  2, 12,  3,  4,  7, 13 }
+};
+
+/* The last block of a chunk or of a parent, ready to be compressed as a
+ * chaining value or as root output. */
+typedef struct Blake3Output {
+    word32 cv[8];
+    word64 counter;
+    byte   block[BLAKE3_BLOCKBYTES];
+    byte   blockLen;
+    byte   flags;
+} Blake3Output;
+
+
+static WC_INLINE word32 blake3_load32(const byte* p)
+{
+    return ((word32)p[0]) | ((word32)p[1] << 8) | ((word32)p[2] << 16) |
+           ((word32)p[3] << 24);
+}
+
+static WC_INLINE void blake3_store32(byte* p, word32 w)
+{
+    p[0] = (byte)w;
+    p[1] = (byte)(w >> 8);
+    p[2] = (byte)(w >> 16);
+    p[3] = (byte)(w >> 24);
+}
+
+static WC_INLINE void blake3_store_cv(byte* out, const word32* cv)
+{
+    int i;
+
+    for (i = 0; i < 8; i++)
+        blake3_store32(out + 4 * i, cv[i]);
+}
+
+#define BLAKE3_G(a, b, c, d, x, y)              \
+    do {                                        \
+        s[a] = s[a] + s[b] + (x);               \
+        s[d] = rotrFixed(s[d] ^ s[a], 16);      \
+        s[c] = s[c] + s[d];                     \
+        s[b] = rotrFixed(s[b] ^ s[c], 12);      \
+        s[a] = s[a] + s[b] + (y);               \
+        s[d] = rotrFixed(s[d] ^ s[a], 8);       \
+        s[c] = s[c] + s[d];                     \
+        s[b] = rotrFixed(s[b] ^ s[c], 7);       \
+    } while (0)
+
+/* Run the seven rounds over the state set up from the chaining value. */
+static void blake3_compress_pre(word32* s, const word32* cv, const byte* block,
+    byte blockLen, word64 counter, byte flags)
+{
+    word32 m[16];
+    int i;
+
+    for (i = 0; i < 16; i++)
+        m[i] = blake3_load32(block + 4 * i);
+
+    for (i = 0; i < 8; i++)
+        s[i] = cv[i];
+    s[ 8] = blake3_IV[0];
+    s[ 9] = blake3_IV[1];
+    s[10] = blake3_IV[2];
+    s[11] = blake3_IV[3];
+    s[12] = (word32)counter;
+    s[13] = (word32)(counter >> 32);
+    s[14] = blockLen;
+    s[15] = flags;
+
+    for (i = 0; i < 7; i++) {
+        const byte* sg = blake3_sigma[i];
+
+        BLAKE3_G(0, 4,  8, 12, m[sg[ 0]], m[sg[ 1]]);
+        BLAKE3_G(1, 5,  9, 13, m[sg[ 2]], m[sg[ 3]]);
+        BLAKE3_G(2, 6, 10, 14, m[sg[ 4]], m[sg[ 5]]);
+        BLAKE3_G(3, 7, 11, 15, m[sg[ 6]], m[sg[ 7]]);
+        BLAKE3_G(0, 5, 10, 15, m[sg[ 8]], m[sg[ 9]]);
+        BLAKE3_G(1, 6, 11, 12, m[sg[10]], m[sg[11]]);
+        BLAKE3_G(2, 7,  8, 13, m[sg[12]], m[sg[13]]);
+        BLAKE3_G(3, 4,  9, 14, m[sg[14]], m[sg[15]]);
+    }
+
+    ForceZero(m, sizeof(m));
+}
+
+static void blake3_compress_in_place(word32* cv, const byte* block,
+    byte blockLen, word64 counter, byte flags)
+{
+    word32 s[16];
+    int i;
+
+    blake3_compress_pre(s, cv, block, blockLen, counter, flags);
+    for (i = 0; i < 8; i++)
+        cv[i] = s[i] ^ s[i + 8];
+}
+
+/* Compress to the full 64 bytes of state for root output. */
+static void blake3_compress_xof(const word32* cv, const byte* block,
+    byte blockLen, word64 counter, byte flags, byte* out)
+{
+    word32 s[16];
+    int i;
+
+    blake3_compress_pre(s, cv, block, blockLen, counter, flags);
+    for (i = 0; i < 8; i++) {
+        blake3_store32(out + 4 * i, s[i] ^ s[i + 8]);
+        blake3_store32(out + 32 + 4 * i, s[i + 8] ^ cv[i]);
+    }
+    ForceZero(s, sizeof(s));
+}
+
+/* Hash whole blocks of one input to a chaining value. */
+static void blake3_hash_one(const byte* input, word32 blocks,
+    const word32* key, word64 counter, byte flags, byte flagsStart,
+    byte flagsEnd, byte* out)
+{
+    word32 cv[8];
+    byte blockFlags = flags | flagsStart;
+
+    XMEMCPY(cv, key, sizeof(cv));
+    while (blocks > 0) {
+        if (blocks == 1)
+            blockFlags |= flagsEnd;
+        blake3_compress_in_place(cv, input, BLAKE3_BLOCKBYTES, counter,
+            blockFlags);
+        input += BLAKE3_BLOCKBYTES;
+        blocks--;
+        blockFlags = flags;
+    }
+    blake3_store_cv(out, cv);
+}
+
+/* Hash many inputs of the same number of blocks to chaining values. With
+ * incCounter the counter goes up by one for each input (chunks), otherwise
+ * every input uses the same counter (parents). */
+static void blake3_hash_many(const byte* const* inputs, word32 num,
+    word32 blocks, const word32* key, word64 counter, int incCounter,
+    byte flags, byte flagsStart, byte flagsEnd, byte* out)
+{
+#ifdef USE_INTEL_BLAKE3_SPEEDUP
+    word32 cpuid_flags = cpuid_get_flags();
+    word32 packed = (word32)flags | ((word32)flagsStart << 8) |
+                    ((word32)flagsEnd << 16);
+    word32 counters[2 * BLAKE3_MAX_SIMD_DEGREE];
+    word32 i;
+
+#ifndef NO_AVX2_SUPPORT
+    if (IS_INTEL_AVX2(cpuid_flags) && (num >= 8) &&
+            (SAVE_VECTOR_REGISTERS2() == 0)) {
+        while (num >= 8) {
+            for (i = 0; i < 8; i++) {
+                word64 c = counter + (incCounter ? i : 0);
+                counters[i] = (word32)c;
+                counters[8 + i] = (word32)(c >> 32);
+            }
+            blake3_hash_many_avx2(inputs, blocks, key, counters, packed, out);
+            if (incCounter)
+                counter += 8;
+            inputs += 8;
+            num -= 8;
+            out += 8 * BLAKE3_OUTBYTES;
+        }
+        RESTORE_VECTOR_REGISTERS();
+    }
+#endif
+    if (IS_INTEL_AVX1(cpuid_flags) && (num >= 4) &&
+            (SAVE_VECTOR_REGISTERS2() == 0)) {
+        while (num >= 4) {
+            for (i = 0; i < 4; i++) {
+                word64 c = counter + (incCounter ? i : 0);
+                counters[i] = (word32)c;
+                counters[4 + i] = (word32)(c >> 32);
+            }
+            blake3_hash_many_avx1(inputs, blocks, key, counters, packed, out);
+            if (incCounter)
+                counter += 4;
+            inputs += 4;
+            num -= 4;
+            out += 4 * BLAKE3_OUTBYTES;
+        }
+        RESTORE_VECTOR_REGISTERS();
+    }
+#endif
+
+    while (num > 0) {
+        blake3_hash_one(*inputs, blocks, key, counter, flags, flagsStart,
+            flagsEnd, out);
+        if (incCounter)
+            counter++;
+        inputs++;
+        num--;
+        out += BLAKE3_OUTBYTES;
+    }
+}
+
+/* Number of chunks hashed at once. */
+static word32 blake3_simd_degree(void)
+{
+#ifdef USE_INTEL_BLAKE3_SPEEDUP
+    word32 cpuid_flags = cpuid_get_flags();
+
+#ifndef NO_AVX2_SUPPORT
+    if (IS_INTEL_AVX2(cpuid_flags))
+        return 8;
+#endif
+    if (IS_INTEL_AVX1(cpuid_flags))
+        return 4;
+#endif
+    return 1;
+}
+
+/* Chaining value of a chunk of 1 to BLAKE3_CHUNKBYTES bytes. */
+static void blake3_chunk_cv(const byte* input, word32 len, const word32* key,
+    word64 counter, byte flags, byte* out)
+{
+    word32 cv[8];
+    byte block[BLAKE3_BLOCKBYTES];
+    byte blockFlags = flags | BLAKE3_CHUNK_START;
+
+    XMEMCPY(cv, key, sizeof(cv));
+    while (len > BLAKE3_BLOCKBYTES) {
+        blake3_compress_in_place(cv, input, BLAKE3_BLOCKBYTES, counter,
+            blockFlags);
+        input += BLAKE3_BLOCKBYTES;
+        len -= BLAKE3_BLOCKBYTES;
+        blockFlags = flags;
+    }
+    XMEMSET(block, 0, sizeof(block));
+    XMEMCPY(block, input, len);
+    blake3_compress_in_place(cv, block, (byte)len, counter,
+        blockFlags | BLAKE3_CHUNK_END);
+    blake3_store_cv(out, cv);
+}
+
+/* Hash up to BLAKE3_MAX_SIMD_DEGREE chunks to chaining values. */
+static word32 blake3_compress_chunks_parallel(const byte* input, word64 len,
+    const word32* key, word64 counter, byte flags, byte* out)
+{
+    const byte* chunks[BLAKE3_MAX_SIMD_DEGREE];
+    word32 n = 0;
+
+    while (len >= BLAKE3_CHUNKBYTES) {
+        chunks[n++] = input;
+        input += BLAKE3_CHUNKBYTES;
+        len -= BLAKE3_CHUNKBYTES;
+    }
+    if (n > 0) {
+        blake3_hash_many(chunks, n, BLAKE3_CHUNKBYTES / BLAKE3_BLOCKBYTES,
+            key, counter, 1, flags, BLAKE3_CHUNK_START, BLAKE3_CHUNK_END, out);
+    }
+    if (len > 0) {
+        blake3_chunk_cv(input, (word32)len, key, counter + n, flags,
+            out + n * BLAKE3_OUTBYTES);
+        n++;
+    }
+    return n;
+}
+
+/* Hash pairs of chaining values to their parents. An odd one is passed up
+ * unchanged. */
+static word32 blake3_compress_parents_parallel(const byte* cvs, word32 num,
+    const word32* key, byte flags, byte* out)
+{
+    const byte* parents[BLAKE3_MAX_SIMD_DEGREE];
+    word32 n = 0;
+
+    while (num - 2 * n >= 2) {
+        parents[n] = cvs + 2 * n * BLAKE3_OUTBYTES;
+        n++;
+    }
+    blake3_hash_many(parents, n, 1, key, 0, 0, flags | BLAKE3_PARENT, 0, 0,
+        out);
+    if (num > 2 * n) {
+        XMEMCPY(out + n * BLAKE3_OUTBYTES, cvs + 2 * n * BLAKE3_OUTBYTES,
+            BLAKE3_OUTBYTES);
+        n++;
+    }
+    return n;
+}
+
+static word64 blake3_round_down_pow2(word64 x)
+{
+    word64 p = 1;
+
+    while ((p << 1) != 0 && (p << 1) <= x)
+        p <<= 1;
+    return p;
+}
+
+/* Largest power of two number of chunks, less than all of them, in bytes. */
+static word64 blake3_left_len(word64 len)
+{
+    word64 chunks = (len - 1) / BLAKE3_CHUNKBYTES;
+
+    return blake3_round_down_pow2(chunks) * BLAKE3_CHUNKBYTES;
+}
+
+static word32 blake3_compress_subtree_wide(const byte* input, word64 len,
+    const word32* key, word64 counter, byte flags, byte* out, word32 threads);
+
+#ifdef BLAKE3_THREADS
+typedef struct Blake3Subtree {
+    const byte*   input;
+    word64        len;
+    const word32* key;
+    word64        counter;
+    byte*         out;
+    word32        threads;
+    word32        num;
+    byte          flags;
+} Blake3Subtree;
+
+static THREAD_RETURN WOLFSSL_THREAD blake3_subtree_thread(void* arg)
+{
+    Blake3Subtree* t = (Blake3Subtree*)arg;
+
+    t->num = blake3_compress_subtree_wide(t->input, t->len, t->key,
+        t->counter, t->flags, t->out, t->threads);
+    WOLFSSL_RETURN_FROM_THREAD(0);
+}
+#endif
+
+/* Hash a subtree to at most BLAKE3_MAX_SIMD_DEGREE chaining values, or two
+ * when there is no SIMD, without ever reaching the root. */
+static word32 blake3_compress_subtree_wide(const byte* input, word64 len,
+    const word32* key, word64 counter, byte flags, byte* out, word32 threads)
+{
+    byte cvs[2 * BLAKE3_MAX_SIMD_DEGREE * BLAKE3_OUTBYTES];
+    word64 leftLen;
+    word32 degree = blake3_simd_degree();
+    word32 leftNum;
+    word32 rightNum;
+    byte* rightCvs;
+
+    if (len <= (word64)degree * BLAKE3_CHUNKBYTES) {
+        return blake3_compress_chunks_parallel(input, len, key, counter,
+            flags, out);
+    }
+
+    leftLen = blake3_left_len(len);
+    if ((leftLen > BLAKE3_CHUNKBYTES) && (degree == 1))
+        degree = 2;
+    rightCvs = cvs + degree * BLAKE3_OUTBYTES;
+
+#ifdef BLAKE3_THREADS
+    if ((threads > 1) && (leftLen >= WOLFSSL_BLAKE3_THREAD_MIN)) {
+        Blake3Subtree right;
+        THREAD_TYPE tid;
+
+        right.input = input + leftLen;
+        right.len = len - leftLen;
+        right.key = key;
+        right.counter = counter + leftLen / BLAKE3_CHUNKBYTES;
+        right.out = rightCvs;
+        right.threads = threads - threads / 2;
+        right.flags = flags;
+        if (wolfSSL_NewThread(&tid, blake3_subtree_thread, &right) == 0) {
+            leftNum = blake3_compress_subtree_wide(input, leftLen, key,
+                counter, flags, cvs, threads / 2);
+            (void)wolfSSL_JoinThread(tid);
+            rightNum = right.num;
+        }
+        else {
+            leftNum = blake3_compress_subtree_wide(input, leftLen, key,
+                counter, flags, cvs, 1);
+            (void)blake3_subtree_thread(&right);
+            rightNum = right.num;
+        }
+    }
+    else
+#endif
+    {
+        leftNum = blake3_compress_subtree_wide(input, leftLen, key, counter,
+            flags, cvs, threads);
+        rightNum = blake3_compress_subtree_wide(input + leftLen,
+            len - leftLen, key, counter + leftLen / BLAKE3_CHUNKBYTES, flags,
+            rightCvs, threads);
+    }
+
+    /* A single chunk on the left means one on the right too - keep both so
+     * the caller always gets at least two. */
+    if (leftNum == 1) {
+        XMEMCPY(out, cvs, 2 * BLAKE3_OUTBYTES);
+        return 2;
+    }
+    return blake3_compress_parents_parallel(cvs, leftNum + rightNum, key,
+        flags, out);
+}
+
+/* Hash a subtree of more than one chunk down to the two children of its
+ * top node. */
+static void blake3_compress_subtree_to_parent_node(const byte* input,
+    word64 len, const word32* key, word64 counter, byte flags, byte* out,
+    word32 threads)
+{
+    byte cvs[BLAKE3_MAX_SIMD_DEGREE * BLAKE3_OUTBYTES];
+    byte parents[BLAKE3_MAX_SIMD_DEGREE * BLAKE3_OUTBYTES / 2];
+    word32 num;
+
+    num = blake3_compress_subtree_wide(input, len, key, counter, flags, cvs,
+        threads);
+    while (num > 2) {
+        num = blake3_compress_parents_parallel(cvs, num, key, flags, parents);
+        XMEMCPY(cvs, parents, num * BLAKE3_OUTBYTES);
+    }
+    XMEMCPY(out, cvs, 2 * BLAKE3_OUTBYTES);
+}
+
+static void blake3_output_cv(const Blake3Output* o, byte* out)
+{
+    word32 cv[8];
+
+    XMEMCPY(cv, o->cv, sizeof(cv));
+    blake3_compress_in_place(cv, o->block, o->blockLen, o->counter, o->flags);
+    blake3_store_cv(out, cv);
+}
+
+/* Root output bytes from seek onwards. */
+static void blake3_output_root(const Blake3Output* o, word64 seek, byte* out,
+    word32 outSz)
+{
+    byte wide[2 * BLAKE3_OUTBYTES];
+    word64 counter = seek / sizeof(wide);
+    word32 offset = (word32)(seek % sizeof(wide));
+
+    while (outSz > 0) {
+        word32 n = (word32)sizeof(wide) - offset;
+
+        if (n > outSz)
+            n = outSz;
+        blake3_compress_xof(o->cv, o->block, o->blockLen, counter,
+            o->flags | BLAKE3_ROOT, wide);
+        XMEMCPY(out, wide + offset, n);
+        out += n;
+        outSz -= n;
+        counter++;
+        offset = 0;
+    }
+    ForceZero(wide, sizeof(wide));
+}
+
+static void blake3_parent_output(const byte* block, const word32* key,
+    byte flags, Blake3Output* o)
+{
+    XMEMCPY(o->cv, key, sizeof(o->cv));
+    XMEMCPY(o->block, block, BLAKE3_BLOCKBYTES);
+    o->blockLen = BLAKE3_BLOCKBYTES;
+    o->counter = 0;
+    o->flags = flags | BLAKE3_PARENT;
+}
+
+static word32 blake3_chunk_len(const Blake3* b3)
+{
+    return (word32)b3->blocksCompressed * BLAKE3_BLOCKBYTES + b3->bufLen;
+}
+
+static void blake3_chunk_reset(Blake3* b3, word64 counter)
+{
+    XMEMCPY(b3->cv, b3->key, sizeof(b3->cv));
+    b3->chunkCounter = counter;
+    XMEMSET(b3->buf, 0, sizeof(b3->buf));
+    b3->bufLen = 0;
+    b3->blocksCompressed = 0;
+}
+
+static byte blake3_chunk_start(const Blake3* b3)
+{
+    return (b3->blocksCompressed == 0) ? BLAKE3_CHUNK_START : 0;
+}
+
+/* Add to the current chunk, which must not overflow. The last block is kept
+ * buffered as it may be the end of the chunk. */
+static void blake3_chunk_update(Blake3* b3, const byte* input, word32 len)
+{
+    if (b3->bufLen > 0) {
+        word32 take = BLAKE3_BLOCKBYTES - b3->bufLen;
+
+        if (take > len)
+            take = len;
+        XMEMCPY(b3->buf + b3->bufLen, input, take);
+        b3->bufLen += (byte)take;
+        input += take;
+        len -= take;
+        if (len > 0) {
+            blake3_compress_in_place(b3->cv, b3->buf, BLAKE3_BLOCKBYTES,
+                b3->chunkCounter, b3->flags | blake3_chunk_start(b3));
+            b3->blocksCompressed++;
+            b3->bufLen = 0;
+            XMEMSET(b3->buf, 0, sizeof(b3->buf));
+        }
+    }
+    while (len > BLAKE3_BLOCKBYTES) {
+        blake3_compress_in_place(b3->cv, input, BLAKE3_BLOCKBYTES,
+            b3->chunkCounter, b3->flags | blake3_chunk_start(b3));
+        b3->blocksCompressed++;
+        input += BLAKE3_BLOCKBYTES;
+        len -= BLAKE3_BLOCKBYTES;
+    }
+    if (len > 0) {
+        XMEMCPY(b3->buf + b3->bufLen, input, len);
+        b3->bufLen += (byte)len;
+    }
+}
+
+static void blake3_chunk_output(const Blake3* b3, Blake3Output* o)
+{
+    XMEMCPY(o->cv, b3->cv, sizeof(o->cv));
+    XMEMCPY(o->block, b3->buf, BLAKE3_BLOCKBYTES);
+    o->blockLen = b3->bufLen;
+    o->counter = b3->chunkCounter;
+    o->flags = b3->flags | blake3_chunk_start(b3) | BLAKE3_CHUNK_END;
+}
+
+/* Merge the chaining values on the stack into parents until there is one
+ * per set bit of the number of chunks. The last merge is left until more
+ * input or the final call shows whether it is the root. */
+static void blake3_merge_cv_stack(Blake3* b3, word64 totalChunks)
+{
+    byte postMerge = 0;
+    Blake3Output o;
+
+    while (totalChunks != 0) {
+        postMerge += (byte)(totalChunks & 1);
+        totalChunks >>= 1;
+    }
+    while (b3->cvStackLen > postMerge) {
+        byte* left = b3->cvStack + (b3->cvStackLen - 2) * BLAKE3_OUTBYTES;
+
+        blake3_parent_output(left, b3->key, b3->flags, &o);
+        blake3_output_cv(&o, left);
+        b3->cvStackLen--;
+    }
+}
+
+static void blake3_push_cv(Blake3* b3, const byte* cv, word64 chunkCounter)
+{
+    blake3_merge_cv_stack(b3, chunkCounter);
+    XMEMCPY(b3->cvStack + b3->cvStackLen * BLAKE3_OUTBYTES, cv,
+        BLAKE3_OUTBYTES);
+    b3->cvStackLen++;
+}
+
+static void blake3_init_key_words(Blake3* b3, const word32* key, byte flags,
+    word32 digestSz)
+{
+    XMEMCPY(b3->key, key, sizeof(b3->key));
+    b3->flags = flags;
+    b3->cvStackLen = 0;
+    b3->digestSz = digestSz;
+#ifdef BLAKE3_THREADS
+    b3->threads = 1;
+#endif
+    blake3_chunk_reset(b3, 0);
+}
+
+static void blake3_update(Blake3* b3, const byte* input, word32 len)
+{
+    word32 threads = 1;
+    byte cv[2 * BLAKE3_OUTBYTES];
+
+#ifdef BLAKE3_THREADS
+    threads = b3->threads;
+#endif
+
+    /* Finish the chunk already started. */
+    if (blake3_chunk_len(b3) > 0) {
+        word32 take = BLAKE3_CHUNKBYTES - blake3_chunk_len(b3);
+        Blake3Output o;
+
+        if (take > len)
+            take = len;
+        blake3_chunk_update(b3, input, take);
+        input += take;
+        len -= take;
+        if (len == 0)
+            return;
+        blake3_chunk_output(b3, &o);
+        blake3_output_cv(&o, cv);
+        blake3_push_cv(b3, cv, b3->chunkCounter);
+        blake3_chunk_reset(b3, b3->chunkCounter + 1);
+    }
+
+    /* Hash the largest whole subtrees the chunk counter allows, keeping the
+     * last chunk back as it may be the root. */
+    while (len > BLAKE3_CHUNKBYTES) {
+        word64 subtreeLen = blake3_round_down_pow2(len);
+        word64 countSoFar = b3->chunkCounter * BLAKE3_CHUNKBYTES;
+        word64 subtreeChunks;
+
+        while (((subtreeLen - 1) & countSoFar) != 0)
+            subtreeLen >>= 1;
+        subtreeChunks = subtreeLen / BLAKE3_CHUNKBYTES;
+
+        if (subtreeLen <= BLAKE3_CHUNKBYTES) {
+            blake3_chunk_cv(input, (word32)subtreeLen, b3->key,
+                b3->chunkCounter, b3->flags, cv);
+            blake3_push_cv(b3, cv, b3->chunkCounter);
+        }
+        else {
+            blake3_compress_subtree_to_parent_node(input, subtreeLen, b3->key,
+                b3->chunkCounter, b3->flags, cv, threads);
+            blake3_push_cv(b3, cv, b3->chunkCounter);
+            blake3_push_cv(b3, cv + BLAKE3_OUTBYTES,
+                b3->chunkCounter + subtreeChunks / 2);
+        }
+        blake3_chunk_reset(b3, b3->chunkCounter + subtreeChunks);
+        input += subtreeLen;
+        len -= (word32)subtreeLen;
+    }
+
+    if (len > 0) {
+        blake3_chunk_update(b3, input, len);
+        blake3_merge_cv_stack(b3, b3->chunkCounter);
+    }
+}
+
+static void blake3_final(const Blake3* b3, word64 seek, byte* out,
+    word32 outSz)
+{
+    Blake3Output o;
+    byte block[BLAKE3_BLOCKBYTES];
+    int remaining;
+
+    if (b3->cvStackLen == 0) {
+        blake3_chunk_output(b3, &o);
+        blake3_output_root(&o, seek, out, outSz);
+        return;
+    }
+
+    if (blake3_chunk_len(b3) > 0) {
+        blake3_chunk_output(b3, &o);
+        remaining = b3->cvStackLen;
+    }
+    else {
+        blake3_parent_output(
+            b3->cvStack + (b3->cvStackLen - 2) * BLAKE3_OUTBYTES, b3->key,
+            b3->flags, &o);
+        remaining = b3->cvStackLen - 2;
+    }
+    while (remaining > 0) {
+        remaining--;
+        XMEMCPY(block, b3->cvStack + remaining * BLAKE3_OUTBYTES,
+            BLAKE3_OUTBYTES);
+        blake3_output_cv(&o, block + BLAKE3_OUTBYTES);
+        blake3_parent_output(block, b3->key, b3->flags, &o);
+    }
+    blake3_output_root(&o, seek, out, outSz);
+}
+
+
+/* wolfCrypt API */
+
+/* Init Blake3 digest, track size in case final doesn't want to "remember" */
+int wc_InitBlake3(Blake3* b3, word32 digestSz)
+{
+    if (b3 == NULL || digestSz == 0) {
+        return BAD_FUNC_ARG;
+    }
+
+    blake3_init_key_words(b3, blake3_IV, 0, digestSz);
+
+    return 0;
+}
+
+/* Init Blake3 keyed hash, the key is always BLAKE3_KEYBYTES bytes */
+int wc_InitBlake3_WithKey(Blake3* b3, word32 digestSz, const byte *key,
+                          word32 keylen)
+{
+    word32 k[BLAKE3_KEYBYTES / sizeof(word32)];
+    int i;
+
+    if (b3 == NULL || digestSz == 0 || key == NULL ||
+            keylen != BLAKE3_KEYBYTES) {
+        return BAD_FUNC_ARG;
+    }
+
+    for (i = 0; i < (int)(BLAKE3_KEYBYTES / sizeof(word32)); i++)
+        k[i] = blake3_load32(key + 4 * i);
+    blake3_init_key_words(b3, k, BLAKE3_KEYED_HASH, digestSz);
+    ForceZero(k, sizeof(k));
+
+    return 0;
+}
+
+/* Init Blake3 key derivation: the context string is hashed to the key that
+ * the key material is then hashed with. */
+int wc_InitBlake3_DeriveKey(Blake3* b3, word32 digestSz, const byte* context,
+                            word32 contextSz)
+{
+    byte ctxKey[BLAKE3_KEYBYTES];
+    word32 k[BLAKE3_KEYBYTES / sizeof(word32)];
+    int i;
+
+    if (b3 == NULL || digestSz == 0 || (context == NULL && contextSz > 0)) {
+        return BAD_FUNC_ARG;
+    }
+
+    blake3_init_key_words(b3, blake3_IV, BLAKE3_DERIVE_KEY_CONTEXT, digestSz);
+    if (contextSz > 0)
+        blake3_update(b3, context, contextSz);
+    blake3_final(b3, 0, ctxKey, sizeof(ctxKey));
+
+    for (i = 0; i < (int)(BLAKE3_KEYBYTES / sizeof(word32)); i++)
+        k[i] = blake3_load32(ctxKey + 4 * i);
+    blake3_init_key_words(b3, k, BLAKE3_DERIVE_KEY_MATERIAL, digestSz);
+    ForceZero(ctxKey, sizeof(ctxKey));
+    ForceZero(k, sizeof(k));
+
+    return 0;
+}
+
+/* Blake3 Update */
+int wc_Blake3Update(Blake3* b3, const byte* data, word32 sz)
+{
+    if (b3 == NULL || (data == NULL && sz > 0)) {
+        return BAD_FUNC_ARG;
+    }
+
+    if (sz > 0)
+        blake3_update(b3, data, sz);
+
+    return 0;
+}
+
+/* Blake3 Final, if pass in zero size we use init digestSz. Any size may be
+ * requested and the state is left as it is so more data may be added. */
+int wc_Blake3Final(Blake3* b3, byte* final, word32 requestSz)
+{
+    return wc_Blake3FinalXof(b3, 0, final,
+        (b3 != NULL && requestSz == 0) ? b3->digestSz : requestSz);
+}
+
+/* Blake3 extendable output of outSz bytes starting seek bytes in */
+int wc_Blake3FinalXof(Blake3* b3, word64 seek, byte* out, word32 outSz)
+{
+    if (b3 == NULL || (out == NULL && outSz > 0)) {
+        return BAD_FUNC_ARG;
+    }
+
+    blake3_final(b3, seek, out, outSz);
+
+    return 0;
+}
+
+#ifdef BLAKE3_THREADS
+/* Hash large updates on up to threads threads */
+int wc_Blake3SetThreads(Blake3* b3, word32 threads)
+{
+    if (b3 == NULL || threads == 0) {
+        return BAD_FUNC_ARG;
+    }
+
+    b3->threads = threads;
+
+    return 0;
+}
+#endif
+
+
+/* end CTaoCrypt API */
+
+#endif  /* HAVE_BLAKE3 */
@@ -46,6 +46,64 @@ or Authenticated Encryption with Additional Data (AEAD) algorithm.
 #include <wolfcrypt/src/misc.c>
 #endif
 
+#ifdef USE_INTEL_CHACHA_SPEEDUP
+    #include <wolfssl/wolfcrypt/cpuid.h>
+
+    #if defined(__GNUC__) && ((__GNUC__ < 4) || \
+                              (__GNUC__ == 4 && __GNUC_MINOR__ <= 8))
+        #undef  NO_AVX2_SUPPORT
+        #define NO_AVX2_SUPPORT
+    #endif
+    #if defined(__clang__) && ((__clang_major__ < 3) || \
+                               (__clang_major__ == 3 && __clang_minor__ <= 5))
+        #undef  NO_AVX2_SUPPORT
+        #define NO_AVX2_SUPPORT
+    #elif defined(__clang__) && defined(NO_AVX2_SUPPORT)
+        #undef NO_AVX2_SUPPORT
+    #endif
+
+    #ifndef NO_AVX2_SUPPORT
+        /* ChaCha20 and Poly1305 in one pass over the data */
+        #define WC_CHACHA20_POLY1305_STITCH
+    #endif
+#endif
+
+#ifdef WC_CHACHA20_POLY1305_STITCH
+/* Bytes handled by one iteration of the stitched kernels: 8 ChaCha blocks */
+#define CHACHA20_POLY1305_STITCH_BYTES  512
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+/* Encrypt whole 512 byte chunks and hash the ciphertext with Poly1305.
+ * The Poly1305 of a chunk is interleaved with the ChaCha20 of the next.
+ *
+ * chacha  ChaCha context with no key stream left over.
+ * poly    Poly1305 context with h as the only accumulator.
+ * m       Plaintext.
+ * c       Buffer to hold ciphertext.
+ * bytes   Multiple of 512 bytes to process.
+ */
+extern void chacha20_poly1305_encrypt_avx2(ChaCha* chacha, Poly1305* poly,
+    const byte* m, byte* c, word32 bytes);
+/* Hash whole 512 byte chunks of ciphertext with Poly1305 and decrypt them.
+ * The Poly1305 and the ChaCha20 of each chunk are interleaved.
+ *
+ * chacha  ChaCha context with no key stream left over.
+ * poly    Poly1305 context with h as the only accumulator.
+ * c       Ciphertext.
+ * m       Buffer to hold plaintext.
+ * bytes   Multiple of 512 bytes to process.
+ */
+extern void chacha20_poly1305_decrypt_avx2(ChaCha* chacha, Poly1305* poly,
+    const byte* c, byte* m, word32 bytes);
+
+#ifdef __cplusplus
+    }  /* extern "C" */
+#endif
+#endif /* WC_CHACHA20_POLY1305_STITCH */
+
 #define CHACHA20_POLY1305_AEAD_INITIAL_COUNTER  0
 WOLFSSL_ABI
 int wc_ChaCha20Poly1305_Encrypt(
@@ -211,6 +269,77 @@ int wc_ChaCha20Poly1305_UpdateAad(ChaChaPoly_Aead* aead,
     return ret;
 }
 
+/* ChaCha20 the data and Poly1305 the ciphertext in two passes. */
+static int chacha20_poly1305_crypt_two_pass(ChaChaPoly_Aead* aead,
+    const byte* inData, byte* outData, word32 dataLen)
+{
+    int ret;
+
+    if (aead->isEncrypt) {
+        ret = wc_Chacha_Process(&aead->chacha, outData, inData, dataLen);
+        if (ret == 0)
+            ret = wc_Poly1305Update(&aead->poly, outData, dataLen);
+    }
+    else {
+        ret = wc_Poly1305Update(&aead->poly, inData, dataLen);
+        if (ret == 0)
+            ret = wc_Chacha_Process(&aead->chacha, outData, inData, dataLen);
+    }
+
+    return ret;
+}
+
+/* ChaCha20 the data and Poly1305 the ciphertext.
+ * Whole 512 byte chunks go through the stitched AVX2 kernel, when available,
+ * so that each chunk is only read once. */
+static int chacha20_poly1305_crypt(ChaChaPoly_Aead* aead,
+    const byte* inData, byte* outData, word32 dataLen)
+{
+    int ret = 0;
+#ifdef WC_CHACHA20_POLY1305_STITCH
+    word32 len;
+
+    if (IS_INTEL_AVX2(cpuid_get_flags()) &&
+            (dataLen >= CHACHA20_POLY1305_STITCH_BYTES)) {
+        /* Use up the key stream left over from the last call. The data is
+         * then on a ChaCha block and so a Poly1305 block boundary. */
+        len = min(aead->chacha.left, dataLen);
+        if (len > 0) {
+            ret = chacha20_poly1305_crypt_two_pass(aead, inData, outData, len);
+            inData += len;
+            outData += len;
+            dataLen -= len;
+        }
+
+        len = dataLen & ~((word32)CHACHA20_POLY1305_STITCH_BYTES - 1);
+        if ((ret == 0) && (len > 0)) {
+            ret = wc_Poly1305_UseScalar(&aead->poly);
+        }
+        if ((ret == 0) && (len > 0) && (aead->poly.leftover == 0)) {
+            SAVE_VECTOR_REGISTERS(return _svr_ret;);
+            if (aead->isEncrypt) {
+                chacha20_poly1305_encrypt_avx2(&aead->chacha, &aead->poly,
+                    inData, outData, len);
+            }
+            else {
+                chacha20_poly1305_decrypt_avx2(&aead->chacha, &aead->poly,
+                    inData, outData, len);
+            }
+            RESTORE_VECTOR_REGISTERS();
+            inData += len;
+            outData += len;
+            dataLen -= len;
+        }
+    }
+#endif
+
+    if ((ret == 0) && (dataLen > 0)) {
+        ret = chacha20_poly1305_crypt_two_pass(aead, inData, outData, dataLen);
+    }
+
+    return ret;
+}
+
 /* inData and outData can be same pointer (inline) */
 int wc_ChaCha20Poly1305_UpdateData(ChaChaPoly_Aead* aead,
     const byte* inData, byte* outData, word32 dataLen)
@@ -238,16 +367,7 @@ int wc_ChaCha20Poly1305_UpdateData(ChaChaPoly_Aead* aead,
 
     /* Perform ChaCha20 encrypt/decrypt and Poly1305 auth calc */
     if (ret == 0) {
-        if (aead->isEncrypt) {
-            ret = wc_Chacha_Process(&aead->chacha, outData, inData, dataLen);
-            if (ret == 0)
-                ret = wc_Poly1305Update(&aead->poly, outData, dataLen);
-        }
-        else {
-            ret = wc_Poly1305Update(&aead->poly, inData, dataLen);
-            if (ret == 0)
-                ret = wc_Chacha_Process(&aead->chacha, outData, inData, dataLen);
-        }
+        ret = chacha20_poly1305_crypt(aead, inData, outData, dataLen);
     }
     if (ret == 0) {
         aead->dataLen += dataLen;
@@ -382,7 +502,8 @@ static WC_INLINE int wc_XChaCha20Poly1305_crypt_oneshot(
 
     if ((ret = wc_XChaCha20Poly1305_Init(aead, ad, (word32)ad_len,
                                          nonce, (word32)nonce_len,
-                                         key, (word32)key_len, 1)) < 0)
+                                         key, (word32)key_len,
+                                         isEncrypt)) < 0)
         goto out;
 
 #ifdef WOLFSSL_CHECK_MEM_ZERO
@@ -402,10 +523,8 @@ static WC_INLINE int wc_XChaCha20Poly1305_crypt_oneshot(
             16384 :
             (word32)src_len_rem;
 
-        if ((ret = wc_Chacha_Process(&aead->chacha, dst_i, src_i, this_src_len)) < 0)
-            goto out;
-
-        if ((ret = wc_Poly1305Update(&aead->poly, isEncrypt ? dst_i : src_i, this_src_len)) < 0)
+        if ((ret = chacha20_poly1305_crypt(aead, src_i, dst_i,
+                                           this_src_len)) < 0)
             goto out;
 
         src_len_rem -= (size_t)this_src_len;
@@ -65,6 +65,8 @@ Possible DH enable options:
                         disable the prime checking.           default: off
  * WOLFSSL_VALIDATE_DH_KEYGEN: Enable DH key gen consistency checking
  *                             (on for FIPS 140-3 or later)   default: off
+ * WOLFSSL_DH_COMB:     Cache fixed-base comb tables for the generator of
+ *                      named groups and use them in key gen  default: off
 */
 
 
@@ -932,6 +934,209 @@ const DhParams* wc_Dh_ffdhe8192_Get(void)
 #endif
 #endif
 
+#ifdef WOLFSSL_DH_COMB
+#ifndef WOLFSSL_DH_COMB_TEETH
+    /* Exponent bits handled in each step: tables have 2^teeth entries. */
+    #define WOLFSSL_DH_COMB_TEETH   6
+#endif
+#ifndef WOLFSSL_DH_COMB_TABLES
+    /* Tables for different exponent lengths kept per group. */
+    #define WOLFSSL_DH_COMB_TABLES  4
+#endif
+
+/* Fixed-base comb tables for the generator of a named group.
+ *
+ * Tables are built on first use and never change after being published, so
+ * they are used without holding the lock. They are freed by wc_DhCombFree().
+ */
+typedef struct DhComb {
+    const byte*  p;                             /* Prime, big-endian. */
+    word32       pSz;                           /* Size of prime in bytes. */
+    unsigned int used;                          /* Digits in prime. */
+    mp_digit*    prime;                         /* Digits of prime. */
+    int          bits[WOLFSSL_DH_COMB_TABLES];  /* Most exponent bits. */
+    mp_digit*    table[WOLFSSL_DH_COMB_TABLES]; /* Comb tables. */
+} DhComb;
+
+static DhComb dhComb[] = {
+#ifdef HAVE_FFDHE_2048
+    { dh_ffdhe2048_p, sizeof(dh_ffdhe2048_p), 0, NULL, { 0 }, { NULL } },
+#endif
+#ifdef HAVE_FFDHE_3072
+    { dh_ffdhe3072_p, sizeof(dh_ffdhe3072_p), 0, NULL, { 0 }, { NULL } },
+#endif
+#ifdef HAVE_FFDHE_4096
+    { dh_ffdhe4096_p, sizeof(dh_ffdhe4096_p), 0, NULL, { 0 }, { NULL } },
+#endif
+#ifdef HAVE_FFDHE_6144
+    { dh_ffdhe6144_p, sizeof(dh_ffdhe6144_p), 0, NULL, { 0 }, { NULL } },
+#endif
+#ifdef HAVE_FFDHE_8192
+    { dh_ffdhe8192_p, sizeof(dh_ffdhe8192_p), 0, NULL, { 0 }, { NULL } },
+#endif
+    { NULL, 0, 0, NULL, { 0 }, { NULL } }
+};
+
+static volatile int dhCombInitMutex = 0;  /* prevent multiple mutex inits */
+static wolfSSL_Mutex dhCombLock;
+
+/* Initialize the lock protecting the comb tables. */
+void wc_DhCombInit(void)
+{
+    if (dhCombInitMutex == 0) {
+        wc_InitMutex(&dhCombLock);
+        dhCombInitMutex = 1;
+    }
+}
+
+/* Free all comb tables. No key generation may be in progress. */
+void wc_DhCombFree(void)
+{
+    int i;
+    int j;
+
+    if (dhCombInitMutex == 0) { /* extra sanity check if wolfCrypt_Init not called */
+        wc_InitMutex(&dhCombLock);
+        dhCombInitMutex = 1;
+    }
+
+    if (wc_LockMutex(&dhCombLock) == 0) {
+        for (i = 0; dhComb[i].p != NULL; i++) {
+            for (j = 0; j < WOLFSSL_DH_COMB_TABLES; j++) {
+                XFREE(dhComb[i].table[j], NULL, DYNAMIC_TYPE_DH);
+                dhComb[i].table[j] = NULL;
+                dhComb[i].bits[j] = 0;
+            }
+            XFREE(dhComb[i].prime, NULL, DYNAMIC_TYPE_DH);
+            dhComb[i].prime = NULL;
+            dhComb[i].used = 0;
+        }
+        wc_UnLockMutex(&dhCombLock);
+        wc_FreeMutex(&dhCombLock);
+        dhCombInitMutex = 0;
+    }
+}
+
+/* Check whether the prime of the key is the prime of a named group.
+ *
+ * Must be called with the lock held.
+ *
+ * key   DH key.
+ * comb  Comb tables of named group with prime of same size.
+ * returns 1 when the primes are the same and 0 otherwise.
+ */
+static int DhCombIsGroup(DhKey* key, DhComb* comb)
+{
+    int same = 0;
+    byte* buf;
+
+    if (comb->prime != NULL) {
+        return (key->p.used == comb->used) &&
+            (XMEMCMP(key->p.dp, comb->prime,
+                comb->used * sizeof(mp_digit)) == 0);
+    }
+
+    /* First use: compare encodings and keep digits for later checks. */
+    buf = (byte*)XMALLOC(comb->pSz, key->heap, DYNAMIC_TYPE_TMP_BUFFER);
+    if ((buf != NULL) &&
+            (mp_to_unsigned_bin_len(&key->p, buf, (int)comb->pSz) == MP_OKAY) &&
+            (XMEMCMP(buf, comb->p, comb->pSz) == 0)) {
+        comb->prime = (mp_digit*)XMALLOC(key->p.used * sizeof(mp_digit), NULL,
+            DYNAMIC_TYPE_DH);
+        if (comb->prime != NULL) {
+            XMEMCPY(comb->prime, key->p.dp, key->p.used * sizeof(mp_digit));
+            comb->used = key->p.used;
+            same = 1;
+        }
+    }
+    XFREE(buf, key->heap, DYNAMIC_TYPE_TMP_BUFFER);
+
+    return same;
+}
+
+/* Get a comb table to generate a public key with.
+ *
+ * Only named groups with a generator of 2 have tables. The table with the
+ * fewest exponent bits that covers the exponent is used. A new table is
+ * built when none is close to the exponent's length and there is room.
+ *
+ * key      DH key.
+ * bits     Number of bits in exponent.
+ * tblBits  Number of exponent bits the returned table handles.
+ * returns table or NULL when comb tables can't be used.
+ */
+static const mp_digit* DhCombGet(DhKey* key, int bits, int* tblBits)
+{
+    DhComb* comb = NULL;
+    const mp_digit* ret = NULL;
+    word32 pSz;
+    int i;
+    int best = -1;
+
+    if (mp_cmp_d(&key->g, 2) != MP_EQ) {
+        return NULL;
+    }
+    pSz = (word32)mp_unsigned_bin_size(&key->p);
+    for (i = 0; dhComb[i].p != NULL; i++) {
+        if (dhComb[i].pSz == pSz) {
+            comb = &dhComb[i];
+            break;
+        }
+    }
+    if (comb == NULL) {
+        return NULL;
+    }
+
+    if (dhCombInitMutex == 0) { /* extra sanity check if wolfCrypt_Init not called */
+        wc_DhCombInit();
+    }
+    if (wc_LockMutex(&dhCombLock) != 0) {
+        return NULL;
+    }
+
+    if (DhCombIsGroup(key, comb)) {
+        /* Smallest table covering exponent. */
+        for (i = 0; i < WOLFSSL_DH_COMB_TABLES; i++) {
+            if ((comb->table[i] != NULL) && (comb->bits[i] >= bits) &&
+                    ((best < 0) || (comb->bits[i] < comb->bits[best]))) {
+                best = i;
+            }
+        }
+        /* Build a table when best is missing or much longer than needed. */
+        if ((best < 0) || (comb->bits[best] > bits + bits / 4)) {
+            for (i = 0; i < WOLFSSL_DH_COMB_TABLES; i++) {
+                if (comb->table[i] == NULL) {
+                    break;
+                }
+            }
+            if (i < WOLFSSL_DH_COMB_TABLES) {
+                mp_digit* table = (mp_digit*)XMALLOC(
+                    ((size_t)1 << WOLFSSL_DH_COMB_TEETH) * comb->used *
+                    sizeof(mp_digit), NULL, DYNAMIC_TYPE_DH);
+                if ((table != NULL) && (mp_exptmod_comb_precomp(&key->g,
+                        &key->p, bits, WOLFSSL_DH_COMB_TEETH, table) ==
+                        MP_OKAY)) {
+                    comb->bits[i] = bits;
+                    comb->table[i] = table;
+                    best = i;
+                }
+                else {
+                    XFREE(table, NULL, DYNAMIC_TYPE_DH);
+                }
+            }
+        }
+        if (best >= 0) {
+            *tblBits = comb->bits[best];
+            ret = comb->table[best];
+        }
+    }
+
+    wc_UnLockMutex(&dhCombLock);
+
+    return ret;
+}
+#endif /* WOLFSSL_DH_COMB */
+
 int wc_InitDhKey_ex(DhKey* key, void* heap, int devId)
 {
     int ret = 0;
@@ -1299,6 +1504,10 @@ static int GeneratePublicDh(DhKey* key, byte* priv, word32 privSz,
     mp_int x[1];
     mp_int y[1];
 #endif
+#endif
+#ifdef WOLFSSL_DH_COMB
+    const mp_digit* table = NULL;
+    int tblBits = 0;
 #endif
 
     if (*pubSz < (word32)mp_unsigned_bin_size(&key->p)) {
@@ -1342,6 +1551,26 @@ static int GeneratePublicDh(DhKey* key, byte* priv, word32 privSz,
     if (mp_read_unsigned_bin(x, priv, privSz) != MP_OKAY)
         ret = MP_READ_E;
 
+#ifdef WOLFSSL_DH_COMB
+    if (ret == 0) {
+        /* Size the comb from public lengths only: the length of the private
+         * buffer and of q, when there is one, as the exponent is less than
+         * q. The length of the exponent itself must not pick the table or
+         * the number of iterations. */
+        int bits = (int)privSz * WOLFSSL_BIT_SIZE;
+        if (!mp_iszero(&key->q) && (mp_count_bits(&key->q) < bits)) {
+            bits = mp_count_bits(&key->q);
+        }
+        table = DhCombGet(key, bits, &tblBits);
+    }
+    if ((ret == 0) && (table != NULL)) {
+        if (mp_exptmod_comb(table, WOLFSSL_DH_COMB_TEETH, tblBits, x, &key->p,
+                y) != MP_OKAY) {
+            ret = MP_EXPTMOD_E;
+        }
+    }
+    else
+#endif
     if (ret == 0 && mp_exptmod(&key->g, x, &key->p, y) != MP_OKAY)
         ret = MP_EXPTMOD_E;
 
@@ -57,6 +57,9 @@ Possible ECC enable options:
  *                      SECP160K1 and SECP224K1. These do not work with scalars
  *                      that are the length of the order when the order is
  *                      longer than the prime. Use wc_ecc_fp_free to free cache.
+ * WOLFSSL_ECC_FP_SHARED: One FP cache for all threads, used without locks.
+ *                      FP_ENTRIES sets its size and FP_SHARED_PROBE the
+ *                      entries looked at for a point.          default: off
  * USE_ECC_B_PARAM:     Enable ECC curve B param                default: off
  *                      (on for HAVE_COMP_KEY)
  * WOLFSSL_ECC_CURVE_STATIC:                                    default off (on for windows)
@@ -5887,6 +5890,174 @@ int wc_ecc_make_key_ex(WC_RNG* rng, int keysize, ecc_key* key, int curve_id)
     return wc_ecc_make_key_ex2(rng, keysize, key, curve_id, WC_ECC_FLAG_NONE);
 }
 
+#ifdef WOLFSSL_ECC_KEYGEN_BATCH
+#if defined(WOLFSSL_SP_ECC_KEYGEN_BATCH) && !defined(WOLFSSL_ATECC508A) && \
+    !defined(WOLFSSL_ATECC608A) && !defined(WOLFSSL_SE050) && \
+    !defined(WOLFSSL_CRYPTOCELL) && !defined(WOLFSSL_SILABS_SE_ACCEL) && \
+    !defined(WOLFSSL_KCAPI_ECC) && !defined(WOLFSSL_XILINX_CRYPT_VERSAL) && \
+    !defined(WOLF_CRYPTO_CB_ONLY_ECC)
+    #define ECC_KEYGEN_BATCH_SP
+#endif
+
+#ifdef ECC_KEYGEN_BATCH_SP
+#ifndef WOLFSSL_ECC_KEYGEN_BATCH_MAX
+    /* Most keys sharing one inversion. */
+    #define WOLFSSL_ECC_KEYGEN_BATCH_MAX    64
+#endif
+
+/* Check whether the key can be made by the SP batch code.
+ *
+ * key  ECC key with curve set.
+ * returns 1 when it can and 0 otherwise.
+ */
+static int ecc_keygen_batch_sp(ecc_key* key)
+{
+    if (key->idx == ECC_CUSTOM_IDX)
+        return 0;
+#ifdef WOLF_CRYPTO_CB
+    if (key->devId != INVALID_DEVID)
+        return 0;
+#endif
+#if defined(WOLFSSL_ASYNC_CRYPT) && defined(WC_ASYNC_ENABLE_ECC)
+    if (key->asyncDev.marker == WOLFSSL_ASYNC_MARKER_ECC)
+        return 0;
+#endif
+#ifdef WC_ECC_NONBLOCK
+    if (key->nb_ctx != NULL)
+        return 0;
+#endif
+#ifndef WOLFSSL_SP_NO_256
+    if (ecc_sets[key->idx].id == ECC_SECP256R1)
+        return 1;
+#endif
+#ifdef WOLFSSL_SP_384
+    if (ecc_sets[key->idx].id == ECC_SECP384R1)
+        return 1;
+#endif
+    return 0;
+}
+
+/* Make up to WOLFSSL_ECC_KEYGEN_BATCH_MAX keys with SP code.
+ *
+ * The public points are converted to affine coordinates with one shared
+ * inversion.
+ */
+static int ecc_make_key_batch_sp(WC_RNG* rng, int keysize, ecc_key** key,
+    word32 cnt, int curve_id)
+{
+    int err = 0;
+    word32 i;
+    mp_int* priv[WOLFSSL_ECC_KEYGEN_BATCH_MAX];
+    ecc_point* pub[WOLFSSL_ECC_KEYGEN_BATCH_MAX];
+
+    for (i = 0; (err == 0) && (i < cnt); i++) {
+        wc_ecc_reset(key[i]);
+        err = wc_ecc_set_curve(key[i], keysize, curve_id);
+        if ((err == 0) && !ecc_keygen_batch_sp(key[i]))
+            err = NOT_COMPILED_IN;
+        if (err == 0) {
+            key[i]->flags = WC_ECC_FLAG_NONE;
+            priv[i] = key[i]->k;
+            pub[i] = &key[i]->pubkey;
+        }
+    }
+
+    if (err == 0) {
+        SAVE_VECTOR_REGISTERS(return _svr_ret;);
+    #ifndef WOLFSSL_SP_NO_256
+        if (ecc_sets[key[0]->idx].id == ECC_SECP256R1) {
+            err = sp_ecc_make_key_batch_256(rng, (int)cnt, priv, pub,
+                key[0]->heap);
+        }
+        else
+    #endif
+    #ifdef WOLFSSL_SP_384
+        if (ecc_sets[key[0]->idx].id == ECC_SECP384R1) {
+            err = sp_ecc_make_key_batch_384(rng, (int)cnt, priv, pub,
+                key[0]->heap);
+        }
+        else
+    #endif
+        {
+            err = NOT_COMPILED_IN;
+        }
+        RESTORE_VECTOR_REGISTERS();
+    }
+
+    for (i = 0; (err == 0) && (i < cnt); i++) {
+        key[i]->type = ECC_PRIVATEKEY;
+    #if FIPS_VERSION_GE(5,0) || defined(WOLFSSL_VALIDATE_ECC_KEYGEN)
+        err = _ecc_validate_public_key(key[i], 0, 0);
+        if (err == MP_OKAY) {
+            err = _ecc_pairwise_consistency_test(key[i], rng);
+        }
+    #endif
+    }
+    if (err != 0) {
+        for (i = 0; i < cnt; i++) {
+            mp_forcezero(key[i]->k);
+        }
+    }
+
+    return err;
+}
+#endif /* ECC_KEYGEN_BATCH_SP */
+
+/* Make cnt ECC keys on one curve.
+ *
+ * With SP code for P-256 and P-384 in 64-bit C, the public points of up to
+ * WOLFSSL_ECC_KEYGEN_BATCH_MAX keys share one modular inversion (Montgomery's
+ * trick). Otherwise, or when a key has a device or non-blocking context, the
+ * keys are made one at a time with wc_ecc_make_key_ex().
+ *
+ * rng       Random number generator.
+ * keysize   Size of keys in bytes.
+ * key       Array of initialized ECC keys.
+ * cnt       Number of keys.
+ * curve_id  Curve of keys.
+ * returns BAD_FUNC_ARG when a parameter is NULL, 0 on success and other
+ * negative values on error.
+ */
+int wc_ecc_make_key_batch(WC_RNG* rng, int keysize, ecc_key** key, word32 cnt,
+                          int curve_id)
+{
+    int err = 0;
+    word32 i;
+#ifdef ECC_KEYGEN_BATCH_SP
+    word32 n;
+#endif
+
+    if ((rng == NULL) || ((key == NULL) && (cnt > 0))) {
+        return BAD_FUNC_ARG;
+    }
+    for (i = 0; i < cnt; i++) {
+        if (key[i] == NULL) {
+            return BAD_FUNC_ARG;
+        }
+    }
+
+    i = 0;
+#ifdef ECC_KEYGEN_BATCH_SP
+    for (; (err == 0) && (i < cnt); i += n) {
+        n = cnt - i;
+        if (n > WOLFSSL_ECC_KEYGEN_BATCH_MAX)
+            n = WOLFSSL_ECC_KEYGEN_BATCH_MAX;
+        err = ecc_make_key_batch_sp(rng, keysize, key + i, n, curve_id);
+        if (err == NOT_COMPILED_IN) {
+            /* Curve or a key not supported - make keys one at a time. */
+            err = 0;
+            break;
+        }
+    }
+#endif
+    for (; (err == 0) && (i < cnt); i++) {
+        err = wc_ecc_make_key_ex(rng, keysize, key[i], curve_id);
+    }
+
+    return err;
+}
+#endif /* WOLFSSL_ECC_KEYGEN_BATCH */
+
 #ifdef ECC_DUMP_OID
 /* Optional dump of encoded OID for adding new curves */
 static int mOidDumpDone;
@@ -8226,6 +8397,382 @@ int ecc_mul2add(ecc_point* A, mp_int* kA,
 #endif /* (!WOLFSSL_SP_MATH && !WOLFSSL_ATECC508A && !WOLFSSL_ATECC608A &&
         * !WOLFSSL_CRYPTOCEL */
 
+#ifdef WOLFSSL_ECC_MULTI_SCALAR
+#if defined(WOLFSSL_SP_ECC_MULTI_SCALAR) && !defined(WOLFSSL_ATECC508A) && \
+    !defined(WOLFSSL_ATECC608A) && !defined(WOLFSSL_SE050) && \
+    !defined(WOLFSSL_CRYPTOCELL) && !defined(WOLFSSL_SILABS_SE_ACCEL) && \
+    !defined(WOLFSSL_KCAPI_ECC) && !defined(WOLFSSL_XILINX_CRYPT_VERSAL) && \
+    !defined(WOLF_CRYPTO_CB_ONLY_ECC)
+    #define ECC_MULTI_SCALAR_SP
+#endif
+#if !defined(WOLFSSL_SP_MATH) && !defined(WOLFSSL_ATECC508A) && \
+    !defined(WOLFSSL_ATECC608A) && !defined(WOLFSSL_CRYPTOCELL) && \
+    !defined(WOLFSSL_KCAPI_ECC) && !defined(WOLF_CRYPTO_CB_ONLY_ECC) && \
+    !defined(FREESCALE_LTC_ECC) && !defined(WOLFSSL_STM32_PKA)
+    #define ECC_MULTI_SCALAR_GENERIC
+#endif
+
+#ifdef ECC_MULTI_SCALAR_GENERIC
+/* Get the window size of Pippenger's method for a number of points.
+ *
+ * Each window adds every point into a bucket and then adds each of the
+ * 2^(c-1) buckets into two running sums.
+ *
+ * cnt   Number of points.
+ * bits  Number of bits in the scalars.
+ * returns the window size in bits with the fewest point additions.
+ */
+static int ecc_multi_window(word32 cnt, int bits)
+{
+    int c;
+    int best = 2;
+    word64 cost;
+    word64 bestCost = (word64)-1;
+
+    for (c = 2; c <= 16; c++) {
+        cost = (word64)((bits + c) / c) * ((word64)cnt + ((word64)1 << c));
+        if (cost < bestCost) {
+            bestCost = cost;
+            best = c;
+        }
+    }
+
+    return best;
+}
+
+/* Convert a big-endian scalar into signed digits of c bits.
+ *
+ * A window value of 2^(c-1) or more is made negative by carrying one into the
+ * next window. Digits are in the range -2^(c-1)..2^(c-1)-1.
+ *
+ * d    Signed digits, least significant first.
+ * k    Scalar as big-endian bytes.
+ * len  Number of bytes in k.
+ * c    Window size in bits - at most 16.
+ * w    Number of windows.
+ */
+static void ecc_multi_recode(short* d, const byte* k, int len, int c, int w)
+{
+    int i;
+    int j;
+    int b;
+    word32 v;
+    word32 carry = 0;
+
+    for (i = 0; i < w; i++) {
+        j = (i * c) >> 3;
+        /* Window is in the next three bytes. */
+        v = 0;
+        for (b = 0; (b < 3) && (j + b < len); b++) {
+            v |= (word32)k[len - 1 - j - b] << (8 * b);
+        }
+        v = ((v >> ((i * c) & 7)) & (((word32)1 << c) - 1)) + carry;
+        carry = (v + ((word32)1 << (c - 1))) >> c;
+        d[i] = (short)((int)v - (int)(carry << c));
+    }
+}
+
+/* Set a point to infinity. */
+static int ecc_multi_set_inf(ecc_point* p)
+{
+    mp_zero(p->x);
+    mp_zero(p->y);
+    return mp_set(p->z, 1);
+}
+
+/* Multiply each point by its scalar and add the results with Pippenger's
+ * bucket method using the generic point operations.
+ *
+ * For each window of c bits, from the top, the result is doubled c times and
+ * each point (negated for a negative digit) is added into the bucket of its
+ * digit. The buckets are summed with running sums so that bucket b is added b
+ * times. Points at infinity are dropped.
+ * Not constant time - only for public scalars.
+ *
+ * k        Scalars to multiply by.
+ * G        Points to multiply. Each affine or infinity.
+ * R        [out] Result in affine coordinates.
+ * cnt      Number of points.
+ * a        ECC curve parameter a.
+ * modulus  Modulus of the field of the curve.
+ * bits     Number of bits in the order of the curve.
+ * heap     Heap to use for allocation.
+ * returns MP_OKAY on success.
+ */
+static int ecc_mulmod_multi(mp_int** k, ecc_point** G, ecc_point* R,
+    word32 cnt, mp_int* a, mp_int* modulus, int bits, void* heap)
+{
+    int err = MP_OKAY;
+    int c;
+    int w;
+    int nb;
+    int len = (bits + 7) / 8;
+    int v;
+    int j;
+    word32 i;
+    word32 n = 0;
+    word32 np;
+    mp_digit mp = 0;
+    ecc_point** p = NULL;
+    ecc_point** bucket = NULL;
+    ecc_point* run = NULL;
+    ecc_point* sum = NULL;
+    ecc_point* acc = NULL;
+    ecc_point* neg = NULL;
+    short* d = NULL;
+    byte* buf = NULL;
+    int muInit = 0;
+#ifdef WOLFSSL_SMALL_STACK_CACHE
+    ecc_key key;
+    int keyInit = 0;
+#endif
+    DECL_MP_INT_SIZE_DYN(mu, mp_bitsused(modulus), MAX_ECC_BITS_USE);
+
+    c = ecc_multi_window(cnt, bits);
+    w = (bits + c) / c;
+    nb = 1 << (c - 1);
+    /* Points, buckets, running sums, result and a negated point. */
+    np = cnt + (word32)nb + 4;
+
+    NEW_MP_INT_SIZE(mu, mp_bitsused(modulus), heap, DYNAMIC_TYPE_ECC);
+#ifdef MP_INT_SIZE_CHECK_NULL
+    if (mu == NULL)
+        err = MEMORY_E;
+#endif
+    if (err == MP_OKAY) {
+        err = INIT_MP_INT_SIZE(mu, mp_bitsused(modulus));
+        muInit = (err == MP_OKAY);
+    }
+#ifdef WOLFSSL_SMALL_STACK_CACHE
+    if (err == MP_OKAY) {
+        err = ecc_key_tmp_init(&key, heap);
+        keyInit = (err == MP_OKAY);
+    }
+#endif
+    if (err == MP_OKAY) {
+        p = (ecc_point**)XMALLOC(sizeof(ecc_point*) * np, heap,
+                                 DYNAMIC_TYPE_ECC_BUFFER);
+        d = (short*)XMALLOC(sizeof(short) * (cnt + 1) * (word32)w, heap,
+                            DYNAMIC_TYPE_ECC_BUFFER);
+        buf = (byte*)XMALLOC((size_t)len, heap, DYNAMIC_TYPE_ECC_BUFFER);
+        if ((p == NULL) || (d == NULL) || (buf == NULL))
+            err = MEMORY_E;
+        else
+            XMEMSET(p, 0, sizeof(ecc_point*) * np);
+    }
+    for (i = 0; (err == MP_OKAY) && (i < np); i++) {
+        err = wc_ecc_new_point_ex(&p[i], heap);
+    #ifdef WOLFSSL_SMALL_STACK_CACHE
+        if (err == MP_OKAY)
+            p[i]->key = &key;
+    #endif
+    }
+    if (err == MP_OKAY) {
+        bucket = p + cnt;
+        run = p[cnt + (word32)nb];
+        sum = p[cnt + (word32)nb + 1];
+        acc = p[cnt + (word32)nb + 2];
+        neg = p[cnt + (word32)nb + 3];
+    #ifdef WOLFSSL_SMALL_STACK_CACHE
+        R->key = &key;
+    #endif
+        err = mp_montgomery_setup(modulus, &mp);
+    }
+    if (err == MP_OKAY)
+        err = mp_montgomery_calc_normalization(mu, modulus);
+
+    /* Montgomery form of the points that are not infinity. */
+    for (i = 0; (err == MP_OKAY) && (i < cnt); i++) {
+        if (wc_ecc_point_is_at_infinity(G[i]))
+            continue;
+        err = mp_to_unsigned_bin_len(k[i], buf, len);
+        if (err == MP_OKAY) {
+            ecc_multi_recode(d + n * (word32)w, buf, len, c, w);
+            err = mp_mulmod(G[i]->x, mu, modulus, p[n]->x);
+        }
+        if (err == MP_OKAY)
+            err = mp_mulmod(G[i]->y, mu, modulus, p[n]->y);
+        if (err == MP_OKAY)
+            err = mp_copy(mu, p[n]->z);
+        n++;
+    }
+
+    if (err == MP_OKAY)
+        err = ecc_multi_set_inf(acc);
+    for (j = w - 1; (err == MP_OKAY) && (j >= 0); j--) {
+        for (v = 0; (err == MP_OKAY) && (v < c); v++) {
+            err = ecc_projective_dbl_point_safe(acc, acc, a, modulus, mp);
+        }
+
+        for (v = 0; (err == MP_OKAY) && (v < nb); v++) {
+            err = ecc_multi_set_inf(bucket[v]);
+        }
+        for (i = 0; (err == MP_OKAY) && (i < n); i++) {
+            v = d[i * (word32)w + (word32)j];
+            if (v > 0) {
+                err = ecc_projective_add_point_safe(bucket[v - 1], p[i],
+                    bucket[v - 1], a, modulus, mp, NULL);
+            }
+            else if (v < 0) {
+                err = mp_copy(p[i]->x, neg->x);
+                if (err == MP_OKAY)
+                    err = mp_sub(modulus, p[i]->y, neg->y);
+                if (err == MP_OKAY)
+                    err = mp_copy(p[i]->z, neg->z);
+                if (err == MP_OKAY) {
+                    err = ecc_projective_add_point_safe(bucket[-v - 1], neg,
+                        bucket[-v - 1], a, modulus, mp, NULL);
+                }
+            }
+        }
+
+        /* sum = bucket[0] + 2.bucket[1] + ... + nb.bucket[nb-1] */
+        if (err == MP_OKAY)
+            err = ecc_multi_set_inf(run);
+        if (err == MP_OKAY)
+            err = ecc_multi_set_inf(sum);
+        for (v = nb - 1; (err == MP_OKAY) && (v >= 0); v--) {
+            err = ecc_projective_add_point_safe(run, bucket[v], run, a,
+                modulus, mp, NULL);
+            if (err == MP_OKAY) {
+                err = ecc_projective_add_point_safe(sum, run, sum, a, modulus,
+                    mp, NULL);
+            }
+        }
+        if (err == MP_OKAY) {
+            err = ecc_projective_add_point_safe(acc, sum, acc, a, modulus, mp,
+                NULL);
+        }
+    }
+
+    if (err == MP_OKAY) {
+        if (wc_ecc_point_is_at_infinity(acc))
+            err = ecc_multi_set_inf(R);
+        else {
+            err = ecc_map(acc, modulus, mp);
+            if (err == MP_OKAY)
+                err = wc_ecc_copy_point(acc, R);
+        }
+    }
+
+#ifdef WOLFSSL_SMALL_STACK_CACHE
+    R->key = NULL;
+#endif
+    if (p != NULL) {
+        for (i = 0; i < np; i++) {
+            wc_ecc_del_point_ex(p[i], heap);
+        }
+    }
+    XFREE(buf, heap, DYNAMIC_TYPE_ECC_BUFFER);
+    XFREE(d, heap, DYNAMIC_TYPE_ECC_BUFFER);
+    XFREE(p, heap, DYNAMIC_TYPE_ECC_BUFFER);
+#ifdef WOLFSSL_SMALL_STACK_CACHE
+    if (keyInit)
+        ecc_key_tmp_final(&key, heap);
+#endif
+    if (muInit)
+        mp_clear(mu);
+    FREE_MP_INT_SIZE(mu, heap, DYNAMIC_TYPE_ECC);
+
+    return err;
+}
+#endif /* ECC_MULTI_SCALAR_GENERIC */
+
+/* Multiply each point by its scalar and add the results:
+ *   R = k[0].G[0] + k[1].G[1] + ... + k[cnt-1].G[cnt-1]
+ *
+ * Uses Pippenger's bucket method with a window size chosen from the number of
+ * points. P-256 and P-384 use the SP code when built for 64-bit C.
+ * Not constant time - only for public scalars such as in batch verification.
+ *
+ * k         Scalars to multiply by. Each no larger than the order.
+ * G         Points to multiply. Each affine (z of one) or infinity.
+ * R         [out] Result in affine coordinates. Infinity when cnt is 0.
+ * cnt       Number of points.
+ * curve_id  Curve of the points.
+ * heap      Heap to use for allocation.
+ * returns BAD_FUNC_ARG when a parameter is NULL, ECC_BAD_ARG_E when the curve
+ * is not known or a point is not affine, ECC_OUT_OF_RANGE_E when a scalar is
+ * too large, MP_OKAY on success and other negative values on error.
+ */
+int wc_ecc_mulmod_multi(mp_int** k, ecc_point** G, ecc_point* R, word32 cnt,
+                        int curve_id, void* heap)
+{
+    int err = MP_OKAY;
+    int idx;
+    word32 i;
+    DECLARE_CURVE_SPECS(3);
+
+    if ((R == NULL) || ((cnt > 0) && ((k == NULL) || (G == NULL)))) {
+        return BAD_FUNC_ARG;
+    }
+    for (i = 0; i < cnt; i++) {
+        if ((k[i] == NULL) || (G[i] == NULL)) {
+            return BAD_FUNC_ARG;
+        }
+    }
+    idx = wc_ecc_get_curve_idx(curve_id);
+    if (wc_ecc_is_valid_idx(idx) == 0) {
+        return ECC_BAD_ARG_E;
+    }
+
+    SAVE_VECTOR_REGISTERS(return _svr_ret;);
+
+    ALLOC_CURVE_SPECS(3, err);
+    if (err == MP_OKAY) {
+        err = wc_ecc_curve_load(wc_ecc_get_curve_params(idx), &curve,
+                                ECC_CURVE_FIELD_PRIME | ECC_CURVE_FIELD_AF |
+                                ECC_CURVE_FIELD_ORDER);
+    }
+    for (i = 0; (err == MP_OKAY) && (i < cnt); i++) {
+        if (mp_count_bits(k[i]) > mp_count_bits(curve->order)) {
+            err = ECC_OUT_OF_RANGE_E;
+        }
+        else if ((!wc_ecc_point_is_at_infinity(G[i])) &&
+                 (!mp_isone(G[i]->z))) {
+            err = ECC_BAD_ARG_E;
+        }
+    }
+
+    if ((err == MP_OKAY) && (cnt == 0)) {
+        mp_zero(R->x);
+        mp_zero(R->y);
+        err = mp_set(R->z, 1);
+    }
+    else if (err == MP_OKAY) {
+    #if defined(ECC_MULTI_SCALAR_SP) && !defined(WOLFSSL_SP_NO_256)
+        if (ecc_sets[idx].id == ECC_SECP256R1) {
+            err = sp_ecc_mulmod_multi_256((int)cnt, k, G, R, heap);
+        }
+        else
+    #endif
+    #if defined(ECC_MULTI_SCALAR_SP) && defined(WOLFSSL_SP_384)
+        if (ecc_sets[idx].id == ECC_SECP384R1) {
+            err = sp_ecc_mulmod_multi_384((int)cnt, k, G, R, heap);
+        }
+        else
+    #endif
+        {
+    #ifdef ECC_MULTI_SCALAR_GENERIC
+            err = ecc_mulmod_multi(k, G, R, cnt, curve->Af, curve->prime,
+                mp_count_bits(curve->order), heap);
+    #else
+            err = NOT_COMPILED_IN;
+    #endif
+        }
+    }
+
+    wc_ecc_curve_free(curve);
+    FREE_CURVE_SPECS();
+
+    RESTORE_VECTOR_REGISTERS();
+
+    (void)heap;
+
+    return err;
+}
+#endif /* WOLFSSL_ECC_MULTI_SCALAR */
+
 
 #ifdef HAVE_ECC_VERIFY
 #ifndef NO_ASN
@@ -11541,6 +12088,13 @@ int wc_ecc_sig_size(const ecc_key* key)
     #define FP_ENTRIES 15
 #endif
 
+#ifdef WOLFSSL_ECC_FP_SHARED
+/* number of entries looked at for a point in the shared cache */
+#ifndef FP_SHARED_PROBE
+    #define FP_SHARED_PROBE 4
+#endif
+#endif
+
 /* number of bits in LUT */
 #ifndef FP_LUT
     #define FP_LUT     8U
@@ -11571,6 +12125,16 @@ typedef struct {
                                /* permitted (0) or not (1) */
 } fp_cache_t;
 
+#ifdef WOLFSSL_ECC_FP_SHARED
+/* One cache for all threads. fp_users counts the threads using an entry and
+ * is -1 while a thread changes it. The LUT is built before the entry is
+ * released so other threads only see complete entries. */
+static fp_cache_t fp_cache[FP_ENTRIES];
+static wolfSSL_Atomic_Int fp_users[FP_ENTRIES];
+static wolfSSL_Atomic_Int fp_uses[FP_ENTRIES];
+static wolfSSL_Atomic_Int fp_hits;
+static wolfSSL_Atomic_Int fp_misses;
+#else
 /* if HAVE_THREAD_LS this cache is per thread, no locking needed */
 static THREAD_LS_T fp_cache_t fp_cache[FP_ENTRIES];
 
@@ -11578,6 +12142,7 @@ static THREAD_LS_T fp_cache_t fp_cache[FP_ENTRIES];
     static volatile int initMutex = 0;  /* prevent multiple mutex inits */
     static wolfSSL_Mutex ecc_fp_lock;
 #endif /* HAVE_THREAD_LS */
+#endif /* WOLFSSL_ECC_FP_SHARED */
 
 /* simple table to help direct the generation of the LUT */
 static const struct {
@@ -12110,6 +12675,7 @@ static const struct {
 };
 
 
+#ifndef WOLFSSL_ECC_FP_SHARED
 /* find a hole and free as required, return -1 if no hole found */
 static int find_hole(void)
 {
@@ -12160,6 +12726,7 @@ static int find_base(ecc_point* g)
    }
    return x;
 }
+#endif /* !WOLFSSL_ECC_FP_SHARED */
 
 /* add a new base to the cache */
 static int add_entry(int idx, ecc_point *g)
@@ -12544,6 +13111,203 @@ done:
 
    return err;
 }
+
+#ifdef WOLFSSL_ECC_FP_SHARED
+/* Index of the first entry to look at for a base point. */
+static int fp_shared_hash(ecc_point* g)
+{
+   word32 h = (word32)get_digit(g->x, 0) ^ ((word32)get_digit(g->y, 0) << 7);
+
+   h *= 0x9E3779B1U;
+   return (int)((h >> 16) % FP_ENTRIES);
+}
+
+/* Take a reference to an entry so it can't be changed while used.
+ * Returns 0 when a thread is changing the entry. */
+static int fp_shared_pin(int idx)
+{
+   int users = wolfSSL_Atomic_Int_Load(&fp_users[idx]);
+
+   while (users >= 0) {
+      if (wolfSSL_Atomic_Int_CompareExchange(&fp_users[idx], &users,
+                                             users + 1)) {
+         return 1;
+      }
+   }
+   return 0;
+}
+
+/* Drop a reference to an entry. */
+static void fp_shared_unpin(int idx)
+{
+   int users = wolfSSL_Atomic_Int_Load(&fp_users[idx]);
+
+   while (!wolfSSL_Atomic_Int_CompareExchange(&fp_users[idx], &users,
+                                              users - 1)) {
+   }
+}
+
+/* Take sole ownership of an entry that no thread is using.
+ * Returns 0 when the entry is in use. */
+static int fp_shared_own(int idx)
+{
+   int users = 0;
+
+   return wolfSSL_Atomic_Int_CompareExchange(&fp_users[idx], &users, -1);
+}
+
+/* Publish the changes to an owned entry. */
+static void fp_shared_publish(int idx)
+{
+   wolfSSL_Atomic_Int_Store(&fp_users[idx], 0);
+}
+
+/* free the base point and table of an owned entry */
+static void fp_shared_clear(int idx)
+{
+   unsigned x;
+
+   if (fp_cache[idx].g != NULL) {
+      for (x = 0; x < (1U<<FP_LUT); x++) {
+         wc_ecc_del_point(fp_cache[idx].LUT[x]);
+         fp_cache[idx].LUT[x] = NULL;
+      }
+      wc_ecc_del_point(fp_cache[idx].g);
+      fp_cache[idx].g = NULL;
+      mp_clear(&fp_cache[idx].mu);
+      fp_cache[idx].LUT_set = 0;
+   }
+   wolfSSL_Atomic_Int_Init(&fp_uses[idx], 0);
+}
+
+/* build the LUT of an owned entry */
+static int fp_shared_build(int idx, mp_int* a, mp_int* modulus)
+{
+   int err;
+   mp_digit mp;
+#ifdef WOLFSSL_SMALL_STACK
+   mp_int* mu = (mp_int*)XMALLOC(sizeof(*mu), NULL, DYNAMIC_TYPE_ECC_BUFFER);
+
+   if (mu == NULL)
+      return MP_MEM;
+#else
+   mp_int  mu[1];
+#endif
+
+   err = mp_init(mu);
+   if (err == MP_OKAY)
+      err = mp_montgomery_setup(modulus, &mp);
+   if (err == MP_OKAY)
+      err = mp_montgomery_calc_normalization(mu, modulus);
+   if (err == MP_OKAY)
+      err = build_lut(idx, a, modulus, mp, mu);
+
+   mp_clear(mu);
+#ifdef WOLFSSL_SMALL_STACK
+   XFREE(mu, NULL, DYNAMIC_TYPE_ECC_BUFFER);
+#endif
+   return err;
+}
+
+/* Find the cache entry of a base point with its LUT built and pin it.
+ *
+ * Only FP_SHARED_PROBE entries from the hash of the point are looked at.
+ * A point not in the cache is added, replacing the least used entry, and its
+ * LUT is built when it is seen again. Entries being changed by another thread
+ * are skipped, so no thread waits on another.
+ *
+ * g        Base point.
+ * a        ECC curve parameter a.
+ * modulus  Modulus for curve.
+ * err      [out] MP_OKAY or error building an entry.
+ * return index of pinned entry or -1 when a normal multiply is to be done.
+ */
+static int fp_shared_acquire(ecc_point* g, mp_int* a, mp_int* modulus,
+                             int* err)
+{
+   int x, idx, hole = -1, victim = -1, fewest = INT_MAX, uses;
+
+   *err = MP_OKAY;
+   idx = fp_shared_hash(g);
+   for (x = 0; x < FP_SHARED_PROBE && x < FP_ENTRIES; x++) {
+      if (!fp_shared_pin(idx)) {
+         idx = (idx + 1) % FP_ENTRIES;
+         continue;
+      }
+      if (fp_cache[idx].g == NULL) {
+         if (hole == -1)
+            hole = idx;
+      }
+      else if (mp_cmp(fp_cache[idx].g->x, g->x) == MP_EQ &&
+               mp_cmp(fp_cache[idx].g->y, g->y) == MP_EQ &&
+               mp_cmp(fp_cache[idx].g->z, g->z) == MP_EQ) {
+         uses = wolfSSL_Atomic_Int_FetchAdd(&fp_uses[idx], 1) + 1;
+         if (fp_cache[idx].LUT_set) {
+            (void)wolfSSL_Atomic_Int_FetchAdd(&fp_hits, 1);
+            return idx;
+         }
+         fp_shared_unpin(idx);
+         /* if it's 2 build the LUT, skip when another thread has it */
+         if (uses >= 2 && fp_shared_own(idx)) {
+            if (fp_cache[idx].g != NULL && !fp_cache[idx].LUT_set)
+               *err = fp_shared_build(idx, a, modulus);
+            fp_shared_publish(idx);
+         }
+         (void)wolfSSL_Atomic_Int_FetchAdd(&fp_misses, 1);
+         return -1;
+      }
+      else {
+         uses = wolfSSL_Atomic_Int_Load(&fp_uses[idx]);
+         if (uses < fewest) {
+            fewest = uses;
+            victim = idx;
+         }
+         /* age entries so ones no longer used can be replaced */
+         if (uses > 3)
+            (void)wolfSSL_Atomic_Int_FetchSub(&fp_uses[idx], 1);
+      }
+      fp_shared_unpin(idx);
+      idx = (idx + 1) % FP_ENTRIES;
+   }
+
+   (void)wolfSSL_Atomic_Int_FetchAdd(&fp_misses, 1);
+   if (hole != -1)
+      victim = hole;
+   if (victim != -1 && fp_shared_own(victim)) {
+      fp_shared_clear(victim);
+      *err = add_entry(victim, g);
+      if (*err == MP_OKAY)
+         wolfSSL_Atomic_Int_Init(&fp_uses[victim], 1);
+      fp_shared_publish(victim);
+   }
+   return -1;
+}
+
+/* Fixed point mulmod using the cache shared by all threads */
+static int ecc_fp_shared_mulmod(const mp_int* k, ecc_point *G, ecc_point *R,
+    mp_int* a, mp_int* modulus, WC_RNG* rng, int map, void* heap)
+{
+   int idx, err;
+   mp_digit mp;
+
+   SAVE_VECTOR_REGISTERS(return _svr_ret;);
+
+   idx = fp_shared_acquire(G, a, modulus, &err);
+   if (idx >= 0) {
+      err = mp_montgomery_setup(modulus, &mp);
+      if (err == MP_OKAY)
+         err = accel_fp_mul(idx, k, R, a, modulus, mp, map);
+      fp_shared_unpin(idx);
+   }
+   else if (err == MP_OKAY) {
+      err = normal_ecc_mulmod(k, G, R, a, modulus, rng, map, heap);
+   }
+
+   RESTORE_VECTOR_REGISTERS();
+
+   return err;
+}
+#endif /* WOLFSSL_ECC_FP_SHARED */
 #endif
 
 #ifdef ECC_SHAMIR
@@ -12827,6 +13591,44 @@ done:
    return ecc_map(R, modulus, mp);
 }
 
+#ifdef WOLFSSL_ECC_FP_SHARED
+/* Fixed point mul2add using the cache shared by all threads */
+static int ecc_fp_shared_mul2add(ecc_point* A, mp_int* kA,
+                                 ecc_point* B, mp_int* kB,
+                                 ecc_point* C, mp_int* a, mp_int* modulus,
+                                 void* heap)
+{
+   int idx1, idx2 = -1, err;
+   mp_digit mp;
+
+   SAVE_VECTOR_REGISTERS(return _svr_ret;);
+
+   idx1 = fp_shared_acquire(A, a, modulus, &err);
+   if (err == MP_OKAY)
+      idx2 = fp_shared_acquire(B, a, modulus, &err);
+
+   if (err == MP_OKAY) {
+      if (idx1 >= 0 && idx2 >= 0) {
+         err = mp_montgomery_setup(modulus, &mp);
+         if (err == MP_OKAY)
+            err = accel_fp_mul2add(idx1, idx2, kA, kB, C, a, modulus, mp);
+      }
+      else {
+         err = normal_ecc_mul2add(A, kA, B, kB, C, a, modulus, heap);
+      }
+   }
+
+   if (idx2 >= 0)
+      fp_shared_unpin(idx2);
+   if (idx1 >= 0)
+      fp_shared_unpin(idx1);
+
+   RESTORE_VECTOR_REGISTERS();
+
+   return err;
+}
+#endif /* WOLFSSL_ECC_FP_SHARED */
+
 
 /** ECC Fixed Point mulmod global with heap hint used
   Computes kA*A + kB*B = C using Shamir's Trick
@@ -12843,6 +13645,9 @@ int ecc_mul2add(ecc_point* A, mp_int* kA,
                 ecc_point* B, mp_int* kB,
                 ecc_point* C, mp_int* a, mp_int* modulus, void* heap)
 {
+#ifdef WOLFSSL_ECC_FP_SHARED
+   return ecc_fp_shared_mul2add(A, kA, B, kB, C, a, modulus, heap);
+#else
    int  idx1 = -1, idx2 = -1, err, mpInit = 0;
    mp_digit mp;
 #ifdef WOLFSSL_SMALL_STACK
@@ -12971,6 +13776,7 @@ int ecc_mul2add(ecc_point* A, mp_int* kA,
 #endif
 
     return err;
+#endif /* WOLFSSL_ECC_FP_SHARED */
 }
 #endif
 #endif /* ECC_SHAMIR */
@@ -12997,7 +13803,7 @@ int wc_ecc_mulmod_ex(const mp_int* k, ecc_point *G, ecc_point *R, mp_int* a,
    mp_int   mu[1];
 #endif
    int      mpSetup = 0;
-#ifndef HAVE_THREAD_LS
+#if !defined(HAVE_THREAD_LS) && !defined(WOLFSSL_ECC_FP_SHARED)
    int got_ecc_fp_lock = 0;
 #endif
 
@@ -13010,6 +13816,14 @@ int wc_ecc_mulmod_ex(const mp_int* k, ecc_point *G, ecc_point *R, mp_int* a,
       return ECC_OUT_OF_RANGE_E;
    }
 
+#ifdef WOLFSSL_ECC_FP_SHARED
+   (void)idx;
+   (void)err;
+   (void)mp;
+   (void)mu;
+   (void)mpSetup;
+   return ecc_fp_shared_mulmod(k, G, R, a, modulus, NULL, map, heap);
+#else
 #ifdef WOLFSSL_SMALL_STACK
    if ((mu = (mp_int *)XMALLOC(sizeof(*mu), NULL, DYNAMIC_TYPE_ECC_BUFFER)) == NULL)
        return MP_MEM;
@@ -13097,6 +13911,7 @@ int wc_ecc_mulmod_ex(const mp_int* k, ecc_point *G, ecc_point *R, mp_int* a,
 #endif
 
     return err;
+#endif /* WOLFSSL_ECC_FP_SHARED */
 
 #else /* WOLFSSL_SP_MATH */
 
@@ -13171,7 +13986,7 @@ int wc_ecc_mulmod_ex2(const mp_int* k, ecc_point *G, ecc_point *R, mp_int* a,
    mp_int   mu[1];
 #endif
    int      mpSetup = 0;
-#ifndef HAVE_THREAD_LS
+#if !defined(HAVE_THREAD_LS) && !defined(WOLFSSL_ECC_FP_SHARED)
    int got_ecc_fp_lock = 0;
 #endif
 
@@ -13185,6 +14000,14 @@ int wc_ecc_mulmod_ex2(const mp_int* k, ecc_point *G, ecc_point *R, mp_int* a,
       return ECC_OUT_OF_RANGE_E;
    }
 
+#ifdef WOLFSSL_ECC_FP_SHARED
+   (void)idx;
+   (void)err;
+   (void)mp;
+   (void)mu;
+   (void)mpSetup;
+   return ecc_fp_shared_mulmod(k, G, R, a, modulus, rng, map, heap);
+#else
 #ifdef WOLFSSL_SMALL_STACK
    if ((mu = (mp_int *)XMALLOC(sizeof(*mu), NULL, DYNAMIC_TYPE_ECC_BUFFER)) == NULL)
        return MP_MEM;
@@ -13272,6 +14095,7 @@ int wc_ecc_mulmod_ex2(const mp_int* k, ecc_point *G, ecc_point *R, mp_int* a,
 #endif
 
     return err;
+#endif /* WOLFSSL_ECC_FP_SHARED */
 
 #else /* WOLFSSL_SP_MATH */
 
@@ -13355,7 +14179,7 @@ static void wc_ecc_fp_free_cache(void)
 void wc_ecc_fp_init(void)
 {
 #ifndef WOLFSSL_SP_MATH
-#ifndef HAVE_THREAD_LS
+#if !defined(HAVE_THREAD_LS) && !defined(WOLFSSL_ECC_FP_SHARED)
    if (initMutex == 0) {
         wc_InitMutex(&ecc_fp_lock);
         initMutex = 1;
@@ -13369,7 +14193,18 @@ void wc_ecc_fp_init(void)
 WOLFSSL_ABI
 void wc_ecc_fp_free(void)
 {
-#if !defined(WOLFSSL_SP_MATH)
+#if defined(WOLFSSL_ECC_FP_SHARED)
+   unsigned x;
+
+   /* no thread may be using the cache */
+   wc_ecc_fp_free_cache();
+   for (x = 0; x < FP_ENTRIES; x++) {
+      wolfSSL_Atomic_Int_Init(&fp_users[x], 0);
+      wolfSSL_Atomic_Int_Init(&fp_uses[x], 0);
+   }
+   wolfSSL_Atomic_Int_Init(&fp_hits, 0);
+   wolfSSL_Atomic_Int_Init(&fp_misses, 0);
+#elif !defined(WOLFSSL_SP_MATH)
 #ifndef HAVE_THREAD_LS
    if (initMutex == 0) { /* extra sanity check if wolfCrypt_Init not called */
         wc_InitMutex(&ecc_fp_lock);
@@ -13390,6 +14225,25 @@ void wc_ecc_fp_free(void)
 #endif
 }
 
+#ifdef WOLFSSL_ECC_FP_SHARED
+/** Get the statistics of the shared Fixed Point cache
+    hits    [out] Number of points found with a LUT built
+    misses  [out] Number of points without a LUT
+    return 0 on success
+*/
+int wc_ecc_fp_stats(word32* hits, word32* misses)
+{
+   if (hits == NULL || misses == NULL) {
+      return BAD_FUNC_ARG;
+   }
+
+   *hits = (word32)wolfSSL_Atomic_Int_Load(&fp_hits);
+   *misses = (word32)wolfSSL_Atomic_Int_Load(&fp_misses);
+
+   return 0;
+}
+#endif /* WOLFSSL_ECC_FP_SHARED */
+
 
 #endif /* FP_ECC */
 
@@ -608,33 +608,10 @@ static const byte ed25519_low_order[] = {
 
 /*
    sig     is array of bytes containing the signature
-   sigLen  is the length of sig byte array
-   res     will be 1 on successful verify and 0 on unsuccessful
-   key     Ed25519 public key
-   return  0 and res of 1 on success
+   return  0 when S is less than the order and BAD_FUNC_ARG otherwise
 */
-static int ed25519_verify_msg_final_with_sha(const byte* sig, word32 sigLen,
-                                             int* res, ed25519_key* key,
-                                             wc_Sha512 *sha)
+static int ed25519_check_s(const byte* sig)
 {
-    ALIGN16 byte rcheck[ED25519_KEY_SIZE];
-    ALIGN16 byte h[WC_SHA512_DIGEST_SIZE];
-#ifndef FREESCALE_LTC_ECC
-    ge_p3  A;
-    ge_p2  R;
-#endif
-    int    ret;
-
-    /* sanity check on arguments */
-    if (sig == NULL || res == NULL || key == NULL)
-        return BAD_FUNC_ARG;
-
-    /* set verification failed by default */
-    *res = 0;
-
-    /* check on basics needed to verify signature */
-    if (sigLen != ED25519_SIG_SIZE)
-        return BAD_FUNC_ARG;
     /* S is not larger or equal to the order:
      *     2^252 + 0x14def9dea2f79cd65812631a5cf5d3ed
      *   = 0x1000000000000000000000000000000014def9dea2f79cd65812631a5cf5d3ed
@@ -667,6 +644,41 @@ static int ed25519_verify_msg_final_with_sha(const byte* sig, word32 sigLen,
         }
     }
 
+    return 0;
+}
+
+/*
+   sig     is array of bytes containing the signature
+   sigLen  is the length of sig byte array
+   res     will be 1 on successful verify and 0 on unsuccessful
+   key     Ed25519 public key
+   return  0 and res of 1 on success
+*/
+static int ed25519_verify_msg_final_with_sha(const byte* sig, word32 sigLen,
+                                             int* res, ed25519_key* key,
+                                             wc_Sha512 *sha)
+{
+    ALIGN16 byte rcheck[ED25519_KEY_SIZE];
+    ALIGN16 byte h[WC_SHA512_DIGEST_SIZE];
+#ifndef FREESCALE_LTC_ECC
+    ge_p3  A;
+    ge_p2  R;
+#endif
+    int    ret;
+
+    /* sanity check on arguments */
+    if (sig == NULL || res == NULL || key == NULL)
+        return BAD_FUNC_ARG;
+
+    /* set verification failed by default */
+    *res = 0;
+
+    /* check on basics needed to verify signature */
+    if (sigLen != ED25519_SIG_SIZE)
+        return BAD_FUNC_ARG;
+    if (ed25519_check_s(sig) != 0)
+        return BAD_FUNC_ARG;
+
     /* uncompress A (public key), test if valid, and negate it */
 #ifndef FREESCALE_LTC_ECC
     if (ge_frombytes_negate_vartime(&A, key->p) != 0)
@@ -879,6 +891,290 @@ int wc_ed25519ph_verify_msg(const byte* sig, word32 sigLen, const byte* msg,
     return wc_ed25519_verify_msg_ex(sig, sigLen, hash, sizeof(hash), res, key,
                                     Ed25519ph, context, contextLen);
 }
+
+#if defined(WOLFSSL_ED25519_BATCH_VERIFY) && !defined(WOLFSSL_SE050)
+#ifndef WOLFSSL_ED25519_BATCH_MAX
+    /* Most signatures checked with one multi-scalar multiplication. */
+    #define WOLFSSL_ED25519_BATCH_MAX   32
+#endif
+
+/* Verify one signature of a batch.
+ *
+ * res is set to 0 when the signature is invalid or malformed.
+ */
+static int ed25519_verify_batch_one(const byte* sig, word32 sigLen,
+                                    const byte* msg, word32 msgLen,
+                                    ed25519_key* key, int* res)
+{
+    int ret = wc_ed25519_verify_msg(sig, sigLen, msg, msgLen, res, key);
+    if ((ret == SIG_VERIFY_E) || (ret == BAD_FUNC_ARG)) {
+        *res = 0;
+        ret = 0;
+    }
+    return ret;
+}
+
+#if !defined(ED25519_SMALL) && !defined(FREESCALE_LTC_ECC)
+/* Encoding of the base point B. */
+static const byte ed25519_base[ED25519_PUB_KEY_SIZE] = {
+    0x58, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66,
+    0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66,
+    0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66,
+    0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66
+};
+
+/* Order minus one in little endian. Multiplying by it negates a scalar. */
+static const byte ed25519_order_m1[ED25519_KEY_SIZE] = {
+    0xec, 0xd3, 0xf5, 0x5c, 0x1a, 0x63, 0x12, 0x58,
+    0xd6, 0x9c, 0xf7, 0xa2, 0xde, 0xf9, 0xde, 0x14,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10
+};
+
+/* Check the encoding of R is one that ge_tobytes() can produce.
+ *
+ * Single verification compares encodings so rejects R when y is not reduced
+ * or the sign bit is set with an x of zero (y is 1 or -1).
+ *
+ * r       encoding of point R from signature
+ * return  1 when canonical and 0 otherwise
+ */
+static int ed25519_r_canonical(const byte* r)
+{
+    int i;
+    int ones = ((r[ED25519_KEY_SIZE-1] & 0x7f) == 0x7f);
+    int zeros = ((r[ED25519_KEY_SIZE-1] & 0x7f) == 0x00);
+
+    for (i = 1; i < ED25519_KEY_SIZE - 1; i++) {
+        ones &= (r[i] == 0xff);
+        zeros &= (r[i] == 0x00);
+    }
+    /* y >= 2^255 - 19 */
+    if (ones && r[0] >= 0xed)
+        return 0;
+    /* y = -1 or y = 1 with sign of x set */
+    if ((r[ED25519_KEY_SIZE-1] & 0x80) &&
+            ((ones && r[0] == 0xec) || (zeros && r[0] == 0x01)))
+        return 0;
+    return 1;
+}
+
+/* Calculate h = H(R,A,M) mod order for a signature. */
+static int ed25519_batch_hash(const byte* sig, const byte* msg, word32 msgLen,
+                              ed25519_key* key, byte* h)
+{
+    int ret;
+#ifdef WOLFSSL_ED25519_PERSISTENT_SHA
+    wc_Sha512 *sha = &key->sha;
+#else
+    wc_Sha512 sha[1];
+
+    ret = ed25519_hash_init(key, sha);
+    if (ret < 0)
+        return ret;
+#endif
+
+    ret = ed25519_verify_msg_init_with_sha(sig, ED25519_SIG_SIZE, key, sha,
+        (byte)Ed25519, NULL, 0);
+    if (ret == 0)
+        ret = ed25519_verify_msg_update_with_sha(msg, msgLen, key, sha);
+    if (ret == 0)
+        ret = ed25519_hash_final(key, sha, h);
+    if (ret == 0)
+        sc_reduce(h);
+
+#ifndef WOLFSSL_ED25519_PERSISTENT_SHA
+    ed25519_hash_free(key, sha);
+#endif
+    return ret;
+}
+
+/* Verify up to WOLFSSL_ED25519_BATCH_MAX signatures at once.
+ *
+ * With random z_i, checks:
+ *   (sum z_i.S_i).B - sum (z_i.h_i).A_i - sum z_i.R_i = 0
+ * with one multi-scalar multiplication. Signatures from the same public key
+ * share the point A and sum their scalars. When the check fails each
+ * signature is verified on its own to find the invalid ones.
+ */
+static int ed25519_verify_batch(const byte** sig, const word32* sigLen,
+                                const byte** msg, const word32* msgLen,
+                                ed25519_key** key, word32 n, int* res,
+                                WC_RNG* rng)
+{
+    int ret = 0;
+    word32 i;
+    word32 j;
+    word32 a;
+    word32 cnt = 1;
+    ge_p3* p;
+    byte* s;
+    word32* aIdx;
+    ge_p3 q;
+    ALIGN16 byte h[WC_SHA512_DIGEST_SIZE];
+    ALIGN16 byte z[ED25519_KEY_SIZE];
+    ALIGN16 byte sum[ED25519_KEY_SIZE];
+    ALIGN16 byte t[ED25519_KEY_SIZE];
+    static const byte zero[ED25519_KEY_SIZE] = { 0 };
+
+    p = (ge_p3*)XMALLOC((2 * n + 1) * sizeof(ge_p3), key[0]->heap,
+        DYNAMIC_TYPE_TMP_BUFFER);
+    s = (byte*)XMALLOC((2 * n + 1) * ED25519_KEY_SIZE, key[0]->heap,
+        DYNAMIC_TYPE_TMP_BUFFER);
+    aIdx = (word32*)XMALLOC(n * sizeof(word32), key[0]->heap,
+        DYNAMIC_TYPE_TMP_BUFFER);
+    if ((p == NULL) || (s == NULL) || (aIdx == NULL)) {
+        ret = MEMORY_E;
+    }
+
+    /* -B with -(sum z_i.S_i) is placed first. */
+    if ((ret == 0) && (ge_frombytes_negate_vartime(&p[0], ed25519_base) != 0))
+        ret = ECC_BAD_ARG_E;
+    XMEMSET(sum, 0, sizeof(sum));
+    XMEMSET(z, 0, sizeof(z));
+
+    for (i = 0; (ret == 0) && (i < n); i++) {
+        res[i] = 0;
+        /* Point 0 is B so never a public key. */
+        aIdx[i] = 0;
+    #ifdef WOLF_CRYPTO_CB
+        if (key[i]->devId != INVALID_DEVID) {
+            ret = ed25519_verify_batch_one(sig[i], sigLen[i], msg[i],
+                msgLen[i], key[i], &res[i]);
+            continue;
+        }
+    #endif
+        /* Malformed signatures and keys fail on their own too. */
+        if ((sigLen[i] != ED25519_SIG_SIZE) ||
+                (ed25519_check_s(sig[i]) != 0) ||
+                !ed25519_r_canonical(sig[i]) ||
+                (ge_frombytes_negate_vartime(&p[cnt], sig[i]) != 0)) {
+            continue;
+        }
+        /* -A_i is shared by signatures with the same public key. */
+        a = cnt + 1;
+        for (j = 0; j < i; j++) {
+            if ((aIdx[j] != 0) && (XMEMCMP(key[j]->p, key[i]->p,
+                                           ED25519_PUB_KEY_SIZE) == 0)) {
+                a = aIdx[j];
+                break;
+            }
+        }
+        if ((a == cnt + 1) &&
+                (ge_frombytes_negate_vartime(&p[a], key[i]->p) != 0)) {
+            continue;
+        }
+
+        ret = ed25519_batch_hash(sig[i], msg[i], msgLen[i], key[i], h);
+        if (ret == 0)
+            ret = wc_RNG_GenerateBlock(rng, z, ED25519_KEY_SIZE / 2);
+        if (ret == 0) {
+            /* Odd so never zero. */
+            z[0] |= 1;
+            /* -R_i with z_i and -A_i with sum of z_i.h_i. */
+            XMEMCPY(s + cnt * ED25519_KEY_SIZE, z, ED25519_KEY_SIZE);
+            if (a == cnt + 1) {
+                sc_muladd(s + a * ED25519_KEY_SIZE, z, h, zero);
+                cnt += 2;
+            }
+            else {
+                sc_muladd(t, z, h, s + a * ED25519_KEY_SIZE);
+                XMEMCPY(s + a * ED25519_KEY_SIZE, t, ED25519_KEY_SIZE);
+                cnt += 1;
+            }
+            sc_muladd(t, z, sig[i] + ED25519_SIG_SIZE/2, sum);
+            XMEMCPY(sum, t, sizeof(sum));
+            aIdx[i] = a;
+            res[i] = 1;
+        }
+    }
+
+    if ((ret == 0) && (cnt > 1)) {
+        sc_muladd(s, sum, ed25519_order_m1, zero);
+        ret = ge_multi_scalarmult_vartime(&q, s, p, (int)cnt);
+        if (ret == 0) {
+            ge_p3_tobytes(t, &q);
+            /* Identity encodes as 1. */
+            t[0] ^= 0x01;
+            if (ConstantCompare(t, zero, ED25519_KEY_SIZE) != 0) {
+                for (i = 0; (ret == 0) && (i < n); i++) {
+                    if (res[i]) {
+                        ret = ed25519_verify_batch_one(sig[i], sigLen[i],
+                            msg[i], msgLen[i], key[i], &res[i]);
+                    }
+                }
+            }
+        }
+    }
+
+    ForceZero(z, sizeof(z));
+    XFREE(aIdx, key[0]->heap, DYNAMIC_TYPE_TMP_BUFFER);
+    XFREE(s, key[0]->heap, DYNAMIC_TYPE_TMP_BUFFER);
+    XFREE(p, key[0]->heap, DYNAMIC_TYPE_TMP_BUFFER);
+    return ret;
+}
+#endif /* !ED25519_SMALL && !FREESCALE_LTC_ECC */
+
+/*
+   Verify many Ed25519 (pure, no context) signatures.
+
+   The signatures are checked together with a randomized batch equation using
+   one multi-scalar multiplication for every WOLFSSL_ED25519_BATCH_MAX
+   signatures. When a batch fails, its signatures are verified one at a time
+   so res is exact for each signature. Signatures whose only fault is a
+   small order component in R or A may cancel out and pass a batch.
+
+   sig     array of signatures
+   sigLen  array of signature lengths
+   msg     array of messages
+   msgLen  array of message lengths
+   key     array of Ed25519 public keys
+   cnt     number of signatures
+   res     array set to 1 for each valid signature and 0 otherwise
+   rng     random number generator for the batch coefficients
+   return  0 when all signatures are valid, SIG_VERIFY_E when any is invalid
+           and other negative values on error
+*/
+int wc_ed25519_verify_msg_batch(const byte** sig, const word32* sigLen,
+                                const byte** msg, const word32* msgLen,
+                                ed25519_key** key, word32 cnt, int* res,
+                                WC_RNG* rng)
+{
+    int ret = 0;
+    word32 i;
+
+    /* sanity check on arguments */
+    if ((cnt > 0) && (sig == NULL || sigLen == NULL || msg == NULL ||
+            msgLen == NULL || key == NULL || res == NULL || rng == NULL))
+        return BAD_FUNC_ARG;
+    for (i = 0; i < cnt; i++) {
+        if (sig[i] == NULL || msg[i] == NULL || key[i] == NULL)
+            return BAD_FUNC_ARG;
+    }
+
+#if !defined(ED25519_SMALL) && !defined(FREESCALE_LTC_ECC)
+    for (i = 0; (ret == 0) && (i < cnt); i += WOLFSSL_ED25519_BATCH_MAX) {
+        word32 n = cnt - i;
+        if (n > WOLFSSL_ED25519_BATCH_MAX)
+            n = WOLFSSL_ED25519_BATCH_MAX;
+        ret = ed25519_verify_batch(sig + i, sigLen + i, msg + i, msgLen + i,
+            key + i, n, res + i, rng);
+    }
+#else
+    for (i = 0; (ret == 0) && (i < cnt); i++) {
+        ret = ed25519_verify_batch_one(sig[i], sigLen[i], msg[i], msgLen[i],
+            key[i], &res[i]);
+    }
+#endif
+
+    for (i = 0; (ret == 0) && (i < cnt); i++) {
+        if (!res[i])
+            ret = SIG_VERIFY_E;
+    }
+
+    return ret;
+}
+#endif /* WOLFSSL_ED25519_BATCH_VERIFY && !WOLFSSL_SE050 */
 #endif /* HAVE_ED25519_VERIFY */
 
 
@@ -1254,6 +1550,74 @@ int wc_ed25519_check_key(ed25519_key* key)
     return ret;
 }
 
+#ifdef WOLFSSL_ED25519_MULTI_SCALAR
+/*
+   Multiply each point by its scalar and add the results:
+     r = s[0].P[0] + s[1].P[1] + ... + s[cnt-1].P[cnt-1]
+   Straus' method is used for up to 256 points and Pippenger's bucket method
+   for more. Not constant time - only for public scalars.
+
+   r       encoding of the resulting point, ED25519_PUB_KEY_SIZE bytes
+   s       cnt little-endian scalars of ED25519_KEY_SIZE bytes, each less
+           than 2^253 (always true when reduced modulo the order)
+   p       cnt encoded points of ED25519_PUB_KEY_SIZE bytes
+   cnt     number of points
+   return  0 on success, BAD_FUNC_ARG when a parameter is NULL or a scalar is
+           too large and ECC_BAD_ARG_E when a point is not valid
+*/
+int wc_ed25519_mul_multi(byte* r, const byte* s, const byte* p, word32 cnt)
+{
+#if !defined(ED25519_SMALL) && !defined(FREESCALE_LTC_ECC)
+    int ret = 0;
+    word32 i;
+    ge_p3* P = NULL;
+    ge_p3 q;
+
+    if ((r == NULL) || ((cnt > 0) && ((s == NULL) || (p == NULL))) ||
+            ((int)cnt < 0)) {
+        return BAD_FUNC_ARG;
+    }
+    for (i = 0; i < cnt; i++) {
+        /* Top three bits clear. */
+        if ((s[i * ED25519_KEY_SIZE + ED25519_KEY_SIZE - 1] & 0xe0) != 0)
+            return BAD_FUNC_ARG;
+    }
+
+    if (cnt > 0) {
+        P = (ge_p3*)XMALLOC(cnt * sizeof(ge_p3), NULL,
+            DYNAMIC_TYPE_TMP_BUFFER);
+        if (P == NULL)
+            ret = MEMORY_E;
+    }
+    for (i = 0; (ret == 0) && (i < cnt); i++) {
+        if (ge_frombytes_negate_vartime(&P[i],
+                p + i * ED25519_PUB_KEY_SIZE) != 0) {
+            ret = ECC_BAD_ARG_E;
+        }
+        else {
+            /* Decoding negates the point. */
+            fe_neg(P[i].X, P[i].X);
+            fe_neg(P[i].T, P[i].T);
+        }
+    }
+
+    if (ret == 0)
+        ret = ge_multi_scalarmult_vartime(&q, s, P, (int)cnt);
+    if (ret == 0)
+        ge_p3_tobytes(r, &q);
+
+    XFREE(P, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    return ret;
+#else
+    (void)r;
+    (void)s;
+    (void)p;
+    (void)cnt;
+    return NOT_COMPILED_IN;
+#endif
+}
+#endif /* WOLFSSL_ED25519_MULTI_SCALAR */
+
 /* returns the private key size (secret only) in bytes */
 int wc_ed25519_size(ed25519_key* key)
 {
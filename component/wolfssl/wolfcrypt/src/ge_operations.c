@@ -9489,6 +9489,276 @@ int ge_double_scalarmult_vartime(ge_p2 *r, const unsigned char *a,
 #endif
 }
 
+#if defined(WOLFSSL_ED25519_BATCH_VERIFY) || \
+    defined(WOLFSSL_ED25519_MULTI_SCALAR)
+/* Get c bits of a 32 byte little-endian scalar starting at bit pos. */
+static int ge_scalar_bits(const unsigned char *s, int pos, int c)
+{
+  int i = pos >> 3;
+  word32 v = s[i];
+
+  if (i + 1 < 32) v |= (word32)s[i + 1] << 8;
+  if (i + 2 < 32) v |= (word32)s[i + 2] << 16;
+
+  return (int)((v >> (pos & 7)) & ((1U << c) - 1));
+}
+
+#ifndef GE_MULTI_STRAUS_MAX
+    /* Most points to multiply with Straus' method. Above this Pippenger's
+     * method does fewer point additions and uses less memory. */
+    #define GE_MULTI_STRAUS_MAX  256
+#endif
+
+/*
+r = s[0] * P[0] + s[1] * P[1] + ... + s[n-1] * P[n-1]
+where s[i] is 32 bytes little-endian at s + 32 * i.
+
+Straus' method: the sliding windows of all scalars share the doublings and
+each point has a table of odd multiples as in ge_double_scalarmult_vartime().
+Not constant time - only for public data.
+*/
+static int ge_multi_scalarmult_straus(ge_p3 *r, const unsigned char *s,
+                                      const ge_p3 *P, int n)
+{
+  signed char *pslide;
+  signed char jslide[SLIDE_SIZE];
+  ge_cached *Pi; /* P,3P,5P,7P,9P,11P,13P,15P for each point */
+  ge_p1p1 t;
+  ge_p2 q;
+  ge_p3 u;
+  ge_p3 P2;
+  int i;
+  int j;
+  int top = -1;
+  signed char d;
+
+  pslide = (signed char *)XMALLOC((size_t)n * SLIDE_SIZE, NULL,
+                                  DYNAMIC_TYPE_TMP_BUFFER);
+  Pi = (ge_cached *)XMALLOC((size_t)n * 8 * sizeof(*Pi), NULL,
+                            DYNAMIC_TYPE_TMP_BUFFER);
+  if ((pslide == NULL) || (Pi == NULL)) {
+    XFREE(Pi, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    XFREE(pslide, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    return MEMORY_E;
+  }
+
+  for (j = 0; j < n; j++) {
+    slide(jslide, s + 32 * j);
+    /* digits of all points at a position are together */
+    for (i = 0; i < SLIDE_SIZE; i++) {
+      pslide[i * n + j] = jslide[i];
+      if (jslide[i] && (i > top))
+        top = i;
+    }
+
+    ge_p3_to_cached(&Pi[8 * j], &P[j]);
+    ge_p3_dbl(&t, &P[j]); ge_p1p1_to_p3(&P2, &t);
+    for (i = 1; i < 8; i++) {
+      ge_add(&t, &P2, &Pi[8 * j + i - 1]);
+      ge_p1p1_to_p3(&u, &t);
+      ge_p3_to_cached(&Pi[8 * j + i], &u);
+    }
+  }
+
+  if (top < 0) {
+    fe_0(r->X); fe_1(r->Y); fe_1(r->Z); fe_0(r->T);
+  }
+
+  ge_p2_0(&q);
+  for (i = top; i >= 0; --i) {
+    ge_p2_dbl(&t, &q);
+
+    for (j = 0; j < n; j++) {
+      d = pslide[i * n + j];
+      if (d > 0) {
+        ge_p1p1_to_p3(&u, &t);
+        ge_add(&t, &u, &Pi[8 * j + d / 2]);
+      } else if (d < 0) {
+        ge_p1p1_to_p3(&u, &t);
+        ge_sub(&t, &u, &Pi[8 * j + (-d) / 2]);
+      }
+    }
+
+    if (i > 0)
+      ge_p1p1_to_p2(&q, &t);
+    else
+      ge_p1p1_to_p3(r, &t);
+  }
+
+  XFREE(Pi, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+  XFREE(pslide, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+
+  return 0;
+}
+
+/* Get the window size of Pippenger's method for n points: the fewest point
+ * additions with n per window into the buckets and two for each of the
+ * 2^(c-1) buckets to sum them. */
+static int ge_multi_window(int n)
+{
+  int c;
+  int best = 4;
+  word64 cost;
+  word64 bestCost = (word64)-1;
+
+  for (c = 4; c <= 16; c++) {
+    cost = (word64)((256 + c) / c) * ((word64)n + ((word64)1 << c));
+    if (cost < bestCost) {
+      bestCost = cost;
+      best = c;
+    }
+  }
+  return best;
+}
+
+/*
+r = s[0] * P[0] + s[1] * P[1] + ... + s[n-1] * P[n-1]
+where s[i] is 32 bytes little-endian at s + 32 * i.
+
+Uses Straus' method for up to GE_MULTI_STRAUS_MAX points and otherwise
+Pippenger's bucket method: each window of c bits of the scalars is a signed
+digit, from -2^(c-1) to 2^(c-1)-1, and the points are added into (or, for a
+negative digit, subtracted from) 2^(c-1) buckets which are then summed with
+running sums.
+Not constant time - only for public data.
+*/
+int ge_multi_scalarmult_vartime(ge_p3 *r, const unsigned char *s,
+                                const ge_p3 *P, int n)
+{
+  ge_cached *Pc;
+  ge_p3 *bucket;
+  byte *used;
+  short *dig;
+  ge_p1p1 t;
+  ge_p2 q;
+  ge_p3 sum;
+  ge_p3 tot;
+  ge_cached tc;
+  int c;
+  int w;
+  int i;
+  int j;
+  int b;
+  int d;
+  int nb;
+  int nw;
+  int sumSet;
+  int totSet;
+
+  if (n <= 0) {
+    fe_0(r->X); fe_1(r->Y); fe_1(r->Z); fe_0(r->T);
+    return 0;
+  }
+  if (n <= GE_MULTI_STRAUS_MAX)
+    return ge_multi_scalarmult_straus(r, s, P, n);
+
+  c = ge_multi_window(n);
+  nb = 1 << (c - 1);
+  nw = (256 + c) / c;
+
+  Pc = (ge_cached *)XMALLOC((size_t)n * sizeof(*Pc), NULL,
+                            DYNAMIC_TYPE_TMP_BUFFER);
+  bucket = (ge_p3 *)XMALLOC((size_t)(nb + 1) * sizeof(*bucket), NULL,
+                            DYNAMIC_TYPE_TMP_BUFFER);
+  used = (byte *)XMALLOC((size_t)nb + 1, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+  dig = (short *)XMALLOC((size_t)n * (size_t)nw * sizeof(*dig), NULL,
+                         DYNAMIC_TYPE_TMP_BUFFER);
+  if ((Pc == NULL) || (bucket == NULL) || (used == NULL) || (dig == NULL)) {
+    XFREE(dig, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    XFREE(used, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    XFREE(bucket, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    XFREE(Pc, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    return MEMORY_E;
+  }
+
+  for (i = 0; i < n; i++) {
+    ge_p3_to_cached(&Pc[i], &P[i]);
+    /* a window of 2^(c-1) or more borrows from the next window */
+    b = 0;
+    for (w = 0; w < nw; w++) {
+      d = ((w * c < 256) ? ge_scalar_bits(s + 32 * i, w * c, c) : 0) + b;
+      b = (d + (1 << (c - 1))) >> c;
+      dig[i * nw + w] = (short)(d - (b << c));
+    }
+  }
+
+  fe_0(r->X); fe_1(r->Y); fe_1(r->Z); fe_0(r->T);
+  for (w = nw - 1; w >= 0; w--) {
+    /* r = 2^c * r */
+    ge_p3_dbl(&t, r);
+    for (j = 1; j < c; j++) {
+      ge_p1p1_to_p2(&q, &t);
+      ge_p2_dbl(&t, &q);
+    }
+    ge_p1p1_to_p3(r, &t);
+
+    /* add each point into the bucket of its digit */
+    XMEMSET(used, 0, (size_t)nb + 1);
+    for (i = 0; i < n; i++) {
+      d = dig[i * nw + w];
+      if (d == 0)
+        continue;
+      b = (d > 0) ? d : -d;
+      if (!used[b]) {
+        bucket[b] = P[i];
+        if (d < 0) {
+          fe_neg(bucket[b].X, bucket[b].X);
+          fe_neg(bucket[b].T, bucket[b].T);
+        }
+        used[b] = 1;
+      }
+      else {
+        if (d > 0)
+          ge_add(&t, &bucket[b], &Pc[i]);
+        else
+          ge_sub(&t, &bucket[b], &Pc[i]);
+        ge_p1p1_to_p3(&bucket[b], &t);
+      }
+    }
+
+    /* tot = sum of b * bucket[b] = sum of running sums from the top */
+    sumSet = 0;
+    totSet = 0;
+    for (b = nb; b > 0; b--) {
+      if (used[b]) {
+        if (sumSet) {
+          ge_p3_to_cached(&tc, &bucket[b]);
+          ge_add(&t, &sum, &tc);
+          ge_p1p1_to_p3(&sum, &t);
+        }
+        else {
+          sum = bucket[b];
+          sumSet = 1;
+        }
+      }
+      if (sumSet) {
+        if (totSet) {
+          ge_p3_to_cached(&tc, &sum);
+          ge_add(&t, &tot, &tc);
+          ge_p1p1_to_p3(&tot, &t);
+        }
+        else {
+          tot = sum;
+          totSet = 1;
+        }
+      }
+    }
+    if (totSet) {
+      ge_p3_to_cached(&tc, &tot);
+      ge_add(&t, r, &tc);
+      ge_p1p1_to_p3(r, &t);
+    }
+  }
+
+  XFREE(dig, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+  XFREE(used, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+  XFREE(bucket, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+  XFREE(Pc, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+
+  return 0;
+}
+#endif /* WOLFSSL_ED25519_BATCH_VERIFY || WOLFSSL_ED25519_MULTI_SCALAR */
+
 #ifdef CURVED25519_ASM_64BIT
 static const ge d = {
     0x75eb4dca135978a3, 0x00700a4d4141d8ab, -0x7338bf8688861768, 0x52036cee2b6ffe73,
@@ -711,7 +711,9 @@ int wc_Poly1305Update(Poly1305* ctx, const byte* m, word32 bytes)
 
 #if defined(WOLFSSL_X86_64_BUILD) && defined(USE_INTEL_SPEEDUP)
     #ifdef HAVE_INTEL_AVX2
-    if (IS_INTEL_AVX2(intel_flags)) {
+    /* finished is the scalar code's high bit: once set by
+     * wc_Poly1305_UseScalar the four AVX2 lanes are not used again */
+    if (IS_INTEL_AVX2(intel_flags) && !ctx->finished) {
         SAVE_VECTOR_REGISTERS(return _svr_ret;);
 
         /* handle leftover */
@@ -802,6 +804,50 @@ int wc_Poly1305Update(Poly1305* ctx, const byte* m, word32 bytes)
     return 0;
 }
 
+#if defined(WOLFSSL_X86_64_BUILD) && defined(USE_INTEL_SPEEDUP)
+/*  Makes h the only accumulator so that whole blocks can be hashed by code
+    outside this file, such as a kernel stitched with ChaCha20. AVX2 lane
+    state and buffered whole blocks are folded into h; a partial block stays
+    in the buffer. Later updates on ctx use the one block at a time code.
+    ctx        : Initialized Poly1305 struct to use
+ */
+int wc_Poly1305_UseScalar(Poly1305* ctx)
+{
+#ifdef HAVE_INTEL_AVX2
+    size_t i;
+    size_t full;
+#endif
+
+    if (ctx == NULL) {
+        return BAD_FUNC_ARG;
+    }
+
+#ifdef HAVE_INTEL_AVX2
+    if (IS_INTEL_AVX2(intel_flags) && !ctx->finished) {
+        SAVE_VECTOR_REGISTERS(return _svr_ret;);
+        /* high bit of the scalar code and marks the lanes as folded */
+        ctx->finished = 1;
+        if (ctx->started) {
+            /* multiply the lanes by r^4..r^1 and add them into h */
+            poly1305_blocks_avx2(ctx, NULL, 4 * POLY1305_BLOCK_SIZE);
+            ForceZero(ctx->hh, sizeof(ctx->hh));
+            ctx->started = 0;
+        }
+        full = ctx->leftover & ~((size_t)POLY1305_BLOCK_SIZE - 1);
+        if (full > 0) {
+            poly1305_blocks_avx(ctx, ctx->buffer, full);
+            for (i = full; i < ctx->leftover; i++)
+                ctx->buffer[i - full] = ctx->buffer[i];
+            ctx->leftover -= full;
+        }
+        RESTORE_VECTOR_REGISTERS();
+    }
+#endif
+
+    return 0;
+}
+#endif
+
 /*  Takes a Poly1305 struct that has a key loaded and pads the provided length
     ctx        : Initialized Poly1305 struct to use
     lenToPad   : Current number of bytes updated that needs padding to 16
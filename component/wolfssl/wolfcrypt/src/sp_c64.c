@@ -24217,6 +24217,254 @@ int sp_ecc_mulmod_256(const mp_int* km, const ecc_point* gm, ecc_point* r,
     return err;
 }
 
+#ifdef WOLFSSL_ECC_MULTI_SCALAR
+/* Add two Montgomery form projective points for a multi-scalar
+ * multiplication.
+ *
+ * Ordinates are not fully reduced so equal points may not be found before
+ * the addition. A Z ordinate of zero (or the modulus) is fixed up afterwards:
+ * when X is also zero the points were the same so q is doubled, otherwise p
+ * was the negative of q and the result is infinity.
+ *
+ * r    Result of addition. May be the same pointer as p.
+ * p    First point to add.
+ * q    Second point to add.
+ * qz1  Whether q has a Z ordinate of one.
+ * t    Temporary ordinate data.
+ */
+static void sp_256_proj_point_add_multi_5(sp_point_256* r,
+    const sp_point_256* p, const sp_point_256* q, int qz1, sp_digit* t)
+{
+#ifndef WOLFSSL_SP_SMALL
+    if (qz1) {
+        sp_256_proj_point_add_qz1_5(r, p, q, t);
+    }
+    else
+#endif
+    {
+        (void)qz1;
+        sp_256_proj_point_add_5(r, p, q, t);
+    }
+
+    if ((!r->infinity) && (sp_256_iszero_5(r->z) |
+                           sp_256_cmp_equal_5(r->z, p256_mod))) {
+        if (sp_256_iszero_5(r->x) | sp_256_cmp_equal_5(r->x, p256_mod)) {
+            sp_256_proj_point_dbl_5(r, q, t);
+        }
+        else {
+            r->infinity = 1;
+        }
+    }
+}
+
+/* Get the window size of Pippenger's method for a number of points.
+ *
+ * Each window adds every point into a bucket and then adds each of the
+ * 2^(c-1) buckets into two running sums.
+ *
+ * cnt  Number of points.
+ * returns the window size in bits with the fewest point additions.
+ */
+static int sp_256_ecc_multi_window(int cnt)
+{
+    int c;
+    int best = 2;
+    word64 cost;
+    word64 bestCost = (word64)-1;
+
+    for (c = 2; c <= 16; c++) {
+        cost = (word64)((256 + c) / c) * ((word64)cnt + ((word64)1 << c));
+        if (cost < bestCost) {
+            bestCost = cost;
+            best = c;
+        }
+    }
+
+    return best;
+}
+
+/* Convert a scalar into signed digits of c bits.
+ *
+ * A window value of 2^(c-1) or more is made negative by carrying one into the
+ * next window. Digits are in the range -2^(c-1)..2^(c-1)-1.
+ *
+ * d  Signed digits, least significant first.
+ * k  Scalar to convert.
+ * c  Window size in bits.
+ * w  Number of windows.
+ */
+static void sp_256_ecc_recode_multi_5(sp_int16* d, const sp_digit* k, int c,
+    int w)
+{
+    int i;
+    int j;
+    int o;
+    sp_digit v;
+    sp_digit carry = 0;
+
+    for (i = 0; i < w; i++) {
+        j = (i * c) / 52;
+        o = (i * c) % 52;
+        v = 0;
+        if (j < 5) {
+            v = k[j] >> o;
+            if ((o + c > 52) && (j + 1 < 5)) {
+                v |= k[j + 1] << (52 - o);
+            }
+        }
+        v = (v & (((sp_digit)1 << c) - 1)) + carry;
+        carry = (v + ((sp_digit)1 << (c - 1))) >> c;
+        d[i] = (sp_int16)(v - (carry << c));
+    }
+}
+
+/* Multiply each point by its scalar and add the results.
+ *
+ * Pippenger's bucket method: for each window of c bits, from the top, the
+ * result is doubled c times and each point (negated for a negative digit) is
+ * added into the bucket of its digit. The buckets are summed with running
+ * sums so that bucket b is added b times.
+ * Not constant time - only for public scalars.
+ *
+ * cnt   Number of points.
+ * km    Scalars to multiply by. Each less than 2^256.
+ * gm    Points to multiply. Each affine or infinity.
+ * r     Resulting point in affine coordinates.
+ * heap  Heap to use for allocation.
+ * returns MEMORY_E when memory allocation fails and MP_OKAY on success.
+ */
+int sp_ecc_mulmod_multi_256(int cnt, mp_int** km, ecc_point** gm,
+    ecc_point* r, void* heap)
+{
+    sp_point_256* p = NULL;
+    sp_point_256* bucket = NULL;
+    sp_point_256* run = NULL;
+    sp_point_256* sum = NULL;
+    sp_point_256* acc = NULL;
+    sp_point_256* neg = NULL;
+    sp_digit* k = NULL;
+    sp_digit* tmp = NULL;
+    sp_int16* d = NULL;
+    int err = MP_OKAY;
+    int c;
+    int w;
+    int nb;
+    int i;
+    int j;
+    int b;
+    int v;
+
+    (void)heap;
+
+    if (cnt < 0) {
+        cnt = 0;
+    }
+    c = sp_256_ecc_multi_window(cnt);
+    w = (256 + c) / c;
+    nb = 1 << (c - 1);
+
+    /* Points, buckets, running sums, result and a negated point. */
+    p = (sp_point_256*)XMALLOC(sizeof(sp_point_256) * (size_t)(cnt + nb + 4),
+        heap, DYNAMIC_TYPE_ECC);
+    if (p == NULL)
+        err = MEMORY_E;
+    if (err == MP_OKAY) {
+        k = (sp_digit*)XMALLOC(sizeof(sp_digit) * (5 + 2 * 5 * 6), heap,
+                               DYNAMIC_TYPE_ECC);
+        if (k == NULL)
+            err = MEMORY_E;
+    }
+    if ((err == MP_OKAY) && (cnt > 0)) {
+        d = (sp_int16*)XMALLOC(sizeof(sp_int16) * (size_t)cnt * (size_t)w,
+                               heap, DYNAMIC_TYPE_ECC);
+        if (d == NULL)
+            err = MEMORY_E;
+    }
+
+    if (err == MP_OKAY) {
+        bucket = p + cnt;
+        run = bucket + nb;
+        sum = run + 1;
+        acc = sum + 1;
+        neg = acc + 1;
+        tmp = k + 5;
+        XMEMSET(bucket, 0, sizeof(sp_point_256) * (size_t)(nb + 4));
+        acc->infinity = 1;
+    }
+
+    for (i = 0; (err == MP_OKAY) && (i < cnt); i++) {
+        sp_256_from_mp(k, 5, km[i]);
+        sp_256_ecc_recode_multi_5(d + i * w, k, c, w);
+
+        sp_256_point_from_ecc_point_5(&p[i], gm[i]);
+        p[i].infinity = (word32)(sp_256_iszero_5(p[i].x) &
+                                 sp_256_iszero_5(p[i].y));
+        err = sp_256_mod_mul_norm_5(p[i].x, p[i].x, p256_mod);
+        if (err == MP_OKAY)
+            err = sp_256_mod_mul_norm_5(p[i].y, p[i].y, p256_mod);
+        if (err == MP_OKAY)
+            err = sp_256_mod_mul_norm_5(p[i].z, p[i].z, p256_mod);
+    }
+
+    for (j = w - 1; (err == MP_OKAY) && (j >= 0); j--) {
+        if (!acc->infinity) {
+            for (b = 0; b < c; b++) {
+                sp_256_proj_point_dbl_5(acc, acc, tmp);
+            }
+        }
+
+        for (b = 0; b < nb; b++) {
+            bucket[b].infinity = 1;
+        }
+        for (i = 0; i < cnt; i++) {
+            v = d[i * w + j];
+            if (v > 0) {
+                sp_256_proj_point_add_multi_5(&bucket[v - 1], &bucket[v - 1],
+                    &p[i], 1, tmp);
+            }
+            else if (v < 0) {
+                XMEMCPY(neg->x, p[i].x, sizeof(sp_digit) * 5);
+                XMEMCPY(neg->z, p[i].z, sizeof(sp_digit) * 5);
+                (void)sp_256_sub_5(neg->y, p256_mod, p[i].y);
+                sp_256_norm_5(neg->y);
+                neg->infinity = p[i].infinity;
+                sp_256_proj_point_add_multi_5(&bucket[-v - 1],
+                    &bucket[-v - 1], neg, 1, tmp);
+            }
+        }
+
+        /* sum = bucket[0] + 2.bucket[1] + ... + nb.bucket[nb-1] */
+        run->infinity = 1;
+        sum->infinity = 1;
+        for (b = nb - 1; b >= 0; b--) {
+            sp_256_proj_point_add_multi_5(run, run, &bucket[b], 0, tmp);
+            sp_256_proj_point_add_multi_5(sum, sum, run, 0, tmp);
+        }
+        sp_256_proj_point_add_multi_5(acc, acc, sum, 0, tmp);
+    }
+
+    if (err == MP_OKAY) {
+        if (acc->infinity) {
+            XMEMSET(acc, 0, sizeof(sp_point_256));
+            acc->z[0] = 1;
+        }
+        else {
+            sp_256_map_5(acc, acc, tmp);
+        }
+        err = sp_256_point_to_ecc_point_5(acc, r);
+    }
+
+    if (d != NULL)
+        XFREE(d, heap, DYNAMIC_TYPE_ECC);
+    if (k != NULL)
+        XFREE(k, heap, DYNAMIC_TYPE_ECC);
+    if (p != NULL)
+        XFREE(p, heap, DYNAMIC_TYPE_ECC);
+
+    return err;
+}
+#endif /* WOLFSSL_ECC_MULTI_SCALAR */
+
 /* Multiply the point by the scalar, add point a and return the result.
  * If map is true then convert result to affine coordinates.
  *
@@ -25927,6 +26175,162 @@ int sp_ecc_make_key_256(WC_RNG* rng, mp_int* priv, ecc_point* pub, void* heap)
     return err;
 }
 
+#ifdef WOLFSSL_ECC_KEYGEN_BATCH
+/* Map a Montgomery form projective coordinate point to an affine point using
+ * the inverse of the Z ordinate.
+ *
+ * p   Montgomery form projective coordinate point. Result in place.
+ * zi  Inverse of Z ordinate in Montgomery form.
+ * t   Temporary ordinate data.
+ */
+static void sp_256_map_zi_5(sp_point_256* p, const sp_digit* zi, sp_digit* t)
+{
+    sp_digit* t1 = t;
+    sp_digit* t2 = t + 2*5;
+    sp_int64 n;
+
+    sp_256_mont_sqr_5(t2, zi, p256_mod, p256_mp_mod);
+    sp_256_mont_mul_5(t1, t2, zi, p256_mod, p256_mp_mod);
+
+    /* x /= z^2 */
+    sp_256_mont_mul_5(p->x, p->x, t2, p256_mod, p256_mp_mod);
+    XMEMSET(p->x + 5, 0, sizeof(sp_digit) * 5U);
+    sp_256_mont_reduce_5(p->x, p256_mod, p256_mp_mod);
+    /* Reduce x to less than modulus */
+    n = sp_256_cmp_5(p->x, p256_mod);
+    sp_256_cond_sub_5(p->x, p->x, p256_mod, ~(n >> 51));
+    sp_256_norm_5(p->x);
+
+    /* y /= z^3 */
+    sp_256_mont_mul_5(p->y, p->y, t1, p256_mod, p256_mp_mod);
+    XMEMSET(p->y + 5, 0, sizeof(sp_digit) * 5U);
+    sp_256_mont_reduce_5(p->y, p256_mod, p256_mp_mod);
+    /* Reduce y to less than modulus */
+    n = sp_256_cmp_5(p->y, p256_mod);
+    sp_256_cond_sub_5(p->y, p->y, p256_mod, ~(n >> 51));
+    sp_256_norm_5(p->y);
+
+    XMEMSET(p->z, 0, sizeof(p->z) / 2);
+    p->z[0] = 1;
+}
+
+/* Makes cnt random EC key pairs sharing one modular inversion.
+ *
+ * The public points are left in projective coordinates and all the Z
+ * ordinates are inverted at once with Montgomery's trick: one inversion and
+ * three multiplications per point.
+ *
+ * rng   Random number generator.
+ * cnt   Number of key pairs to make.
+ * priv  Generated private values.
+ * pub   Generated public points.
+ * heap  Heap to use for allocation.
+ * returns ECC_INF_E when a point does not have the correct order, RNG
+ * failures, MEMORY_E when memory allocation fails and MP_OKAY on success.
+ */
+int sp_ecc_make_key_batch_256(WC_RNG* rng, int cnt, mp_int** priv,
+    ecc_point** pub, void* heap)
+{
+    sp_point_256* point = NULL;
+    sp_digit* k = NULL;
+    sp_digit* pz = NULL;
+    sp_digit* t = NULL;
+#ifdef WOLFSSL_VALIDATE_ECC_KEYGEN
+    sp_point_256* infinity = NULL;
+#endif
+    int err = MP_OKAY;
+    int i;
+
+    (void)heap;
+
+    if (cnt <= 0) {
+        return MP_OKAY;
+    }
+
+    /* Last point is for the order check. */
+    point = (sp_point_256*)XMALLOC(sizeof(sp_point_256) * (cnt + 1), heap,
+                                 DYNAMIC_TYPE_ECC);
+    if (point == NULL)
+        err = MEMORY_E;
+    if (err == MP_OKAY) {
+        /* k, products of Z ordinates, inverse and inversion temporaries. */
+        k = (sp_digit*)XMALLOC(sizeof(sp_digit) * (5 + 2 * 5 * cnt +
+                               2 * 5 * 6), heap, DYNAMIC_TYPE_ECC);
+        if (k == NULL)
+            err = MEMORY_E;
+    }
+
+    if (err == MP_OKAY) {
+    #ifdef WOLFSSL_VALIDATE_ECC_KEYGEN
+        infinity = point + cnt;
+    #endif
+        pz = k + 5;
+        t = pz + 2 * 5 * cnt;
+    }
+
+    /* pz[i] = z[0] * z[1] * ... * z[i] */
+    for (i = 0; (err == MP_OKAY) && (i < cnt); i++) {
+        err = sp_256_ecc_gen_k_5(rng, k);
+        if (err == MP_OKAY) {
+            err = sp_256_ecc_mulmod_base_5(&point[i], k, 0, 1, heap);
+        }
+        if (err == MP_OKAY) {
+            err = sp_256_to_mp(k, priv[i]);
+        }
+        if (err == MP_OKAY) {
+            if (i == 0) {
+                XMEMCPY(pz, point[0].z, sizeof(sp_digit) * 5);
+            }
+            else {
+                sp_256_mont_mul_5(pz + 2 * 5 * i, pz + 2 * 5 * (i - 1),
+                    point[i].z, p256_mod, p256_mp_mod);
+            }
+        }
+    }
+
+    if (err == MP_OKAY) {
+        /* t = 1 / (z[0] * ... * z[cnt-1]) */
+        sp_256_mont_inv_5(t, pz + 2 * 5 * (cnt - 1), t + 2 * 5);
+        for (i = cnt - 1; i > 0; i--) {
+            /* 1 / z[i] = t * z[0] * ... * z[i-1] */
+            sp_256_mont_mul_5(pz + 2 * 5 * i, t, pz + 2 * 5 * (i - 1),
+                p256_mod, p256_mp_mod);
+            sp_256_mont_mul_5(t, t, point[i].z, p256_mod, p256_mp_mod);
+            sp_256_map_zi_5(&point[i], pz + 2 * 5 * i, t + 2 * 5);
+        }
+        sp_256_map_zi_5(&point[0], t, t + 2 * 5);
+    }
+
+    for (i = 0; (err == MP_OKAY) && (i < cnt); i++) {
+    #ifdef WOLFSSL_VALIDATE_ECC_KEYGEN
+        err = sp_256_ecc_mulmod_5(infinity, &point[i], p256_order, 1, 1,
+            NULL);
+        if (err == MP_OKAY) {
+            if (sp_256_iszero_5(point[i].x) ||
+                    sp_256_iszero_5(point[i].y)) {
+                err = ECC_INF_E;
+            }
+        }
+        if (err == MP_OKAY)
+    #endif
+        {
+            err = sp_256_point_to_ecc_point_5(&point[i], pub[i]);
+        }
+    }
+
+    if (k != NULL) {
+        ForceZero(k, sizeof(sp_digit) * 5);
+        XFREE(k, heap, DYNAMIC_TYPE_ECC);
+    }
+    if (point != NULL) {
+        /* point is not sensitive, so no need to zeroize */
+        XFREE(point, heap, DYNAMIC_TYPE_ECC);
+    }
+
+    return err;
+}
+#endif /* WOLFSSL_ECC_KEYGEN_BATCH */
+
 #ifdef WOLFSSL_SP_NONBLOCK
 typedef struct sp_ecc_key_gen_256_ctx {
     int state;
@@ -31198,6 +31602,254 @@ int sp_ecc_mulmod_384(const mp_int* km, const ecc_point* gm, ecc_point* r,
     return err;
 }
 
+#ifdef WOLFSSL_ECC_MULTI_SCALAR
+/* Add two Montgomery form projective points for a multi-scalar
+ * multiplication.
+ *
+ * Ordinates are not fully reduced so equal points may not be found before
+ * the addition. A Z ordinate of zero (or the modulus) is fixed up afterwards:
+ * when X is also zero the points were the same so q is doubled, otherwise p
+ * was the negative of q and the result is infinity.
+ *
+ * r    Result of addition. May be the same pointer as p.
+ * p    First point to add.
+ * q    Second point to add.
+ * qz1  Whether q has a Z ordinate of one.
+ * t    Temporary ordinate data.
+ */
+static void sp_384_proj_point_add_multi_7(sp_point_384* r,
+    const sp_point_384* p, const sp_point_384* q, int qz1, sp_digit* t)
+{
+#ifndef WOLFSSL_SP_SMALL
+    if (qz1) {
+        sp_384_proj_point_add_qz1_7(r, p, q, t);
+    }
+    else
+#endif
+    {
+        (void)qz1;
+        sp_384_proj_point_add_7(r, p, q, t);
+    }
+
+    if ((!r->infinity) && (sp_384_iszero_7(r->z) |
+                           sp_384_cmp_equal_7(r->z, p384_mod))) {
+        if (sp_384_iszero_7(r->x) | sp_384_cmp_equal_7(r->x, p384_mod)) {
+            sp_384_proj_point_dbl_7(r, q, t);
+        }
+        else {
+            r->infinity = 1;
+        }
+    }
+}
+
+/* Get the window size of Pippenger's method for a number of points.
+ *
+ * Each window adds every point into a bucket and then adds each of the
+ * 2^(c-1) buckets into two running sums.
+ *
+ * cnt  Number of points.
+ * returns the window size in bits with the fewest point additions.
+ */
+static int sp_384_ecc_multi_window(int cnt)
+{
+    int c;
+    int best = 2;
+    word64 cost;
+    word64 bestCost = (word64)-1;
+
+    for (c = 2; c <= 16; c++) {
+        cost = (word64)((384 + c) / c) * ((word64)cnt + ((word64)1 << c));
+        if (cost < bestCost) {
+            bestCost = cost;
+            best = c;
+        }
+    }
+
+    return best;
+}
+
+/* Convert a scalar into signed digits of c bits.
+ *
+ * A window value of 2^(c-1) or more is made negative by carrying one into the
+ * next window. Digits are in the range -2^(c-1)..2^(c-1)-1.
+ *
+ * d  Signed digits, least significant first.
+ * k  Scalar to convert.
+ * c  Window size in bits.
+ * w  Number of windows.
+ */
+static void sp_384_ecc_recode_multi_7(sp_int16* d, const sp_digit* k, int c,
+    int w)
+{
+    int i;
+    int j;
+    int o;
+    sp_digit v;
+    sp_digit carry = 0;
+
+    for (i = 0; i < w; i++) {
+        j = (i * c) / 55;
+        o = (i * c) % 55;
+        v = 0;
+        if (j < 7) {
+            v = k[j] >> o;
+            if ((o + c > 55) && (j + 1 < 7)) {
+                v |= k[j + 1] << (55 - o);
+            }
+        }
+        v = (v & (((sp_digit)1 << c) - 1)) + carry;
+        carry = (v + ((sp_digit)1 << (c - 1))) >> c;
+        d[i] = (sp_int16)(v - (carry << c));
+    }
+}
+
+/* Multiply each point by its scalar and add the results.
+ *
+ * Pippenger's bucket method: for each window of c bits, from the top, the
+ * result is doubled c times and each point (negated for a negative digit) is
+ * added into the bucket of its digit. The buckets are summed with running
+ * sums so that bucket b is added b times.
+ * Not constant time - only for public scalars.
+ *
+ * cnt   Number of points.
+ * km    Scalars to multiply by. Each less than 2^384.
+ * gm    Points to multiply. Each affine or infinity.
+ * r     Resulting point in affine coordinates.
+ * heap  Heap to use for allocation.
+ * returns MEMORY_E when memory allocation fails and MP_OKAY on success.
+ */
+int sp_ecc_mulmod_multi_384(int cnt, mp_int** km, ecc_point** gm,
+    ecc_point* r, void* heap)
+{
+    sp_point_384* p = NULL;
+    sp_point_384* bucket = NULL;
+    sp_point_384* run = NULL;
+    sp_point_384* sum = NULL;
+    sp_point_384* acc = NULL;
+    sp_point_384* neg = NULL;
+    sp_digit* k = NULL;
+    sp_digit* tmp = NULL;
+    sp_int16* d = NULL;
+    int err = MP_OKAY;
+    int c;
+    int w;
+    int nb;
+    int i;
+    int j;
+    int b;
+    int v;
+
+    (void)heap;
+
+    if (cnt < 0) {
+        cnt = 0;
+    }
+    c = sp_384_ecc_multi_window(cnt);
+    w = (384 + c) / c;
+    nb = 1 << (c - 1);
+
+    /* Points, buckets, running sums, result and a negated point. */
+    p = (sp_point_384*)XMALLOC(sizeof(sp_point_384) * (size_t)(cnt + nb + 4),
+        heap, DYNAMIC_TYPE_ECC);
+    if (p == NULL)
+        err = MEMORY_E;
+    if (err == MP_OKAY) {
+        k = (sp_digit*)XMALLOC(sizeof(sp_digit) * (7 + 2 * 7 * 6), heap,
+                               DYNAMIC_TYPE_ECC);
+        if (k == NULL)
+            err = MEMORY_E;
+    }
+    if ((err == MP_OKAY) && (cnt > 0)) {
+        d = (sp_int16*)XMALLOC(sizeof(sp_int16) * (size_t)cnt * (size_t)w,
+                               heap, DYNAMIC_TYPE_ECC);
+        if (d == NULL)
+            err = MEMORY_E;
+    }
+
+    if (err == MP_OKAY) {
+        bucket = p + cnt;
+        run = bucket + nb;
+        sum = run + 1;
+        acc = sum + 1;
+        neg = acc + 1;
+        tmp = k + 7;
+        XMEMSET(bucket, 0, sizeof(sp_point_384) * (size_t)(nb + 4));
+        acc->infinity = 1;
+    }
+
+    for (i = 0; (err == MP_OKAY) && (i < cnt); i++) {
+        sp_384_from_mp(k, 7, km[i]);
+        sp_384_ecc_recode_multi_7(d + i * w, k, c, w);
+
+        sp_384_point_from_ecc_point_7(&p[i], gm[i]);
+        p[i].infinity = (word32)(sp_384_iszero_7(p[i].x) &
+                                 sp_384_iszero_7(p[i].y));
+        err = sp_384_mod_mul_norm_7(p[i].x, p[i].x, p384_mod);
+        if (err == MP_OKAY)
+            err = sp_384_mod_mul_norm_7(p[i].y, p[i].y, p384_mod);
+        if (err == MP_OKAY)
+            err = sp_384_mod_mul_norm_7(p[i].z, p[i].z, p384_mod);
+    }
+
+    for (j = w - 1; (err == MP_OKAY) && (j >= 0); j--) {
+        if (!acc->infinity) {
+            for (b = 0; b < c; b++) {
+                sp_384_proj_point_dbl_7(acc, acc, tmp);
+            }
+        }
+
+        for (b = 0; b < nb; b++) {
+            bucket[b].infinity = 1;
+        }
+        for (i = 0; i < cnt; i++) {
+            v = d[i * w + j];
+            if (v > 0) {
+                sp_384_proj_point_add_multi_7(&bucket[v - 1], &bucket[v - 1],
+                    &p[i], 1, tmp);
+            }
+            else if (v < 0) {
+                XMEMCPY(neg->x, p[i].x, sizeof(sp_digit) * 7);
+                XMEMCPY(neg->z, p[i].z, sizeof(sp_digit) * 7);
+                (void)sp_384_sub_7(neg->y, p384_mod, p[i].y);
+                sp_384_norm_7(neg->y);
+                neg->infinity = p[i].infinity;
+                sp_384_proj_point_add_multi_7(&bucket[-v - 1],
+                    &bucket[-v - 1], neg, 1, tmp);
+            }
+        }
+
+        /* sum = bucket[0] + 2.bucket[1] + ... + nb.bucket[nb-1] */
+        run->infinity = 1;
+        sum->infinity = 1;
+        for (b = nb - 1; b >= 0; b--) {
+            sp_384_proj_point_add_multi_7(run, run, &bucket[b], 0, tmp);
+            sp_384_proj_point_add_multi_7(sum, sum, run, 0, tmp);
+        }
+        sp_384_proj_point_add_multi_7(acc, acc, sum, 0, tmp);
+    }
+
+    if (err == MP_OKAY) {
+        if (acc->infinity) {
+            XMEMSET(acc, 0, sizeof(sp_point_384));
+            acc->z[0] = 1;
+        }
+        else {
+            sp_384_map_7(acc, acc, tmp);
+        }
+        err = sp_384_point_to_ecc_point_7(acc, r);
+    }
+
+    if (d != NULL)
+        XFREE(d, heap, DYNAMIC_TYPE_ECC);
+    if (k != NULL)
+        XFREE(k, heap, DYNAMIC_TYPE_ECC);
+    if (p != NULL)
+        XFREE(p, heap, DYNAMIC_TYPE_ECC);
+
+    return err;
+}
+#endif /* WOLFSSL_ECC_MULTI_SCALAR */
+
 /* Multiply the point by the scalar, add point a and return the result.
  * If map is true then convert result to affine coordinates.
  *
@@ -33418,6 +34070,162 @@ int sp_ecc_make_key_384(WC_RNG* rng, mp_int* priv, ecc_point* pub, void* heap)
     return err;
 }
 
+#ifdef WOLFSSL_ECC_KEYGEN_BATCH
+/* Map a Montgomery form projective coordinate point to an affine point using
+ * the inverse of the Z ordinate.
+ *
+ * p   Montgomery form projective coordinate point. Result in place.
+ * zi  Inverse of Z ordinate in Montgomery form.
+ * t   Temporary ordinate data.
+ */
+static void sp_384_map_zi_7(sp_point_384* p, const sp_digit* zi, sp_digit* t)
+{
+    sp_digit* t1 = t;
+    sp_digit* t2 = t + 2*7;
+    sp_int64 n;
+
+    sp_384_mont_sqr_7(t2, zi, p384_mod, p384_mp_mod);
+    sp_384_mont_mul_7(t1, t2, zi, p384_mod, p384_mp_mod);
+
+    /* x /= z^2 */
+    sp_384_mont_mul_7(p->x, p->x, t2, p384_mod, p384_mp_mod);
+    XMEMSET(p->x + 7, 0, sizeof(sp_digit) * 7U);
+    sp_384_mont_reduce_7(p->x, p384_mod, p384_mp_mod);
+    /* Reduce x to less than modulus */
+    n = sp_384_cmp_7(p->x, p384_mod);
+    sp_384_cond_sub_7(p->x, p->x, p384_mod, ~(n >> 54));
+    sp_384_norm_7(p->x);
+
+    /* y /= z^3 */
+    sp_384_mont_mul_7(p->y, p->y, t1, p384_mod, p384_mp_mod);
+    XMEMSET(p->y + 7, 0, sizeof(sp_digit) * 7U);
+    sp_384_mont_reduce_7(p->y, p384_mod, p384_mp_mod);
+    /* Reduce y to less than modulus */
+    n = sp_384_cmp_7(p->y, p384_mod);
+    sp_384_cond_sub_7(p->y, p->y, p384_mod, ~(n >> 54));
+    sp_384_norm_7(p->y);
+
+    XMEMSET(p->z, 0, sizeof(p->z) / 2);
+    p->z[0] = 1;
+}
+
+/* Makes cnt random EC key pairs sharing one modular inversion.
+ *
+ * The public points are left in projective coordinates and all the Z
+ * ordinates are inverted at once with Montgomery's trick: one inversion and
+ * three multiplications per point.
+ *
+ * rng   Random number generator.
+ * cnt   Number of key pairs to make.
+ * priv  Generated private values.
+ * pub   Generated public points.
+ * heap  Heap to use for allocation.
+ * returns ECC_INF_E when a point does not have the correct order, RNG
+ * failures, MEMORY_E when memory allocation fails and MP_OKAY on success.
+ */
+int sp_ecc_make_key_batch_384(WC_RNG* rng, int cnt, mp_int** priv,
+    ecc_point** pub, void* heap)
+{
+    sp_point_384* point = NULL;
+    sp_digit* k = NULL;
+    sp_digit* pz = NULL;
+    sp_digit* t = NULL;
+#ifdef WOLFSSL_VALIDATE_ECC_KEYGEN
+    sp_point_384* infinity = NULL;
+#endif
+    int err = MP_OKAY;
+    int i;
+
+    (void)heap;
+
+    if (cnt <= 0) {
+        return MP_OKAY;
+    }
+
+    /* Last point is for the order check. */
+    point = (sp_point_384*)XMALLOC(sizeof(sp_point_384) * (cnt + 1), heap,
+                                 DYNAMIC_TYPE_ECC);
+    if (point == NULL)
+        err = MEMORY_E;
+    if (err == MP_OKAY) {
+        /* k, products of Z ordinates, inverse and inversion temporaries. */
+        k = (sp_digit*)XMALLOC(sizeof(sp_digit) * (7 + 2 * 7 * cnt +
+                               2 * 7 * 6), heap, DYNAMIC_TYPE_ECC);
+        if (k == NULL)
+            err = MEMORY_E;
+    }
+
+    if (err == MP_OKAY) {
+    #ifdef WOLFSSL_VALIDATE_ECC_KEYGEN
+        infinity = point + cnt;
+    #endif
+        pz = k + 7;
+        t = pz + 2 * 7 * cnt;
+    }
+
+    /* pz[i] = z[0] * z[1] * ... * z[i] */
+    for (i = 0; (err == MP_OKAY) && (i < cnt); i++) {
+        err = sp_384_ecc_gen_k_7(rng, k);
+        if (err == MP_OKAY) {
+            err = sp_384_ecc_mulmod_base_7(&point[i], k, 0, 1, heap);
+        }
+        if (err == MP_OKAY) {
+            err = sp_384_to_mp(k, priv[i]);
+        }
+        if (err == MP_OKAY) {
+            if (i == 0) {
+                XMEMCPY(pz, point[0].z, sizeof(sp_digit) * 7);
+            }
+            else {
+                sp_384_mont_mul_7(pz + 2 * 7 * i, pz + 2 * 7 * (i - 1),
+                    point[i].z, p384_mod, p384_mp_mod);
+            }
+        }
+    }
+
+    if (err == MP_OKAY) {
+        /* t = 1 / (z[0] * ... * z[cnt-1]) */
+        sp_384_mont_inv_7(t, pz + 2 * 7 * (cnt - 1), t + 2 * 7);
+        for (i = cnt - 1; i > 0; i--) {
+            /* 1 / z[i] = t * z[0] * ... * z[i-1] */
+            sp_384_mont_mul_7(pz + 2 * 7 * i, t, pz + 2 * 7 * (i - 1),
+                p384_mod, p384_mp_mod);
+            sp_384_mont_mul_7(t, t, point[i].z, p384_mod, p384_mp_mod);
+            sp_384_map_zi_7(&point[i], pz + 2 * 7 * i, t + 2 * 7);
+        }
+        sp_384_map_zi_7(&point[0], t, t + 2 * 7);
+    }
+
+    for (i = 0; (err == MP_OKAY) && (i < cnt); i++) {
+    #ifdef WOLFSSL_VALIDATE_ECC_KEYGEN
+        err = sp_384_ecc_mulmod_7(infinity, &point[i], p384_order, 1, 1,
+            NULL);
+        if (err == MP_OKAY) {
+            if (sp_384_iszero_7(point[i].x) ||
+                    sp_384_iszero_7(point[i].y)) {
+                err = ECC_INF_E;
+            }
+        }
+        if (err == MP_OKAY)
+    #endif
+        {
+            err = sp_384_point_to_ecc_point_7(&point[i], pub[i]);
+        }
+    }
+
+    if (k != NULL) {
+        ForceZero(k, sizeof(sp_digit) * 7);
+        XFREE(k, heap, DYNAMIC_TYPE_ECC);
+    }
+    if (point != NULL) {
+        /* point is not sensitive, so no need to zeroize */
+        XFREE(point, heap, DYNAMIC_TYPE_ECC);
+    }
+
+    return err;
+}
+#endif /* WOLFSSL_ECC_KEYGEN_BATCH */
+
 #ifdef WOLFSSL_SP_NONBLOCK
 typedef struct sp_ecc_key_gen_384_ctx {
     int state;
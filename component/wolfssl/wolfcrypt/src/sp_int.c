@@ -13855,6 +13855,288 @@ int sp_exptmod(const sp_int* b, const sp_int* e, const sp_int* m, sp_int* r)
 }
 #endif
 
+#if defined(WOLFSSL_SP_MATH_ALL) && defined(WOLFSSL_DH_COMB)
+/* Internal. Store a number into an entry of a comb table.
+ *
+ * Entries are a fixed number of digits so that they can be selected in
+ * constant time.
+ *
+ * @param  [in]   a      SP integer to store. Fits in used digits.
+ * @param  [out]  entry  Entry of table.
+ * @param  [in]   used   Number of digits in an entry.
+ */
+static void _sp_comb_store(const sp_int* a, sp_int_digit* entry,
+    unsigned int used)
+{
+    unsigned int j;
+
+    for (j = 0; j < a->used; j++) {
+        entry[j] = a->dp[j];
+    }
+    for (; j < used; j++) {
+        entry[j] = 0;
+    }
+}
+
+/* Internal. Load an entry of a comb table. Not constant time.
+ *
+ * @param  [in]   entry  Entry of table.
+ * @param  [in]   used   Number of digits in an entry.
+ * @param  [out]  r      SP integer to hold number.
+ */
+static void _sp_comb_load(const sp_int_digit* entry, unsigned int used,
+    sp_int* r)
+{
+    XMEMCPY(r->dp, entry, used * SP_WORD_SIZEOF);
+    r->used = used;
+    sp_clamp(r);
+}
+
+/* Internal. Select an entry of a comb table in constant time.
+ *
+ * Every entry is read and masked so that the memory access pattern does not
+ * depend on the index.
+ *
+ * @param  [in]   table  Comb table.
+ * @param  [in]   cnt    Number of entries in table.
+ * @param  [in]   idx    Index of entry to select.
+ * @param  [in]   used   Number of digits in an entry.
+ * @param  [out]  r      SP integer to hold selected number.
+ */
+static void _sp_comb_select(const sp_int_digit* table, int cnt, int idx,
+    unsigned int used, sp_int* r)
+{
+    int i;
+    unsigned int j;
+
+    for (j = 0; j < used; j++) {
+        r->dp[j] = 0;
+    }
+    for (i = 0; i < cnt; i++) {
+        sp_int_digit mask = (sp_int_digit)0 -
+            (sp_int_digit)(ctMaskEq(i, idx) & 1);
+
+        for (j = 0; j < used; j++) {
+            r->dp[j] |= table[j] & mask;
+        }
+        table += used;
+    }
+    /* Not clamped: the length must not depend on the entry selected. */
+    r->used = used;
+}
+
+/* Pre-compute a comb table for exponentiating a fixed base modulo m.
+ *
+ * The exponent is split into teeth rows of d = ceil(bits / teeth) bits.
+ * Entry i is the product of b^(2^(k*d)) for each bit k set in i, in
+ * Montgomery form. The table is 2^teeth entries of m->used digits.
+ *
+ * @param  [in]   b      SP integer that is the base.
+ * @param  [in]   m      SP integer that is the modulus. Must be odd.
+ * @param  [in]   bits   Maximum number of bits in exponents.
+ * @param  [in]   teeth  Number of bits of exponent processed together.
+ * @param  [out]  table  Comb table of (1 << teeth) * m->used digits.
+ *
+ * @return  MP_OKAY on success.
+ * @return  MP_VAL when a parameter is NULL, m is even or bits and teeth are
+ *          not positive.
+ * @return  MP_MEM when dynamic memory allocation fails.
+ */
+int sp_exptmod_comb_precomp(const sp_int* b, const sp_int* m, int bits,
+    int teeth, sp_int_digit* table)
+{
+    int err = MP_OKAY;
+    int i;
+    int k;
+    int d;
+    unsigned int used;
+    sp_int_digit mp;
+    DECL_SP_INT_ARRAY(t, (m == NULL) ? 1 : m->used * 2 + 1, 2);
+
+    if ((b == NULL) || (m == NULL) || (table == NULL) || (bits <= 0) ||
+            (teeth <= 0) || (teeth > 8) || sp_iseven(m) ||
+            (m->used * 2 >= SP_INT_DIGITS)) {
+        err = MP_VAL;
+    }
+
+    ALLOC_SP_INT_ARRAY(t, m->used * 2 + 1, 2, err, NULL);
+    if (err == MP_OKAY) {
+        _sp_init_size(t[0], m->used * 2 + 1);
+        _sp_init_size(t[1], m->used * 2 + 1);
+
+        used = m->used;
+        d = (bits + teeth - 1) / teeth;
+        _sp_mont_setup(m, &mp);
+
+        /* table[0] = ToMont(1) */
+        err = sp_mont_norm(t[0], m);
+        if (err == MP_OKAY) {
+            _sp_comb_store(t[0], table, used);
+            /* t[0] = ToMont(b mod m) */
+            err = sp_mulmod(b, t[0], m, t[0]);
+        }
+        /* table[2^k] = b^(2^(k*d)) */
+        for (k = 0; (err == MP_OKAY) && (k < teeth); k++) {
+            if (k > 0) {
+                for (i = 0; (err == MP_OKAY) && (i < d); i++) {
+                    err = sp_sqr(t[0], t[0]);
+                    if (err == MP_OKAY) {
+                        err = _sp_mont_red(t[0], m, mp, 0);
+                    }
+                }
+            }
+            if (err == MP_OKAY) {
+                _sp_comb_store(t[0], table + ((size_t)1 << k) * used, used);
+            }
+        }
+        /* table[i] = table[i without lowest bit] * table[lowest bit of i] */
+        for (i = 3; (err == MP_OKAY) && (i < (1 << teeth)); i++) {
+            int low = i & (-i);
+
+            if (low == i) {
+                continue;
+            }
+            _sp_comb_load(table + (size_t)(i - low) * used, used, t[0]);
+            _sp_comb_load(table + (size_t)low * used, used, t[1]);
+            err = sp_mul(t[0], t[1], t[0]);
+            if (err == MP_OKAY) {
+                err = _sp_mont_red(t[0], m, mp, 0);
+            }
+            if (err == MP_OKAY) {
+                _sp_comb_store(t[0], table + (size_t)i * used, used);
+            }
+        }
+    }
+
+    FREE_SP_INT_ARRAY(t, NULL);
+    return err;
+}
+
+/* Exponentiate a fixed base with a comb table: r = b ^ e mod m
+ *
+ * Lim-Lee fixed-base comb: d squarings and d multiplications by an entry
+ * selected in constant time. The exponent is read as a fixed number of
+ * digits derived from bits, whatever its used count, the selected entry
+ * always has m->used digits and the Montgomery reductions are the constant
+ * time variant. So the operations and memory accesses depend on bits and m
+ * only, not on the value of the exponent.
+ *
+ * @param  [in]   table  Comb table from sp_exptmod_comb_precomp().
+ * @param  [in]   teeth  Number of bits of exponent processed together.
+ * @param  [in]   bits   Maximum number of bits in exponents of table.
+ * @param  [in]   e      SP integer that is the exponent. Must have room for
+ *                       the digits of bits.
+ * @param  [in]   m      SP integer that is the modulus of table.
+ * @param  [out]  r      SP integer to hold result.
+ *
+ * @return  MP_OKAY on success.
+ * @return  MP_VAL when a parameter is NULL or e has more than bits bits.
+ * @return  MP_MEM when dynamic memory allocation fails.
+ */
+int sp_exptmod_comb(const sp_int_digit* table, int teeth, int bits,
+    const sp_int* e, const sp_int* m, sp_int* r)
+{
+    int err = MP_OKAY;
+    int i;
+    int j;
+    int k;
+    int d;
+    unsigned int used;
+    unsigned int w;
+    sp_int_digit mp;
+    DECL_SP_INT_ARRAY(t, (m == NULL) ? 1 : m->used * 2 + 1, 2);
+
+    if ((table == NULL) || (e == NULL) || (m == NULL) || (r == NULL) ||
+            (bits <= 0) || (teeth <= 0) || (teeth > 8) || sp_iseven(m) ||
+            (m->used * 2 >= SP_INT_DIGITS) ||
+            ((unsigned int)(bits + SP_WORD_SIZE - 1) >> SP_WORD_SHIFT) >
+            e->size) {
+        err = MP_VAL;
+    }
+#ifdef WOLFSSL_SP_INT_NEGATIVE
+    if ((err == MP_OKAY) && (e->sign == MP_NEG)) {
+        err = MP_VAL;
+    }
+#endif
+    if (err == MP_OKAY) {
+        /* Check e has no bits at or above bits. Every digit from the one
+         * holding bit 'bits' to the end of e is read, with those past used
+         * masked to zero, so the time doesn't depend on the length of e. */
+        sp_int_digit over = 0;
+
+        for (w = (unsigned int)bits >> SP_WORD_SHIFT; w < e->size; w++) {
+            sp_int_digit dw = e->dp[w] & ((sp_int_digit)0 -
+                (sp_int_digit)(ctMaskLT((int)w, (int)e->used) & 1));
+            if (w == ((unsigned int)bits >> SP_WORD_SHIFT)) {
+                dw >>= bits & SP_WORD_MASK;
+            }
+            over |= dw;
+        }
+        if (over != 0) {
+            err = MP_VAL;
+        }
+    }
+
+    ALLOC_SP_INT_ARRAY(t, m->used * 2 + 1, 2, err, NULL);
+    if (err == MP_OKAY) {
+        _sp_init_size(t[0], m->used * 2 + 1);
+        _sp_init_size(t[1], m->used * 2 + 1);
+
+        used = m->used;
+        d = (bits + teeth - 1) / teeth;
+        _sp_mont_setup(m, &mp);
+
+        SAVE_VECTOR_REGISTERS(err = _svr_ret;);
+    }
+    if (err == MP_OKAY) {
+        /* t[0] = ToMont(1) */
+        _sp_comb_load(table, used, t[0]);
+        for (j = d - 1; (err == MP_OKAY) && (j >= 0); j--) {
+            int idx = 0;
+
+            err = sp_sqr(t[0], t[0]);
+            if (err == MP_OKAY) {
+                err = _sp_mont_red(t[0], m, mp, 1);
+                /* All digits are written, keep the length fixed. */
+                t[0]->used = used;
+            }
+            /* Bit j of each row of the exponent. Which bits exist depends on
+             * bits only. Digits past used are masked to zero. */
+            for (k = 0; k < teeth; k++) {
+                i = k * d + j;
+                if (i < bits) {
+                    sp_int_digit dw;
+
+                    w = (unsigned int)i >> SP_WORD_SHIFT;
+                    dw = e->dp[w] & ((sp_int_digit)0 -
+                        (sp_int_digit)(ctMaskLT((int)w, (int)e->used) & 1));
+                    idx |= (int)((dw >> (i & SP_WORD_MASK)) & 1) << k;
+                }
+            }
+            _sp_comb_select(table, 1 << teeth, idx, used, t[1]);
+            if (err == MP_OKAY) {
+                err = sp_mul(t[0], t[1], t[0]);
+            }
+            if (err == MP_OKAY) {
+                err = _sp_mont_red(t[0], m, mp, 1);
+                t[0]->used = used;
+            }
+        }
+        if (err == MP_OKAY) {
+            /* r = FromMont(t[0]) */
+            err = _sp_mont_red(t[0], m, mp, 1);
+        }
+        if (err == MP_OKAY) {
+            _sp_copy(t[0], r);
+        }
+        RESTORE_VECTOR_REGISTERS();
+    }
+
+    FREE_SP_INT_ARRAY(t, NULL);
+    return err;
+}
+#endif /* WOLFSSL_SP_MATH_ALL && WOLFSSL_DH_COMB */
+
 #if defined(WOLFSSL_SP_MATH_ALL) || defined(WOLFSSL_HAVE_SP_DH)
 #if defined(WOLFSSL_SP_FAST_NCT_EXPTMOD) || !defined(WOLFSSL_SP_SMALL)
 
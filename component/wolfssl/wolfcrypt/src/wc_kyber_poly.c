@@ -19,8 +19,1105 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
  */
 
+/* Implementation of the polynomial operations of Kyber.
+ *
+ * Polynomials have 256 signed 16-bit co-efficients modulo q = 3329.
+ * Multiplication is done in the NTT domain with Montgomery reduction.
+ *
+ * When USE_INTEL_SPEEDUP is defined and the CPU supports AVX2, the NTT,
+ * inverse NTT and base multiplication use the code in wc_kyber_asm.S. The
+ * results are the same as the C code.
+ *
+ * Unless WOLFSSL_KYBER_SMALL is defined, the matrix and noise polynomials are
+ * generated four at a time with the interleaved SHAKE functions.
+ */
+
+#ifdef HAVE_CONFIG_H
+    #include <config.h>
+#endif
+
 #include <wolfssl/wolfcrypt/settings.h>
 
-#ifdef WOLFSSL_HAVE_KYBER
-    #error "Contact wolfSSL to get the implementation of this file"
+#ifdef WOLFSSL_WC_KYBER
+
+#include <wolfssl/wolfcrypt/wc_kyber.h>
+#include <wolfssl/wolfcrypt/error-crypt.h>
+
+#ifdef NO_INLINE
+    #include <wolfssl/wolfcrypt/misc.h>
+#else
+    #define WOLFSSL_MISC_INCLUDED
+    #include <wolfcrypt/src/misc.c>
+#endif
+
+#ifdef USE_INTEL_SPEEDUP
+    #include <wolfssl/wolfcrypt/cpuid.h>
+
+    /* CPU features are only checked once when initializing a key. */
+    static word32 cpuid_flags = 0;
+#endif
+
+/* q^-1 mod 2^16 as a signed value. */
+#define KYBER_QINV          (-3327)
+/* Barrett reduction multiplier: round(2^26 / q). */
+#define KYBER_V             20159
+/* 2^32 mod q: Montgomery multiply by this to convert to Montgomery form. */
+#define KYBER_MONT_SQR      1353
+/* Montgomery form of 1/128 to scale the result of the inverse NTT. */
+#define KYBER_F             1441
+
+/* Powers of the 256th root of unity, 17, in Montgomery form.
+ * Bit-reversed order and centered around zero.
+ */
+static const sword16 zetas[KYBER_N / 2] = {
+    -1044, -758, -359, -1517, 1493, 1422, 287, 202,
+    -171, 622, 1577, 182, 962, -1202, -1474, 1468,
+    573, -1325, 264, 383, -829, 1458, -1602, -130,
+    -681, 1017, 732, 608, -1542, 411, -205, -1571,
+    1223, 652, -552, 1015, -1293, 1491, -282, -1544,
+    516, -8, -320, -666, -1618, -1162, 126, 1469,
+    -853, -90, -271, 830, 107, -1421, -247, -951,
+    -398, 961, -1508, -725, 448, -1065, 677, -1275,
+    -1103, 430, 555, 843, -1251, 871, 1550, 105,
+    422, 587, 177, -235, -291, -460, 1574, 1653,
+    -246, 778, 1159, -147, -777, 1483, -602, 1119,
+    -1590, 644, -872, 349, 418, 329, -156, -75,
+    817, 1097, 603, 610, 1322, -1285, -1465, 384,
+    -1215, -136, 1218, -1335, -874, 220, -1187, -1659,
+    -1185, -1530, -1278, 794, -1510, -854, -870, 478,
+    -108, -308, 996, 991, 958, -1460, 1522, 1628,
+};
+
+
+/******************************************************************************/
+/* Modular arithmetic. */
+
+/* Montgomery reduce a 32-bit value.
+ *
+ * a  Value to reduce. Absolute value less than q * 2^15.
+ * returns a / 2^16 mod q with an absolute value less than q.
+ */
+static sword16 kyber_mont_red(sword32 a)
+{
+    sword16 t = (sword16)((sword16)a * (sword16)KYBER_QINV);
+    return (sword16)((a - (sword32)t * KYBER_Q) >> 16);
+}
+
+/* Montgomery multiply two values.
+ *
+ * a  First value.
+ * b  Second value.
+ * returns a * b / 2^16 mod q.
+ */
+#define KYBER_FQMUL(a, b)   kyber_mont_red((sword32)(a) * (b))
+
+/* Barrett reduce a 16-bit value.
+ *
+ * a  Value to reduce.
+ * returns a mod q centered around zero.
+ */
+static sword16 kyber_barrett_red(sword16 a)
+{
+    sword16 t = (sword16)(((sword32)KYBER_V * a + (1 << 25)) >> 26);
+    return (sword16)(a - t * KYBER_Q);
+}
+
+
+/******************************************************************************/
+/* Number-theoretic transform. */
+
+/* Forward NTT of a polynomial with the result reduced.
+ *
+ * Co-efficients are in bit-reversed order on output.
+ *
+ * r  Polynomial to transform.
+ */
+static void kyber_ntt_c(sword16* r)
+{
+    unsigned int len;
+    unsigned int start;
+    unsigned int j;
+    unsigned int k = 1;
+
+    for (len = KYBER_N / 2; len >= 2; len >>= 1) {
+        for (start = 0; start < KYBER_N; start = j + len) {
+            sword16 zeta = zetas[k++];
+            for (j = start; j < start + len; j++) {
+                sword16 t = KYBER_FQMUL(zeta, r[j + len]);
+                r[j + len] = (sword16)(r[j] - t);
+                r[j] = (sword16)(r[j] + t);
+            }
+        }
+    }
+
+    for (j = 0; j < KYBER_N; j++) {
+        r[j] = kyber_barrett_red(r[j]);
+    }
+}
+
+/* Inverse NTT of a polynomial.
+ *
+ * The result is multiplied by the Montgomery factor.
+ *
+ * r  Polynomial to transform.
+ */
+static void kyber_invntt_c(sword16* r)
+{
+    unsigned int len;
+    unsigned int start;
+    unsigned int j;
+    unsigned int k = KYBER_N / 2 - 1;
+
+    for (len = 2; len <= KYBER_N / 2; len <<= 1) {
+        for (start = 0; start < KYBER_N; start = j + len) {
+            sword16 zeta = zetas[k--];
+            for (j = start; j < start + len; j++) {
+                sword16 t = r[j];
+                r[j] = kyber_barrett_red((sword16)(t + r[j + len]));
+                r[j + len] = KYBER_FQMUL(zeta, (sword16)(r[j + len] - t));
+            }
+        }
+    }
+
+    for (j = 0; j < KYBER_N; j++) {
+        r[j] = KYBER_FQMUL(r[j], KYBER_F);
+    }
+}
+
+/* Multiply two degree one polynomials modulo X^2 - zeta.
+ *
+ * r     Resulting polynomial.
+ * a     First polynomial.
+ * b     Second polynomial.
+ * zeta  Root of unity of the modulus.
+ */
+static void kyber_basemul(sword16* r, const sword16* a, const sword16* b,
+    sword16 zeta)
+{
+    sword16 t = KYBER_FQMUL(a[1], b[1]);
+
+    r[0] = (sword16)(KYBER_FQMUL(t, zeta) + KYBER_FQMUL(a[0], b[0]));
+    r[1] = (sword16)(KYBER_FQMUL(a[0], b[1]) + KYBER_FQMUL(a[1], b[0]));
+}
+
+/* Multiply two polynomials in the NTT domain and add into the result.
+ *
+ * r    Polynomial to add product to.
+ * a    First polynomial.
+ * b    Second polynomial.
+ * add  Whether to add to r rather than overwrite it.
+ */
+static void kyber_basemul_mont_c(sword16* r, const sword16* a,
+    const sword16* b, int add)
+{
+    unsigned int i;
+    unsigned int j;
+    sword16 t[4];
+
+    for (i = 0; i < KYBER_N / 4; i++) {
+        kyber_basemul(t, a + 4 * i, b + 4 * i, zetas[KYBER_N / 4 + i]);
+        kyber_basemul(t + 2, a + 4 * i + 2, b + 4 * i + 2,
+            (sword16)-zetas[KYBER_N / 4 + i]);
+        for (j = 0; j < 4; j++) {
+            r[4 * i + j] = (sword16)((add ? r[4 * i + j] : 0) + t[j]);
+        }
+    }
+}
+
+/* Forward NTT of a polynomial with the result reduced.
+ *
+ * r  Polynomial to transform.
+ */
+static void kyber_ntt(sword16* r)
+{
+#ifdef USE_INTEL_SPEEDUP
+    if (IS_INTEL_AVX2(cpuid_flags)) {
+        kyber_ntt_avx2(r);
+    }
+    else
+#endif
+    {
+        kyber_ntt_c(r);
+    }
+}
+
+/* Inverse NTT of a polynomial, multiplied by the Montgomery factor.
+ *
+ * r  Polynomial to transform.
+ */
+static void kyber_invntt(sword16* r)
+{
+#ifdef USE_INTEL_SPEEDUP
+    if (IS_INTEL_AVX2(cpuid_flags)) {
+        kyber_invntt_avx2(r);
+    }
+    else
+#endif
+    {
+        kyber_invntt_c(r);
+    }
+}
+
+/* Reduce each co-efficient of a polynomial.
+ *
+ * p  Polynomial to reduce.
+ */
+static void kyber_poly_reduce(sword16* p)
+{
+    unsigned int i;
+
+    for (i = 0; i < KYBER_N; i++) {
+        p[i] = kyber_barrett_red(p[i]);
+    }
+}
+
+/* Inner product of two vectors of polynomials in the NTT domain.
+ *
+ * r   Resulting polynomial, reduced.
+ * a   First vector of polynomials.
+ * b   Second vector of polynomials.
+ * kp  Number of polynomials in a vector.
+ */
+static void kyber_pointwise_acc_mont(sword16* r, const sword16* a,
+    const sword16* b, int kp)
+{
+    int i;
+
+#ifdef USE_INTEL_SPEEDUP
+    if (IS_INTEL_AVX2(cpuid_flags)) {
+        kyber_basemul_mont_avx2(r, a, b);
+        for (i = 1; i < kp; i++) {
+            kyber_basemul_mont_add_avx2(r, a + i * KYBER_N, b + i * KYBER_N);
+        }
+    }
+    else
+#endif
+    {
+        kyber_basemul_mont_c(r, a, b, 0);
+        for (i = 1; i < kp; i++) {
+            kyber_basemul_mont_c(r, a + i * KYBER_N, b + i * KYBER_N, 1);
+        }
+    }
+
+    kyber_poly_reduce(r);
+}
+
+/* Initialize Kyber implementation.
+ *
+ * Records whether AVX2 can be used.
+ */
+void kyber_init(void)
+{
+#ifdef USE_INTEL_SPEEDUP
+    cpuid_flags = cpuid_get_flags();
+#endif
+}
+
+
+/******************************************************************************/
+/* Key generation, encapsulation and decapsulation. */
+
+/* Generate a public key from the private key and matrix A.
+ *
+ * pub = A.s + e with s and e transformed into the NTT domain.
+ *
+ * priv  [in,out] Private key vector s. Transformed to NTT domain.
+ * pub   [out]    Public key vector.
+ * e     [in,out] Error vector. Transformed to NTT domain.
+ * a     [in]     Matrix A in the NTT domain.
+ * kp    [in]     Number of polynomials in a vector.
+ */
+void kyber_keygen(sword16* priv, sword16* pub, sword16* e, const sword16* a,
+    int kp)
+{
+    int i;
+    unsigned int j;
+
+    for (i = 0; i < kp; i++) {
+        kyber_ntt(priv + i * KYBER_N);
+        kyber_ntt(e + i * KYBER_N);
+    }
+
+    for (i = 0; i < kp; i++) {
+        sword16* p = pub + i * KYBER_N;
+        const sword16* ep = e + i * KYBER_N;
+
+        kyber_pointwise_acc_mont(p, a + i * kp * KYBER_N, priv, kp);
+        for (j = 0; j < KYBER_N; j++) {
+            /* Convert to Montgomery form and add error. */
+            p[j] = kyber_barrett_red((sword16)(
+                KYBER_FQMUL(p[j], KYBER_MONT_SQR) + ep[j]));
+        }
+    }
+}
+
+/* Encrypt a message into the two parts of a cipher text.
+ *
+ * bp = A^T.sp + ep and v = pub.sp + epp + m.
+ *
+ * pub  [in]     Public key vector in the NTT domain.
+ * bp   [out]    Vector of polynomials of cipher text.
+ * v    [out]    Polynomial of cipher text.
+ * at   [in]     Transposed matrix A in the NTT domain.
+ * sp   [in,out] Random vector. Transformed to NTT domain.
+ * ep   [in]     Error vector.
+ * epp  [in]     Error polynomial.
+ * m    [in]     Message as a polynomial.
+ * kp   [in]     Number of polynomials in a vector.
+ */
+void kyber_encapsulate(const sword16* pub, sword16* bp, sword16* v,
+    const sword16* at, sword16* sp, const sword16* ep, const sword16* epp,
+    const sword16* m, int kp)
+{
+    int i;
+    unsigned int j;
+
+    for (i = 0; i < kp; i++) {
+        kyber_ntt(sp + i * KYBER_N);
+    }
+
+    for (i = 0; i < kp; i++) {
+        sword16* p = bp + i * KYBER_N;
+        const sword16* e = ep + i * KYBER_N;
+
+        kyber_pointwise_acc_mont(p, at + i * kp * KYBER_N, sp, kp);
+        kyber_invntt(p);
+        for (j = 0; j < KYBER_N; j++) {
+            p[j] = kyber_barrett_red((sword16)(p[j] + e[j]));
+        }
+    }
+
+    kyber_pointwise_acc_mont(v, pub, sp, kp);
+    kyber_invntt(v);
+    for (j = 0; j < KYBER_N; j++) {
+        v[j] = kyber_barrett_red((sword16)(v[j] + epp[j] + m[j]));
+    }
+}
+
+/* Decrypt the two parts of a cipher text into a message polynomial.
+ *
+ * mp = v - priv.bp
+ *
+ * priv  [in]     Private key vector in the NTT domain.
+ * mp    [out]    Message as a polynomial.
+ * bp    [in,out] Vector of polynomials of cipher text. Transformed to NTT
+ *                domain.
+ * v     [in]     Polynomial of cipher text.
+ * kp    [in]     Number of polynomials in a vector.
+ */
+void kyber_decapsulate(const sword16* priv, sword16* mp, sword16* bp,
+    const sword16* v, int kp)
+{
+    int i;
+    unsigned int j;
+
+    for (i = 0; i < kp; i++) {
+        kyber_ntt(bp + i * KYBER_N);
+    }
+
+    kyber_pointwise_acc_mont(mp, priv, bp, kp);
+    kyber_invntt(mp);
+    for (j = 0; j < KYBER_N; j++) {
+        mp[j] = kyber_barrett_red((sword16)(v[j] - mp[j]));
+    }
+}
+
+
+/******************************************************************************/
+/* Matrix generation. */
+
+/* Rejection sample uniform co-efficients less than q from 12-bit values.
+ *
+ * p     Polynomial co-efficients to fill.
+ * len   Number of co-efficients wanted.
+ * r     Pseudo-random data.
+ * rLen  Length of pseudo-random data in bytes.
+ * returns the number of co-efficients sampled.
+ */
+static unsigned int kyber_rej_uniform(sword16* p, unsigned int len,
+    const byte* r, unsigned int rLen)
+{
+    unsigned int ctr = 0;
+    unsigned int pos = 0;
+
+    while ((ctr < len) && (pos + 3 <= rLen)) {
+        word16 v0 = (word16)((r[pos + 0] | ((word16)r[pos + 1] << 8)) & 0xfff);
+        word16 v1 = (word16)(((r[pos + 1] >> 4) | ((word16)r[pos + 2] << 4)) &
+                             0xfff);
+        pos += 3;
+
+        if (v0 < KYBER_Q) {
+            p[ctr++] = (sword16)v0;
+        }
+        if ((ctr < len) && (v1 < KYBER_Q)) {
+            p[ctr++] = (sword16)v1;
+        }
+    }
+
+    return ctr;
+}
+
+/* Set the XOF input for an entry of the matrix: seed || x || y.
+ *
+ * in          XOF input.
+ * seed        Public seed.
+ * idx         Index of entry: row * kp + column.
+ * kp          Number of rows and columns.
+ * transposed  Whether the matrix is transposed.
+ */
+static void kyber_matrix_xof_in(byte* in, const byte* seed, int idx, int kp,
+    int transposed)
+{
+    byte row = (byte)(idx / kp);
+    byte col = (byte)(idx % kp);
+
+    XMEMCPY(in, seed, KYBER_SYM_SZ);
+    in[KYBER_SYM_SZ + 0] = transposed ? row : col;
+    in[KYBER_SYM_SZ + 1] = transposed ? col : row;
+}
+
+/* Generate one uniform polynomial of the matrix with SHAKE128.
+ *
+ * shake       SHAKE128 object.
+ * p           Polynomial to fill.
+ * seed        Public seed.
+ * idx         Index of entry: row * kp + column.
+ * kp          Number of rows and columns.
+ * transposed  Whether the matrix is transposed.
+ * returns 0 on success and other values on hash failure.
+ */
+static int kyber_gen_matrix_1(wc_Shake* shake, sword16* p, const byte* seed,
+    int idx, int kp, int transposed, void* heap, int devId)
+{
+    int ret;
+    unsigned int ctr;
+    byte in[KYBER_SYM_SZ + 2];
+    byte rand[KYBER_GEN_MATRIX_BLOCKS * KYBER_XOF_BLOCK_SZ];
+
+    kyber_matrix_xof_in(in, seed, idx, kp, transposed);
+    ret = wc_InitShake128(shake, heap, devId);
+    if (ret == 0) {
+        ret = wc_Shake128_Absorb(shake, in, sizeof(in));
+    }
+    if (ret == 0) {
+        ret = wc_Shake128_SqueezeBlocks(shake, rand, KYBER_GEN_MATRIX_BLOCKS);
+    }
+    if (ret == 0) {
+        ctr = kyber_rej_uniform(p, KYBER_N, rand, sizeof(rand));
+        while ((ret == 0) && (ctr < KYBER_N)) {
+            ret = wc_Shake128_SqueezeBlocks(shake, rand, 1);
+            if (ret == 0) {
+                ctr += kyber_rej_uniform(p + ctr, KYBER_N - ctr, rand,
+                    KYBER_XOF_BLOCK_SZ);
+            }
+        }
+    }
+
+    return ret;
+}
+
+#ifndef WOLFSSL_KYBER_SMALL
+/* Generate four uniform polynomials of the matrix with interleaved SHAKE128.
+ *
+ * a           Matrix of polynomials.
+ * seed        Public seed.
+ * idx         Index of first entry: row * kp + column.
+ * kp          Number of rows and columns.
+ * transposed  Whether the matrix is transposed.
+ * returns 0 on success and other values on hash failure.
+ */
+static int kyber_gen_matrix_x4(sword16* a, const byte* seed, int idx, int kp,
+    int transposed)
+{
+    int ret;
+    int l;
+    int done;
+    wc_Shakex4 shake;
+    byte in[4][KYBER_SYM_SZ + 2];
+    byte rand[4][KYBER_GEN_MATRIX_BLOCKS * KYBER_XOF_BLOCK_SZ];
+    const byte* inp[4];
+    byte* outp[4];
+    unsigned int ctr[4];
+
+    for (l = 0; l < 4; l++) {
+        kyber_matrix_xof_in(in[l], seed, idx + l, kp, transposed);
+        inp[l] = in[l];
+        outp[l] = rand[l];
+    }
+
+    ret = wc_Shake128x4_Absorb(&shake, inp, sizeof(in[0]));
+    if (ret == 0) {
+        ret = wc_Shake128x4_SqueezeBlocks(&shake, outp,
+            KYBER_GEN_MATRIX_BLOCKS);
+    }
+    if (ret == 0) {
+        done = 1;
+        for (l = 0; l < 4; l++) {
+            ctr[l] = kyber_rej_uniform(a + (idx + l) * KYBER_N, KYBER_N,
+                rand[l], sizeof(rand[l]));
+            done &= (ctr[l] == KYBER_N);
+        }
+        /* Rarely more output is needed. All four states are squeezed. */
+        while ((ret == 0) && (!done)) {
+            ret = wc_Shake128x4_SqueezeBlocks(&shake, outp, 1);
+            done = 1;
+            for (l = 0; (ret == 0) && (l < 4); l++) {
+                ctr[l] += kyber_rej_uniform(a + (idx + l) * KYBER_N + ctr[l],
+                    KYBER_N - ctr[l], rand[l], KYBER_XOF_BLOCK_SZ);
+                done &= (ctr[l] == KYBER_N);
+            }
+        }
+    }
+
+    wc_Shakex4_Free(&shake);
+    return ret;
+}
+#endif /* !WOLFSSL_KYBER_SMALL */
+
+/* Generate the matrix A, or its transpose, from the public seed.
+ *
+ * Entry [i][j] of A is sampled from SHAKE128(seed || j || i).
+ *
+ * a           [out] Matrix of polynomials.
+ * kp          [in]  Number of rows and columns.
+ * seed        [in]  Public seed.
+ * transposed  [in]  Whether to generate the transpose of A.
+ * heap        [in]  Dynamic memory hint.
+ * devId       [in]  Device identifier for hashing.
+ * returns 0 on success and other values on hash failure.
+ */
+int kyber_gen_matrix(sword16* a, int kp, const byte* seed, int transposed,
+    void* heap, int devId)
+{
+    int ret = 0;
+    int i = 0;
+    int n = kp * kp;
+    wc_Shake shake;
+
+#ifndef WOLFSSL_KYBER_SMALL
+    for (; (ret == 0) && (i + 4 <= n); i += 4) {
+        ret = kyber_gen_matrix_x4(a, seed, i, kp, transposed);
+    }
+#endif
+    if ((ret == 0) && (i < n)) {
+        for (; (ret == 0) && (i < n); i++) {
+            ret = kyber_gen_matrix_1(&shake, a + i * KYBER_N, seed, i, kp,
+                transposed, heap, devId);
+        }
+        wc_Shake128_Free(&shake);
+    }
+
+    return ret;
+}
+
+
+/******************************************************************************/
+/* Noise generation. */
+
+/* Centered binomial distribution with eta = 2.
+ *
+ * p  Polynomial to fill.
+ * r  Pseudo-random data: 128 bytes.
+ */
+static void kyber_cbd_eta2(sword16* p, const byte* r)
+{
+    unsigned int i;
+    unsigned int j;
+
+    for (i = 0; i < KYBER_N / 8; i++) {
+        word32 t = ((word32)r[4 * i + 0] <<  0) | ((word32)r[4 * i + 1] <<  8) |
+                   ((word32)r[4 * i + 2] << 16) | ((word32)r[4 * i + 3] << 24);
+        word32 d = (t & 0x55555555) + ((t >> 1) & 0x55555555);
+
+        for (j = 0; j < 8; j++) {
+            sword16 x = (sword16)((d >> (4 * j + 0)) & 0x3);
+            sword16 y = (sword16)((d >> (4 * j + 2)) & 0x3);
+            p[8 * i + j] = (sword16)(x - y);
+        }
+    }
+}
+
+#ifdef WOLFSSL_KYBER512
+/* Centered binomial distribution with eta = 3.
+ *
+ * p  Polynomial to fill.
+ * r  Pseudo-random data: 192 bytes.
+ */
+static void kyber_cbd_eta3(sword16* p, const byte* r)
+{
+    unsigned int i;
+    unsigned int j;
+
+    for (i = 0; i < KYBER_N / 4; i++) {
+        word32 t = ((word32)r[3 * i + 0] <<  0) | ((word32)r[3 * i + 1] <<  8) |
+                   ((word32)r[3 * i + 2] << 16);
+        word32 d = (t & 0x00249249) + ((t >> 1) & 0x00249249) +
+                   ((t >> 2) & 0x00249249);
+
+        for (j = 0; j < 4; j++) {
+            sword16 x = (sword16)((d >> (6 * j + 0)) & 0x7);
+            sword16 y = (sword16)((d >> (6 * j + 3)) & 0x7);
+            p[4 * i + j] = (sword16)(x - y);
+        }
+    }
+}
+#endif
+
+/* Sample a noise polynomial from pseudo-random data.
+ *
+ * p    Polynomial to fill.
+ * r    Pseudo-random data: eta * 64 bytes.
+ * eta  Parameter of the centered binomial distribution.
+ */
+static void kyber_cbd(sword16* p, const byte* r, int eta)
+{
+#ifdef WOLFSSL_KYBER512
+    if (eta == KYBER_ETA1_512) {
+        kyber_cbd_eta3(p, r);
+    }
+    else
+#endif
+    {
+        (void)eta;
+        kyber_cbd_eta2(p, r);
+    }
+}
+
+/* Maximum number of bytes of PRF output for a noise polynomial. */
+#define KYBER_PRF_MAX_SZ    (KYBER_ETA1_512 * KYBER_N / 4)
+/* Number of SHAKE256 blocks that hold the most PRF output needed. */
+#define KYBER_PRF_BLOCKS    \
+    ((KYBER_PRF_MAX_SZ + KYBER_PRF_BLOCK_SZ - 1) / KYBER_PRF_BLOCK_SZ)
+
+/* Generate noise polynomials from the noise seed.
+ *
+ * Polynomial with nonce n is sampled from SHAKE256(seed || n).
+ * Key generation passes NULL for poly: vec2 is then sampled with eta1.
+ *
+ * kp     [in]  Number of polynomials in a vector.
+ * vec1   [out] First vector: nonces 0..kp-1 with eta1.
+ * vec2   [out] Second vector: nonces kp..2kp-1 with eta1 or eta2.
+ * poly   [out] Polynomial: nonce 2kp with eta2. May be NULL.
+ * seed   [in]  Noise seed.
+ * heap   [in]  Dynamic memory hint.
+ * devId  [in]  Device identifier for hashing.
+ * returns 0 on success and other values on hash failure.
+ */
+int kyber_get_noise(int kp, sword16* vec1, sword16* vec2, sword16* poly,
+    const byte* seed, void* heap, int devId)
+{
+    int ret = 0;
+    int i;
+    int n = 0;
+    int eta1 = KYBER_ETA1_OTHER;
+    sword16* p[2 * KYBER_MAX_K + 1];
+    int eta[2 * KYBER_MAX_K + 1];
+    byte in[KYBER_SYM_SZ + 1];
+    byte rand[KYBER_PRF_BLOCKS * KYBER_PRF_BLOCK_SZ];
+    wc_Shake shake;
+
+#ifdef WOLFSSL_KYBER512
+    if (kp == KYBER512_K) {
+        eta1 = KYBER_ETA1_512;
+    }
 #endif
+
+    for (i = 0; i < kp; i++) {
+        p[n] = vec1 + i * KYBER_N;
+        eta[n++] = eta1;
+    }
+    for (i = 0; i < kp; i++) {
+        p[n] = vec2 + i * KYBER_N;
+        eta[n++] = (poly == NULL) ? eta1 : KYBER_ETA2;
+    }
+    if (poly != NULL) {
+        p[n] = poly;
+        eta[n++] = KYBER_ETA2;
+    }
+
+    i = 0;
+#ifndef WOLFSSL_KYBER_SMALL
+    if (n >= 4) {
+        wc_Shakex4 shakex4;
+        byte inx4[4][KYBER_SYM_SZ + 1];
+        byte randx4[4][KYBER_PRF_BLOCKS * KYBER_PRF_BLOCK_SZ];
+        const byte* inp[4];
+        byte* outp[4];
+        int l;
+        word32 blocks;
+
+        for (; (ret == 0) && (i + 4 <= n); i += 4) {
+            blocks = 1;
+            for (l = 0; l < 4; l++) {
+                XMEMCPY(inx4[l], seed, KYBER_SYM_SZ);
+                inx4[l][KYBER_SYM_SZ] = (byte)(i + l);
+                inp[l] = inx4[l];
+                outp[l] = randx4[l];
+                if (eta[i + l] * KYBER_N / 4 > KYBER_PRF_BLOCK_SZ) {
+                    blocks = KYBER_PRF_BLOCKS;
+                }
+            }
+            ret = wc_Shake256x4_Absorb(&shakex4, inp, sizeof(inx4[0]));
+            if (ret == 0) {
+                ret = wc_Shake256x4_SqueezeBlocks(&shakex4, outp, blocks);
+            }
+            for (l = 0; (ret == 0) && (l < 4); l++) {
+                kyber_cbd(p[i + l], randx4[l], eta[i + l]);
+            }
+        }
+
+        wc_Shakex4_Free(&shakex4);
+        ForceZero(randx4, sizeof(randx4));
+    }
+#endif
+    if ((ret == 0) && (i < n)) {
+        ret = wc_InitShake256(&shake, heap, devId);
+        for (; (ret == 0) && (i < n); i++) {
+            XMEMCPY(in, seed, KYBER_SYM_SZ);
+            in[KYBER_SYM_SZ] = (byte)i;
+            ret = wc_Shake256_Update(&shake, in, sizeof(in));
+            if (ret == 0) {
+                ret = wc_Shake256_Final(&shake, rand,
+                    (word32)(eta[i] * KYBER_N / 4));
+            }
+            if (ret == 0) {
+                kyber_cbd(p[i], rand, eta[i]);
+            }
+        }
+        wc_Shake256_Free(&shake);
+        ForceZero(rand, sizeof(rand));
+    }
+
+    return ret;
+}
+
+
+/******************************************************************************/
+/* Encoding and compression. */
+
+/* Map a co-efficient to its standard representative in 0..q-1.
+ *
+ * a  Reduced co-efficient.
+ * returns the co-efficient plus q when negative.
+ */
+#define KYBER_CSUBQ(a)  ((word16)((a) + (((sword16)(a) >> 15) & KYBER_Q)))
+
+#if defined(WOLFSSL_KYBER512) || defined(WOLFSSL_KYBER768)
+/* Compress a vector of polynomials to 10 bits per co-efficient.
+ *
+ * r   Compressed data.
+ * v   Vector of reduced polynomials.
+ * kp  Number of polynomials in a vector.
+ */
+void kyber_vec_compress_10(byte* r, sword16* v, unsigned int kp)
+{
+    unsigned int i;
+    unsigned int j;
+    unsigned int k;
+    word16 t[4];
+
+    for (i = 0; i < kp; i++) {
+        for (j = 0; j < KYBER_N / 4; j++) {
+            for (k = 0; k < 4; k++) {
+                word32 u = KYBER_CSUBQ(v[i * KYBER_N + 4 * j + k]);
+                t[k] = (word16)((((u << 10) + KYBER_Q / 2) / KYBER_Q) & 0x3ff);
+            }
+            r[0] = (byte)(t[0] >> 0);
+            r[1] = (byte)((t[0] >> 8) | (t[1] << 2));
+            r[2] = (byte)((t[1] >> 6) | (t[2] << 4));
+            r[3] = (byte)((t[2] >> 4) | (t[3] << 6));
+            r[4] = (byte)(t[3] >> 2);
+            r += 5;
+        }
+    }
+}
+
+/* Decompress a vector of polynomials from 10 bits per co-efficient.
+ *
+ * v   Vector of polynomials.
+ * b   Compressed data.
+ * kp  Number of polynomials in a vector.
+ */
+void kyber_vec_decompress_10(sword16* v, const byte* b, unsigned int kp)
+{
+    unsigned int i;
+    unsigned int j;
+    unsigned int k;
+    word16 t[4];
+
+    for (i = 0; i < kp; i++) {
+        for (j = 0; j < KYBER_N / 4; j++) {
+            t[0] = (word16)((b[0] >> 0) | ((word16)b[1] << 8));
+            t[1] = (word16)((b[1] >> 2) | ((word16)b[2] << 6));
+            t[2] = (word16)((b[2] >> 4) | ((word16)b[3] << 4));
+            t[3] = (word16)((b[3] >> 6) | ((word16)b[4] << 2));
+            b += 5;
+            for (k = 0; k < 4; k++) {
+                v[i * KYBER_N + 4 * j + k] = (sword16)(
+                    ((word32)(t[k] & 0x3ff) * KYBER_Q + 512) >> 10);
+            }
+        }
+    }
+}
+
+/* Compress a polynomial to 4 bits per co-efficient.
+ *
+ * b  Compressed data.
+ * p  Reduced polynomial.
+ */
+void kyber_compress_4(byte* b, sword16* p)
+{
+    unsigned int i;
+    unsigned int j;
+    byte t[8];
+
+    for (i = 0; i < KYBER_N / 8; i++) {
+        for (j = 0; j < 8; j++) {
+            word32 u = KYBER_CSUBQ(p[8 * i + j]);
+            t[j] = (byte)((((u << 4) + KYBER_Q / 2) / KYBER_Q) & 0xf);
+        }
+        b[0] = (byte)(t[0] | (t[1] << 4));
+        b[1] = (byte)(t[2] | (t[3] << 4));
+        b[2] = (byte)(t[4] | (t[5] << 4));
+        b[3] = (byte)(t[6] | (t[7] << 4));
+        b += 4;
+    }
+}
+
+/* Decompress a polynomial from 4 bits per co-efficient.
+ *
+ * p  Polynomial.
+ * b  Compressed data.
+ */
+void kyber_decompress_4(sword16* p, const byte* b)
+{
+    unsigned int i;
+
+    for (i = 0; i < KYBER_N / 2; i++) {
+        p[2 * i + 0] = (sword16)(((word16)(b[i] & 0xf) * KYBER_Q + 8) >> 4);
+        p[2 * i + 1] = (sword16)(((word16)(b[i] >> 4) * KYBER_Q + 8) >> 4);
+    }
+}
+#endif /* WOLFSSL_KYBER512 || WOLFSSL_KYBER768 */
+
+#ifdef WOLFSSL_KYBER1024
+/* Compress a vector of four polynomials to 11 bits per co-efficient.
+ *
+ * r  Compressed data.
+ * v  Vector of reduced polynomials.
+ */
+void kyber_vec_compress_11(byte* r, sword16* v)
+{
+    unsigned int i;
+    unsigned int j;
+    unsigned int k;
+    word16 t[8];
+
+    for (i = 0; i < KYBER1024_K; i++) {
+        for (j = 0; j < KYBER_N / 8; j++) {
+            for (k = 0; k < 8; k++) {
+                word32 u = KYBER_CSUBQ(v[i * KYBER_N + 8 * j + k]);
+                t[k] = (word16)((((u << 11) + KYBER_Q / 2) / KYBER_Q) & 0x7ff);
+            }
+            r[ 0] = (byte)(t[0] >>  0);
+            r[ 1] = (byte)((t[0] >>  8) | (t[1] << 3));
+            r[ 2] = (byte)((t[1] >>  5) | (t[2] << 6));
+            r[ 3] = (byte)(t[2] >>  2);
+            r[ 4] = (byte)((t[2] >> 10) | (t[3] << 1));
+            r[ 5] = (byte)((t[3] >>  7) | (t[4] << 4));
+            r[ 6] = (byte)((t[4] >>  4) | (t[5] << 7));
+            r[ 7] = (byte)(t[5] >>  1);
+            r[ 8] = (byte)((t[5] >>  9) | (t[6] << 2));
+            r[ 9] = (byte)((t[6] >>  6) | (t[7] << 5));
+            r[10] = (byte)(t[7] >>  3);
+            r += 11;
+        }
+    }
+}
+
+/* Decompress a vector of four polynomials from 11 bits per co-efficient.
+ *
+ * v  Vector of polynomials.
+ * b  Compressed data.
+ */
+void kyber_vec_decompress_11(sword16* v, const byte* b)
+{
+    unsigned int i;
+    unsigned int j;
+    unsigned int k;
+    word16 t[8];
+
+    for (i = 0; i < KYBER1024_K; i++) {
+        for (j = 0; j < KYBER_N / 8; j++) {
+            t[0] = (word16)((b[0] >> 0) | ((word16)b[ 1] << 8));
+            t[1] = (word16)((b[1] >> 3) | ((word16)b[ 2] << 5));
+            t[2] = (word16)((b[2] >> 6) | ((word16)b[ 3] << 2) |
+                            ((word16)b[4] << 10));
+            t[3] = (word16)((b[4] >> 1) | ((word16)b[ 5] << 7));
+            t[4] = (word16)((b[5] >> 4) | ((word16)b[ 6] << 4));
+            t[5] = (word16)((b[6] >> 7) | ((word16)b[ 7] << 1) |
+                            ((word16)b[8] <<  9));
+            t[6] = (word16)((b[8] >> 2) | ((word16)b[ 9] << 6));
+            t[7] = (word16)((b[9] >> 5) | ((word16)b[10] << 3));
+            b += 11;
+            for (k = 0; k < 8; k++) {
+                v[i * KYBER_N + 8 * j + k] = (sword16)(
+                    ((word32)(t[k] & 0x7ff) * KYBER_Q + 1024) >> 11);
+            }
+        }
+    }
+}
+
+/* Compress a polynomial to 5 bits per co-efficient.
+ *
+ * b  Compressed data.
+ * p  Reduced polynomial.
+ */
+void kyber_compress_5(byte* b, sword16* p)
+{
+    unsigned int i;
+    unsigned int j;
+    byte t[8];
+
+    for (i = 0; i < KYBER_N / 8; i++) {
+        for (j = 0; j < 8; j++) {
+            word32 u = KYBER_CSUBQ(p[8 * i + j]);
+            t[j] = (byte)((((u << 5) + KYBER_Q / 2) / KYBER_Q) & 0x1f);
+        }
+        b[0] = (byte)((t[0] >> 0) | (t[1] << 5));
+        b[1] = (byte)((t[1] >> 3) | (t[2] << 2) | (t[3] << 7));
+        b[2] = (byte)((t[3] >> 1) | (t[4] << 4));
+        b[3] = (byte)((t[4] >> 4) | (t[5] << 1) | (t[6] << 6));
+        b[4] = (byte)((t[6] >> 2) | (t[7] << 3));
+        b += 5;
+    }
+}
+
+/* Decompress a polynomial from 5 bits per co-efficient.
+ *
+ * p  Polynomial.
+ * b  Compressed data.
+ */
+void kyber_decompress_5(sword16* p, const byte* b)
+{
+    unsigned int i;
+    unsigned int j;
+    byte t[8];
+
+    for (i = 0; i < KYBER_N / 8; i++) {
+        t[0] = (byte)(b[0] >> 0);
+        t[1] = (byte)((b[0] >> 5) | (b[1] << 3));
+        t[2] = (byte)(b[1] >> 2);
+        t[3] = (byte)((b[1] >> 7) | (b[2] << 1));
+        t[4] = (byte)((b[2] >> 4) | (b[3] << 4));
+        t[5] = (byte)(b[3] >> 1);
+        t[6] = (byte)((b[3] >> 6) | (b[4] << 2));
+        t[7] = (byte)(b[4] >> 3);
+        b += 5;
+        for (j = 0; j < 8; j++) {
+            p[8 * i + j] = (sword16)(((word32)(t[j] & 0x1f) * KYBER_Q + 16) >>
+                                     5);
+        }
+    }
+}
+#endif /* WOLFSSL_KYBER1024 */
+
+/* Convert a 32 byte message to a polynomial.
+ *
+ * Each bit becomes a co-efficient of 0 or (q + 1) / 2.
+ *
+ * p    Polynomial.
+ * msg  Message.
+ */
+void kyber_from_msg(sword16* p, const byte* msg)
+{
+    unsigned int i;
+    unsigned int j;
+
+    for (i = 0; i < KYBER_N / 8; i++) {
+        for (j = 0; j < 8; j++) {
+            sword16 mask = (sword16)(0 - ((msg[i] >> j) & 1));
+            p[8 * i + j] = (sword16)(mask & ((KYBER_Q + 1) / 2));
+        }
+    }
+}
+
+/* Convert a polynomial to a 32 byte message.
+ *
+ * Each co-efficient closer to q / 2 than to 0 becomes a set bit.
+ *
+ * msg  Message.
+ * p    Reduced polynomial.
+ */
+void kyber_to_msg(byte* msg, sword16* p)
+{
+    unsigned int i;
+    unsigned int j;
+
+    for (i = 0; i < KYBER_N / 8; i++) {
+        msg[i] = 0;
+        for (j = 0; j < 8; j++) {
+            word32 t = KYBER_CSUBQ(p[8 * i + j]);
+            t = (((t << 1) + KYBER_Q / 2) / KYBER_Q) & 1;
+            msg[i] |= (byte)(t << j);
+        }
+    }
+}
+
+/* Decode a vector of polynomials from 12 bits per co-efficient.
+ *
+ * p  Vector of polynomials.
+ * b  Encoded data.
+ * k  Number of polynomials in the vector.
+ */
+void kyber_from_bytes(sword16* p, const byte* b, int k)
+{
+    int i;
+
+    for (i = 0; i < k * KYBER_N / 2; i++) {
+        p[2 * i + 0] = (sword16)(((b[0] >> 0) | ((word16)b[1] << 8)) & 0xfff);
+        p[2 * i + 1] = (sword16)(((b[1] >> 4) | ((word16)b[2] << 4)) & 0xfff);
+        b += 3;
+    }
+}
+
+/* Encode a vector of polynomials to 12 bits per co-efficient.
+ *
+ * b  Encoded data.
+ * p  Vector of reduced polynomials.
+ * k  Number of polynomials in the vector.
+ */
+void kyber_to_bytes(byte* b, sword16* p, int k)
+{
+    int i;
+
+    for (i = 0; i < k * KYBER_N / 2; i++) {
+        word16 t0 = KYBER_CSUBQ(p[2 * i + 0]);
+        word16 t1 = KYBER_CSUBQ(p[2 * i + 1]);
+        b[0] = (byte)(t0 >> 0);
+        b[1] = (byte)((t0 >> 8) | (t1 << 4));
+        b[2] = (byte)(t1 >> 4);
+        b += 3;
+    }
+}
+
+/* Compare two byte arrays in constant time.
+ *
+ * a   First array.
+ * b   Second array.
+ * sz  Number of bytes to compare.
+ * returns 0 when equal and -1 otherwise.
+ */
+int kyber_cmp(const byte* a, const byte* b, int sz)
+{
+    int i;
+    byte r = 0;
+
+    for (i = 0; i < sz; i++) {
+        r |= (byte)(a[i] ^ b[i]);
+    }
+
+    return (int)(0 - (((word32)0 - r) >> 31));
+}
+
+#endif /* WOLFSSL_WC_KYBER */
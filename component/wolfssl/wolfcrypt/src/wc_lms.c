@@ -19,8 +19,2218 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
  */
 
+/* Implementation of LMS/HSS stateful hash-based signatures (RFC 8554) with
+ * SHA-256 and 32 byte hashes.
+ *
+ * The one-time keys of a leaf are p independent Winternitz chains of 55 byte
+ * messages. The chains of a batch of leaves are hashed in lock step so that
+ * wc_Sha256HashMulti() (WOLFSSL_SHA256_MULTI) can fill its SIMD lanes.
+ *
+ * Building a tree is split into units of leaves that a pool of threads takes
+ * from a shared counter when WOLFSSL_LMS_THREADS is defined and
+ * wc_LmsKey_SetThreads() has been called with more than one thread. The
+ * threads only live for the call that builds the tree.
+ *
+ * Only the top WOLFSSL_LMS_CACHE_HEIGHT levels of nodes of a tree are kept.
+ * The lower nodes are kept for the subtree of the leaf being signed with and
+ * are recomputed when signing moves on to the next subtree.
+ *
+ * The private key has the same layout as that of the hash-sigs lib:
+ *   number of signatures used (8 bytes), type of each level (8 bytes),
+ *   SEED (32 bytes) and I (16 bytes) of the top level tree.
+ * The one-time keys are derived from SEED as in Appendix A of RFC 8554 and the
+ * SEED and I of lower level trees from the parent tree's SEED and I. The
+ * updated private key is written with the write callback before each
+ * signature is produced.
+ */
+
+#ifdef HAVE_CONFIG_H
+    #include <config.h>
+#endif
+
 #include <wolfssl/wolfcrypt/settings.h>
+#include <wolfssl/wolfcrypt/error-crypt.h>
+#include <wolfssl/wolfcrypt/logging.h>
+
+#if defined(WOLFSSL_HAVE_LMS) && defined(WOLFSSL_WC_LMS)
+#include <wolfssl/wolfcrypt/wc_lms.h>
+#include <wolfssl/wolfcrypt/sha256.h>
+#include <wolfssl/wolfcrypt/hash.h>
+
+#ifdef NO_INLINE
+    #include <wolfssl/wolfcrypt/misc.h>
+#else
+    #define WOLFSSL_MISC_INCLUDED
+    #include <wolfcrypt/src/misc.c>
+#endif
+
+#if defined(WOLFSSL_LMS_THREADS) && !defined(SINGLE_THREADED) && \
+    !defined(WOLFSSL_LMS_VERIFY_ONLY)
+    #define LMS_THREADS
+    /* Most threads a tree is built with. */
+    #ifndef WOLFSSL_LMS_MAX_THREADS
+        #define WOLFSSL_LMS_MAX_THREADS     16
+    #endif
+#endif
+
+/* LMS types: SHA-256, 32 byte hash, tree height of 5 to 25. */
+#define LMS_SHA256_M32_H5       5
+#define LMS_SHA256_M32_H25      9
+/* LM-OTS types: SHA-256, 32 byte hash, Winternitz parameter of 1 to 8. */
+#define LMOTS_SHA256_N32_W1     1
+#define LMOTS_SHA256_N32_W8     4
+
+/* Domain separation values of RFC 8554. */
+#define LMS_D_PBLC              0x8080
+#define LMS_D_MESG              0x8181
+#define LMS_D_LEAF              0x8282
+#define LMS_D_INTR              0x8383
+/* Chain step that derives the one-time private keys (RFC 8554 Appendix A). */
+#define LMS_D_PRIV              0xff
+/* Indices past the last chain for deriving the randomizer C and the SEED and
+ * I of child trees. */
+#define LMS_D_C                 0xfffd
+#define LMS_D_CHILD_SEED        0xfffe
+#define LMS_D_CHILD_I           0xffff
+
+/* Layout of a chain message: I || u32str(q) || u16str(i) || u8str(j) || tmp */
+#define LMS_CHAIN_Q             LMS_I_LEN
+#define LMS_CHAIN_I             (LMS_CHAIN_Q + 4)
+#define LMS_CHAIN_J             (LMS_CHAIN_I + 2)
+#define LMS_CHAIN_TMP           (LMS_CHAIN_J + 1)
+#define LMS_CHAIN_LEN           (LMS_CHAIN_TMP + LMS_HASH_LEN)
+/* Length of the prefix of a public key, message or node hash:
+ * I || u32str(q or r) || u16str(D) */
+#define LMS_PREFIX_LEN          (LMS_I_LEN + 4 + 2)
+/* Length of a leaf node message. */
+#define LMS_LEAF_LEN            (LMS_PREFIX_LEN + LMS_HASH_LEN)
+/* Length of an internal node message. */
+#define LMS_NODE_LEN            (LMS_PREFIX_LEN + 2 * LMS_HASH_LEN)
+
+/* Most chains of a one-time signature: p for a Winternitz parameter of 1. */
+#define LMS_MAX_P               265
+/* Leaves computed together to fill the SIMD lanes with their chains. */
+#define LMS_LEAF_BATCH          8
+/* Internal nodes hashed together. */
+#define LMS_NODE_BATCH          64
+
+/* Tree id of a tree not built yet. */
+#define LMS_TREE_NONE           ((word64)-1)
+
+/* Parameters of an LMS tree and its one-time signatures. */
+typedef struct LmsParams {
+    /* LMS type. */
+    word32 lmType;
+    /* LM-OTS type. */
+    word32 otsType;
+    /* Height of the tree. */
+    word32 height;
+    /* Winternitz parameter: bits of the hash per chain. */
+    word32 w;
+    /* Number of chains. */
+    word32 p;
+    /* Left shift of the checksum. */
+    word32 ls;
+    /* Length of an LMS signature. */
+    word32 sigLen;
+} LmsParams;
+
+/* Working memory to compute the one-time keys of a batch of leaves. */
+typedef struct LmsScratch {
+    /* Chain messages. */
+    byte*        chain;
+    /* Public key messages of the leaves. */
+    byte*        k;
+    /* Messages, lengths and outputs of a multi-buffer hash. */
+    const byte** data;
+    byte**       hash;
+    word32*      len;
+    /* Size of the allocation. */
+    word32       sz;
+} LmsScratch;
+
+/* Set the parameters from the LMS and LM-OTS types.
+ *
+ * @param [out] params   Parameters of tree.
+ * @param [in]  lmType   LMS type.
+ * @param [in]  otsType  LM-OTS type.
+ * @return  0 on success.
+ * @return  NOT_COMPILED_IN when a type is not supported.
+ */
+static int wc_lms_params(LmsParams* params, word32 lmType, word32 otsType)
+{
+    int ret = 0;
+
+    if ((lmType < LMS_SHA256_M32_H5) || (lmType > LMS_SHA256_M32_H25)) {
+        ret = NOT_COMPILED_IN;
+    }
+    else {
+        params->lmType = lmType;
+        params->height = (lmType - LMS_SHA256_M32_H5 + 1) * 5;
+        params->otsType = otsType;
+        switch (otsType) {
+            case 1:
+                params->w = 1; params->p = 265; params->ls = 7;
+                break;
+            case 2:
+                params->w = 2; params->p = 133; params->ls = 6;
+                break;
+            case 3:
+                params->w = 4; params->p = 67; params->ls = 4;
+                break;
+            case 4:
+                params->w = 8; params->p = 34; params->ls = 0;
+                break;
+            default:
+                ret = NOT_COMPILED_IN;
+                break;
+        }
+    }
+    if (ret == 0) {
+        /* q || OTS type || C || y[p] || LMS type || path[h] */
+        params->sigLen = 4 + 4 + LMS_HASH_LEN + params->p * LMS_HASH_LEN + 4 +
+                         params->height * LMS_HASH_LEN;
+    }
+
+    return ret;
+}
 
-#ifdef WOLFSSL_HAVE_LMS
-    #error "Contact wolfSSL to get the implementation of this file"
+/* Set the parameters of the trees of a key.
+ *
+ * @param [in]  key     LMS key.
+ * @param [out] params  Parameters of tree.
+ * @return  0 on success.
+ * @return  NOT_COMPILED_IN when parameters are not supported.
+ */
+static int wc_lms_key_params(const LmsKey* key, LmsParams* params)
+{
+    word32 otsType;
+
+    switch (key->winternitz) {
+        case 1: otsType = 1; break;
+        case 2: otsType = 2; break;
+        case 4: otsType = 3; break;
+        case 8: otsType = 4; break;
+        default: otsType = 0; break;
+    }
+    return wc_lms_params(params, (word32)(key->height / 5 + 4), otsType);
+}
+
+/* Length of an HSS signature.
+ *
+ * @param [in] params  Parameters of each tree.
+ * @param [in] levels  Number of levels of trees.
+ * @return  Length of signature in bytes.
+ */
+static word32 wc_hss_sig_len(const LmsParams* params, int levels)
+{
+    return 4 + (word32)(levels - 1) * (params->sigLen + LMS_PUB_LEN) +
+           params->sigLen;
+}
+
+/* Hash a number of independent messages.
+ *
+ * A digest may be written over the end of its own message.
+ *
+ * @param [in]  data  Messages.
+ * @param [in]  len   Lengths of messages.
+ * @param [out] hash  Buffers to hold digests.
+ * @param [in]  cnt   Number of messages.
+ * @param [in]  heap  Dynamic memory allocation hint.
+ * @return  0 on success.
+ */
+static int wc_lms_hash_multi(const byte* const* data, const word32* len,
+    byte* const* hash, word32 cnt, void* heap)
+{
+#ifdef WOLFSSL_SHA256_MULTI
+    return wc_Sha256HashMulti_ex(data, len, hash, cnt, heap, INVALID_DEVID);
+#else
+    int ret;
+    word32 i;
+    wc_Sha256 sha256[1];
+
+    ret = wc_InitSha256_ex(sha256, heap, INVALID_DEVID);
+    for (i = 0; (ret == 0) && (i < cnt); i++) {
+        ret = wc_Sha256Update(sha256, data[i], len[i]);
+        if (ret == 0) {
+            /* Final resets the object for the next message. */
+            ret = wc_Sha256Final(sha256, hash[i]);
+        }
+    }
+    wc_Sha256Free(sha256);
+
+    return ret;
 #endif
+}
+
+/* Hash an internal node: H(I || u32str(r) || u16str(D_INTR) || left || right)
+ *
+ * @param [in]  I      Tree identifier.
+ * @param [in]  r      Node number.
+ * @param [in]  left   Left child.
+ * @param [in]  right  Right child.
+ * @param [out] node   Node.
+ * @return  0 on success.
+ */
+static int wc_lms_hash_node(const byte* I, word32 r, const byte* left,
+    const byte* right, byte* node)
+{
+    byte msg[LMS_NODE_LEN];
+
+    XMEMCPY(msg, I, LMS_I_LEN);
+    c32toa(r, msg + LMS_I_LEN);
+    c16toa(LMS_D_INTR, msg + LMS_I_LEN + 4);
+    XMEMCPY(msg + LMS_PREFIX_LEN, left, LMS_HASH_LEN);
+    XMEMCPY(msg + LMS_PREFIX_LEN + LMS_HASH_LEN, right, LMS_HASH_LEN);
+
+    return wc_Sha256Hash(msg, LMS_NODE_LEN, node);
+}
+
+/* Get coefficient i of Winternitz parameter w bits from S.
+ *
+ * @param [in] s  Hash and checksum.
+ * @param [in] i  Index of coefficient.
+ * @param [in] w  Winternitz parameter.
+ * @return  Coefficient.
+ */
+static WC_INLINE word32 wc_lms_coef(const byte* s, word32 i, word32 w)
+{
+    return (((word32)1 << w) - 1) &
+           (s[i * w / 8] >> (8 - (w * (i % (8 / w)) + w)));
+}
+
+/* Put the checksum of the message hash after it.
+ *
+ * @param [in]      params  Parameters of tree.
+ * @param [in, out] q       Message hash followed by 2 bytes for checksum.
+ */
+static void wc_lms_checksum(const LmsParams* params, byte* q)
+{
+    word32 i;
+    word32 sum = 0;
+    word32 max = ((word32)1 << params->w) - 1;
+
+    for (i = 0; i < LMS_HASH_LEN * 8 / params->w; i++) {
+        sum += max - wc_lms_coef(q, i, params->w);
+    }
+    c16toa((word16)(sum << params->ls), q + LMS_HASH_LEN);
+}
+
+/* Hash the message with its randomizer: Q of RFC 8554 with checksum.
+ *
+ * @param [in]  params  Parameters of tree.
+ * @param [in]  I       Tree identifier.
+ * @param [in]  q       Leaf index.
+ * @param [in]  c       Randomizer.
+ * @param [in]  msg     Message.
+ * @param [in]  msgSz   Length of message in bytes.
+ * @param [out] out     Hash and checksum.
+ * @param [in]  heap    Dynamic memory allocation hint.
+ * @return  0 on success.
+ */
+static int wc_lms_msg_hash(const LmsParams* params, const byte* I, word32 q,
+    const byte* c, const byte* msg, word32 msgSz, byte* out, void* heap)
+{
+    int ret;
+    byte prefix[LMS_PREFIX_LEN];
+    wc_Sha256 sha256[1];
+
+    XMEMCPY(prefix, I, LMS_I_LEN);
+    c32toa(q, prefix + LMS_I_LEN);
+    c16toa(LMS_D_MESG, prefix + LMS_I_LEN + 4);
+
+    ret = wc_InitSha256_ex(sha256, heap, INVALID_DEVID);
+    if (ret == 0) {
+        ret = wc_Sha256Update(sha256, prefix, LMS_PREFIX_LEN);
+        if (ret == 0) {
+            ret = wc_Sha256Update(sha256, c, LMS_HASH_LEN);
+        }
+        if (ret == 0) {
+            ret = wc_Sha256Update(sha256, msg, msgSz);
+        }
+        if (ret == 0) {
+            ret = wc_Sha256Final(sha256, out);
+        }
+        wc_Sha256Free(sha256);
+    }
+    if (ret == 0) {
+        wc_lms_checksum(params, out);
+    }
+
+    return ret;
+}
+
+/* Allocate working memory for the one-time keys of a batch of leaves.
+ *
+ * @param [out] s       Working memory.
+ * @param [in]  p       Number of chains per leaf.
+ * @param [in]  leaves  Number of leaves in a batch.
+ * @param [in]  heap    Dynamic memory allocation hint.
+ * @return  0 on success.
+ * @return  MEMORY_E on dynamic memory allocation failure.
+ */
+static int wc_lms_scratch_alloc(LmsScratch* s, word32 p, word32 leaves,
+    void* heap)
+{
+    word32 n = p * leaves;
+    word32 kLen = LMS_PREFIX_LEN + p * LMS_HASH_LEN;
+    byte* mem;
+
+    s->sz = n * (word32)(sizeof(byte*) + sizeof(byte*) + sizeof(word32)) +
+            n * LMS_CHAIN_LEN + leaves * kLen;
+    mem = (byte*)XMALLOC(s->sz, heap, DYNAMIC_TYPE_TMP_BUFFER);
+    if (mem == NULL) {
+        return MEMORY_E;
+    }
+    s->data = (const byte**)mem;
+    s->hash = (byte**)(mem + n * sizeof(byte*));
+    s->len = (word32*)(mem + 2 * n * sizeof(byte*));
+    s->chain = mem + n * (word32)(2 * sizeof(byte*) + sizeof(word32));
+    s->k = s->chain + n * LMS_CHAIN_LEN;
+
+    return 0;
+}
+
+/* Dispose of working memory holding secret chain values.
+ *
+ * @param [in] s     Working memory.
+ * @param [in] heap  Dynamic memory allocation hint.
+ */
+static void wc_lms_scratch_free(LmsScratch* s, void* heap)
+{
+    if (s->data != NULL) {
+        ForceZero(s->data, s->sz);
+        XFREE(s->data, heap, DYNAMIC_TYPE_TMP_BUFFER);
+        s->data = NULL;
+    }
+    (void)heap;
+}
+
+#ifndef WOLFSSL_LMS_VERIFY_ONLY
+
+/* Set up the chain messages of a leaf with the message for step j.
+ *
+ * @param [in] s      Working memory.
+ * @param [in] idx    Index of first chain in working memory.
+ * @param [in] p      Number of chains.
+ * @param [in] I      Tree identifier.
+ * @param [in] q      Leaf index.
+ * @param [in] j      Chain step.
+ * @param [in] tmp    Value to put at the end of each chain message.
+ */
+static void wc_lms_chain_init(LmsScratch* s, word32 idx, word32 p,
+    const byte* I, word32 q, byte j, const byte* tmp)
+{
+    word32 i;
+
+    for (i = 0; i < p; i++) {
+        byte* buf = s->chain + (idx + i) * LMS_CHAIN_LEN;
+
+        XMEMCPY(buf, I, LMS_I_LEN);
+        c32toa(q, buf + LMS_CHAIN_Q);
+        c16toa((word16)i, buf + LMS_CHAIN_I);
+        buf[LMS_CHAIN_J] = j;
+        XMEMCPY(buf + LMS_CHAIN_TMP, tmp, LMS_HASH_LEN);
+        s->data[idx + i] = buf;
+        s->len[idx + i] = LMS_CHAIN_LEN;
+        s->hash[idx + i] = buf + LMS_CHAIN_TMP;
+    }
+}
+
+/* Calculate the leaf nodes of a batch of consecutive leaves.
+ *
+ * @param [in]  params  Parameters of tree.
+ * @param [in]  I       Tree identifier.
+ * @param [in]  seed    Secret seed of tree.
+ * @param [in]  q       Index of first leaf.
+ * @param [in]  cnt     Number of leaves. At most LMS_LEAF_BATCH.
+ * @param [out] out     Leaf nodes.
+ * @param [in]  s       Working memory for LMS_LEAF_BATCH leaves.
+ * @param [in]  heap    Dynamic memory allocation hint.
+ * @return  0 on success.
+ */
+static int wc_lms_leaves(const LmsParams* params, const byte* I,
+    const byte* seed, word32 q, word32 cnt, byte* out, LmsScratch* s,
+    void* heap)
+{
+    int ret;
+    word32 p = params->p;
+    word32 n = p * cnt;
+    word32 kLen = LMS_PREFIX_LEN + p * LMS_HASH_LEN;
+    word32 l;
+    word32 i;
+    word32 j;
+
+    /* x_q[i] = H(I || u32str(q) || u16str(i) || u8str(0xff) || SEED) */
+    for (l = 0; l < cnt; l++) {
+        wc_lms_chain_init(s, l * p, p, I, q + l, LMS_D_PRIV, seed);
+    }
+    ret = wc_lms_hash_multi(s->data, s->len, s->hash, n, heap);
+
+    /* Run every chain to its end: all chains of all leaves in lock step. */
+    for (j = 0; (ret == 0) && (j < ((word32)1 << params->w) - 1); j++) {
+        for (i = 0; i < n; i++) {
+            s->chain[i * LMS_CHAIN_LEN + LMS_CHAIN_J] = (byte)j;
+        }
+        ret = wc_lms_hash_multi(s->data, s->len, s->hash, n, heap);
+    }
+
+    /* K = H(I || u32str(q) || u16str(D_PBLC) || y[0] || ... || y[p-1]) */
+    if (ret == 0) {
+        for (l = 0; l < cnt; l++) {
+            byte* k = s->k + l * kLen;
+
+            XMEMCPY(k, I, LMS_I_LEN);
+            c32toa(q + l, k + LMS_I_LEN);
+            c16toa(LMS_D_PBLC, k + LMS_I_LEN + 4);
+            for (i = 0; i < p; i++) {
+                XMEMCPY(k + LMS_PREFIX_LEN + i * LMS_HASH_LEN,
+                    s->chain + (l * p + i) * LMS_CHAIN_LEN + LMS_CHAIN_TMP,
+                    LMS_HASH_LEN);
+            }
+            s->data[l] = k;
+            s->len[l] = kLen;
+            s->hash[l] = out + l * LMS_HASH_LEN;
+        }
+        ret = wc_lms_hash_multi(s->data, s->len, s->hash, cnt, heap);
+    }
+
+    /* T[r] = H(I || u32str(r) || u16str(D_LEAF) || K) */
+    if (ret == 0) {
+        for (l = 0; l < cnt; l++) {
+            byte* m = s->chain + l * LMS_LEAF_LEN;
+
+            XMEMCPY(m, I, LMS_I_LEN);
+            c32toa(((word32)1 << params->height) + q + l, m + LMS_I_LEN);
+            c16toa(LMS_D_LEAF, m + LMS_I_LEN + 4);
+            XMEMCPY(m + LMS_PREFIX_LEN, out + l * LMS_HASH_LEN, LMS_HASH_LEN);
+            s->data[l] = m;
+            s->len[l] = LMS_LEAF_LEN;
+            s->hash[l] = out + l * LMS_HASH_LEN;
+        }
+        ret = wc_lms_hash_multi(s->data, s->len, s->hash, cnt, heap);
+    }
+
+    return ret;
+}
+
+/* Nodes of one height computed from consecutive leaves by a pool of threads.
+ *
+ * The nodes are split into units of work that each thread takes in turn. A
+ * unit has at least LMS_LEAF_BATCH leaves under it when the tree is big
+ * enough.
+ */
+typedef struct LmsNodeJob {
+    /* Parameters of tree. */
+    const LmsParams* params;
+    /* Tree identifier. */
+    const byte*      I;
+    /* Secret seed of tree. */
+    const byte*      seed;
+    /* Index of first leaf. */
+    word32           start;
+    /* Height of the nodes to compute. */
+    word32           nodeH;
+    /* Number of nodes to compute. */
+    word32           cnt;
+    /* Number of nodes in a unit of work. */
+    word32           per;
+    /* Buffer to hold nodes. */
+    byte*            out;
+    /* Dynamic memory allocation hint. */
+    void*            heap;
+    /* Next unit of work to take. */
+    word32           next;
+    /* First error of a thread. */
+    int              ret;
+#ifdef LMS_THREADS
+    /* Whether other threads are sharing the job. */
+    int              threaded;
+    /* Lock on next and ret. */
+    wolfSSL_Mutex    lock;
+#endif
+} LmsNodeJob;
+
+/* Take the next unit of work of a job.
+ *
+ * @param [in]  job   Job shared by threads.
+ * @param [out] unit  Index of unit of work.
+ * @return  1 when there is a unit of work to do.
+ * @return  0 when all units taken or a thread failed.
+ */
+static int wc_lms_job_take(LmsNodeJob* job, word32* unit)
+{
+    int more;
+    word32 units = (job->cnt + job->per - 1) / job->per;
+
+#ifdef LMS_THREADS
+    if (job->threaded && (wc_LockMutex(&job->lock) != 0)) {
+        return 0;
+    }
+#endif
+    *unit = job->next++;
+    more = (job->ret == 0) && (*unit < units);
+#ifdef LMS_THREADS
+    if (job->threaded) {
+        wc_UnLockMutex(&job->lock);
+    }
+#endif
+
+    return more;
+}
+
+/* Record the failure of a thread.
+ *
+ * @param [in] job  Job shared by threads.
+ * @param [in] ret  Error code.
+ */
+static void wc_lms_job_fail(LmsNodeJob* job, int ret)
+{
+#ifdef LMS_THREADS
+    int locked = job->threaded && (wc_LockMutex(&job->lock) == 0);
+#endif
+
+    if (job->ret == 0) {
+        job->ret = ret;
+    }
+#ifdef LMS_THREADS
+    if (locked) {
+        wc_UnLockMutex(&job->lock);
+    }
+#endif
+}
+
+/* Compute a node from the leaves under it with a stack of pending nodes.
+ *
+ * @param [in]  job    Job with tree to compute node of.
+ * @param [in]  first  Index of first leaf under node.
+ * @param [out] node   Node.
+ * @param [in]  s      Working memory.
+ * @return  0 on success.
+ */
+static int wc_lms_treehash(LmsNodeJob* job, word32 first, byte* node,
+    LmsScratch* s)
+{
+    int ret = 0;
+    const LmsParams* params = job->params;
+    word32 leaves = (word32)1 << job->nodeH;
+    word32 batch = (leaves < LMS_LEAF_BATCH) ? leaves : LMS_LEAF_BATCH;
+    word32 sp = 0;
+    word32 i;
+    word32 l;
+    byte leaf[LMS_LEAF_BATCH * LMS_HASH_LEN];
+    byte stack[(LMS_MAX_HEIGHT + 1) * LMS_HASH_LEN];
+    byte cur[LMS_HASH_LEN];
+
+    for (i = 0; (ret == 0) && (i < leaves); i += batch) {
+        ret = wc_lms_leaves(params, job->I, job->seed, first + i, batch, leaf,
+            s, job->heap);
+        for (l = 0; (ret == 0) && (l < batch); l++) {
+            word32 pos = first + i + l;
+            word32 h = 0;
+
+            XMEMCPY(cur, leaf + l * LMS_HASH_LEN, LMS_HASH_LEN);
+            /* Merge with left siblings waiting on the stack. */
+            while ((ret == 0) && (h < job->nodeH) && (pos & 1)) {
+                sp--;
+                pos >>= 1;
+                h++;
+                ret = wc_lms_hash_node(job->I,
+                    ((word32)1 << (params->height - h)) + pos,
+                    stack + sp * LMS_HASH_LEN, cur, cur);
+            }
+            XMEMCPY(stack + sp * LMS_HASH_LEN, cur, LMS_HASH_LEN);
+            sp++;
+        }
+    }
+    if (ret == 0) {
+        XMEMCPY(node, stack, LMS_HASH_LEN);
+    }
+
+    return ret;
+}
+
+/* Do units of work of a job until there are none left.
+ *
+ * @param [in] job  Job shared by threads.
+ */
+static void wc_lms_node_work(LmsNodeJob* job)
+{
+    int ret;
+    word32 unit;
+    LmsScratch s;
+
+    XMEMSET(&s, 0, sizeof(s));
+    ret = wc_lms_scratch_alloc(&s, job->params->p, LMS_LEAF_BATCH, job->heap);
+    while ((ret == 0) && wc_lms_job_take(job, &unit)) {
+        word32 k = unit * job->per;
+        word32 end = k + job->per;
+
+        if (end > job->cnt) {
+            end = job->cnt;
+        }
+        if (job->nodeH == 0) {
+            ret = wc_lms_leaves(job->params, job->I, job->seed,
+                job->start + k, end - k, job->out + k * LMS_HASH_LEN, &s,
+                job->heap);
+        }
+        else {
+            for (; (ret == 0) && (k < end); k++) {
+                ret = wc_lms_treehash(job, job->start + (k << job->nodeH),
+                    job->out + k * LMS_HASH_LEN, &s);
+            }
+        }
+    }
+    if (ret != 0) {
+        wc_lms_job_fail(job, ret);
+    }
+    wc_lms_scratch_free(&s, job->heap);
+}
+
+#ifdef LMS_THREADS
+static THREAD_RETURN WOLFSSL_THREAD wc_lms_node_thread(void* arg)
+{
+    wc_lms_node_work((LmsNodeJob*)arg);
+    WOLFSSL_RETURN_FROM_THREAD(0);
+}
+#endif
+
+/* Compute consecutive nodes of one height with the key's threads.
+ *
+ * The calling thread works on the job too. Threads that can't be started
+ * leave their share to the others.
+ *
+ * @param [in]  key     LMS key.
+ * @param [in]  params  Parameters of tree.
+ * @param [in]  tree    Tree to compute nodes of.
+ * @param [in]  start   Index of first leaf under first node.
+ * @param [in]  nodeH   Height of nodes.
+ * @param [in]  cnt     Number of nodes.
+ * @param [out] out     Nodes.
+ * @return  0 on success.
+ */
+static int wc_lms_nodes(LmsKey* key, const LmsParams* params,
+    const LmsTree* tree, word32 start, word32 nodeH, word32 cnt, byte* out)
+{
+    LmsNodeJob job;
+#ifdef LMS_THREADS
+    THREAD_TYPE tid[WOLFSSL_LMS_MAX_THREADS];
+    int started[WOLFSSL_LMS_MAX_THREADS];
+    word32 threads = key->threads;
+    word32 units;
+    word32 t;
+#endif
+
+    XMEMSET(&job, 0, sizeof(job));
+    job.params = params;
+    job.I = tree->I;
+    job.seed = tree->seed;
+    job.start = start;
+    job.nodeH = nodeH;
+    job.cnt = cnt;
+    job.per = (nodeH >= 3) ? 1 : (LMS_LEAF_BATCH >> nodeH);
+    job.out = out;
+    job.heap = key->heap;
+
+#ifdef LMS_THREADS
+    units = (cnt + job.per - 1) / job.per;
+    if (threads > WOLFSSL_LMS_MAX_THREADS) {
+        threads = WOLFSSL_LMS_MAX_THREADS;
+    }
+    if (threads > units) {
+        threads = units;
+    }
+    if ((threads > 1) && (wc_InitMutex(&job.lock) == 0)) {
+        job.threaded = 1;
+        for (t = 1; t < threads; t++) {
+            started[t] = (wolfSSL_NewThread(&tid[t], wc_lms_node_thread,
+                                            &job) == 0);
+        }
+        wc_lms_node_work(&job);
+        for (t = 1; t < threads; t++) {
+            if (started[t]) {
+                (void)wolfSSL_JoinThread(tid[t]);
+            }
+        }
+        wc_FreeMutex(&job.lock);
+    }
+    else
+#endif
+    {
+        wc_lms_node_work(&job);
+    }
+
+    return job.ret;
+}
+
+/* Compute the internal nodes of a tree, or subtree, whose lowest nodes are set.
+ *
+ * Nodes are stored by node number relative to the root of the (sub)tree.
+ *
+ * @param [in]      I      Tree identifier.
+ * @param [in]      lh     Number of levels above the lowest nodes.
+ * @param [in]      rootR  Node number of root of (sub)tree.
+ * @param [in, out] nodes  Nodes of (sub)tree.
+ * @param [in]      heap   Dynamic memory allocation hint.
+ * @return  0 on success.
+ * @return  MEMORY_E on dynamic memory allocation failure.
+ */
+static int wc_lms_build_up(const byte* I, word32 lh, word32 rootR,
+    byte* nodes, void* heap)
+{
+    int ret = 0;
+    int d;
+    byte* msg;
+    const byte* data[LMS_NODE_BATCH];
+    byte* hash[LMS_NODE_BATCH];
+    word32 len[LMS_NODE_BATCH];
+
+    msg = (byte*)XMALLOC(LMS_NODE_BATCH * LMS_NODE_LEN, heap,
+        DYNAMIC_TYPE_TMP_BUFFER);
+    if (msg == NULL) {
+        return MEMORY_E;
+    }
+
+    for (d = (int)lh - 1; (ret == 0) && (d >= 0); d--) {
+        word32 lo = (word32)1 << d;
+        word32 lr;
+
+        for (lr = lo; (ret == 0) && (lr < 2 * lo); lr += LMS_NODE_BATCH) {
+            word32 cnt = 2 * lo - lr;
+            word32 i;
+
+            if (cnt > LMS_NODE_BATCH) {
+                cnt = LMS_NODE_BATCH;
+            }
+            for (i = 0; i < cnt; i++) {
+                byte* m = msg + i * LMS_NODE_LEN;
+                word32 n = lr + i;
+
+                XMEMCPY(m, I, LMS_I_LEN);
+                c32toa(rootR * lo + n - lo, m + LMS_I_LEN);
+                c16toa(LMS_D_INTR, m + LMS_I_LEN + 4);
+                XMEMCPY(m + LMS_PREFIX_LEN, nodes + 2 * n * LMS_HASH_LEN,
+                    2 * LMS_HASH_LEN);
+                data[i] = m;
+                len[i] = LMS_NODE_LEN;
+                hash[i] = nodes + n * LMS_HASH_LEN;
+            }
+            ret = wc_lms_hash_multi(data, len, hash, cnt, heap);
+        }
+    }
+
+    XFREE(msg, heap, DYNAMIC_TYPE_TMP_BUFFER);
+    return ret;
+}
+
+/* Number of levels of nodes of a tree kept in the top cache.
+ *
+ * @param [in] params  Parameters of tree.
+ * @return  Levels of nodes above the subtrees.
+ */
+static word32 wc_lms_top_height(const LmsParams* params)
+{
+    return (params->height < WOLFSSL_LMS_CACHE_HEIGHT) ? params->height :
+           WOLFSSL_LMS_CACHE_HEIGHT;
+}
+
+/* Compute the nodes of the subtree of leaves being signed with.
+ *
+ * @param [in] key     LMS key.
+ * @param [in] params  Parameters of tree.
+ * @param [in] tree    Tree to compute subtree of.
+ * @param [in] b       Index of subtree.
+ * @return  0 on success.
+ */
+static int wc_lms_tree_bottom(LmsKey* key, const LmsParams* params,
+    LmsTree* tree, word32 b)
+{
+    int ret;
+    word32 t = wc_lms_top_height(params);
+    word32 s = params->height - t;
+
+    tree->bottomIdx = (word32)-1;
+    ret = wc_lms_nodes(key, params, tree, b << s, 0, (word32)1 << s,
+        tree->bottom + ((word32)1 << s) * LMS_HASH_LEN);
+    if (ret == 0) {
+        ret = wc_lms_build_up(tree->I, s, ((word32)1 << t) + b, tree->bottom,
+            key->heap);
+    }
+    if (ret == 0) {
+        tree->bottomIdx = b;
+    }
+
+    return ret;
+}
+
+/* Compute the nodes of a tree that are kept in memory.
+ *
+ * @param [in] key     LMS key.
+ * @param [in] params  Parameters of tree.
+ * @param [in] tree    Tree to build.
+ * @param [in] q       Leaf to sign with next.
+ * @return  0 on success.
+ */
+static int wc_lms_tree_build(LmsKey* key, const LmsParams* params,
+    LmsTree* tree, word32 q)
+{
+    int ret;
+    word32 t = wc_lms_top_height(params);
+    word32 s = params->height - t;
+
+    /* Roots of the subtrees are the lowest level of the top cache. */
+    ret = wc_lms_nodes(key, params, tree, 0, s, (word32)1 << t,
+        tree->top + ((word32)1 << t) * LMS_HASH_LEN);
+    if (ret == 0) {
+        ret = wc_lms_build_up(tree->I, t, 1, tree->top, key->heap);
+    }
+    if (ret == 0) {
+        XMEMCPY(tree->root, tree->top + LMS_HASH_LEN, LMS_HASH_LEN);
+        if (s > 0) {
+            ret = wc_lms_tree_bottom(key, params, tree, q >> s);
+        }
+    }
+
+    return ret;
+}
+
+/* Encode the LMS public key of a tree.
+ *
+ * @param [in]  params  Parameters of tree.
+ * @param [in]  tree    Tree.
+ * @param [out] pub     LMS public key.
+ */
+static void wc_lms_tree_pub(const LmsParams* params, const LmsTree* tree,
+    byte* pub)
+{
+    c32toa(params->lmType, pub);
+    c32toa(params->otsType, pub + 4);
+    XMEMCPY(pub + 8, tree->I, LMS_I_LEN);
+    XMEMCPY(pub + 8 + LMS_I_LEN, tree->root, LMS_HASH_LEN);
+}
+
+/* Derive a value from the secret seed of a tree:
+ * H(I || u32str(q) || u16str(d) || u8str(0xff) || SEED)
+ *
+ * @param [in]  tree  Tree.
+ * @param [in]  q     Leaf index.
+ * @param [in]  d     Index past the last chain.
+ * @param [out] out   Derived value.
+ * @return  0 on success.
+ */
+static int wc_lms_derive(const LmsTree* tree, word32 q, word16 d, byte* out)
+{
+    int ret;
+    byte msg[LMS_CHAIN_LEN];
+
+    XMEMCPY(msg, tree->I, LMS_I_LEN);
+    c32toa(q, msg + LMS_CHAIN_Q);
+    c16toa(d, msg + LMS_CHAIN_I);
+    msg[LMS_CHAIN_J] = LMS_D_PRIV;
+    XMEMCPY(msg + LMS_CHAIN_TMP, tree->seed, LMS_SEED_LEN);
+    ret = wc_Sha256Hash(msg, LMS_CHAIN_LEN, out);
+    ForceZero(msg, sizeof(msg));
+
+    return ret;
+}
+
+/* Make an LMS signature with a leaf of a tree.
+ *
+ * @param [in]  key     LMS key.
+ * @param [in]  params  Parameters of tree.
+ * @param [in]  tree    Tree to sign with.
+ * @param [in]  q       Leaf index.
+ * @param [in]  msg     Message to sign.
+ * @param [in]  msgSz   Length of message in bytes.
+ * @param [out] sig     LMS signature.
+ * @return  0 on success.
+ */
+static int wc_lms_sign(LmsKey* key, const LmsParams* params,
+    const LmsTree* tree, word32 q, const byte* msg, word32 msgSz, byte* sig)
+{
+    int ret;
+    word32 p = params->p;
+    word32 t = wc_lms_top_height(params);
+    word32 s = params->height - t;
+    word32 i;
+    word32 j;
+    word32 a[LMS_MAX_P];
+    word32 maxA = 0;
+    byte* c = sig + 8;
+    byte* y = c + LMS_HASH_LEN;
+    byte* path;
+    byte qc[LMS_HASH_LEN + 2];
+    LmsScratch sc;
+
+    XMEMSET(&sc, 0, sizeof(sc));
+
+    c32toa(q, sig);
+    c32toa(params->otsType, sig + 4);
+    /* Randomizer derived from the secret seed. */
+    ret = wc_lms_derive(tree, q, LMS_D_C, c);
+    if (ret == 0) {
+        ret = wc_lms_msg_hash(params, tree->I, q, c, msg, msgSz, qc,
+            key->heap);
+    }
+    if (ret == 0) {
+        ret = wc_lms_scratch_alloc(&sc, p, 1, key->heap);
+    }
+    if (ret == 0) {
+        for (i = 0; i < p; i++) {
+            a[i] = wc_lms_coef(qc, i, params->w);
+            if (a[i] > maxA) {
+                maxA = a[i];
+            }
+        }
+        wc_lms_chain_init(&sc, 0, p, tree->I, q, LMS_D_PRIV, tree->seed);
+        ret = wc_lms_hash_multi(sc.data, sc.len, sc.hash, p, key->heap);
+    }
+    /* Step each chain a[i] times: the chains still going in lock step. */
+    for (j = 0; (ret == 0) && (j < maxA); j++) {
+        word32 n = 0;
+
+        for (i = 0; i < p; i++) {
+            if (a[i] > j) {
+                byte* buf = sc.chain + i * LMS_CHAIN_LEN;
+
+                buf[LMS_CHAIN_J] = (byte)j;
+                sc.data[n] = buf;
+                sc.len[n] = LMS_CHAIN_LEN;
+                sc.hash[n] = buf + LMS_CHAIN_TMP;
+                n++;
+            }
+        }
+        ret = wc_lms_hash_multi(sc.data, sc.len, sc.hash, n, key->heap);
+    }
+    if (ret == 0) {
+        for (i = 0; i < p; i++) {
+            XMEMCPY(y + i * LMS_HASH_LEN,
+                sc.chain + i * LMS_CHAIN_LEN + LMS_CHAIN_TMP, LMS_HASH_LEN);
+        }
+
+        c32toa(params->lmType, y + p * LMS_HASH_LEN);
+        path = y + p * LMS_HASH_LEN + 4;
+        /* Authentication path: siblings of the nodes from leaf to root. */
+        for (i = 0; i < params->height; i++) {
+            const byte* sib;
+
+            if (i < s) {
+                sib = tree->bottom + ((((((word32)1 << s) +
+                    (q & (((word32)1 << s) - 1))) >> i) ^ 1) * LMS_HASH_LEN);
+            }
+            else {
+                sib = tree->top + ((((((word32)1 << params->height) + q) >>
+                    i) ^ 1) * LMS_HASH_LEN);
+            }
+            XMEMCPY(path + i * LMS_HASH_LEN, sib, LMS_HASH_LEN);
+        }
+    }
+
+    wc_lms_scratch_free(&sc, key->heap);
+    ForceZero(a, sizeof(a));
+    return ret;
+}
+
+/* Leaf index of a level for a number of signatures used.
+ *
+ * @param [in] key    LMS key.
+ * @param [in] q      Number of signatures used.
+ * @param [in] level  Level of tree.
+ * @return  Leaf index.
+ */
+static word32 wc_hss_leaf(const LmsKey* key, word64 q, int level)
+{
+    word32 shift = (word32)(key->height * (key->levels - 1 - level));
+
+    if (shift >= 64) {
+        return 0;
+    }
+    return (word32)(q >> shift) & (((word32)1 << key->height) - 1);
+}
+
+/* Identifier of the tree at a level for a number of signatures used.
+ *
+ * @param [in] key    LMS key.
+ * @param [in] q      Number of signatures used.
+ * @param [in] level  Level of tree.
+ * @return  Tree identifier.
+ */
+static word64 wc_hss_tree_id(const LmsKey* key, word64 q, int level)
+{
+    word32 shift = (word32)(key->height * (key->levels - level));
+
+    if (shift >= 64) {
+        return 0;
+    }
+    return q >> shift;
+}
+
+/* Maximum number of signatures of a key.
+ *
+ * @param [in] key  LMS key.
+ * @return  Number of signatures. Capped at 2^64 - 1.
+ */
+static word64 wc_hss_max_sigs(const LmsKey* key)
+{
+    word32 bits = (word32)(key->height * key->levels);
+
+    if (bits >= 64) {
+        return (word64)-1;
+    }
+    return (word64)1 << bits;
+}
+
+/* Make sure each level has the tree and subtree for the next signature.
+ *
+ * A child tree is derived from the leaf of its parent that signs it and is
+ * built, and signed, when the signatures of the previous one are used up.
+ *
+ * @param [in] key     LMS key.
+ * @param [in] params  Parameters of each tree.
+ * @return  0 on success.
+ */
+static int wc_hss_update_trees(LmsKey* key, const LmsParams* params)
+{
+    int ret = 0;
+    int i;
+    word32 s = params->height - wc_lms_top_height(params);
+
+    for (i = 0; (ret == 0) && (i < key->levels); i++) {
+        LmsTree* tree = &key->tree[i];
+        word32 q = wc_hss_leaf(key, key->q, i);
+        word64 id = wc_hss_tree_id(key, key->q, i);
+
+        if (tree->id != id) {
+            LmsTree* parent = &key->tree[i - 1];
+            word32 pq = wc_hss_leaf(key, key->q, i - 1);
+            byte childI[LMS_HASH_LEN];
+            byte pub[LMS_PUB_LEN];
+
+            tree->id = LMS_TREE_NONE;
+            ret = wc_lms_derive(parent, pq, LMS_D_CHILD_SEED, tree->seed);
+            if (ret == 0) {
+                ret = wc_lms_derive(parent, pq, LMS_D_CHILD_I, childI);
+            }
+            if (ret == 0) {
+                XMEMCPY(tree->I, childI, LMS_I_LEN);
+                ret = wc_lms_tree_build(key, params, tree, q);
+            }
+            if (ret == 0) {
+                wc_lms_tree_pub(params, tree, pub);
+                ret = wc_lms_sign(key, params, parent, pq, pub, LMS_PUB_LEN,
+                    tree->sig);
+            }
+            if (ret == 0) {
+                tree->id = id;
+            }
+        }
+        else if ((s > 0) && (tree->bottomIdx != (q >> s))) {
+            ret = wc_lms_tree_bottom(key, params, tree, q >> s);
+        }
+    }
+
+    return ret;
+}
+
+/* Free the nodes kept for each tree.
+ *
+ * @param [in] key  LMS key.
+ */
+static void wc_hss_free_trees(LmsKey* key)
+{
+    int i;
+
+    for (i = 0; i < LMS_MAX_LEVELS; i++) {
+        LmsTree* tree = &key->tree[i];
+
+        if (tree->top != NULL) {
+            XFREE(tree->top, key->heap, DYNAMIC_TYPE_TMP_BUFFER);
+            tree->top = NULL;
+        }
+        if (tree->bottom != NULL) {
+            XFREE(tree->bottom, key->heap, DYNAMIC_TYPE_TMP_BUFFER);
+            tree->bottom = NULL;
+        }
+        if (tree->sig != NULL) {
+            XFREE(tree->sig, key->heap, DYNAMIC_TYPE_TMP_BUFFER);
+            tree->sig = NULL;
+        }
+        tree->id = LMS_TREE_NONE;
+    }
+}
+
+/* Allocate the nodes kept for each tree and build the trees from the private
+ * key.
+ *
+ * @param [in] key     LMS key with private key set.
+ * @param [in] params  Parameters of each tree.
+ * @return  0 on success.
+ * @return  MEMORY_E on dynamic memory allocation failure.
+ */
+static int wc_hss_load_trees(LmsKey* key, const LmsParams* params)
+{
+    int ret = 0;
+    int i;
+    word32 t = wc_lms_top_height(params);
+    word32 s = params->height - t;
+
+    wc_hss_free_trees(key);
+    for (i = 0; (ret == 0) && (i < key->levels); i++) {
+        LmsTree* tree = &key->tree[i];
+
+        tree->top = (byte*)XMALLOC(((word32)2 << t) * LMS_HASH_LEN, key->heap,
+            DYNAMIC_TYPE_TMP_BUFFER);
+        if (tree->top == NULL) {
+            ret = MEMORY_E;
+        }
+        if ((ret == 0) && (s > 0)) {
+            tree->bottom = (byte*)XMALLOC(((word32)2 << s) * LMS_HASH_LEN,
+                key->heap, DYNAMIC_TYPE_TMP_BUFFER);
+            if (tree->bottom == NULL) {
+                ret = MEMORY_E;
+            }
+        }
+        if ((ret == 0) && (i > 0)) {
+            tree->sig = (byte*)XMALLOC(params->sigLen, key->heap,
+                DYNAMIC_TYPE_TMP_BUFFER);
+            if (tree->sig == NULL) {
+                ret = MEMORY_E;
+            }
+        }
+    }
+
+    if (ret == 0) {
+        LmsTree* tree = &key->tree[0];
+
+        XMEMCPY(tree->seed, key->priv + 16, LMS_SEED_LEN);
+        XMEMCPY(tree->I, key->priv + 16 + LMS_SEED_LEN, LMS_I_LEN);
+        ret = wc_lms_tree_build(key, params, tree, wc_hss_leaf(key, key->q, 0));
+        if (ret == 0) {
+            tree->id = 0;
+            ret = wc_hss_update_trees(key, params);
+        }
+    }
+    if (ret == 0) {
+        c32toa((word32)key->levels, key->pub);
+        wc_lms_tree_pub(params, &key->tree[0], key->pub + 4);
+    }
+    else {
+        wc_hss_free_trees(key);
+    }
+
+    return ret;
+}
+
+/* Encode the number of signatures used into the private key and write it
+ * with the callback.
+ *
+ * @param [in] key  LMS key.
+ * @param [in] q    Number of signatures used.
+ * @return  0 on success.
+ * @return  -1 when the write callback fails.
+ */
+static int wc_hss_write_priv(LmsKey* key, word64 q)
+{
+    enum wc_LmsRc rc;
+
+    c32toa((word32)(q >> 32), key->priv);
+    c32toa((word32)q, key->priv + 4);
+
+    rc = key->write_private_key(key->priv, HSS_MAX_PRIVATE_KEY_LEN,
+        key->context);
+    if (rc != WC_LMS_RC_SAVED_TO_NV_MEMORY) {
+        WOLFSSL_MSG("error: LmsKey write_private_key failed");
+        WOLFSSL_MSG(wc_LmsKey_RcToStr(rc));
+        key->state = WC_LMS_STATE_BAD;
+        return -1;
+    }
+
+    return 0;
+}
+#endif /* ifndef WOLFSSL_LMS_VERIFY_ONLY */
+
+/* Verify an LMS signature against an LMS public key.
+ *
+ * @param [in] pub    LMS public key.
+ * @param [in] sig    LMS signature.
+ * @param [in] sigSz  Length of signature in bytes.
+ * @param [in] msg    Message.
+ * @param [in] msgSz  Length of message in bytes.
+ * @param [in] heap   Dynamic memory allocation hint.
+ * @return  0 when signature verifies.
+ * @return  -1 when signature does not verify.
+ * @return  MEMORY_E on dynamic memory allocation failure.
+ */
+static int wc_lms_verify(const byte* pub, const byte* sig, word32 sigSz,
+    const byte* msg, word32 msgSz, void* heap)
+{
+    int ret;
+    LmsParams params;
+    word32 lmType;
+    word32 otsType;
+    word32 q;
+    word32 r;
+    word32 i;
+    word32 j;
+    word32 a[LMS_MAX_P];
+    word32 max;
+    const byte* I = pub + 8;
+    const byte* c;
+    const byte* y;
+    const byte* path;
+    byte qc[LMS_HASH_LEN + 2];
+    byte node[LMS_HASH_LEN];
+    byte leaf[LMS_LEAF_LEN];
+    LmsScratch sc;
+
+    XMEMSET(&sc, 0, sizeof(sc));
+
+    ato32(pub, &lmType);
+    ato32(pub + 4, &otsType);
+    ret = wc_lms_params(&params, lmType, otsType);
+    if (ret != 0) {
+        return -1;
+    }
+    if (sigSz != params.sigLen) {
+        return -1;
+    }
+    ato32(sig, &q);
+    ato32(sig + 4, &otsType);
+    ato32(sig + 8 + LMS_HASH_LEN + params.p * LMS_HASH_LEN, &lmType);
+    if ((otsType != params.otsType) || (lmType != params.lmType) ||
+            (q >= ((word32)1 << params.height))) {
+        return -1;
+    }
+    c = sig + 8;
+    y = c + LMS_HASH_LEN;
+    path = y + params.p * LMS_HASH_LEN + 4;
+    max = ((word32)1 << params.w) - 1;
+
+    ret = wc_lms_msg_hash(&params, I, q, c, msg, msgSz, qc, heap);
+    if (ret == 0) {
+        ret = wc_lms_scratch_alloc(&sc, params.p, 1, heap);
+    }
+    if (ret == 0) {
+        for (i = 0; i < params.p; i++) {
+            byte* buf = sc.chain + i * LMS_CHAIN_LEN;
+
+            a[i] = wc_lms_coef(qc, i, params.w);
+            XMEMCPY(buf, I, LMS_I_LEN);
+            c32toa(q, buf + LMS_CHAIN_Q);
+            c16toa((word16)i, buf + LMS_CHAIN_I);
+            XMEMCPY(buf + LMS_CHAIN_TMP, y + i * LMS_HASH_LEN, LMS_HASH_LEN);
+        }
+    }
+    /* Finish each chain from step a[i]: the chains still going in lock
+     * step. */
+    for (j = 0; (ret == 0) && (j < max); j++) {
+        word32 n = 0;
+
+        for (i = 0; i < params.p; i++) {
+            if (a[i] <= j) {
+                byte* buf = sc.chain + i * LMS_CHAIN_LEN;
+
+                buf[LMS_CHAIN_J] = (byte)j;
+                sc.data[n] = buf;
+                sc.len[n] = LMS_CHAIN_LEN;
+                sc.hash[n] = buf + LMS_CHAIN_TMP;
+                n++;
+            }
+        }
+        ret = wc_lms_hash_multi(sc.data, sc.len, sc.hash, n, heap);
+    }
+    /* Candidate public key of the one-time signature. */
+    if (ret == 0) {
+        byte* k = sc.k;
+
+        XMEMCPY(k, I, LMS_I_LEN);
+        c32toa(q, k + LMS_I_LEN);
+        c16toa(LMS_D_PBLC, k + LMS_I_LEN + 4);
+        for (i = 0; i < params.p; i++) {
+            XMEMCPY(k + LMS_PREFIX_LEN + i * LMS_HASH_LEN,
+                sc.chain + i * LMS_CHAIN_LEN + LMS_CHAIN_TMP, LMS_HASH_LEN);
+        }
+        ret = wc_Sha256Hash(k, LMS_PREFIX_LEN + params.p * LMS_HASH_LEN,
+            node);
+    }
+    /* Up the authentication path to the root. */
+    if (ret == 0) {
+        r = ((word32)1 << params.height) + q;
+        XMEMCPY(leaf, I, LMS_I_LEN);
+        c32toa(r, leaf + LMS_I_LEN);
+        c16toa(LMS_D_LEAF, leaf + LMS_I_LEN + 4);
+        XMEMCPY(leaf + LMS_PREFIX_LEN, node, LMS_HASH_LEN);
+        ret = wc_Sha256Hash(leaf, LMS_LEAF_LEN, node);
+    }
+    for (i = 0; (ret == 0) && (i < params.height); i++) {
+        if (r & 1) {
+            ret = wc_lms_hash_node(I, r >> 1, path + i * LMS_HASH_LEN, node,
+                node);
+        }
+        else {
+            ret = wc_lms_hash_node(I, r >> 1, node, path + i * LMS_HASH_LEN,
+                node);
+        }
+        r >>= 1;
+    }
+    if ((ret == 0) && (XMEMCMP(node, pub + 8 + LMS_I_LEN, LMS_HASH_LEN) != 0)) {
+        ret = -1;
+    }
+
+    wc_lms_scratch_free(&sc, heap);
+    return ret;
+}
+
+/* Length of the LMS signature at the start of a buffer.
+ *
+ * @param [in] sig    Buffer holding LMS signature.
+ * @param [in] sigSz  Length of data in buffer.
+ * @return  Length of LMS signature on success.
+ * @return  0 when types are invalid or the buffer is too short.
+ */
+static word32 wc_lms_sig_len(const byte* sig, word32 sigSz)
+{
+    LmsParams params;
+    word32 otsType;
+    word32 lmType;
+    word32 off;
+
+    if (sigSz < 8) {
+        return 0;
+    }
+    ato32(sig + 4, &otsType);
+    /* Any valid LMS type to get p. */
+    if (wc_lms_params(&params, LMS_SHA256_M32_H5, otsType) != 0) {
+        return 0;
+    }
+    off = 8 + LMS_HASH_LEN + params.p * LMS_HASH_LEN;
+    if (sigSz < off + 4) {
+        return 0;
+    }
+    ato32(sig + off, &lmType);
+    if (wc_lms_params(&params, lmType, otsType) != 0) {
+        return 0;
+    }
+    if (sigSz < params.sigLen) {
+        return 0;
+    }
+
+    return params.sigLen;
+}
+
+const char * wc_LmsKey_ParmToStr(enum wc_LmsParm lmsParm)
+{
+    switch (lmsParm) {
+    case WC_LMS_PARM_NONE:
+        return "LMS_NONE";
+
+    case WC_LMS_PARM_L1_H15_W2:
+        return "LMS/HSS L1_H15_W2";
+
+    case WC_LMS_PARM_L1_H15_W4:
+        return "LMS/HSS L1_H15_W4";
+
+    case WC_LMS_PARM_L2_H10_W2:
+        return "LMS/HSS L2_H10_W2";
+
+    case WC_LMS_PARM_L2_H10_W4:
+        return "LMS/HSS L2_H10_W4";
+
+    case WC_LMS_PARM_L2_H10_W8:
+        return "LMS/HSS L2_H10_W8";
+
+    case WC_LMS_PARM_L3_H5_W2:
+        return "LMS/HSS L3_H5_W2";
+
+    case WC_LMS_PARM_L3_H5_W4:
+        return "LMS/HSS L3_H5_W4";
+
+    case WC_LMS_PARM_L3_H5_W8:
+        return "LMS/HSS L3_H5_W8";
+
+    case WC_LMS_PARM_L3_H10_W4:
+        return "LMS/HSS L3_H10_W4";
+
+    case WC_LMS_PARM_L4_H5_W8:
+        return "LMS/HSS L4_H5_W8";
+
+    default:
+        WOLFSSL_MSG("error: invalid LMS parameter");
+        break;
+    }
+
+    return "LMS_INVALID";
+}
+
+const char * wc_LmsKey_RcToStr(enum wc_LmsRc lmsEc)
+{
+    switch (lmsEc) {
+    case WC_LMS_RC_NONE:
+        return "LMS_RC_NONE";
+
+    case WC_LMS_RC_BAD_ARG:
+        return "LMS_RC_BAD_ARG";
+
+    case WC_LMS_RC_WRITE_FAIL:
+        return "LMS_RC_WRITE_FAIL";
+
+    case WC_LMS_RC_READ_FAIL:
+        return "LMS_RC_READ_FAIL";
+
+    case WC_LMS_RC_SAVED_TO_NV_MEMORY:
+        return "LMS_RC_SAVED_TO_NV_MEMORY";
+
+    case WC_LMS_RC_READ_TO_MEMORY:
+        return "LMS_RC_READ_TO_MEMORY";
+
+    default:
+        WOLFSSL_MSG("error: invalid LMS error code");
+        break;
+    }
+
+    return "LMS_RC_INVALID";
+}
+
+/* Init an LMS key.
+ *
+ * Call this before setting the params of an LMS key.
+ *
+ * Returns 0 on success.
+ * */
+int wc_LmsKey_Init(LmsKey * key, void * heap, int devId)
+{
+#ifndef WOLFSSL_LMS_VERIFY_ONLY
+    int i;
+#endif
+
+    if (key == NULL) {
+        return BAD_FUNC_ARG;
+    }
+
+    (void) devId;
+
+    ForceZero(key, sizeof(LmsKey));
+
+    key->heap = heap;
+#ifndef WOLFSSL_LMS_VERIFY_ONLY
+    for (i = 0; i < LMS_MAX_LEVELS; i++) {
+        key->tree[i].id = LMS_TREE_NONE;
+    }
+#if defined(WOLFSSL_LMS_THREADS) && !defined(SINGLE_THREADED)
+    key->threads = 1;
+#endif
+#endif /* ifndef WOLFSSL_LMS_VERIFY_ONLY */
+    key->state = WC_LMS_STATE_INITED;
+
+    return 0;
+}
+
+/* Set the wc_LmsParm of an LMS key.
+ *
+ * Use this if you wish to set a key with a predefined parameter set,
+ * such as WC_LMS_PARM_L2_H10_W8.
+ *
+ * Key must be inited before calling this.
+ *
+ * Returns 0 on success.
+ * */
+int wc_LmsKey_SetLmsParm(LmsKey * key, enum wc_LmsParm lmsParm)
+{
+    if (key == NULL) {
+        return BAD_FUNC_ARG;
+    }
+
+    /* If NONE is passed, default to the lowest predefined set. */
+    switch (lmsParm) {
+    case WC_LMS_PARM_NONE:
+    case WC_LMS_PARM_L1_H15_W2:
+        return wc_LmsKey_SetParameters(key, 1, 15, 2);
+
+    case WC_LMS_PARM_L1_H15_W4:
+        return wc_LmsKey_SetParameters(key, 1, 15, 4);
+
+    case WC_LMS_PARM_L2_H10_W2:
+        return wc_LmsKey_SetParameters(key, 2, 10, 2);
+
+    case WC_LMS_PARM_L2_H10_W4:
+        return wc_LmsKey_SetParameters(key, 2, 10, 4);
+
+    case WC_LMS_PARM_L2_H10_W8:
+        return wc_LmsKey_SetParameters(key, 2, 10, 8);
+
+    case WC_LMS_PARM_L3_H5_W2:
+        return wc_LmsKey_SetParameters(key, 3, 5, 2);
+
+    case WC_LMS_PARM_L3_H5_W4:
+        return wc_LmsKey_SetParameters(key, 3, 5, 4);
+
+    case WC_LMS_PARM_L3_H5_W8:
+        return wc_LmsKey_SetParameters(key, 3, 5, 8);
+
+    case WC_LMS_PARM_L3_H10_W4:
+        return wc_LmsKey_SetParameters(key, 3, 10, 4);
+
+    case WC_LMS_PARM_L4_H5_W8:
+        return wc_LmsKey_SetParameters(key, 4, 5, 8);
+
+    default:
+        WOLFSSL_MSG("error: invalid LMS parameter set");
+        break;
+    }
+
+    return BAD_FUNC_ARG;
+}
+
+/* Set the parameters of an LMS key.
+ *
+ * Use this if you wish to set specific parameters not found in the
+ * wc_LmsParm predefined sets. See comments in lms.h for allowed
+ * parameters.
+ *
+ * Key must be inited before calling this.
+ *
+ * Returns 0 on success.
+ * */
+int wc_LmsKey_SetParameters(LmsKey * key, int levels, int height,
+    int winternitz)
+{
+    if (key == NULL) {
+        return BAD_FUNC_ARG;
+    }
+
+    if (key->state != WC_LMS_STATE_INITED) {
+        WOLFSSL_MSG("error: LmsKey needs init");
+        return -1;
+    }
+
+    if (levels < LMS_MIN_LEVELS || levels > LMS_MAX_LEVELS) {
+        WOLFSSL_MSG("error: invalid level parameter");
+        return BAD_FUNC_ARG;
+    }
+
+    if (height < LMS_MIN_HEIGHT || height > LMS_MAX_HEIGHT ||
+            (height % 5) != 0) {
+        WOLFSSL_MSG("error: invalid height parameter");
+        return BAD_FUNC_ARG;
+    }
+
+    if (winternitz != 1 && winternitz != 2 && winternitz != 4 &&
+            winternitz != 8) {
+        WOLFSSL_MSG("error: invalid winternitz parameter");
+        return BAD_FUNC_ARG;
+    }
+
+    key->levels = levels;
+    key->height = height;
+    key->winternitz = winternitz;
+
+    /* Move the state to params set.
+     * Key is ready for MakeKey or Reload. */
+    key->state = WC_LMS_STATE_PARMSET;
+
+    return 0;
+}
+
+/* Get the parameters of an LMS key.
+ *
+ * Key must be inited and parameters set before calling this.
+ *
+ * Returns 0 on success.
+ * */
+int wc_LmsKey_GetParameters(const LmsKey * key, int * levels, int * height,
+    int * winternitz)
+{
+    if (key == NULL || levels == NULL || height == NULL || winternitz == NULL) {
+        return BAD_FUNC_ARG;
+    }
+
+    /* This shouldn't happen, but check the LmsKey parameters aren't invalid. */
+    if (key->levels < LMS_MIN_LEVELS || key->levels > LMS_MAX_LEVELS) {
+        WOLFSSL_MSG("error: LmsKey invalid level parameter");
+        return -1;
+    }
+
+    *levels = key->levels;
+    *height = key->height;
+    *winternitz = key->winternitz;
+
+    return 0;
+}
+
+/* Frees the LMS key from memory.
+ *
+ * This does not affect the private key saved to non-volatile storage.
+ * */
+void wc_LmsKey_Free(LmsKey* key)
+{
+    if (key == NULL) {
+        return;
+    }
+
+#ifndef WOLFSSL_LMS_VERIFY_ONLY
+    wc_hss_free_trees(key);
+#endif /* ifndef WOLFSSL_LMS_VERIFY_ONLY */
+
+    ForceZero(key, sizeof(LmsKey));
+
+    key->state = WC_LMS_STATE_FREED;
+
+    return;
+}
+
+#ifndef WOLFSSL_LMS_VERIFY_ONLY
+#if defined(WOLFSSL_LMS_THREADS) && !defined(SINGLE_THREADED)
+/* Set the number of threads that build the trees of the key.
+ *
+ * Key generation, reloading and starting a new tree at a lower level when
+ * signing compute the leaves of a tree with this many threads.
+ *
+ * Returns 0 on success.
+ * */
+int wc_LmsKey_SetThreads(LmsKey * key, word32 threads)
+{
+    if (key == NULL || threads == 0) {
+        return BAD_FUNC_ARG;
+    }
+
+    key->threads = threads;
+
+    return 0;
+}
+#endif
+
+/* Set the write private key callback to the LMS key structure.
+ *
+ * The callback must be able to write/update the private key to
+ * non-volatile storage.
+ *
+ * Returns 0 on success.
+ * */
+int wc_LmsKey_SetWriteCb(LmsKey * key, write_private_key_cb write_cb)
+{
+    if (key == NULL || write_cb == NULL) {
+        return BAD_FUNC_ARG;
+    }
+
+    /* Changing the write callback of an already working key is forbidden. */
+    if (key->state == WC_LMS_STATE_OK) {
+        WOLFSSL_MSG("error: wc_LmsKey_SetWriteCb: key in use");
+        return -1;
+    }
+
+    key->write_private_key = write_cb;
+
+    return 0;
+}
+
+/* Set the read private key callback to the LMS key structure.
+ *
+ * The callback must be able to read the private key from
+ * non-volatile storage.
+ *
+ * Returns 0 on success.
+ * */
+int wc_LmsKey_SetReadCb(LmsKey * key, read_private_key_cb read_cb)
+{
+    if (key == NULL || read_cb == NULL) {
+        return BAD_FUNC_ARG;
+    }
+
+    /* Changing the read callback of an already working key is forbidden. */
+    if (key->state == WC_LMS_STATE_OK) {
+        WOLFSSL_MSG("error: wc_LmsKey_SetReadCb: key in use");
+        return -1;
+    }
+
+    key->read_private_key = read_cb;
+
+    return 0;
+}
+
+/* Sets the context to be used by write and read callbacks.
+ *
+ * E.g. this could be a filename if the callbacks write/read to file.
+ *
+ * Returns 0 on success.
+ * */
+int wc_LmsKey_SetContext(LmsKey * key, void * context)
+{
+    if (key == NULL || context == NULL) {
+        return BAD_FUNC_ARG;
+    }
+
+    /* Setting context of an already working key is forbidden. */
+    if (key->state == WC_LMS_STATE_OK) {
+        WOLFSSL_MSG("error: wc_LmsKey_SetContext: key in use");
+        return -1;
+    }
+
+    key->context = context;
+
+    return 0;
+}
+
+/* Make the LMS private/public key pair. The key must have its parameters
+ * set before calling this.
+ *
+ * Write/read callbacks, and context data, must be set prior.
+ * Key must have parameters set.
+ *
+ * The private key is written before the trees are built.
+ *
+ * Returns 0 on success.
+ * */
+int wc_LmsKey_MakeKey(LmsKey* key, WC_RNG * rng)
+{
+    int       ret = 0;
+    int       i;
+    LmsParams params;
+
+    if (key == NULL || rng == NULL) {
+        return BAD_FUNC_ARG;
+    }
+
+    if (key->state != WC_LMS_STATE_PARMSET) {
+        WOLFSSL_MSG("error: LmsKey not ready for generation");
+        return -1;
+    }
+
+    if (key->write_private_key == NULL || key->read_private_key == NULL) {
+        WOLFSSL_MSG("error: LmsKey write/read callbacks are not set");
+        return -1;
+    }
+
+    if (key->context == NULL) {
+        WOLFSSL_MSG("error: LmsKey context is not set");
+        return -1;
+    }
+
+    ret = wc_lms_key_params(key, &params);
+    if (ret != 0) {
+        return ret;
+    }
+
+    /* Signatures used, type of each level, SEED and I. */
+    key->q = 0;
+    XMEMSET(key->priv + 8, 0xff, LMS_MAX_LEVELS);
+    for (i = 0; i < key->levels; i++) {
+        key->priv[8 + i] = (byte)((params.lmType << 4) | params.otsType);
+    }
+    ret = wc_RNG_GenerateBlock(rng, key->priv + 16,
+        LMS_SEED_LEN + LMS_I_LEN);
+    if (ret != 0) {
+        WOLFSSL_MSG("error: LmsKey random generation failed");
+        return ret;
+    }
+
+    ret = wc_hss_write_priv(key, 0);
+    if (ret == 0) {
+        ret = wc_hss_load_trees(key, &params);
+        if (ret != 0) {
+            WOLFSSL_MSG("error: LmsKey tree generation failed");
+            key->state = WC_LMS_STATE_BAD;
+        }
+    }
+
+    if (ret == 0) {
+        key->state = WC_LMS_STATE_OK;
+    }
+
+    return ret;
+}
+
+/* Reload a key that has been prepared with the appropriate params and
+ * data. Use this if you wish to resume signing with an existing key.
+ *
+ * Write/read callbacks, and context data, must be set prior.
+ * Key must have parameters set. They are replaced with those of the
+ * private key read.
+ *
+ * Returns 0 on success. */
+int wc_LmsKey_Reload(LmsKey * key)
+{
+    int           ret = 0;
+    int           i;
+    int           levels;
+    enum wc_LmsRc rc;
+    word32        hi;
+    word32        lo;
+    LmsParams     params;
+
+    if (key == NULL) {
+        return BAD_FUNC_ARG;
+    }
+
+    if (key->state != WC_LMS_STATE_PARMSET) {
+        WOLFSSL_MSG("error: LmsKey not ready for reload");
+        return -1;
+    }
+
+    if (key->write_private_key == NULL || key->read_private_key == NULL) {
+        WOLFSSL_MSG("error: LmsKey write/read callbacks are not set");
+        return -1;
+    }
+
+    if (key->context == NULL) {
+        WOLFSSL_MSG("error: LmsKey context is not set");
+        return -1;
+    }
+
+    rc = key->read_private_key(key->priv, HSS_MAX_PRIVATE_KEY_LEN,
+        key->context);
+    if (rc != WC_LMS_RC_READ_TO_MEMORY) {
+        WOLFSSL_MSG("error: LmsKey read_private_key failed");
+        WOLFSSL_MSG(wc_LmsKey_RcToStr(rc));
+        key->state = WC_LMS_STATE_BAD;
+        return -1;
+    }
+
+    /* Parameter set: the same type at each level. */
+    for (levels = 0; levels < LMS_MAX_LEVELS; levels++) {
+        if (key->priv[8 + levels] == 0xff) {
+            break;
+        }
+    }
+    for (i = 1; i < levels; i++) {
+        if (key->priv[8 + i] != key->priv[8]) {
+            break;
+        }
+    }
+    if ((levels == 0) || (i != levels) ||
+            (wc_lms_params(&params, key->priv[8] >> 4,
+                           key->priv[8] & 0xf) != 0)) {
+        WOLFSSL_MSG("error: LmsKey private key parameters not supported");
+        key->state = WC_LMS_STATE_BAD;
+        return -1;
+    }
+    key->levels = levels;
+    key->height = (int)params.height;
+    key->winternitz = (int)params.w;
+
+    ato32(key->priv, &hi);
+    ato32(key->priv + 4, &lo);
+    key->q = ((word64)hi << 32) | lo;
+    if (key->q >= wc_hss_max_sigs(key)) {
+        WOLFSSL_MSG("error: reloaded LMS key signatures exhausted");
+        key->state = WC_LMS_STATE_NOSIGS;
+        return -1;
+    }
+
+    ret = wc_hss_load_trees(key, &params);
+    if (ret != 0) {
+        WOLFSSL_MSG("error: LmsKey tree generation failed");
+        key->state = WC_LMS_STATE_BAD;
+        return ret;
+    }
+
+    key->state = WC_LMS_STATE_OK;
+
+    return 0;
+}
+
+/* Given a levels, height, winternitz parameter set, determine
+ * the private key length */
+int wc_LmsKey_GetPrivLen(const LmsKey * key, word32 * len)
+{
+    if (key == NULL || len == NULL) {
+        return BAD_FUNC_ARG;
+    }
+
+    *len = HSS_MAX_PRIVATE_KEY_LEN;
+
+    return 0;
+}
+
+/* Sign a message with the next leaf.
+ *
+ * The private key with the number of signatures used incremented is written
+ * with the write callback before the signature is made. When the signatures
+ * of a lower level tree are used up, the next one is built and signed here.
+ *
+ * Returns 0 on success. */
+int wc_LmsKey_Sign(LmsKey* key, byte * sig, word32 * sigSz, const byte * msg,
+    int msgSz)
+{
+    int       ret = 0;
+    int       i;
+    word32    len;
+    word32    off;
+    LmsParams params;
+
+    if (key == NULL || sig == NULL || sigSz == NULL || msg == NULL) {
+        return BAD_FUNC_ARG;
+    }
+
+    if (msgSz <= 0) {
+        return BAD_FUNC_ARG;
+    }
+
+    if (key->state == WC_LMS_STATE_NOSIGS) {
+        WOLFSSL_MSG("error: LMS signatures exhausted");
+        return -1;
+    }
+    else if (key->state != WC_LMS_STATE_OK) {
+       /* The key had an error the last time it was used, and we
+        * can't guarantee its state. */
+        WOLFSSL_MSG("error: can't sign, LMS key not in good state");
+        return -1;
+    }
+
+    ret = wc_lms_key_params(key, &params);
+    if (ret != 0) {
+        key->state = WC_LMS_STATE_BAD;
+        return -1;
+    }
+
+    len = wc_hss_sig_len(&params, key->levels);
+    if (*sigSz < len) {
+        return BUFFER_E;
+    }
+
+    if (key->q >= wc_hss_max_sigs(key)) {
+        WOLFSSL_MSG("error: LMS signatures exhausted");
+        key->state = WC_LMS_STATE_NOSIGS;
+        return -1;
+    }
+
+    /* Trees for this signature: new lower level trees once the last ones
+     * are used up. */
+    ret = wc_hss_update_trees(key, &params);
+    if (ret != 0) {
+        WOLFSSL_MSG("error: LMS tree update failed");
+        key->state = WC_LMS_STATE_BAD;
+        return -1;
+    }
+
+    /* Persist the use of the leaf before the signature exists. */
+    ret = wc_hss_write_priv(key, key->q + 1);
+    if (ret != 0) {
+        return ret;
+    }
+
+    c32toa((word32)(key->levels - 1), sig);
+    off = 4;
+    for (i = 1; i < key->levels; i++) {
+        XMEMCPY(sig + off, key->tree[i].sig, params.sigLen);
+        off += params.sigLen;
+        wc_lms_tree_pub(&params, &key->tree[i], sig + off);
+        off += LMS_PUB_LEN;
+    }
+    ret = wc_lms_sign(key, &params, &key->tree[key->levels - 1],
+        wc_hss_leaf(key, key->q, key->levels - 1), msg, (word32)msgSz,
+        sig + off);
+    key->q++;
+    if (ret != 0) {
+        WOLFSSL_MSG("error: LMS signing failed");
+        key->state = WC_LMS_STATE_BAD;
+        return -1;
+    }
+
+    *sigSz = len;
+
+    return 0;
+}
+
+/* Returns 1 if there are signatures remaining.
+ * Returns 0 if available signatures are exhausted.
+ *
+ * The number of available signatures grows as
+ *   N = 2 ** (levels * height)
+ * and is capped at 2 ** 64 - 1. */
+int wc_LmsKey_SigsLeft(LmsKey * key)
+{
+    if (key == NULL) {
+        return BAD_FUNC_ARG;
+    }
+
+    if (key->q >= wc_hss_max_sigs(key)) {
+        return 0;
+    }
+
+    return 1;
+}
+
+#endif /* ifndef WOLFSSL_LMS_VERIFY_ONLY*/
+
+/* Given a levels, height, winternitz parameter set, determine
+ * the public key length */
+int wc_LmsKey_GetPubLen(const LmsKey * key, word32 * len)
+{
+    if (key == NULL || len == NULL) {
+        return BAD_FUNC_ARG;
+    }
+
+    *len = HSS_MAX_PUBLIC_KEY_LEN;
+
+    return 0;
+}
+
+/* Export a generated public key and parameter set from one LmsKey
+ * to another. Use this to prepare a signature verification LmsKey
+ * that is pub only.
+ *
+ * Though the public key is all that is used to verify signatures,
+ * the parameter set is needed to calculate the signature length
+ * before hand. */
+int wc_LmsKey_ExportPub(LmsKey * keyDst, const LmsKey * keySrc)
+{
+    if (keyDst == NULL || keySrc == NULL) {
+        return BAD_FUNC_ARG;
+    }
+
+    ForceZero(keyDst, sizeof(LmsKey));
+
+    XMEMCPY(keyDst->pub, keySrc->pub, sizeof(keySrc->pub));
+    keyDst->levels = keySrc->levels;
+    keyDst->height = keySrc->height;
+    keyDst->winternitz = keySrc->winternitz;
+    keyDst->heap = keySrc->heap;
+
+    /* Mark this key as verify only, to prevent misuse. */
+    keyDst->state = WC_LMS_STATE_VERIFYONLY;
+
+    return 0;
+}
+
+/* Exports the raw LMS public key buffer from key to out buffer.
+ * The out buffer should be large enough to hold the public key, and
+ * outLen should indicate the size of the buffer.
+ *
+ * - Returns 0 on success, and sets outLen to LMS pubLen.
+ * - Returns BUFFER_E if outLen < LMS pubLen.
+ *
+ * Call wc_LmsKey_GetPubLen beforehand to determine pubLen.
+ * */
+int wc_LmsKey_ExportPubRaw(const LmsKey * key, byte * out, word32 * outLen)
+{
+    if (key == NULL || out == NULL || outLen == NULL) {
+        return BAD_FUNC_ARG;
+    }
+
+    if (*outLen < HSS_MAX_PUBLIC_KEY_LEN) {
+        return BUFFER_E;
+    }
+
+    XMEMCPY(out, key->pub, HSS_MAX_PUBLIC_KEY_LEN);
+    *outLen = HSS_MAX_PUBLIC_KEY_LEN;
+
+    return 0;
+}
+
+/* Imports a raw public key buffer from in array to LmsKey key.
+ *
+ * The LMS parameters must be set first with wc_LmsKey_SetLmsParm or
+ * wc_LmsKey_SetParameters, and inLen must match the length returned
+ * by wc_LmsKey_GetPubLen.
+ *
+ * - Returns 0 on success.
+ * - Returns BUFFER_E if inlen != LMS pubLen.
+ *
+ * Call wc_LmsKey_GetPubLen beforehand to determine pubLen.
+ * */
+int wc_LmsKey_ImportPubRaw(LmsKey * key, const byte * in, word32 inLen)
+{
+    if (key == NULL || in == NULL) {
+        return BAD_FUNC_ARG;
+    }
+
+    if (inLen != HSS_MAX_PUBLIC_KEY_LEN) {
+        /* Something inconsistent. Parameters weren't set, or input
+         * pub key is wrong.*/
+        return BUFFER_E;
+    }
+
+    XMEMCPY(key->pub, in, HSS_MAX_PUBLIC_KEY_LEN);
+
+    return 0;
+}
+
+/* Given a levels, height, winternitz parameter set, determine
+ * the signature length.
+ *
+ * Call this before wc_LmsKey_Sign so you know the length of
+ * the required signature buffer. */
+int wc_LmsKey_GetSigLen(const LmsKey * key, word32 * len)
+{
+    LmsParams params;
+
+    if (key == NULL || len == NULL) {
+        return BAD_FUNC_ARG;
+    }
+
+    if (wc_lms_key_params(key, &params) != 0) {
+        return BAD_FUNC_ARG;
+    }
+
+    *len = wc_hss_sig_len(&params, key->levels);
+
+    return 0;
+}
+
+/* Verify an HSS signature: each level's public key is signed by the level
+ * above and the message by the lowest level.
+ *
+ * Returns 0 when the signature verifies and -1 when it doesn't. */
+int wc_LmsKey_Verify(LmsKey * key, const byte * sig, word32 sigSz,
+    const byte * msg, int msgSz)
+{
+    int         ret = 0;
+    word32      levels;
+    word32      nspk;
+    word32      off = 4;
+    word32      len;
+    word32      i;
+    const byte* pub;
+
+    if (key == NULL || sig == NULL || msg == NULL) {
+        return BAD_FUNC_ARG;
+    }
+
+    if (msgSz < 0) {
+        return BAD_FUNC_ARG;
+    }
+
+    ato32(key->pub, &levels);
+    if ((levels < LMS_MIN_LEVELS) || (levels > LMS_MAX_LEVELS) ||
+            (sigSz < 4)) {
+        return -1;
+    }
+    ato32(sig, &nspk);
+    if (nspk + 1 != levels) {
+        return -1;
+    }
+
+    pub = key->pub + 4;
+    for (i = 0; (ret == 0) && (i < nspk); i++) {
+        len = wc_lms_sig_len(sig + off, sigSz - off);
+        if ((len == 0) || (sigSz - off - len < LMS_PUB_LEN)) {
+            ret = -1;
+            break;
+        }
+        ret = wc_lms_verify(pub, sig + off, len, sig + off + len,
+            LMS_PUB_LEN, key->heap);
+        pub = sig + off + len;
+        off += len + LMS_PUB_LEN;
+    }
+    if (ret == 0) {
+        len = wc_lms_sig_len(sig + off, sigSz - off);
+        if ((len == 0) || (off + len != sigSz)) {
+            ret = -1;
+        }
+    }
+    if (ret == 0) {
+        ret = wc_lms_verify(pub, sig + off, len, msg, (word32)msgSz,
+            key->heap);
+    }
+
+    if (ret != 0) {
+        WOLFSSL_MSG("error: LMS signature verification failed");
+        if (ret != MEMORY_E) {
+            ret = -1;
+        }
+    }
+
+    return ret;
+}
+
+#endif /* WOLFSSL_HAVE_LMS && WOLFSSL_WC_LMS */
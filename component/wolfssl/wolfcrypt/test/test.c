@@ -282,6 +282,7 @@ const byte const_byte_array[] = "A+Gd\0\0\0";
 #include <wolfssl/wolfcrypt/pwdbased.h>
 #include <wolfssl/wolfcrypt/ripemd.h>
 #include <wolfssl/wolfcrypt/error-crypt.h>
+#include <wolfssl/wolfcrypt/cpuid.h>
 #ifdef HAVE_ECC
     #include <wolfssl/wolfcrypt/ecc.h>
 #endif
@@ -323,6 +324,9 @@ const byte const_byte_array[] = "A+Gd\0\0\0";
 #ifdef HAVE_LIBLMS
     #include <wolfssl/wolfcrypt/ext_lms.h>
 #endif
+#ifdef WOLFSSL_WC_LMS
+    #include <wolfssl/wolfcrypt/wc_lms.h>
+#endif
 #endif
 #ifdef WOLFCRYPT_HAVE_ECCSI
     #include <wolfssl/wolfcrypt/eccsi.h>
@@ -333,6 +337,9 @@ const byte const_byte_array[] = "A+Gd\0\0\0";
 #if defined(HAVE_BLAKE2) || defined(HAVE_BLAKE2S)
     #include <wolfssl/wolfcrypt/blake2.h>
 #endif
+#ifdef HAVE_BLAKE3
+    #include <wolfssl/wolfcrypt/blake3.h>
+#endif
 #ifdef WOLFSSL_SHA3
     #include <wolfssl/wolfcrypt/sha3.h>
 #endif
@@ -482,6 +489,13 @@ WOLFSSL_TEST_SUBROUTINE wc_test_ret_t  md4_test(void);
 WOLFSSL_TEST_SUBROUTINE wc_test_ret_t  sha_test(void);
 WOLFSSL_TEST_SUBROUTINE wc_test_ret_t  sha224_test(void);
 WOLFSSL_TEST_SUBROUTINE wc_test_ret_t  sha256_test(void);
+#if defined(HAVE_CPUID_INTEL) && defined(USE_INTEL_SPEEDUP) && \
+    (!defined(NO_SHA) || !defined(NO_SHA256))
+WOLFSSL_TEST_SUBROUTINE wc_test_ret_t  sha_ni_fallback_test(void);
+#endif
+#if !defined(NO_SHA256) && defined(WOLFSSL_SHA256_MULTI)
+WOLFSSL_TEST_SUBROUTINE wc_test_ret_t  sha256_multi_test(void);
+#endif
 WOLFSSL_TEST_SUBROUTINE wc_test_ret_t  sha512_test(void);
 #if !defined(WOLFSSL_NOSHA512_224) && \
    (!defined(HAVE_FIPS) || FIPS_VERSION_GE(5, 3)) && !defined(HAVE_SELFTEST)
@@ -495,6 +509,9 @@ WOLFSSL_TEST_SUBROUTINE wc_test_ret_t  sha384_test(void);
 WOLFSSL_TEST_SUBROUTINE wc_test_ret_t  sha3_test(void);
 WOLFSSL_TEST_SUBROUTINE wc_test_ret_t  shake128_test(void);
 WOLFSSL_TEST_SUBROUTINE wc_test_ret_t  shake256_test(void);
+#if defined(WOLFSSL_SHAKE128) || defined(WOLFSSL_SHAKE256)
+WOLFSSL_TEST_SUBROUTINE wc_test_ret_t  shake_x4_test(void);
+#endif
 WOLFSSL_TEST_SUBROUTINE wc_test_ret_t  sm3_test(void);
 WOLFSSL_TEST_SUBROUTINE wc_test_ret_t  hash_test(void);
 WOLFSSL_TEST_SUBROUTINE wc_test_ret_t  hmac_md5_test(void);
@@ -631,9 +648,14 @@ WOLFSSL_TEST_SUBROUTINE wc_test_ret_t scrypt_test(void);
 #endif
 #ifdef HAVE_BLAKE2
     WOLFSSL_TEST_SUBROUTINE wc_test_ret_t  blake2b_test(void);
+    WOLFSSL_TEST_SUBROUTINE wc_test_ret_t  blake2bp_test(void);
 #endif
 #ifdef HAVE_BLAKE2S
     WOLFSSL_TEST_SUBROUTINE wc_test_ret_t  blake2s_test(void);
+    WOLFSSL_TEST_SUBROUTINE wc_test_ret_t  blake2sp_test(void);
+#endif
+#ifdef HAVE_BLAKE3
+    WOLFSSL_TEST_SUBROUTINE wc_test_ret_t  blake3_test(void);
 #endif
 #ifdef HAVE_LIBZ
     WOLFSSL_TEST_SUBROUTINE wc_test_ret_t compress_test(void);
@@ -1172,6 +1194,21 @@ options: [-s max_relative_stack_bytes] [-m max_relative_heap_memory_bytes]\n\
         TEST_PASS("SHA-256  test passed!\n");
 #endif
 
+#if defined(HAVE_CPUID_INTEL) && defined(USE_INTEL_SPEEDUP) && \
+    (!defined(NO_SHA) || !defined(NO_SHA256))
+    if ( (ret = sha_ni_fallback_test()) != 0)
+        TEST_FAIL("SHA-NI   test failed!\n", ret);
+    else
+        TEST_PASS("SHA-NI   test passed!\n");
+#endif
+
+#if !defined(NO_SHA256) && defined(WOLFSSL_SHA256_MULTI)
+    if ( (ret = sha256_multi_test()) != 0)
+        TEST_FAIL("SHA-256 multi test failed!\n", ret);
+    else
+        TEST_PASS("SHA-256 multi test passed!\n");
+#endif
+
 #ifdef WOLFSSL_SHA384
     if ( (ret = sha384_test()) != 0)
         TEST_FAIL("SHA-384  test failed!\n", ret);
@@ -1228,6 +1265,13 @@ options: [-s max_relative_stack_bytes] [-m max_relative_heap_memory_bytes]\n\
         TEST_PASS("SHAKE256 test passed!\n");
 #endif
 
+#if defined(WOLFSSL_SHAKE128) || defined(WOLFSSL_SHAKE256)
+    if ( (ret = shake_x4_test()) != 0)
+        TEST_FAIL("SHAKE x4 test failed!\n", ret);
+    else
+        TEST_PASS("SHAKE x4 test passed!\n");
+#endif
+
 #ifdef WOLFSSL_SM3
     if ( (ret = sm3_test()) != 0)
         return err_sys("SM-3     test failed!\n", ret);
@@ -1254,12 +1298,26 @@ options: [-s max_relative_stack_bytes] [-m max_relative_heap_memory_bytes]\n\
         TEST_FAIL("BLAKE2b  test failed!\n", ret);
     else
         TEST_PASS("BLAKE2b  test passed!\n");
+    if ( (ret = blake2bp_test()) != 0)
+        TEST_FAIL("BLAKE2bp test failed!\n", ret);
+    else
+        TEST_PASS("BLAKE2bp test passed!\n");
 #endif
 #ifdef HAVE_BLAKE2S
     if ( (ret = blake2s_test()) != 0)
         TEST_FAIL("BLAKE2s  test failed!\n", ret);
     else
         TEST_PASS("BLAKE2s  test passed!\n");
+    if ( (ret = blake2sp_test()) != 0)
+        TEST_FAIL("BLAKE2sp test failed!\n", ret);
+    else
+        TEST_PASS("BLAKE2sp test passed!\n");
+#endif
+#ifdef HAVE_BLAKE3
+    if ( (ret = blake3_test()) != 0)
+        TEST_FAIL("BLAKE3   test failed!\n", ret);
+    else
+        TEST_PASS("BLAKE3   test passed!\n");
 #endif
 
 #ifndef NO_HMAC
@@ -2972,6 +3030,147 @@ WOLFSSL_TEST_SUBROUTINE wc_test_ret_t blake2b_test(void)
 
     return 0;
 }
+
+#define BLAKE2BP_TESTS 4
+
+/* BLAKE2bp of the bytes 0, 1, 2, ... with the key 0, 1, 2, ... for the first
+ * two lengths and no key for the last two. */
+static const word32 blake2bp_len[BLAKE2BP_TESTS] = { 0, 255, 513, 1000 };
+static const byte blake2bp_vec[BLAKE2BP_TESTS][BLAKE2B_OUTBYTES] =
+{
+  {
+    0x9d, 0x94, 0x61, 0x07, 0x3e, 0x4e, 0xb6, 0x40,
+    0xa2, 0x55, 0x35, 0x7b, 0x83, 0x9f, 0x39, 0x4b,
+    0x83, 0x8c, 0x6f, 0xf5, 0x7c, 0x9b, 0x68, 0x6a,
+    0x3f, 0x76, 0x10, 0x7c, 0x10, 0x66, 0x72, 0x8f,
+    0x3c, 0x99, 0x56, 0xbd, 0x78, 0x5c, 0xbc, 0x3b,
+    0xf7, 0x9d, 0xc2, 0xab, 0x57, 0x8c, 0x5a, 0x0c,
+    0x06, 0x3b, 0x9d, 0x9c, 0x40, 0x58, 0x48, 0xde,
+    0x1d, 0xbe, 0x82, 0x1c, 0xd0, 0x5c, 0x94, 0x0a
+  },
+  {
+    0x96, 0xfb, 0xcb, 0xb6, 0x0b, 0xd3, 0x13, 0xb8,
+    0x84, 0x50, 0x33, 0xe5, 0xbc, 0x05, 0x8a, 0x38,
+    0x02, 0x74, 0x38, 0x57, 0x2d, 0x7e, 0x79, 0x57,
+    0xf3, 0x68, 0x4f, 0x62, 0x68, 0xaa, 0xdd, 0x3a,
+    0xd0, 0x8d, 0x21, 0x76, 0x7e, 0xd6, 0x87, 0x86,
+    0x85, 0x33, 0x1b, 0xa9, 0x85, 0x71, 0x48, 0x7e,
+    0x12, 0x47, 0x0a, 0xad, 0x66, 0x93, 0x26, 0x71,
+    0x6e, 0x46, 0x66, 0x7f, 0x69, 0xf8, 0xd7, 0xe8
+  },
+  {
+    0xcd, 0x79, 0xfb, 0xbd, 0xed, 0x91, 0x82, 0x32,
+    0x72, 0xab, 0xb7, 0xa9, 0x7a, 0x55, 0x30, 0x60,
+    0x8f, 0x05, 0x83, 0xbd, 0x54, 0x05, 0xc7, 0x76,
+    0x51, 0x56, 0xc4, 0xd8, 0x75, 0x4d, 0xdf, 0x43,
+    0x5d, 0x6d, 0x71, 0xb8, 0x4f, 0x83, 0xc6, 0x38,
+    0x10, 0x78, 0x93, 0x5e, 0x37, 0x8d, 0x4b, 0xf0,
+    0xf7, 0x52, 0xb3, 0x09, 0xd1, 0x39, 0x8a, 0xf5,
+    0x78, 0xe1, 0x03, 0xe4, 0x43, 0xb8, 0xac, 0x55
+  },
+  {
+    0x1c, 0xe5, 0xb8, 0xd6, 0xf6, 0xfc, 0xc8, 0x9f,
+    0xcb, 0x6e, 0xd2, 0x9f, 0x12, 0x79, 0x6c, 0xc2,
+    0x10, 0xa0, 0x3f, 0x47, 0x63, 0xe5, 0x28, 0xcb,
+    0x2c, 0x0e, 0x1b, 0x4b, 0x12, 0x55, 0xd6, 0xae,
+    0x86, 0xc7, 0x93, 0x32, 0x52, 0x9f, 0x63, 0x68,
+    0xd0, 0xbc, 0xfe, 0x9d, 0x31, 0x6a, 0x5f, 0x99,
+    0x9a, 0x53, 0xaf, 0x47, 0xa8, 0xf0, 0xec, 0x44,
+    0x12, 0xce, 0x19, 0x15, 0x6b, 0xba, 0xfd, 0x04
+  }
+};
+
+static wc_test_ret_t blake2bp_test_vec(const byte* input)
+{
+    static const word32 chunk[] = { 1000, 1, 13, 128, 600 };
+    Blake2bp b2bp;
+    byte    key[BLAKE2B_KEYBYTES];
+    byte    digest[BLAKE2B_OUTBYTES];
+    word32  i, j, k, sz;
+    int     ret;
+
+    for (i = 0; i < (word32)sizeof(key); i++)
+        key[i] = (byte)i;
+
+    for (i = 0; i < BLAKE2BP_TESTS; i++) {
+        /* Feed the message in pieces that do and do not line up with the
+         * blocks and the strides of the leaves. */
+        for (j = 0; j < sizeof(chunk) / sizeof(chunk[0]); j++) {
+            if (i < 2)
+                ret = wc_InitBlake2bp_WithKey(&b2bp, BLAKE2B_OUTBYTES, key,
+                                              sizeof(key));
+            else
+                ret = wc_InitBlake2bp(&b2bp, BLAKE2B_OUTBYTES);
+            if (ret != 0)
+                return WC_TEST_RET_ENC_I(i);
+
+            for (k = 0; k < blake2bp_len[i]; k += sz) {
+                sz = blake2bp_len[i] - k;
+                if (sz > chunk[j])
+                    sz = chunk[j];
+                ret = wc_Blake2bpUpdate(&b2bp, input + k, sz);
+                if (ret != 0)
+                    return WC_TEST_RET_ENC_I(i);
+            }
+
+            ret = wc_Blake2bpFinal(&b2bp, digest, 0);
+            if (ret != 0)
+                return WC_TEST_RET_ENC_I(i);
+
+            if (XMEMCMP(digest, blake2bp_vec[i], BLAKE2B_OUTBYTES) != 0)
+                return WC_TEST_RET_ENC_I(i);
+        }
+    }
+
+    return 0;
+}
+
+WOLFSSL_TEST_SUBROUTINE wc_test_ret_t blake2bp_test(void)
+{
+    wc_test_ret_t ret;
+    Blake2bp b2bp;
+    byte    digest[BLAKE2B_OUTBYTES];
+    byte    input[1000];
+    word32  i;
+#if defined(HAVE_CPUID_INTEL) && defined(USE_INTEL_SPEEDUP)
+    word32  flags = cpuid_get_flags();
+#endif
+
+    for (i = 0; i < (word32)sizeof(input); i++)
+        input[i] = (byte)i;
+
+    ret = blake2bp_test_vec(input);
+    if (ret != 0)
+        return ret;
+
+    if (wc_InitBlake2bp(NULL, BLAKE2B_OUTBYTES) != BAD_FUNC_ARG)
+        return WC_TEST_RET_ENC_NC;
+    if (wc_InitBlake2bp(&b2bp, BLAKE2B_OUTBYTES + 1) != BAD_FUNC_ARG)
+        return WC_TEST_RET_ENC_NC;
+    if (wc_InitBlake2bp(&b2bp, BLAKE2B_OUTBYTES) != 0)
+        return WC_TEST_RET_ENC_NC;
+    if (wc_Blake2bpUpdate(&b2bp, NULL, 1) != BAD_FUNC_ARG)
+        return WC_TEST_RET_ENC_NC;
+    if (wc_Blake2bpFinal(&b2bp, NULL, 0) != BAD_FUNC_ARG)
+        return WC_TEST_RET_ENC_NC;
+    if (wc_Blake2bpFinal(&b2bp, digest, BLAKE2B_OUTBYTES + 1) !=
+            BAD_FUNC_ARG) {
+        return WC_TEST_RET_ENC_NC;
+    }
+
+#if defined(HAVE_CPUID_INTEL) && defined(USE_INTEL_SPEEDUP)
+    /* The tests above ran the AVX2 compression, run them again in C. */
+    if (IS_INTEL_AVX2(flags)) {
+        cpuid_clear_flag(CPUID_AVX2);
+        ret = blake2b_test();
+        if (ret == 0)
+            ret = blake2bp_test_vec(input);
+        cpuid_select_flags(flags);
+    }
+#endif
+
+    return ret;
+}
 #endif /* HAVE_BLAKE2 */
 
 #ifdef HAVE_BLAKE2S
@@ -3033,8 +3232,489 @@ WOLFSSL_TEST_SUBROUTINE wc_test_ret_t blake2s_test(void)
 
     return 0;
 }
+
+#define BLAKE2SP_TESTS 4
+
+/* BLAKE2sp of the bytes 0, 1, 2, ... with the key 0, 1, 2, ... for the first
+ * two lengths and no key for the last two. */
+static const word32 blake2sp_len[BLAKE2SP_TESTS] = { 0, 255, 513, 1000 };
+static const byte blake2sp_vec[BLAKE2SP_TESTS][BLAKE2S_OUTBYTES] =
+{
+  {
+    0x71, 0x5c, 0xb1, 0x38, 0x95, 0xae, 0xb6, 0x78,
+    0xf6, 0x12, 0x41, 0x60, 0xbf, 0xf2, 0x14, 0x65,
+    0xb3, 0x0f, 0x4f, 0x68, 0x74, 0x19, 0x3f, 0xc8,
+    0x51, 0xb4, 0x62, 0x10, 0x43, 0xf0, 0x9c, 0xc6
+  },
+  {
+    0x0c, 0x8a, 0x36, 0x59, 0x7d, 0x74, 0x61, 0xc6,
+    0x3a, 0x94, 0x73, 0x28, 0x21, 0xc9, 0x41, 0x85,
+    0x6c, 0x66, 0x83, 0x76, 0x60, 0x6c, 0x86, 0xa5,
+    0x2d, 0xe0, 0xee, 0x41, 0x04, 0xc6, 0x15, 0xdb
+  },
+  {
+    0x13, 0x36, 0x62, 0x8c, 0x7f, 0x15, 0x41, 0xc7,
+    0x81, 0x5f, 0xc0, 0xff, 0x1f, 0xb5, 0xdf, 0xb0,
+    0x7a, 0x85, 0xcf, 0x5a, 0x17, 0xa2, 0x87, 0x2a,
+    0x3c, 0xe4, 0xb3, 0x22, 0xd4, 0xa0, 0x3d, 0x0b
+  },
+  {
+    0x7e, 0x28, 0x30, 0xf7, 0x4f, 0xc7, 0xc4, 0xd2,
+    0x24, 0xa2, 0x01, 0xb4, 0x6f, 0x95, 0xe3, 0x7e,
+    0xbb, 0xfb, 0x56, 0xdd, 0xdc, 0x49, 0x2f, 0x82,
+    0x27, 0xe4, 0xd9, 0x05, 0x20, 0x17, 0x34, 0xb8
+  }
+};
+
+static wc_test_ret_t blake2sp_test_vec(const byte* input)
+{
+    static const word32 chunk[] = { 1000, 1, 13, 64, 600 };
+    Blake2sp b2sp;
+    byte    key[BLAKE2S_KEYBYTES];
+    byte    digest[BLAKE2S_OUTBYTES];
+    word32  i, j, k, sz;
+    int     ret;
+
+    for (i = 0; i < (word32)sizeof(key); i++)
+        key[i] = (byte)i;
+
+    for (i = 0; i < BLAKE2SP_TESTS; i++) {
+        /* Feed the message in pieces that do and do not line up with the
+         * blocks and the strides of the leaves. */
+        for (j = 0; j < sizeof(chunk) / sizeof(chunk[0]); j++) {
+            if (i < 2)
+                ret = wc_InitBlake2sp_WithKey(&b2sp, BLAKE2S_OUTBYTES, key,
+                                              sizeof(key));
+            else
+                ret = wc_InitBlake2sp(&b2sp, BLAKE2S_OUTBYTES);
+            if (ret != 0)
+                return WC_TEST_RET_ENC_I(i);
+
+            for (k = 0; k < blake2sp_len[i]; k += sz) {
+                sz = blake2sp_len[i] - k;
+                if (sz > chunk[j])
+                    sz = chunk[j];
+                ret = wc_Blake2spUpdate(&b2sp, input + k, sz);
+                if (ret != 0)
+                    return WC_TEST_RET_ENC_I(i);
+            }
+
+            ret = wc_Blake2spFinal(&b2sp, digest, 0);
+            if (ret != 0)
+                return WC_TEST_RET_ENC_I(i);
+
+            if (XMEMCMP(digest, blake2sp_vec[i], BLAKE2S_OUTBYTES) != 0)
+                return WC_TEST_RET_ENC_I(i);
+        }
+    }
+
+    return 0;
+}
+
+WOLFSSL_TEST_SUBROUTINE wc_test_ret_t blake2sp_test(void)
+{
+    wc_test_ret_t ret;
+    Blake2sp b2sp;
+    byte    digest[BLAKE2S_OUTBYTES];
+    byte    input[1000];
+    word32  i;
+#if defined(HAVE_CPUID_INTEL) && defined(USE_INTEL_SPEEDUP)
+    word32  flags = cpuid_get_flags();
+#endif
+
+    for (i = 0; i < (word32)sizeof(input); i++)
+        input[i] = (byte)i;
+
+    ret = blake2sp_test_vec(input);
+    if (ret != 0)
+        return ret;
+
+    if (wc_InitBlake2sp(NULL, BLAKE2S_OUTBYTES) != BAD_FUNC_ARG)
+        return WC_TEST_RET_ENC_NC;
+    if (wc_InitBlake2sp(&b2sp, BLAKE2S_OUTBYTES + 1) != BAD_FUNC_ARG)
+        return WC_TEST_RET_ENC_NC;
+    if (wc_InitBlake2sp(&b2sp, BLAKE2S_OUTBYTES) != 0)
+        return WC_TEST_RET_ENC_NC;
+    if (wc_Blake2spUpdate(&b2sp, NULL, 1) != BAD_FUNC_ARG)
+        return WC_TEST_RET_ENC_NC;
+    if (wc_Blake2spFinal(&b2sp, NULL, 0) != BAD_FUNC_ARG)
+        return WC_TEST_RET_ENC_NC;
+    if (wc_Blake2spFinal(&b2sp, digest, BLAKE2S_OUTBYTES + 1) !=
+            BAD_FUNC_ARG) {
+        return WC_TEST_RET_ENC_NC;
+    }
+
+#if defined(HAVE_CPUID_INTEL) && defined(USE_INTEL_SPEEDUP)
+    /* The tests above ran the AVX1 compression, run them again in C. */
+    if (IS_INTEL_AVX1(flags)) {
+        cpuid_clear_flag(CPUID_AVX1);
+        ret = blake2s_test();
+        if (ret == 0)
+            ret = blake2sp_test_vec(input);
+        cpuid_select_flags(flags);
+    }
+#endif
+
+    return ret;
+}
 #endif /* HAVE_BLAKE2S */
 
+#ifdef HAVE_BLAKE3
+
+#define BLAKE3_TESTS 8
+
+/* Official test vectors: the input is the bytes 0, 1, ..., 250, 0, 1, ...
+ * hashed, hashed with blake3_test_key and with keys derived from
+ * blake3_test_context. */
+static const word32 blake3_test_len[BLAKE3_TESTS] = {
+    0, 1, 1024, 1025, 2049, 8193, 31744, 102400
+};
+static const byte blake3_hash_vec[BLAKE3_TESTS][BLAKE3_OUTBYTES] =
+{
+  {
+    0xaf, 0x13, 0x49, 0xb9, 0xf5, 0xf9, 0xa1, 0xa6,
+    0xa0, 0x40, 0x4d, 0xea, 0x36, 0xdc, 0xc9, 0x49,
+    0x9b, 0xcb, 0x25, 0xc9, 0xad, 0xc1, 0x12, 0xb7,
+    0xcc, 0x9a, 0x93, 0xca, 0xe4, 0x1f, 0x32, 0x62
+  },
+  {
+    0x2d, 0x3a, 0xde, 0xdf, 0xf1, 0x1b, 0x61, 0xf1,
+    0x4c, 0x88, 0x6e, 0x35, 0xaf, 0xa0, 0x36, 0x73,
+    0x6d, 0xcd, 0x87, 0xa7, 0x4d, 0x27, 0xb5, 0xc1,
+    0x51, 0x02, 0x25, 0xd0, 0xf5, 0x92, 0xe2, 0x13
+  },
+  {
+    0x42, 0x21, 0x47, 0x39, 0xf0, 0x95, 0xa4, 0x06,
+    0xf3, 0xfc, 0x83, 0xde, 0xb8, 0x89, 0x74, 0x4a,
+    0xc0, 0x0d, 0xf8, 0x31, 0xc1, 0x0d, 0xaa, 0x55,
+    0x18, 0x9b, 0x5d, 0x12, 0x1c, 0x85, 0x5a, 0xf7
+  },
+  {
+    0xd0, 0x02, 0x78, 0xae, 0x47, 0xeb, 0x27, 0xb3,
+    0x4f, 0xae, 0xcf, 0x67, 0xb4, 0xfe, 0x26, 0x3f,
+    0x82, 0xd5, 0x41, 0x29, 0x16, 0xc1, 0xff, 0xd9,
+    0x7c, 0x8c, 0xb7, 0xfb, 0x81, 0x4b, 0x84, 0x44
+  },
+  {
+    0x5f, 0x4d, 0x72, 0xf4, 0x0d, 0x7a, 0x5f, 0x82,
+    0xb1, 0x5c, 0xa2, 0xb2, 0xe4, 0x4b, 0x1d, 0xe3,
+    0xc2, 0xef, 0x86, 0xc4, 0x26, 0xc9, 0x5c, 0x1a,
+    0xf0, 0xb6, 0x87, 0x95, 0x22, 0x56, 0x30, 0x30
+  },
+  {
+    0xba, 0xb6, 0xc0, 0x9c, 0xb8, 0xce, 0x8c, 0xf4,
+    0x59, 0x26, 0x13, 0x98, 0xd2, 0xe7, 0xae, 0xf3,
+    0x57, 0x00, 0xbf, 0x48, 0x81, 0x16, 0xce, 0xb9,
+    0x4a, 0x36, 0xd0, 0xf5, 0xf1, 0xb7, 0xbc, 0x3b
+  },
+  {
+    0x62, 0xb6, 0x96, 0x0e, 0x1a, 0x44, 0xbc, 0xc1,
+    0xeb, 0x1a, 0x61, 0x1a, 0x8d, 0x62, 0x35, 0xb6,
+    0xb4, 0xb7, 0x8f, 0x32, 0xe7, 0xab, 0xc4, 0xfb,
+    0x4c, 0x6c, 0xdc, 0xce, 0x94, 0x89, 0x5c, 0x47
+  },
+  {
+    0xbc, 0x3e, 0x3d, 0x41, 0xa1, 0x14, 0x6b, 0x06,
+    0x9a, 0xbf, 0xfa, 0xd3, 0xc0, 0xd4, 0x48, 0x60,
+    0xcf, 0x66, 0x43, 0x90, 0xaf, 0xce, 0x4d, 0x96,
+    0x61, 0xf7, 0x90, 0x2e, 0x79, 0x43, 0xe0, 0x85
+  }
+};
+static const byte blake3_keyed_vec[BLAKE3_TESTS][BLAKE3_OUTBYTES] =
+{
+  {
+    0x92, 0xb2, 0xb7, 0x56, 0x04, 0xed, 0x3c, 0x76,
+    0x1f, 0x9d, 0x6f, 0x62, 0x39, 0x2c, 0x8a, 0x92,
+    0x27, 0xad, 0x0e, 0xa3, 0xf0, 0x95, 0x73, 0xe7,
+    0x83, 0xf1, 0x49, 0x8a, 0x4e, 0xd6, 0x0d, 0x26
+  },
+  {
+    0x6d, 0x78, 0x78, 0xdf, 0xff, 0x2f, 0x48, 0x56,
+    0x35, 0xd3, 0x90, 0x13, 0x27, 0x8a, 0xe1, 0x4f,
+    0x14, 0x54, 0xb8, 0xc0, 0xa3, 0xa2, 0xd3, 0x4b,
+    0xc1, 0xab, 0x38, 0x22, 0x8a, 0x80, 0xc9, 0x5b
+  },
+  {
+    0x75, 0xc4, 0x6f, 0x6f, 0x3d, 0x9e, 0xb4, 0xf5,
+    0x5e, 0xca, 0xae, 0xe4, 0x80, 0xdb, 0x73, 0x2e,
+    0x6c, 0x21, 0x05, 0x54, 0x6f, 0x1e, 0x67, 0x50,
+    0x03, 0x68, 0x7c, 0x31, 0x71, 0x9c, 0x7b, 0xa4
+  },
+  {
+    0x35, 0x7d, 0xc5, 0x5d, 0xe0, 0xc7, 0xe3, 0x82,
+    0xc9, 0x00, 0xfd, 0x6e, 0x32, 0x0a, 0xcc, 0x04,
+    0x14, 0x6b, 0xe0, 0x1d, 0xb6, 0xa8, 0xce, 0x72,
+    0x10, 0xb7, 0x18, 0x9b, 0xd6, 0x64, 0xea, 0x69
+  },
+  {
+    0x9f, 0x29, 0x70, 0x09, 0x02, 0xf7, 0xc8, 0x6e,
+    0x51, 0x4d, 0xdc, 0x4d, 0xf1, 0xe3, 0x04, 0x9f,
+    0x25, 0x8b, 0x24, 0x72, 0xb6, 0xdd, 0x52, 0x67,
+    0xf6, 0x1b, 0xf1, 0x39, 0x83, 0xb7, 0x8d, 0xd5
+  },
+  {
+    0x95, 0x4a, 0x2a, 0x75, 0x42, 0x0c, 0x8d, 0x65,
+    0x47, 0xe3, 0xba, 0x5b, 0x98, 0xd9, 0x63, 0xe6,
+    0xfa, 0x64, 0x91, 0xad, 0xdc, 0x8c, 0x02, 0x31,
+    0x89, 0xcc, 0x51, 0x98, 0x21, 0xb4, 0xa1, 0xf5
+  },
+  {
+    0xef, 0xa5, 0x3b, 0x38, 0x9a, 0xb6, 0x7c, 0x59,
+    0x3d, 0xba, 0x62, 0x4d, 0x89, 0x8d, 0x0f, 0x73,
+    0x53, 0xab, 0x99, 0xe4, 0xac, 0x9d, 0x42, 0x30,
+    0x2e, 0xe6, 0x4c, 0xbf, 0x99, 0x39, 0xa4, 0x19
+  },
+  {
+    0x1c, 0x35, 0xd1, 0xa5, 0x81, 0x10, 0x83, 0xfd,
+    0x71, 0x19, 0xf5, 0xd5, 0xd1, 0xba, 0x02, 0x7b,
+    0x4d, 0x01, 0xc0, 0xc6, 0xc4, 0x9f, 0xb6, 0xff,
+    0x2c, 0xf7, 0x53, 0x93, 0xea, 0x5d, 0xb4, 0xa7
+  }
+};
+static const byte blake3_derive_vec[BLAKE3_TESTS][BLAKE3_OUTBYTES] =
+{
+  {
+    0x2c, 0xc3, 0x97, 0x83, 0xc2, 0x23, 0x15, 0x4f,
+    0xea, 0x8d, 0xfb, 0x7c, 0x1b, 0x16, 0x60, 0xf2,
+    0xac, 0x2d, 0xcb, 0xd1, 0xc1, 0xde, 0x82, 0x77,
+    0xb0, 0xb0, 0xdd, 0x39, 0xb7, 0xe5, 0x0d, 0x7d
+  },
+  {
+    0xb3, 0xe2, 0xe3, 0x40, 0xa1, 0x17, 0xa4, 0x99,
+    0xc6, 0xcf, 0x23, 0x98, 0xa1, 0x9e, 0xe0, 0xd2,
+    0x9c, 0xca, 0x2b, 0xb7, 0x40, 0x4c, 0x73, 0x06,
+    0x33, 0x82, 0x69, 0x3b, 0xf6, 0x6c, 0xb0, 0x6c
+  },
+  {
+    0x73, 0x56, 0xcd, 0x77, 0x20, 0xd5, 0xb6, 0x6b,
+    0x6d, 0x06, 0x97, 0xeb, 0x31, 0x77, 0xd9, 0xf8,
+    0xd7, 0x3a, 0x4a, 0x5c, 0x5e, 0x96, 0x88, 0x96,
+    0xeb, 0x6a, 0x68, 0x96, 0x84, 0x30, 0x27, 0x06
+  },
+  {
+    0xef, 0xfa, 0xa2, 0x45, 0xf0, 0x65, 0xfb, 0xf8,
+    0x2a, 0xc1, 0x86, 0x83, 0x9a, 0x24, 0x97, 0x07,
+    0xc3, 0xbd, 0xdf, 0x6d, 0x3f, 0xdd, 0xa2, 0x2d,
+    0x1b, 0x95, 0xa3, 0xc9, 0x70, 0x37, 0x9b, 0xcb
+  },
+  {
+    0x2e, 0xa4, 0x77, 0xc5, 0x51, 0x5c, 0xc3, 0xdd,
+    0x60, 0x65, 0x12, 0xee, 0x72, 0xbb, 0x3e, 0x0e,
+    0x75, 0x8c, 0xfa, 0xe7, 0x23, 0x28, 0x26, 0xf3,
+    0x5f, 0xb9, 0x8c, 0xa1, 0xbc, 0xbd, 0xf2, 0x73
+  },
+  {
+    0xaf, 0x1e, 0x03, 0x46, 0xe3, 0x89, 0xb1, 0x7c,
+    0x23, 0x20, 0x02, 0x70, 0xa6, 0x4a, 0xa4, 0xe1,
+    0xea, 0xd9, 0x8c, 0x61, 0x69, 0x5d, 0x91, 0x7d,
+    0xe7, 0xd5, 0xb0, 0x04, 0x91, 0xc9, 0xb0, 0xf1
+  },
+  {
+    0x39, 0x77, 0x2a, 0xef, 0x80, 0xe0, 0xeb, 0xe6,
+    0x05, 0x96, 0x36, 0x1e, 0x45, 0xb0, 0x61, 0xe8,
+    0xf4, 0x17, 0x42, 0x9d, 0x52, 0x91, 0x71, 0xb6,
+    0x76, 0x44, 0x68, 0xc2, 0x29, 0x28, 0xe2, 0x8e
+  },
+  {
+    0x46, 0x52, 0xcf, 0xf7, 0xa3, 0xf3, 0x85, 0xa6,
+    0x10, 0x3b, 0x5c, 0x26, 0x0f, 0xc1, 0x59, 0x3e,
+    0x13, 0xc7, 0x78, 0xdb, 0xe6, 0x08, 0xef, 0xb0,
+    0x92, 0xfe, 0x7e, 0xe6, 0x9d, 0xf6, 0xe9, 0xc6
+  }
+};
+/* 131 bytes of output from hashing the 1025 byte input */
+static const byte blake3_xof_vec[131] =
+{
+    0xd0, 0x02, 0x78, 0xae, 0x47, 0xeb, 0x27, 0xb3,
+    0x4f, 0xae, 0xcf, 0x67, 0xb4, 0xfe, 0x26, 0x3f,
+    0x82, 0xd5, 0x41, 0x29, 0x16, 0xc1, 0xff, 0xd9,
+    0x7c, 0x8c, 0xb7, 0xfb, 0x81, 0x4b, 0x84, 0x44,
+    0xf4, 0xc4, 0xa2, 0x2b, 0x4b, 0x39, 0x91, 0x55,
+    0x35, 0x8a, 0x99, 0x4e, 0x52, 0xbf, 0x25, 0x5d,
+    0xe6, 0x00, 0x35, 0x74, 0x2e, 0xc7, 0x1b, 0xd0,
+    0x8a, 0xc2, 0x75, 0xa1, 0xb5, 0x1c, 0xc6, 0xbf,
+    0xe3, 0x32, 0xb0, 0xef, 0x84, 0xb4, 0x09, 0x10,
+    0x8c, 0xda, 0x08, 0x0e, 0x62, 0x69, 0xed, 0x4b,
+    0x3e, 0x2c, 0x3f, 0x7d, 0x72, 0x2a, 0xa4, 0xcd,
+    0xc9, 0x8d, 0x16, 0xde, 0xb5, 0x54, 0xe5, 0x62,
+    0x7b, 0xe8, 0xf9, 0x55, 0xc9, 0x8e, 0x1d, 0x5f,
+    0x95, 0x65, 0xa9, 0x19, 0x4c, 0xad, 0x0c, 0x42,
+    0x85, 0xf9, 0x37, 0x00, 0x06, 0x2d, 0x95, 0x95,
+    0xad, 0xb9, 0x92, 0xae, 0x68, 0xff, 0x12, 0x80,
+    0x0a, 0xb6, 0x7a
+};
+
+/* Hash the input, fed in pieces of chunk bytes, in each mode. */
+static wc_test_ret_t blake3_test_vec(const byte* input, word32 chunk)
+{
+    static const char blake3_test_key[] = "whats the Elvish word for friend";
+    static const char blake3_test_context[] =
+        "BLAKE3 2019-12-27 16:29:52 test vectors context";
+    Blake3  b3;
+    byte    digest[BLAKE3_OUTBYTES];
+    const byte* vec = NULL;
+    word32  i, k, sz;
+    int     mode, ret = 0;
+
+    for (mode = 0; mode < 3; mode++) {
+        for (i = 0; i < BLAKE3_TESTS; i++) {
+            if (mode == 0) {
+                ret = wc_InitBlake3(&b3, BLAKE3_OUTBYTES);
+                vec = blake3_hash_vec[i];
+            }
+            else if (mode == 1) {
+                ret = wc_InitBlake3_WithKey(&b3, BLAKE3_OUTBYTES,
+                    (const byte*)blake3_test_key, BLAKE3_KEYBYTES);
+                vec = blake3_keyed_vec[i];
+            }
+            else {
+                ret = wc_InitBlake3_DeriveKey(&b3, BLAKE3_OUTBYTES,
+                    (const byte*)blake3_test_context,
+                    (word32)XSTRLEN(blake3_test_context));
+                vec = blake3_derive_vec[i];
+            }
+            if (ret != 0)
+                return WC_TEST_RET_ENC_I(i);
+
+            for (k = 0; k < blake3_test_len[i]; k += sz) {
+                sz = blake3_test_len[i] - k;
+                if (sz > chunk)
+                    sz = chunk;
+                ret = wc_Blake3Update(&b3, input + k, sz);
+                if (ret != 0)
+                    return WC_TEST_RET_ENC_I(i);
+            }
+
+            ret = wc_Blake3Final(&b3, digest, 0);
+            if (ret != 0)
+                return WC_TEST_RET_ENC_I(i);
+            if (XMEMCMP(digest, vec, BLAKE3_OUTBYTES) != 0)
+                return WC_TEST_RET_ENC_I(i);
+        }
+    }
+
+    return 0;
+}
+
+static wc_test_ret_t blake3_test_all(const byte* input)
+{
+    static const word32 chunk[] = { 102400, 13, 1000, 5000 };
+    wc_test_ret_t ret = 0;
+    word32 j;
+
+    for (j = 0; (ret == 0) && (j < sizeof(chunk) / sizeof(chunk[0])); j++)
+        ret = blake3_test_vec(input, chunk[j]);
+
+    return ret;
+}
+
+WOLFSSL_TEST_SUBROUTINE wc_test_ret_t blake3_test(void)
+{
+    wc_test_ret_t ret;
+    Blake3  b3;
+    byte    out[sizeof(blake3_xof_vec)];
+    byte*   input;
+    word32  i;
+#if defined(HAVE_CPUID_INTEL) && defined(USE_INTEL_SPEEDUP)
+    word32  flags = cpuid_get_flags();
+#endif
+
+    input = (byte*)XMALLOC(102400, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+    if (input == NULL)
+        return WC_TEST_RET_ENC_ERRNO;
+    for (i = 0; i < 102400; i++)
+        input[i] = (byte)(i % 251);
+
+    ret = blake3_test_all(input);
+#if defined(HAVE_CPUID_INTEL) && defined(USE_INTEL_SPEEDUP)
+    /* The tests above hashed 8 chunks at a time, now 4 and then 1. */
+    if ((ret == 0) && IS_INTEL_AVX2(flags)) {
+        cpuid_clear_flag(CPUID_AVX2);
+        ret = blake3_test_all(input);
+    }
+    if ((ret == 0) && IS_INTEL_AVX1(flags)) {
+        cpuid_clear_flag(CPUID_AVX2);
+        cpuid_clear_flag(CPUID_AVX1);
+        ret = blake3_test_all(input);
+    }
+    cpuid_select_flags(flags);
+#endif
+
+    /* Extendable output, all at once and from part way in. */
+    if (ret == 0) {
+        ret = wc_InitBlake3(&b3, sizeof(out));
+        if (ret == 0)
+            ret = wc_Blake3Update(&b3, input, 1025);
+        if (ret == 0)
+            ret = wc_Blake3Final(&b3, out, 0);
+        if (ret != 0)
+            ret = WC_TEST_RET_ENC_EC(ret);
+        else if (XMEMCMP(out, blake3_xof_vec, sizeof(out)) != 0)
+            ret = WC_TEST_RET_ENC_NC;
+    }
+    for (i = 1; (ret == 0) && (i < (word32)sizeof(out)); i += 21) {
+        ret = wc_Blake3FinalXof(&b3, i, out, (word32)sizeof(out) - i);
+        if (ret != 0)
+            ret = WC_TEST_RET_ENC_EC(ret);
+        else if (XMEMCMP(out, blake3_xof_vec + i, sizeof(out) - i) != 0)
+            ret = WC_TEST_RET_ENC_I(i);
+    }
+
+    if (ret == 0) {
+        if (wc_InitBlake3(NULL, BLAKE3_OUTBYTES) != BAD_FUNC_ARG)
+            ret = WC_TEST_RET_ENC_NC;
+        else if (wc_InitBlake3_WithKey(&b3, BLAKE3_OUTBYTES, input,
+                BLAKE3_KEYBYTES - 1) != BAD_FUNC_ARG)
+            ret = WC_TEST_RET_ENC_NC;
+        else if (wc_Blake3Update(&b3, NULL, 1) != BAD_FUNC_ARG)
+            ret = WC_TEST_RET_ENC_NC;
+        else if (wc_Blake3Final(&b3, NULL, 0) != BAD_FUNC_ARG)
+            ret = WC_TEST_RET_ENC_NC;
+    }
+
+    XFREE(input, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+
+#if defined(WOLFSSL_BLAKE3_THREADS) && !defined(SINGLE_THREADED)
+    /* Splitting the tree over threads must not change the digest. */
+    if (ret == 0) {
+        byte digest[BLAKE3_OUTBYTES];
+        word32 sz = 3 * 1024 * 1024 + 777;
+
+        input = (byte*)XMALLOC(sz, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+        if (input == NULL)
+            return WC_TEST_RET_ENC_ERRNO;
+        for (i = 0; i < sz; i++)
+            input[i] = (byte)(i * 31 + 7);
+
+        ret = wc_InitBlake3(&b3, BLAKE3_OUTBYTES);
+        if (ret == 0)
+            ret = wc_Blake3Update(&b3, input, sz);
+        if (ret == 0)
+            ret = wc_Blake3Final(&b3, digest, 0);
+        for (i = 2; (ret == 0) && (i <= 8); i += 3) {
+            ret = wc_InitBlake3(&b3, BLAKE3_OUTBYTES);
+            if (ret == 0)
+                ret = wc_Blake3SetThreads(&b3, i);
+            if (ret == 0)
+                ret = wc_Blake3Update(&b3, input, 1000);
+            if (ret == 0)
+                ret = wc_Blake3Update(&b3, input + 1000, sz - 1000);
+            if (ret == 0)
+                ret = wc_Blake3Final(&b3, out, 0);
+            if (ret != 0)
+                ret = WC_TEST_RET_ENC_EC(ret);
+            else if (XMEMCMP(out, digest, sizeof(digest)) != 0)
+                ret = WC_TEST_RET_ENC_I(i);
+        }
+
+        XFREE(input, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+    }
+#endif
+
+    return ret;
+}
+#endif /* HAVE_BLAKE3 */
+
 
 #ifdef WOLFSSL_SHA224
 WOLFSSL_TEST_SUBROUTINE wc_test_ret_t sha224_test(void)
@@ -3225,6 +3905,129 @@ exit:
 }
 #endif
 
+#if defined(HAVE_CPUID_INTEL) && defined(USE_INTEL_SPEEDUP) && \
+    (!defined(NO_SHA) || !defined(NO_SHA256))
+/* The SHA-1 and SHA-256 transforms are chosen at runtime from the CPU flags.
+ * When the SHA extensions are present the tests above ran the SHA-NI code, so
+ * run them again with the flag cleared to cover the AVX and C transforms. */
+WOLFSSL_TEST_SUBROUTINE wc_test_ret_t sha_ni_fallback_test(void)
+{
+    wc_test_ret_t ret = 0;
+    word32 flags = cpuid_get_flags();
+
+    if (!IS_INTEL_SHA(flags))
+        return 0;
+
+    cpuid_clear_flag(CPUID_SHA);
+#ifndef NO_SHA
+    ret = sha_test();
+#endif
+#ifdef WOLFSSL_SHA224
+    if (ret == 0)
+        ret = sha224_test();
+#endif
+#ifndef NO_SHA256
+    if (ret == 0)
+        ret = sha256_test();
+#endif
+    cpuid_select_flags(flags);
+
+    return ret;
+}
+#endif
+
+#if !defined(NO_SHA256) && defined(WOLFSSL_SHA256_MULTI)
+#define SHA256_MULTI_TEST_CNT   17
+/* Hash messages with lengths either side of the padding and block boundaries
+ * in batches that leave lanes idle and lanes refilled, and compare each digest
+ * with the single-buffer API. */
+static wc_test_ret_t sha256_multi_test_cnt(const byte* input, word32 cnt)
+{
+    static const word32 lens[SHA256_MULTI_TEST_CNT] = {
+        0, 1, 55, 56, 63, 64, 65, 119, 1000, 3, 128, 200, 511, 64, 0, 700, 120
+    };
+    const byte* data[SHA256_MULTI_TEST_CNT];
+    byte* hashes[SHA256_MULTI_TEST_CNT];
+    byte  hash[SHA256_MULTI_TEST_CNT][WC_SHA256_DIGEST_SIZE];
+    byte  expect[WC_SHA256_DIGEST_SIZE];
+    wc_test_ret_t ret;
+    word32 i;
+
+    for (i = 0; i < SHA256_MULTI_TEST_CNT; i++) {
+        data[i] = input + i;
+        hashes[i] = hash[i];
+    }
+    ret = wc_Sha256HashMulti(data, lens, hashes, cnt);
+    if (ret != 0)
+        return WC_TEST_RET_ENC_EC(ret);
+
+    for (i = 0; i < cnt; i++) {
+        ret = wc_Sha256Hash(data[i], lens[i], expect);
+        if (ret != 0)
+            return WC_TEST_RET_ENC_EC(ret);
+        if (XMEMCMP(hash[i], expect, WC_SHA256_DIGEST_SIZE) != 0)
+            return WC_TEST_RET_ENC_I(i);
+    }
+
+    return 0;
+}
+
+static wc_test_ret_t sha256_multi_test_all(const byte* input)
+{
+    static const word32 cnts[] = { 1, 3, 8, 9, SHA256_MULTI_TEST_CNT };
+    wc_test_ret_t ret = 0;
+    word32 i;
+
+    for (i = 0; (ret == 0) && (i < sizeof(cnts) / sizeof(*cnts)); i++) {
+        ret = sha256_multi_test_cnt(input, cnts[i]);
+    }
+
+    return ret;
+}
+
+WOLFSSL_TEST_SUBROUTINE wc_test_ret_t sha256_multi_test(void)
+{
+    wc_test_ret_t ret;
+    byte input[1024];
+    word32 i;
+#if defined(HAVE_CPUID_INTEL) && defined(USE_INTEL_SPEEDUP)
+    word32 flags = cpuid_get_flags();
+#endif
+
+    for (i = 0; i < (word32)sizeof(input); i++) {
+        input[i] = (byte)(i * 7 + 3);
+    }
+
+    ret = sha256_multi_test_all(input);
+    if (ret == 0) {
+        if (wc_Sha256HashMulti(NULL, NULL, NULL, 1) != BAD_FUNC_ARG)
+            ret = WC_TEST_RET_ENC_NC;
+    }
+#if defined(HAVE_CPUID_INTEL) && defined(USE_INTEL_SPEEDUP)
+    /* SHA-NI is preferred over the lanes, so take it away and then drop to
+     * the 4 lane and the one message at a time code. */
+    if ((ret == 0) && IS_INTEL_SHA(flags)) {
+        cpuid_clear_flag(CPUID_SHA);
+        ret = sha256_multi_test_all(input);
+    }
+    if ((ret == 0) && IS_INTEL_AVX2(flags)) {
+        cpuid_clear_flag(CPUID_SHA);
+        cpuid_clear_flag(CPUID_AVX2);
+        ret = sha256_multi_test_all(input);
+    }
+    if ((ret == 0) && IS_INTEL_AVX1(flags)) {
+        cpuid_clear_flag(CPUID_SHA);
+        cpuid_clear_flag(CPUID_AVX2);
+        cpuid_clear_flag(CPUID_AVX1);
+        ret = sha256_multi_test_all(input);
+    }
+    cpuid_select_flags(flags);
+#endif
+
+    return ret;
+}
+#endif
+
 
 #ifdef WOLFSSL_SHA512
 WOLFSSL_TEST_SUBROUTINE wc_test_ret_t sha512_test(void)
@@ -4938,6 +5741,130 @@ exit:
 }
 #endif
 
+#if defined(WOLFSSL_SHAKE128) || defined(WOLFSSL_SHAKE256)
+#define SHAKE_X4_TEST_BLOCKS    2
+/* Absorb and squeeze four different messages at once and compare each output
+ * with the single state API. Lengths cover empty, partial, exact and multiple
+ * blocks of both rates. */
+static wc_test_ret_t shake_x4_test_rate(const byte* input, int shake256)
+{
+    static const word32 lens[] = {
+        0, 1, 33, 135, 136, 137, 167, 168, 169, 200, 336, 500
+    };
+    wc_Shakex4 x4;
+    wc_Shake   sha;
+    const byte* data[4];
+    byte* outs[4];
+    byte out[4][SHAKE_X4_TEST_BLOCKS * WC_SHA3_128_COUNT * 8];
+    byte expect[SHAKE_X4_TEST_BLOCKS * WC_SHA3_128_COUNT * 8];
+    word32 outLen;
+    wc_test_ret_t ret = 0;
+    word32 i;
+    int l;
+
+    outLen = SHAKE_X4_TEST_BLOCKS * 8 *
+             (shake256 ? WC_SHA3_256_COUNT : WC_SHA3_128_COUNT);
+    for (l = 0; l < 4; l++) {
+        data[l] = input + l * 7;
+        outs[l] = out[l];
+    }
+
+    for (i = 0; (ret == 0) && (i < sizeof(lens) / sizeof(*lens)); i++) {
+    #ifdef WOLFSSL_SHAKE256
+        if (shake256) {
+            ret = wc_Shake256x4_Absorb(&x4, data, lens[i]);
+            if (ret == 0)
+                ret = wc_Shake256x4_SqueezeBlocks(&x4, outs,
+                    SHAKE_X4_TEST_BLOCKS);
+        }
+    #endif
+    #ifdef WOLFSSL_SHAKE128
+        if (!shake256) {
+            ret = wc_Shake128x4_Absorb(&x4, data, lens[i]);
+            if (ret == 0)
+                ret = wc_Shake128x4_SqueezeBlocks(&x4, outs,
+                    SHAKE_X4_TEST_BLOCKS);
+        }
+    #endif
+        if (ret != 0)
+            return WC_TEST_RET_ENC_EC(ret);
+
+        for (l = 0; l < 4; l++) {
+        #ifdef WOLFSSL_SHAKE256
+            if (shake256) {
+                ret = wc_InitShake256(&sha, HEAP_HINT, devId);
+                if (ret == 0)
+                    ret = wc_Shake256_Absorb(&sha, data[l], lens[i]);
+                if (ret == 0)
+                    ret = wc_Shake256_SqueezeBlocks(&sha, expect,
+                        SHAKE_X4_TEST_BLOCKS);
+                wc_Shake256_Free(&sha);
+            }
+        #endif
+        #ifdef WOLFSSL_SHAKE128
+            if (!shake256) {
+                ret = wc_InitShake128(&sha, HEAP_HINT, devId);
+                if (ret == 0)
+                    ret = wc_Shake128_Absorb(&sha, data[l], lens[i]);
+                if (ret == 0)
+                    ret = wc_Shake128_SqueezeBlocks(&sha, expect,
+                        SHAKE_X4_TEST_BLOCKS);
+                wc_Shake128_Free(&sha);
+            }
+        #endif
+            if (ret != 0)
+                return WC_TEST_RET_ENC_EC(ret);
+            if (XMEMCMP(out[l], expect, outLen) != 0)
+                return WC_TEST_RET_ENC_I(i);
+        }
+    }
+    wc_Shakex4_Free(&x4);
+
+    return ret;
+}
+
+static wc_test_ret_t shake_x4_test_all(const byte* input)
+{
+    wc_test_ret_t ret = 0;
+
+#ifdef WOLFSSL_SHAKE128
+    ret = shake_x4_test_rate(input, 0);
+#endif
+#ifdef WOLFSSL_SHAKE256
+    if (ret == 0)
+        ret = shake_x4_test_rate(input, 1);
+#endif
+
+    return ret;
+}
+
+WOLFSSL_TEST_SUBROUTINE wc_test_ret_t shake_x4_test(void)
+{
+    wc_test_ret_t ret;
+    byte input[528];
+    word32 i;
+#if defined(HAVE_CPUID_INTEL) && defined(USE_INTEL_SPEEDUP)
+    word32 flags = cpuid_get_flags();
+#endif
+
+    for (i = 0; i < (word32)sizeof(input); i++) {
+        input[i] = (byte)(i * 13 + 5);
+    }
+
+    ret = shake_x4_test_all(input);
+#if defined(HAVE_CPUID_INTEL) && defined(USE_INTEL_SPEEDUP)
+    /* Permute the states one at a time as well. */
+    if ((ret == 0) && IS_INTEL_AVX2(flags)) {
+        cpuid_clear_flag(CPUID_AVX2);
+        ret = shake_x4_test_all(input);
+        cpuid_select_flags(flags);
+    }
+#endif
+
+    return ret;
+}
+#endif
+
 #ifdef WOLFSSL_SM3
 WOLFSSL_TEST_SUBROUTINE wc_test_ret_t sm3_test(void)
 {
@@ -7189,6 +8116,120 @@ WOLFSSL_TEST_SUBROUTINE wc_test_ret_t poly1305_test(void)
 
 
 #if defined(HAVE_CHACHA) && defined(HAVE_POLY1305)
+/* Encrypt/decrypt 3 x 512 + 77 bytes in one call and in pieces that start
+ * and end off the ChaCha block boundary, in place, so that the 512 byte
+ * chunks of the SIMD code and the bytes either side of them are covered. */
+static wc_test_ret_t chacha20_poly1305_long_test(const byte* key,
+    const byte* iv, const byte* aad, word32 aadSz)
+{
+    WOLFSSL_SMALL_STACK_STATIC const byte authTag[] = {
+        0xc8, 0x63, 0x8e, 0xf9, 0xf5, 0x95, 0x1a, 0xb3,
+        0x4c, 0x1c, 0x2c, 0x22, 0xb5, 0x72, 0x16, 0xaa
+    };
+    static const word32 pieces[] = { 7, 600, 1006 };
+    const word32 sz = 3 * 512 + 77;
+    wc_test_ret_t ret = 0;
+    int err;
+    word32 i;
+    word32 off;
+    int pass;
+    byte* plain;
+    byte* cipher;
+    byte* buf;
+    byte tag[CHACHA20_POLY1305_AEAD_AUTHTAG_SIZE];
+    ChaChaPoly_Aead aead;
+#if defined(HAVE_CPUID_INTEL) && defined(USE_INTEL_SPEEDUP)
+    word32 flags = cpuid_get_flags();
+#endif
+
+    plain = (byte*)XMALLOC(3 * sz, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+    if (plain == NULL)
+        return WC_TEST_RET_ENC_ERRNO;
+    cipher = plain + sz;
+    buf = cipher + sz;
+    for (i = 0; i < sz; i++)
+        plain[i] = (byte)i;
+
+    for (pass = 0; (ret == 0) && (pass < 2); pass++) {
+        err = wc_ChaCha20Poly1305_Encrypt(key, iv, aad, aadSz, plain, sz,
+            cipher, tag);
+        if (err != 0)
+            ret = WC_TEST_RET_ENC_EC(err);
+        else if (XMEMCMP(tag, authTag, sizeof(authTag)) != 0)
+            ret = WC_TEST_RET_ENC_NC;
+        if (ret == 0) {
+            err = wc_ChaCha20Poly1305_Decrypt(key, iv, aad, aadSz, cipher,
+                sz, authTag, buf);
+            if (err != 0)
+                ret = WC_TEST_RET_ENC_EC(err);
+            else if (XMEMCMP(buf, plain, sz) != 0)
+                ret = WC_TEST_RET_ENC_NC;
+        }
+
+        /* Encrypt then decrypt in place, in pieces */
+        if (ret == 0) {
+            XMEMCPY(buf, plain, sz);
+            err = wc_ChaCha20Poly1305_Init(&aead, key, iv,
+                CHACHA20_POLY1305_AEAD_ENCRYPT);
+            if (err == 0)
+                err = wc_ChaCha20Poly1305_UpdateAad(&aead, aad, aadSz);
+            for (i = 0, off = 0; (err == 0) && (off < sz); i++) {
+                word32 len = pieces[i % 3];
+                if (len > sz - off)
+                    len = sz - off;
+                err = wc_ChaCha20Poly1305_UpdateData(&aead, buf + off,
+                    buf + off, len);
+                off += len;
+            }
+            if (err == 0)
+                err = wc_ChaCha20Poly1305_Final(&aead, tag);
+            if (err != 0)
+                ret = WC_TEST_RET_ENC_EC(err);
+            else if ((XMEMCMP(buf, cipher, sz) != 0) ||
+                     (XMEMCMP(tag, authTag, sizeof(authTag)) != 0))
+                ret = WC_TEST_RET_ENC_NC;
+        }
+        if (ret == 0) {
+            err = wc_ChaCha20Poly1305_Init(&aead, key, iv,
+                CHACHA20_POLY1305_AEAD_DECRYPT);
+            if (err == 0)
+                err = wc_ChaCha20Poly1305_UpdateAad(&aead, aad, aadSz);
+            for (i = 0, off = 0; (err == 0) && (off < sz); i++) {
+                word32 len = pieces[i % 3];
+                if (len > sz - off)
+                    len = sz - off;
+                err = wc_ChaCha20Poly1305_UpdateData(&aead, buf + off,
+                    buf + off, len);
+                off += len;
+            }
+            if (err == 0)
+                err = wc_ChaCha20Poly1305_Final(&aead, tag);
+            if (err == 0)
+                err = wc_ChaCha20Poly1305_CheckTag(tag, authTag);
+            if (err != 0)
+                ret = WC_TEST_RET_ENC_EC(err);
+            else if (XMEMCMP(buf, plain, sz) != 0)
+                ret = WC_TEST_RET_ENC_NC;
+        }
+
+    #if defined(HAVE_CPUID_INTEL) && defined(USE_INTEL_SPEEDUP)
+        /* Again with ChaCha20 and Poly1305 done one after the other */
+        if (!IS_INTEL_AVX2(flags))
+            break;
+        cpuid_clear_flag(CPUID_AVX2);
+    #else
+        break;
+    #endif
+    }
+
+#if defined(HAVE_CPUID_INTEL) && defined(USE_INTEL_SPEEDUP)
+    cpuid_select_flags(flags);
+#endif
+    XFREE(plain, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+
+    return ret;
+}
+
 WOLFSSL_TEST_SUBROUTINE wc_test_ret_t chacha20_poly1305_aead_test(void)
 {
     /* Test #1 from Section 2.8.2 of draft-irtf-cfrg-chacha20-poly1305-10 */
@@ -7702,6 +8743,8 @@ WOLFSSL_TEST_SUBROUTINE wc_test_ret_t chacha20_poly1305_aead_test(void)
         return WC_TEST_RET_ENC_NC;
     }
 
+    err = chacha20_poly1305_long_test(key1, iv1, aad1, sizeof(aad1));
+
     return err;
 }
 #endif /* HAVE_CHACHA && HAVE_POLY1305 */
@@ -10323,6 +11366,202 @@ static wc_test_ret_t aes_xts_args_test(void)
     return ret;
 }
 #endif /* WOLFSSL_AES_128 */
+
+#if defined(WOLFSSL_AESXTS_THREADS) && !defined(SINGLE_THREADED) && \
+    defined(WOLFSSL_AES_128) && !defined(WOLFSSL_NO_MALLOC)
+typedef struct AesXtsPipeCtx {
+    const byte* src;
+    word32      srcSz;
+    word32      rd;
+    byte*       dst;
+    word32      wr;
+    int         failRead;
+    word32      maxRead;
+} AesXtsPipeCtx;
+
+static int aes_xts_pipe_read(void* ctx, byte* buf, word32 sz)
+{
+    AesXtsPipeCtx* p = (AesXtsPipeCtx*)ctx;
+
+    if (p->failRead > 0 && --p->failRead == 0)
+        return -1;
+    if (p->maxRead > 0 && sz > p->maxRead)
+        sz = p->maxRead;
+    if (sz > p->srcSz - p->rd)
+        sz = p->srcSz - p->rd;
+    XMEMCPY(buf, p->src + p->rd, sz);
+    p->rd += sz;
+    return (int)sz;
+}
+
+static int aes_xts_pipe_write(void* ctx, const byte* buf, word32 sz)
+{
+    AesXtsPipeCtx* p = (AesXtsPipeCtx*)ctx;
+
+    if (sz > p->srcSz - p->wr)
+        return -1;
+    XMEMCPY(p->dst + p->wr, buf, sz);
+    p->wr += sz;
+    return 0;
+}
+
+static wc_test_ret_t aes_xts_threads_test(void)
+{
+    XtsAes *aes = NULL;
+    int aes_inited = 0;
+    wc_test_ret_t ret = 0;
+    byte* plain = NULL;
+    byte* ref = NULL;
+    byte* res = NULL;
+    byte* work = NULL;
+    AesXtsPipeCtx pipe;
+    word32 i;
+    /* Four threads' worth of sectors, some more and a partial sector. */
+    const word32 sz = 4 * 65536 + 8 * 512 + 77;
+    const word32 sectorSz = 512;
+    const word64 sector = W64LIT(0x1122334455);
+    const word32 workSz[2] = { 2 * 3 * 512 + 100, 2 * 128 * 1024 };
+    static const word32 threads[] = { 2, 3, 4, 8 };
+
+    WOLFSSL_SMALL_STACK_STATIC unsigned char k1[] = {
+        0xa3, 0xe4, 0x0d, 0x5b, 0xd4, 0xb6, 0xbb, 0xed,
+        0xb2, 0xd1, 0x8c, 0x70, 0x0a, 0xd2, 0xdb, 0x22,
+        0x10, 0xc8, 0x11, 0x90, 0x64, 0x6d, 0x67, 0x3c,
+        0xbc, 0xa5, 0x3f, 0x13, 0x3e, 0xab, 0x37, 0x3c
+    };
+
+    aes = (XtsAes *)XMALLOC(sizeof *aes, HEAP_HINT, DYNAMIC_TYPE_AES);
+    plain = (byte*)XMALLOC(sz, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+    ref = (byte*)XMALLOC(sz, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+    res = (byte*)XMALLOC(sz, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+    work = (byte*)XMALLOC(workSz[1], HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+    if (aes == NULL || plain == NULL || ref == NULL || res == NULL ||
+            work == NULL)
+        ERROR_OUT(WC_TEST_RET_ENC_ERRNO, out);
+    for (i = 0; i < sz; i++)
+        plain[i] = (byte)(i * 13 + (i >> 9));
+
+    ret = wc_AesXtsInit(aes, HEAP_HINT, devId);
+    if (ret != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), out);
+    aes_inited = 1;
+
+    ret = wc_AesXtsSetKeyNoInit(aes, k1, sizeof(k1), AES_ENCRYPTION);
+    if (ret != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), out);
+    ret = wc_AesXtsEncryptConsecutiveSectors(aes, ref, plain, sz, sector,
+        sectorSz);
+    if (ret != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), out);
+
+    /* Splitting across threads must not change the cipher text. */
+    for (i = 0; i < sizeof(threads) / sizeof(threads[0]); i++) {
+        ret = wc_AesXtsSetThreads(aes, threads[i]);
+        if (ret != 0)
+            ERROR_OUT(WC_TEST_RET_ENC_EC(ret), out);
+        XMEMSET(res, 0, sz);
+        ret = wc_AesXtsEncryptConsecutiveSectors(aes, res, plain, sz, sector,
+            sectorSz);
+        if (ret != 0)
+            ERROR_OUT(WC_TEST_RET_ENC_EC(ret), out);
+        if (XMEMCMP(res, ref, sz) != 0)
+            ERROR_OUT(WC_TEST_RET_ENC_I(i), out);
+    }
+
+    /* In place, encrypt then pipelined from plain text. */
+    XMEMCPY(res, plain, sz);
+    ret = wc_AesXtsEncryptConsecutiveSectors(aes, res, res, sz, sector,
+        sectorSz);
+    if (ret != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), out);
+    if (XMEMCMP(res, ref, sz) != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_NC, out);
+    for (i = 0; i < 2; i++) {
+        XMEMSET(&pipe, 0, sizeof(pipe));
+        pipe.src = plain;
+        pipe.srcSz = sz;
+        pipe.dst = res;
+        XMEMSET(res, 0, sz);
+        ret = wc_AesXtsEncryptPipelined(aes, work, workSz[i], sector,
+            sectorSz, aes_xts_pipe_read, aes_xts_pipe_write, &pipe);
+        if (ret != 0)
+            ERROR_OUT(WC_TEST_RET_ENC_EC(ret), out);
+        if (pipe.wr != sz || XMEMCMP(res, ref, sz) != 0)
+            ERROR_OUT(WC_TEST_RET_ENC_I(i), out);
+    }
+
+    /* Short reads, not a multiple of the sector size, don't end the data. */
+    XMEMSET(&pipe, 0, sizeof(pipe));
+    pipe.src = plain;
+    pipe.srcSz = sz;
+    pipe.dst = res;
+    pipe.maxRead = 700;
+    XMEMSET(res, 0, sz);
+    ret = wc_AesXtsEncryptPipelined(aes, work, workSz[1], sector, sectorSz,
+        aes_xts_pipe_read, aes_xts_pipe_write, &pipe);
+    if (ret != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), out);
+    if (pipe.wr != sz || XMEMCMP(res, ref, sz) != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_NC, out);
+
+    /* A failed read is returned. */
+    XMEMSET(&pipe, 0, sizeof(pipe));
+    pipe.src = plain;
+    pipe.srcSz = sz;
+    pipe.dst = res;
+    pipe.failRead = 3;
+    ret = wc_AesXtsEncryptPipelined(aes, work, workSz[0], sector, sectorSz,
+        aes_xts_pipe_read, aes_xts_pipe_write, &pipe);
+    if (ret != -1)
+        ERROR_OUT(WC_TEST_RET_ENC_NC, out);
+    ret = wc_AesXtsEncryptPipelined(aes, work, sectorSz, sector, sectorSz,
+        aes_xts_pipe_read, aes_xts_pipe_write, &pipe);
+    if (ret != BAD_FUNC_ARG)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), out);
+
+    /* Decrypt on threads and pipelined. */
+    ret = wc_AesXtsSetKeyNoInit(aes, k1, sizeof(k1), AES_DECRYPTION);
+    if (ret != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), out);
+    ret = wc_AesXtsSetThreads(aes, 4);
+    if (ret != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), out);
+    ret = wc_AesXtsDecryptConsecutiveSectors(aes, res, ref, sz, sector,
+        sectorSz);
+    if (ret != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), out);
+    if (XMEMCMP(res, plain, sz) != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_NC, out);
+    XMEMSET(&pipe, 0, sizeof(pipe));
+    pipe.src = ref;
+    pipe.srcSz = sz;
+    pipe.dst = res;
+    XMEMSET(res, 0, sz);
+    ret = wc_AesXtsDecryptPipelined(aes, work, workSz[1], sector, sectorSz,
+        aes_xts_pipe_read, aes_xts_pipe_write, &pipe);
+    if (ret != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), out);
+    if (pipe.wr != sz || XMEMCMP(res, plain, sz) != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_NC, out);
+
+    ret = wc_AesXtsSetThreads(aes, 0);
+    if (ret != BAD_FUNC_ARG)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), out);
+    ret = 0;
+
+  out:
+
+    if (aes_inited)
+        wc_AesXtsFree(aes);
+    XFREE(work, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+    XFREE(res, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+    XFREE(ref, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+    XFREE(plain, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+    XFREE(aes, HEAP_HINT, DYNAMIC_TYPE_AES);
+
+    return ret;
+}
+#endif /* WOLFSSL_AESXTS_THREADS && !SINGLE_THREADED && WOLFSSL_AES_128 */
 #endif /* WOLFSSL_AES_XTS && (!HAVE_FIPS || FIPS_VERSION_GE(5,3)) */
 
 #if defined(HAVE_AES_CBC) && defined(WOLFSSL_AES_128)
@@ -11219,6 +12458,54 @@ static wc_test_ret_t aesctr_test(Aes* enc, Aes* dec, byte* cipher, byte* plain)
 
 #endif /* DEBUG_VECTOR_REGISTER_ACCESS && WC_AES_C_DYNAMIC_FALLBACK */
 
+#if defined(WC_AES_BITSLICED_NARROW) && defined(WOLFSSL_AES_128) && \
+    defined(WOLFSSL_AES_DIRECT)
+    /* Encrypt 1 to 5 blocks in one call so the narrow bit-sliced core runs
+     * whole 2 or 4 block passes and a partial pass. The fifth block's key
+     * stream is the counter after the vector's four, encrypted directly. */
+    {
+        byte bsPlain[AES_BLOCK_SIZE * 5];
+        byte bsCipher[AES_BLOCK_SIZE * 5];
+        byte bsExpect[AES_BLOCK_SIZE * 5];
+        byte bsCtr[AES_BLOCK_SIZE];
+        int  j;
+
+        XMEMCPY(bsPlain, ctrPlain, sizeof(ctrPlain));
+        XMEMCPY(bsPlain + sizeof(ctrPlain), ctrPlain, AES_BLOCK_SIZE);
+        XMEMCPY(bsCtr, ctrIv, AES_BLOCK_SIZE);
+        for (i = 0; i < 4; i++) {
+            for (j = AES_BLOCK_SIZE - 1; j >= 0; j--) {
+                if (++bsCtr[j] != 0)
+                    break;
+            }
+        }
+
+        ret = wc_AesSetKeyDirect(enc, ctr128Key, (word32)sizeof(ctr128Key),
+            ctrIv, AES_ENCRYPTION);
+        if (ret != 0)
+            ERROR_OUT(WC_TEST_RET_ENC_EC(ret), out);
+        ret = wc_AesEncryptDirect(enc, bsExpect + sizeof(ctrPlain), bsCtr);
+        if (ret != 0)
+            ERROR_OUT(WC_TEST_RET_ENC_EC(ret), out);
+        for (j = 0; j < AES_BLOCK_SIZE; j++)
+            bsExpect[sizeof(ctrPlain) + j] ^= bsPlain[sizeof(ctrPlain) + j];
+        XMEMCPY(bsExpect, ctr128Cipher, sizeof(ctrPlain));
+
+        for (i = 1; i <= 5; i++) {
+            ret = wc_AesSetKeyDirect(enc, ctr128Key,
+                (word32)sizeof(ctr128Key), ctrIv, AES_ENCRYPTION);
+            if (ret != 0)
+                ERROR_OUT(WC_TEST_RET_ENC_I(i), out);
+            ret = wc_AesCtrEncrypt(enc, bsCipher, bsPlain,
+                (word32)i * AES_BLOCK_SIZE);
+            if (ret != 0)
+                ERROR_OUT(WC_TEST_RET_ENC_I(i), out);
+            if (XMEMCMP(bsCipher, bsExpect, (size_t)i * AES_BLOCK_SIZE))
+                ERROR_OUT(WC_TEST_RET_ENC_I(i), out);
+        }
+    }
+#endif /* WC_AES_BITSLICED_NARROW && WOLFSSL_AES_128 && WOLFSSL_AES_DIRECT */
+
 
 out:
     return ret;
@@ -11718,6 +13005,12 @@ WOLFSSL_TEST_SUBROUTINE wc_test_ret_t aes_test(void)
     if (ret != 0)
         goto out;
     #endif
+    #if defined(WOLFSSL_AESXTS_THREADS) && !defined(SINGLE_THREADED) && \
+        defined(WOLFSSL_AES_128) && !defined(WOLFSSL_NO_MALLOC)
+    ret = aes_xts_threads_test();
+    if (ret != 0)
+        goto out;
+    #endif
 #endif
 
 #if defined(WOLFSSL_AES_CFB)
@@ -12117,8 +13410,8 @@ static wc_test_ret_t aesgcm_default_test_helper(byte* key, int keySz, byte* iv,
 #endif
 
     byte resultT[AES_BLOCK_SIZE];
-    byte resultP[AES_BLOCK_SIZE * 3];
-    byte resultC[AES_BLOCK_SIZE * 3];
+    byte resultP[AES_BLOCK_SIZE * 5];
+    byte resultC[AES_BLOCK_SIZE * 5];
 
 #if defined(WOLFSSL_SMALL_STACK) && !defined(WOLFSSL_NO_MALLOC)
     if ((enc = (Aes *)XMALLOC(sizeof *enc, HEAP_HINT, DYNAMIC_TYPE_AES)) == NULL)
@@ -12321,6 +13614,60 @@ WOLFSSL_TEST_SUBROUTINE wc_test_ret_t aesgcm_default_test(void)
         0x11, 0x64, 0xb2, 0xff
     };
 
+    /* More than four blocks of AAD and plaintext. */
+    byte key4[] = {
+        0x03, 0x0a, 0x11, 0x18, 0x1f, 0x26, 0x2d, 0x34,
+        0x3b, 0x42, 0x49, 0x50, 0x57, 0x5e, 0x65, 0x6c
+    };
+
+    byte iv4[] = {
+        0x05, 0x12, 0x1f, 0x2c, 0x39, 0x46, 0x53, 0x60,
+        0x6d, 0x7a, 0x87, 0x94
+    };
+
+    ALIGN64 byte plain4[] = {
+        0x0b, 0x28, 0x45, 0x62, 0x7f, 0x9c, 0xb9, 0xd6,
+        0xf3, 0x10, 0x2d, 0x4a, 0x67, 0x84, 0xa1, 0xbe,
+        0xdb, 0xf8, 0x15, 0x32, 0x4f, 0x6c, 0x89, 0xa6,
+        0xc3, 0xe0, 0xfd, 0x1a, 0x37, 0x54, 0x71, 0x8e,
+        0xab, 0xc8, 0xe5, 0x02, 0x1f, 0x3c, 0x59, 0x76,
+        0x93, 0xb0, 0xcd, 0xea, 0x07, 0x24, 0x41, 0x5e,
+        0x7b, 0x98, 0xb5, 0xd2, 0xef, 0x0c, 0x29, 0x46,
+        0x63, 0x80, 0x9d, 0xba, 0xd7, 0xf4, 0x11, 0x2e,
+        0x4b, 0x68, 0x85, 0xa2, 0xbf, 0xdc, 0xf9, 0x16,
+        0x33, 0x50, 0x6d, 0x8a, 0xa7, 0xc4, 0xe1, 0xfe
+    };
+
+    byte aad4[] = {
+        0x01, 0x12, 0x23, 0x34, 0x45, 0x56, 0x67, 0x78,
+        0x89, 0x9a, 0xab, 0xbc, 0xcd, 0xde, 0xef, 0x00,
+        0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88,
+        0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff, 0x10,
+        0x21, 0x32, 0x43, 0x54, 0x65, 0x76, 0x87, 0x98,
+        0xa9, 0xba, 0xcb, 0xdc, 0xed, 0xfe, 0x0f, 0x20,
+        0x31, 0x42, 0x53, 0x64, 0x75, 0x86, 0x97, 0xa8,
+        0xb9, 0xca, 0xdb, 0xec, 0xfd, 0x0e, 0x1f, 0x30,
+        0x41, 0x52, 0x63, 0x74, 0x85, 0x96
+    };
+
+    ALIGN64 byte cipher4[] = {
+        0xc9, 0xbf, 0x9a, 0x92, 0x37, 0x2e, 0x94, 0x76,
+        0xea, 0x7b, 0x18, 0xea, 0x3f, 0xdd, 0xec, 0xbc,
+        0x17, 0x86, 0x41, 0x44, 0x99, 0xc2, 0x0a, 0xc6,
+        0x53, 0x3c, 0x2d, 0x71, 0x43, 0xd4, 0x11, 0x7d,
+        0x10, 0xeb, 0x20, 0x4c, 0xe8, 0x83, 0x91, 0x08,
+        0x08, 0x63, 0xf5, 0x8e, 0x6c, 0x9d, 0x29, 0x49,
+        0xc0, 0x5e, 0x74, 0x82, 0x36, 0x78, 0x93, 0x0f,
+        0x51, 0xd8, 0x53, 0x09, 0xea, 0xe3, 0x85, 0x7b,
+        0xfd, 0x6e, 0x1f, 0x33, 0xd3, 0xb5, 0x08, 0xd1,
+        0x8a, 0xd3, 0xe5, 0x2a, 0xb2, 0x94, 0x42, 0x5e
+    };
+
+    byte tag4[] = {
+        0x30, 0x19, 0x90, 0xf6, 0xb9, 0x90, 0x5c, 0x4f,
+        0xfe, 0xc4, 0x5f, 0xc3, 0x42, 0xfc, 0x50, 0x53
+    };
+
     wc_test_ret_t ret;
     ret = aesgcm_default_test_helper(key1, sizeof(key1), iv1, sizeof(iv1),
             plain1, sizeof(plain1), cipher1, sizeof(cipher1),
@@ -12340,6 +13687,12 @@ WOLFSSL_TEST_SUBROUTINE wc_test_ret_t aesgcm_default_test(void)
     if (ret != 0) {
         return ret;
     }
+    ret = aesgcm_default_test_helper(key4, sizeof(key4), iv4, sizeof(iv4),
+            plain4, sizeof(plain4), cipher4, sizeof(cipher4),
+            aad4, sizeof(aad4), tag4, sizeof(tag4));
+    if (ret != 0) {
+        return ret;
+    }
 #endif
 
     return 0;
@@ -12617,6 +13970,61 @@ WOLFSSL_TEST_SUBROUTINE wc_test_ret_t aesgcm_test(void)
         ERROR_OUT(WC_TEST_RET_ENC_NC, out);
 #endif /* HAVE_AES_DECRYPT */
 
+#if defined(WC_AES_BITSLICED_NARROW) && defined(WOLFSSL_AES_DIRECT)
+    /* Encrypt 1 to 5 blocks in one call so the narrow bit-sliced core runs
+     * whole 2 or 4 block passes and a partial pass. The vector covers the
+     * first 60 bytes. The rest of the plain text is zero, so the expected
+     * cipher text there is the key stream of counters 5 and 6. */
+    {
+        byte bsPlain[AES_BLOCK_SIZE * 5];
+        byte bsCipher[AES_BLOCK_SIZE * 5];
+        byte bsExpect[AES_BLOCK_SIZE * 5];
+        byte bsCtr[AES_BLOCK_SIZE];
+        byte bsTag[AES_BLOCK_SIZE];
+        int  n;
+
+        XMEMSET(bsPlain, 0, sizeof(bsPlain));
+        XMEMCPY(bsPlain, p, sizeof(p));
+
+        ret = wc_AesSetKeyDirect(dec, k1, (word32)k1Sz, NULL, AES_ENCRYPTION);
+        if (ret != 0)
+            ERROR_OUT(WC_TEST_RET_ENC_EC(ret), out);
+        XMEMSET(bsCtr, 0, sizeof(bsCtr));
+        XMEMCPY(bsCtr, iv1, sizeof(iv1));
+        bsCtr[AES_BLOCK_SIZE - 1] = 5;
+        ret = wc_AesEncryptDirect(dec, bsExpect + AES_BLOCK_SIZE * 3, bsCtr);
+        if (ret != 0)
+            ERROR_OUT(WC_TEST_RET_ENC_EC(ret), out);
+        bsCtr[AES_BLOCK_SIZE - 1] = 6;
+        ret = wc_AesEncryptDirect(dec, bsExpect + AES_BLOCK_SIZE * 4, bsCtr);
+        if (ret != 0)
+            ERROR_OUT(WC_TEST_RET_ENC_EC(ret), out);
+        XMEMCPY(bsExpect, c1, sizeof(c1));
+
+        ret = wc_AesGcmSetKey(dec, k1, k1Sz);
+        if (ret != 0)
+            ERROR_OUT(WC_TEST_RET_ENC_EC(ret), out);
+        for (n = 1; n <= 5; n++) {
+            ret = wc_AesGcmEncrypt(enc, bsCipher, bsPlain,
+                (word32)n * AES_BLOCK_SIZE, iv1, sizeof(iv1), bsTag,
+                sizeof(bsTag), a, sizeof(a));
+            if (ret != 0)
+                ERROR_OUT(WC_TEST_RET_ENC_I(n), out);
+            if (XMEMCMP(bsCipher, bsExpect, (size_t)n * AES_BLOCK_SIZE))
+                ERROR_OUT(WC_TEST_RET_ENC_I(n), out);
+        #ifdef HAVE_AES_DECRYPT
+            ret = wc_AesGcmDecrypt(dec, bsCipher, bsCipher,
+                (word32)n * AES_BLOCK_SIZE, iv1, sizeof(iv1), bsTag,
+                sizeof(bsTag), a, sizeof(a));
+            if (ret != 0)
+                ERROR_OUT(WC_TEST_RET_ENC_I(n), out);
+            if (XMEMCMP(bsCipher, bsPlain, (size_t)n * AES_BLOCK_SIZE))
+                ERROR_OUT(WC_TEST_RET_ENC_I(n), out);
+        #endif
+        }
+    }
+#endif /* WC_AES_BITSLICED_NARROW && WOLFSSL_AES_DIRECT */
+
     /* Large buffer test */
 #ifdef BENCH_AESGCM_LARGE
     /* setup test buffer */
@@ -16845,6 +18253,243 @@ static wc_test_ret_t rsa_nb_test(RsaKey* key, const byte* in, word32 inLen, byte
 }
 #endif
 
+#if defined(WC_RSA_BLINDING_CACHE) && !defined(WC_NO_RNG) && \
+    !defined(WOLFSSL_RSA_PUBLIC_ONLY) && !defined(WOLFSSL_RSA_VERIFY_ONLY)
+#if defined(WOLFSSL_KEY_GEN) && !defined(NO_ASN)
+#define RSA_BLIND_DER_SZ    (RSA_TEST_BYTES * 5 + 64)
+/* Load a different key into an RsaKey whose cached blinding factors are in
+ * use. The signature made after must be that of the new key. */
+static wc_test_ret_t rsa_blinding_cache_reload_test(RsaKey* keyA,
+    const byte* in, word32 inLen, WC_RNG* rng)
+{
+    wc_test_ret_t ret;
+    int sz = wc_RsaEncryptSize(keyA);
+    int derASz;
+    int derBSz;
+    word32 idx;
+    WC_DECLARE_VAR(der, byte, 2 * RSA_BLIND_DER_SZ, HEAP_HINT);
+    WC_DECLARE_VAR(sig, byte, 2 * RSA_TEST_BYTES, HEAP_HINT);
+    WC_DECLARE_VAR(keys, RsaKey, 2, HEAP_HINT);
+
+#ifdef WC_DECLARE_VAR_IS_HEAP_ALLOC
+    if (der == NULL || sig == NULL || keys == NULL)
+        ERROR_OUT(WC_TEST_RET_ENC_ERRNO, exit_rsa_blind_reload);
+#endif
+    XMEMSET(keys, 0, sizeof(RsaKey) * 2);
+
+    ret = wc_InitRsaKey_ex(&keys[0], HEAP_HINT, devId);
+    if (ret == 0)
+        ret = wc_InitRsaKey_ex(&keys[1], HEAP_HINT, devId);
+    if (ret != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), exit_rsa_blind_reload);
+
+    /* Key B, same size as key A. */
+    ret = wc_MakeRsaKey(&keys[1], sz * 8, WC_RSA_EXPONENT, rng);
+    if (ret != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), exit_rsa_blind_reload);
+    derASz = wc_RsaKeyToDer(keyA, der, RSA_BLIND_DER_SZ);
+    if (derASz < 0)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(derASz), exit_rsa_blind_reload);
+    derBSz = wc_RsaKeyToDer(&keys[1], der + RSA_BLIND_DER_SZ,
+        RSA_BLIND_DER_SZ);
+    if (derBSz < 0)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(derBSz), exit_rsa_blind_reload);
+
+    /* Sign with key A to fill the cache. */
+    idx = 0;
+    ret = wc_RsaPrivateKeyDecode(der, &idx, &keys[0], (word32)derASz);
+    if (ret != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), exit_rsa_blind_reload);
+    ret = wc_RsaSSL_Sign(in, inLen, sig, RSA_TEST_BYTES, &keys[0], rng);
+    if (ret != sz)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), exit_rsa_blind_reload);
+
+    /* Decode key B over key A and sign again. */
+    idx = 0;
+    ret = wc_RsaPrivateKeyDecode(der + RSA_BLIND_DER_SZ, &idx, &keys[0],
+        (word32)derBSz);
+    if (ret != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), exit_rsa_blind_reload);
+    ret = wc_RsaSSL_Sign(in, inLen, sig, RSA_TEST_BYTES, &keys[0], rng);
+    if (ret != sz)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), exit_rsa_blind_reload);
+
+    ret = wc_RsaSSL_Verify(sig, (word32)sz, sig + RSA_TEST_BYTES,
+        RSA_TEST_BYTES, &keys[1]);
+    if (ret != (int)inLen)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), exit_rsa_blind_reload);
+    if (XMEMCMP(sig + RSA_TEST_BYTES, in, inLen) != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_NC, exit_rsa_blind_reload);
+    ret = 0;
+
+exit_rsa_blind_reload:
+    wc_FreeRsaKey(&keys[0]);
+    wc_FreeRsaKey(&keys[1]);
+    WC_FREE_VAR(keys, HEAP_HINT);
+    WC_FREE_VAR(sig, HEAP_HINT);
+    WC_FREE_VAR(der, HEAP_HINT);
+    return ret;
+}
+#endif
+
+/* Sign repeatedly so the cached blinding factors are squared many times and
+ * regenerated at least twice. PKCS #1 v1.5 signatures are deterministic so
+ * each one must match the first. */
+static wc_test_ret_t rsa_blinding_cache_test(RsaKey* key, const byte* in,
+    word32 inLen, byte* out, word32 outSz, WC_RNG* rng)
+{
+    wc_test_ret_t ret;
+    int i;
+    int sigSz;
+    WC_DECLARE_VAR(sig, byte, RSA_TEST_BYTES, HEAP_HINT);
+
+#ifdef WC_DECLARE_VAR_IS_HEAP_ALLOC
+    if (sig == NULL)
+        ERROR_OUT(WC_TEST_RET_ENC_ERRNO, exit_rsa_blind);
+#endif
+
+    ret = wc_RsaSSL_Sign(in, inLen, sig, RSA_TEST_BYTES, key, rng);
+    if (ret < 0)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), exit_rsa_blind);
+    sigSz = (int)ret;
+
+    for (i = 0; i < 70; i++) {
+        ret = wc_RsaSSL_Sign(in, inLen, out, outSz, key, rng);
+        if (ret < 0)
+            ERROR_OUT(WC_TEST_RET_ENC_EC(ret), exit_rsa_blind);
+        if ((ret != sigSz) || (XMEMCMP(out, sig, (size_t)sigSz) != 0))
+            ERROR_OUT(WC_TEST_RET_ENC_I(i), exit_rsa_blind);
+    }
+    ret = 0;
+
+#if defined(WOLFSSL_KEY_GEN) && !defined(NO_ASN)
+    ret = rsa_blinding_cache_reload_test(key, in, inLen, rng);
+#endif
+
+exit_rsa_blind:
+    WC_FREE_VAR(sig, HEAP_HINT);
+    return ret;
+}
+#endif
+
+#if defined(WC_RSA_BATCH) && !defined(WC_NO_RNG)
+#define RSA_BATCH_TEST_CNT  5
+/* Sign in batches of different sizes with a mix of keys and check each
+ * signature matches the one from wc_RsaSSL_Sign(). PKCS #1 v1.5 signatures
+ * are deterministic. */
+static wc_test_ret_t rsa_batch_test(RsaKey* key, const byte* in, word32 inLen,
+    WC_RNG* rng)
+{
+    wc_test_ret_t ret;
+    int i;
+    int j;
+    int sz = wc_RsaEncryptSize(key);
+    const int cnts[] = { 1, 2, 3, RSA_BATCH_TEST_CNT };
+    const byte* msg[RSA_BATCH_TEST_CNT];
+    word32 msgLen[RSA_BATCH_TEST_CNT];
+    byte* exp[RSA_BATCH_TEST_CNT];
+    byte* sig[RSA_BATCH_TEST_CNT];
+    RsaKey* keys[RSA_BATCH_TEST_CNT];
+    WC_DECLARE_VAR(buf, byte, 2 * RSA_BATCH_TEST_CNT * RSA_TEST_BYTES,
+        HEAP_HINT);
+    WC_DECLARE_VAR(other, RsaKey, 2, HEAP_HINT);
+
+#ifdef WC_DECLARE_VAR_IS_HEAP_ALLOC
+    if (buf == NULL || other == NULL)
+        ERROR_OUT(WC_TEST_RET_ENC_ERRNO, exit_rsa_batch);
+#endif
+    XMEMSET(other, 0, sizeof(RsaKey) * 2);
+
+    ret = wc_InitRsaKey_ex(&other[0], HEAP_HINT, devId);
+    if (ret == 0)
+        ret = wc_InitRsaKey_ex(&other[1], HEAP_HINT, devId);
+    if (ret != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), exit_rsa_batch);
+
+    for (i = 0; i < RSA_BATCH_TEST_CNT; i++) {
+        msg[i] = in;
+        msgLen[i] = inLen - (word32)i;
+        exp[i] = buf + i * RSA_TEST_BYTES;
+        sig[i] = buf + (RSA_BATCH_TEST_CNT + i) * RSA_TEST_BYTES;
+        keys[i] = key;
+    }
+#ifdef WOLFSSL_KEY_GEN
+    /* Pairs with different moduli. */
+    ret = wc_MakeRsaKey(&other[0], sz * 8, WC_RSA_EXPONENT, rng);
+    if (ret != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), exit_rsa_batch);
+    keys[1] = &other[0];
+    keys[4] = &other[0];
+#ifdef WOLFSSL_RSA_MULTI_PRIME
+    /* Keys that can't be batched are done one at a time. */
+    ret = wc_MakeRsaKeyMultiPrime(&other[1], sz * 8, WC_RSA_EXPONENT, 3, rng);
+    if (ret != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), exit_rsa_batch);
+    keys[2] = &other[1];
+#endif
+#endif
+
+    for (i = 0; i < RSA_BATCH_TEST_CNT; i++) {
+        ret = wc_RsaSSL_Sign(msg[i], msgLen[i], exp[i], RSA_TEST_BYTES,
+            keys[i], rng);
+        if (ret != sz)
+            ERROR_OUT(WC_TEST_RET_ENC_EC(ret), exit_rsa_batch);
+    }
+
+    for (j = 0; j < (int)(sizeof(cnts) / sizeof(*cnts)); j++) {
+        XMEMSET(buf + RSA_BATCH_TEST_CNT * RSA_TEST_BYTES, 0,
+            RSA_BATCH_TEST_CNT * RSA_TEST_BYTES);
+        ret = wc_RsaSSL_SignBatch(msg, msgLen, sig, RSA_TEST_BYTES, keys,
+            cnts[j], rng);
+        if (ret != sz)
+            ERROR_OUT(WC_TEST_RET_ENC_EC(ret), exit_rsa_batch);
+        for (i = 0; i < cnts[j]; i++) {
+            if (XMEMCMP(sig[i], exp[i], (size_t)sz) != 0)
+                ERROR_OUT(WC_TEST_RET_ENC_I(j * RSA_BATCH_TEST_CNT + i),
+                    exit_rsa_batch);
+        }
+    }
+
+    /* Only private operations are batched. */
+    ret = wc_RsaFunctionBatch((const byte* const*)exp, exp, (word32)sz,
+        RSA_PUBLIC_DECRYPT, keys, 2, rng);
+    if (ret != BAD_FUNC_ARG)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), exit_rsa_batch);
+    /* Raw private decrypt, in place, of encrypted signatures. */
+    for (i = 0; i < 2; i++) {
+        word32 outLen = (word32)sz;
+
+        ret = wc_RsaFunction(exp[i], (word32)sz, sig[i], &outLen,
+            RSA_PUBLIC_ENCRYPT, keys[i], rng);
+        if (ret != 0)
+            ERROR_OUT(WC_TEST_RET_ENC_EC(ret), exit_rsa_batch);
+    }
+    ret = wc_RsaFunctionBatch((const byte* const*)sig, sig, (word32)sz,
+        RSA_PRIVATE_DECRYPT, keys, 2, rng);
+    if (ret != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), exit_rsa_batch);
+    for (i = 0; i < 2; i++) {
+        if (XMEMCMP(sig[i], exp[i], (size_t)sz) != 0)
+            ERROR_OUT(WC_TEST_RET_ENC_I(i), exit_rsa_batch);
+    }
+
+    ret = wc_RsaSSL_SignBatch(msg, msgLen, sig, RSA_TEST_BYTES, keys, 0, rng);
+    if (ret != BAD_FUNC_ARG)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), exit_rsa_batch);
+    ret = wc_RsaSSL_SignBatch(msg, msgLen, sig, (word32)sz - 1, keys, 1, rng);
+    if (ret != RSA_BUFFER_E)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), exit_rsa_batch);
+    ret = 0;
+
+exit_rsa_batch:
+    wc_FreeRsaKey(&other[0]);
+    wc_FreeRsaKey(&other[1]);
+    WC_FREE_VAR(other, HEAP_HINT);
+    WC_FREE_VAR(buf, HEAP_HINT);
+    return ret;
+}
+#endif
+
 #if !defined(HAVE_USER_RSA) && !defined(NO_ASN)
 static wc_test_ret_t rsa_decode_test(RsaKey* keyPub)
 {
@@ -18535,6 +20180,106 @@ exit_rsa:
 }
 #endif
 
+#if defined(WOLFSSL_RSA_MULTI_PRIME) && defined(WOLFSSL_KEY_GEN)
+/* Generate a three prime key, check it signs, decrypts and survives a DER
+ * round trip with its OtherPrimeInfos intact. */
+static wc_test_ret_t rsa_multi_prime_test(WC_RNG* rng)
+{
+    wc_test_ret_t ret;
+    int sigSz;
+    int derSz;
+    word32 idx;
+    const char inStr[] = TEST_STRING;
+    const word32 inLen = (word32)TEST_STRING_SZ;
+    WC_DECLARE_VAR(key, RsaKey, 2, HEAP_HINT);
+    WC_DECLARE_VAR(sig, byte, RSA_TEST_BYTES, HEAP_HINT);
+    WC_DECLARE_VAR(out, byte, RSA_TEST_BYTES, HEAP_HINT);
+    byte* der = NULL;
+
+#ifdef WC_DECLARE_VAR_IS_HEAP_ALLOC
+    if (key == NULL || sig == NULL || out == NULL)
+        return WC_TEST_RET_ENC_ERRNO;
+#endif
+    XMEMSET(key, 0, sizeof(RsaKey) * 2);
+
+    ret = wc_InitRsaKey_ex(&key[0], HEAP_HINT, devId);
+    if (ret == 0)
+        ret = wc_InitRsaKey_ex(&key[1], HEAP_HINT, devId);
+    if (ret != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), exit_rsa_mp);
+
+    /* Too many primes for the size. */
+    ret = wc_MakeRsaKeyMultiPrime(&key[0], 2048, WC_RSA_EXPONENT, 4, rng);
+    if (ret != BAD_FUNC_ARG)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), exit_rsa_mp);
+
+    ret = wc_MakeRsaKeyMultiPrime(&key[0], 2048, WC_RSA_EXPONENT, 3, rng);
+    if (ret != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), exit_rsa_mp);
+    if (key[0].otherPrimes != 1 || wc_RsaEncryptSize(&key[0]) != 256)
+        ERROR_OUT(WC_TEST_RET_ENC_NC, exit_rsa_mp);
+#ifdef WC_RSA_BLINDING
+    ret = wc_RsaSetRNG(&key[0], rng);
+    if (ret == 0)
+        ret = wc_RsaSetRNG(&key[1], rng);
+    if (ret != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), exit_rsa_mp);
+#endif
+#ifdef WOLFSSL_RSA_KEY_CHECK
+    ret = wc_CheckRsaKey(&key[0]);
+    if (ret != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), exit_rsa_mp);
+#endif
+
+    ret = wc_RsaPublicEncrypt((const byte*)inStr, inLen, sig, RSA_TEST_BYTES,
+        &key[0], rng);
+    if (ret < 0)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), exit_rsa_mp);
+    ret = wc_RsaPrivateDecrypt(sig, (word32)ret, out, RSA_TEST_BYTES,
+        &key[0]);
+    if (ret != (int)inLen || XMEMCMP(out, inStr, inLen) != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_NC, exit_rsa_mp);
+
+    ret = wc_RsaSSL_Sign((const byte*)inStr, inLen, sig, RSA_TEST_BYTES,
+        &key[0], rng);
+    if (ret < 0)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), exit_rsa_mp);
+    sigSz = (int)ret;
+    ret = wc_RsaSSL_Verify(sig, (word32)sigSz, out, RSA_TEST_BYTES, &key[0]);
+    if (ret != (int)inLen || XMEMCMP(out, inStr, inLen) != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_NC, exit_rsa_mp);
+
+    der = (byte*)XMALLOC(FOURK_BUF, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+    if (der == NULL)
+        ERROR_OUT(WC_TEST_RET_ENC_ERRNO, exit_rsa_mp);
+    derSz = wc_RsaKeyToDer(&key[0], der, FOURK_BUF);
+    if (derSz < 0)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(derSz), exit_rsa_mp);
+    idx = 0;
+    ret = wc_RsaPrivateKeyDecode(der, &idx, &key[1], (word32)derSz);
+    if (ret != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), exit_rsa_mp);
+    if (key[1].otherPrimes != 1 || idx != (word32)derSz)
+        ERROR_OUT(WC_TEST_RET_ENC_NC, exit_rsa_mp);
+
+    /* PKCS #1 v1.5 signatures are deterministic. */
+    ret = wc_RsaSSL_Sign((const byte*)inStr, inLen, out, RSA_TEST_BYTES,
+        &key[1], rng);
+    if (ret != sigSz || XMEMCMP(out, sig, (size_t)sigSz) != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_NC, exit_rsa_mp);
+    ret = 0;
+
+exit_rsa_mp:
+    XFREE(der, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+    wc_FreeRsaKey(&key[0]);
+    wc_FreeRsaKey(&key[1]);
+    WC_FREE_VAR(out, HEAP_HINT);
+    WC_FREE_VAR(sig, HEAP_HINT);
+    WC_FREE_VAR(key, HEAP_HINT);
+    return ret;
+}
+#endif
+
 #ifndef WOLFSSL_RSA_VERIFY_ONLY
 #if !defined(WC_NO_RSA_OAEP) && !defined(WC_NO_RNG) && \
     !defined(HAVE_FAST_RSA) && !defined(HAVE_USER_RSA) && \
@@ -19047,6 +20792,19 @@ WOLFSSL_TEST_SUBROUTINE wc_test_ret_t rsa_test(void)
         goto exit_rsa;
 #endif
 
+#if defined(WC_RSA_BLINDING_CACHE) && !defined(WC_NO_RNG) && \
+    !defined(WOLFSSL_RSA_PUBLIC_ONLY) && !defined(WOLFSSL_RSA_VERIFY_ONLY)
+    ret = rsa_blinding_cache_test(key, in, inLen, out, outSz, &rng);
+    if (ret != 0)
+        goto exit_rsa;
+#endif
+
+#if defined(WC_RSA_BATCH) && !defined(WC_NO_RNG)
+    ret = rsa_batch_test(key, in, inLen, &rng);
+    if (ret != 0)
+        goto exit_rsa;
+#endif
+
 #if !defined(WOLFSSL_RSA_VERIFY_ONLY) && !defined(WOLFSSL_RSA_PUBLIC_ONLY) && \
     !defined(WC_NO_RNG) && !defined(WOLF_CRYPTO_CB_ONLY_RSA)
     do {
@@ -19342,6 +21100,12 @@ WOLFSSL_TEST_SUBROUTINE wc_test_ret_t rsa_test(void)
         goto exit_rsa;
 #endif
 
+#if defined(WOLFSSL_RSA_MULTI_PRIME) && defined(WOLFSSL_KEY_GEN)
+    ret = rsa_multi_prime_test(&rng);
+    if (ret != 0)
+        goto exit_rsa;
+#endif
+
 #if defined(WOLFSSL_CERT_GEN) && !defined(NO_ASN_TIME)
     /* Make Cert / Sign example for RSA cert and RSA CA */
     ret = rsa_certgen_test(key, keypub, &rng, tmp);
@@ -19964,6 +21728,59 @@ static wc_test_ret_t dh_test_check_pubvalue(void)
 #if !(defined(HAVE_FIPS_VERSION) && (HAVE_FIPS_VERSION == 2) && \
       (defined(WOLFSSL_SP_ARM64_ASM) || defined(WOLFSSL_SP_ARM32_ASM)))
 
+#if defined(WOLFSSL_DH_COMB) && !defined(HAVE_SELFTEST)
+/* Compare a public key made with a comb table against the generic
+ * exponentiation: agreeing with a peer public value of g gives g^x mod p.
+ * Key generation alternates between two keys of the same group so the table
+ * built lazily by the first is shared with the second. */
+static wc_test_ret_t dh_ffdhe_comb_test(WC_RNG *rng, DhKey* key, DhKey* key2,
+    word32 privLen, byte* priv, byte* pub, byte* agree)
+{
+    wc_test_ret_t ret = 0;
+    int i;
+    word32 privSz;
+    word32 pubSz;
+    word32 agreeSz;
+    word32 pubOff;
+    word32 agreeOff;
+    const byte g[1] = { 0x02 };
+
+    for (i = 0; i < 4; i++) {
+        DhKey* gen = (i & 1) ? key2 : key;
+        DhKey* other = (i & 1) ? key : key2;
+
+        privSz = privLen;
+        pubSz = MAX_DH_KEY_SZ;
+        ret = wc_DhGenerateKeyPair(gen, rng, priv, &privSz, pub, &pubSz);
+    #if defined(WOLFSSL_ASYNC_CRYPT)
+        ret = wc_AsyncWait(ret, &gen->asyncDev, WC_ASYNC_FLAG_NONE);
+    #endif
+        if (ret != 0)
+            return WC_TEST_RET_ENC_EC(ret);
+
+        agreeSz = MAX_DH_KEY_SZ;
+        ret = wc_DhAgree(other, agree, &agreeSz, priv, privSz, g, sizeof(g));
+    #if defined(WOLFSSL_ASYNC_CRYPT)
+        ret = wc_AsyncWait(ret, &other->asyncDev, WC_ASYNC_FLAG_NONE);
+    #endif
+        if (ret != 0)
+            return WC_TEST_RET_ENC_EC(ret);
+
+        /* Either may have leading zeros. */
+        for (pubOff = 0; (pubOff < pubSz) && (pub[pubOff] == 0); pubOff++) {
+        }
+        for (agreeOff = 0; (agreeOff < agreeSz) && (agree[agreeOff] == 0);
+                agreeOff++) {
+        }
+        if ((pubSz - pubOff != agreeSz - agreeOff) ||
+                (XMEMCMP(pub + pubOff, agree + agreeOff, pubSz - pubOff) != 0))
+            return WC_TEST_RET_ENC_I(i);
+    }
+
+    return 0;
+}
+#endif
+
 #ifdef HAVE_PUBLIC_FFDHE
 static wc_test_ret_t dh_ffdhe_test(WC_RNG *rng, const DhParams* params)
 #else
@@ -20075,6 +21892,22 @@ static wc_test_ret_t dh_ffdhe_test(WC_RNG *rng, int name)
         ERROR_OUT(WC_TEST_RET_ENC_NC, done);
     }
 
+#if defined(WOLFSSL_DH_COMB) && !defined(HAVE_SELFTEST)
+    /* Second key pair was generated with the cached comb table. */
+    ret = wc_DhCheckKeyPair(key2, pub2, pubSz2, priv2, privSz2);
+    if (ret != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), done);
+
+    #ifdef HAVE_PUBLIC_FFDHE
+    ret = dh_ffdhe_comb_test(rng, key, key2, MAX_DH_PRIV_SZ, priv, pub, agree);
+    #else
+    ret = dh_ffdhe_comb_test(rng, key, key2, wc_DhGetNamedKeyMinSize(name),
+        priv, pub, agree);
+    #endif
+    if (ret != 0)
+        goto done;
+#endif
+
 #if defined(WOLFSSL_HAVE_SP_DH) || defined(USE_FAST_MATH)
     /* Make p even */
     key->p.dp[0] &= (mp_digit)-2;
@@ -30070,6 +31903,473 @@ static int ecc_test_raw_enc_dec(void)
 }
 #endif
 
+#if defined(WOLFSSL_ECC_FP_SHARED) && !defined(WOLFSSL_HAVE_SP_ECC) && \
+    defined(HAVE_ECC_SIGN) && defined(HAVE_ECC_VERIFY) && \
+    (!defined(NO_ECC256) || defined(HAVE_ALL_CURVES)) && ECC_MIN_KEY_SZ <= 256
+#if !defined(SINGLE_THREADED) && defined(HAVE_ECC_DHE)
+/* More points than the default of 15 FP_ENTRIES so entries are evicted. */
+#define ECC_FP_SHARED_TEST_PTS      24
+#define ECC_FP_SHARED_TEST_THREADS  4
+#define ECC_FP_SHARED_TEST_ROUNDS   4
+
+typedef struct ecc_fp_shared_thread_t {
+    ecc_key*    key;                /* this thread's private key */
+    ecc_key*    peer;               /* ECC_FP_SHARED_TEST_PTS public keys */
+    const byte* expect;             /* secrets with each peer, not cached */
+    word32      expectSz;
+    int         start;
+    wc_test_ret_t ret;
+} ecc_fp_shared_thread_t;
+
+static THREAD_RETURN WOLFSSL_THREAD ecc_fp_shared_thread(void* arg)
+{
+    ecc_fp_shared_thread_t* t = (ecc_fp_shared_thread_t*)arg;
+    byte   secret[MAX_ECC_BYTES];
+    word32 secretSz;
+    int    i;
+    int    p;
+    int    ret;
+
+    t->ret = 0;
+    for (i = 0; i < ECC_FP_SHARED_TEST_ROUNDS * ECC_FP_SHARED_TEST_PTS; i++) {
+        p = (t->start + i) % ECC_FP_SHARED_TEST_PTS;
+        secretSz = (word32)sizeof(secret);
+        PRIVATE_KEY_UNLOCK();
+        ret = wc_ecc_shared_secret(t->key, &t->peer[p], secret, &secretSz);
+        PRIVATE_KEY_LOCK();
+        if (ret != 0) {
+            t->ret = WC_TEST_RET_ENC_EC(ret);
+            break;
+        }
+        if (secretSz != t->expectSz ||
+                XMEMCMP(secret, t->expect + p * MAX_ECC_BYTES, secretSz) != 0) {
+            t->ret = WC_TEST_RET_ENC_I(i);
+            break;
+        }
+    }
+
+    WOLFSSL_RETURN_FROM_THREAD(0);
+}
+
+/* Several threads find, build and evict entries of the shared cache at once.
+ * Every secret must match the one made by a normal multiply. */
+static wc_test_ret_t ecc_fp_shared_thread_test(void)
+{
+    wc_test_ret_t ret = 0;
+    ecc_key* key = NULL;
+    ecc_key* peer;
+    WC_RNG* rng = NULL;
+    byte* expect = NULL;
+    ecc_fp_shared_thread_t t[ECC_FP_SHARED_TEST_THREADS];
+    THREAD_TYPE tid[ECC_FP_SHARED_TEST_THREADS];
+    int started[ECC_FP_SHARED_TEST_THREADS];
+    int keyCnt = ECC_FP_SHARED_TEST_THREADS + ECC_FP_SHARED_TEST_PTS;
+    word32 secretSz = 0;
+    word32 hits;
+    word32 misses;
+    int i;
+    int p;
+
+    XMEMSET(started, 0, sizeof(started));
+    key = (ecc_key*)XMALLOC(sizeof(ecc_key) * (size_t)keyCnt, HEAP_HINT,
+        DYNAMIC_TYPE_ECC);
+    rng = (WC_RNG*)XMALLOC(sizeof(WC_RNG) * ECC_FP_SHARED_TEST_THREADS,
+        HEAP_HINT, DYNAMIC_TYPE_RNG);
+    expect = (byte*)XMALLOC(ECC_FP_SHARED_TEST_THREADS *
+        ECC_FP_SHARED_TEST_PTS * MAX_ECC_BYTES, HEAP_HINT,
+        DYNAMIC_TYPE_TMP_BUFFER);
+    if (key == NULL || rng == NULL || expect == NULL) {
+        XFREE(key, HEAP_HINT, DYNAMIC_TYPE_ECC);
+        XFREE(rng, HEAP_HINT, DYNAMIC_TYPE_RNG);
+        XFREE(expect, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+        return WC_TEST_RET_ENC_ERRNO;
+    }
+    XMEMSET(key, 0, sizeof(ecc_key) * (size_t)keyCnt);
+    XMEMSET(rng, 0, sizeof(WC_RNG) * ECC_FP_SHARED_TEST_THREADS);
+    peer = key + ECC_FP_SHARED_TEST_THREADS;
+
+    /* Each thread has its own RNG for blinding. */
+    for (i = 0; i < ECC_FP_SHARED_TEST_THREADS; i++) {
+    #ifndef HAVE_FIPS
+        ret = wc_InitRng_ex(&rng[i], HEAP_HINT, devId);
+    #else
+        ret = wc_InitRng(&rng[i]);
+    #endif
+        if (ret != 0)
+            ERROR_OUT(WC_TEST_RET_ENC_EC(ret), done);
+    }
+    for (i = 0; i < keyCnt; i++) {
+        ret = wc_ecc_init_ex(&key[i], HEAP_HINT, devId);
+        if (ret != 0)
+            ERROR_OUT(WC_TEST_RET_ENC_EC(ret), done);
+        ret = wc_ecc_make_key_ex(&rng[0], 32, &key[i], ECC_SECP256R1);
+        if (ret != 0)
+            ERROR_OUT(WC_TEST_RET_ENC_EC(ret), done);
+    }
+#if defined(ECC_TIMING_RESISTANT) && (!defined(HAVE_FIPS) || \
+    (!defined(HAVE_FIPS_VERSION) || (HAVE_FIPS_VERSION != 2))) && \
+    !defined(HAVE_SELFTEST)
+    for (i = 0; i < ECC_FP_SHARED_TEST_THREADS; i++) {
+        ret = wc_ecc_set_rng(&key[i], &rng[i]);
+        if (ret != 0)
+            ERROR_OUT(WC_TEST_RET_ENC_EC(ret), done);
+    }
+#endif
+
+    /* Emptying the cache before each multiply means no LUT is ever used. */
+    for (i = 0; i < ECC_FP_SHARED_TEST_THREADS; i++) {
+        for (p = 0; p < ECC_FP_SHARED_TEST_PTS; p++) {
+            wc_ecc_fp_free();
+            secretSz = MAX_ECC_BYTES;
+            PRIVATE_KEY_UNLOCK();
+            ret = wc_ecc_shared_secret(&key[i], &peer[p],
+                expect + (i * ECC_FP_SHARED_TEST_PTS + p) * MAX_ECC_BYTES,
+                &secretSz);
+            PRIVATE_KEY_LOCK();
+            if (ret != 0)
+                ERROR_OUT(WC_TEST_RET_ENC_EC(ret), done);
+        }
+    }
+    ret = wc_ecc_fp_stats(&hits, &misses);
+    if (ret != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), done);
+    if (hits != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_NC, done);
+    wc_ecc_fp_free();
+
+    for (i = 0; i < ECC_FP_SHARED_TEST_THREADS; i++) {
+        t[i].key = &key[i];
+        t[i].peer = peer;
+        t[i].expect = expect + i * ECC_FP_SHARED_TEST_PTS * MAX_ECC_BYTES;
+        t[i].expectSz = secretSz;
+        t[i].start = i * (ECC_FP_SHARED_TEST_PTS / ECC_FP_SHARED_TEST_THREADS);
+        t[i].ret = WC_TEST_RET_ENC_NC;
+        started[i] = (wolfSSL_NewThread(&tid[i], ecc_fp_shared_thread,
+            &t[i]) == 0);
+        if (!started[i])
+            ERROR_OUT(WC_TEST_RET_ENC_I(i), done);
+    }
+    for (i = 0; i < ECC_FP_SHARED_TEST_THREADS; i++) {
+        if (started[i]) {
+            (void)wolfSSL_JoinThread(tid[i]);
+            started[i] = 0;
+            if (t[i].ret != 0)
+                ERROR_OUT(t[i].ret, done);
+        }
+    }
+
+    /* Tables must have been built and used, and points must have missed. */
+    ret = wc_ecc_fp_stats(&hits, &misses);
+    if (ret != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), done);
+    if (hits == 0 || misses == 0)
+        ERROR_OUT(WC_TEST_RET_ENC_NC, done);
+
+done:
+    for (i = 0; i < ECC_FP_SHARED_TEST_THREADS; i++) {
+        if (started[i])
+            (void)wolfSSL_JoinThread(tid[i]);
+    }
+    for (i = 0; i < keyCnt; i++) {
+        wc_ecc_free(&key[i]);
+    }
+    for (i = 0; i < ECC_FP_SHARED_TEST_THREADS; i++) {
+        wc_FreeRng(&rng[i]);
+    }
+    XFREE(key, HEAP_HINT, DYNAMIC_TYPE_ECC);
+    XFREE(rng, HEAP_HINT, DYNAMIC_TYPE_RNG);
+    XFREE(expect, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+    wc_ecc_fp_free();
+    return ret;
+}
+#endif /* !SINGLE_THREADED && HAVE_ECC_DHE */
+
+
+static wc_test_ret_t ecc_fp_shared_test(WC_RNG* rng)
+{
+    wc_test_ret_t ret;
+#if defined(WOLFSSL_SMALL_STACK) && !defined(WOLFSSL_NO_MALLOC)
+    ecc_key *key = (ecc_key *)XMALLOC(sizeof(*key), HEAP_HINT,
+        DYNAMIC_TYPE_ECC);
+#else
+    ecc_key key[1];
+#endif
+    byte   hash[WC_SHA256_DIGEST_SIZE];
+    byte   sig[ECC_MAX_SIG_SIZE];
+    word32 sigSz = (word32)sizeof(sig);
+    word32 hits;
+    word32 misses;
+    int    verify;
+    int    i;
+
+#if defined(WOLFSSL_SMALL_STACK) && !defined(WOLFSSL_NO_MALLOC)
+    if (key == NULL)
+        return WC_TEST_RET_ENC_ERRNO;
+#endif
+
+    XMEMSET(hash, 0x5a, sizeof(hash));
+    ret = wc_ecc_init_ex(key, HEAP_HINT, devId);
+    if (ret != 0) {
+    #if defined(WOLFSSL_SMALL_STACK) && !defined(WOLFSSL_NO_MALLOC)
+        XFREE(key, HEAP_HINT, DYNAMIC_TYPE_ECC);
+    #endif
+        return WC_TEST_RET_ENC_EC(ret);
+    }
+
+    /* Start with an empty cache. */
+    wc_ecc_fp_free();
+    ret = wc_ecc_fp_stats(&hits, &misses);
+    if (ret != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), done);
+    if (hits != 0 || misses != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_NC, done);
+    if (wc_ecc_fp_stats(NULL, &misses) != BAD_FUNC_ARG)
+        ERROR_OUT(WC_TEST_RET_ENC_NC, done);
+
+    ret = wc_ecc_make_key_ex(rng, 32, key, ECC_SECP256R1);
+#if defined(WOLFSSL_ASYNC_CRYPT)
+    ret = wc_AsyncWait(ret, &key->asyncDev, WC_ASYNC_FLAG_NONE);
+#endif
+    if (ret != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), done);
+    ret = wc_ecc_sign_hash(hash, sizeof(hash), sig, &sigSz, rng, key);
+    if (ret != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), done);
+
+    /* Tables are built on the second use of a point and then used. */
+    for (i = 0; i < 4; i++) {
+        verify = 0;
+        ret = wc_ecc_verify_hash(sig, sigSz, hash, sizeof(hash), &verify, key);
+        if (ret != 0)
+            ERROR_OUT(WC_TEST_RET_ENC_EC(ret), done);
+        if (verify != 1)
+            ERROR_OUT(WC_TEST_RET_ENC_I(i), done);
+    }
+    /* Corrupted hash must still fail with tables. */
+    hash[0] ^= 0x01;
+    ret = wc_ecc_verify_hash(sig, sigSz, hash, sizeof(hash), &verify, key);
+    if (ret != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), done);
+    if (verify != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_NC, done);
+
+    ret = wc_ecc_fp_stats(&hits, &misses);
+    if (ret != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), done);
+    if (hits == 0 || misses == 0)
+        ERROR_OUT(WC_TEST_RET_ENC_NC, done);
+
+#if !defined(SINGLE_THREADED) && defined(HAVE_ECC_DHE)
+    ret = ecc_fp_shared_thread_test();
+#endif
+
+done:
+    wc_ecc_free(key);
+#if defined(WOLFSSL_SMALL_STACK) && !defined(WOLFSSL_NO_MALLOC)
+    XFREE(key, HEAP_HINT, DYNAMIC_TYPE_ECC);
+#endif
+    return ret;
+}
+#endif /* WOLFSSL_ECC_FP_SHARED && !WOLFSSL_HAVE_SP_ECC */
+
+#ifdef WOLFSSL_ECC_KEYGEN_BATCH
+#define ECC_KEYGEN_BATCH_TEST_CNT   5
+static wc_test_ret_t ecc_keygen_batch_test(WC_RNG* rng, int keySz, int curveId)
+{
+    wc_test_ret_t ret = 0;
+    ecc_key* key[ECC_KEYGEN_BATCH_TEST_CNT];
+    int i;
+
+    XMEMSET(key, 0, sizeof(key));
+    for (i = 0; i < ECC_KEYGEN_BATCH_TEST_CNT; i++) {
+        key[i] = (ecc_key*)XMALLOC(sizeof(ecc_key), HEAP_HINT,
+            DYNAMIC_TYPE_ECC);
+        if (key[i] == NULL)
+            ERROR_OUT(WC_TEST_RET_ENC_ERRNO, done);
+        ret = wc_ecc_init_ex(key[i], HEAP_HINT, devId);
+        if (ret != 0) {
+            XFREE(key[i], HEAP_HINT, DYNAMIC_TYPE_ECC);
+            key[i] = NULL;
+            ERROR_OUT(WC_TEST_RET_ENC_EC(ret), done);
+        }
+    }
+
+    ret = wc_ecc_make_key_batch(rng, keySz, key, ECC_KEYGEN_BATCH_TEST_CNT,
+        curveId);
+    if (ret != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), done);
+
+    /* Each public key must be the private key times the base point. */
+    for (i = 0; i < ECC_KEYGEN_BATCH_TEST_CNT; i++) {
+        ret = wc_ecc_check_key(key[i]);
+        if (ret != 0)
+            ERROR_OUT(WC_TEST_RET_ENC_I(i), done);
+        if ((i > 0) && (wc_ecc_cmp_point(&key[i]->pubkey,
+                &key[i-1]->pubkey) == MP_EQ))
+            ERROR_OUT(WC_TEST_RET_ENC_I(i), done);
+    }
+
+    if (wc_ecc_make_key_batch(NULL, keySz, key, ECC_KEYGEN_BATCH_TEST_CNT,
+            curveId) != BAD_FUNC_ARG)
+        ERROR_OUT(WC_TEST_RET_ENC_NC, done);
+    ret = wc_ecc_make_key_batch(rng, keySz, key, 0, curveId);
+    if (ret != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), done);
+
+done:
+    for (i = 0; i < ECC_KEYGEN_BATCH_TEST_CNT; i++) {
+        if (key[i] != NULL) {
+            wc_ecc_free(key[i]);
+            XFREE(key[i], HEAP_HINT, DYNAMIC_TYPE_ECC);
+        }
+    }
+    return ret;
+}
+#endif /* WOLFSSL_ECC_KEYGEN_BATCH */
+
+#ifdef WOLFSSL_ECC_MULTI_SCALAR
+#define ECC_MULTI_SCALAR_TEST_CNT   20
+static wc_test_ret_t ecc_multi_scalar_test(WC_RNG* rng, int keySz, int curveId)
+{
+    wc_test_ret_t ret = 0;
+    ecc_key* key = NULL;
+    ecc_key* one = NULL;
+    mp_int* k[ECC_MULTI_SCALAR_TEST_CNT];
+    ecc_point* g[ECC_MULTI_SCALAR_TEST_CNT];
+    ecc_point* r[3] = { NULL, NULL, NULL };
+    byte oneByte = 0x01;
+    byte der[1 + 2 * MAX_ECC_BYTES];
+    word32 derSz;
+#ifdef HAVE_ECC_DHE
+    byte secret[MAX_ECC_BYTES];
+    word32 secretSz;
+#endif
+    int curveIdx = wc_ecc_get_curve_idx(curveId);
+    int half = ECC_MULTI_SCALAR_TEST_CNT / 2;
+    int i;
+
+    key = (ecc_key*)XMALLOC(sizeof(ecc_key) * (ECC_MULTI_SCALAR_TEST_CNT + 1),
+        HEAP_HINT, DYNAMIC_TYPE_ECC);
+    if (key == NULL)
+        ERROR_OUT(WC_TEST_RET_ENC_ERRNO, done);
+    XMEMSET(key, 0, sizeof(ecc_key) * (ECC_MULTI_SCALAR_TEST_CNT + 1));
+    one = &key[ECC_MULTI_SCALAR_TEST_CNT];
+    for (i = 0; i <= ECC_MULTI_SCALAR_TEST_CNT; i++) {
+        ret = wc_ecc_init_ex(&key[i], HEAP_HINT, devId);
+        if (ret != 0)
+            ERROR_OUT(WC_TEST_RET_ENC_EC(ret), done);
+    }
+    for (i = 0; i < 3; i++) {
+        r[i] = wc_ecc_new_point_h(HEAP_HINT);
+        if (r[i] == NULL)
+            ERROR_OUT(WC_TEST_RET_ENC_ERRNO, done);
+    }
+
+    for (i = 0; i < ECC_MULTI_SCALAR_TEST_CNT; i++) {
+        ret = wc_ecc_make_key_ex(rng, keySz, &key[i], curveId);
+        if (ret != 0)
+            ERROR_OUT(WC_TEST_RET_ENC_EC(ret), done);
+        k[i] = wc_ecc_key_get_priv(&key[i]);
+        g[i] = &key[i].pubkey;
+    }
+    ret = wc_ecc_import_private_key_ex(&oneByte, 1, NULL, 0, one, curveId);
+    if (ret != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), done);
+
+#ifdef HAVE_ECC_DHE
+    /* One point: X ordinate must match the ECDH shared secret. */
+    ret = wc_ecc_mulmod_multi(k, &g[1], r[0], 1, curveId, HEAP_HINT);
+    if (ret != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), done);
+#if defined(ECC_TIMING_RESISTANT) && (!defined(HAVE_FIPS) || \
+    (!defined(HAVE_FIPS_VERSION) || (HAVE_FIPS_VERSION != 2))) && \
+    !defined(HAVE_SELFTEST)
+    ret = wc_ecc_set_rng(&key[0], rng);
+    if (ret != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), done);
+#endif
+    secretSz = sizeof(secret);
+    ret = wc_ecc_shared_secret(&key[0], &key[1], secret, &secretSz);
+    if (ret != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), done);
+    derSz = sizeof(der);
+    ret = wc_ecc_export_point_der(curveIdx, r[0], der, &derSz);
+    if (ret != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), done);
+    if (XMEMCMP(der + 1, secret, secretSz) != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_NC, done);
+#endif
+
+    /* All points must equal the sum of the two halves. */
+    ret = wc_ecc_mulmod_multi(k, g, r[0], ECC_MULTI_SCALAR_TEST_CNT, curveId,
+        HEAP_HINT);
+    if (ret != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), done);
+    ret = wc_ecc_mulmod_multi(k, g, r[1], (word32)half, curveId, HEAP_HINT);
+    if (ret != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), done);
+    ret = wc_ecc_mulmod_multi(k + half, g + half, r[2],
+        (word32)(ECC_MULTI_SCALAR_TEST_CNT - half), curveId, HEAP_HINT);
+    if (ret != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), done);
+    k[0] = wc_ecc_key_get_priv(one);
+    k[1] = wc_ecc_key_get_priv(one);
+    ret = wc_ecc_mulmod_multi(k, &r[1], r[1], 2, curveId, HEAP_HINT);
+    if (ret != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), done);
+    if (wc_ecc_cmp_point(r[0], r[1]) != MP_EQ)
+        ERROR_OUT(WC_TEST_RET_ENC_NC, done);
+
+    /* Same point twice: k.P + k.P must equal 1.kP + 1.kP. */
+    k[0] = wc_ecc_key_get_priv(&key[2]);
+    k[1] = wc_ecc_key_get_priv(&key[2]);
+    g[0] = &key[3].pubkey;
+    g[1] = &key[3].pubkey;
+    ret = wc_ecc_mulmod_multi(k, g, r[0], 1, curveId, HEAP_HINT);
+    if (ret != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), done);
+    ret = wc_ecc_mulmod_multi(k, g, r[2], 2, curveId, HEAP_HINT);
+    if (ret != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), done);
+    k[0] = wc_ecc_key_get_priv(one);
+    k[1] = wc_ecc_key_get_priv(one);
+    g[0] = r[0];
+    g[1] = r[0];
+    ret = wc_ecc_mulmod_multi(k, g, r[1], 2, curveId, HEAP_HINT);
+    if (ret != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), done);
+    if (wc_ecc_cmp_point(r[1], r[2]) != MP_EQ)
+        ERROR_OUT(WC_TEST_RET_ENC_NC, done);
+
+    /* No points is the point at infinity. */
+    ret = wc_ecc_mulmod_multi(k, g, r[0], 0, curveId, HEAP_HINT);
+    if (ret != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), done);
+    if (!wc_ecc_point_is_at_infinity(r[0]))
+        ERROR_OUT(WC_TEST_RET_ENC_NC, done);
+
+    if (wc_ecc_mulmod_multi(NULL, g, r[0], 1, curveId, HEAP_HINT) !=
+            BAD_FUNC_ARG)
+        ERROR_OUT(WC_TEST_RET_ENC_NC, done);
+    if (wc_ecc_mulmod_multi(k, g, NULL, 1, curveId, HEAP_HINT) !=
+            BAD_FUNC_ARG)
+        ERROR_OUT(WC_TEST_RET_ENC_NC, done);
+    ret = 0;
+
+done:
+    for (i = 0; i < 3; i++) {
+        if (r[i] != NULL)
+            wc_ecc_del_point_h(r[i], HEAP_HINT);
+    }
+    if (key != NULL) {
+        for (i = 0; i <= ECC_MULTI_SCALAR_TEST_CNT; i++)
+            wc_ecc_free(&key[i]);
+        XFREE(key, HEAP_HINT, DYNAMIC_TYPE_ECC);
+    }
+    return ret;
+}
+#endif /* WOLFSSL_ECC_MULTI_SCALAR */
+
 WOLFSSL_TEST_SUBROUTINE wc_test_ret_t ecc_test(void)
 {
     wc_test_ret_t ret;
@@ -30157,6 +32457,28 @@ WOLFSSL_TEST_SUBROUTINE wc_test_ret_t ecc_test(void)
         goto done;
     }
 #endif
+#if defined(WOLFSSL_ECC_FP_SHARED) && !defined(WOLFSSL_HAVE_SP_ECC) && \
+    defined(HAVE_ECC_SIGN) && defined(HAVE_ECC_VERIFY)
+    ret = ecc_fp_shared_test(&rng);
+    if (ret < 0) {
+        printf("FP shared cache\n");
+        goto done;
+    }
+#endif
+#ifdef WOLFSSL_ECC_KEYGEN_BATCH
+    ret = ecc_keygen_batch_test(&rng, 32, ECC_SECP256R1);
+    if (ret < 0) {
+        printf("keySize=32, Batch\n");
+        goto done;
+    }
+#endif
+#ifdef WOLFSSL_ECC_MULTI_SCALAR
+    ret = ecc_multi_scalar_test(&rng, 32, ECC_SECP256R1);
+    if (ret < 0) {
+        printf("keySize=32, Multi-scalar\n");
+        goto done;
+    }
+#endif
 #endif /* !NO_ECC256 */
 #if (defined(HAVE_ECC320) || defined(HAVE_ALL_CURVES)) && ECC_MIN_KEY_SZ <= 320
     ret = ecc_test_curve(&rng, 40, ECC_CURVE_DEF);
@@ -30171,6 +32493,20 @@ WOLFSSL_TEST_SUBROUTINE wc_test_ret_t ecc_test(void)
         printf("keySize=48, Default\n");
         goto done;
     }
+#ifdef WOLFSSL_ECC_KEYGEN_BATCH
+    ret = ecc_keygen_batch_test(&rng, 48, ECC_SECP384R1);
+    if (ret < 0) {
+        printf("keySize=48, Batch\n");
+        goto done;
+    }
+#endif
+#ifdef WOLFSSL_ECC_MULTI_SCALAR
+    ret = ecc_multi_scalar_test(&rng, 48, ECC_SECP384R1);
+    if (ret < 0) {
+        printf("keySize=48, Multi-scalar\n");
+        goto done;
+    }
+#endif
 #endif /* HAVE_ECC384 */
 #if (defined(HAVE_ECC512) || defined(HAVE_ALL_CURVES)) && ECC_MIN_KEY_SZ <= 512
     ret = ecc_test_curve(&rng, 64, ECC_CURVE_DEF);
@@ -32267,6 +34603,197 @@ static wc_test_ret_t ed25519ph_test(void)
 }
 #endif /* HAVE_ED25519_SIGN && HAVE_ED25519_KEY_EXPORT && HAVE_ED25519_KEY_IMPORT */
 
+#if defined(WOLFSSL_ED25519_BATCH_VERIFY) && defined(HAVE_ED25519_SIGN) && \
+    defined(HAVE_ED25519_VERIFY)
+#define ED25519_BATCH_TEST_KEYS     5
+/* More than one batch of signatures. */
+#define ED25519_BATCH_TEST_SIGS     67
+static wc_test_ret_t ed25519_batch_test(WC_RNG* rng)
+{
+    wc_test_ret_t ret = 0;
+    ed25519_key keys[ED25519_BATCH_TEST_KEYS];
+    ed25519_key* key[ED25519_BATCH_TEST_SIGS];
+    byte msgs[ED25519_BATCH_TEST_SIGS][16];
+    const byte* sig[ED25519_BATCH_TEST_SIGS];
+    const byte* msg[ED25519_BATCH_TEST_SIGS];
+    word32 sigLen[ED25519_BATCH_TEST_SIGS];
+    word32 msgLen[ED25519_BATCH_TEST_SIGS];
+    int res[ED25519_BATCH_TEST_SIGS];
+    byte* sigs = NULL;
+    int i;
+
+    XMEMSET(keys, 0, sizeof(keys));
+    for (i = 0; i < ED25519_BATCH_TEST_KEYS; i++) {
+        ret = wc_ed25519_init_ex(&keys[i], HEAP_HINT, devId);
+        if (ret != 0)
+            ERROR_OUT(WC_TEST_RET_ENC_EC(ret), done);
+        ret = wc_ed25519_make_key(rng, ED25519_KEY_SIZE, &keys[i]);
+        if (ret != 0)
+            ERROR_OUT(WC_TEST_RET_ENC_EC(ret), done);
+    }
+
+    sigs = (byte*)XMALLOC(ED25519_BATCH_TEST_SIGS * ED25519_SIG_SIZE, HEAP_HINT,
+        DYNAMIC_TYPE_TMP_BUFFER);
+    if (sigs == NULL)
+        ERROR_OUT(WC_TEST_RET_ENC_ERRNO, done);
+
+    for (i = 0; i < ED25519_BATCH_TEST_SIGS; i++) {
+        key[i] = &keys[i % ED25519_BATCH_TEST_KEYS];
+        XMEMSET(msgs[i], (byte)i, sizeof(msgs[i]));
+        msg[i] = msgs[i];
+        /* Include an empty message. */
+        msgLen[i] = (word32)(i % (int)sizeof(msgs[i]));
+        sig[i] = sigs + i * ED25519_SIG_SIZE;
+        sigLen[i] = ED25519_SIG_SIZE;
+        ret = wc_ed25519_sign_msg(msg[i], msgLen[i], sigs + i * ED25519_SIG_SIZE,
+            &sigLen[i], key[i]);
+        if (ret != 0)
+            ERROR_OUT(WC_TEST_RET_ENC_I(i), done);
+    }
+
+    ret = wc_ed25519_verify_msg_batch(sig, sigLen, msg, msgLen, key,
+        ED25519_BATCH_TEST_SIGS, res, rng);
+    if (ret != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), done);
+    for (i = 0; i < ED25519_BATCH_TEST_SIGS; i++) {
+        if (res[i] != 1)
+            ERROR_OUT(WC_TEST_RET_ENC_I(i), done);
+    }
+
+    /* Bad R, bad S and wrong message must only fail their own signature. */
+    sigs[2 * ED25519_SIG_SIZE] ^= 0x01;
+    sigs[40 * ED25519_SIG_SIZE + ED25519_SIG_SIZE/2] ^= 0x01;
+    msgs[65][0] ^= 0x01;
+    ret = wc_ed25519_verify_msg_batch(sig, sigLen, msg, msgLen, key,
+        ED25519_BATCH_TEST_SIGS, res, rng);
+    if (ret != SIG_VERIFY_E)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), done);
+    for (i = 0; i < ED25519_BATCH_TEST_SIGS; i++) {
+        if (res[i] != ((i == 2) || (i == 40) || (i == 65) ? 0 : 1))
+            ERROR_OUT(WC_TEST_RET_ENC_I(i), done);
+    }
+
+    ret = wc_ed25519_verify_msg_batch(sig, sigLen, msg, msgLen, key,
+        ED25519_BATCH_TEST_SIGS, res, NULL);
+    if (ret != BAD_FUNC_ARG)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), done);
+    ret = 0;
+
+done:
+    XFREE(sigs, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+    for (i = 0; i < ED25519_BATCH_TEST_KEYS; i++)
+        wc_ed25519_free(&keys[i]);
+
+    return ret;
+}
+#endif /* WOLFSSL_ED25519_BATCH_VERIFY && HAVE_ED25519_SIGN &&
+        * HAVE_ED25519_VERIFY */
+
+#if defined(WOLFSSL_ED25519_MULTI_SCALAR) && defined(HAVE_ED25519_KEY_EXPORT)
+#define ED25519_MULTI_TEST_KEYS     5
+/* Enough points to use Pippenger's method. */
+#define ED25519_MULTI_TEST_PTS      300
+static wc_test_ret_t ed25519_multi_scalar_test(WC_RNG* rng)
+{
+    wc_test_ret_t ret = 0;
+    ed25519_key key;
+    byte pub[ED25519_MULTI_TEST_KEYS * ED25519_PUB_KEY_SIZE];
+    byte sum[ED25519_MULTI_TEST_KEYS * ED25519_KEY_SIZE];
+    byte r[2][ED25519_PUB_KEY_SIZE];
+    byte* s = NULL;
+    byte* p = NULL;
+    word32 sz;
+    word32 carry;
+    int i;
+    int j;
+
+    ret = wc_ed25519_init_ex(&key, HEAP_HINT, devId);
+    if (ret != 0)
+        return WC_TEST_RET_ENC_EC(ret);
+    for (i = 0; i < ED25519_MULTI_TEST_KEYS; i++) {
+        ret = wc_ed25519_make_key(rng, ED25519_KEY_SIZE, &key);
+        if (ret != 0)
+            ERROR_OUT(WC_TEST_RET_ENC_EC(ret), done);
+        sz = ED25519_PUB_KEY_SIZE;
+        ret = wc_ed25519_export_public(&key, pub + i * ED25519_PUB_KEY_SIZE,
+            &sz);
+        if (ret != 0)
+            ERROR_OUT(WC_TEST_RET_ENC_EC(ret), done);
+    }
+
+    s = (byte*)XMALLOC(ED25519_MULTI_TEST_PTS * ED25519_KEY_SIZE, HEAP_HINT,
+        DYNAMIC_TYPE_TMP_BUFFER);
+    p = (byte*)XMALLOC(ED25519_MULTI_TEST_PTS * ED25519_PUB_KEY_SIZE,
+        HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+    if ((s == NULL) || (p == NULL))
+        ERROR_OUT(WC_TEST_RET_ENC_ERRNO, done);
+    ret = wc_RNG_GenerateBlock(rng, s, ED25519_MULTI_TEST_PTS *
+        ED25519_KEY_SIZE);
+    if (ret != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), done);
+
+    /* Scalars less than 2^245 so that the sums are less than 2^253. */
+    XMEMSET(sum, 0, sizeof(sum));
+    for (i = 0; i < ED25519_MULTI_TEST_PTS; i++) {
+        byte* si = s + i * ED25519_KEY_SIZE;
+        byte* t = sum + (i % ED25519_MULTI_TEST_KEYS) * ED25519_KEY_SIZE;
+
+        si[ED25519_KEY_SIZE - 1] = 0;
+        si[ED25519_KEY_SIZE - 2] &= 0x1f;
+        XMEMCPY(p + i * ED25519_PUB_KEY_SIZE,
+            pub + (i % ED25519_MULTI_TEST_KEYS) * ED25519_PUB_KEY_SIZE,
+            ED25519_PUB_KEY_SIZE);
+        carry = 0;
+        for (j = 0; j < ED25519_KEY_SIZE; j++) {
+            carry += (word32)t[j] + si[j];
+            t[j] = (byte)carry;
+            carry >>= 8;
+        }
+    }
+
+    /* Pippenger's method on repeated points must match Straus' method on
+     * the summed scalars. */
+    ret = wc_ed25519_mul_multi(r[0], s, p, ED25519_MULTI_TEST_PTS);
+    if (ret != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), done);
+    ret = wc_ed25519_mul_multi(r[1], sum, pub, ED25519_MULTI_TEST_KEYS);
+    if (ret != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), done);
+    if (XMEMCMP(r[0], r[1], ED25519_PUB_KEY_SIZE) != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_NC, done);
+
+    /* 1.P is P and no points is the identity. */
+    XMEMSET(sum, 0, ED25519_KEY_SIZE);
+    sum[0] = 1;
+    ret = wc_ed25519_mul_multi(r[0], sum, pub, 1);
+    if (ret != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), done);
+    if (XMEMCMP(r[0], pub, ED25519_PUB_KEY_SIZE) != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_NC, done);
+    ret = wc_ed25519_mul_multi(r[0], NULL, NULL, 0);
+    if (ret != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), done);
+    XMEMSET(r[1], 0, ED25519_PUB_KEY_SIZE);
+    r[1][0] = 1;
+    if (XMEMCMP(r[0], r[1], ED25519_PUB_KEY_SIZE) != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_NC, done);
+
+    sum[ED25519_KEY_SIZE - 1] = 0x80;
+    if (wc_ed25519_mul_multi(r[0], sum, pub, 1) != BAD_FUNC_ARG)
+        ERROR_OUT(WC_TEST_RET_ENC_NC, done);
+    if (wc_ed25519_mul_multi(NULL, sum, pub, 1) != BAD_FUNC_ARG)
+        ERROR_OUT(WC_TEST_RET_ENC_NC, done);
+    ret = 0;
+
+done:
+    XFREE(p, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+    XFREE(s, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+    wc_ed25519_free(&key);
+
+    return ret;
+}
+#endif /* WOLFSSL_ED25519_MULTI_SCALAR && HAVE_ED25519_KEY_EXPORT */
+
 WOLFSSL_TEST_SUBROUTINE wc_test_ret_t ed25519_test(void)
 {
     wc_test_ret_t ret;
@@ -32779,6 +35306,17 @@ WOLFSSL_TEST_SUBROUTINE wc_test_ret_t ed25519_test(void)
     if (ret != 0)
         return ret;
 
+#if defined(WOLFSSL_ED25519_BATCH_VERIFY) && defined(HAVE_ED25519_VERIFY)
+    ret = ed25519_batch_test(&rng);
+    if (ret != 0)
+        return ret;
+#endif
+#if defined(WOLFSSL_ED25519_MULTI_SCALAR) && defined(HAVE_ED25519_KEY_EXPORT)
+    ret = ed25519_multi_scalar_test(&rng);
+    if (ret != 0)
+        return ret;
+#endif
+
 #ifndef NO_ASN
     /* Try ASN.1 encoded private-only key and public key. */
     idx = 0;
@@ -36423,6 +38961,185 @@ static wc_test_ret_t kyber1024_kat(void)
     return 0;
 }
 #endif /* WOLFSSL_KYBER1024 */
+
+/* Implicit rejection: a changed cipher text is not an error and decapsulates
+ * to KDF(z || H(c)), where z is the last 32 bytes of the private key. */
+static wc_test_ret_t kyber_reject_test(KyberKey* key, const byte* priv,
+    word32 privSz, byte* ct, word32 ctSz, const byte* ss)
+{
+    wc_test_ret_t ret;
+    wc_Sha3  sha3;
+    wc_Shake shake;
+    byte     kr[2 * KYBER_SYM_SZ];
+    byte     ss_dec[KYBER_SS_SZ];
+    byte     expect[KYBER_SS_SZ];
+
+    ct[ctSz - 1] ^= 0x80;
+    ret = wc_KyberKey_Decapsulate(key, ss_dec, ct, ctSz);
+    if (ret != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), out);
+
+    XMEMCPY(kr, priv + privSz - KYBER_SYM_SZ, KYBER_SYM_SZ);
+    ret = wc_InitSha3_256(&sha3, HEAP_HINT, devId);
+    if (ret != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), out);
+    ret = wc_Sha3_256_Update(&sha3, ct, ctSz);
+    if (ret == 0)
+        ret = wc_Sha3_256_Final(&sha3, kr + KYBER_SYM_SZ);
+    wc_Sha3_256_Free(&sha3);
+    if (ret != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), out);
+    ret = wc_InitShake256(&shake, HEAP_HINT, devId);
+    if (ret != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), out);
+    ret = wc_Shake256_Update(&shake, kr, sizeof(kr));
+    if (ret == 0)
+        ret = wc_Shake256_Final(&shake, expect, sizeof(expect));
+    wc_Shake256_Free(&shake);
+    if (ret != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_EC(ret), out);
+
+    if (XMEMCMP(ss_dec, expect, sizeof(expect)) != 0)
+        ERROR_OUT(WC_TEST_RET_ENC_NC, out);
+    if (XMEMCMP(ss_dec, ss, sizeof(ss_dec)) == 0)
+        ERROR_OUT(WC_TEST_RET_ENC_NC, out);
+
+out:
+    ct[ctSz - 1] ^= 0x80;
+    return ret;
+}
+
+#if defined(HAVE_CPUID_INTEL) && defined(USE_INTEL_SPEEDUP)
+#define KYBER_AVX2_TEST_CNT     8
+
+/* Size of the output of kyber_avx2_test_run(). */
+#define KYBER_AVX2_TEST_OUT_SZ                                          \
+    (KYBER_MAX_PUBLIC_KEY_SIZE + KYBER_MAX_PRIVATE_KEY_SIZE +           \
+     2 * KYBER_MAX_CIPHER_TEXT_SIZE + 3 * KYBER_SS_SZ)
+
+/* Key generation, encapsulation and decapsulation from fixed random data.
+ *
+ * The private key is in the NTT domain, so it is the output of the forward
+ * NTT. Decapsulating random bytes with a random private key, and
+ * encapsulating to a random public key, puts co-efficients of any 12-bit value
+ * through the NTT, inverse NTT and base multiplication.
+ */
+static wc_test_ret_t kyber_avx2_test_run(int type, word32 pubSz, word32 privSz,
+    word32 ctSz, const byte* rnd, byte* out)
+{
+    wc_test_ret_t ret;
+    KyberKey key;
+    const byte* kgRnd = rnd;
+    const byte* encRnd = kgRnd + KYBER_MAKEKEY_RAND_SZ;
+    const byte* priv = encRnd + KYBER_ENC_RAND_SZ;
+    const byte* ct = priv + privSz;
+    const byte* pub = ct + ctSz;
+
+    ret = wc_KyberKey_Init(type, &key, HEAP_HINT, INVALID_DEVID);
+    if (ret != 0)
+        return WC_TEST_RET_ENC_EC(ret);
+
+    ret = wc_KyberKey_MakeKeyWithRandom(&key, kgRnd, KYBER_MAKEKEY_RAND_SZ);
+    if (ret == 0)
+        ret = wc_KyberKey_EncodePublicKey(&key, out, pubSz);
+    out += pubSz;
+    if (ret == 0)
+        ret = wc_KyberKey_EncodePrivateKey(&key, out, privSz);
+    out += privSz;
+    if (ret == 0) {
+        ret = wc_KyberKey_EncapsulateWithRandom(&key, out, out + ctSz, encRnd,
+            KYBER_ENC_RAND_SZ);
+    }
+    out += ctSz + KYBER_SS_SZ;
+
+    if (ret == 0)
+        ret = wc_KyberKey_DecodePrivateKey(&key, (byte*)priv, privSz);
+    if (ret == 0)
+        ret = wc_KyberKey_Decapsulate(&key, out, ct, ctSz);
+    out += KYBER_SS_SZ;
+
+    if (ret == 0)
+        ret = wc_KyberKey_DecodePublicKey(&key, (byte*)pub, pubSz);
+    if (ret == 0) {
+        ret = wc_KyberKey_EncapsulateWithRandom(&key, out, out + ctSz, encRnd,
+            KYBER_ENC_RAND_SZ);
+    }
+
+    wc_KyberKey_Free(&key);
+    if (ret != 0)
+        return WC_TEST_RET_ENC_EC(ret);
+    return 0;
+}
+
+/* The AVX2 NTT, inverse NTT and base multiplication must give the same
+ * results as the C code. */
+static wc_test_ret_t kyber_avx2_test(WC_RNG* rng)
+{
+    wc_test_ret_t ret = 0;
+    word32 flags = cpuid_get_flags();
+    byte*  rnd = NULL;
+    byte*  out = NULL;
+    word32 rndSz = KYBER_MAKEKEY_RAND_SZ + KYBER_ENC_RAND_SZ +
+        KYBER_MAX_PRIVATE_KEY_SIZE + KYBER_MAX_CIPHER_TEXT_SIZE +
+        KYBER_MAX_PUBLIC_KEY_SIZE;
+    int    i;
+    int    j;
+    int    testData[][4] = {
+    #ifdef WOLFSSL_KYBER512
+        { KYBER512,  KYBER512_PUBLIC_KEY_SIZE,  KYBER512_PRIVATE_KEY_SIZE,
+          KYBER512_CIPHER_TEXT_SIZE },
+    #endif
+    #ifdef WOLFSSL_KYBER768
+        { KYBER768,  KYBER768_PUBLIC_KEY_SIZE,  KYBER768_PRIVATE_KEY_SIZE,
+          KYBER768_CIPHER_TEXT_SIZE },
+    #endif
+    #ifdef WOLFSSL_KYBER1024
+        { KYBER1024, KYBER1024_PUBLIC_KEY_SIZE, KYBER1024_PRIVATE_KEY_SIZE,
+          KYBER1024_CIPHER_TEXT_SIZE },
+    #endif
+    };
+
+    if (!IS_INTEL_AVX2(flags))
+        return 0;
+
+    rnd = (byte*)XMALLOC(rndSz, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+    out = (byte*)XMALLOC(2 * KYBER_AVX2_TEST_OUT_SZ, HEAP_HINT,
+        DYNAMIC_TYPE_TMP_BUFFER);
+    if ((rnd == NULL) || (out == NULL))
+        ERROR_OUT(WC_TEST_RET_ENC_ERRNO, out);
+
+    for (i = 0; i < (int)(sizeof(testData) / sizeof(*testData)); i++) {
+        for (j = 0; j < KYBER_AVX2_TEST_CNT; j++) {
+            ret = wc_RNG_GenerateBlock(rng, rnd, rndSz);
+            if (ret != 0)
+                ERROR_OUT(WC_TEST_RET_ENC_EC(ret), out);
+            XMEMSET(out, 0, 2 * KYBER_AVX2_TEST_OUT_SZ);
+
+            ret = kyber_avx2_test_run(testData[i][0], (word32)testData[i][1],
+                (word32)testData[i][2], (word32)testData[i][3], rnd, out);
+            if (ret != 0)
+                goto out;
+            cpuid_clear_flag(CPUID_AVX2);
+            ret = kyber_avx2_test_run(testData[i][0], (word32)testData[i][1],
+                (word32)testData[i][2], (word32)testData[i][3], rnd,
+                out + KYBER_AVX2_TEST_OUT_SZ);
+            cpuid_select_flags(flags);
+            if (ret != 0)
+                goto out;
+
+            if (XMEMCMP(out, out + KYBER_AVX2_TEST_OUT_SZ,
+                        KYBER_AVX2_TEST_OUT_SZ) != 0) {
+                ERROR_OUT(WC_TEST_RET_ENC_I(i), out);
+            }
+        }
+    }
+
+out:
+    XFREE(rnd, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+    XFREE(out, HEAP_HINT, DYNAMIC_TYPE_TMP_BUFFER);
+    return ret;
+}
+#endif /* HAVE_CPUID_INTEL && USE_INTEL_SPEEDUP */
 #endif /* WOLFSSL_WC_KYBER */
 
 WOLFSSL_TEST_SUBROUTINE wc_test_ret_t kyber_test(void)
@@ -36438,6 +39155,10 @@ WOLFSSL_TEST_SUBROUTINE wc_test_ret_t kyber_test(void)
     byte ct[KYBER_MAX_CIPHER_TEXT_SIZE];
     byte ss[KYBER_SS_SZ];
     byte ss_dec[KYBER_SS_SZ];
+#if defined(WOLFSSL_WC_KYBER) && defined(HAVE_CPUID_INTEL) && \
+    defined(USE_INTEL_SPEEDUP)
+    word32 flags = cpuid_get_flags();
+#endif
     int testData[][4] = {
     #ifdef WOLFSSL_KYBER512
         { KYBER512,  KYBER512_PRIVATE_KEY_SIZE,  KYBER512_PUBLIC_KEY_SIZE,
@@ -36512,6 +39233,13 @@ WOLFSSL_TEST_SUBROUTINE wc_test_ret_t kyber_test(void)
         if (XMEMCMP(ss, ss_dec, sizeof(ss)) != 0)
             return WC_TEST_RET_ENC_I(i);
 
+    #ifdef WOLFSSL_WC_KYBER
+        ret = kyber_reject_test(&key, priv, (word32)testData[i][1], ct,
+            (word32)testData[i][3], ss);
+        if (ret != 0)
+            return ret;
+    #endif
+
         ret = wc_KyberKey_EncodePrivateKey(&key, priv2, testData[i][1]);
         if (ret != 0)
             return WC_TEST_RET_ENC_I(i);
@@ -36522,6 +39250,15 @@ WOLFSSL_TEST_SUBROUTINE wc_test_ret_t kyber_test(void)
         wc_KyberKey_Free(&key);
     }
 
+#if defined(WOLFSSL_WC_KYBER) && defined(HAVE_CPUID_INTEL) && \
+    defined(USE_INTEL_SPEEDUP)
+    ret = kyber_avx2_test(&rng);
+    if (ret != 0) {
+        wc_FreeRng(&rng);
+        return ret;
+    }
+#endif
+
     wc_FreeRng(&rng);
 
 #ifdef WOLFSSL_WC_KYBER
@@ -36540,6 +39277,26 @@ WOLFSSL_TEST_SUBROUTINE wc_test_ret_t kyber_test(void)
     if (ret != 0)
         return ret;
 #endif
+#if defined(HAVE_CPUID_INTEL) && defined(USE_INTEL_SPEEDUP)
+    /* The KATs above ran the AVX2 code, run them again in C. */
+    if (IS_INTEL_AVX2(flags)) {
+        cpuid_clear_flag(CPUID_AVX2);
+    #ifdef WOLFSSL_KYBER512
+        ret = kyber512_kat();
+    #endif
+    #ifdef WOLFSSL_KYBER768
+        if (ret == 0)
+            ret = kyber768_kat();
+    #endif
+    #ifdef WOLFSSL_KYBER1024
+        if (ret == 0)
+            ret = kyber1024_kat();
+    #endif
+        cpuid_select_flags(flags);
+        if (ret != 0)
+            return ret;
+    }
+#endif
 #endif /* WOLFSSL_WC_KYBER */
 
     return 0;
@@ -37181,6 +39938,50 @@ static int lms_read_key_mem(byte * priv, word32 privSz, void *context)
  * test has a signature of 8688 bytes. */
 #define WC_TEST_LMS_SIG_LEN (8688)
 
+#if defined(WOLFSSL_WC_LMS) && defined(WOLFSSL_LMS_THREADS) && \
+    !defined(SINGLE_THREADED)
+/* Reload the private key with the tree built by several threads and check
+ * the public key is the same as that of the key made on one thread. */
+static wc_test_ret_t lms_test_threads(const LmsKey* key, byte* priv)
+{
+    wc_test_ret_t ret;
+    LmsKey        threadKey;
+    byte          pub[HSS_MAX_PUBLIC_KEY_LEN];
+    byte          threadPub[HSS_MAX_PUBLIC_KEY_LEN];
+    word32        pubSz = sizeof(pub);
+    word32        threadPubSz = sizeof(threadPub);
+
+    ret = wc_LmsKey_Init(&threadKey, NULL, INVALID_DEVID);
+    if (ret != 0) { return WC_TEST_RET_ENC_EC(ret); }
+
+    ret = wc_LmsKey_SetThreads(&threadKey, 4);
+    if (ret == 0)
+        ret = wc_LmsKey_SetParameters(&threadKey, 1, 5, 1);
+    if (ret == 0)
+        ret = wc_LmsKey_SetWriteCb(&threadKey, lms_write_key_mem);
+    if (ret == 0)
+        ret = wc_LmsKey_SetReadCb(&threadKey, lms_read_key_mem);
+    if (ret == 0)
+        ret = wc_LmsKey_SetContext(&threadKey, (void *) priv);
+    if (ret == 0)
+        ret = wc_LmsKey_Reload(&threadKey);
+    if (ret == 0)
+        ret = wc_LmsKey_ExportPubRaw(key, pub, &pubSz);
+    if (ret == 0)
+        ret = wc_LmsKey_ExportPubRaw(&threadKey, threadPub, &threadPubSz);
+    if (ret != 0) {
+        ret = WC_TEST_RET_ENC_EC(ret);
+    }
+    else if ((pubSz != threadPubSz) || (XMEMCMP(pub, threadPub, pubSz) != 0)) {
+        ret = WC_TEST_RET_ENC_NC;
+    }
+
+    wc_LmsKey_Free(&threadKey);
+
+    return ret;
+}
+#endif
+
 WOLFSSL_TEST_SUBROUTINE wc_test_ret_t lms_test(void)
 {
     int           i = 0;
@@ -37247,6 +40048,12 @@ WOLFSSL_TEST_SUBROUTINE wc_test_ret_t lms_test(void)
     ret = wc_LmsKey_MakeKey(&signingKey, &rng);
     if (ret != 0) { return WC_TEST_RET_ENC_EC(ret); }
 
+#if defined(WOLFSSL_WC_LMS) && defined(WOLFSSL_LMS_THREADS) && \
+    !defined(SINGLE_THREADED)
+    ret = lms_test_threads(&signingKey, priv);
+    if (ret != 0) { return ret; }
+#endif
+
     XMEMCPY(old_priv, priv, sizeof(priv));
 
     ret = wc_LmsKey_ExportPub(&verifyKey, &signingKey);
@@ -76,6 +76,7 @@
     byte  salt[BLAKE2S_SALTBYTES]; /* 24 */
     byte  personal[BLAKE2S_PERSONALBYTES];  /* 32 */
   } blake2s_param;
+#pragma pack(pop)
 
   typedef struct __blake2s_state
   {
@@ -87,6 +88,7 @@
     byte  last_node;
   } blake2s_state ;
 
+#pragma pack(push, 1)
   typedef struct __blake2b_param
   {
     byte  digest_length; /* 1 */
@@ -101,6 +103,7 @@
     byte  salt[BLAKE2B_SALTBYTES]; /* 48 */
     byte  personal[BLAKE2B_PERSONALBYTES];  /* 64 */
   } blake2b_param;
+#pragma pack(pop)
 
   typedef struct __blake2b_state
   {
@@ -127,7 +130,6 @@
     byte buf[4 * BLAKE2B_BLOCKBYTES];
     word64 buflen;
   } blake2bp_state;
-#pragma pack(pop)
 
   /* Streaming API */
   int blake2s_init( blake2s_state *S, byte outlen );
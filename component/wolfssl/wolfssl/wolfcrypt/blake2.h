@@ -63,6 +63,12 @@ typedef struct Blake2b {
     blake2b_state S[1];         /* our state */
     word32        digestSz;     /* digest size used on init */
 } Blake2b;
+
+/* BLAKE2bp digest, four BLAKE2b leaves under one root */
+typedef struct Blake2bp {
+    blake2bp_state S[1];        /* our state */
+    word32         digestSz;    /* digest size used on init */
+} Blake2bp;
 #endif
 
 #ifdef HAVE_BLAKE2S
@@ -71,6 +77,12 @@ typedef struct Blake2s {
     blake2s_state S[1];         /* our state */
     word32        digestSz;     /* digest size used on init */
 } Blake2s;
+
+/* BLAKE2sp digest, eight BLAKE2s leaves under one root */
+typedef struct Blake2sp {
+    blake2sp_state S[1];        /* our state */
+    word32         digestSz;    /* digest size used on init */
+} Blake2sp;
 #endif
 
 
@@ -80,6 +92,13 @@ WOLFSSL_API int wc_InitBlake2b_WithKey(Blake2b* b2b, word32 digestSz,
                                        const byte *key, word32 keylen);
 WOLFSSL_API int wc_Blake2bUpdate(Blake2b* b2b, const byte* data, word32 sz);
 WOLFSSL_API int wc_Blake2bFinal(Blake2b* b2b, byte* final, word32 requestSz);
+
+WOLFSSL_API int wc_InitBlake2bp(Blake2bp* b2bp, word32 digestSz);
+WOLFSSL_API int wc_InitBlake2bp_WithKey(Blake2bp* b2bp, word32 digestSz,
+                                        const byte *key, word32 keylen);
+WOLFSSL_API int wc_Blake2bpUpdate(Blake2bp* b2bp, const byte* data, word32 sz);
+WOLFSSL_API int wc_Blake2bpFinal(Blake2bp* b2bp, byte* final,
+                                 word32 requestSz);
 #endif
 
 #ifdef HAVE_BLAKE2S
@@ -88,6 +107,13 @@ WOLFSSL_API int wc_InitBlake2s_WithKey(Blake2s* b2s, word32 digestSz,
                                        const byte *key, word32 keylen);
 WOLFSSL_API int wc_Blake2sUpdate(Blake2s* b2s, const byte* data, word32 sz);
 WOLFSSL_API int wc_Blake2sFinal(Blake2s* b2s, byte* final, word32 requestSz);
+
+WOLFSSL_API int wc_InitBlake2sp(Blake2sp* b2sp, word32 digestSz);
+WOLFSSL_API int wc_InitBlake2sp_WithKey(Blake2sp* b2sp, word32 digestSz,
+                                        const byte *key, word32 keylen);
+WOLFSSL_API int wc_Blake2spUpdate(Blake2sp* b2sp, const byte* data, word32 sz);
+WOLFSSL_API int wc_Blake2spFinal(Blake2sp* b2sp, byte* final,
+                                 word32 requestSz);
 #endif
 
 
@@ -120,6 +120,13 @@ enum {
     #endif
 #endif
 
+#ifdef WOLFSSL_DH_COMB
+    #if !defined(WOLFSSL_SP_MATH_ALL) || defined(WOLFSSL_SP_MATH) || \
+        defined(HAVE_FIPS)
+        #error "DH comb tables need sp_int math (WOLFSSL_SP_MATH_ALL)"
+    #endif
+#endif
+
 #ifdef HAVE_PUBLIC_FFDHE
 #ifdef HAVE_FFDHE_2048
 WOLFSSL_API const DhParams* wc_Dh_ffdhe2048_Get(void);
@@ -191,6 +198,10 @@ WOLFSSL_API int wc_DhCheckKeyPair(DhKey* key, const byte* pub, word32 pubSz,
 WOLFSSL_API int wc_DhGenerateParams(WC_RNG *rng, int modSz, DhKey *dh);
 WOLFSSL_API int wc_DhExportParamsRaw(DhKey* dh, byte* p, word32* pSz,
                        byte* q, word32* qSz, byte* g, word32* gSz);
+#ifdef WOLFSSL_DH_COMB
+WOLFSSL_API void wc_DhCombFree(void);
+WOLFSSL_LOCAL void wc_DhCombInit(void);
+#endif
 
 
 #ifdef __cplusplus
@@ -468,6 +468,15 @@ enum {
     } ecc_nb_ctx_t;
 #endif /* WC_ECC_NONBLOCK */
 
+#ifdef WOLFSSL_ECC_FP_SHARED
+    #if !defined(FP_ECC) || defined(WOLFSSL_SP_MATH)
+        #error Shared FP cache requires FP_ECC without WOLFSSL_SP_MATH
+    #endif
+    #if !defined(WOLFSSL_ATOMIC_OPS)
+        #error Shared FP cache requires atomic operations
+    #endif
+#endif /* WOLFSSL_ECC_FP_SHARED */
+
 
 /* An ECC Key */
 struct ecc_key {
@@ -634,6 +643,11 @@ int wc_ecc_make_key_ex(WC_RNG* rng, int keysize, ecc_key* key, int curve_id);
 WOLFSSL_API
 int wc_ecc_make_key_ex2(WC_RNG* rng, int keysize, ecc_key* key, int curve_id,
                         int flags);
+#ifdef WOLFSSL_ECC_KEYGEN_BATCH
+WOLFSSL_API
+int wc_ecc_make_key_batch(WC_RNG* rng, int keysize, ecc_key** key, word32 cnt,
+                          int curve_id);
+#endif
 WOLFSSL_API
 int wc_ecc_make_pub(ecc_key* key, ecc_point* pubOut);
 WOLFSSL_API
@@ -722,6 +736,10 @@ WOLFSSL_ABI WOLFSSL_API
 void wc_ecc_fp_free(void);
 WOLFSSL_LOCAL
 void wc_ecc_fp_init(void);
+#ifdef WOLFSSL_ECC_FP_SHARED
+WOLFSSL_API
+int wc_ecc_fp_stats(word32* hits, word32* misses);
+#endif
 WOLFSSL_API
 int wc_ecc_set_rng(ecc_key* key, WC_RNG* rng);
 
@@ -788,6 +806,11 @@ int wc_ecc_mulmod_ex2(const mp_int* k, ecc_point *G, ecc_point *R, mp_int* a,
                       mp_int* modulus, mp_int* order, WC_RNG* rng, int map,
                       void* heap);
 #endif /* !WOLFSSL_ATECC508A */
+#ifdef WOLFSSL_ECC_MULTI_SCALAR
+WOLFSSL_API
+int wc_ecc_mulmod_multi(mp_int** k, ecc_point** G, ecc_point* R, word32 cnt,
+                        int curve_id, void* heap);
+#endif
 
 
 #ifdef HAVE_ECC_KEY_EXPORT
@@ -255,6 +255,14 @@ WOLFSSL_API int wc_Sha256_Grow(wc_Sha256* sha256, const byte* in, int inSz);
 WOLFSSL_API int wc_Sha256GetHash(wc_Sha256* sha256, byte* hash);
 WOLFSSL_API int wc_Sha256Copy(wc_Sha256* src, wc_Sha256* dst);
 
+#ifdef WOLFSSL_SHA256_MULTI
+WOLFSSL_API int wc_Sha256HashMulti(const byte* const* data, const word32* len,
+                                   byte* const* hash, word32 cnt);
+WOLFSSL_API int wc_Sha256HashMulti_ex(const byte* const* data,
+                                      const word32* len, byte* const* hash,
+                                      word32 cnt, void* heap, int devId);
+#endif
+
 #ifdef WOLFSSL_PIC32MZ_HASH
 WOLFSSL_API void wc_Sha256SizeSet(wc_Sha256* sha256, word32 len);
 #endif
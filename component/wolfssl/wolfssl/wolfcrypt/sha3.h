@@ -136,6 +136,11 @@ struct wc_Sha3 {
 
 #if defined(WOLFSSL_SHAKE128) || defined(WOLFSSL_SHAKE256)
 typedef wc_Sha3 wc_Shake;
+
+/* Four SHAKE states permuted together. Word i of state l is s[i * 4 + l]. */
+typedef struct wc_Shakex4 {
+    word64 s[25 * 4];
+} wc_Shakex4;
 #endif
 
 WOLFSSL_API int wc_InitSha3_224(wc_Sha3* sha3, void* heap, int devId);
@@ -176,6 +181,10 @@ WOLFSSL_API int wc_Shake128_SqueezeBlocks(wc_Shake* shake, byte* out,
     word32 blockCnt);
 WOLFSSL_API void wc_Shake128_Free(wc_Shake* shake);
 WOLFSSL_API int wc_Shake128_Copy(wc_Shake* src, wc_Sha3* dst);
+WOLFSSL_API int wc_Shake128x4_Absorb(wc_Shakex4* shake,
+    const byte* const* data, word32 len);
+WOLFSSL_API int wc_Shake128x4_SqueezeBlocks(wc_Shakex4* shake,
+    byte* const* out, word32 blockCnt);
 #endif
 
 #ifdef WOLFSSL_SHAKE256
@@ -188,6 +197,13 @@ WOLFSSL_API int wc_Shake256_SqueezeBlocks(wc_Shake* shake, byte* out,
     word32 blockCnt);
 WOLFSSL_API void wc_Shake256_Free(wc_Shake* shake);
 WOLFSSL_API int wc_Shake256_Copy(wc_Shake* src, wc_Sha3* dst);
+WOLFSSL_API int wc_Shake256x4_Absorb(wc_Shakex4* shake,
+    const byte* const* data, word32 len);
+WOLFSSL_API int wc_Shake256x4_SqueezeBlocks(wc_Shakex4* shake,
+    byte* const* out, word32 blockCnt);
+#endif
+#if defined(WOLFSSL_SHAKE128) || defined(WOLFSSL_SHAKE256)
+WOLFSSL_API void wc_Shakex4_Free(wc_Shakex4* shake);
 #endif
 
 #ifdef WOLFSSL_HASH_FLAGS
@@ -200,6 +216,7 @@ WOLFSSL_LOCAL void sha3_block_n_bmi2(word64* s, const byte* data, word32 n,
     word64 c);
 WOLFSSL_LOCAL void sha3_block_bmi2(word64* s);
 WOLFSSL_LOCAL void sha3_block_avx2(word64* s);
+WOLFSSL_LOCAL void kyber_sha3_blocksx4_avx2(word64* s);
 WOLFSSL_LOCAL void BlockSha3(word64 *s);
 #endif
 #if defined(WOLFSSL_ARMASM) && defined(WOLFSSL_ARMASM_CRYPTO_SHA3)
@@ -401,6 +401,26 @@ WOLFSSL_LOCAL int sp_ecc_verify_521_nb(sp_ecc_ctx_t* ctx, const byte* hash,
     const mp_int* r, const mp_int* sm, int* res, void* heap);
 #endif /* WOLFSSL_SP_NONBLOCK */
 
+#if defined(WOLFSSL_ECC_KEYGEN_BATCH) && !defined(WOLFSSL_SP_ASM) && \
+    (SP_WORD_SIZE == 64)
+/* Batch key generation is implemented in the 64-bit C code. */
+#define WOLFSSL_SP_ECC_KEYGEN_BATCH
+WOLFSSL_LOCAL int sp_ecc_make_key_batch_256(WC_RNG* rng, int cnt,
+    mp_int** priv, ecc_point** pub, void* heap);
+WOLFSSL_LOCAL int sp_ecc_make_key_batch_384(WC_RNG* rng, int cnt,
+    mp_int** priv, ecc_point** pub, void* heap);
+#endif /* WOLFSSL_ECC_KEYGEN_BATCH && !WOLFSSL_SP_ASM && SP_WORD_SIZE == 64 */
+
+#if defined(WOLFSSL_ECC_MULTI_SCALAR) && !defined(WOLFSSL_SP_ASM) && \
+    (SP_WORD_SIZE == 64)
+/* Multi-scalar multiplication is implemented in the 64-bit C code. */
+#define WOLFSSL_SP_ECC_MULTI_SCALAR
+WOLFSSL_LOCAL int sp_ecc_mulmod_multi_256(int cnt, mp_int** km,
+    ecc_point** gm, ecc_point* r, void* heap);
+WOLFSSL_LOCAL int sp_ecc_mulmod_multi_384(int cnt, mp_int** km,
+    ecc_point** gm, ecc_point* r, void* heap);
+#endif /* WOLFSSL_ECC_MULTI_SCALAR && !WOLFSSL_SP_ASM && SP_WORD_SIZE == 64 */
+
 #ifdef HAVE_ECC_SM2
 
 WOLFSSL_LOCAL int sp_ecc_mulmod_sm2_256(mp_int* km, ecc_point* gm,
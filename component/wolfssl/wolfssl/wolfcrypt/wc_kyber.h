@@ -1,3 +1,144 @@
+/* wc_kyber.h
+ *
+ * Copyright (C) 2006-2023 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL.
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
+ */
 
-#error "Contact wolfSSL to get the implementation of this file"
+/*!
+    \file wolfssl/wolfcrypt/wc_kyber.h
+*/
 
+#ifndef WOLF_CRYPT_WC_KYBER_H
+#define WOLF_CRYPT_WC_KYBER_H
+
+#include <wolfssl/wolfcrypt/types.h>
+#include <wolfssl/wolfcrypt/random.h>
+#include <wolfssl/wolfcrypt/sha3.h>
+#include <wolfssl/wolfcrypt/kyber.h>
+
+#ifdef WOLFSSL_HAVE_KYBER
+
+#if !defined(WOLFSSL_SHA3) || !defined(WOLFSSL_SHAKE128) || \
+    !defined(WOLFSSL_SHAKE256)
+    #error "wolfCrypt's Kyber requires SHA-3, SHAKE128 and SHAKE256"
+#endif
+
+/* Modulus of the polynomial ring. */
+#define KYBER_Q             3329
+
+/* Number of bytes of SHAKE128 output squeezed at a time. */
+#define KYBER_XOF_BLOCK_SZ  WC_SHA3_128_BLOCK_SIZE
+/* Number of bytes of SHAKE256 output squeezed at a time. */
+#define KYBER_PRF_BLOCK_SZ  WC_SHA3_256_BLOCK_SIZE
+
+/* Number of bytes of XOF output to generate a polynomial with a likely
+ * rejection rate: 12 bits per co-efficient and an acceptance of q/4096. */
+#define KYBER_GEN_MATRIX_BLOCKS \
+    ((12 * KYBER_N / 8 * 4096 / KYBER_Q + KYBER_XOF_BLOCK_SZ) / \
+     KYBER_XOF_BLOCK_SZ)
+
+/* Parameters of Kyber variants. */
+#define KYBER_ETA1_512      3
+#define KYBER_ETA1_OTHER    2
+#define KYBER_ETA2          2
+
+/* Key has private part set. */
+#define KYBER_FLAG_PRIV_SET     0x0001
+/* Key has public part set. */
+#define KYBER_FLAG_PUB_SET      0x0002
+/* Key has both parts set. */
+#define KYBER_FLAG_BOTH_SET     0x0003
+/* Hash of public key has been calculated. */
+#define KYBER_FLAG_H_SET        0x0004
+
+/* Kyber key: private and public polynomial vectors are kept in NTT form. */
+struct KyberKey {
+    /* Type of key: KYBER512, KYBER768 or KYBER1024. */
+    int type;
+    /* Dynamic memory allocation hint. */
+    void* heap;
+    /* Device identifier for hashing. */
+    int devId;
+    /* Flags indicating what is stored in the key. */
+    int flags;
+
+    /* Private key as a vector of polynomials. */
+    sword16 priv[KYBER_MAX_K * KYBER_N];
+    /* Public key as a vector of polynomials. */
+    sword16 pub[KYBER_MAX_K * KYBER_N];
+    /* Public seed used to generate the matrix. */
+    byte pubSeed[KYBER_SYM_SZ];
+    /* Hash of the encoded public key. */
+    byte h[KYBER_SYM_SZ];
+    /* Random used for implicit rejection in decapsulation. */
+    byte z[KYBER_SYM_SZ];
+};
+
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+WOLFSSL_LOCAL void kyber_init(void);
+
+WOLFSSL_LOCAL void kyber_keygen(sword16* priv, sword16* pub, sword16* e,
+    const sword16* a, int kp);
+WOLFSSL_LOCAL void kyber_encapsulate(const sword16* pub, sword16* bp,
+    sword16* v, const sword16* at, sword16* sp, const sword16* ep,
+    const sword16* epp, const sword16* m, int kp);
+WOLFSSL_LOCAL void kyber_decapsulate(const sword16* priv, sword16* mp,
+    sword16* bp, const sword16* v, int kp);
+
+WOLFSSL_LOCAL int kyber_gen_matrix(sword16* a, int kp, const byte* seed,
+    int transposed, void* heap, int devId);
+WOLFSSL_LOCAL int kyber_get_noise(int kp, sword16* vec1, sword16* vec2,
+    sword16* poly, const byte* seed, void* heap, int devId);
+
+WOLFSSL_LOCAL void kyber_vec_compress_10(byte* r, sword16* v, unsigned int kp);
+WOLFSSL_LOCAL void kyber_vec_compress_11(byte* r, sword16* v);
+WOLFSSL_LOCAL void kyber_vec_decompress_10(sword16* v, const byte* b,
+    unsigned int kp);
+WOLFSSL_LOCAL void kyber_vec_decompress_11(sword16* v, const byte* b);
+WOLFSSL_LOCAL void kyber_compress_4(byte* b, sword16* p);
+WOLFSSL_LOCAL void kyber_compress_5(byte* b, sword16* p);
+WOLFSSL_LOCAL void kyber_decompress_4(sword16* p, const byte* b);
+WOLFSSL_LOCAL void kyber_decompress_5(sword16* p, const byte* b);
+
+WOLFSSL_LOCAL void kyber_from_msg(sword16* p, const byte* msg);
+WOLFSSL_LOCAL void kyber_to_msg(byte* msg, sword16* p);
+WOLFSSL_LOCAL void kyber_from_bytes(sword16* p, const byte* b, int k);
+WOLFSSL_LOCAL void kyber_to_bytes(byte* b, sword16* p, int k);
+
+WOLFSSL_LOCAL int kyber_cmp(const byte* a, const byte* b, int sz);
+
+#ifdef USE_INTEL_SPEEDUP
+WOLFSSL_LOCAL void kyber_ntt_avx2(sword16* r);
+WOLFSSL_LOCAL void kyber_invntt_avx2(sword16* r);
+WOLFSSL_LOCAL void kyber_basemul_mont_avx2(sword16* r, const sword16* a,
+    const sword16* b);
+WOLFSSL_LOCAL void kyber_basemul_mont_add_avx2(sword16* r, const sword16* a,
+    const sword16* b);
+#endif
+
+#ifdef __cplusplus
+    } /* extern "C" */
+#endif
+
+#endif /* WOLFSSL_HAVE_KYBER */
+
+#endif /* WOLF_CRYPT_WC_KYBER_H */
@@ -19,5 +19,124 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
  */
 
-#error "Contact wolfSSL to get the implementation of this file"
+/*!
+    \file wolfssl/wolfcrypt/wc_lms.h
+*/
 
+#ifndef WOLF_CRYPT_WC_LMS_H
+#define WOLF_CRYPT_WC_LMS_H
+
+#include <wolfssl/wolfcrypt/types.h>
+#include <wolfssl/wolfcrypt/lms.h>
+
+#ifdef WOLFSSL_HAVE_LMS
+
+#ifdef NO_SHA256
+    #error "wolfCrypt's LMS/HSS requires SHA-256"
+#endif
+
+#if defined(HAVE_LIBLMS)
+    #error "This code is incompatible with the hash-sigs LMS/HSS lib."
+#endif
+
+/* Limits on the parameters from RFC 8554. */
+#define LMS_MIN_LEVELS          1
+#define LMS_MAX_LEVELS          8
+#define LMS_MIN_HEIGHT          5
+#define LMS_MAX_HEIGHT          25
+
+/* Only SHA-256 with a 32 byte output is supported. */
+#define LMS_HASH_LEN            32
+/* Length of the tree identifier I. */
+#define LMS_I_LEN               16
+/* Length of the secret seed each tree's one-time keys are derived from. */
+#define LMS_SEED_LEN            32
+/* Length of a u32str encoded number, type or leaf index. */
+#define LMS_U32_LEN             4
+/* Length of an LMS public key: type, OTS type, I and root. */
+#define LMS_PUB_LEN \
+    (2 * LMS_U32_LEN + LMS_I_LEN + LMS_HASH_LEN)
+
+/* HSS public key: number of levels and top level LMS public key. */
+#define HSS_MAX_PUBLIC_KEY_LEN  (LMS_U32_LEN + LMS_PUB_LEN)
+/* HSS private key: number of signatures used, the type of each level, the
+ * seed and I of the top level tree. Same layout as the hash-sigs lib. */
+#define HSS_MAX_PRIVATE_KEY_LEN (8 + LMS_MAX_LEVELS + LMS_SEED_LEN + LMS_I_LEN)
+
+/* Log2 of the number of top levels of nodes of each tree kept in memory.
+ * The nodes of the lower levels are kept for the subtree being signed with
+ * and recomputed when signing moves on to the next one. */
+#ifndef WOLFSSL_LMS_CACHE_HEIGHT
+    #define WOLFSSL_LMS_CACHE_HEIGHT    10
+#endif
+
+/* State of the tree at one level of an HSS key. */
+typedef struct LmsTree {
+    /* Identifier of the tree. */
+    byte   I[LMS_I_LEN];
+    /* Secret seed of the one-time keys. */
+    byte   seed[LMS_SEED_LEN];
+    /* Root of the tree. */
+    byte   root[LMS_HASH_LEN];
+    /* Signatures used before this tree was started: identifies the tree. */
+    word64 id;
+    /* Nodes of the top levels, indexed by node number. */
+    byte*  top;
+    /* Nodes of the subtree of leaves currently signed with, indexed by node
+     * number relative to the root of the subtree. NULL when the whole tree
+     * is in top. */
+    byte*  bottom;
+    /* Index of the subtree in bottom. */
+    word32 bottomIdx;
+    /* Signature of this tree's public key by the parent tree. */
+    byte*  sig;
+} LmsTree;
+
+struct LmsKey {
+    /* Number of levels of trees. */
+    int                  levels;
+    /* Height of each tree. */
+    int                  height;
+    /* Bits of the hash per Winternitz chain. */
+    int                  winternitz;
+    /* HSS public key. */
+    byte                 pub[HSS_MAX_PUBLIC_KEY_LEN];
+    /* Dynamic memory allocation hint. */
+    void*                heap;
+#ifndef WOLFSSL_LMS_VERIFY_ONLY
+    /* Callback to write/update private key. */
+    write_private_key_cb write_private_key;
+    /* Callback to read private key. */
+    read_private_key_cb  read_private_key;
+    /* Context arg passed to callbacks. */
+    void*                context;
+    /* Private key as last written. */
+    byte                 priv[HSS_MAX_PRIVATE_KEY_LEN];
+    /* Number of signatures made with the key. */
+    word64               q;
+    /* State of the tree at each level. */
+    LmsTree              tree[LMS_MAX_LEVELS];
+#if defined(WOLFSSL_LMS_THREADS) && !defined(SINGLE_THREADED)
+    /* Number of threads building trees. */
+    word32               threads;
+#endif
+#endif /* ifndef WOLFSSL_LMS_VERIFY_ONLY */
+    enum wc_LmsState     state;
+};
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+#if !defined(WOLFSSL_LMS_VERIFY_ONLY) && defined(WOLFSSL_LMS_THREADS) && \
+    !defined(SINGLE_THREADED)
+WOLFSSL_API int  wc_LmsKey_SetThreads(LmsKey * key, word32 threads);
+#endif
+
+#ifdef __cplusplus
+    } /* extern "C" */
+#endif
+
+#endif /* WOLFSSL_HAVE_LMS */
+
+#endif /* WOLF_CRYPT_WC_LMS_H */
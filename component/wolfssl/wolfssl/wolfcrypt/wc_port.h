@@ -339,6 +339,14 @@
      * the effects of the function. */
     WOLFSSL_LOCAL int wolfSSL_Atomic_Int_FetchAdd(wolfSSL_Atomic_Int* c, int i);
     WOLFSSL_LOCAL int wolfSSL_Atomic_Int_FetchSub(wolfSSL_Atomic_Int* c, int i);
+    /* Load with acquire and store with release ordering, for publishing data
+     * guarded by the counter. */
+    WOLFSSL_LOCAL int wolfSSL_Atomic_Int_Load(wolfSSL_Atomic_Int* c);
+    WOLFSSL_LOCAL void wolfSSL_Atomic_Int_Store(wolfSSL_Atomic_Int* c, int i);
+    /* Sets counter to i when it equals *expected and returns 1. Otherwise
+     * *expected is set to the counter and 0 is returned. */
+    WOLFSSL_LOCAL int wolfSSL_Atomic_Int_CompareExchange(wolfSSL_Atomic_Int* c,
+        int* expected, int i);
 #endif
 
 /* Reference counting. */
@@ -1,6 +1,5 @@
 from cryptography.hazmat.primitives.asymmetric import rsa
 from cryptography.hazmat.primitives import serialization
-import binascii
 import hashlib
 import os
 
@@ -9,6 +8,13 @@ import os
 PIN_KEY_LENGTH = 12
 TOKEN_KEY_LENGTH = 15
 RSA_KEY_LENGTH = 512 # Will convert to bytes
+ATTEST_KEY_LENGTH = 32 # Bytes, HMAC-SHA256 key
+INPUT_BUFSIZE = 64 # Bytes the AP reads for an entered PIN or token
+KDF_SALT_LENGTH = 16 # Bytes
+# PBKDF2-HMAC-SHA256 work factor for the PIN and token. Every guess costs the AP
+# this many HMACs, tune per deployment with `make KDF_ITERATIONS=<n>` and check
+# the cost on the board with the AP's KDF_BENCH build
+KDF_ITERATIONS = int(os.environ.get("KDF_ITERATIONS", 1000))
 
 def generate_sequence(is_pin):
         sequence_length = PIN_KEY_LENGTH if is_pin else TOKEN_KEY_LENGTH
@@ -26,20 +32,17 @@ def generate_sequence(is_pin):
         typesequence = "PIN" if is_pin else "TOKEN"
         print(typesequence + " SEQUENCE ->", " > " + sequence + " < ")
 
-        # Digest and hash the result, the result will be flashed to our chip
-        m = hashlib.sha256()
-        m.update(bytes(sequence, 'ascii'))
-        hashed_goodies = m.hexdigest()
-
-        generate_hash_pins = "#define " + typesequence + " " + '"' + hashed_goodies + '"\n'
-        generate_length = "#define " + typesequence + "_BUFSIZE" + " " + str(len(hashed_goodies)) + '\n'
+        # Only a salted, iterated digest of the sequence is flashed to our chip
+        salt = os.urandom(KDF_SALT_LENGTH)
+        digest = hashlib.pbkdf2_hmac('sha256', bytes(sequence, 'ascii'), salt, KDF_ITERATIONS)
 
         f = open("global_secrets.h", 'a')
-        f.write(generate_hash_pins)
-        f.write(generate_length)
+        f.write(format_key_store(typesequence + "_SALT", salt))
+        f.write(format_key_store(typesequence + "_DIGEST", digest))
+        f.write("#define " + typesequence + "_BUFSIZE " + str(INPUT_BUFSIZE) + "\n\n")
         f.close()
         
-        print("Hexed input = ", hashed_goodies)
+        print("Derived digest = ", digest.hex())
 
 def generate_nonce():
         number = int.from_bytes(os.urandom(8), "little")
@@ -68,6 +71,21 @@ def generate_comp_seed():
         f.write(seed)
         f.close()
 
+# Keys are emitted as const arrays tagged with KEY_STORE so the linker places
+# them in the .key_store flash section (see firmware.ld). The firmware decodes
+# them in place, so no copy of the DER blobs is ever made in SRAM.
+def format_key_store(name, der):
+        body = ",".join(("\n    " if i % 16 == 0 else " ") + "0x%02x" % b for i, b in enumerate(der))
+        return "static const uint8_t " + name + "[" + str(len(der)) + "] KEY_STORE = {" + body + "\n};\n"
+
+def generate_key_store_header():
+        f = open("global_secrets.h", 'a')
+        f.write("#include <stdint.h>\n\n")
+        f.write("#ifndef KEY_STORE\n")
+        f.write("#define KEY_STORE __attribute__((section(\".key_store\"), aligned(4), unused))\n")
+        f.write("#endif\n\n")
+        f.close()
+
 def generate_ap_key_pair():
       private_key = rsa.generate_private_key(
                         public_exponent=65537,
@@ -83,14 +101,8 @@ def generate_ap_key_pair():
                         format=serialization.PublicFormat.SubjectPublicKeyInfo
                     )
 
-      der_private_key_hex = binascii.hexlify(der_private_key).decode('utf-8')
-      der_public_key_hex = binascii.hexlify(der_public_key).decode('utf-8')
-
-      formatted_private_key = '\\x'+'\\x'.join(a+b for a,b in zip(der_private_key_hex[::2],der_private_key_hex[1::2]))
-      formatted_public_key = '\\x'+'\\x'.join(a+b for a,b in zip(der_public_key_hex[::2],der_public_key_hex[1::2]))
-
-      ap_priv = "#define AP_PRIV_AT " + '"' + formatted_private_key + '"\n'
-      ap_pub  = "#define AP_PUB_AT  " + '"' + formatted_public_key + '"\n'
+      ap_priv = format_key_store("AP_PRIV_AT", der_private_key)
+      ap_pub  = format_key_store("AP_PUB_AT", der_public_key)
       f = open("global_secrets.h", 'a')
       f.write("\n\n")
       f.write(ap_priv)
@@ -117,15 +129,8 @@ def generate_comp_key_pair(n):
                         format=serialization.PublicFormat.SubjectPublicKeyInfo
                         )
 
-                der_private_key_hex = binascii.hexlify(der_private_key).decode('utf-8')
-                der_public_key_hex = binascii.hexlify(der_public_key).decode('utf-8')
-
-                formatted_private_key = '\\x'+'\\x'.join(a+b for a,b in zip(der_private_key_hex[::2],der_private_key_hex[1::2]))
-                formatted_public_key = '\\x'+'\\x'.join(a+b for a,b in zip(der_public_key_hex[::2],der_public_key_hex[1::2]))
-
-
-                comp_priv = "#define COMP"+str(i+1)+"_PRIV " + '"' + formatted_private_key + '"\n'
-                comp_pub  = "#define COMP"+str(i+1)+"_PUB  " + '"' + formatted_public_key + '"\n'
+                comp_priv = format_key_store("COMP"+str(i+1)+"_PRIV", der_private_key)
+                comp_pub  = format_key_store("COMP"+str(i+1)+"_PUB", der_public_key)
                 f.write("\n\n")
                 f.write(comp_priv)
                 f.write("\n\n")
@@ -135,6 +140,19 @@ def generate_comp_key_pair(n):
 
       f.close() 
 
+# Shared by the AP and every component, the component MACs each attestation
+# reply together with the AP's nonce so a recorded reply cannot be replayed
+def generate_attest_key():
+        f = open("global_secrets.h", 'a')
+        f.write(format_key_store("ATTEST_KEY", os.urandom(ATTEST_KEY_LENGTH)))
+        f.write("\n\n")
+        f.close()
+
+def generate_kdf_params():
+        f = open("global_secrets.h", 'a')
+        f.write("#define KDF_ITERATIONS " + str(KDF_ITERATIONS) + "\n\n")
+        f.close()
+
 def generate_key_length():
         f = open("global_secrets.h", 'a')
         f.write("#define RSA_KEY_LENGTH " + str(int(RSA_KEY_LENGTH/8)) + "\n")  
@@ -147,6 +165,9 @@ def main():
     f = open("global_secrets.h", 'w')
     f.close() 
 
+    generate_key_store_header()
+
+    generate_kdf_params()
     generate_sequence(1)
     generate_sequence(0)
     generate_nonce()
@@ -156,6 +177,7 @@ def main():
     # This gets ugly 
     generate_ap_key_pair() # FOR AT ENCRYPTION
     generate_comp_key_pair(1) # Just use one key pair for all components, ez
+    generate_attest_key() # For binding attestation replies to a nonce
     generate_key_length() # Note the key size we chose
 
 if __name__ == "__main__":